@@ -55,9 +55,12 @@
 #include "llsd.h"
 #include "llsdserialize.h"
 #include "llstl.h"
+#include "llthread.h"
 #include "lltimer.h"
 #include "aithreadsafe.h"
 
+#include "apr_atomic.h"
+
 extern apr_thread_mutex_t* gCallStacksLogMutexp;
 
 namespace {
@@ -356,49 +359,33 @@ namespace
 
 	typedef std::map<std::string, LLError::ELevel> LevelMap;
 	typedef std::vector<LLError::Recorder*> Recorders;
-	typedef std::vector<LLError::CallSite*> CallSiteVector;
+
+	class LogQueue;
+	typedef std::vector<LogQueue*> LogQueues;
 
 	class Globals
 	{
 	public:
-		std::ostringstream messageStream;
-		bool messageStreamInUse;
+		LogQueues queues;	// One per thread that logged while logging was asynchronous.
 
-		void addCallSite(LLError::CallSite&);
-		void invalidateCallSites();
-		
 		static AIThreadSafeSimple<Globals>& get();
 			// return the one instance of the globals
 
 	private:
-		CallSiteVector callSites;
-
 		friend class AIThreadSafeSimpleDC<Globals>;		// Calls constructor.
 		friend class AIThreadSafeSimple<Globals>;		// Calls destructor.
 
-		Globals()
-			:	messageStreamInUse(false)
-			{ }
-		
+		Globals() { }
 	};
 
-	void Globals::addCallSite(LLError::CallSite& site)
+	void invalidateCallSites()
 	{
-		callSites.push_back(&site);
-	}
-	
-	void Globals::invalidateCallSites()
-	{
-		for (CallSiteVector::const_iterator i = callSites.begin();
-			 i != callSites.end();
-			 ++i)
-		{
-			(*i)->invalidate();
-		}
-		
-		callSites.clear();
+		apr_atomic_inc32(&LLError::Log::sGeneration);
 	}
 
+	// Copy of Settings::printLocation that can be read without locking.
+	volatile bool sPrintLocation = false;
+
 	AIThreadSafeSimple<Globals>& Globals::get()
 	{
 		/* This pattern, of returning a reference to a static function
@@ -412,6 +399,108 @@ namespace
 	}
 }
 
+apr_thread_mutex_t* gLogMutexp;
+apr_thread_mutex_t* gCallStacksLogMutexp;
+
+namespace
+{
+	// The mutex isn't recursive: don't wait for it if this thread already
+	// has it (something logged while writing out or crashing).
+	ll_thread_local bool tHoldsLogLock = false;
+
+	class LogLock
+	{
+	public:
+		LogLock(bool wait = false);
+		~LogLock();
+		bool ok() const { return mOK; }
+	private:
+		bool mLocked;
+		bool mOK;
+	};
+	
+	LogLock::LogLock(bool wait)
+		: mLocked(false), mOK(false)
+	{
+		if (!gLogMutexp)
+		{
+			mOK = true;
+			return;
+		}
+
+		if (wait && !tHoldsLogLock)
+		{
+			// The log writer can hold the lock for a while.
+			mLocked = mOK = apr_thread_mutex_lock(gLogMutexp) == APR_SUCCESS;
+			tHoldsLogLock = mLocked;
+			return;
+		}
+		
+		const int MAX_RETRIES = 5;
+		for (int attempts = 0; attempts < MAX_RETRIES; ++attempts)
+		{
+			apr_status_t s = apr_thread_mutex_trylock(gLogMutexp);
+			if (!APR_STATUS_IS_EBUSY(s))
+			{
+				mLocked = true;
+				mOK = true;
+				tHoldsLogLock = true;
+				return;
+			}
+
+			ms_sleep(1);
+			//apr_thread_yield();
+				// Just yielding won't necessarily work, I had problems with
+				// this on Linux - doug 12/02/04
+		}
+
+		// We're hosed, we can't get the mutex.  Blah.
+		std::cerr << "LogLock::LogLock: failed to get mutex for log"
+					<< std::endl;
+	}
+	
+	LogLock::~LogLock()
+	{
+		if (mLocked)
+		{
+			tHoldsLogLock = false;
+			apr_thread_mutex_unlock(gLogMutexp);
+		}
+	}
+
+	// Recorders are called with only LogLock held, from a copy of the
+	// list.  Take this before the settings to remove or delete one, so
+	// that no other thread is using it then.
+	class RecorderLock
+	{
+	public:
+		RecorderLock();
+		~RecorderLock();
+	private:
+		bool mLocked;
+	};
+
+	RecorderLock::RecorderLock()
+		: mLocked(false)
+	{
+		// Already held when a recorder goes away while writing out.
+		if (gLogMutexp && !tHoldsLogLock)
+		{
+			mLocked = apr_thread_mutex_lock(gLogMutexp) == APR_SUCCESS;
+			tHoldsLogLock = mLocked;
+		}
+	}
+
+	RecorderLock::~RecorderLock()
+	{
+		if (mLocked)
+		{
+			tHoldsLogLock = false;
+			apr_thread_mutex_unlock(gLogMutexp);
+		}
+	}
+}
+
 namespace LLError
 {
 	class Settings
@@ -480,24 +569,33 @@ namespace LLError
 	
 	void Settings::reset()
 	{
-		AIAccess<Globals>(Globals::get())->invalidateCallSites();
-		delete sSettings;
-		sSettings = new AIThreadSafeSimpleDC<Settings>;
+		{
+			RecorderLock lock;
+			delete sSettings;
+			sSettings = new AIThreadSafeSimpleDC<Settings>;
+		}
+		sPrintLocation = false;
+		invalidateCallSites();
 	}
 	
 	AIThreadSafeSimple<Settings>* Settings::saveAndReset()
 	{
-		AIAccess<Globals>(Globals::get())->invalidateCallSites();
 		AIThreadSafeSimple<Settings>* originalSettings = sSettings;
 		sSettings = new AIThreadSafeSimpleDC<Settings>;
+		sPrintLocation = false;
+		invalidateCallSites();
 		return originalSettings;
 	}
 	
 	void Settings::restore(AIThreadSafeSimple<Settings>* originalSettings)
 	{
-		AIAccess<Globals>(Globals::get())->invalidateCallSites();
-		delete sSettings;
-		sSettings = originalSettings;
+		{
+			RecorderLock lock;
+			delete sSettings;
+			sSettings = originalSettings;
+		}
+		sPrintLocation = AIAccess<Settings>(*sSettings)->printLocation;
+		invalidateCallSites();
 	}
 }
 
@@ -513,13 +611,13 @@ namespace LLError
 					bool printOnce)
 		: mLevel(level), mFile(file), mLine(line),
 		  mClassInfo(class_info), mFunction(function),
-		  mCached(false), mShouldLog(false), 
-		  mBroadTag(broadTag), mNarrowTag(narrowTag), mPrintOnce(printOnce)
+		  mBroadTag(broadTag), mNarrowTag(narrowTag), mPrintOnce(printOnce),
+		  mCache(0)
 		{ }
 
 
 	void CallSite::invalidate()
-		{ mCached = false; }
+		{ mCache = 0; }
 }
 
 namespace
@@ -604,6 +702,7 @@ namespace LLError
 	void setPrintLocation(AIAccess<Settings> const& settings_w, bool print)
 	{
 		settings_w->printLocation = print;
+		sPrintLocation = print;
 	}
 
 	void setPrintLocation(bool print)
@@ -628,8 +727,8 @@ namespace LLError
 
 	void setDefaultLevel(AIAccess<Settings> const& settings_w, ELevel level)
 	{
-		AIAccess<Globals>(Globals::get())->invalidateCallSites();
 		settings_w->defaultLevel = level;
+		invalidateCallSites();
 	}
 
 	void setDefaultLevel(ELevel level)
@@ -639,26 +738,26 @@ namespace LLError
 
 	void setFunctionLevel(const std::string& function_name, ELevel level)
 	{
-		AIAccess<Globals>(Globals::get())->invalidateCallSites();
 		AIAccess<Settings>(Settings::get())->functionLevelMap[function_name] = level;
+		invalidateCallSites();
 	}
 
 	void setClassLevel(const std::string& class_name, ELevel level)
 	{
-		AIAccess<Globals>(Globals::get())->invalidateCallSites();
 		AIAccess<Settings>(Settings::get())->classLevelMap[class_name] = level;
+		invalidateCallSites();
 	}
 
 	void setFileLevel(const std::string& file_name, ELevel level)
 	{
-		AIAccess<Globals>(Globals::get())->invalidateCallSites();
 		AIAccess<Settings>(Settings::get())->fileLevelMap[file_name] = level;
+		invalidateCallSites();
 	}
 
 	void setTagLevel(const std::string& tag_name, ELevel level)
 	{
-		AIAccess<Globals>(Globals::get())->invalidateCallSites();
 		AIAccess<Settings>(Settings::get())->tagLevelMap[tag_name] = level;
+		invalidateCallSites();
 	}
 }
 
@@ -703,7 +802,6 @@ namespace LLError
 	void configure(const LLSD& config)
 	{
 		AIAccess<Settings> settings_w(Settings::get());
-		AIAccess<Globals>(Globals::get())->invalidateCallSites();
 		settings_w->functionLevelMap.clear();
 		settings_w->classLevelMap.clear();
 		settings_w->fileLevelMap.clear();
@@ -726,6 +824,7 @@ namespace LLError
 			setLevels(settings_w->fileLevelMap,	 entry["files"],	 level);
 			setLevels(settings_w->tagLevelMap,		 entry["tags"],		 level);
 		}
+		invalidateCallSites();
 	}
 }
 
@@ -768,6 +867,8 @@ namespace LLError
 
 	void removeRecorder(Recorder* recorder)
 	{
+		// The caller deletes it once we return.
+		RecorderLock lock;
 		removeRecorder(AIAccess<Settings>(Settings::get()), recorder);
 	}
 }
@@ -776,6 +877,7 @@ namespace LLError
 {
 	void logToFile(const std::string& file_name)
 	{
+		RecorderLock lock;
 		AIAccess<Settings> settings_w(Settings::get());
 
 		removeRecorder(settings_w, settings_w->fileRecorder);
@@ -802,6 +904,7 @@ namespace LLError
 	
 	void logToFixedBuffer(LLLineBuffer* fixedBuffer)
 	{
+		RecorderLock lock;
 		AIAccess<Settings> settings_w(Settings::get());
 
 		removeRecorder(settings_w, settings_w->fixedBufferRecorder);
@@ -825,21 +928,39 @@ namespace LLError
 
 namespace
 {
-	void writeToRecorders(AIAccess<LLError::Settings> const& settings_w, LLError::ELevel level, const std::string& message)
+	// What the recorders need, copied out of the settings so that they are
+	// called without holding them (they may log, or look at the settings).
+	// Use with LogLock held, which keeps the recorders from being deleted.
+	struct RecorderList
+	{
+		RecorderList()
+		{
+			AIAccess<LLError::Settings> settings_w(LLError::Settings::get());
+			recorders = settings_w->recorders;
+			timeFunction = settings_w->timeFunction;
+			crashFunction = settings_w->crashFunction;
+		}
+
+		Recorders recorders;
+		LLError::TimeFunction timeFunction;
+		LLError::FatalFunction crashFunction;
+	};
+
+	void writeToRecorders(RecorderList const& list, LLError::ELevel level, const std::string& message)
 	{
 		std::string messageWithTime;
 
-		for (Recorders::const_iterator i = settings_w->recorders.begin();
-			i != settings_w->recorders.end();
+		for (Recorders::const_iterator i = list.recorders.begin();
+			i != list.recorders.end();
 			++i)
 		{
 			LLError::Recorder* r = *i;
 			
-			if (r->wantsTime()  &&  settings_w->timeFunction != NULL)
+			if (r->wantsTime()  &&  list.timeFunction != NULL)
 			{
 				if (messageWithTime.empty())
 				{
-					messageWithTime = settings_w->timeFunction() + " " + message;
+					messageWithTime = list.timeFunction() + " " + message;
 				}
 				
 				r->recordMessage(level, messageWithTime);
@@ -881,9 +1002,6 @@ You get:
 	
 */
 
-apr_thread_mutex_t* gLogMutexp;
-apr_thread_mutex_t* gCallStacksLogMutexp;
-
 namespace {
 	bool checkLevelMap(const LevelMap& map, const std::string& key,
 						LLError::ELevel& level)
@@ -897,68 +1015,179 @@ namespace {
 			level = i->second;
 		return true;
 	}
-	
-	class LogLock
+}
+
+namespace
+{
+	const U32 LOG_QUEUE_SIZE = 1024;				// Messages, must be a power of two.
+	const U32 LOG_QUEUE_MAX_BYTES = 1024 * 1024;	// Text queued per thread before messages get dropped.
+	const U32 LOG_WRITER_INTERVAL_MS = 10;
+
+	// The messages of one thread waiting for the log writer.  Only the
+	// owning thread pushes, and popping is serialized by LogLock, so this
+	// is a single producer, single consumer ring that needs no lock.
+	class LogQueue
 	{
 	public:
-		LogLock();
-		~LogLock();
-		bool ok() const { return mOK; }
+		LogQueue() : mHead(0), mTail(0), mCachedHead(0), mBytes(0), mDropped(0) { }
+
+		// Producer.  Takes the contents of message, returns false (and
+		// counts the message as dropped) if the queue is full.
+		bool push(LLError::ELevel level, std::string& message)
+		{
+			U32 tail = mTail;
+			if (tail - mCachedHead >= LOG_QUEUE_SIZE)
+			{
+				mCachedHead = load(&mHead);
+			}
+			if (tail - mCachedHead >= LOG_QUEUE_SIZE ||
+				mBytes + message.size() > LOG_QUEUE_MAX_BYTES)
+			{
+				apr_atomic_inc32(&mDropped);
+				return false;
+			}
+			Entry& entry = mEntries[tail & (LOG_QUEUE_SIZE - 1)];
+			entry.mLevel = level;
+			entry.mMessage.swap(message);
+			apr_atomic_add32(&mBytes, entry.mMessage.size());
+			apr_atomic_xchg32(&mTail, tail + 1);		// Publishes the entry.
+			return true;
+		}
+
+		// Consumer, call with LogLock held.
+		bool pop(LLError::ELevel& level, std::string& message)
+		{
+			U32 head = mHead;
+			if (head == load(&mTail))
+			{
+				return false;
+			}
+			Entry& entry = mEntries[head & (LOG_QUEUE_SIZE - 1)];
+			level = entry.mLevel;
+			message.swap(entry.mMessage);
+			std::string().swap(entry.mMessage);			// Don't keep the buffer around.
+			apr_atomic_sub32(&mBytes, message.size());
+			apr_atomic_xchg32(&mHead, head + 1);		// Hands the entry back.
+			return true;
+		}
+
+		U32 takeDropped() { return apr_atomic_xchg32(&mDropped, 0); }
+
 	private:
-		bool mLocked;
-		bool mOK;
+		// Read with a full barrier, so that nothing that follows is done before it.
+		static U32 load(volatile apr_uint32_t* value) { return apr_atomic_cas32(value, 0, 0); }
+
+		struct Entry
+		{
+			LLError::ELevel mLevel;
+			std::string mMessage;
+		};
+
+		Entry mEntries[LOG_QUEUE_SIZE];
+		volatile apr_uint32_t mHead;		// Next entry to pop, only written by the consumer.
+		volatile apr_uint32_t mTail;		// Next entry to push, only written by the producer.
+		U32 mCachedHead;					// The producer's last look at mHead.
+		volatile apr_uint32_t mBytes;
+		volatile apr_uint32_t mDropped;
 	};
-	
-	LogLock::LogLock()
-		: mLocked(false), mOK(false)
+
+	ll_thread_local LogQueue* tLogQueue = NULL;
+	ll_thread_local std::ostringstream* tMessageStream = NULL;
+	ll_thread_local bool tMessageStreamInUse = false;
+
+	volatile bool sAsyncLogging = false;
+	volatile apr_uint32_t sDroppedMessages = 0;
+
+	// A thread's queue lives until the thread exits, see freeThreadLogBuffers().
+	LogQueue* getLogQueue()
 	{
-		if (!gLogMutexp)
+		if (!tLogQueue)
+		{
+			tLogQueue = new LogQueue;
+			AIAccess<Globals>(Globals::get())->queues.push_back(tLogQueue);
+		}
+		return tLogQueue;
+	}
+
+	void releaseMessageStream(std::ostringstream* out)
+	{
+		if (out == tMessageStream)
+		{
+			out->clear();
+			out->str("");
+			tMessageStreamInUse = false;
+		}
+		else
+		{
+			delete out;
+		}
+	}
+
+	// Writes out what has been queued so far.  Call with LogLock held.
+	void writeQueuedMessages()
+	{
+		LogQueues queues = AIAccess<Globals>(Globals::get())->queues;
+		if (queues.empty())
 		{
-			mOK = true;
 			return;
 		}
-		
-		const int MAX_RETRIES = 5;
-		for (int attempts = 0; attempts < MAX_RETRIES; ++attempts)
+
+		RecorderList recorders;
+		LLError::ELevel level;
+		std::string message;
+		for (LogQueues::iterator iter = queues.begin(); iter != queues.end(); ++iter)
 		{
-			apr_status_t s = apr_thread_mutex_trylock(gLogMutexp);
-			if (!APR_STATUS_IS_EBUSY(s))
+			// Don't let one busy thread keep us here forever.
+			for (U32 count = 0; count < LOG_QUEUE_SIZE && (*iter)->pop(level, message); ++count)
 			{
-				mLocked = true;
-				mOK = true;
-				return;
+				writeToRecorders(recorders, level, message);
 			}
 
-			ms_sleep(1);
-			//apr_thread_yield();
-				// Just yielding won't necessarily work, I had problems with
-				// this on Linux - doug 12/02/04
+			U32 dropped = (*iter)->takeDropped();
+			if (dropped)
+			{
+				apr_atomic_add32(&sDroppedMessages, dropped);
+				std::ostringstream warning;
+				warning << "WARNING: LLError: dropped " << dropped
+						<< " messages from a thread logging faster than they could be written";
+				writeToRecorders(recorders, LLError::LEVEL_WARN, warning.str());
+			}
 		}
-
-		// We're hosed, we can't get the mutex.  Blah.
-		std::cerr << "LogLock::LogLock: failed to get mutex for log"
-					<< std::endl;
 	}
-	
-	LogLock::~LogLock()
+
+	class LogWriterThread : public LLThread
 	{
-		if (mLocked)
+	public:
+		LogWriterThread() : LLThread("Log writer") { }
+
+	protected:
+		/*virtual*/ void run()
 		{
-			apr_thread_mutex_unlock(gLogMutexp);
+			while (!isQuitting())
+			{
+				ms_sleep(LOG_WRITER_INTERVAL_MS);
+				LogLock lock;
+				if (lock.ok())
+				{
+					writeQueuedMessages();
+				}
+			}
 		}
-	}
+	};
+
+	LogWriterThread* sLogWriter = NULL;
 }
 
 namespace LLError
 {
+	volatile U32 Log::sGeneration = 1;
+
 	bool Log::shouldLog(CallSite& site)
 	{
-		LogLock lock;
-		if (!lock.ok())
-		{
-			return false;
-		}
-		
+		// Look at the generation before the settings: should they change
+		// in between, the decision is cached as already stale.
+		U32 generation = sGeneration & 0x7FFFFFFF;
+
 		AIAccess<Settings> settings_w(Settings::get());
 		
 		settings_w->shouldLogCallCounter += 1;
@@ -982,96 +1211,50 @@ namespace LLError
 		|| checkLevelMap(settings_w->fileLevelMap, abbreviateFile(site.mFile), compareLevel)
 		|| ((site.mBroadTag != NULL) ? checkLevelMap(settings_w->tagLevelMap, site.mBroadTag, compareLevel) : false);
 
-		site.mCached = true;
-		AIAccess<Globals>(Globals::get())->addCallSite(site);
-		return site.mShouldLog = site.mLevel >= compareLevel;
+		bool should_log = site.mLevel >= compareLevel;
+		site.mCache = (generation << 1) | (should_log ? 1 : 0);
+		return should_log;
 	}
 
 
 	std::ostringstream* Log::out()
 	{
-		LogLock lock;
-		if (lock.ok())
+		// Every thread reuses its own stream, unless it is already building
+		// a message on it (something logged from inside an operator<<).
+		if (!tMessageStreamInUse)
 		{
-			AIAccess<Globals> globals(Globals::get());
-
-			if (!globals->messageStreamInUse)
+			if (!tMessageStream)
 			{
-				globals->messageStreamInUse = true;
-				return &globals->messageStream;			// Returns pointer to member of unlocked object, apparently "protected" by having set globals->messageStreamInUse.
+				tMessageStream = new std::ostringstream;
 			}
+			tMessageStreamInUse = true;
+			return tMessageStream;
 		}
 		
-		return new std::ostringstream;				// Holy memory leak.
+		return new std::ostringstream;
 	}
 	
 	void Log::flush(std::ostringstream* out, char* message)
     {
-       LogLock lock;
-       if (!lock.ok())
-       {
-           return;
-       }
-       
-	   if(strlen(out->str().c_str()) < 128)
+	   std::string str = out->str();
+	   if(str.size() < 128)
 	   {
-		   strcpy(message, out->str().c_str());
+		   strcpy(message, str.c_str());
 	   }
 	   else
 	   {
-		   strncpy(message, out->str().c_str(), 127);
+		   strncpy(message, str.c_str(), 127);
 		   message[127] = '\0' ;
 	   }
 	   
-	   AIAccess<Globals> globals(Globals::get());
-       if (out == &globals->messageStream)
-       {
-           globals->messageStream.clear();
-           globals->messageStream.str("");
-           globals->messageStreamInUse = false;
-       }
-       else
-       {
-           delete out;
-       }
+	   releaseMessageStream(out);
 	   return ;
     }
 
 	void Log::flush(std::ostringstream* out, const CallSite& site)
 	{
-		LogLock lock;
-		if (!lock.ok())
-		{
-			return;
-		}
-		
 		std::string message = out->str();
-
-		{
-			AIAccess<Globals> globals(Globals::get());
-			if (out == &globals->messageStream)
-			{
-				globals->messageStream.clear();
-				globals->messageStream.str("");
-				globals->messageStreamInUse = false;
-			}
-			else
-			{
-				delete out;
-			}
-		}
-
-		AIAccess<Settings> settings_w(Settings::get());
-
-		if (site.mLevel == LEVEL_ERROR)
-		{
-			std::ostringstream fatalMessage;
-			fatalMessage << abbreviateFile(site.mFile)
-						<< "(" << site.mLine << ") : error";
-			
-			writeToRecorders(settings_w, site.mLevel, fatalMessage.str());
-		}
-		
+		releaseMessageStream(out);
 		
 		std::ostringstream prefix;
 
@@ -1104,7 +1287,7 @@ namespace LLError
 		
 		if (need_function)
 		{
-			if (settings_w->printLocation)
+			if (sPrintLocation)
 			{
 				prefix << abbreviateFile(site.mFile)
 						<< "(" << site.mLine << ") : ";
@@ -1123,29 +1306,7 @@ namespace LLError
 
 		if (site.mPrintOnce)
 		{
-			std::map<std::string, unsigned int>::iterator messageIter = settings_w->uniqueLogMessages.find(message);
-			if (messageIter != settings_w->uniqueLogMessages.end())
-			{
-				messageIter->second++;
-				unsigned int num_messages = messageIter->second;
-				if (num_messages == 10 || num_messages == 50 || (num_messages % 100) == 0)
-				{
-					prefix << "ONCE (" << num_messages << "th time seen): ";
-				} 
-				else
-				{
-					return;
-				}
-			}
-			else 
-			{
-				prefix << "ONCE: ";
-				settings_w->uniqueLogMessages[message] = 1;
-			}
-		}
-
-		if (site.mPrintOnce)
-		{
+			AIAccess<Settings> settings_w(Settings::get());
 			std::map<std::string, unsigned int>::iterator messageIter = settings_w->uniqueLogMessages.find(message);
 			if (messageIter != settings_w->uniqueLogMessages.end())
 			{
@@ -1169,13 +1330,113 @@ namespace LLError
 		
 		prefix << message;
 		message = prefix.str();
+
+		if (sAsyncLogging && site.mLevel != LEVEL_ERROR)
+		{
+			getLogQueue()->push(site.mLevel, message);
+			return;
+		}
+
+		// Errors must not get lost, wait for the log writer if need be.
+		LogLock lock(site.mLevel == LEVEL_ERROR);
+		if (!lock.ok())
+		{
+			return;
+		}
+
+		if (site.mLevel == LEVEL_ERROR)
+		{
+			// Get out what led up to this before we crash.
+			writeQueuedMessages();
+		}
+
+		RecorderList recorders;
+
+		if (site.mLevel == LEVEL_ERROR)
+		{
+			std::ostringstream fatalMessage;
+			fatalMessage << abbreviateFile(site.mFile)
+						<< "(" << site.mLine << ") : error";
+			
+			writeToRecorders(recorders, site.mLevel, fatalMessage.str());
+		}
 		
-		writeToRecorders(settings_w, site.mLevel, message);
+		writeToRecorders(recorders, site.mLevel, message);
 		
-		if (site.mLevel == LEVEL_ERROR  &&  settings_w->crashFunction)
+		if (site.mLevel == LEVEL_ERROR  &&  recorders.crashFunction)
+		{
+			recorders.crashFunction(message);
+		}
+	}
+
+	void startAsyncLogging()
+	{
+		if (sLogWriter)
+		{
+			return;
+		}
+		sLogWriter = new LogWriterThread;
+		sLogWriter->start();
+		sAsyncLogging = true;
+	}
+
+	void stopAsyncLogging()
+	{
+		if (!sLogWriter)
+		{
+			return;
+		}
+		sAsyncLogging = false;
+		flushAsyncLog();
+		sLogWriter->shutdown();
+		delete sLogWriter;
+		sLogWriter = NULL;
+		// Anything that was being queued while we stopped.
+		flushAsyncLog();
+	}
+
+	void flushAsyncLog()
+	{
+		LogLock lock(true);
+		if (lock.ok())
+		{
+			writeQueuedMessages();
+		}
+	}
+
+	U32 droppedMessageCount()
+	{
+		return apr_atomic_read32(&sDroppedMessages);
+	}
+
+	void freeThreadLogBuffers()
+	{
+		if (!tMessageStreamInUse)
+		{
+			delete tMessageStream;
+			tMessageStream = NULL;
+		}
+
+		if (!tLogQueue)
+		{
+			return;
+		}
+		// The writer only looks at the queues with the lock held.
+		LogLock lock(true);
+		if (!lock.ok())
+		{
+			return;
+		}
+		// Whatever this thread still had queued goes out first.
+		writeQueuedMessages();
 		{
-			settings_w->crashFunction(message);
+			AIAccess<Globals> globals_w(Globals::get());
+			globals_w->queues.erase(
+				std::remove(globals_w->queues.begin(), globals_w->queues.end(), tLogQueue),
+				globals_w->queues.end());
 		}
+		delete tLogQueue;
+		tLogQueue = NULL;
 	}
 }
 
@@ -138,6 +138,10 @@ namespace LLError
 		static std::ostringstream* out();
 		static void flush(std::ostringstream* out, char* message)  ;
 		static void flush(std::ostringstream*, const CallSite&);
+
+		// Bumped whenever the settings change, which invalidates the
+		// decision cached in every CallSite.
+		static volatile U32 sGeneration;
 	};
 	
 	class LL_COMMON_API CallSite
@@ -149,8 +153,13 @@ namespace LLError
 		CallSite(ELevel, const char* file, int line,
 				const std::type_info& class_info, const char* function, const char* broadTag, const char* narrowTag, bool printOnce);
 						
+		// No locking: the cached decision and the settings generation it
+		// was made for share one word, so they are always read together.
 		bool shouldLog()
-			{ return mCached ? mShouldLog : Log::shouldLog(*this); }
+			{
+				U32 cache = mCache;
+				return ((cache >> 1) == (Log::sGeneration & 0x7FFFFFFF)) ? (cache & 1) : Log::shouldLog(*this);
+			}
 			// this member function needs to be in-line for efficiency
 		
 		void invalidate();
@@ -167,8 +176,7 @@ namespace LLError
 		const bool			mPrintOnce;
 		
 		// these implement a cache of the call to shouldLog()
-		bool mCached;
-		bool mShouldLog;
+		U32 mCache;		// (generation << 1) | should log, 0 until decided
 		
 		friend class Log;
 	};
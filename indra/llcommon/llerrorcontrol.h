@@ -162,6 +162,23 @@ namespace LLError
 	LL_COMMON_API std::string logFileName();
 		// returns name of current logging file, empty string if none
 
+	LL_COMMON_API void startAsyncLogging();
+	LL_COMMON_API void stopAsyncLogging();
+		// While started, messages are queued per thread and written to the
+		// recorders by a background thread, so logging threads never wait
+		// for each other or for disk I/O.  LEVEL_ERROR messages are still
+		// written right away, after everything queued before them.  When a
+		// thread queues faster than the writer keeps up, further messages
+		// from it are dropped and counted.
+		// APR must be initialized first; stop before it is shut down.
+	LL_COMMON_API void flushAsyncLog();
+		// writes out everything queued so far, on the calling thread
+	LL_COMMON_API U32 droppedMessageCount();
+		// number of messages dropped since logging started
+	LL_COMMON_API void freeThreadLogBuffers();
+		// writes out and frees the calling thread's queue and message
+		// stream; called by LLThread when a thread exits
+
 
 	/*
 		Utilities for use by the unit tests of LLError itself.
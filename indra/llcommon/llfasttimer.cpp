@@ -35,6 +35,12 @@
 #include "llfasttimer.h"
 #include "llmemory.h"
 #include "llprocessor.h"
+#include "llthread.h"
+#include "apr_atomic.h"
+
+#include <ostream>
+#include <sstream>
+#include <vector>
 
 #if LL_WINDOWS
 #define WIN32_LEAN_AND_MEAN
@@ -42,12 +48,141 @@
 #endif
 #include "lltimer.h"
 
+//////////////////////////////////////////////////////////////////////////////
+// per thread state
+
+namespace
+{
+	struct TraceEvent
+	{
+		U64 mStart;
+		U64 mDuration;
+		U32 mTraceID;
+	};
+}
+
+// Every thread that runs a timer gets one of these.  They are never freed,
+// so that the events of threads that are gone can still be written out.
+struct LLFastTimer::ThreadState
+{
+	ThreadState(U32 tid) : mDepth(0), mEvents(NULL), mEventMask(0), mEventsWritten(0), mTID(tid), mNext(NULL) { }
+
+	S32 mDepth;
+	U64 mStart[FTM_MAX_DEPTH];
+	U64 mChildTime[FTM_MAX_DEPTH];				// Time spent in timers started at the next depth.
+
+	TraceEvent* mEvents;						// Ring buffer of stopped timers, allocated when tracing starts.
+	U32 mEventMask;
+	volatile apr_uint32_t mEventsWritten;
+
+	std::string mName;
+	U32 mTID;
+	ThreadState* mNext;
+};
+
+namespace
+{
+	ll_thread_local LLFastTimer::ThreadState* tThreadState = NULL;
+	LLFastTimer::ThreadState* volatile sThreadStates = NULL;	// List of all of them.
+	LLFastTimer::ThreadState* sMainThreadState = NULL;			// The one of the thread calling reset().
+	volatile apr_uint32_t sNextTID = 0;
+	U32 sTraceEventsPerThread = 0;
+
+	std::vector<const char*>& trace_names()
+	{
+		static std::vector<const char*> names(LLFastTimer::FTM_NUM_TYPES, (const char*)NULL);
+		return names;
+	}
+
+	LLFastTimer::ThreadState* get_thread_state()
+	{
+		LLFastTimer::ThreadState* state = tThreadState;
+		if (!state)
+		{
+			state = new LLFastTimer::ThreadState(apr_atomic_inc32(&sNextTID) + 1);
+			void* head;
+			do
+			{
+				head = (void*)sThreadStates;
+				state->mNext = (LLFastTimer::ThreadState*)head;
+			}
+			while (apr_atomic_casptr((volatile void**)&sThreadStates, state, head) != head);
+			tThreadState = state;
+		}
+		return state;
+	}
+}
+
+LLFastTimer::DeclareTimer::DeclareTimer(const char* name)
+{
+	std::vector<const char*>& names = trace_names();
+	mTraceID = names.size();
+	names.push_back(name);
+}
+
+void LLFastTimer::start(U32 trace_id)
+{
+	ThreadState* state = get_thread_state();
+	mState = state;
+	if (state == sMainThreadState && mType < FTM_NUM_TYPES)
+	{
+		sCurType = mType;
+	}
+	S32 depth = state->mDepth++;
+	if (depth < FTM_MAX_DEPTH)
+	{
+		state->mChildTime[depth] = 0;
+		state->mStart[depth] = getCPUClockCount64();
+	}
+	mTraceID = trace_id;
+}
+
+void LLFastTimer::stop()
+{
+	U64 end = getCPUClockCount64();
+	ThreadState* state = mState;
+	S32 depth = --state->mDepth;
+	if (depth >= FTM_MAX_DEPTH)
+	{
+		return;
+	}
+
+	U64 delta = end - state->mStart[depth];
+	if (depth > 0)
+	{
+		// Declared timers have no accumulator: their own time stays with
+		// the enclosing timer, only their timed children are taken off it.
+		state->mChildTime[depth - 1] += mType < FTM_NUM_TYPES ? delta : state->mChildTime[depth];
+	}
+
+	if (state == sMainThreadState && mType < FTM_NUM_TYPES)
+	{
+		// Only the main thread feeds the per frame accumulators, counting
+		// the time not spent in nested timers.
+		sCounter[mType] += (delta - state->mChildTime[depth]) >> 8;
+		sCalls[mType]++;
+	}
+
+	if (sTracing)
+	{
+		if (!state->mEvents)
+		{
+			state->mEventMask = sTraceEventsPerThread - 1;
+			state->mEvents = new TraceEvent[sTraceEventsPerThread];
+		}
+		U32 written = state->mEventsWritten;
+		TraceEvent& event = state->mEvents[written & state->mEventMask];
+		event.mStart = state->mStart[depth];
+		event.mDuration = delta;
+		event.mTraceID = mTraceID;
+		apr_atomic_xchg32(&state->mEventsWritten, written + 1);
+	}
+}
+
 //////////////////////////////////////////////////////////////////////////////
 // statics
 
 LLFastTimer::EFastTimerType LLFastTimer::sCurType = LLFastTimer::FTM_OTHER;
-int LLFastTimer::sCurDepth = 0;
-U64 LLFastTimer::sStart[LLFastTimer::FTM_MAX_DEPTH];
 U64 LLFastTimer::sCounter[LLFastTimer::FTM_NUM_TYPES];
 U64 LLFastTimer::sCountHistory[LLFastTimer::FTM_HISTORY_NUM][LLFastTimer::FTM_NUM_TYPES];
 U64 LLFastTimer::sCountAverage[LLFastTimer::FTM_NUM_TYPES];
@@ -58,6 +193,7 @@ S32 LLFastTimer::sCurFrameIndex = -1;
 S32 LLFastTimer::sLastFrameIndex = -1;
 int LLFastTimer::sPauseHistory = 0;
 int LLFastTimer::sResetHistory = 0;
+volatile bool LLFastTimer::sTracing = false;
 
 U64 LLFastTimer::sClockResolution = calc_clock_frequency(50U);	// Resolution of get_clock_count()
 
@@ -70,7 +206,12 @@ void LLFastTimer::reset()
 {
 	countsPerSecond(); // good place to calculate clock frequency
 	
-	if (sCurDepth != 0)
+	if (!sMainThreadState)
+	{
+		sMainThreadState = get_thread_state();
+		sMainThreadState->mName = "Main";
+	}
+	if (sMainThreadState->mDepth != 0)
 	{
 		llerrs << "LLFastTimer::Reset() when sCurDepth != 0" << llendl;
 	}
@@ -111,7 +252,123 @@ void LLFastTimer::reset()
 		sCounter[i] = 0;
 		sCalls[i] = 0;
 	}
-	sCurDepth = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// tracing
+
+void LLFastTimer::startTracing(U32 events_per_thread)
+{
+	if (sTracing)
+	{
+		return;
+	}
+	// Buffers of threads that traced before keep their size.
+	U32 size = 1024;
+	while (size < events_per_thread)
+	{
+		size <<= 1;
+	}
+	sTraceEventsPerThread = size;
+	sTracing = true;
+	llinfos << "Fast timer tracing started, " << size << " events per thread." << llendl;
+}
+
+void LLFastTimer::stopTracing()
+{
+	if (sTracing)
+	{
+		sTracing = false;
+		llinfos << "Fast timer tracing stopped." << llendl;
+	}
+}
+
+void LLFastTimer::setThreadName(std::string const& name)
+{
+	get_thread_state()->mName = name;
+}
+
+void LLFastTimer::setTypeName(EFastTimerType type, const char* name)
+{
+	trace_names()[type] = name;
+}
+
+static void write_json_string(std::ostream& out, const char* str)
+{
+	out << '"';
+	for (; *str; ++str)
+	{
+		if (*str == '"' || *str == '\\')
+		{
+			out << '\\';
+		}
+		if ((unsigned char)*str >= ' ')
+		{
+			out << *str;
+		}
+	}
+	out << '"';
+}
+
+void LLFastTimer::writeTrace(std::ostream& out, F64 seconds)
+{
+	U64 now = getCPUClockCount64();
+	U64 window = (U64)(seconds * (F64)sClockResolution);
+	U64 from = (window < now) ? now - window : 0;
+	F64 usec_per_count = 1000000.0 / (F64)sClockResolution;
+	std::vector<const char*>& names = trace_names();
+
+	out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+	bool first = true;
+	for (ThreadState* state = sThreadStates; state; state = state->mNext)
+	{
+		out << (first ? "" : ",\n") << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << state->mTID << ",\"args\":{\"name\":";
+		std::ostringstream name;
+		if (state->mName.empty())
+		{
+			name << "Thread " << state->mTID;
+		}
+		else
+		{
+			name << state->mName;
+		}
+		write_json_string(out, name.str().c_str());
+		out << "}}";
+		first = false;
+
+		if (!state->mEvents)
+		{
+			continue;
+		}
+		// Leave out the oldest eighth of the ring, the thread may be
+		// overwriting it while we read.
+		U32 end = apr_atomic_read32(&state->mEventsWritten);
+		U32 size = state->mEventMask + 1;
+		U32 count = llmin(end, size - size / 8);
+		for (U32 i = end - count; i != end; ++i)
+		{
+			TraceEvent const& event = state->mEvents[i & state->mEventMask];
+			if (event.mStart < from || event.mStart > now || event.mTraceID >= names.size())
+			{
+				continue;
+			}
+			out << ",\n{\"ph\":\"X\",\"cat\":\"fasttimer\",\"pid\":1,\"tid\":" << state->mTID
+				<< ",\"ts\":" << llformat("%.3f", (F64)(event.mStart - from) * usec_per_count)
+				<< ",\"dur\":" << llformat("%.3f", (F64)event.mDuration * usec_per_count)
+				<< ",\"name\":";
+			const char* type_name = names[event.mTraceID];
+			if (type_name)
+			{
+				write_json_string(out, type_name);
+			}
+			else
+			{
+				out << "\"FTM_" << event.mTraceID << '"';
+			}
+			out << '}';
+		}
+	}
+	out << "\n]}\n";
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -33,6 +33,9 @@
 #ifndef LL_LLFASTTIMER_H
 #define LL_LLFASTTIMER_H
 
+#include <iosfwd>
+#include <string>
+
 #define FAST_TIMER_ON 1
 
 
@@ -225,6 +228,27 @@ public:
 	enum { FTM_HISTORY_NUM = 60 };
 	enum { FTM_MAX_DEPTH = 64 };
 	
+	// Timers beyond the fixed ids above can be declared anywhere:
+	//
+	//   static LLFastTimer::DeclareTimer FTM_DECODE_J2C("Decode J2C");
+	//   ...
+	//   LLFastTimer t(FTM_DECODE_J2C);
+	//
+	// They aren't part of the fast timer view, they only show up in
+	// traces.  Declare them at namespace scope (not as function statics),
+	// so that they are all constructed before any thread is started.
+	class LL_COMMON_API DeclareTimer
+	{
+	public:
+		DeclareTimer(const char* name);
+		U32 getTraceID() const { return mTraceID; }
+
+	private:
+		U32 mTraceID;
+	};
+
+	struct ThreadState;
+
 public:
 	static EFastTimerType sCurType;
 
@@ -232,44 +256,40 @@ public:
 	{
 #if FAST_TIMER_ON
 		mType = type;
-		sCurType = type;
-		// These don't get counted, because they use CPU clockticks
-		//gTimerBins[gCurTimerBin]++;
-		//LLTimer::sNumTimerCalls++;
-
-		U64 cpu_clocks =  getCPUClockCount32();
-
-		sStart[sCurDepth] = cpu_clocks;
-		sCurDepth++;
+		start(type);
+#endif
+	};
+	LLFastTimer(DeclareTimer const& timer)
+	{
+#if FAST_TIMER_ON
+		mType = FTM_NUM_TYPES;
+		start(timer.getTraceID());
 #endif
 	};
 	~LLFastTimer()
 	{
 #if FAST_TIMER_ON
-		U64 end,delta;
-		int i;
-
-		// These don't get counted, because they use CPU clockticks
-		//gTimerBins[gCurTimerBin]++;
-		//LLTimer::sNumTimerCalls++;
-		end =  getCPUClockCount32();
-
-		sCurDepth--;
-		delta = end - sStart[sCurDepth];
-		sCounter[mType] += delta;
-		sCalls[mType]++;
-		// Subtract delta from parents
-		for (i=0; i<sCurDepth; i++)
-			sStart[i] += delta;
+		stop();
 #endif
 	}
 
 	static void reset();
 	static U64 countsPerSecond();
 
+	// Tracing: while on, every thread records each timer it stops, with
+	// its start and duration, in a ring buffer of its own.
+	static void startTracing(U32 events_per_thread = 256 * 1024);
+	static void stopTracing();
+	static bool isTracing() { return sTracing; }
+	// Names the calling thread in traces.  LLThreads are named after themselves.
+	static void setThreadName(std::string const& name);
+	// Writes the events of the last 'seconds' recorded by all threads as
+	// Chrome trace event JSON (chrome://tracing, Perfetto).
+	static void writeTrace(std::ostream& out, F64 seconds);
+	// Name of a timer in traces, the fixed ids get their names from the fast timer view.
+	static void setTypeName(EFastTimerType type, const char* name);
+
 public:
-	static int sCurDepth;
-	static U64 sStart[FTM_MAX_DEPTH];
 	static U64 sCounter[FTM_NUM_TYPES];
 	static U64 sCalls[FTM_NUM_TYPES];
 	static U64 sCountAverage[FTM_NUM_TYPES];
@@ -288,6 +308,14 @@ public:
 	static S32 sLastFrameIndex;
 	
 	EFastTimerType mType;
+
+private:
+	void start(U32 trace_id);
+	void stop();
+
+	ThreadState* mState;
+	U32 mTraceID;
+	static volatile bool sTracing;
 };
 
 
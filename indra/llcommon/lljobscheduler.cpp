@@ -0,0 +1,347 @@
+/** 
+ * @file lljobscheduler.cpp
+ * @brief Shared pool of worker threads running short jobs from priority lanes.
+ *
+ * $LicenseInfo:firstyear=2004&license=viewergpl$
+ * 
+ * Copyright (c) 2004-2009, Linden Research, Inc.
+ * 
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ * 
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ * 
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ * 
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+
+#include "linden_common.h"
+#include "lljobscheduler.h"
+
+#include <deque>
+
+#include "llstl.h"
+#include "lltimer.h"
+
+#if LL_WINDOWS
+#	define WIN32_LEAN_AND_MEAN
+#	include <winsock2.h>
+#	include <windows.h>
+#else
+#	include <unistd.h>
+#endif
+
+//============================================================================
+
+class LLJobSchedulerWorker : public LLThread
+{
+public:
+	struct entry_t
+	{
+		entry_t(LLJobScheduler::handle_t handle, LLJobScheduler::Job* job) : mHandle(handle), mJob(job) {}
+		LLJobScheduler::handle_t mHandle;
+		LLJobScheduler::Job* mJob;
+	};
+
+	LLJobSchedulerWorker(const std::string& name, U32 index);
+	~LLJobSchedulerWorker();
+
+	void push(const entry_t& entry, LLJobScheduler::lane_t lane);
+	// The owner takes the oldest job, thieves take the newest one.
+	bool popFront(LLJobScheduler::lane_t lane, entry_t& entry);
+	bool popBack(LLJobScheduler::lane_t lane, entry_t& entry);
+	// MAIN THREAD, once the thread has stopped
+	void deleteQueued();
+
+	void stop() { setQuitting(); }
+
+private:
+	/*virtual*/ void run();
+
+	U32 mIndex;
+	LLMutex mQueueMutex;
+	typedef std::deque<entry_t> job_queue_t;
+	job_queue_t mQueue[LLJobScheduler::LANE_COUNT];
+};
+
+LLJobSchedulerWorker::LLJobSchedulerWorker(const std::string& name, U32 index) :
+	LLThread(name),
+	mIndex(index)
+{
+}
+
+LLJobSchedulerWorker::~LLJobSchedulerWorker()
+{
+	deleteQueued();
+}
+
+void LLJobSchedulerWorker::push(const entry_t& entry, LLJobScheduler::lane_t lane)
+{
+	LLMutexLock lock(&mQueueMutex);
+	mQueue[lane].push_back(entry);
+}
+
+bool LLJobSchedulerWorker::popFront(LLJobScheduler::lane_t lane, entry_t& entry)
+{
+	LLMutexLock lock(&mQueueMutex);
+	if (mQueue[lane].empty())
+	{
+		return false;
+	}
+	entry = mQueue[lane].front();
+	mQueue[lane].pop_front();
+	return true;
+}
+
+bool LLJobSchedulerWorker::popBack(LLJobScheduler::lane_t lane, entry_t& entry)
+{
+	LLMutexLock lock(&mQueueMutex);
+	if (mQueue[lane].empty())
+	{
+		return false;
+	}
+	entry = mQueue[lane].back();
+	mQueue[lane].pop_back();
+	return true;
+}
+
+void LLJobSchedulerWorker::deleteQueued()
+{
+	LLMutexLock lock(&mQueueMutex);
+	for (S32 lane = 0; lane < LLJobScheduler::LANE_COUNT; ++lane)
+	{
+		for (job_queue_t::iterator iter = mQueue[lane].begin(); iter != mQueue[lane].end(); ++iter)
+		{
+			delete iter->mJob;
+		}
+		mQueue[lane].clear();
+	}
+}
+
+//virtual
+void LLJobSchedulerWorker::run()
+{
+	while (!isQuitting())
+	{
+		LLJobScheduler::Job* job = LLJobScheduler::nextJob(mIndex);
+		if (job)
+		{
+			job->run();
+			delete job;
+		}
+		else
+		{
+			LLJobScheduler::waitForWork(this);
+		}
+	}
+	llinfos << "LLJobScheduler " << mName << " EXITING." << llendl;
+}
+
+//============================================================================
+
+LLJobScheduler::worker_list_t LLJobScheduler::sWorkers;
+U32 LLJobScheduler::sNextWorker = 0;
+LLJobScheduler::job_map_t LLJobScheduler::sJobs;
+LLJobScheduler::handle_t LLJobScheduler::sNextHandle = 0;
+LLMutex* LLJobScheduler::sJobsMutex = NULL;
+LLCondition* LLJobScheduler::sWorkCondition = NULL;
+LLAtomicS32 LLJobScheduler::sQueuedCount;
+
+// MAIN THREAD
+//static
+void LLJobScheduler::initClass(U32 num_threads)
+{
+	llassert_always(sWorkers.empty());
+	if (num_threads == 0)
+	{
+		num_threads = llmax(getProcessorCount(), (U32)2) - 1;
+	}
+	sJobsMutex = new LLMutex;
+	sWorkCondition = new LLCondition;
+	sQueuedCount = 0;
+	sNextWorker = 0;
+	for (U32 i = 0; i < num_threads; ++i)
+	{
+		sWorkers.push_back(new LLJobSchedulerWorker(llformat("jobworker%d", i), i));
+	}
+	// Workers look at each other's queues, so none may run before the list is complete
+	for (worker_list_t::iterator iter = sWorkers.begin(); iter != sWorkers.end(); ++iter)
+	{
+		(*iter)->start();
+	}
+	llinfos << "LLJobScheduler started " << num_threads << " workers" << llendl;
+}
+
+// MAIN THREAD
+//static
+void LLJobScheduler::cleanupClass()
+{
+	if (sWorkers.empty())
+	{
+		return;
+	}
+	for (worker_list_t::iterator iter = sWorkers.begin(); iter != sWorkers.end(); ++iter)
+	{
+		(*iter)->stop();
+	}
+	sWorkCondition->lock();
+	sWorkCondition->broadcast();
+	sWorkCondition->unlock();
+
+	// Jobs still running get a few seconds to return
+	S32 timeout = 50;
+	for ( ; timeout > 0; --timeout)
+	{
+		bool stopped = true;
+		for (worker_list_t::iterator iter = sWorkers.begin(); iter != sWorkers.end(); ++iter)
+		{
+			stopped = stopped && (*iter)->isStopped();
+		}
+		if (stopped)
+		{
+			break;
+		}
+		ms_sleep(100);
+	}
+	if (timeout == 0)
+	{
+		llwarns << "LLJobScheduler::cleanupClass() timed out!" << llendl;
+	}
+
+	// Jobs that never started are dropped
+	for_each(sWorkers.begin(), sWorkers.end(), DeletePointer());
+	sWorkers.clear();
+	sJobs.clear();
+	delete sJobsMutex;
+	sJobsMutex = NULL;
+	delete sWorkCondition;
+	sWorkCondition = NULL;
+}
+
+//static
+U32 LLJobScheduler::getProcessorCount()
+{
+#if LL_WINDOWS
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	S32 count = info.dwNumberOfProcessors;
+#else
+	S32 count = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+	return count > 0 ? (U32)count : 1;
+}
+
+// May be called from any thread
+//static
+LLJobScheduler::handle_t LLJobScheduler::post(Job* job, lane_t lane)
+{
+	if (sWorkers.empty())
+	{
+		llwarns << "Job posted while the scheduler is not running" << llendl;
+		delete job;
+		return nullHandle();
+	}
+
+	sJobsMutex->lock();
+	do
+	{
+		++sNextHandle;
+	} while (sNextHandle == nullHandle() || sJobs.find(sNextHandle) != sJobs.end());
+	handle_t handle = sNextHandle;
+	sJobs[handle] = job;
+	LLJobSchedulerWorker* worker = sWorkers[sNextWorker++ % sWorkers.size()];
+	sJobsMutex->unlock();
+
+	// Count it before it can be popped, so nextJob() never takes the count below zero
+	sQueuedCount++;
+	worker->push(LLJobSchedulerWorker::entry_t(handle, job), lane);
+
+	sWorkCondition->lock();
+	sWorkCondition->signal();
+	sWorkCondition->unlock();
+
+	return handle;
+}
+
+// May be called from any thread
+//static
+bool LLJobScheduler::cancel(handle_t handle)
+{
+	if (!sJobsMutex)
+	{
+		return false;
+	}
+	LLMutexLock lock(sJobsMutex);
+	// The entry stays in the worker's queue; the worker drops it when popped
+	return sJobs.erase(handle) != 0;
+}
+
+//static
+S32 LLJobScheduler::getPending()
+{
+	return isRunning() ? (S32)sQueuedCount : 0;
+}
+
+// WORKER THREAD
+//static
+bool LLJobScheduler::claim(handle_t handle)
+{
+	LLMutexLock lock(sJobsMutex);
+	return sJobs.erase(handle) != 0;
+}
+
+// WORKER THREAD
+//static
+LLJobScheduler::Job* LLJobScheduler::nextJob(U32 index)
+{
+	const U32 count = sWorkers.size();
+	for (S32 lane = 0; lane < LANE_COUNT; ++lane)
+	{
+		LLJobSchedulerWorker::entry_t entry(nullHandle(), NULL);
+		bool found = sWorkers[index]->popFront((lane_t)lane, entry);
+		for (U32 i = 1; !found && i < count; ++i)
+		{
+			found = sWorkers[(index + i) % count]->popBack((lane_t)lane, entry);
+		}
+		if (found)
+		{
+			sQueuedCount--;
+			if (claim(entry.mHandle))
+			{
+				return entry.mJob;
+			}
+			// Cancelled; look again
+			delete entry.mJob;
+			--lane;
+		}
+	}
+	return NULL;
+}
+
+// WORKER THREAD
+//static
+void LLJobScheduler::waitForWork(LLJobSchedulerWorker* worker)
+{
+	sWorkCondition->lock();
+	while (sQueuedCount == 0 && !worker->isQuitting())
+	{
+		sWorkCondition->wait();
+	}
+	sWorkCondition->unlock();
+}
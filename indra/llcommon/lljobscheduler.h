@@ -0,0 +1,123 @@
+/** 
+ * @file lljobscheduler.h
+ * @brief Shared pool of worker threads running short jobs from priority lanes.
+ *
+ * $LicenseInfo:firstyear=2004&license=viewergpl$
+ * 
+ * Copyright (c) 2004-2009, Linden Research, Inc.
+ * 
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ * 
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ * 
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ * 
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLJOBSCHEDULER_H
+#define LL_LLJOBSCHEDULER_H
+
+#include <map>
+#include <vector>
+
+#include "llapr.h"
+#include "llthread.h"
+
+//============================================================================
+// A fixed set of worker threads, one per core by default, shared by every
+// client that has short pieces of background work to run.
+// Jobs are posted to one of three priority lanes; each worker has its own
+// queue per lane and steals from the other workers' queues when it runs dry,
+// so a burst of work from one client spreads over all idle cores.
+// Posting returns a handle that can cancel the job as long as it has not
+// started yet.
+
+class LLJobSchedulerWorker;
+
+class LL_COMMON_API LLJobScheduler
+{
+public:
+	enum lane_t {
+		LANE_HIGH = 0,
+		LANE_NORMAL,
+		LANE_LOW,
+		LANE_COUNT
+	};
+
+	typedef U32 handle_t;
+
+	class LL_COMMON_API Job
+	{
+	public:
+		virtual ~Job() {}
+		// Runs on a worker thread. The job is deleted afterwards.
+		virtual void run() = 0;
+	};
+
+public:
+	static handle_t nullHandle() { return handle_t(0); }
+
+	// MAIN THREAD
+	// num_threads == 0 starts one worker per core, less one for the main thread.
+	static void initClass(U32 num_threads);
+	static void cleanupClass();
+
+	static bool isRunning() { return !sWorkers.empty(); }
+	static U32 getWorkerCount() { return sWorkers.size(); }
+	static U32 getProcessorCount();
+
+	// May be called from any thread, including from inside a job.
+	// The scheduler takes ownership of job. Returns nullHandle() (and deletes
+	// the job) when the scheduler is not running.
+	static handle_t post(Job* job, lane_t lane = LANE_NORMAL);
+	// Returns true if the job had not started yet; it is then dropped without
+	// running. Returns false if it is running, has run or never existed.
+	static bool cancel(handle_t handle);
+
+	// Number of jobs posted that have not started yet.
+	static S32 getPending();
+
+private:
+	friend class LLJobSchedulerWorker;
+
+	// Called by worker 'index': the best job in its own queues, or one
+	// stolen from the back of another worker's queues at the same lane.
+	static Job* nextJob(U32 index);
+	// Returns true (and forgets handle) if the job was not cancelled.
+	static bool claim(handle_t handle);
+	static void waitForWork(LLJobSchedulerWorker* worker);
+
+private:
+	typedef std::vector<LLJobSchedulerWorker*> worker_list_t;
+	static worker_list_t sWorkers;
+	static U32 sNextWorker;
+
+	// Jobs posted and not yet started, by handle. A job missing from here
+	// when a worker pops it has been cancelled.
+	typedef std::map<handle_t, Job*> job_map_t;
+	static job_map_t sJobs;
+	static handle_t sNextHandle;
+	static LLMutex* sJobsMutex;
+
+	// Workers sleep here when every queue is empty.
+	static LLCondition* sWorkCondition;
+	static LLAtomicS32 sQueuedCount;
+};
+
+#endif // LL_LLJOBSCHEDULER_H
@@ -45,6 +45,7 @@
 
 #include "llmemory.h"
 #include "llmemtype.h"
+#include "llpoolallocator.h"
 
 //----------------------------------------------------------------------------
 
@@ -156,6 +157,7 @@ void LLMemType::printMem()
 #endif
 	llinfos << llformat("MEM: % 20s %03d MB","MISC",misc_mem>>20) << llendl;
 	llinfos << llformat("MEM: % 20s %03d MB (Max=%d MB)","TOTAL",sTotalMem>>20,sMaxTotalMem>>20) << llendl;
+	LLPoolStats::printStats();
 }
 
 #if MEM_TRACK_MEM
@@ -0,0 +1,381 @@
+/** 
+ * @file llpoolallocator.cpp
+ * @brief Size class pool allocator for small, frequently churned objects.
+ *
+ * $LicenseInfo:firstyear=2005&license=viewergpl$
+ * 
+ * Copyright (c) 2005-2009, Linden Research, Inc.
+ * 
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ * 
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ * 
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ * 
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+
+#include "linden_common.h"
+
+#include "llpoolallocator.h"
+#include "llformat.h"
+#include "llmemory.h"
+#include "llthread.h"
+
+namespace
+{
+	const U32 SLAB_SIZE = 64 * 1024;
+	const U32 BATCH_SIZE = 32;				// Blocks moved between a thread and the shared list at a time.
+	const U32 CACHE_SIZE = 2 * BATCH_SIZE;	// Most free blocks a thread keeps per size class.
+
+	// Overlays a free block; GRANULARITY leaves room for both pointers.
+	struct FreeBlock
+	{
+		FreeBlock* mNext;
+		FreeBlock* mNextBatch;		// Only used in the first block of a shared batch.
+	};
+
+	// The shared free blocks of one size class: full batches, plus what
+	// exiting threads left behind.
+	struct SharedList
+	{
+		volatile apr_uint32_t mLock;
+		FreeBlock* mBatches;
+		FreeBlock* mLoose;
+	};
+
+	// Zero initialized before anything can allocate, so usable from static
+	// constructors, before APR is up.
+	SharedList sShared[LLPoolAllocator::NUM_CLASSES];
+	volatile apr_uint32_t sSlabBytes = 0;
+
+	ll_thread_local FreeBlock* tFree[LLPoolAllocator::NUM_CLASSES];
+	ll_thread_local U32 tFreeCount[LLPoolAllocator::NUM_CLASSES];
+
+	// Counts of the calling thread not published yet, by LLPoolStats index.
+	const S32 PUBLISH_COUNT = 32;
+	ll_thread_local S32 tLiveDelta[LLPoolStats::MAX_CLASSES];
+	ll_thread_local U32 tAllocCount[LLPoolStats::MAX_CLASSES];
+
+	void lock_shared(SharedList& shared)
+	{
+		while (apr_atomic_cas32(&shared.mLock, 1, 0) != 0)
+		{
+			LLThread::yield();
+		}
+	}
+
+	void unlock_shared(SharedList& shared)
+	{
+		apr_atomic_xchg32(&shared.mLock, 0);
+	}
+
+	U32 size_class(size_t size)
+	{
+		return size ? (U32)(size - 1) / LLPoolAllocator::GRANULARITY : 0;
+	}
+
+	// Carves a new slab into blocks, keeps a batch and shares the rest.
+	void new_slab(U32 cls)
+	{
+		U8* slab = (U8*)malloc(SLAB_SIZE);
+		if (!slab)
+		{
+			LLMemory::freeReserve();
+			llerrs << "Out of memory Error" << llendl;
+		}
+		apr_atomic_add32(&sSlabBytes, SLAB_SIZE);
+
+		U32 block_size = (cls + 1) * LLPoolAllocator::GRANULARITY;
+		U32 count = SLAB_SIZE / block_size;
+		FreeBlock* batches = NULL;
+		FreeBlock* loose = NULL;
+		U32 i = 0;
+		while (i < count)
+		{
+			U32 batch_count = llmin(BATCH_SIZE, count - i);
+			FreeBlock* first = (FreeBlock*)(slab + i * block_size);
+			FreeBlock* block = first;
+			for (U32 j = 1; j < batch_count; ++j)
+			{
+				block->mNext = (FreeBlock*)((U8*)block + block_size);
+				block = block->mNext;
+			}
+			block->mNext = NULL;
+			i += batch_count;
+
+			if (!tFree[cls])
+			{
+				tFree[cls] = first;
+				tFreeCount[cls] = batch_count;
+			}
+			else if (batch_count == BATCH_SIZE)
+			{
+				first->mNextBatch = batches;
+				batches = first;
+			}
+			else
+			{
+				block->mNext = loose;
+				loose = first;
+			}
+		}
+
+		if (batches || loose)
+		{
+			SharedList& shared = sShared[cls];
+			lock_shared(shared);
+			while (batches)
+			{
+				FreeBlock* batch = batches;
+				batches = batch->mNextBatch;
+				batch->mNextBatch = shared.mBatches;
+				shared.mBatches = batch;
+			}
+			if (loose)
+			{
+				FreeBlock* last = loose;
+				while (last->mNext)
+				{
+					last = last->mNext;
+				}
+				last->mNext = shared.mLoose;
+				shared.mLoose = loose;
+			}
+			unlock_shared(shared);
+		}
+	}
+
+	// Gets the thread free list of a size class going again once it is empty.
+	void refill(U32 cls)
+	{
+		SharedList& shared = sShared[cls];
+		lock_shared(shared);
+		if (shared.mBatches)
+		{
+			FreeBlock* batch = shared.mBatches;
+			shared.mBatches = batch->mNextBatch;
+			tFree[cls] = batch;
+			tFreeCount[cls] = BATCH_SIZE;
+		}
+		else
+		{
+			U32 count = 0;
+			while (shared.mLoose && count < BATCH_SIZE)
+			{
+				FreeBlock* block = shared.mLoose;
+				shared.mLoose = block->mNext;
+				block->mNext = tFree[cls];
+				tFree[cls] = block;
+				++count;
+			}
+			tFreeCount[cls] = count;
+		}
+		unlock_shared(shared);
+
+		if (!tFree[cls])
+		{
+			new_slab(cls);
+		}
+	}
+
+	// Shares a batch once a thread holds more free blocks than it should.
+	void drain(U32 cls)
+	{
+		FreeBlock* batch = tFree[cls];
+		FreeBlock* last = batch;
+		for (U32 i = 1; i < BATCH_SIZE; ++i)
+		{
+			last = last->mNext;
+		}
+		tFree[cls] = last->mNext;
+		tFreeCount[cls] -= BATCH_SIZE;
+		last->mNext = NULL;
+
+		SharedList& shared = sShared[cls];
+		lock_shared(shared);
+		batch->mNextBatch = shared.mBatches;
+		shared.mBatches = batch;
+		unlock_shared(shared);
+	}
+}
+
+//static
+void* LLPoolAllocator::allocate(size_t size, LLPoolStats& stats)
+{
+	stats.noteAlloc();
+	if (size > MAX_SIZE)
+	{
+		return ::operator new(size);
+	}
+	U32 cls = size_class(size);
+	if (!tFree[cls])
+	{
+		refill(cls);
+	}
+	FreeBlock* block = tFree[cls];
+	tFree[cls] = block->mNext;
+	--tFreeCount[cls];
+	return block;
+}
+
+//static
+void LLPoolAllocator::free(void* p, size_t size, LLPoolStats& stats)
+{
+	stats.noteFree();
+	if (size > MAX_SIZE)
+	{
+		::operator delete(p);
+		return;
+	}
+	U32 cls = size_class(size);
+	FreeBlock* block = (FreeBlock*)p;
+	block->mNext = tFree[cls];
+	tFree[cls] = block;
+	if (++tFreeCount[cls] > CACHE_SIZE)
+	{
+		drain(cls);
+	}
+}
+
+//static
+void LLPoolAllocator::flushThreadCache()
+{
+	for (U32 cls = 0; cls < NUM_CLASSES; ++cls)
+	{
+		FreeBlock* first = tFree[cls];
+		if (!first)
+		{
+			continue;
+		}
+		FreeBlock* last = first;
+		while (last->mNext)
+		{
+			last = last->mNext;
+		}
+		tFree[cls] = NULL;
+		tFreeCount[cls] = 0;
+
+		SharedList& shared = sShared[cls];
+		lock_shared(shared);
+		last->mNext = shared.mLoose;
+		shared.mLoose = first;
+		unlock_shared(shared);
+	}
+
+	for (LLPoolStats* stats = LLPoolStats::getFirst(); stats; stats = stats->getNext())
+	{
+		stats->publish();
+	}
+}
+
+//static
+U32 LLPoolAllocator::getSlabBytes()
+{
+	return apr_atomic_read32(&sSlabBytes);
+}
+
+//----------------------------------------------------------------------------
+
+//static
+LLPoolStats* LLPoolStats::sFirst = NULL;
+//static
+U32 LLPoolStats::sCount = 0;
+
+// Only ever constructed as a static.  The counters are left alone: objects
+// may have been allocated from other static constructors before this one
+// ran, and the counts start zeroed anyway.  Until then the index is 0 too,
+// which has those early allocations counted straight away.
+LLPoolStats::LLPoolStats(const char* name)
+:	mName(name),
+	mNext(sFirst),
+	mIndex(++sCount)
+{
+	sFirst = this;
+}
+
+bool LLPoolStats::countsPerThread() const
+{
+	return mIndex && mIndex < MAX_CLASSES;
+}
+
+void LLPoolStats::noteAlloc()
+{
+	if (!countsPerThread())
+	{
+		U32 live = apr_atomic_inc32(&mLive) + 1;
+		U32 peak;
+		while ((S32)live > (S32)(peak = mPeak) && apr_atomic_cas32(&mPeak, live, peak) != peak)
+		{
+		}
+		apr_atomic_inc32(&mTotal);
+		return;
+	}
+	++tAllocCount[mIndex];
+	if (++tLiveDelta[mIndex] >= PUBLISH_COUNT)
+	{
+		publish();
+	}
+}
+
+void LLPoolStats::noteFree()
+{
+	if (!countsPerThread())
+	{
+		apr_atomic_dec32(&mLive);
+	}
+	else if (--tLiveDelta[mIndex] <= -PUBLISH_COUNT)
+	{
+		publish();
+	}
+}
+
+// Adds the counts of the calling thread to the shared ones.
+void LLPoolStats::publish()
+{
+	if (!countsPerThread())
+	{
+		return;
+	}
+	S32 delta = tLiveDelta[mIndex];
+	U32 allocs = tAllocCount[mIndex];
+	tLiveDelta[mIndex] = 0;
+	tAllocCount[mIndex] = 0;
+
+	U32 live = apr_atomic_add32(&mLive, (U32)delta) + (U32)delta;
+	U32 peak;
+	while ((S32)live > (S32)(peak = mPeak) && apr_atomic_cas32(&mPeak, live, peak) != peak)
+	{
+	}
+	if (allocs)
+	{
+		apr_atomic_add32(&mTotal, allocs);
+	}
+}
+
+//static
+void LLPoolStats::printStats()
+{
+	for (LLPoolStats* stats = sFirst; stats; stats = stats->mNext)
+	{
+		llinfos << llformat("POOL: % 32s %8u live %8u peak %10u allocated", stats->mName,
+							stats->getLive(), stats->getPeak(), stats->getTotal()) << llendl;
+	}
+	llinfos << llformat("POOL: % 32s %03d MB", "SLABS", LLPoolAllocator::getSlabBytes() >> 20) << llendl;
+}
@@ -0,0 +1,129 @@
+/** 
+ * @file llpoolallocator.h
+ * @brief Size class pool allocator for small, frequently churned objects.
+ *
+ * $LicenseInfo:firstyear=2005&license=viewergpl$
+ * 
+ * Copyright (c) 2005-2009, Linden Research, Inc.
+ * 
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ * 
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ * 
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ * 
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+
+#ifndef LL_LLPOOLALLOCATOR_H
+#define LL_LLPOOLALLOCATOR_H
+
+#include "apr_atomic.h"
+
+//
+// Allocator for small objects that are created and destroyed at a high
+// rate.  Blocks come in size classes of GRANULARITY bytes, carved out of
+// slabs that are never handed back to the system.  Every thread keeps a
+// short free list per size class, so that most allocations and frees
+// touch no shared state; surplus blocks move to and from a shared list
+// per size class in batches.
+//
+// A block may be freed by any thread, not just the one that allocated it:
+// it simply joins the free list of the thread freeing it.
+//
+// A class opts in with LL_USE_POOL_ALLOCATOR(Class) in a public section
+// of its declaration and LL_DEFINE_POOL_ALLOCATOR(Class) in its .cpp file.
+// Subclasses inherit the operators and are counted with their base.  The
+// class must have a virtual destructor if it is ever deleted through a
+// base pointer, since the size passed to delete picks the size class.
+//
+
+class LLPoolStats;
+
+class LL_COMMON_API LLPoolAllocator
+{
+public:
+	enum
+	{
+		GRANULARITY = 16,
+		MAX_SIZE = 256,		// Larger objects use the global new and delete.
+		NUM_CLASSES = MAX_SIZE / GRANULARITY
+	};
+
+	static void* allocate(size_t size, LLPoolStats& stats);
+	static void free(void* p, size_t size, LLPoolStats& stats);
+
+	// Hands the free blocks of the calling thread back to the shared lists
+	// and publishes its counts.  LLThread calls it when its thread exits.
+	static void flushThreadCache();
+
+	// Bytes taken from the system for slabs.
+	static U32 getSlabBytes();
+};
+
+// Live and peak object counts of one class using the pool.  Threads count
+// on their own and publish every few dozen allocations, so the figures
+// may lag a little behind.
+class LL_COMMON_API LLPoolStats
+{
+public:
+	enum { MAX_CLASSES = 64 };	// Classes past this count every allocation straight away.
+
+	LLPoolStats(const char* name);
+
+	const char* getName() const						{ return mName; }
+	U32 getLive() const								{ return apr_atomic_read32(const_cast<volatile apr_uint32_t*>(&mLive)); }
+	U32 getPeak() const								{ return apr_atomic_read32(const_cast<volatile apr_uint32_t*>(&mPeak)); }
+	U32 getTotal() const							{ return apr_atomic_read32(const_cast<volatile apr_uint32_t*>(&mTotal)); }
+
+	// All the classes using the pool.
+	static LLPoolStats* getFirst()					{ return sFirst; }
+	LLPoolStats* getNext() const					{ return mNext; }
+
+	// Logs the statistics of every class.
+	static void printStats();
+
+private:
+	friend class LLPoolAllocator;
+
+	bool countsPerThread() const;
+	void noteAlloc();
+	void noteFree();
+	void publish();
+
+	const char* mName;
+	LLPoolStats* mNext;
+	U32 mIndex;
+	volatile apr_uint32_t mLive;
+	volatile apr_uint32_t mPeak;
+	volatile apr_uint32_t mTotal;
+
+	static LLPoolStats* sFirst;
+	static U32 sCount;
+};
+
+#define LL_USE_POOL_ALLOCATOR(T) \
+	static void* operator new(size_t size) { return LLPoolAllocator::allocate(size, sPoolStats); } \
+	static void operator delete(void* p, size_t size) { if (p) LLPoolAllocator::free(p, size, sPoolStats); } \
+	static LLPoolStats sPoolStats
+
+#define LL_DEFINE_POOL_ALLOCATOR(T) \
+	LLPoolStats T::sPoolStats(#T)
+
+#endif // LL_LLPOOLALLOCATOR_H
@@ -31,20 +31,59 @@
 
 #include "linden_common.h"
 #include "llqueuedthread.h"
+#include "llfasttimer.h"
 #include "llstl.h"
 #include "lltimer.h"
 
+static LLFastTimer::DeclareTimer FTM_PROCESS_QUEUED_REQUEST("Queued Request");
+
+//============================================================================
+// One request's worth of work for a pooled queue
+
+class LLQueuedThreadJob : public LLJobScheduler::Job
+{
+public:
+	LLQueuedThreadJob(LLQueuedThread* queue) : mQueue(queue), mHandle(LLJobScheduler::nullHandle()) {}
+	/*virtual*/ void run() { mQueue->runJob(this); }
+
+	LLQueuedThread* mQueue;
+	LLJobScheduler::handle_t mHandle; // set by postJobs() under lockData()
+};
+
+static LLJobScheduler::lane_t lane_for_priority(U32 priority)
+{
+	U32 pri = priority & LLQueuedThread::PRIORITY_HIGHBITS;
+	if (pri >= LLQueuedThread::PRIORITY_HIGH)
+	{
+		return LLJobScheduler::LANE_HIGH;
+	}
+	else if (pri >= LLQueuedThread::PRIORITY_NORMAL)
+	{
+		return LLJobScheduler::LANE_NORMAL;
+	}
+	return LLJobScheduler::LANE_LOW;
+}
+
 //============================================================================
 
 // MAIN THREAD
-LLQueuedThread::LLQueuedThread(const std::string& name, bool threaded) :
+LLQueuedThread::LLQueuedThread(const std::string& name, bool threaded, S32 max_jobs) :
 	LLThread(name),
 	mThreaded(threaded),
 	mIdleThread(TRUE),
+	mPooled(threaded && max_jobs > 0 && LLJobScheduler::isRunning()),
+	mMaxJobs(max_jobs),
+	mActiveJobs(0),
 	mNextHandle(0),
 	mStarted(FALSE)
 {
-	if (mThreaded)
+	if (mPooled)
+	{
+		// No thread of our own, the scheduler workers pick up our requests
+		mStatus = RUNNING;
+		mStarted = TRUE;
+	}
+	else if (mThreaded)
 	{
 		start();
 	}
@@ -66,7 +105,39 @@ void LLQueuedThread::shutdown()
 	setQuitting();
 
 	unpause(); // MAIN THREAD
-	if (mThreaded)
+	if (mPooled)
+	{
+		// Take back the jobs that have not started, then wait for the running ones
+		lockData();
+		for (job_handle_set_t::iterator iter = mJobHandles.begin(); iter != mJobHandles.end(); ++iter)
+		{
+			if (LLJobScheduler::cancel(*iter))
+			{
+				--mActiveJobs;
+			}
+		}
+		mJobHandles.clear();
+		unlockData();
+
+		S32 timeout = 100;
+		for ( ; timeout>0; timeout--)
+		{
+			lockData();
+			bool done = (mActiveJobs == 0);
+			unlockData();
+			if (done)
+			{
+				break;
+			}
+			ms_sleep(100);
+		}
+		if (timeout == 0)
+		{
+			llwarns << "~LLQueuedThread (" << mName << ") timed out!" << llendl;
+		}
+		mStatus = STOPPED;
+	}
+	else if (mThreaded)
 	{
 		S32 timeout = 100;
 		for ( ; timeout>0; timeout--)
@@ -134,8 +205,14 @@ S32 LLQueuedThread::updateQueue(U32 max_time_ms)
 		pending = getPending();
 		if(pending > 0)
 		{
-		unpause();
-	}
+			unpause();
+			if (mPooled)
+			{
+				lockData();
+				postJobs();
+				unlockData();
+			}
+		}
 	}
 	else
 	{
@@ -154,7 +231,13 @@ void LLQueuedThread::incQueue()
 	// Something has been added to the queue
 	if (!isPaused())
 	{
-		if (mThreaded)
+		if (mPooled)
+		{
+			lockData();
+			postJobs();
+			unlockData();
+		}
+		else if (mThreaded)
 		{
 			wake(); // Wake the thread up if necessary.
 		}
@@ -441,7 +524,11 @@ S32 LLQueuedThread::processNextRequest()
 	if (req)
 	{
 		// process request
-		bool complete = req->processRequest();
+		bool complete;
+		{
+			LLFastTimer t(FTM_PROCESS_QUEUED_REQUEST);
+			complete = req->processRequest();
+		}
 
 		if (complete)
 		{
@@ -462,7 +549,7 @@ S32 LLQueuedThread::processNextRequest()
 			req->setStatus(STATUS_QUEUED);
 			mRequestQueue.insert(req);
 			unlockData();
-			if (mThreaded && start_priority < PRIORITY_NORMAL)
+			if (mThreaded && !mPooled && start_priority < PRIORITY_NORMAL)
 			{
 				ms_sleep(1); // sleep the thread a little
 			}
@@ -518,6 +605,56 @@ void LLQueuedThread::run()
 	llinfos << "LLQueuedThread " << mName << " EXITING." << llendl;
 }
 
+//============================================================================
+// Pooled mode
+
+// Any thread, lockData() held
+void LLQueuedThread::postJobs()
+{
+	if (!mPooled || isQuitting() || isPaused())
+	{
+		return;
+	}
+	// One job per queued request, up to mMaxJobs running or waiting to run
+	S32 pending = mRequestQueue.size();
+	while (mActiveJobs < mMaxJobs && (S32)mJobHandles.size() < pending)
+	{
+		LLQueuedThreadJob* job = new LLQueuedThreadJob(this);
+		LLJobScheduler::lane_t lane = lane_for_priority((*mRequestQueue.begin())->getPriority());
+		job->mHandle = LLJobScheduler::post(job, lane);
+		if (job->mHandle == LLJobScheduler::nullHandle())
+		{
+			break; // scheduler is gone, job was deleted
+		}
+		mJobHandles.insert(job->mHandle);
+		++mActiveJobs;
+		mIdleThread = FALSE;
+	}
+}
+
+// Runs on a LLJobScheduler worker
+void LLQueuedThread::runJob(LLQueuedThreadJob* job)
+{
+	lockData();
+	mJobHandles.erase(job->mHandle);
+	unlockData();
+
+	if (!isQuitting() && !isPaused())
+	{
+		processNextRequest();
+	}
+
+	lockData();
+	--mActiveJobs;
+	postJobs();
+	if (mActiveJobs == 0)
+	{
+		mIdleThread = TRUE;
+	}
+	// Must not touch this after unlocking; shutdown() may be waiting to delete us
+	unlockData();
+}
+
 // virtual
 void LLQueuedThread::startThread()
 {
@@ -535,6 +672,8 @@ void LLQueuedThread::threadedUpdate()
 
 //============================================================================
 
+LL_DEFINE_POOL_ALLOCATOR(LLQueuedThread::QueuedRequest);
+
 LLQueuedThread::QueuedRequest::QueuedRequest(LLQueuedThread::handle_t handle, U32 priority, U32 flags) :
 	LLSimpleHashEntry<LLQueuedThread::handle_t>(handle),
 	mStatus(STATUS_UNKNOWN),
@@ -41,11 +41,22 @@
 #include "llapr.h"
 
 #include "llthread.h"
+#include "lljobscheduler.h"
 #include "llsimplehash.h"
+#include "llpoolallocator.h"
+
+class LLQueuedThreadJob;
 
 //============================================================================
 // Note: ~LLQueuedThread is O(N) N=# of queued threads, assumed to be small
 //   It is assumed that LLQueuedThreads are rarely created/destroyed.
+//
+// When threaded and LLJobScheduler is running, requests are run as jobs on
+// the shared scheduler workers instead of on a thread of our own, at most
+// max_jobs of them at the same time (1 keeps requests serialized exactly as
+// on a dedicated thread). Queues that need startThread(), endThread() or
+// threadedUpdate(), or whose requests must stay on one OS thread, pass
+// max_jobs = 0 to keep a dedicated thread.
 
 class LL_COMMON_API LLQueuedThread : public LLThread
 {
@@ -88,6 +99,8 @@ public:
 		virtual ~QueuedRequest(); // use deleteRequest()
 		
 	public:
+		LL_USE_POOL_ALLOCATOR(QueuedRequest);
+
 		QueuedRequest(handle_t handle, U32 priority, U32 flags = 0);
 
 		status_t getStatus()
@@ -154,7 +167,7 @@ public:
 	static handle_t nullHandle() { return handle_t(0); }
 	
 public:
-	LLQueuedThread(const std::string& name, bool threaded = true);
+	LLQueuedThread(const std::string& name, bool threaded = true, S32 max_jobs = 1);
 	virtual ~LLQueuedThread();	
 	virtual void shutdown();
 	
@@ -175,6 +188,11 @@ protected:
 	S32  processNextRequest(void);
 	void incQueue();
 
+private:
+	friend class LLQueuedThreadJob;
+	void postJobs(); // lockData() must be held
+	void runJob(LLQueuedThreadJob* job);
+
 public:
 	bool waitForResult(handle_t handle, bool auto_complete = true);
 
@@ -186,6 +204,7 @@ public:
 
 	virtual S32 getPending();
 	bool getThreaded() { return mThreaded ? true : false; }
+	bool getPooled() { return mPooled ? true : false; }
 
 	// Request accessors
 	status_t getRequestStatus(handle_t handle);
@@ -204,6 +223,13 @@ protected:
 	BOOL mThreaded;  // if false, run on main thread and do updates during update()
 	BOOL mStarted;  // required when mThreaded is false to call startThread() from update()
 	LLAtomic32<BOOL> mIdleThread; // request queue is empty (or we are quitting) and the thread is idle
+	BOOL mPooled; // if true, requests run as LLJobScheduler jobs instead of on our own thread
+	S32 mMaxJobs; // jobs allowed to run at the same time when pooled
+
+	// Pooled mode, guarded by lockData()
+	S32 mActiveJobs; // posted or running
+	typedef std::set<LLJobScheduler::handle_t> job_handle_set_t;
+	job_handle_set_t mJobHandles; // posted, not started yet
 	
 	typedef std::set<QueuedRequest*, queued_request_less> request_queue_t;
 	request_queue_t mRequestQueue;
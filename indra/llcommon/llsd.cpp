@@ -38,6 +38,10 @@
 #include "llformat.h"
 #include "llsdserialize.h"
 
+#include "llpoolallocator.h"
+#include "llthread.h"
+#include "apr_atomic.h"
+
 #ifndef LL_RELEASE_FOR_DOWNLOAD
 #define NAME_UNNAMED_NAMESPACE
 #endif
@@ -81,6 +85,9 @@ protected:
 	bool shared() const							{ return mUseCount > 1; }
 	
 public:
+	LL_USE_POOL_ALLOCATOR(LLSD::Impl);
+		///< Impls are small and made and dropped at a high rate
+	
 	static void reset(Impl*& var, Impl* impl);
 		///< safely set var to refer to the new impl (possibly shared)
 		
@@ -130,7 +137,7 @@ public:
 	virtual const LLSD& ref(Integer) const		{ return undef(); }
 
 	virtual LLSD::map_const_iterator beginMap() const { return endMap(); }
-	virtual LLSD::map_const_iterator endMap() const { static const std::map<String, LLSD> empty; return empty.end(); }
+	virtual LLSD::map_const_iterator endMap() const { return LLSD::map_const_iterator(); }
 	virtual LLSD::array_const_iterator beginArray() const { return endArray(); }
 	virtual LLSD::array_const_iterator endArray() const { static const std::vector<LLSD> empty; return empty.end(); }
 
@@ -330,18 +337,159 @@ namespace
 	};
 
 
+	//
+	// The key table.  It is plain old data so that it works during static
+	// initialization, before APR is, and it is guarded by a spin lock as
+	// each visit is short.  A key is only ever unlinked with the lock held
+	// and its last reference being dropped, so interning, which also holds
+	// the lock, never revives a key being deleted.
+	//
+	LLSDMapKey** sKeyBuckets = NULL;
+	U32 sKeyBucketCount = 0;
+	U32 sKeyCount = 0;
+	volatile apr_uint32_t sKeyLock = 0;
+
+	void lock_keys()
+	{
+		while (apr_atomic_cas32(&sKeyLock, 1, 0) != 0)
+		{
+			LLThread::yield();
+		}
+	}
+
+	void unlock_keys()
+	{
+		apr_atomic_xchg32(&sKeyLock, 0);
+	}
+
+	U32 hash_key(const LLSD::String& k)
+	{
+		U32 hash = 0;
+		for (LLSD::String::const_iterator i = k.begin(); i != k.end(); ++i)
+		{
+			hash = ((hash << 5) + hash) + (U8)*i;
+		}
+		return hash;
+	}
+
+	void grow_key_table()
+	{
+		U32 count = sKeyBucketCount ? sKeyBucketCount * 2 : 256;
+		LLSDMapKey** buckets = new LLSDMapKey*[count];
+		memset(buckets, 0, count * sizeof(LLSDMapKey*));	/* Flawfinder: ignore */
+		for (U32 i = 0; i < sKeyBucketCount; ++i)
+		{
+			LLSDMapKey* key = sKeyBuckets[i];
+			while (key)
+			{
+				LLSDMapKey* next = key->mNext;
+				LLSDMapKey*& bucket = buckets[key->mHash & (count - 1)];
+				key->mNext = bucket;
+				bucket = key;
+				key = next;
+			}
+		}
+		delete[] sKeyBuckets;
+		sKeyBuckets = buckets;
+		sKeyBucketCount = count;
+	}
+
+	// Returns the interned copy of k, with a reference added for the caller.
+	LLSDMapKey* intern_key(const LLSD::String& k)
+	{
+		U32 hash = hash_key(k);
+		lock_keys();
+		if (sKeyCount >= sKeyBucketCount)
+		{
+			grow_key_table();
+		}
+		LLSDMapKey*& bucket = sKeyBuckets[hash & (sKeyBucketCount - 1)];
+		LLSDMapKey* key = bucket;
+		while (key && (key->mHash != hash || key->mString != k))
+		{
+			key = key->mNext;
+		}
+		if (key)
+		{
+			apr_atomic_inc32(&key->mRefs);
+		}
+		else
+		{
+			key = new LLSDMapKey;
+			key->mString = k;
+			key->mRefs = 1;
+			key->mHash = hash;
+			key->mNext = bucket;
+			bucket = key;
+			++sKeyCount;
+		}
+		unlock_keys();
+		return key;
+	}
+
+	// Only for a key the caller already holds a reference to.
+	void add_key_ref(LLSDMapKey* key)
+	{
+		apr_atomic_inc32(&key->mRefs);
+	}
+
+	void release_key(LLSDMapKey* key)
+	{
+		while (true)
+		{
+			apr_uint32_t refs = apr_atomic_read32(&key->mRefs);
+			if (refs > 1)
+			{
+				if (apr_atomic_cas32(&key->mRefs, refs - 1, refs) == refs)
+				{
+					return;
+				}
+				continue;
+			}
+
+			lock_keys();
+			if (!apr_atomic_dec32(&key->mRefs))
+			{
+				LLSDMapKey** link = &sKeyBuckets[key->mHash & (sKeyBucketCount - 1)];
+				while (*link != key)
+				{
+					link = &(*link)->mNext;
+				}
+				*link = key->mNext;
+				--sKeyCount;
+				delete key;
+			}
+			unlock_keys();
+			return;
+		}
+	}
+
+	//
+	// A map is an array of entries sorted by key.  The values are kept in
+	// blocks that never move, so that references to them stay good however
+	// the map grows, as they did with a std::map.  The first few values fit
+	// in the map itself, which is all that most maps need.
+	//
 	class ImplMap : public LLSD::Impl
 	{
 	private:
-		typedef std::map<LLSD::String, LLSD>	DataMap;
+		typedef std::vector<LLSDMapEntry>	DataVector;
 		
-		DataMap mData;
+		DataVector mData;
+
+		enum { INLINE_VALUES = 4 };
+		LLSD mInlineValues[INLINE_VALUES];
+		std::vector<LLSD*> mValueBlocks;
+		LLSD* mNextValue;			// Next unused value in the last block.
+		LLSD* mValuesEnd;			// End of the last block.
+		std::vector<LLSD*> mFreeValues;	// Erased values, to be reused.
 		
 	protected:
-		ImplMap(const DataMap& data) : mData(data) { }
+		ImplMap(const ImplMap& other);
 		
 	public:
-		ImplMap() { }
+		ImplMap() : mNextValue(mInlineValues), mValuesEnd(mInlineValues + INLINE_VALUES) { }
+		virtual ~ImplMap();
 		
 		virtual ImplMap& makeMap(LLSD::Impl*&);
 
@@ -362,17 +510,56 @@ namespace
 
 		virtual int size() const { return mData.size(); }
 
-		LLSD::map_iterator beginMap() { return mData.begin(); }
-		LLSD::map_iterator endMap() { return mData.end(); }
-		virtual LLSD::map_const_iterator beginMap() const { return mData.begin(); }
-		virtual LLSD::map_const_iterator endMap() const { return mData.end(); }
+		LLSD::map_iterator beginMap() { return LLSD::map_iterator(entries()); }
+		LLSD::map_iterator endMap() { return LLSD::map_iterator(entries() + mData.size()); }
+		virtual LLSD::map_const_iterator beginMap() const { return LLSD::map_const_iterator(entries()); }
+		virtual LLSD::map_const_iterator endMap() const { return LLSD::map_const_iterator(entries() + mData.size()); }
+
+	private:
+		LLSDMapEntry* entries()				{ return mData.empty() ? NULL : &mData[0]; }
+		const LLSDMapEntry* entries() const	{ return mData.empty() ? NULL : &mData[0]; }
+
+		// First entry whose key is not less than k.
+		DataVector::iterator lowerBound(const LLSD::String& k);
+		DataVector::const_iterator lowerBound(const LLSD::String& k) const;
+		static bool matches(const LLSDMapEntry& entry, const LLSD::String& k)
+			{ return &entry.mKey->mString == &k || entry.mKey->mString == k; }
+
+		DataVector::iterator insertEntry(DataVector::iterator where, const LLSD::String& k);
+		LLSD* newValue();
 	};
+
+	ImplMap::ImplMap(const ImplMap& other)
+		: LLSD::Impl(),
+		  mNextValue(mInlineValues), mValuesEnd(mInlineValues + INLINE_VALUES)
+	{
+		mData.reserve(other.mData.size());
+		for (DataVector::const_iterator i = other.mData.begin(); i != other.mData.end(); ++i)
+		{
+			add_key_ref(i->mKey);
+			LLSDMapEntry entry = { i->mKey, newValue() };
+			*entry.mValue = *i->mValue;
+			mData.push_back(entry);
+		}
+	}
+
+	ImplMap::~ImplMap()
+	{
+		for (DataVector::iterator i = mData.begin(); i != mData.end(); ++i)
+		{
+			release_key(i->mKey);
+		}
+		for (std::vector<LLSD*>::iterator i = mValueBlocks.begin(); i != mValueBlocks.end(); ++i)
+		{
+			delete[] *i;
+		}
+	}
 	
 	ImplMap& ImplMap::makeMap(LLSD::Impl*& var)
 	{
 		if (shared())
 		{
-			ImplMap* i = new ImplMap(mData);
+			ImplMap* i = new ImplMap(*this);
 			Impl::assign(var, i);
 			return *i;
 		}
@@ -381,43 +568,118 @@ namespace
 			return *this;
 		}
 	}
+
+	ImplMap::DataVector::iterator ImplMap::lowerBound(const LLSD::String& k)
+	{
+		DataVector::iterator first = mData.begin();
+		S32 count = mData.size();
+		while (count > 0)
+		{
+			S32 half = count >> 1;
+			DataVector::iterator middle = first + half;
+			if (&middle->mKey->mString == &k)
+			{
+				return middle;
+			}
+			if (middle->mKey->mString < k)
+			{
+				first = middle + 1;
+				count -= half + 1;
+			}
+			else
+			{
+				count = half;
+			}
+		}
+		return first;
+	}
+
+	ImplMap::DataVector::const_iterator ImplMap::lowerBound(const LLSD::String& k) const
+	{
+		return const_cast<ImplMap*>(this)->lowerBound(k);
+	}
+
+	ImplMap::DataVector::iterator ImplMap::insertEntry(DataVector::iterator where, const LLSD::String& k)
+	{
+		LLSDMapEntry entry = { intern_key(k), newValue() };
+		return mData.insert(where, entry);
+	}
+
+	LLSD* ImplMap::newValue()
+	{
+		if (!mFreeValues.empty())
+		{
+			LLSD* value = mFreeValues.back();
+			mFreeValues.pop_back();
+			return value;
+		}
+		if (mNextValue == mValuesEnd)
+		{
+			// Each block doubles the room there is.
+			S32 count = INLINE_VALUES;
+			for (std::vector<LLSD*>::size_type i = 0; i < mValueBlocks.size(); ++i)
+			{
+				count *= 2;
+			}
+			mNextValue = new LLSD[count];
+			mValuesEnd = mNextValue + count;
+			mValueBlocks.push_back(mNextValue);
+		}
+		return mNextValue++;
+	}
 	
 	bool ImplMap::has(const LLSD::String& k) const
 	{
-		DataMap::const_iterator i = mData.find(k);
-		return i != mData.end();
+		DataVector::const_iterator i = lowerBound(k);
+		return i != mData.end() && matches(*i, k);
 	}
 	
 	LLSD ImplMap::get(const LLSD::String& k) const
 	{
-		DataMap::const_iterator i = mData.find(k);
-		return (i != mData.end()) ? i->second : LLSD();
+		DataVector::const_iterator i = lowerBound(k);
+		return (i != mData.end() && matches(*i, k)) ? *i->mValue : LLSD();
 	}
 	
 	void ImplMap::insert(const LLSD::String& k, const LLSD& v)
 	{
-		mData.insert(DataMap::value_type(k, v));
+		DataVector::iterator i = lowerBound(k);
+		if (i == mData.end() || !matches(*i, k))
+		{
+			*insertEntry(i, k)->mValue = v;
+		}
 	}
 	
 	void ImplMap::erase(const LLSD::String& k)
 	{
-		mData.erase(k);
+		DataVector::iterator i = lowerBound(k);
+		if (i != mData.end() && matches(*i, k))
+		{
+			i->mValue->clear();
+			mFreeValues.push_back(i->mValue);
+			release_key(i->mKey);
+			mData.erase(i);
+		}
 	}
 	
 	LLSD& ImplMap::ref(const LLSD::String& k)
 	{
-		return mData[k];
+		DataVector::iterator i = lowerBound(k);
+		if (i == mData.end() || !matches(*i, k))
+		{
+			i = insertEntry(i, k);
+		}
+		return *i->mValue;
 	}
 	
 	const LLSD& ImplMap::ref(const LLSD::String& k) const
 	{
-		DataMap::const_iterator i = mData.lower_bound(k);
-		if (i == mData.end()  ||  mData.key_comp()(k, i->first))
+		DataVector::const_iterator i = lowerBound(k);
+		if (i == mData.end() || !matches(*i, k))
 		{
 			return undef();
 		}
 		
-		return i->second;
+		return *i->mValue;
 	}
 
 	class ImplArray : public LLSD::Impl
@@ -664,6 +926,7 @@ const LLSD& LLSD::Impl::undef()
 
 U32 LLSD::Impl::sAllocationCount = 0;
 U32 LLSD::Impl::sOutstandingCount = 0;
+LL_DEFINE_POOL_ALLOCATOR(LLSD::Impl);
 
 
 
@@ -800,6 +1063,7 @@ const LLSD& LLSD::operator[](Integer i) const
 
 U32 LLSD::allocationCount()				{ return Impl::sAllocationCount; }
 U32 LLSD::outstandingCount()			{ return Impl::sOutstandingCount; }
+U32 LLSD::internedKeyCount()			{ return sKeyCount; }
 
 static const char *llsd_dump(const LLSD &llsd, bool useXMLFormat)
 {
@@ -33,6 +33,7 @@
 #ifndef LL_LLSD_NEW_H
 #define LL_LLSD_NEW_H
 
+#include <iterator>
 #include <map>
 #include <string>
 #include <vector>
@@ -255,8 +256,12 @@ public:
 	//@{
 		int size() const;
 
-		typedef std::map<String, LLSD>::iterator		map_iterator;
-		typedef std::map<String, LLSD>::const_iterator	map_const_iterator;
+		// Maps are kept as arrays sorted by key, iterators walk them in the
+		// same order as a std::map would.  iter->first and iter->second are
+		// references to the key and the value, which stay put as the map
+		// grows; the iterators themselves don't.
+		class map_iterator;
+		class map_const_iterator;
 		
 		map_iterator		beginMap();
 		map_iterator		endMap();
@@ -336,6 +341,7 @@ private:
 public:
 		static U32 allocationCount();	///< how many Impls have been made
 		static U32 outstandingCount();	///< how many Impls are still alive
+		static U32 internedKeyCount();	///< how many distinct map keys are in use
 	//@}
 
 private:
@@ -349,6 +355,100 @@ private:
 	//@}
 };
 
+/**
+ * Map keys are interned: each distinct key string is kept once, in a table
+ * shared by all maps on all threads, for as long as some map uses it.
+ */
+struct LLSDMapKey
+{
+	LLSD::String mString;
+	volatile U32 mRefs;
+	U32 mHash;
+	LLSDMapKey* mNext;	// Next in its hash bucket.
+};
+
+/**
+ * One element of a map.  The values live in blocks of their own, so that
+ * they don't move when elements are inserted in front of them.
+ */
+struct LLSDMapEntry
+{
+	LLSDMapKey* mKey;
+	LLSD* mValue;
+};
+
+/**
+ * What a map iterator points at, standing in for the
+ * std::pair<const std::string, LLSD> of a std::map.
+ */
+template<class V>
+class LLSDMapPair
+{
+public:
+	LLSDMapPair(const LLSD::String& key, V& value) : first(key), second(value) { }
+
+	const LLSDMapPair* operator->() const	{ return this; }
+
+	const LLSD::String& first;
+	V& second;
+};
+
+class LLSD::map_iterator
+{
+public:
+	typedef std::bidirectional_iterator_tag iterator_category;
+	typedef LLSDMapPair<LLSD> value_type;
+	typedef std::ptrdiff_t difference_type;
+	typedef LLSDMapPair<LLSD> pointer;
+	typedef LLSDMapPair<LLSD> reference;
+
+	map_iterator() : mEntry(NULL) { }
+	explicit map_iterator(LLSDMapEntry* entry) : mEntry(entry) { }
+
+	reference operator*() const		{ return reference(mEntry->mKey->mString, *mEntry->mValue); }
+	pointer operator->() const		{ return **this; }
+
+	map_iterator& operator++()		{ ++mEntry; return *this; }
+	map_iterator operator++(int)	{ map_iterator old(*this); ++mEntry; return old; }
+	map_iterator& operator--()		{ --mEntry; return *this; }
+	map_iterator operator--(int)	{ map_iterator old(*this); --mEntry; return old; }
+
+	bool operator==(const map_iterator& rhs) const	{ return mEntry == rhs.mEntry; }
+	bool operator!=(const map_iterator& rhs) const	{ return mEntry != rhs.mEntry; }
+
+private:
+	friend class LLSD::map_const_iterator;
+	LLSDMapEntry* mEntry;
+};
+
+class LLSD::map_const_iterator
+{
+public:
+	typedef std::bidirectional_iterator_tag iterator_category;
+	typedef LLSDMapPair<const LLSD> value_type;
+	typedef std::ptrdiff_t difference_type;
+	typedef LLSDMapPair<const LLSD> pointer;
+	typedef LLSDMapPair<const LLSD> reference;
+
+	map_const_iterator() : mEntry(NULL) { }
+	explicit map_const_iterator(const LLSDMapEntry* entry) : mEntry(entry) { }
+	map_const_iterator(const map_iterator& iter) : mEntry(iter.mEntry) { }
+
+	reference operator*() const				{ return reference(mEntry->mKey->mString, *mEntry->mValue); }
+	pointer operator->() const				{ return **this; }
+
+	map_const_iterator& operator++()		{ ++mEntry; return *this; }
+	map_const_iterator operator++(int)		{ map_const_iterator old(*this); ++mEntry; return old; }
+	map_const_iterator& operator--()		{ --mEntry; return *this; }
+	map_const_iterator operator--(int)		{ map_const_iterator old(*this); --mEntry; return old; }
+
+	bool operator==(const map_const_iterator& rhs) const	{ return mEntry == rhs.mEntry; }
+	bool operator!=(const map_const_iterator& rhs) const	{ return mEntry != rhs.mEntry; }
+
+private:
+	const LLSDMapEntry* mEntry;
+};
+
 struct llsd_select_bool : public std::unary_function<LLSD, LLSD::Boolean>
 {
 	LLSD::Boolean operator()(const LLSD& sd) const
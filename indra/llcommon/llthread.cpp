@@ -36,6 +36,9 @@
 
 #include "llthread.h"
 
+#include "llerrorcontrol.h"
+#include "llfasttimer.h"
+#include "llpoolallocator.h"
 #include "lltimer.h"
 
 #if LL_LINUX || LL_SOLARIS
@@ -96,6 +99,9 @@ void *APR_THREAD_FUNC LLThread::staticRun(apr_thread_t *apr_threadp, void *datap
 	// Create a thread local data.
 	AIThreadLocalData::create(threadp);
 
+	// Show up by name in fast timer traces.
+	LLFastTimer::setThreadName(threadp->mName);
+
 	// Run the user supplied function
 	threadp->run();
 
@@ -114,6 +120,11 @@ void *APR_THREAD_FUNC LLThread::staticRun(apr_thread_t *apr_threadp, void *datap
 	// the critical area of the mSignal lock)].
 	llinfos << "LLThread::staticRun() Exiting: " << name << llendl;
 
+	// Don't strand the free blocks this thread was holding on to, or its
+	// log buffers.
+	LLPoolAllocator::flushThreadCache();
+	LLError::freeThreadLogBuffers();
+
 	return NULL;
 }
 
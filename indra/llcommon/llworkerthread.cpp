@@ -40,8 +40,8 @@
 //============================================================================
 // Run on MAIN thread
 
-LLWorkerThread::LLWorkerThread(const std::string& name, bool threaded) :
-	LLQueuedThread(name, threaded)
+LLWorkerThread::LLWorkerThread(const std::string& name, bool threaded, S32 max_jobs) :
+	LLQueuedThread(name, threaded, max_jobs)
 {
 	mDeleteMutex = new LLMutex;
 }
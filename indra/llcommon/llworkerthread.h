@@ -89,7 +89,7 @@ private:
 	LLMutex* mDeleteMutex;
 	
 public:
-	LLWorkerThread(const std::string& name, bool threaded = true);
+	LLWorkerThread(const std::string& name, bool threaded = true, S32 max_jobs = 1);
 	~LLWorkerThread();
 
 	/*virtual*/ S32 update(U32 max_time_ms);
@@ -0,0 +1,275 @@
+/**
+ * @file llerror_test.cpp
+ * @brief Tests for asynchronous logging and the log writer thread
+ *
+ * $LicenseInfo:firstyear=2010&license=viewergpl$
+ *
+ * Copyright (c) 2010, Linden Research, Inc.
+ *
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ *
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ *
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ *
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+#include "../llerrorcontrol.h"
+#include "../test/lltut.h"
+
+#include "llthread.h"
+#include "lltimer.h"
+
+namespace
+{
+	static bool fatalWasCalled;
+	void fatalCall(const std::string&) { fatalWasCalled = true; }
+
+	// Looks at the settings from inside the fatal function.
+	static std::string fatalLogFileName;
+	void fatalReadSettings(const std::string&)
+	{
+		fatalWasCalled = true;
+		fatalLogFileName = LLError::logFileName() + "-";
+	}
+
+	// Messages come in on the log writer thread.
+	class TestRecorder : public LLError::Recorder
+	{
+	public:
+		void recordMessage(LLError::ELevel level, const std::string& message)
+		{
+			LLMutexLock lock(&mMutex);
+			mMessages.push_back(message);
+		}
+
+		std::vector<std::string> getMessages()
+		{
+			LLMutexLock lock(&mMutex);
+			return mMessages;
+		}
+
+		void clearMessages()
+		{
+			LLMutexLock lock(&mMutex);
+			mMessages.clear();
+		}
+
+		S32 countContaining(const std::string& text)
+		{
+			LLMutexLock lock(&mMutex);
+			S32 count = 0;
+			for (U32 i = 0; i < mMessages.size(); ++i)
+			{
+				if (mMessages[i].find(text) != std::string::npos)
+				{
+					++count;
+				}
+			}
+			return count;
+		}
+
+	private:
+		LLMutex mMutex;
+		std::vector<std::string> mMessages;
+	};
+
+	class TestLoggingThread : public LLThread
+	{
+	public:
+		TestLoggingThread(const std::string& what, S32 count, bool free_buffers = false) :
+			LLThread("TestLoggingThread"),
+			mWhat(what),
+			mCount(count),
+			mFreeBuffers(free_buffers)
+		{
+			mFreed = 0;
+		}
+
+		LLAtomicS32 mFreed;
+
+	protected:
+		/*virtual*/ void run()
+		{
+			for (S32 i = 0; i < mCount; ++i)
+			{
+				llinfos << mWhat << " " << i << llendl;
+			}
+			if (mFreeBuffers)
+			{
+				// What LLThread does when the thread exits
+				LLError::freeThreadLogBuffers();
+				mFreed = 1;
+				llinfos << "after free: " << mWhat << llendl;
+			}
+		}
+
+	private:
+		std::string mWhat;
+		S32 mCount;
+		bool mFreeBuffers;
+	};
+
+	void wait_until_stopped(LLThread& thread)
+	{
+		while (!thread.isStopped())
+		{
+			ms_sleep(1);
+		}
+	}
+}
+
+namespace tut
+{
+	struct AsyncLogData
+	{
+		TestRecorder mRecorder;
+		LLError::ThreadSafeSettings* mPriorErrorSettings;
+
+		AsyncLogData()
+		{
+			fatalWasCalled = false;
+
+			mPriorErrorSettings = LLError::saveAndResetSettings();
+			LLError::setDefaultLevel(LLError::LEVEL_DEBUG);
+			LLError::setFatalFunction(fatalCall);
+			LLError::addRecorder(&mRecorder);
+		}
+
+		~AsyncLogData()
+		{
+			LLError::stopAsyncLogging();
+			LLError::removeRecorder(&mRecorder);
+			LLError::restoreSettings(mPriorErrorSettings);
+		}
+	};
+
+	typedef test_group<AsyncLogData> AsyncLogGroup;
+	typedef AsyncLogGroup::object AsyncLogObject;
+	AsyncLogGroup asyncLogTestGroup("LLError async");
+
+	template<> template<>
+	void AsyncLogObject::test<1>()
+	{
+		// Asynchronous logging keeps each thread's messages in order,
+		// and errors still go out (after what was queued) right away.
+		LLError::startAsyncLogging();
+
+		TestLoggingThread worker("worker", 100);
+		worker.start();
+		for (S32 i = 0; i < 100; ++i)
+		{
+			llinfos << "main " << i << llendl;
+		}
+		wait_until_stopped(worker);
+
+		llerrs << "ate eels" << llendl;
+		ensure("fatal called", fatalWasCalled);
+
+		// The worker's own "Exiting" message may come in anywhere.
+		std::vector<std::string> messages = mRecorder.getMessages();
+		S32 next_main = 0;
+		S32 next_worker = 0;
+		U32 n = 0;
+		for (; n < messages.size(); ++n)
+		{
+			const std::string& message = messages[n];
+			size_t pos;
+			if ((pos = message.find("main ")) != std::string::npos)
+			{
+				ensure_equals("main order", atoi(message.c_str() + pos + 5), next_main++);
+			}
+			else if ((pos = message.find("worker ")) != std::string::npos)
+			{
+				ensure_equals("worker order", atoi(message.c_str() + pos + 7), next_worker++);
+			}
+			else if (message.find("ate eels") != std::string::npos)
+			{
+				break;
+			}
+		}
+		ensure_equals("main messages", next_main, 100);
+		ensure_equals("worker messages", next_worker, 100);
+		ensure("error written", n > 0 && n < messages.size());
+		ensure_contains("error location first", messages[n - 1], "error");
+
+		mRecorder.clearMessages();
+		llinfos << "after" << llendl;
+		LLError::stopAsyncLogging();
+		messages = mRecorder.getMessages();
+		ensure("written on stop", messages.size() > 0);
+		ensure_contains("stop flushes", messages[0], "after");
+		ensure_equals("nothing dropped", LLError::droppedMessageCount(), (U32)0);
+	}
+
+	template<> template<>
+	void AsyncLogObject::test<2>()
+	{
+		// A thread's log buffers are written out when they are freed, and
+		// the thread can go on logging afterwards.
+		LLError::startAsyncLogging();
+
+		TestLoggingThread worker("leaving", 20, true);
+		worker.start();
+		while (worker.mFreed == 0)
+		{
+			ms_sleep(1);
+		}
+		ensure_equals("queued messages written out", mRecorder.countContaining("leaving "), 20);
+		wait_until_stopped(worker);
+
+		LLError::stopAsyncLogging();
+		ensure_equals("logged after the free", mRecorder.countContaining("after free: leaving"), 1);
+	}
+
+	template<> template<>
+	void AsyncLogObject::test<3>()
+	{
+		// The fatal function runs without the settings locked, so it can
+		// use them.
+		LLError::setFatalFunction(fatalReadSettings);
+		llerrs << "look around" << llendl;
+		ensure("fatal called", fatalWasCalled);
+		ensure_equals("read the settings", fatalLogFileName, std::string("-"));
+	}
+
+	template<> template<>
+	void AsyncLogObject::test<4>()
+	{
+		// Recorders can be removed and deleted while the writer is busy
+		// with the messages of another thread.
+		LLError::startAsyncLogging();
+
+		TestLoggingThread worker("busy", 500);
+		worker.start();
+		for (S32 i = 0; i < 50; ++i)
+		{
+			TestRecorder* recorder = new TestRecorder;
+			LLError::addRecorder(recorder);
+			ms_sleep(1);
+			LLError::removeRecorder(recorder);
+			delete recorder;
+		}
+		wait_until_stopped(worker);
+
+		LLError::stopAsyncLogging();
+		ensure_equals("all messages reached the fixture's recorder", mRecorder.countContaining("busy "), 500);
+	}
+}
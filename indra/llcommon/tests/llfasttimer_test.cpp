@@ -0,0 +1,134 @@
+/**
+ * @file llfasttimer_test.cpp
+ * @brief Tests for per thread fast timers and trace export
+ *
+ * $LicenseInfo:firstyear=2010&license=viewergpl$
+ *
+ * Copyright (c) 2010, Linden Research, Inc.
+ *
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ *
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ *
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ *
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+#include "../llfasttimer.h"
+#include "../test/lltut.h"
+
+#include "llthread.h"
+#include "lltimer.h"
+
+namespace
+{
+	LLFastTimer::DeclareTimer FTM_TEST_WORK("Test Work");
+	LLFastTimer::DeclareTimer FTM_TEST_WRAPPER("Test Wrapper");
+
+	class FastTimerTestThread : public LLThread
+	{
+	public:
+		FastTimerTestThread() : LLThread("Fast Timer Test") { }
+
+	protected:
+		/*virtual*/ void run()
+		{
+			for (S32 i = 0; i < 100; ++i)
+			{
+				LLFastTimer t1(FTM_TEST_WORK);
+				LLFastTimer t2(LLFastTimer::FTM_TEMP8);
+			}
+		}
+	};
+
+	F64 seconds(LLFastTimer::EFastTimerType type)
+	{
+		return (F64)LLFastTimer::sCounter[type] / (F64)LLFastTimer::countsPerSecond();
+	}
+}
+
+namespace tut
+{
+	struct fasttimer_data
+	{
+		fasttimer_data()
+		{
+			LLFastTimer::reset();
+		}
+		~fasttimer_data()
+		{
+			LLFastTimer::reset();
+		}
+	};
+
+	typedef test_group<fasttimer_data> fasttimer_test;
+	typedef fasttimer_test::object fasttimer_object;
+	tut::fasttimer_test tfasttimer("LLFastTimer");
+
+	template<> template<>
+	void fasttimer_object::test<1>()
+	{
+		// Other threads neither disturb the frame accumulators nor get
+		// counted in them, and they show up in traces by name.
+		LLFastTimer::startTracing();
+		FastTimerTestThread thread;
+		{
+			LLFastTimer t(LLFastTimer::FTM_TEMP7);
+			thread.start();
+			while (!thread.isStopped())
+			{
+				ms_sleep(1);
+			}
+		}
+		ensure_equals("main thread calls", LLFastTimer::sCalls[LLFastTimer::FTM_TEMP7], (U64)1);
+		ensure_equals("other thread calls", LLFastTimer::sCalls[LLFastTimer::FTM_TEMP8], (U64)0);
+
+		std::ostringstream trace;
+		LLFastTimer::writeTrace(trace, 60.0);
+		LLFastTimer::stopTracing();
+
+		std::string json = trace.str();
+		ensure_contains("thread name", json, "\"Fast Timer Test\"");
+		ensure_contains("declared timer", json, "\"Test Work\"");
+		ensure_contains("main thread", json, "\"Main\"");
+		ensure("complete events", json.find("\"ph\":\"X\"") != std::string::npos);
+	}
+
+	template<> template<>
+	void fasttimer_object::test<2>()
+	{
+		// The time of a declared timer counts for the fixed timer around it,
+		// the fixed timers inside it still count for themselves.
+		{
+			LLFastTimer outer(LLFastTimer::FTM_TEMP5);
+			LLFastTimer wrapper(FTM_TEST_WRAPPER);
+			ms_sleep(20);
+			{
+				LLFastTimer inner(LLFastTimer::FTM_TEMP6);
+				ms_sleep(50);
+			}
+		}
+		F64 outer = seconds(LLFastTimer::FTM_TEMP5);
+		F64 inner = seconds(LLFastTimer::FTM_TEMP6);
+		ensure("inner timer counted", inner >= 0.045);
+		ensure("declared timer's own time counted for the outer timer", outer >= 0.015);
+		ensure("inner timer not counted twice", outer < 0.045);
+	}
+}
@@ -0,0 +1,265 @@
+/**
+ * @file lljobscheduler_test.cpp
+ * @brief Tests for the shared work-stealing job scheduler
+ *
+ * $LicenseInfo:firstyear=2010&license=viewergpl$
+ *
+ * Copyright (c) 2010, Linden Research, Inc.
+ *
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ *
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ *
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ *
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+#include "../lljobscheduler.h"
+#include "../test/lltut.h"
+
+#include "lltimer.h"
+
+namespace
+{
+	// What the jobs of one test did, shared with the workers.
+	struct Log
+	{
+		Log() : mStarted(0), mDeleted(0) {}
+
+		void ran(S32 id)
+		{
+			LLMutexLock lock(&mMutex);
+			mRan.push_back(id);
+		}
+		std::vector<S32> getRan()
+		{
+			LLMutexLock lock(&mMutex);
+			return mRan;
+		}
+
+		LLMutex mMutex;
+		std::vector<S32> mRan;
+		LLAtomicS32 mStarted; // blocking jobs that have started
+		LLAtomicS32 mDeleted;
+	};
+
+	// Records its id. With a gate, waits for it to open first.
+	class TestJob : public LLJobScheduler::Job
+	{
+	public:
+		TestJob(Log* log, S32 id, LLAtomicS32* gate = NULL) : mLog(log), mID(id), mGate(gate) {}
+		~TestJob() { mLog->mDeleted++; }
+
+		/*virtual*/ void run()
+		{
+			if (mGate)
+			{
+				mLog->mStarted++;
+				while (*mGate == 0)
+				{
+					ms_sleep(1);
+				}
+			}
+			mLog->ran(mID);
+		}
+
+	private:
+		Log* mLog;
+		S32 mID;
+		LLAtomicS32* mGate;
+	};
+
+	// Polls until value reaches expected or a few seconds have passed.
+	bool wait_for(LLAtomicS32& value, S32 expected)
+	{
+		for (S32 i = 0; i < 5000; ++i)
+		{
+			if (value == expected)
+			{
+				return true;
+			}
+			ms_sleep(1);
+		}
+		return false;
+	}
+
+	bool wait_for_ran(Log& log, U32 count)
+	{
+		for (S32 i = 0; i < 5000; ++i)
+		{
+			if (log.getRan().size() >= count)
+			{
+				return true;
+			}
+			ms_sleep(1);
+		}
+		return false;
+	}
+
+	S32 ids(S32 a, S32 b, S32 c, S32 d)
+	{
+		return ((a * 10 + b) * 10 + c) * 10 + d;
+	}
+
+	S32 ids(const std::vector<S32>& ran, U32 first)
+	{
+		return ids(ran[first], ran[first + 1], ran[first + 2], ran[first + 3]);
+	}
+}
+
+namespace tut
+{
+	struct jobscheduler_data
+	{
+		~jobscheduler_data()
+		{
+			LLJobScheduler::cleanupClass();
+		}
+	};
+
+	typedef test_group<jobscheduler_data> jobscheduler_test;
+	typedef jobscheduler_test::object jobscheduler_object;
+	tut::jobscheduler_test tjs("LLJobScheduler");
+
+	template<> template<>
+	void jobscheduler_object::test<1>()
+	{
+		// One worker runs the jobs of a lane in the order they were posted,
+		// and empties higher lanes first.
+		LLJobScheduler::initClass(1);
+		Log log;
+		LLAtomicS32 gate;
+		gate = 0;
+		LLJobScheduler::post(new TestJob(&log, 0, &gate));
+		ensure("blocker started", wait_for(log.mStarted, 1));
+
+		LLJobScheduler::post(new TestJob(&log, 1), LLJobScheduler::LANE_LOW);
+		LLJobScheduler::post(new TestJob(&log, 2), LLJobScheduler::LANE_NORMAL);
+		LLJobScheduler::post(new TestJob(&log, 3), LLJobScheduler::LANE_NORMAL);
+		LLJobScheduler::post(new TestJob(&log, 4), LLJobScheduler::LANE_HIGH);
+		ensure_equals("queued while blocked", LLJobScheduler::getPending(), 4);
+
+		gate = 1;
+		ensure("all ran", wait_for_ran(log, 5));
+		std::vector<S32> ran = log.getRan();
+		ensure_equals("blocker first", ran[0], 0);
+		ensure_equals("high, then normal in order, then low", ids(ran, 1), ids(4, 2, 3, 1));
+		ensure_equals("nothing left", LLJobScheduler::getPending(), 0);
+	}
+
+	template<> template<>
+	void jobscheduler_object::test<2>()
+	{
+		// A worker runs its own queue from the front, then steals from the
+		// back of the other worker's queue.
+		LLJobScheduler::initClass(2);
+		Log log;
+		LLAtomicS32 gate_a;
+		LLAtomicS32 gate_b;
+		gate_a = 0;
+		gate_b = 0;
+		LLJobScheduler::post(new TestJob(&log, 8, &gate_a));
+		LLJobScheduler::post(new TestJob(&log, 9, &gate_b));
+		ensure("both workers busy", wait_for(log.mStarted, 2));
+
+		// Round robin: 1 and 3 go to one worker, 2 and 4 to the other
+		LLJobScheduler::post(new TestJob(&log, 1));
+		LLJobScheduler::post(new TestJob(&log, 2));
+		LLJobScheduler::post(new TestJob(&log, 3));
+		LLJobScheduler::post(new TestJob(&log, 4));
+
+		// Free one worker; it runs everything while the other stays blocked
+		gate_b = 1;
+		ensure("freed worker ran its blocker and all four", wait_for_ran(log, 5));
+		std::vector<S32> ran = log.getRan();
+		ensure_equals("released blocker first", ran[0], 9);
+		S32 order = ids(ran, 1);
+		ensure("own queue front to back, then the other queue back to front",
+			   order == ids(1, 3, 4, 2) || order == ids(2, 4, 3, 1));
+
+		gate_a = 1;
+		ensure("other blocker ran", wait_for_ran(log, 6));
+	}
+
+	template<> template<>
+	void jobscheduler_object::test<3>()
+	{
+		// A job cancelled before it starts is dropped without running.
+		LLJobScheduler::initClass(1);
+		Log log;
+		LLAtomicS32 gate;
+		gate = 0;
+		LLJobScheduler::post(new TestJob(&log, 0, &gate));
+		ensure("blocker started", wait_for(log.mStarted, 1));
+
+		LLJobScheduler::handle_t cancelled = LLJobScheduler::post(new TestJob(&log, 1));
+		LLJobScheduler::handle_t kept = LLJobScheduler::post(new TestJob(&log, 2));
+		ensure("valid handle", cancelled != LLJobScheduler::nullHandle());
+		ensure("cancel before start", LLJobScheduler::cancel(cancelled));
+		ensure("second cancel finds nothing", !LLJobScheduler::cancel(cancelled));
+
+		gate = 1;
+		ensure("kept job ran", wait_for_ran(log, 2));
+		ensure("cancelled job deleted too", wait_for(log.mDeleted, 3));
+		std::vector<S32> ran = log.getRan();
+		ensure_equals("ran count", ran.size(), (size_t)2);
+		ensure_equals("blocker", ran[0], 0);
+		ensure_equals("kept", ran[1], 2);
+		ensure("cancel after run fails", !LLJobScheduler::cancel(kept));
+	}
+
+	template<> template<>
+	void jobscheduler_object::test<4>()
+	{
+		// Shutdown waits for running jobs and drops the ones not started.
+		LLJobScheduler::initClass(1);
+		Log log;
+		LLAtomicS32 gate;
+		gate = 0;
+		LLJobScheduler::post(new TestJob(&log, 0, &gate));
+		ensure("blocker started", wait_for(log.mStarted, 1));
+		LLJobScheduler::post(new TestJob(&log, 1));
+		LLJobScheduler::post(new TestJob(&log, 2));
+
+		// Let the running job finish a little after shutdown starts waiting
+		class Opener : public LLThread
+		{
+		public:
+			Opener(LLAtomicS32* gate) : LLThread("opener"), mGate(gate) {}
+			/*virtual*/ void run() { ms_sleep(100); *mGate = 1; }
+			LLAtomicS32* mGate;
+		};
+		Opener opener(&gate);
+		opener.start();
+
+		LLJobScheduler::cleanupClass();
+		ensure("scheduler stopped", !LLJobScheduler::isRunning());
+		std::vector<S32> ran = log.getRan();
+		ensure_equals("only the running job finished", ran.size(), (size_t)1);
+		ensure_equals("running job", ran[0], 0);
+		ensure_equals("all jobs deleted", (S32)log.mDeleted, 3);
+		ensure_equals("post after shutdown", LLJobScheduler::post(new TestJob(&log, 3)), LLJobScheduler::nullHandle());
+
+		while (!opener.isStopped())
+		{
+			ms_sleep(1);
+		}
+	}
+}
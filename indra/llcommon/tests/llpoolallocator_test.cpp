@@ -0,0 +1,284 @@
+/** 
+ * @file llpoolallocator_test.cpp
+ * @brief Tests and stress benchmark for the small object pool allocator
+ *
+ * $LicenseInfo:firstyear=2006&license=viewergpl$
+ * 
+ * Copyright (c) 2006-2009, Linden Research, Inc.
+ * 
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ * 
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ * 
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ * 
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+
+#include "linden_common.h"
+#include "../llpoolallocator.h"
+#include "../test/lltut.h"
+#include "../test/lltestrand.h"
+
+#include "llthread.h"
+#include "lltimer.h"
+
+#include <set>
+
+namespace
+{
+	// Remembers where it lives, so that handing out a block twice or
+	// scribbling over one shows up.
+	class PoolTestObject
+	{
+	public:
+		LL_USE_POOL_ALLOCATOR(PoolTestObject);
+
+		PoolTestObject(U32 stamp) : mSelf(this), mStamp(stamp) { }
+		virtual ~PoolTestObject() { mSelf = NULL; }
+
+		bool valid(U32 stamp) const		{ return mSelf == this && mStamp == stamp; }
+
+	private:
+		const PoolTestObject* mSelf;
+		U32 mStamp;
+	};
+
+	// Lands in a larger size class than its base.
+	class PoolTestDerived : public PoolTestObject
+	{
+	public:
+		PoolTestDerived(U32 stamp) : PoolTestObject(stamp) { memset(mPadding, 0xAB, sizeof(mPadding)); }	/* Flawfinder: ignore */
+
+		U8 mPadding[100];
+	};
+
+	// Past the largest size class, goes to the global new.
+	class PoolTestLarge : public PoolTestObject
+	{
+	public:
+		PoolTestLarge(U32 stamp) : PoolTestObject(stamp) { }
+
+		U8 mPadding[LLPoolAllocator::MAX_SIZE];
+	};
+
+	// The same object without the pool, for the benchmark.
+	class PlainTestObject
+	{
+	public:
+		PlainTestObject(U32 stamp) : mSelf(this), mStamp(stamp) { }
+		virtual ~PlainTestObject() { mSelf = NULL; }
+
+		bool valid(U32 stamp) const		{ return mSelf == this && mStamp == stamp; }
+
+	private:
+		const PlainTestObject* mSelf;
+		U32 mStamp;
+	};
+}
+
+LL_DEFINE_POOL_ALLOCATOR(PoolTestObject);
+
+namespace tut
+{
+	struct poolallocator_test
+	{
+	};
+
+	typedef test_group<poolallocator_test> poolallocator_t;
+	typedef poolallocator_t::object poolallocator_object_t;
+	tut::poolallocator_t tut_poolallocator("poolallocator");
+
+	template<> template<>
+	void poolallocator_object_t::test<1>()
+	{
+		// Blocks are distinct, keep their contents and are counted
+		LLPoolStats& stats = PoolTestObject::sPoolStats;
+		LLPoolAllocator::flushThreadCache();
+		U32 live_at_start = stats.getLive();
+		U32 total_at_start = stats.getTotal();
+
+		const S32 COUNT = 10000;
+		std::vector<PoolTestObject*> objects;
+		for (S32 i = 0; i < COUNT; i++)
+		{
+			switch (i % 3)
+			{
+			case 0:	objects.push_back(new PoolTestObject(i));	break;
+			case 1:	objects.push_back(new PoolTestDerived(i));	break;
+			default: objects.push_back(new PoolTestLarge(i));	break;
+			}
+		}
+		LLPoolAllocator::flushThreadCache();
+		ensure_equals("live", stats.getLive(), live_at_start + COUNT);
+		ensure("peak", stats.getPeak() >= live_at_start + COUNT);
+
+		std::set<PoolTestObject*> distinct(objects.begin(), objects.end());
+		ensure_equals("distinct blocks", (S32)distinct.size(), COUNT);
+
+		// Free every other one and reuse the space
+		for (S32 i = 0; i < COUNT; i += 2)
+		{
+			ensure("intact before free", objects[i]->valid(i));
+			delete objects[i];
+			objects[i] = new PoolTestDerived(i);
+		}
+		for (S32 i = 0; i < COUNT; i++)
+		{
+			ensure("intact", objects[i]->valid(i));
+			delete objects[i];
+		}
+		LLPoolAllocator::flushThreadCache();
+		ensure_equals("all freed", stats.getLive(), live_at_start);
+		ensure_equals("allocations counted", stats.getTotal(), total_at_start + COUNT + COUNT / 2);
+	}
+
+	class PoolTestThread : public LLThread
+	{
+	public:
+		PoolTestThread(PoolTestObject* volatile* slots, S32 num_slots, S32 rounds, U32 seed, bool pooled)
+		:	LLThread("Pool Test"),
+			mSlots(slots),
+			mNumSlots(num_slots),
+			mRounds(rounds),
+			mRand(seed),
+			mPooled(pooled),
+			mErrors(0)
+		{
+		}
+
+		S32 getErrors() const	{ return mErrors; }
+
+	protected:
+		/*virtual*/ void run()
+		{
+			// Objects are swapped through shared slots, so most of them are
+			// freed by a different thread than the one that made them.
+			for (S32 i = 0; i < mRounds; i++)
+			{
+				U32 slot = mRand.next(mNumSlots);
+				if (mPooled)
+				{
+					PoolTestObject* object = mRand.next(4) ? new PoolTestObject(slot) : new PoolTestDerived(slot);
+					PoolTestObject* old = (PoolTestObject*)apr_atomic_xchgptr((volatile void**)&mSlots[slot], object);
+					if (old)
+					{
+						mErrors += !old->valid(slot);
+						delete old;
+					}
+				}
+				else
+				{
+					PlainTestObject* object = new PlainTestObject(slot);
+					PlainTestObject* old = (PlainTestObject*)apr_atomic_xchgptr((volatile void**)&mSlots[slot], object);
+					if (old)
+					{
+						mErrors += !old->valid(slot);
+						delete old;
+					}
+				}
+			}
+		}
+
+	private:
+		PoolTestObject* volatile* mSlots;
+		S32 mNumSlots;
+		S32 mRounds;
+		LLTestRand mRand;
+		bool mPooled;
+		S32 mErrors;
+	};
+
+	// Runs the threads to completion and frees what is left in the slots,
+	// returns the number of corrupted objects seen.  Unless shared, every
+	// thread gets slots of its own and frees only what it made.
+	S32 run_pool_threads(S32 num_threads, S32 rounds, bool pooled, bool shared = true)
+	{
+		const S32 NUM_SLOTS = 4096;
+		std::vector<PoolTestObject*> slots(NUM_SLOTS, (PoolTestObject*)NULL);
+		std::vector<PoolTestThread*> threads;
+		for (S32 i = 0; i < num_threads; i++)
+		{
+			S32 num_slots = shared ? NUM_SLOTS : NUM_SLOTS / num_threads;
+			PoolTestObject** first_slot = shared ? &slots[0] : &slots[i * num_slots];
+			threads.push_back(new PoolTestThread(first_slot, num_slots, rounds, i + 1, pooled));
+			threads.back()->start();
+		}
+		S32 errors = 0;
+		for (S32 i = 0; i < num_threads; i++)
+		{
+			while (!threads[i]->isStopped())
+			{
+				ms_sleep(1);
+			}
+			errors += threads[i]->getErrors();
+			delete threads[i];
+		}
+		for (S32 i = 0; i < NUM_SLOTS; i++)
+		{
+			if (pooled)
+			{
+				delete slots[i];
+			}
+			else
+			{
+				delete (PlainTestObject*)(void*)slots[i];
+			}
+		}
+		return errors;
+	}
+
+	template<> template<>
+	void poolallocator_object_t::test<2>()
+	{
+		// Objects made on one thread and freed on another
+		LLPoolAllocator::flushThreadCache();
+		U32 live_at_start = PoolTestObject::sPoolStats.getLive();
+		ensure_equals("no corruption", run_pool_threads(4, 200000, true), 0);
+		LLPoolAllocator::flushThreadCache();
+		ensure_equals("all freed", PoolTestObject::sPoolStats.getLive(), live_at_start);
+	}
+
+	template<> template<>
+	void poolallocator_object_t::test<3>()
+	{
+		// Benchmark: the churn of the test above with the pool and with the
+		// global new and delete, on one thread and on several, with objects
+		// freed where they were made and with objects passed around.
+		const S32 ROUNDS = 2000000;
+		S32 thread_counts[] = { 1, 4, 4 };
+		bool shared[] = { false, false, true };
+		for (S32 i = 0; i < 3; i++)
+		{
+			S32 num_threads = thread_counts[i];
+			LLTimer timer;
+			ensure_equals("pooled", run_pool_threads(num_threads, ROUNDS / num_threads, true, shared[i]), 0);
+			F64 pool_time = timer.getElapsedTimeF64();
+
+			timer.reset();
+			ensure_equals("plain", run_pool_threads(num_threads, ROUNDS / num_threads, false, shared[i]), 0);
+			F64 plain_time = timer.getElapsedTimeF64();
+
+			llinfos << "LLPoolAllocator: " << ROUNDS << " allocations on " << num_threads
+					<< (shared[i] ? " threads passing objects around" : " threads") << ": pool "
+					<< pool_time * 1000.0 << " ms, new/delete " << plain_time * 1000.0 << " ms" << llendl;
+		}
+		llinfos << "LLPoolAllocator: " << (LLPoolAllocator::getSlabBytes() >> 10) << " KB of slabs" << llendl;
+	}
+}
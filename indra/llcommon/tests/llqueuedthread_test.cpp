@@ -0,0 +1,201 @@
+/**
+ * @file llqueuedthread_test.cpp
+ * @brief Tests for LLQueuedThread running its requests on the job scheduler
+ *
+ * $LicenseInfo:firstyear=2010&license=viewergpl$
+ *
+ * Copyright (c) 2010, Linden Research, Inc.
+ *
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ *
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ *
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ *
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+#include "../llqueuedthread.h"
+#include "../test/lltut.h"
+
+#include "lltimer.h"
+
+namespace
+{
+	// What the requests of one test did, shared with the workers.
+	struct Counters
+	{
+		Counters() : mRunning(0), mMaxRunning(0), mDone(0), mDeleted(0) {}
+
+		void enter()
+		{
+			LLMutexLock lock(&mMutex);
+			mMaxRunning = llmax(mMaxRunning, ++mRunning);
+		}
+		void leave()
+		{
+			LLMutexLock lock(&mMutex);
+			--mRunning;
+			++mDone;
+		}
+		S32 getRunning()
+		{
+			LLMutexLock lock(&mMutex);
+			return mRunning;
+		}
+
+		LLMutex mMutex;
+		S32 mRunning;
+		S32 mMaxRunning;
+		S32 mDone;
+		LLAtomicS32 mDeleted;
+	};
+
+	class TestRequest : public LLQueuedThread::QueuedRequest
+	{
+	public:
+		TestRequest(LLQueuedThread::handle_t handle, Counters* counters, S32 sleep_ms, S32 wait_for_running) :
+			LLQueuedThread::QueuedRequest(handle, LLQueuedThread::PRIORITY_NORMAL, LLQueuedThread::FLAG_AUTO_COMPLETE),
+			mCounters(counters),
+			mSleepMS(sleep_ms),
+			mWaitForRunning(wait_for_running)
+		{
+		}
+
+	protected:
+		~TestRequest() { mCounters->mDeleted++; }
+
+		/*virtual*/ bool processRequest()
+		{
+			mCounters->enter();
+			// Give other jobs a chance to overlap with this one
+			for (S32 i = 0; i < 200 && mCounters->getRunning() < mWaitForRunning; ++i)
+			{
+				ms_sleep(1);
+			}
+			ms_sleep(mSleepMS);
+			mCounters->leave();
+			return true;
+		}
+
+	private:
+		Counters* mCounters;
+		S32 mSleepMS;
+		S32 mWaitForRunning;
+	};
+
+	class TestQueue : public LLQueuedThread
+	{
+	public:
+		TestQueue(S32 max_jobs) : LLQueuedThread("test queue", true, max_jobs) {}
+
+		handle_t add(Counters* counters, S32 sleep_ms, S32 wait_for_running = 0)
+		{
+			handle_t handle = generateHandle();
+			addRequest(new TestRequest(handle, counters, sleep_ms, wait_for_running));
+			return handle;
+		}
+	};
+
+	S32 get_done(Counters& counters)
+	{
+		LLMutexLock lock(&counters.mMutex);
+		return counters.mDone;
+	}
+
+	bool wait_for_done(Counters& counters, S32 count)
+	{
+		for (S32 i = 0; i < 5000 && get_done(counters) < count; ++i)
+		{
+			ms_sleep(1);
+		}
+		return get_done(counters) >= count;
+	}
+}
+
+namespace tut
+{
+	struct queuedthread_data
+	{
+		queuedthread_data()
+		{
+			LLJobScheduler::initClass(4);
+		}
+		~queuedthread_data()
+		{
+			LLJobScheduler::cleanupClass();
+		}
+	};
+
+	typedef test_group<queuedthread_data> queuedthread_test;
+	typedef queuedthread_test::object queuedthread_object;
+	tut::queuedthread_test tqt("LLQueuedThread");
+
+	template<> template<>
+	void queuedthread_object::test<1>()
+	{
+		// max_jobs = 1 keeps requests one at a time, as on a dedicated thread,
+		// even with idle workers to spare.
+		Counters counters;
+		TestQueue* queue = new TestQueue(1);
+		ensure("runs on the scheduler", queue->getPooled());
+		for (S32 i = 0; i < 8; ++i)
+		{
+			queue->add(&counters, 5);
+		}
+		ensure("all done", wait_for_done(counters, 8));
+		ensure_equals("never two at once", counters.mMaxRunning, 1);
+		delete queue;
+		ensure_equals("requests deleted", (S32)counters.mDeleted, 8);
+	}
+
+	template<> template<>
+	void queuedthread_object::test<2>()
+	{
+		// A larger max_jobs lets requests overlap, up to that many.
+		Counters counters;
+		TestQueue* queue = new TestQueue(2);
+		for (S32 i = 0; i < 8; ++i)
+		{
+			queue->add(&counters, 2, 2);
+		}
+		ensure("all done", wait_for_done(counters, 8));
+		ensure_equals("two at once", counters.mMaxRunning, 2);
+		delete queue;
+	}
+
+	template<> template<>
+	void queuedthread_object::test<3>()
+	{
+		// Shutdown lets the running request finish and drops the queued one.
+		Counters counters;
+		TestQueue* queue = new TestQueue(1);
+		queue->add(&counters, 200);
+		for (S32 i = 0; i < 5000 && counters.getRunning() == 0; ++i)
+		{
+			ms_sleep(1);
+		}
+		ensure_equals("first request running", counters.getRunning(), 1);
+		queue->add(&counters, 0);
+
+		delete queue;
+		ensure_equals("running request finished", get_done(counters), 1);
+		ensure_equals("both requests deleted", (S32)counters.mDeleted, 2);
+	}
+}
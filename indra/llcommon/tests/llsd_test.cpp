@@ -0,0 +1,394 @@
+/** 
+ * @file llsd_test.cpp
+ * @brief Tests and benchmarks for LLSD maps and their interned keys
+ *
+ * $LicenseInfo:firstyear=2006&license=viewergpl$
+ * 
+ * Copyright (c) 2006-2009, Linden Research, Inc.
+ * 
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ * 
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ * 
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ * 
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+#include "../llsd.h"
+#include "../test/lltut.h"
+#include "../test/lltestrand.h"
+
+#include "llmemory.h"
+#include "llthread.h"
+#include "lltimer.h"
+
+namespace tut
+{
+	struct sdmap_test
+	{
+		sdmap_test() : mRand(4321)
+		{
+		}
+
+		LLUUID makeID()
+		{
+			LLUUID id;
+			for (S32 i = 0; i < UUID_BYTES; i++)
+			{
+				id.mData[i] = (U8)mRand.next(256);
+			}
+			return id;
+		}
+
+		// One folder of a FetchInventoryDescendents response.
+		LLSD makeFolder(S32 num_categories, S32 num_items)
+		{
+			LLSD folder;
+			LLUUID folder_id = makeID();
+			LLUUID agent_id = makeID();
+			folder["agent_id"] = agent_id;
+			folder["owner_id"] = agent_id;
+			folder["folder_id"] = folder_id;
+			folder["version"] = (S32)mRand.next(100);
+			folder["descendents"] = num_categories + num_items;
+
+			LLSD& categories = folder["categories"];
+			for (S32 i = 0; i < num_categories; i++)
+			{
+				LLSD category;
+				category["category_id"] = makeID();
+				category["parent_id"] = folder_id;
+				category["name"] = llformat("Folder %d", i);
+				category["type_default"] = -1;
+				categories.append(category);
+			}
+
+			LLSD& items = folder["items"];
+			for (S32 i = 0; i < num_items; i++)
+			{
+				LLSD item;
+				item["item_id"] = makeID();
+				item["parent_id"] = folder_id;
+				item["asset_id"] = makeID();
+				item["name"] = llformat("Object %d", i);
+				item["desc"] = "(No Description)";
+				item["type"] = 6;
+				item["inv_type"] = 6;
+				item["flags"] = 0;
+				item["created_at"] = (S32)(1300000000 + mRand.next(10000000));
+
+				LLSD& sale_info = item["sale_info"];
+				sale_info["sale_price"] = 10;
+				sale_info["sale_type"] = 0;
+
+				LLSD& permissions = item["permissions"];
+				permissions["base_mask"] = (S32)0x7fffffff;
+				permissions["owner_mask"] = (S32)0x7fffffff;
+				permissions["group_mask"] = 0;
+				permissions["everyone_mask"] = 0;
+				permissions["next_owner_mask"] = (S32)0x82000;
+				permissions["creator_id"] = agent_id;
+				permissions["owner_id"] = agent_id;
+				permissions["last_owner_id"] = agent_id;
+				permissions["group_id"] = LLUUID::null;
+				permissions["is_owner_group"] = false;
+
+				items.append(item);
+			}
+			return folder;
+		}
+
+		LLSD makeResponse(S32 num_folders)
+		{
+			LLSD response;
+			LLSD& folders = response["folders"];
+			for (S32 i = 0; i < num_folders; i++)
+			{
+				folders.append(makeFolder(5, 60));
+			}
+			return response;
+		}
+
+		// What a client does with a response: look every field up by name.
+		S32 walkResponse(const LLSD& response)
+		{
+			S32 total = 0;
+			const LLSD& folders = response["folders"];
+			for (LLSD::array_const_iterator folder = folders.beginArray(); folder != folders.endArray(); ++folder)
+			{
+				total += (*folder)["version"].asInteger();
+				const LLSD& items = (*folder)["items"];
+				for (LLSD::array_const_iterator item = items.beginArray(); item != items.endArray(); ++item)
+				{
+					if ((*item)["item_id"].asUUID().notNull() && (*item)["name"].isString())
+					{
+						total += (*item)["type"].asInteger() + (*item)["inv_type"].asInteger();
+						total += (*item)["permissions"]["owner_mask"].asInteger() & 1;
+						total += (*item)["sale_info"]["sale_type"].asInteger();
+					}
+				}
+			}
+			return total;
+		}
+
+		LLTestRand mRand;
+	};
+
+	typedef test_group<sdmap_test> sdmap_t;
+	typedef sdmap_t::object sdmap_object_t;
+	tut::sdmap_t tut_sdmap("sdmap");
+
+	template<> template<>
+	void sdmap_object_t::test<1>()
+	{
+		// A map behaves like the std::map it replaces, iteration order included
+		LLSD map;
+		std::map<std::string, S32> expected;
+		for (S32 i = 0; i < 20000; i++)
+		{
+			std::string key = llformat("key%d", mRand.next(500));
+			switch (mRand.next(4))
+			{
+			case 0:
+				map.erase(key);
+				expected.erase(key);
+				break;
+			case 1:
+				map.insert(key, i);		// Doesn't replace
+				expected.insert(std::make_pair(key, i));
+				break;
+			default:
+				map[key] = i;
+				expected[key] = i;
+				break;
+			}
+		}
+
+		ensure_equals("size", map.size(), (int)expected.size());
+		std::map<std::string, S32>::iterator iter = expected.begin();
+		for (LLSD::map_const_iterator sd_iter = map.beginMap(); sd_iter != map.endMap(); ++sd_iter, ++iter)
+		{
+			ensure_equals("key order", sd_iter->first, iter->first);
+			ensure_equals("value", sd_iter->second.asInteger(), iter->second);
+			ensure("has", map.has(iter->first));
+		}
+		ensure("not there", !map.has("key500"));
+		ensure("not there get", map.get("key500").isUndefined());
+		ensure("empty key", !map.has(""));
+
+		// Walking backwards, and writing through the iterator
+		LLSD::map_iterator last = map.endMap();
+		--last;
+		ensure_equals("last key", last->first, expected.rbegin()->first);
+		last->second = "changed";
+		ensure_equals("written through iterator", map[expected.rbegin()->first].asString(), std::string("changed"));
+
+		// Maps that aren't, and empty ones
+		LLSD undef;
+		ensure("undefined map is empty", undef.beginMap() == undef.endMap());
+		const LLSD empty = LLSD::emptyMap();
+		ensure("empty map is empty", empty.beginMap() == empty.endMap());
+	}
+
+	template<> template<>
+	void sdmap_object_t::test<2>()
+	{
+		// References to values and keys stay good as the map grows, as they
+		// did with a std::map, and copies don't share changes.
+		U32 keys_at_start = LLSD::internedKeyCount();
+		{
+			LLSD map;
+			LLSD& middle = map["m"];
+			middle = 1;
+			const std::string& middle_key = map.beginMap()->first;
+			for (S32 i = 0; i < 1000; i++)
+			{
+				map[llformat("a%d", i)] = i;
+				map[llformat("z%d", i)] = i;
+			}
+			middle = 2;
+			ensure_equals("value reference", map["m"].asInteger(), 2);
+			ensure_equals("key reference", middle_key, std::string("m"));
+
+			for (S32 i = 0; i < 1000; i += 2)
+			{
+				map.erase(llformat("a%d", i));
+			}
+			ensure_equals("after erase", map.size(), 1501);
+			ensure_equals("value reference after erase", middle.asInteger(), 2);
+
+			LLSD copy = map;
+			copy["m"] = 3;
+			copy["new"] = 4;
+			ensure_equals("original untouched", map["m"].asInteger(), 2);
+			ensure("original has no new key", !map.has("new"));
+			ensure_equals("copy", copy["m"].asInteger(), 3);
+			ensure_equals("copy size", copy.size(), 1502);
+
+			// Keys are shared between maps
+			ensure("keys interned", LLSD::internedKeyCount() >= keys_at_start + 1501);
+			ensure("shared key", &map.beginMap()->first == &copy.beginMap()->first);
+		}
+		ensure_equals("keys released", LLSD::internedKeyCount(), keys_at_start);
+	}
+
+	class SDMapTestThread : public LLThread
+	{
+	public:
+		SDMapTestThread(S32 seed) : LLThread("LLSD Map Test"), mSeed(seed), mSum(0) { }
+
+		S32 getSum() const	{ return mSum; }
+
+	protected:
+		/*virtual*/ void run()
+		{
+			// Lots of maps sharing keys, built and dropped on every thread
+			for (S32 round = 0; round < 200; round++)
+			{
+				LLSD maps;
+				for (S32 i = 0; i < 20; i++)
+				{
+					LLSD map;
+					for (S32 j = 0; j < 20; j++)
+					{
+						map[llformat("shared%d", (j * 7 + round) % 30)] = j;
+						map[llformat("own%d_%d", mSeed, j)] = j;
+					}
+					maps.append(map);
+				}
+				mSum += maps[round % 20]["shared0"].asInteger() + maps[0].size();
+			}
+		}
+
+	private:
+		S32 mSeed;
+		S32 mSum;
+	};
+
+	template<> template<>
+	void sdmap_object_t::test<3>()
+	{
+		// The key table holds up with maps made on several threads at once
+		U32 keys_at_start = LLSD::internedKeyCount();
+		SDMapTestThread* threads[4];
+		for (S32 i = 0; i < 4; i++)
+		{
+			threads[i] = new SDMapTestThread(i);
+			threads[i]->start();
+		}
+		for (S32 i = 0; i < 4; i++)
+		{
+			while (!threads[i]->isStopped())
+			{
+				ms_sleep(1);
+			}
+		}
+		for (S32 i = 1; i < 4; i++)
+		{
+			ensure_equals("same work on every thread", threads[i]->getSum(), threads[0]->getSum());
+			delete threads[i];
+		}
+		delete threads[0];
+		ensure_equals("keys released", LLSD::internedKeyCount(), keys_at_start);
+	}
+
+	template<> template<>
+	void sdmap_object_t::test<4>()
+	{
+		// Benchmark: FetchInventoryDescendents sized responses, built,
+		// walked, copied and dropped.  The memory used by the maps is
+		// compared with the std::map<std::string, LLSD> they used to be.
+		const S32 NUM_RESPONSES = 40;
+		const S32 FOLDERS_PER_RESPONSE = 10;
+
+		LLTimer timer;
+		U64 rss_before = LLMemory::getCurrentRSS();
+		std::vector<LLSD> responses;
+		for (S32 i = 0; i < NUM_RESPONSES; i++)
+		{
+			responses.push_back(makeResponse(FOLDERS_PER_RESPONSE));
+		}
+		F64 build_time = timer.getElapsedTimeF64();
+		U64 sd_bytes = LLMemory::getCurrentRSS() - rss_before;
+
+		timer.reset();
+		S32 total = 0;
+		for (S32 pass = 0; pass < 5; pass++)
+		{
+			for (S32 i = 0; i < NUM_RESPONSES; i++)
+			{
+				total += walkResponse(responses[i]);
+			}
+		}
+		F64 walk_time = timer.getElapsedTimeF64();
+
+		// The same items, as maps of the old kind
+		rss_before = LLMemory::getCurrentRSS();
+		typedef std::map<std::string, LLSD> old_map_t;
+		std::vector<old_map_t> old_items;
+		for (S32 i = 0; i < NUM_RESPONSES; i++)
+		{
+			const LLSD& folders = responses[i]["folders"];
+			for (LLSD::array_const_iterator folder = folders.beginArray(); folder != folders.endArray(); ++folder)
+			{
+				const LLSD& items = (*folder)["items"];
+				for (LLSD::array_const_iterator item = items.beginArray(); item != items.endArray(); ++item)
+				{
+					old_items.push_back(old_map_t());
+					old_map_t& old_item = old_items.back();
+					for (LLSD::map_const_iterator field = item->beginMap(); field != item->endMap(); ++field)
+					{
+						// Fresh key strings, as parsing a response makes them
+						old_item[std::string(field->first.c_str())] = field->second;
+					}
+				}
+			}
+		}
+		U64 old_bytes = LLMemory::getCurrentRSS() - rss_before;
+
+		timer.reset();
+		S32 copies = 0;
+		for (S32 i = 0; i < NUM_RESPONSES; i++)
+		{
+			LLSD copy = responses[i];
+			// Touching the copy makes it a map of its own
+			copy["folders"][0]["items"][0]["name"] = "renamed";
+			copies += copy["folders"].size();
+		}
+		F64 copy_time = timer.getElapsedTimeF64();
+
+		timer.reset();
+		responses.clear();
+		F64 free_time = timer.getElapsedTimeF64();
+
+		S32 num_items = NUM_RESPONSES * FOLDERS_PER_RESPONSE * 60;
+		llinfos << "LLSD maps, " << NUM_RESPONSES << " FetchInventoryDescendents responses of "
+				<< FOLDERS_PER_RESPONSE << " folders: build " << build_time * 1000.0
+				<< " ms, walk x5 " << walk_time * 1000.0 << " ms, copy " << copy_time * 1000.0
+				<< " ms, free " << free_time * 1000.0 << " ms" << llendl;
+		llinfos << "LLSD maps, resident size of the responses " << sd_bytes / 1024
+				<< " KB; " << num_items << " item maps alone as std::map "
+				<< old_bytes / 1024 << " KB" << llendl;
+
+		ensure("walked", total > 0);
+		ensure_equals("copied", copies, NUM_RESPONSES * FOLDERS_PER_RESPONSE);
+		ensure_equals("old items", (S32)old_items.size(), num_items);
+	}
+}
@@ -32,6 +32,7 @@
 #include "linden_common.h"
 
 #include "llimagedxt.h"
+#include "llmath.h"
 
 //static
 void LLImageDXT::checkMinWidthHeight(EFileFormat format, S32& width, S32& height)
@@ -268,6 +269,23 @@ BOOL LLImageDXT::decode(LLImageRaw* raw_image, F32 time)
 	//  but we don't use it any more!
 	llassert_always(raw_image);
 	
+	if (mFileFormat == FORMAT_DXR1 || mFileFormat == FORMAT_DXR5)
+	{
+		// Blocks written by encodeCompressed()
+		S32 discard = llmax(mDiscardLevel, (S8)0);
+		S32 width = llmax(getWidth() >> discard, 1);
+		S32 height = llmax(getHeight() >> discard, 1);
+		U8* data = getData() + getMipOffset(discard);
+		if ((!getData()) || (data + formatBytes(mFileFormat, width, height) > getData() + getDataSize()))
+		{
+			setLastError("LLImageDXT trying to decode an image with not enough data!");
+			return FALSE;
+		}
+		S32 ncomponents = formatComponents(mFileFormat);
+		raw_image->resize(width, height, ncomponents);
+		decompressLevel(data, width, height, ncomponents, raw_image->getData(), mFileFormat == FORMAT_DXR5);
+		return TRUE;
+	}
 	if (mFileFormat >= FORMAT_DXT1 && mFileFormat <= FORMAT_DXR5)
 	{
 		llwarns << "Attempt to decode compressed LLImageDXT to Raw (unsupported)" << llendl;
@@ -509,3 +527,597 @@ void LLImageDXT::extractMip(const U8 *indata, U8* mipdata, int width, int height
 }
 
 //============================================================================
+
+//============================================================================
+// DXT block compression
+//
+// Colour end points come either from the bounding box of the block, inset a
+// little and laid along the diagonal the pixels follow (fast), or from the
+// principal axis of the block refined by least squares (high quality).
+// Alpha always gets the eight value DXT5 ramp between its extremes.
+
+namespace
+{
+	inline U16 pack_565(F32 r, F32 g, F32 b)
+	{
+		S32 ri = llclamp(llround(r * (31.f / 255.f)), 0, 31);
+		S32 gi = llclamp(llround(g * (63.f / 255.f)), 0, 63);
+		S32 bi = llclamp(llround(b * (31.f / 255.f)), 0, 31);
+		return (U16)((ri << 11) | (gi << 5) | bi);
+	}
+
+	inline void unpack_565(U16 color, S32* rgb)
+	{
+		S32 r = (color >> 11) & 31;
+		S32 g = (color >> 5) & 63;
+		S32 b = color & 31;
+		rgb[0] = (r << 3) | (r >> 2);
+		rgb[1] = (g << 2) | (g >> 4);
+		rgb[2] = (b << 3) | (b >> 2);
+	}
+
+	inline void write_u16(U8* out, U16 value)
+	{
+		out[0] = (U8)(value & 0xff);
+		out[1] = (U8)(value >> 8);
+	}
+
+	inline U16 read_u16(const U8* in)
+	{
+		return (U16)(in[0] | (in[1] << 8));
+	}
+
+	// Four colour palette: c0, c1, 2/3 c0 + 1/3 c1, 1/3 c0 + 2/3 c1
+	void color_palette(U16 c0, U16 c1, S32 palette[4][3])
+	{
+		unpack_565(c0, palette[0]);
+		unpack_565(c1, palette[1]);
+		for (S32 i = 0; i < 3; i++)
+		{
+			palette[2][i] = (2 * palette[0][i] + palette[1][i]) / 3;
+			palette[3][i] = (palette[0][i] + 2 * palette[1][i]) / 3;
+		}
+	}
+
+	// Closest palette entry for every pixel, two bits each.
+	U32 color_indices(const U8* rgba, S32 palette[4][3], S32& error)
+	{
+		U32 indices = 0;
+		error = 0;
+		for (S32 i = 0; i < 16; i++)
+		{
+			const U8* p = rgba + i * 4;
+			S32 best = 0;
+			S32 best_dist = 0x7fffffff;
+			for (S32 j = 0; j < 4; j++)
+			{
+				S32 dr = p[0] - palette[j][0];
+				S32 dg = p[1] - palette[j][1];
+				S32 db = p[2] - palette[j][2];
+				S32 dist = dr * dr + dg * dg + db * db;
+				if (dist < best_dist)
+				{
+					best_dist = dist;
+					best = j;
+				}
+			}
+			indices |= (U32)best << (i * 2);
+			error += best_dist;
+		}
+		return indices;
+	}
+
+	// Fast end points: bounding box of the block, inset by 1/16th, with
+	// green and blue flipped when they run against red.
+	void fit_bounding_box(const U8* rgba, F32* max_color, F32* min_color)
+	{
+		S32 lo[3] = { 255, 255, 255 };
+		S32 hi[3] = { 0, 0, 0 };
+		for (S32 i = 0; i < 16; i++)
+		{
+			for (S32 c = 0; c < 3; c++)
+			{
+				lo[c] = llmin(lo[c], (S32)rgba[i * 4 + c]);
+				hi[c] = llmax(hi[c], (S32)rgba[i * 4 + c]);
+			}
+		}
+
+		F32 center[3];
+		for (S32 c = 0; c < 3; c++)
+		{
+			S32 inset = (hi[c] - lo[c]) >> 4;
+			max_color[c] = (F32)(hi[c] - inset);
+			min_color[c] = (F32)(lo[c] + inset);
+			center[c] = 0.5f * (hi[c] + lo[c]);
+		}
+
+		F32 cov_rg = 0.f, cov_rb = 0.f;
+		for (S32 i = 0; i < 16; i++)
+		{
+			F32 r = rgba[i * 4] - center[0];
+			cov_rg += r * (rgba[i * 4 + 1] - center[1]);
+			cov_rb += r * (rgba[i * 4 + 2] - center[2]);
+		}
+		if (cov_rg < 0.f)
+		{
+			std::swap(max_color[1], min_color[1]);
+		}
+		if (cov_rb < 0.f)
+		{
+			std::swap(max_color[2], min_color[2]);
+		}
+	}
+
+	// High quality end points: extremes of the block along its principal axis.
+	void fit_principal_axis(const U8* rgba, F32* max_color, F32* min_color)
+	{
+		F32 mean[3] = { 0.f, 0.f, 0.f };
+		for (S32 i = 0; i < 16; i++)
+		{
+			for (S32 c = 0; c < 3; c++)
+			{
+				mean[c] += rgba[i * 4 + c];
+			}
+		}
+		for (S32 c = 0; c < 3; c++)
+		{
+			mean[c] *= 1.f / 16.f;
+		}
+
+		// Covariance: rr, rg, rb, gg, gb, bb
+		F32 cov[6] = { 0.f, 0.f, 0.f, 0.f, 0.f, 0.f };
+		for (S32 i = 0; i < 16; i++)
+		{
+			F32 r = rgba[i * 4] - mean[0];
+			F32 g = rgba[i * 4 + 1] - mean[1];
+			F32 b = rgba[i * 4 + 2] - mean[2];
+			cov[0] += r * r;
+			cov[1] += r * g;
+			cov[2] += r * b;
+			cov[3] += g * g;
+			cov[4] += g * b;
+			cov[5] += b * b;
+		}
+
+		// Power iteration, seeded with the largest column
+		F32 axis[3] = { cov[0], cov[1], cov[2] };
+		if (cov[3] > cov[0] && cov[3] >= cov[5])
+		{
+			axis[0] = cov[1]; axis[1] = cov[3]; axis[2] = cov[4];
+		}
+		else if (cov[5] > cov[0])
+		{
+			axis[0] = cov[2]; axis[1] = cov[4]; axis[2] = cov[5];
+		}
+		for (S32 iter = 0; iter < 4; iter++)
+		{
+			F32 x = cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2];
+			F32 y = cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2];
+			F32 z = cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2];
+			F32 norm = llmax(fabsf(x), llmax(fabsf(y), fabsf(z)));
+			if (norm < 1e-6f)
+			{
+				break;
+			}
+			axis[0] = x / norm;
+			axis[1] = y / norm;
+			axis[2] = z / norm;
+		}
+
+		F32 len2 = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+		if (len2 < 1e-6f)
+		{
+			// Flat block
+			for (S32 c = 0; c < 3; c++)
+			{
+				max_color[c] = min_color[c] = mean[c];
+			}
+			return;
+		}
+
+		F32 min_t = 1e30f, max_t = -1e30f;
+		for (S32 i = 0; i < 16; i++)
+		{
+			F32 t = (rgba[i * 4] - mean[0]) * axis[0] +
+					(rgba[i * 4 + 1] - mean[1]) * axis[1] +
+					(rgba[i * 4 + 2] - mean[2]) * axis[2];
+			min_t = llmin(min_t, t);
+			max_t = llmax(max_t, t);
+		}
+		for (S32 c = 0; c < 3; c++)
+		{
+			max_color[c] = mean[c] + axis[c] * max_t / len2;
+			min_color[c] = mean[c] + axis[c] * min_t / len2;
+		}
+	}
+
+	// Least squares end points for the given indices. Returns false when the
+	// indices don't constrain both end points.
+	bool refine_end_points(const U8* rgba, U32 indices, F32* max_color, F32* min_color)
+	{
+		static const F32 weights[4] = { 1.f, 0.f, 2.f / 3.f, 1.f / 3.f };
+		F32 aa = 0.f, bb = 0.f, ab = 0.f;
+		F32 ax[3] = { 0.f, 0.f, 0.f };
+		F32 bx[3] = { 0.f, 0.f, 0.f };
+		for (S32 i = 0; i < 16; i++)
+		{
+			F32 a = weights[(indices >> (i * 2)) & 3];
+			F32 b = 1.f - a;
+			aa += a * a;
+			bb += b * b;
+			ab += a * b;
+			for (S32 c = 0; c < 3; c++)
+			{
+				ax[c] += a * rgba[i * 4 + c];
+				bx[c] += b * rgba[i * 4 + c];
+			}
+		}
+		F32 det = aa * bb - ab * ab;
+		if (fabsf(det) < 1e-6f)
+		{
+			return false;
+		}
+		F32 inv_det = 1.f / det;
+		for (S32 c = 0; c < 3; c++)
+		{
+			max_color[c] = llclamp((ax[c] * bb - bx[c] * ab) * inv_det, 0.f, 255.f);
+			min_color[c] = llclamp((bx[c] * aa - ax[c] * ab) * inv_det, 0.f, 255.f);
+		}
+		return true;
+	}
+
+	// Four colour block (c0 > c1), so DXT1 never falls into its punch-through mode.
+	void compress_color_block(const U8* rgba, U8* block, bool high_quality)
+	{
+		F32 max_color[3], min_color[3];
+		if (high_quality)
+		{
+			fit_principal_axis(rgba, max_color, min_color);
+		}
+		else
+		{
+			fit_bounding_box(rgba, max_color, min_color);
+		}
+
+		U16 c0 = pack_565(max_color[0], max_color[1], max_color[2]);
+		U16 c1 = pack_565(min_color[0], min_color[1], min_color[2]);
+		S32 palette[4][3];
+		S32 error = 0;
+		U32 indices = 0;
+		if (c0 != c1)
+		{
+			color_palette(c0, c1, palette);
+			indices = color_indices(rgba, palette, error);
+		}
+
+		if (high_quality && c0 != c1)
+		{
+			for (S32 iter = 0; iter < 2; iter++)
+			{
+				if (!refine_end_points(rgba, indices, max_color, min_color))
+				{
+					break;
+				}
+				U16 r0 = pack_565(max_color[0], max_color[1], max_color[2]);
+				U16 r1 = pack_565(min_color[0], min_color[1], min_color[2]);
+				if (r0 == r1 || (r0 == c0 && r1 == c1))
+				{
+					break;
+				}
+				S32 refined_error = 0;
+				color_palette(r0, r1, palette);
+				U32 refined = color_indices(rgba, palette, refined_error);
+				if (refined_error >= error)
+				{
+					break;
+				}
+				c0 = r0;
+				c1 = r1;
+				indices = refined;
+				error = refined_error;
+			}
+		}
+
+		if (c0 < c1)
+		{
+			// Swapping the end points swaps indices 0<->1 and 2<->3
+			std::swap(c0, c1);
+			indices ^= 0x55555555;
+		}
+		else if (c0 == c1)
+		{
+			indices = 0;
+		}
+
+		write_u16(block, c0);
+		write_u16(block + 2, c1);
+		block[4] = (U8)(indices & 0xff);
+		block[5] = (U8)((indices >> 8) & 0xff);
+		block[6] = (U8)((indices >> 16) & 0xff);
+		block[7] = (U8)(indices >> 24);
+	}
+
+	void decompress_color_block(const U8* block, U8* rgba, bool dxt1)
+	{
+		U16 c0 = read_u16(block);
+		U16 c1 = read_u16(block + 2);
+		S32 palette[4][3];
+		S32 alpha[4] = { 255, 255, 255, 255 };
+		color_palette(c0, c1, palette);
+		if (dxt1 && c0 <= c1)
+		{
+			for (S32 i = 0; i < 3; i++)
+			{
+				palette[2][i] = (palette[0][i] + palette[1][i]) / 2;
+				palette[3][i] = 0;
+			}
+			alpha[3] = 0;
+		}
+		U32 indices = block[4] | (block[5] << 8) | (block[6] << 16) | ((U32)block[7] << 24);
+		for (S32 i = 0; i < 16; i++)
+		{
+			S32 idx = (indices >> (i * 2)) & 3;
+			rgba[i * 4] = (U8)palette[idx][0];
+			rgba[i * 4 + 1] = (U8)palette[idx][1];
+			rgba[i * 4 + 2] = (U8)palette[idx][2];
+			rgba[i * 4 + 3] = (U8)alpha[idx];
+		}
+	}
+
+	// Eight value ramp (a0 > a1), three bits per pixel
+	void compress_alpha_block(const U8* rgba, U8* block)
+	{
+		S32 amin = 255, amax = 0;
+		for (S32 i = 0; i < 16; i++)
+		{
+			amin = llmin(amin, (S32)rgba[i * 4 + 3]);
+			amax = llmax(amax, (S32)rgba[i * 4 + 3]);
+		}
+		block[0] = (U8)amax;
+		block[1] = (U8)amin;
+
+		U64 bits = 0;
+		if (amax > amin)
+		{
+			S32 ramp[8];
+			ramp[0] = amax;
+			ramp[1] = amin;
+			for (S32 j = 2; j < 8; j++)
+			{
+				ramp[j] = ((8 - j) * amax + (j - 1) * amin) / 7;
+			}
+			for (S32 i = 0; i < 16; i++)
+			{
+				S32 a = rgba[i * 4 + 3];
+				S32 best = 0;
+				S32 best_dist = 256;
+				for (S32 j = 0; j < 8; j++)
+				{
+					S32 dist = llabs(a - ramp[j]);
+					if (dist < best_dist)
+					{
+						best_dist = dist;
+						best = j;
+					}
+				}
+				bits |= (U64)best << (i * 3);
+			}
+		}
+		for (S32 i = 0; i < 6; i++)
+		{
+			block[2 + i] = (U8)((bits >> (i * 8)) & 0xff);
+		}
+	}
+
+	void decompress_alpha_block(const U8* block, U8* rgba)
+	{
+		S32 ramp[8];
+		ramp[0] = block[0];
+		ramp[1] = block[1];
+		if (ramp[0] > ramp[1])
+		{
+			for (S32 j = 2; j < 8; j++)
+			{
+				ramp[j] = ((8 - j) * ramp[0] + (j - 1) * ramp[1]) / 7;
+			}
+		}
+		else
+		{
+			for (S32 j = 2; j < 6; j++)
+			{
+				ramp[j] = ((6 - j) * ramp[0] + (j - 1) * ramp[1]) / 5;
+			}
+			ramp[6] = 0;
+			ramp[7] = 255;
+		}
+		U64 bits = 0;
+		for (S32 i = 0; i < 6; i++)
+		{
+			bits |= (U64)block[2 + i] << (i * 8);
+		}
+		for (S32 i = 0; i < 16; i++)
+		{
+			rgba[i * 4 + 3] = (U8)ramp[(bits >> (i * 3)) & 7];
+		}
+	}
+}
+
+//static
+void LLImageDXT::compressBlockDXT1(const U8* rgba, U8* block, bool high_quality)
+{
+	compress_color_block(rgba, block, high_quality);
+}
+
+//static
+void LLImageDXT::compressBlockDXT5(const U8* rgba, U8* block, bool high_quality)
+{
+	compress_alpha_block(rgba, block);
+	compress_color_block(rgba, block + 8, high_quality);
+}
+
+//static
+void LLImageDXT::decompressBlockDXT1(const U8* block, U8* rgba)
+{
+	decompress_color_block(block, rgba, true);
+}
+
+//static
+void LLImageDXT::decompressBlockDXT5(const U8* block, U8* rgba)
+{
+	decompress_color_block(block + 8, rgba, false);
+	decompress_alpha_block(block, rgba);
+}
+
+//static
+void LLImageDXT::compressLevel(const U8* indata, S32 width, S32 height, S32 ncomponents,
+							   U8* outdata, bool dxt5, bool high_quality)
+{
+	U8 pixels[64];
+	for (S32 by = 0; by < height; by += 4)
+	{
+		for (S32 bx = 0; bx < width; bx += 4)
+		{
+			// Blocks hanging over the edge of small mips repeat the edge pixels
+			for (S32 y = 0; y < 4; y++)
+			{
+				const U8* row = indata + llmin(by + y, height - 1) * width * ncomponents;
+				for (S32 x = 0; x < 4; x++)
+				{
+					const U8* p = row + llmin(bx + x, width - 1) * ncomponents;
+					U8* q = pixels + (y * 4 + x) * 4;
+					q[0] = p[0];
+					q[1] = p[1];
+					q[2] = p[2];
+					q[3] = ncomponents == 4 ? p[3] : 255;
+				}
+			}
+			if (dxt5)
+			{
+				compressBlockDXT5(pixels, outdata, high_quality);
+				outdata += 16;
+			}
+			else
+			{
+				compressBlockDXT1(pixels, outdata, high_quality);
+				outdata += 8;
+			}
+		}
+	}
+}
+
+//static
+void LLImageDXT::decompressLevel(const U8* indata, S32 width, S32 height, S32 ncomponents,
+								 U8* outdata, bool dxt5)
+{
+	U8 pixels[64];
+	for (S32 by = 0; by < height; by += 4)
+	{
+		for (S32 bx = 0; bx < width; bx += 4)
+		{
+			if (dxt5)
+			{
+				decompressBlockDXT5(indata, pixels);
+				indata += 16;
+			}
+			else
+			{
+				decompressBlockDXT1(indata, pixels);
+				indata += 8;
+			}
+			for (S32 y = 0; y < 4 && by + y < height; y++)
+			{
+				U8* row = outdata + (by + y) * width * ncomponents;
+				for (S32 x = 0; x < 4 && bx + x < width; x++)
+				{
+					memcpy(row + (bx + x) * ncomponents, pixels + (y * 4 + x) * 4, ncomponents);	/* Flawfinder: ignore */
+				}
+			}
+		}
+	}
+}
+
+BOOL LLImageDXT::encodeCompressed(const LLImageRaw* raw_image, bool high_quality)
+{
+	llassert_always(raw_image);
+
+	S32 width = raw_image->getWidth();
+	S32 height = raw_image->getHeight();
+	S32 ncomponents = raw_image->getComponents();
+	const U8* rawdata = raw_image->getData();
+	if (!rawdata || (ncomponents != 3 && ncomponents != 4) || width <= 0 || height <= 0)
+	{
+		setLastError("LLImageDXT::encodeCompressed needs an RGB or RGBA image");
+		return FALSE;
+	}
+	if ((width & (width - 1)) || (height & (height - 1)))
+	{
+		// generateMip() only halves power of two images
+		setLastError("LLImageDXT::encodeCompressed needs power of two dimensions");
+		return FALSE;
+	}
+
+	bool has_alpha = false;
+	if (ncomponents == 4)
+	{
+		const U8* alpha = rawdata + 3;
+		const U8* end = rawdata + width * height * 4;
+		for (; alpha < end; alpha += 4)
+		{
+			if (*alpha != 255)
+			{
+				has_alpha = true;
+				break;
+			}
+		}
+	}
+	EFileFormat format = has_alpha ? FORMAT_DXR5 : FORMAT_DXR1;
+
+	setSize(width, height, formatComponents(format));
+	mHeaderSize = sizeof(dxtfile_header_t);
+	mFileFormat = format;
+
+	S32 nmips = calcNumMips(width, height);
+	S32 totbytes = mHeaderSize;
+	S32 w = width, h = height;
+	for (S32 mip = 0; mip < nmips; mip++)
+	{
+		totbytes += formatBytes(format, w, h);
+		w >>= 1;
+		h >>= 1;
+	}
+
+	if (!allocateData(totbytes))
+	{
+		return FALSE;
+	}
+
+	U8* data = getData();
+	dxtfile_header_t* header = (dxtfile_header_t*)data;
+	memset(header, 0, mHeaderSize);	/* Flawfinder: ignore */
+	header->fourcc = 0x20534444;
+	header->pixel_fmt.fourcc = getFourCC(format);
+	header->num_mips = nmips;
+	header->maxwidth = width;
+	header->maxheight = height;
+
+	// Two scratch levels: the mip being compressed and the next one down
+	std::vector<U8> mip_buffer[2];
+	const U8* level = rawdata;
+	w = width, h = height;
+	for (S32 mip = 0; mip < nmips; mip++)
+	{
+		compressLevel(level, w, h, ncomponents, data + getMipOffset(mip), has_alpha, high_quality);
+		if (mip + 1 < nmips)
+		{
+			std::vector<U8>& next = mip_buffer[mip & 1];
+			next.resize((w >> 1) * (h >> 1) * ncomponents);
+			generateMip(level, &next[0], w >> 1, h >> 1, ncomponents);
+			level = &next[0];
+		}
+		w >>= 1;
+		h >>= 1;
+	}
+
+	setDiscardLevel(0);
+	return TRUE;
+}
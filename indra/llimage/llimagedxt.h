@@ -109,6 +109,10 @@ public:
 	/*virtual*/ BOOL decode(LLImageRaw* raw_image, F32 decode_time);
 	/*virtual*/ BOOL encode(const LLImageRaw* raw_image, F32 encode_time);
 
+	// Compresses raw_image, with all its mips, to DXR1 (DXT1) if it is opaque
+	// or DXR5 (DXT5) if not: the layout LLImageGL uploads compressed textures from.
+	BOOL encodeCompressed(const LLImageRaw* raw_image, bool high_quality = false);
+
 	/*virtual*/ S32 calcHeaderSize();
 	/*virtual*/ S32 calcDataSize(S32 discard_level = 0);
 
@@ -134,9 +138,19 @@ public:
 	static void calcDiscardWidthHeight(S32 discard_level, EFileFormat format, S32& width, S32& height);
 	static S32 calcNumMips(S32 width, S32 height);
 
+	// A 4x4 block of RGBA pixels to and from DXT1 (8 bytes) or DXT5 (16 bytes).
+	static void compressBlockDXT1(const U8* rgba, U8* block, bool high_quality = false);
+	static void compressBlockDXT5(const U8* rgba, U8* block, bool high_quality = false);
+	static void decompressBlockDXT1(const U8* block, U8* rgba);
+	static void decompressBlockDXT5(const U8* block, U8* rgba);
+
 private:
 	static void extractMip(const U8 *indata, U8* mipdata, int width, int height,
 						   int mip_width, int mip_height, EFileFormat format);
+	static void compressLevel(const U8* indata, S32 width, S32 height, S32 ncomponents,
+							  U8* outdata, bool dxt5, bool high_quality);
+	static void decompressLevel(const U8* indata, S32 width, S32 height, S32 ncomponents,
+								U8* outdata, bool dxt5);
 	
 private:
 	EFileFormat mFileFormat;
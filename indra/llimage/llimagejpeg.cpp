@@ -36,7 +36,6 @@
 
 #include "llerror.h"
 
-jmp_buf	LLImageJPEG::sSetjmpBuffer ;
 LLImageJPEG::LLImageJPEG(S32 quality) 
 	:
 	LLImageFormatted(IMG_CODEC_JPEG),
@@ -71,7 +70,8 @@ BOOL LLImageJPEG::updateData()
 	struct jpeg_decompress_struct cinfo;
 	cinfo.client_data = this;
 
-	struct jpeg_error_mgr jerr;
+	LLImageJPEGErrorMgr err_mgr;
+	struct jpeg_error_mgr& jerr = err_mgr.mPub;
 	cinfo.err = jpeg_std_error(&jerr);
 	
 	// Customize with our own callbacks
@@ -83,7 +83,7 @@ BOOL LLImageJPEG::updateData()
 	//try/catch will crash on Mac and Linux if LLImageJPEG::errorExit throws an error
 	//so as instead, we use setjmp/longjmp to avoid this crash, which is the best we can get. --bao 
 	//
-	if(setjmp(sSetjmpBuffer))
+	if(setjmp(err_mgr.mSetjmpBuffer))
 	{
 		jpeg_destroy_decompress(&cinfo);
 		return FALSE;
@@ -212,7 +212,8 @@ BOOL LLImageJPEG::decode(LLImageRaw* raw_image, F32 decode_time)
 	// working space (which is allocated as needed by the JPEG library).
 	struct jpeg_decompress_struct cinfo;
 
-	struct jpeg_error_mgr jerr;
+	LLImageJPEGErrorMgr err_mgr;
+	struct jpeg_error_mgr& jerr = err_mgr.mPub;
 	cinfo.err = jpeg_std_error(&jerr);
 	
 	// Customize with our own callbacks
@@ -224,7 +225,7 @@ BOOL LLImageJPEG::decode(LLImageRaw* raw_image, F32 decode_time)
 	//try/catch will crash on Mac and Linux if LLImageJPEG::errorExit throws an error
 	//so as instead, we use setjmp/longjmp to avoid this crash, which is the best we can get. --bao 
 	//
-	if(setjmp(sSetjmpBuffer))
+	if(setjmp(err_mgr.mSetjmpBuffer))
 	{
 		jpeg_destroy_decompress(&cinfo);
 		return TRUE; // done
@@ -415,6 +416,9 @@ void LLImageJPEG::errorExit( j_common_ptr cinfo )
 {
 	//LLImageJPEG* self = (LLImageJPEG*) cinfo->client_data;
 
+	// Set up by the encode or decode that failed, see LLImageJPEGErrorMgr
+	LLImageJPEGErrorMgr* err_mgr = (LLImageJPEGErrorMgr*)cinfo->err;
+
 	// Always display the message
 	(*cinfo->err->output_message)(cinfo);
 
@@ -422,7 +426,7 @@ void LLImageJPEG::errorExit( j_common_ptr cinfo )
 	jpeg_destroy(cinfo);
 
 	// Return control to the setjmp point
-	longjmp(sSetjmpBuffer, 1) ;
+	longjmp(err_mgr->mSetjmpBuffer, 1) ;
 }
 
 // Decide whether to emit a trace or warning message.
@@ -513,7 +517,8 @@ BOOL LLImageJPEG::encode( const LLImageRaw* raw_image, F32 encode_time )
 	// step fails.  (Unlikely, but it could happen if you are out of memory.)
 	// This routine fills in the contents of struct jerr, and returns jerr's
 	// address which we place into the link field in cinfo.
-	struct jpeg_error_mgr jerr;
+	LLImageJPEGErrorMgr err_mgr;
+	struct jpeg_error_mgr& jerr = err_mgr.mPub;
 	cinfo.err = jpeg_std_error(&jerr);
 
 	// Customize with our own callbacks
@@ -525,7 +530,7 @@ BOOL LLImageJPEG::encode( const LLImageRaw* raw_image, F32 encode_time )
 	//try/catch will crash on Mac and Linux if LLImageJPEG::errorExit throws an error
 	//so as instead, we use setjmp/longjmp to avoid this crash, which is the best we can get. --bao 
 	//
-	if( setjmp(sSetjmpBuffer) ) 
+	if( setjmp(err_mgr.mSetjmpBuffer) ) 
 	{
 		// If we get here, the JPEG code has signaled an error.
 		// We need to clean up the JPEG object, close the input file, and return.
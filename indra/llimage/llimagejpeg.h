@@ -47,6 +47,15 @@ extern "C" {
 #endif
 }
 
+// libjpeg error manager that also holds the point errorExit() jumps back
+// to. Each encode or decode has its own, so images can be coded on
+// several threads at once.
+struct LLImageJPEGErrorMgr
+{
+	struct jpeg_error_mgr	mPub;			// must come first, libjpeg only sees this
+	jmp_buf					mSetjmpBuffer;	// To allow the library to abort.
+};
+
 class LLImageJPEG : public LLImageFormatted
 {
 protected:
@@ -85,8 +94,6 @@ protected:
 	S32				mOutputBufferSize;	// bytes in mOuputBuffer
 
 	S32				mEncodeQuality;		// on a scale from 1 to 100
-private:
-	static jmp_buf	sSetjmpBuffer;		// To allow the library to abort.
 };
 
 #endif  // LL_LLIMAGEJPEG_H
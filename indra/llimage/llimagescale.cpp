@@ -0,0 +1,243 @@
+/** 
+ * @file llimagescale.cpp
+ * @brief Separable box filter resampling of 8 bit images.
+ *
+ * $LicenseInfo:firstyear=2010&license=viewergpl$
+ * 
+ * Copyright (c) 2010, Linden Research, Inc.
+ * 
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ * 
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ * 
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ * 
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "llimagescale.h"
+#include "llmath.h"
+#include "llsys.h"
+
+//---------------------------------------------------------------------------
+// LLImageScaleFilter
+//---------------------------------------------------------------------------
+
+LLImageScaleFilter::LLImageScaleFilter(S32 in_len, S32 out_len)
+	: mInLength(in_len),
+	  mIdentity(in_len == out_len)
+{
+	llassert(in_len > 0 && out_len > 0);
+
+	mFirst.resize(out_len);
+	mStart.resize(out_len + 1);
+	mWeights.reserve(out_len * (in_len / out_len + 2));
+
+	const F32 ratio = F32(in_len) / out_len; // ratio of old to new
+	const F32 norm_factor = 1.f / ratio;
+
+	for (S32 x = 0; x < out_len; x++)
+	{
+		mStart[x] = (S32)mWeights.size();
+
+		// Sample input pixels in range from sample0 to sample1.
+		// Avoid floating point accumulation error... don't just add ratio each time.  JC
+		const F32 sample0 = x * ratio;
+		const F32 sample1 = (x+1) * ratio;
+		const S32 index0 = llfloor(sample0);			// left integer (floor)
+		const S32 index1 = llfloor(sample1);			// right integer (floor)
+		const F32 fract0 = 1.f - (sample0 - F32(index0));	// spill over on left
+		const F32 fract1 = sample1 - F32(index1);			// spill-over on right
+
+		mFirst[x] = index0;
+		if (index0 == index1)
+		{
+			// Interval is embedded in one input pixel
+			mWeights.push_back(1.f);
+			continue;
+		}
+
+		// Left straddle
+		mWeights.push_back(fract0 * norm_factor);
+
+		// Central interval
+		for (S32 u = index0 + 1; u < index1; u++)
+		{
+			mWeights.push_back(norm_factor);
+		}
+
+		// Right straddle
+		// Watch out for reading off of end of input array.
+		if (fract1 && index1 < in_len)
+		{
+			mWeights.push_back(fract1 * norm_factor);
+		}
+	}
+	mStart[out_len] = (S32)mWeights.size();
+}
+
+//---------------------------------------------------------------------------
+// LLImageScale
+//---------------------------------------------------------------------------
+
+//static
+bool LLImageScale::sUseSSE2 = false;
+LLImageScale::scale_columns_func_t LLImageScale::sScaleColumnsFunc = &LLImageScale::scaleColumnsScalar;
+LLImageScale::scale_row_func_t LLImageScale::sScaleRowFunc = &LLImageScale::scaleRowScalar;
+
+//static
+void LLImageScale::initClass()
+{
+	setUseSSE2(gSysCPU.hasSSE2());
+	llinfos << "Image scaling kernels: " << (sUseSSE2 ? "SSE2" : "scalar") << llendl;
+}
+
+//static
+void LLImageScale::setUseSSE2(bool use_sse2)
+{
+	sUseSSE2 = use_sse2 && supportsSSE2();
+	if (sUseSSE2)
+	{
+		sScaleColumnsFunc = &scaleColumnsSSE2;
+		sScaleRowFunc = &scaleRowSSE2;
+	}
+	else
+	{
+		sScaleColumnsFunc = &scaleColumnsScalar;
+		sScaleRowFunc = &scaleRowScalar;
+	}
+}
+
+//static
+void LLImageScale::scale(const U8* in, S32 in_width, S32 in_height,
+						 U8* out, S32 out_width, S32 out_height, S32 components)
+{
+	llassert(components >= 1 && components <= 4);
+
+	const S32 in_row_bytes = in_width * components;
+	if (in_width == out_width && in_height == out_height)
+	{
+		memcpy(out, in, in_row_bytes * in_height);	/* Flawfinder: ignore */
+		return;
+	}
+
+	// Vertical, straight into the output when there is no horizontal pass
+	std::vector<U8> temp;
+	const U8* rows = in;
+	if (in_height != out_height)
+	{
+		U8* dst = out;
+		if (in_width != out_width)
+		{
+			temp.resize(in_row_bytes * out_height);
+			dst = &temp[0];
+		}
+		scaleColumns(in, dst, in_row_bytes, LLImageScaleFilter(in_height, out_height));
+		rows = dst;
+	}
+
+	// Horizontal
+	if (in_width != out_width)
+	{
+		LLImageScaleFilter filter_x(in_width, out_width);
+		const S32 out_row_bytes = out_width * components;
+		for (S32 row = 0; row < out_height; row++)
+		{
+			scaleRow(rows + in_row_bytes * row, out + out_row_bytes * row, components, filter_x);
+		}
+	}
+}
+
+//static
+void LLImageScale::scaleColumns(const U8* in, U8* out, S32 row_bytes, const LLImageScaleFilter& filter)
+{
+	sScaleColumnsFunc(in, out, row_bytes, filter);
+}
+
+//static
+void LLImageScale::scaleRow(const U8* in, U8* out, S32 components, const LLImageScaleFilter& filter)
+{
+	sScaleRowFunc(in, out, components, filter);
+}
+
+//static
+void LLImageScale::scaleColumnsScalar(const U8* in, U8* out, S32 row_bytes, const LLImageScaleFilter& filter)
+{
+	std::vector<F32> acc(row_bytes);
+	const S32 out_len = filter.getOutLength();
+	for (S32 y = 0; y < out_len; y++)
+	{
+		const F32* weights = &filter.mWeights[filter.mStart[y]];
+		const S32 taps = filter.mStart[y + 1] - filter.mStart[y];
+		const U8* src = in + row_bytes * filter.mFirst[y];
+		U8* dst = out + row_bytes * y;
+
+		if (taps == 1 && weights[0] == 1.f)
+		{
+			memcpy(dst, src, row_bytes);	/* Flawfinder: ignore */
+			continue;
+		}
+
+		for (S32 i = 0; i < row_bytes; i++)
+		{
+			acc[i] = src[i] * weights[0];
+		}
+		for (S32 t = 1; t < taps; t++)
+		{
+			src += row_bytes;
+			const F32 w = weights[t];
+			for (S32 i = 0; i < row_bytes; i++)
+			{
+				acc[i] += src[i] * w;
+			}
+		}
+		for (S32 i = 0; i < row_bytes; i++)
+		{
+			dst[i] = U8(llround(acc[i]));
+		}
+	}
+}
+
+//static
+void LLImageScale::scaleRowScalar(const U8* in, U8* out, S32 components, const LLImageScaleFilter& filter)
+{
+	const S32 out_len = filter.getOutLength();
+	for (S32 x = 0; x < out_len; x++)
+	{
+		const F32* weights = &filter.mWeights[filter.mStart[x]];
+		const S32 taps = filter.mStart[x + 1] - filter.mStart[x];
+		const U8* src = in + components * filter.mFirst[x];
+
+		F32 acc[4] = { 0.f, 0.f, 0.f, 0.f };
+		for (S32 t = 0; t < taps; t++)
+		{
+			for (S32 c = 0; c < components; c++)
+			{
+				acc[c] += src[c] * weights[t];
+			}
+			src += components;
+		}
+		for (S32 c = 0; c < components; c++)
+		{
+			out[c] = U8(llround(acc[c]));
+		}
+		out += components;
+	}
+}
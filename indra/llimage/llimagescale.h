@@ -0,0 +1,106 @@
+/** 
+ * @file llimagescale.h
+ * @brief Separable box filter resampling of 8 bit images.
+ *
+ * $LicenseInfo:firstyear=2010&license=viewergpl$
+ * 
+ * Copyright (c) 2010, Linden Research, Inc.
+ * 
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ * 
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ * 
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ * 
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLIMAGESCALE_H
+#define LL_LLIMAGESCALE_H
+
+#include <vector>
+
+// Box filter along one axis: each output pixel is the area average of the
+// input pixels it covers, with fractional weights for the pixels straddling
+// its edges. Upscales copy or blend at most two input pixels. The taps are
+// computed once per axis instead of once per row/column.
+class LLImageScaleFilter
+{
+public:
+	LLImageScaleFilter(S32 in_len, S32 out_len);
+
+	S32 getInLength() const		{ return mInLength; }
+	S32 getOutLength() const	{ return (S32)mFirst.size(); }
+
+	// TRUE when every output pixel is a copy of the matching input pixel.
+	BOOL isIdentity() const		{ return mIdentity; }
+
+	// Taps of output pixel i are mWeights[mStart[i]..mStart[i+1]), applied
+	// to the consecutive input pixels starting at mFirst[i].
+	std::vector<S32> mFirst;
+	std::vector<S32> mStart;
+	std::vector<F32> mWeights;
+
+private:
+	S32 mInLength;
+	BOOL mIdentity;
+};
+
+// Scaling kernels used by LLImageRaw. Both passes walk whole rows, so the
+// vertical pass streams through memory instead of striding down columns.
+// The SSE2 kernels are picked at run time by initClass().
+class LLImageScale
+{
+public:
+	static void initClass();
+
+	// Scales in (in_width x in_height) to out (out_width x out_height).
+	// Both images have the same number of components (1 to 4).
+	static void scale(const U8* in, S32 in_width, S32 in_height,
+					  U8* out, S32 out_width, S32 out_height, S32 components);
+
+	// Vertical pass: each output row is the weighted sum of input rows of
+	// row_bytes bytes. filter spans the image height.
+	static void scaleColumns(const U8* in, U8* out, S32 row_bytes, const LLImageScaleFilter& filter);
+
+	// Horizontal pass over one row of pixels. filter spans the image width.
+	static void scaleRow(const U8* in, U8* out, S32 components, const LLImageScaleFilter& filter);
+
+	static void setUseSSE2(bool use_sse2);
+	static bool getUseSSE2()	{ return sUseSSE2; }
+
+	// Whether the SSE2 kernels were compiled in (llimagescale_sse2.cpp).
+	static bool supportsSSE2();
+
+private:
+	static void scaleColumnsScalar(const U8* in, U8* out, S32 row_bytes, const LLImageScaleFilter& filter);
+	static void scaleRowScalar(const U8* in, U8* out, S32 components, const LLImageScaleFilter& filter);
+
+	// These require compiler options for SSE2 (see llimagescale_sse2.cpp).
+	static void scaleColumnsSSE2(const U8* in, U8* out, S32 row_bytes, const LLImageScaleFilter& filter);
+	static void scaleRowSSE2(const U8* in, U8* out, S32 components, const LLImageScaleFilter& filter);
+
+	typedef void (*scale_columns_func_t)(const U8* in, U8* out, S32 row_bytes, const LLImageScaleFilter& filter);
+	typedef void (*scale_row_func_t)(const U8* in, U8* out, S32 components, const LLImageScaleFilter& filter);
+
+	static bool sUseSSE2;
+	static scale_columns_func_t sScaleColumnsFunc;
+	static scale_row_func_t sScaleRowFunc;
+};
+
+#endif // LL_LLIMAGESCALE_H
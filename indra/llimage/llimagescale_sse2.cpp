@@ -0,0 +1,202 @@
+/** 
+ * @file llimagescale_sse2.cpp
+ * @brief SSE2 kernels for LLImageScale.
+ *
+ * $LicenseInfo:firstyear=2010&license=viewergpl$
+ * 
+ * Copyright (c) 2010, Linden Research, Inc.
+ * 
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ * 
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ * 
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ * 
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+// Visual Studio required settings for this file:
+// Precompiled Headers OFF
+// Code Generation: SSE2
+
+#include "linden_common.h"
+
+#include "llimagescale.h"
+
+#if defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP > 1) || defined(_M_X64)
+
+#include <emmintrin.h>
+
+// Rounds four non-negative floats like llround() and packs them to bytes,
+// saturating, in the low 32 bits of the result.
+inline __m128i round_pack(const __m128& a, const __m128& half)
+{
+	__m128i v = _mm_cvttps_epi32(_mm_add_ps(a, half));
+	v = _mm_packs_epi32(v, v);
+	return _mm_packus_epi16(v, v);
+}
+
+//static
+void LLImageScale::scaleColumnsSSE2(const U8* in, U8* out, S32 row_bytes, const LLImageScaleFilter& filter)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128 half = _mm_set1_ps(0.5f);
+
+	const S32 out_len = filter.getOutLength();
+	for (S32 y = 0; y < out_len; y++)
+	{
+		const F32* weights = &filter.mWeights[filter.mStart[y]];
+		const S32 taps = filter.mStart[y + 1] - filter.mStart[y];
+		const U8* src_row = in + row_bytes * filter.mFirst[y];
+		U8* dst = out + row_bytes * y;
+
+		if (taps == 1 && weights[0] == 1.f)
+		{
+			memcpy(dst, src_row, row_bytes);	/* Flawfinder: ignore */
+			continue;
+		}
+
+		// 16 bytes at a time, all taps accumulated in registers
+		S32 i = 0;
+		for ( ; i + 16 <= row_bytes; i += 16)
+		{
+			__m128 acc0 = _mm_setzero_ps();
+			__m128 acc1 = _mm_setzero_ps();
+			__m128 acc2 = _mm_setzero_ps();
+			__m128 acc3 = _mm_setzero_ps();
+			const U8* src = src_row + i;
+			for (S32 t = 0; t < taps; t++)
+			{
+				const __m128 w = _mm_set1_ps(weights[t]);
+				const __m128i v = _mm_loadu_si128((const __m128i*)src);
+				const __m128i lo = _mm_unpacklo_epi8(v, zero);
+				const __m128i hi = _mm_unpackhi_epi8(v, zero);
+				acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), w));
+				acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), w));
+				acc2 = _mm_add_ps(acc2, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), w));
+				acc3 = _mm_add_ps(acc3, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), w));
+				src += row_bytes;
+			}
+			const __m128i r0 = _mm_cvttps_epi32(_mm_add_ps(acc0, half));
+			const __m128i r1 = _mm_cvttps_epi32(_mm_add_ps(acc1, half));
+			const __m128i r2 = _mm_cvttps_epi32(_mm_add_ps(acc2, half));
+			const __m128i r3 = _mm_cvttps_epi32(_mm_add_ps(acc3, half));
+			_mm_storeu_si128((__m128i*)(dst + i),
+							 _mm_packus_epi16(_mm_packs_epi32(r0, r1), _mm_packs_epi32(r2, r3)));
+		}
+
+		// Leftover bytes, four at a time then one at a time
+		for ( ; i < row_bytes; i += 4)
+		{
+			const S32 count = llmin(4, row_bytes - i);
+			__m128 acc = _mm_setzero_ps();
+			const U8* src = src_row + i;
+			for (S32 t = 0; t < taps; t++)
+			{
+				U32 bytes = 0;
+				for (S32 c = count - 1; c >= 0; c--)
+				{
+					bytes = (bytes << 8) | src[c];
+				}
+				const __m128i v = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128((S32)bytes), zero), zero);
+				acc = _mm_add_ps(acc, _mm_mul_ps(_mm_cvtepi32_ps(v), _mm_set1_ps(weights[t])));
+				src += row_bytes;
+			}
+			U32 packed = (U32)_mm_cvtsi128_si32(round_pack(acc, half));
+			for (S32 c = 0; c < count; c++)
+			{
+				dst[i + c] = U8(packed);
+				packed >>= 8;
+			}
+		}
+	}
+}
+
+//static
+void LLImageScale::scaleRowSSE2(const U8* in, U8* out, S32 components, const LLImageScaleFilter& filter)
+{
+	if (components < 3)
+	{
+		// Not enough channels to fill a vector
+		scaleRowScalar(in, out, components, filter);
+		return;
+	}
+
+	const __m128i zero = _mm_setzero_si128();
+	const __m128 half = _mm_set1_ps(0.5f);
+
+	const S32 out_len = filter.getOutLength();
+	for (S32 x = 0; x < out_len; x++)
+	{
+		const F32* weights = &filter.mWeights[filter.mStart[x]];
+		const S32 taps = filter.mStart[x + 1] - filter.mStart[x];
+		const U8* src = in + components * filter.mFirst[x];
+
+		__m128 acc = _mm_setzero_ps();
+		for (S32 t = 0; t < taps; t++)
+		{
+			// Never read past the pixel: the last one may end the buffer.
+			U32 pixel = src[0] | (src[1] << 8) | (src[2] << 16);
+			if (components == 4)
+			{
+				pixel |= (U32)src[3] << 24;
+			}
+			const __m128i v = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128((S32)pixel), zero), zero);
+			acc = _mm_add_ps(acc, _mm_mul_ps(_mm_cvtepi32_ps(v), _mm_set1_ps(weights[t])));
+			src += components;
+		}
+
+		U32 packed = (U32)_mm_cvtsi128_si32(round_pack(acc, half));
+		out[0] = U8(packed);
+		out[1] = U8(packed >> 8);
+		out[2] = U8(packed >> 16);
+		if (components == 4)
+		{
+			out[3] = U8(packed >> 24);
+		}
+		out += components;
+	}
+}
+
+//static
+bool LLImageScale::supportsSSE2()
+{
+	return true;
+}
+
+#else
+
+//static
+void LLImageScale::scaleColumnsSSE2(const U8* in, U8* out, S32 row_bytes, const LLImageScaleFilter& filter)
+{
+	scaleColumnsScalar(in, out, row_bytes, filter);
+}
+
+//static
+void LLImageScale::scaleRowSSE2(const U8* in, U8* out, S32 components, const LLImageScaleFilter& filter)
+{
+	scaleRowScalar(in, out, components, filter);
+}
+
+//static
+bool LLImageScale::supportsSSE2()
+{
+	return false;
+}
+
+#endif
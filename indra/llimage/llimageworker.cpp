@@ -33,13 +33,14 @@
 #include "linden_common.h"
 
 #include "llimageworker.h"
-#include "llimagedxt.h"
+
+#include "llstl.h"
 
 //----------------------------------------------------------------------------
 
 // MAIN THREAD
-LLImageDecodeThread::LLImageDecodeThread(bool threaded)
-	: LLQueuedThread("imagedecode", threaded)
+LLImageDecodeThread::LLImageDecodeThread(bool threaded, S32 max_jobs)
+	: LLQueuedThread("imagedecode", threaded, max_jobs)
 {
 }
 
@@ -63,6 +64,21 @@ S32 LLImageDecodeThread::update(U32 max_time_ms)
 		}
 	}
 	mCreationList.clear();
+	for (compression_list_t::iterator iter = mCompressionList.begin();
+		 iter != mCompressionList.end(); ++iter)
+	{
+		compression_info& info = *iter;
+		CompressRequest* req = new CompressRequest(info.handle, info.raw, info.compressed,
+												   info.priority, info.high_quality,
+												   info.responder);
+
+		bool res = addRequest(req);
+		if (!res)
+		{
+			llerrs << "request added after LLLFSThread::cleanupClass()" << llendl;
+		}
+	}
+	mCompressionList.clear();
 	S32 res = LLQueuedThread::update(max_time_ms);
 	return res;
 }
@@ -76,12 +92,21 @@ LLImageDecodeThread::handle_t LLImageDecodeThread::decodeImage(LLImageFormatted*
 	return handle;
 }
 
+LLImageDecodeThread::handle_t LLImageDecodeThread::compressImage(LLImageRaw* raw, LLImageDXT* compressed,
+	U32 priority, bool high_quality, CompressResponder* responder)
+{
+	LLMutexLock lock(&mCreationMutex);
+	handle_t handle = generateHandle();
+	mCompressionList.push_back(compression_info(handle, raw, compressed, priority, high_quality, responder));
+	return handle;
+}
+
 // Used by unit test only
-// Returns the size of the mutex guarded list as an indication of sanity
+// Returns the size of the mutex guarded lists as an indication of sanity
 S32 LLImageDecodeThread::tut_size()
 {
 	LLMutexLock lock(&mCreationMutex);
-	S32 res = mCreationList.size();
+	S32 res = mCreationList.size() + mCompressionList.size();
 	return res;
 }
 
@@ -89,6 +114,10 @@ LLImageDecodeThread::Responder::~Responder()
 {
 }
 
+LLImageDecodeThread::CompressResponder::~CompressResponder()
+{
+}
+
 //----------------------------------------------------------------------------
 
 LLImageDecodeThread::ImageRequest::ImageRequest(handle_t handle, LLImageFormatted* image, 
@@ -176,3 +205,216 @@ bool LLImageDecodeThread::ImageRequest::tut_isOK()
 {
 	return mResponder.notNull();
 }
+
+//----------------------------------------------------------------------------
+
+LLImageDecodeThread::CompressRequest::CompressRequest(handle_t handle, LLImageRaw* raw, LLImageDXT* compressed,
+													  U32 priority, bool high_quality,
+													  LLImageDecodeThread::CompressResponder* responder)
+	: LLQueuedThread::QueuedRequest(handle, priority, FLAG_AUTO_COMPLETE),
+	  mImageRaw(raw),
+	  mHighQuality(high_quality),
+	  mCompressedImage(compressed),
+	  mCompressed(false),
+	  mResponder(responder)
+{
+}
+
+LLImageDecodeThread::CompressRequest::~CompressRequest()
+{
+	mImageRaw = NULL;
+	mCompressedImage = NULL;
+}
+
+// Compression is done in a single pass.
+bool LLImageDecodeThread::CompressRequest::processRequest()
+{
+	if (mImageRaw.notNull() && mCompressedImage.notNull() && mImageRaw->getData())
+	{
+		mCompressed = mCompressedImage->encodeCompressed(mImageRaw, mHighQuality);
+	}
+	return true;
+}
+
+void LLImageDecodeThread::CompressRequest::finishRequest(bool completed)
+{
+	if (mResponder.notNull())
+	{
+		bool success = completed && mCompressed;
+		mResponder->completed(success, mCompressedImage);
+	}
+	// Will automatically be deleted
+}
+
+//============================================================================
+
+/*static*/ LLImageEncodeThread::thread_list_t LLImageEncodeThread::sThreads;
+
+//============================================================================
+// Run on MAIN thread
+//static
+void LLImageEncodeThread::initClass(U32 num_threads, bool threaded)
+{
+	llassert(sThreads.empty());
+	num_threads = llmax(num_threads, (U32)1);
+	for (U32 i = 0; i < num_threads; i++)
+	{
+		sThreads.push_back(new LLImageEncodeThread(threaded));
+	}
+}
+
+//static
+S32 LLImageEncodeThread::updateClass(U32 max_time_ms)
+{
+	S32 pending = 0;
+	for (thread_list_t::iterator iter = sThreads.begin(); iter != sThreads.end(); ++iter)
+	{
+		pending += (*iter)->update(max_time_ms);
+	}
+	return pending;
+}
+
+//static
+void LLImageEncodeThread::cleanupClass()
+{
+	for (thread_list_t::iterator iter = sThreads.begin(); iter != sThreads.end(); ++iter)
+	{
+		(*iter)->setQuitting();
+	}
+	while (updateClass(0))
+	{
+	}
+	for_each(sThreads.begin(), sThreads.end(), DeletePointer());
+	sThreads.clear();
+}
+
+//static
+bool LLImageEncodeThread::encodeImage(LLImageRaw* raw, LLImageFormatted* formatted,
+									  bool decode, Responder* responder, U32 priority)
+{
+	if (sThreads.empty())
+	{
+		llwarns << "LLImageEncodeThread::encodeImage called after cleanupClass()" << llendl;
+		return false;
+	}
+	LLImageEncodeThread* least_busy = sThreads.front();
+	S32 least_pending = least_busy->getPending();
+	for (thread_list_t::iterator iter = sThreads.begin() + 1; iter != sThreads.end(); ++iter)
+	{
+		S32 pending = (*iter)->getPending();
+		if (pending < least_pending)
+		{
+			least_busy = *iter;
+			least_pending = pending;
+		}
+	}
+	least_busy->encode(raw, formatted, priority, decode, responder);
+	return true;
+}
+
+//----------------------------------------------------------------------------
+
+LLImageEncodeThread::LLImageEncodeThread(bool threaded)
+	: LLQueuedThread("imageencode", threaded)
+{
+}
+
+LLImageEncodeThread::~LLImageEncodeThread()
+{
+	// ~LLQueuedThread() will be called here
+}
+
+LLImageEncodeThread::handle_t LLImageEncodeThread::encode(LLImageRaw* raw, LLImageFormatted* formatted,
+														  U32 priority, bool decode, Responder* responder)
+{
+	handle_t handle = generateHandle();
+	EncodeRequest* req = new EncodeRequest(this, handle, raw, formatted, priority, decode, responder);
+	bool res = addRequest(req);
+	if (!res)
+	{
+		llerrs << "LLImageEncodeThread::encode called after LLImageEncodeThread::cleanupClass()" << llendl;
+	}
+	return handle;
+}
+
+// MAIN THREAD
+S32 LLImageEncodeThread::update(U32 max_time_ms)
+{
+	S32 res = LLQueuedThread::update(max_time_ms);
+
+	// Hand finished images back to their responders outside of the lock,
+	// they are free to queue more work.
+	completed_list_t completed;
+	{
+		LLMutexLock lock(&mCompletedMutex);
+		completed.swap(mCompletedList);
+	}
+	for (completed_list_t::iterator iter = completed.begin(); iter != completed.end(); ++iter)
+	{
+		iter->responder->completed(iter->success, iter->formatted, iter->decoded);
+	}
+	return res + (S32)completed.size();
+}
+
+//----------------------------------------------------------------------------
+
+LLImageEncodeThread::Responder::~Responder()
+{
+}
+
+//----------------------------------------------------------------------------
+
+LLImageEncodeThread::EncodeRequest::EncodeRequest(LLImageEncodeThread* thread, handle_t handle,
+												  LLImageRaw* raw, LLImageFormatted* formatted,
+												  U32 priority, bool decode, Responder* responder)
+	: LLQueuedThread::QueuedRequest(handle, priority, FLAG_AUTO_COMPLETE),
+	  mThread(thread),
+	  mImageRaw(raw),
+	  mDecode(decode),
+	  mFormattedImage(formatted),
+	  mEncoded(false),
+	  mResponder(responder)
+{
+}
+
+LLImageEncodeThread::EncodeRequest::~EncodeRequest()
+{
+	mImageRaw = NULL;
+	mFormattedImage = NULL;
+	mDecodedImage = NULL;
+}
+
+// Encoding is done in a single pass.
+bool LLImageEncodeThread::EncodeRequest::processRequest()
+{
+	if (mImageRaw.notNull() && mFormattedImage.notNull() && mImageRaw->getData())
+	{
+		mEncoded = mFormattedImage->encode(mImageRaw, 0.f);
+		if (mEncoded && mDecode)
+		{
+			mDecodedImage = new LLImageRaw(mFormattedImage->getWidth(),
+										   mFormattedImage->getHeight(),
+										   mFormattedImage->getComponents());
+			if (!mFormattedImage->decode(mDecodedImage, 0.f))
+			{
+				mDecodedImage = NULL;
+			}
+		}
+	}
+	return true;
+}
+
+void LLImageEncodeThread::EncodeRequest::finishRequest(bool completed)
+{
+	if (mResponder.notNull())
+	{
+		LLMutexLock lock(&mThread->mCompletedMutex);
+		mThread->mCompletedList.push_back(completed_info());
+		completed_info& info = mThread->mCompletedList.back();
+		info.success = completed && mEncoded;
+		info.formatted = mFormattedImage;
+		info.decoded = mDecodedImage;
+		info.responder = mResponder;
+	}
+	// Will automatically be deleted
+}
@@ -33,7 +33,11 @@
 #ifndef LL_LLIMAGEWORKER_H
 #define LL_LLIMAGEWORKER_H
 
+#include <list>
+#include <vector>
+
 #include "llimage.h"
+#include "llimagedxt.h"
 #include "llqueuedthread.h"
 
 class LLImageDecodeThread : public LLQueuedThread
@@ -47,6 +51,14 @@ public:
 		virtual void completed(bool success, LLImageRaw* raw, LLImageRaw* aux) = 0;
 	};
 
+	class CompressResponder : public LLThreadSafeRefCount
+	{
+	protected:
+		virtual ~CompressResponder();
+	public:
+		virtual void completed(bool success, LLImageDXT* compressed) = 0;
+	};
+
 	class ImageRequest : public LLQueuedThread::QueuedRequest
 	{
 	protected:
@@ -75,12 +87,40 @@ public:
 		BOOL mDecodedAux;
 		LLPointer<LLImageDecodeThread::Responder> mResponder;
 	};
+
+	// Compresses a decoded image to DXT (see LLImageDXT::encodeCompressed())
+	class CompressRequest : public LLQueuedThread::QueuedRequest
+	{
+	protected:
+		virtual ~CompressRequest(); // use deleteRequest()
+
+	public:
+		CompressRequest(handle_t handle, LLImageRaw* raw, LLImageDXT* compressed,
+						U32 priority, bool high_quality,
+						LLImageDecodeThread::CompressResponder* responder);
+
+		/*virtual*/ bool processRequest();
+		/*virtual*/ void finishRequest(bool completed);
+
+	private:
+		// input
+		LLPointer<LLImageRaw> mImageRaw;
+		bool mHighQuality;
+		// output
+		LLPointer<LLImageDXT> mCompressedImage;
+		bool mCompressed;
+		LLPointer<LLImageDecodeThread::CompressResponder> mResponder;
+	};
 	
 public:
-	LLImageDecodeThread(bool threaded = true);
+	LLImageDecodeThread(bool threaded = true, S32 max_jobs = 1);
 	handle_t decodeImage(LLImageFormatted* image,
 						 U32 priority, S32 discard, BOOL needs_aux,
 						 Responder* responder);
+	// Fills compressed (a new, empty LLImageDXT) from raw
+	handle_t compressImage(LLImageRaw* raw, LLImageDXT* compressed,
+						   U32 priority, bool high_quality,
+						   CompressResponder* responder);
 	S32 update(U32 max_time_ms);
 
 	// Used by unit tests to check the consistency of the thread instance
@@ -101,7 +141,105 @@ private:
 	};
 	typedef std::list<creation_info> creation_list_t;
 	creation_list_t mCreationList;
+	struct compression_info
+	{
+		handle_t handle;
+		LLPointer<LLImageRaw> raw;
+		LLPointer<LLImageDXT> compressed;
+		U32 priority;
+		bool high_quality;
+		LLPointer<CompressResponder> responder;
+		compression_info(handle_t h, LLImageRaw* i, LLImageDXT* c, U32 p, bool hq, CompressResponder* r)
+			: handle(h), raw(i), compressed(c), priority(p), high_quality(hq), responder(r)
+		{}
+	};
+	typedef std::list<compression_info> compression_list_t;
+	compression_list_t mCompressionList;
 	LLMutex mCreationMutex;
 };
 
+//============================================================================
+// Encodes raw images to any LLImageFormatted (J2C, PNG, JPEG...) off the
+// main thread. Encoders keep their state per image or per call, libjpeg's
+// error recovery point included, so several of these run side by side as
+// a pool; encodeImage() hands each request to the least loaded one. Responders are always called on the main thread, from updateClass().
+//============================================================================
+
+class LLImageEncodeThread : public LLQueuedThread
+{
+public:
+	class Responder : public LLThreadSafeRefCount
+	{
+	protected:
+		virtual ~Responder();
+	public:
+		// decoded is the encoded image decoded back, when it was asked for.
+		virtual void completed(bool success, LLImageFormatted* formatted, LLImageRaw* decoded) = 0;
+	};
+
+	class EncodeRequest : public LLQueuedThread::QueuedRequest
+	{
+	protected:
+		virtual ~EncodeRequest(); // use deleteRequest()
+
+	public:
+		EncodeRequest(LLImageEncodeThread* thread, handle_t handle,
+					  LLImageRaw* raw, LLImageFormatted* formatted,
+					  U32 priority, bool decode, Responder* responder);
+
+		/*virtual*/ bool processRequest();
+		/*virtual*/ void finishRequest(bool completed);
+
+	private:
+		LLImageEncodeThread* mThread;
+		// input
+		LLPointer<LLImageRaw> mImageRaw;
+		bool mDecode;
+		// output
+		LLPointer<LLImageFormatted> mFormattedImage;
+		LLPointer<LLImageRaw> mDecodedImage;
+		bool mEncoded;
+		LLPointer<Responder> mResponder;
+	};
+
+public:
+	LLImageEncodeThread(bool threaded = true);
+	virtual ~LLImageEncodeThread();
+
+	handle_t encode(LLImageRaw* raw, LLImageFormatted* formatted,
+					U32 priority, bool decode, Responder* responder);
+	S32 update(U32 max_time_ms);
+
+	// Run on MAIN thread
+	static void initClass(U32 num_threads, bool threaded = true);
+	static S32 updateClass(U32 max_time_ms);
+	static void cleanupClass();
+
+	// Encodes raw into formatted (a new, empty image of the wanted codec).
+	// raw must not be modified until the responder is called. When decode
+	// is true the result is also decoded back, to preview artifacts.
+	// Returns false when there is no thread to run it.
+	static bool encodeImage(LLImageRaw* raw, LLImageFormatted* formatted,
+							bool decode, Responder* responder,
+							U32 priority = PRIORITY_NORMAL);
+
+	// Used by unit tests to check the consistency of the thread pool
+	static S32 tut_size() { return (S32)sThreads.size(); }
+
+private:
+	struct completed_info
+	{
+		bool success;
+		LLPointer<LLImageFormatted> formatted;
+		LLPointer<LLImageRaw> decoded;
+		LLPointer<Responder> responder;
+	};
+	typedef std::list<completed_info> completed_list_t;
+	completed_list_t mCompletedList;
+	LLMutex mCompletedMutex;
+
+	typedef std::vector<LLImageEncodeThread*> thread_list_t;
+	static thread_list_t sThreads;
+};
+
 #endif
@@ -0,0 +1,356 @@
+/** 
+ * @file llimagedxt_test.cpp
+ * @brief Tests for the DXT1/DXT5 block codec of LLImageDXT
+ *
+ * $LicenseInfo:firstyear=2006&license=viewergpl$
+ * 
+ * Copyright (c) 2006-2009, Linden Research, Inc.
+ * 
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ * 
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ * 
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ * 
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header: almost always required for newview cpp files
+#include "../llcommon/linden_common.h"
+#include <math.h>
+// Class to test
+#include "../llimagedxt.h"
+// For timer class
+#include "../llcommon/lltimer.h"
+// Tut header
+#include "../test/lltut.h"
+
+// -------------------------------------------------------------------------------------------
+// Stubbing: Declarations required to link and run the class being tested
+// Notes: 
+// * LLImageDXT keeps its data in LLImageBase, so the few LLImageBase, LLImageFormatted and
+//   LLImageRaw methods it uses are simulated here with a plain heap buffer.
+// * generateMip() is a straight 2x2 box filter, which is all the mip chain needs.
+
+LLImageBase::LLImageBase()
+	: mData(NULL), mDataSize(0), mWidth(0), mHeight(0), mComponents(0),
+	  mBadBufferAllocation(false), mAllowOverSize(false), mMemType(0) {}
+LLImageBase::~LLImageBase() { LLImageBase::deleteData(); }
+void LLImageBase::dump() { }
+void LLImageBase::sanityCheck() { }
+void LLImageBase::deleteData() { delete[] mData; mData = NULL; mDataSize = 0; }
+U8* LLImageBase::allocateData(S32 size)
+{
+	if (size < 0)
+	{
+		size = mWidth * mHeight * mComponents;
+	}
+	delete[] mData;
+	mData = new U8[size];
+	mDataSize = size;
+	return mData;
+}
+U8* LLImageBase::reallocateData(S32 size) { return allocateData(size); }
+const U8* LLImageBase::getData() const { return mData; }
+U8* LLImageBase::getData() { return mData; }
+void LLImageBase::setSize(S32 width, S32 height, S32 ncomponents)
+{
+	mWidth = width;
+	mHeight = height;
+	mComponents = ncomponents;
+}
+void LLImageBase::generateMip(const U8* indata, U8* mipdata, int width, int height, S32 nchannels)
+{
+	S32 in_stride = width * 2 * nchannels;
+	for (S32 y = 0; y < height; y++)
+	{
+		const U8* row = indata + y * 2 * in_stride;
+		for (S32 x = 0; x < width; x++)
+		{
+			for (S32 c = 0; c < nchannels; c++)
+			{
+				S32 i = x * 2 * nchannels + c;
+				*mipdata++ = (U8)((row[i] + row[i + nchannels] + row[i + in_stride] + row[i + in_stride + nchannels] + 2) >> 2);
+			}
+		}
+	}
+}
+
+LLImageFormatted::LLImageFormatted(S8 codec)
+	: mCodec(codec), mDecoding(0), mDecoded(0), mDiscardLevel(-1) {}
+LLImageFormatted::~LLImageFormatted() { }
+void LLImageFormatted::deleteData() { LLImageBase::deleteData(); }
+U8* LLImageFormatted::allocateData(S32 size) { return LLImageBase::allocateData(size); }
+U8* LLImageFormatted::reallocateData(S32 size) { return LLImageBase::allocateData(size); }
+void LLImageFormatted::dump() { }
+void LLImageFormatted::sanityCheck() { }
+S32 LLImageFormatted::calcDataSize(S32 discard_level) { return 0; }
+S32 LLImageFormatted::calcDiscardLevelBytes(S32 bytes) { return 0; }
+BOOL LLImageFormatted::decodeChannels(LLImageRaw* raw_image, F32 decode_time, S32 first_channel, S32 max_channel) { return FALSE; }
+void LLImageFormatted::setData(U8 *data, S32 size) { LLImageBase::deleteData(); setDataAndSize(data, size); }
+void LLImageFormatted::resetLastError() { }
+void LLImageFormatted::setLastError(const std::string& message, const std::string& filename) { }
+
+LLImageRaw::LLImageRaw(U16 width, U16 height, S8 components) : mCacheEntries(0)
+{
+	setSize(width, height, components);
+	allocateData();
+}
+LLImageRaw::LLImageRaw(U8 *data, U16 width, U16 height, S8 components) : mCacheEntries(0)
+{
+	setSize(width, height, components);
+	memcpy(allocateData(), data, width * height * components);	/* Flawfinder: ignore */
+}
+LLImageRaw::~LLImageRaw() { }
+void LLImageRaw::deleteData() { LLImageBase::deleteData(); }
+U8* LLImageRaw::allocateData(S32 size) { return LLImageBase::allocateData(size); }
+U8* LLImageRaw::reallocateData(S32 size) { return LLImageBase::allocateData(size); }
+BOOL LLImageRaw::resize(U16 width, U16 height, S8 components)
+{
+	setSize(width, height, components);
+	allocateData();
+	return TRUE;
+}
+
+// End Stubbing
+// -------------------------------------------------------------------------------------------
+
+namespace
+{
+	// Smooth gradients with a little deterministic noise: roughly what
+	// terrain and avatar textures look like to a block compressor.
+	LLPointer<LLImageRaw> make_test_image(S32 width, S32 height, S32 ncomponents, bool vary_alpha)
+	{
+		LLPointer<LLImageRaw> raw = new LLImageRaw(width, height, ncomponents);
+		U8* data = raw->getData();
+		U32 seed = 12345;
+		for (S32 y = 0; y < height; y++)
+		{
+			for (S32 x = 0; x < width; x++)
+			{
+				seed = seed * 1664525 + 1013904223;
+				S32 noise = (S32)((seed >> 24) & 15) - 8;
+				U8* p = data + (y * width + x) * ncomponents;
+				p[0] = (U8)llclamp(x * 255 / width + noise, 0, 255);
+				p[1] = (U8)llclamp(y * 255 / height + noise, 0, 255);
+				p[2] = (U8)llclamp(128 + (S32)(96.f * sinf(x * 0.1f) * cosf(y * 0.07f)) + noise, 0, 255);
+				if (ncomponents == 4)
+				{
+					p[3] = vary_alpha ? (U8)((x + y) * 255 / (width + height)) : 255;
+				}
+			}
+		}
+		return raw;
+	}
+
+	// Peak signal to noise ratio over the colour channels (and alpha if both have it)
+	F64 psnr(const LLImageRaw* a, const LLImageRaw* b)
+	{
+		S32 channels = llmin(a->getComponents(), b->getComponents());
+		S32 pixels = a->getWidth() * a->getHeight();
+		F64 err = 0.0;
+		for (S32 i = 0; i < pixels; i++)
+		{
+			for (S32 c = 0; c < channels; c++)
+			{
+				F64 d = (F64)a->getData()[i * a->getComponents() + c] - (F64)b->getData()[i * b->getComponents() + c];
+				err += d * d;
+			}
+		}
+		F64 mse = err / (pixels * channels);
+		return mse > 0.0 ? 10.0 * log10(255.0 * 255.0 / mse) : 99.0;
+	}
+
+	F64 block_psnr(const U8* a, const U8* b, S32 channels)
+	{
+		F64 err = 0.0;
+		for (S32 i = 0; i < 16; i++)
+		{
+			for (S32 c = 0; c < channels; c++)
+			{
+				F64 d = (F64)a[i * 4 + c] - (F64)b[i * 4 + c];
+				err += d * d;
+			}
+		}
+		F64 mse = err / (16 * channels);
+		return mse > 0.0 ? 10.0 * log10(255.0 * 255.0 / mse) : 99.0;
+	}
+}
+
+// -------------------------------------------------------------------------------------------
+// TUT
+// -------------------------------------------------------------------------------------------
+
+namespace tut
+{
+	struct imagedxt_test
+	{
+	};
+
+	typedef test_group<imagedxt_test> imagedxt_t;
+	typedef imagedxt_t::object imagedxt_object_t;
+	tut::imagedxt_t tut_imagedxt("imagedxt");
+
+	template<> template<>
+	void imagedxt_object_t::test<1>()
+	{
+		// A flat block survives up to 565 quantization and never uses the DXT1 punch-through mode
+		U8 pixels[64], decoded[64], block[8];
+		for (S32 i = 0; i < 16; i++)
+		{
+			pixels[i * 4] = 200;
+			pixels[i * 4 + 1] = 100;
+			pixels[i * 4 + 2] = 50;
+			pixels[i * 4 + 3] = 255;
+		}
+		LLImageDXT::compressBlockDXT1(pixels, block, false);
+		LLImageDXT::decompressBlockDXT1(block, decoded);
+		for (S32 i = 0; i < 16; i++)
+		{
+			ensure("LLImageDXT: flat block red", llabs(decoded[i * 4] - 200) <= 4);
+			ensure("LLImageDXT: flat block green", llabs(decoded[i * 4 + 1] - 100) <= 2);
+			ensure("LLImageDXT: flat block blue", llabs(decoded[i * 4 + 2] - 50) <= 4);
+			ensure_equals("LLImageDXT: flat block alpha", (S32)decoded[i * 4 + 3], 255);
+		}
+	}
+
+	template<> template<>
+	void imagedxt_object_t::test<2>()
+	{
+		// A two colour block keeps c0 > c1, so DXT1 stays opaque; the fast fit insets
+		// its end points by 1/16th of the range while the principal axis hits them
+		U8 pixels[64], decoded[64], block[8];
+		for (S32 i = 0; i < 16; i++)
+		{
+			bool dark = (i & 1) != 0;
+			pixels[i * 4] = dark ? 0 : 255;
+			pixels[i * 4 + 1] = dark ? 0 : 255;
+			pixels[i * 4 + 2] = dark ? 0 : 255;
+			pixels[i * 4 + 3] = 255;
+		}
+		for (S32 hq = 0; hq < 2; hq++)
+		{
+			LLImageDXT::compressBlockDXT1(pixels, block, hq != 0);
+			U16 c0 = block[0] | (block[1] << 8);
+			U16 c1 = block[2] | (block[3] << 8);
+			ensure("LLImageDXT: DXT1 end points out of order", c0 > c1);
+			LLImageDXT::decompressBlockDXT1(block, decoded);
+			for (S32 i = 0; i < 64; i++)
+			{
+				ensure("LLImageDXT: two colour block error", llabs(decoded[i] - pixels[i]) <= (hq ? 0 : 16));
+			}
+		}
+	}
+
+	template<> template<>
+	void imagedxt_object_t::test<3>()
+	{
+		// DXT5 keeps an alpha ramp to within half a step of its eight value palette
+		U8 pixels[64], decoded[64], block[16];
+		for (S32 i = 0; i < 16; i++)
+		{
+			pixels[i * 4] = (U8)(i * 16);
+			pixels[i * 4 + 1] = (U8)(255 - i * 16);
+			pixels[i * 4 + 2] = 64;
+			pixels[i * 4 + 3] = (U8)(i * 17);
+		}
+		LLImageDXT::compressBlockDXT5(pixels, block, true);
+		LLImageDXT::decompressBlockDXT5(block, decoded);
+		for (S32 i = 0; i < 16; i++)
+		{
+			ensure("LLImageDXT: DXT5 alpha error", llabs(decoded[i * 4 + 3] - pixels[i * 4 + 3]) <= 19);
+		}
+		// Sixteen colour steps squeezed into four cost about 24 dB
+		ensure("LLImageDXT: DXT5 colour error", block_psnr(pixels, decoded, 3) > 22.0);
+	}
+
+	template<> template<>
+	void imagedxt_object_t::test<4>()
+	{
+		// Opaque images become DXR1 with a full mip chain that decodes back at every level
+		LLPointer<LLImageRaw> raw = make_test_image(64, 32, 4, false);
+		LLPointer<LLImageDXT> dxt = new LLImageDXT();
+		ensure("LLImageDXT: encodeCompressed failed", dxt->encodeCompressed(raw, false));
+		ensure_equals("LLImageDXT: opaque image format", (S32)dxt->getFileFormat(), (S32)LLImageDXT::FORMAT_DXR1);
+		ensure_equals("LLImageDXT: opaque image components", (S32)dxt->getComponents(), 3);
+
+		S32 expected = sizeof(LLImageDXT::dxtfile_header_t);
+		for (S32 w = 64, h = 32; w > 0 && h > 0; w >>= 1, h >>= 1)
+		{
+			expected += LLImageDXT::formatBytes(LLImageDXT::FORMAT_DXR1, w, h);
+		}
+		ensure_equals("LLImageDXT: DXR1 data size", dxt->getDataSize(), expected);
+		// 4 bits per pixel instead of 32, mips and header included
+		ensure("LLImageDXT: DXR1 not smaller", dxt->getDataSize() * 4 < 64 * 32 * 4);
+
+		LLPointer<LLImageRaw> decoded = new LLImageRaw(1, 1, 3);
+		ensure("LLImageDXT: decode failed", dxt->decode(decoded, 0.f));
+		ensure_equals("LLImageDXT: decoded width", (S32)decoded->getWidth(), 64);
+		ensure_equals("LLImageDXT: decoded height", (S32)decoded->getHeight(), 32);
+		ensure("LLImageDXT: DXR1 quality", psnr(raw, decoded) > 30.0);
+
+		dxt->setDiscardLevel(4);
+		ensure("LLImageDXT: mip decode failed", dxt->decode(decoded, 0.f));
+		ensure_equals("LLImageDXT: mip width", (S32)decoded->getWidth(), 4);
+		ensure_equals("LLImageDXT: mip height", (S32)decoded->getHeight(), 2);
+	}
+
+	template<> template<>
+	void imagedxt_object_t::test<5>()
+	{
+		// Images with any translucency become DXR5; other sizes and layouts are refused
+		LLPointer<LLImageRaw> raw = make_test_image(32, 32, 4, true);
+		LLPointer<LLImageDXT> dxt = new LLImageDXT();
+		ensure("LLImageDXT: encodeCompressed failed", dxt->encodeCompressed(raw, true));
+		ensure_equals("LLImageDXT: alpha image format", (S32)dxt->getFileFormat(), (S32)LLImageDXT::FORMAT_DXR5);
+		ensure_equals("LLImageDXT: alpha image components", (S32)dxt->getComponents(), 4);
+
+		LLPointer<LLImageRaw> decoded = new LLImageRaw(1, 1, 4);
+		ensure("LLImageDXT: decode failed", dxt->decode(decoded, 0.f));
+		ensure("LLImageDXT: DXR5 quality", psnr(raw, decoded) > 30.0);
+
+		LLPointer<LLImageRaw> npot = make_test_image(48, 32, 3, false);
+		ensure("LLImageDXT: accepted a non power of two image", !dxt->encodeCompressed(npot, false));
+		LLPointer<LLImageRaw> luminance = new LLImageRaw(32, 32, 1);
+		ensure("LLImageDXT: accepted a one channel image", !dxt->encodeCompressed(luminance, false));
+	}
+
+	template<> template<>
+	void imagedxt_object_t::test<6>()
+	{
+		// Quality / speed benchmark of the two fitting modes on a 512x512 RGB texture
+		const S32 SIZE = 512;
+		LLPointer<LLImageRaw> raw = make_test_image(SIZE, SIZE, 3, false);
+		F64 quality[2];
+		for (S32 hq = 0; hq < 2; hq++)
+		{
+			LLPointer<LLImageDXT> dxt = new LLImageDXT();
+			LLTimer timer;
+			ensure("LLImageDXT: benchmark encode failed", dxt->encodeCompressed(raw, hq != 0));
+			F64 seconds = llmax(timer.getElapsedTimeF64(), 1e-6);
+			LLPointer<LLImageRaw> decoded = new LLImageRaw(1, 1, 3);
+			dxt->decode(decoded, 0.f);
+			quality[hq] = psnr(raw, decoded);
+			llinfos << "LLImageDXT " << (hq ? "high quality" : "fast") << " DXT1: "
+					<< quality[hq] << " dB PSNR, "
+					<< (F64)SIZE * SIZE / seconds / 1000000.0 << " Mpixels/s (mips included)" << llendl;
+		}
+		ensure("LLImageDXT: fast mode quality", quality[0] > 30.0);
+		ensure("LLImageDXT: high quality mode worse than fast", quality[1] >= quality[0] - 0.1);
+	}
+}
@@ -0,0 +1,311 @@
+/** 
+ * @file llimagescale_test.cpp
+ * @brief Tests for the LLImageScale box filter kernels
+ *
+ * $LicenseInfo:firstyear=2010&license=viewergpl$
+ * 
+ * Copyright (c) 2010, Linden Research, Inc.
+ * 
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ * 
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ * 
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ * 
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+
+// Precompiled header: almost always required for newview cpp files
+#include "../llcommon/linden_common.h"
+// Class to test
+#include "../llimagescale.h"
+#include "llmath.h"
+// For timer class
+#include "../llcommon/lltimer.h"
+// Tut header
+#include "../test/lltut.h"
+#include "../test/lltestrand.h"
+
+namespace
+{
+	// The per-column copyLineScaled() loop LLImageRaw used before
+	// LLImageScale, kept as the reference the kernels are checked against.
+	void reference_line(const U8* in, U8* out, S32 components, S32 in_pixel_len, S32 out_pixel_len, S32 in_pixel_step, S32 out_pixel_step)
+	{
+		const F32 ratio = F32(in_pixel_len) / out_pixel_len;
+		const F32 norm_factor = 1.f / ratio;
+		for (S32 x = 0; x < out_pixel_len; x++)
+		{
+			const F32 sample0 = x * ratio;
+			const F32 sample1 = (x+1) * ratio;
+			const S32 index0 = llfloor(sample0);
+			const S32 index1 = llfloor(sample1);
+			const F32 fract0 = 1.f - (sample0 - F32(index0));
+			const F32 fract1 = sample1 - F32(index1);
+			U8* outp = out + x * out_pixel_step * components;
+			for (S32 c = 0; c < components; c++)
+			{
+				if (index0 == index1)
+				{
+					outp[c] = in[index0 * in_pixel_step * components + c];
+					continue;
+				}
+				F32 v = in[index0 * in_pixel_step * components + c] * fract0;
+				for (S32 u = index0 + 1; u < index1; u++)
+				{
+					v += in[u * in_pixel_step * components + c];
+				}
+				if (fract1 && index1 < in_pixel_len)
+				{
+					v += in[index1 * in_pixel_step * components + c] * fract1;
+				}
+				outp[c] = U8(llround(v * norm_factor));
+			}
+		}
+	}
+
+	void reference_scale(const U8* in, S32 in_width, S32 in_height, U8* out, S32 out_width, S32 out_height, S32 components)
+	{
+		std::vector<U8> temp(in_width * out_height * components);
+		for (S32 col = 0; col < in_width; col++)
+		{
+			reference_line(in + components * col, &temp[0] + components * col, components, in_height, out_height, in_width, in_width);
+		}
+		for (S32 row = 0; row < out_height; row++)
+		{
+			reference_line(&temp[0] + components * in_width * row, out + components * out_width * row, components, in_width, out_width, 1, 1);
+		}
+	}
+
+	// Smooth gradients with some noise on top, so every rounding path is hit
+	void make_image(std::vector<U8>& image, S32 width, S32 height, S32 components)
+	{
+		image.resize(width * height * components);
+		LLTestRand noise(12345);
+		for (S32 y = 0; y < height; y++)
+		{
+			for (S32 x = 0; x < width; x++)
+			{
+				for (S32 c = 0; c < components; c++)
+				{
+					S32 v = (x * 255 / width + y * 128 / height + c * 64 + (S32)noise.next(32)) & 255;
+					image[(y * width + x) * components + c] = (U8)v;
+				}
+			}
+		}
+	}
+
+	S32 max_difference(const std::vector<U8>& a, const std::vector<U8>& b)
+	{
+		S32 diff = 0;
+		for (size_t i = 0; i < a.size(); i++)
+		{
+			diff = llmax(diff, llabs((S32)a[i] - (S32)b[i]));
+		}
+		return diff;
+	}
+
+	// in size, out size
+	const S32 SIZES[][4] =
+	{
+		{ 64, 64, 32, 32 },
+		{ 256, 128, 64, 32 },
+		{ 100, 75, 64, 64 },		// biased down to a power of two
+		{ 37, 19, 16, 8 },
+		{ 512, 512, 7, 3 },
+		{ 16, 16, 64, 64 },			// upscale
+		{ 30, 20, 64, 32 },
+		{ 50, 10, 17, 40 },			// down in x, up in y
+		{ 33, 33, 33, 16 },			// vertical only
+		{ 33, 33, 16, 33 },			// horizontal only
+	};
+	const S32 NUM_SIZES = sizeof(SIZES) / sizeof(SIZES[0]);
+}
+
+namespace tut
+{
+	struct imagescale_test
+	{
+		imagescale_test()
+		{
+			mHadSSE2 = LLImageScale::getUseSSE2();
+		}
+		~imagescale_test()
+		{
+			LLImageScale::setUseSSE2(mHadSSE2);
+		}
+
+		// Checks the current kernels against the reference loop for every
+		// test size, returning the worst error.
+		S32 compareToReference(S32 components)
+		{
+			S32 worst = 0;
+			for (S32 i = 0; i < NUM_SIZES; i++)
+			{
+				const S32* s = SIZES[i];
+				std::vector<U8> in;
+				make_image(in, s[0], s[1], components);
+				std::vector<U8> expected(s[2] * s[3] * components);
+				std::vector<U8> result(s[2] * s[3] * components);
+				reference_scale(&in[0], s[0], s[1], &expected[0], s[2], s[3], components);
+				LLImageScale::scale(&in[0], s[0], s[1], &result[0], s[2], s[3], components);
+				worst = llmax(worst, max_difference(expected, result));
+			}
+			return worst;
+		}
+
+		bool mHadSSE2;
+	};
+
+	typedef test_group<imagescale_test> imagescale_t;
+	typedef imagescale_t::object imagescale_object_t;
+	tut::imagescale_t tut_imagescale("imagescale");
+
+	template<> template<>
+	void imagescale_object_t::test<1>()
+	{
+		// Filter taps
+		LLImageScaleFilter half(4, 2);
+		ensure_equals("LLImageScaleFilter: halving length", half.getOutLength(), 2);
+		ensure("LLImageScaleFilter: halving is not an identity", !half.isIdentity());
+		ensure_equals("LLImageScaleFilter: halving second pixel", half.mFirst[1], 2);
+		ensure_equals("LLImageScaleFilter: halving taps", half.mStart[1] - half.mStart[0], 2);
+		ensure_equals("LLImageScaleFilter: halving weight", half.mWeights[0], 0.5f);
+		ensure_equals("LLImageScaleFilter: halving weight", half.mWeights[1], 0.5f);
+
+		LLImageScaleFilter same(7, 7);
+		ensure("LLImageScaleFilter: identity", same.isIdentity());
+		for (S32 x = 0; x < 7; x++)
+		{
+			ensure_equals("LLImageScaleFilter: identity first", same.mFirst[x], x);
+			ensure_equals("LLImageScaleFilter: identity taps", same.mStart[x + 1] - same.mStart[x], 1);
+		}
+
+		// The first output pixel covers a whole input pixel and a third of the next
+		LLImageScaleFilter third(4, 3);
+		ensure_equals("LLImageScaleFilter: 4 to 3 taps", third.mStart[1] - third.mStart[0], 2);
+		ensure("LLImageScaleFilter: 4 to 3 whole pixel", llabs(third.mWeights[0] - 0.75f) < 0.0001f);
+		ensure("LLImageScaleFilter: 4 to 3 spill", llabs(third.mWeights[1] - 0.25f) < 0.0001f);
+
+		// Weights always add up to one
+		LLImageScaleFilter odd(1000, 7);
+		for (S32 x = 0; x < 7; x++)
+		{
+			F32 sum = 0.f;
+			for (S32 t = odd.mStart[x]; t < odd.mStart[x + 1]; t++)
+			{
+				sum += odd.mWeights[t];
+			}
+			ensure("LLImageScaleFilter: normalized", llabs(sum - 1.f) < 0.001f);
+		}
+	}
+
+	template<> template<>
+	void imagescale_object_t::test<2>()
+	{
+		// Scalar kernels match the old per-column loop
+		LLImageScale::setUseSSE2(false);
+		ensure("LLImageScale: scalar kernels in use", !LLImageScale::getUseSSE2());
+		ensure("LLImageScale: scalar 1 component", compareToReference(1) <= 1);
+		ensure("LLImageScale: scalar 3 components", compareToReference(3) <= 1);
+		ensure("LLImageScale: scalar 4 components", compareToReference(4) <= 1);
+	}
+
+	template<> template<>
+	void imagescale_object_t::test<3>()
+	{
+		// SSE2 kernels match the old per-column loop
+		if (!LLImageScale::supportsSSE2())
+		{
+			skip("SSE2 kernels not compiled in");
+		}
+		LLImageScale::setUseSSE2(true);
+		ensure("LLImageScale: SSE2 kernels in use", LLImageScale::getUseSSE2());
+		ensure("LLImageScale: SSE2 1 component", compareToReference(1) <= 1);
+		ensure("LLImageScale: SSE2 3 components", compareToReference(3) <= 1);
+		ensure("LLImageScale: SSE2 4 components", compareToReference(4) <= 1);
+	}
+
+	template<> template<>
+	void imagescale_object_t::test<4>()
+	{
+		// A flat image stays flat through downscales and upscales
+		const S32 in_width = 19;
+		const S32 in_height = 23;
+		for (S32 sse2 = 0; sse2 < 2; sse2++)
+		{
+			LLImageScale::setUseSSE2(sse2 != 0);
+			for (S32 components = 1; components <= 4; components++)
+			{
+				std::vector<U8> in(in_width * in_height * components, 200);
+				std::vector<U8> out(5 * 7 * components);
+				LLImageScale::scale(&in[0], in_width, in_height, &out[0], 5, 7, components);
+				for (size_t i = 0; i < out.size(); i++)
+				{
+					ensure_equals("LLImageScale: flat downscale", (S32)out[i], 200);
+				}
+				out.resize(40 * 50 * components);
+				LLImageScale::scale(&in[0], in_width, in_height, &out[0], 40, 50, components);
+				for (size_t i = 0; i < out.size(); i++)
+				{
+					ensure_equals("LLImageScale: flat upscale", (S32)out[i], 200);
+				}
+			}
+		}
+	}
+
+	template<> template<>
+	void imagescale_object_t::test<5>()
+	{
+		// Throughput of the reference loop and both kernel sets, the way
+		// textures get scaled: 1024x1024 RGBA down to a 512x512 mip and an
+		// odd size biased down to a power of two.
+		const S32 cases[][4] = { { 1024, 1024, 512, 512 }, { 1000, 700, 512, 512 } };
+		for (S32 i = 0; i < 2; i++)
+		{
+			const S32* s = cases[i];
+			std::vector<U8> in;
+			make_image(in, s[0], s[1], 4);
+			std::vector<U8> expected(s[2] * s[3] * 4);
+			std::vector<U8> result(s[2] * s[3] * 4);
+
+			LLTimer timer;
+			reference_scale(&in[0], s[0], s[1], &expected[0], s[2], s[3], 4);
+			F64 reference_time = llmax(timer.getElapsedTimeF64(), 1e-6);
+			llinfos << "LLImageScale " << s[0] << "x" << s[1] << " to " << s[2] << "x" << s[3]
+					<< " reference: " << (F64)s[0] * s[1] / reference_time / 1000000.0 << " Mpixels/s" << llendl;
+
+			for (S32 sse2 = 0; sse2 < 2; sse2++)
+			{
+				LLImageScale::setUseSSE2(sse2 != 0);
+				if (sse2 && !LLImageScale::getUseSSE2())
+				{
+					break;
+				}
+				timer.reset();
+				LLImageScale::scale(&in[0], s[0], s[1], &result[0], s[2], s[3], 4);
+				F64 seconds = llmax(timer.getElapsedTimeF64(), 1e-6);
+				llinfos << "LLImageScale " << s[0] << "x" << s[1] << " to " << s[2] << "x" << s[3]
+						<< (sse2 ? " SSE2: " : " scalar: ") << (F64)s[0] * s[1] / seconds / 1000000.0
+						<< " Mpixels/s (" << reference_time / seconds << "x)" << llendl;
+				ensure("LLImageScale: benchmark result", max_difference(expected, result) <= 1);
+			}
+		}
+	}
+}
@@ -65,6 +65,8 @@ void LLImageRaw::deleteData() { }
 U8* LLImageRaw::allocateData(S32 size) { return NULL; }
 U8* LLImageRaw::reallocateData(S32 size) { return NULL; }
 
+BOOL LLImageDXT::encodeCompressed(const LLImageRaw* raw_image, bool high_quality) { return TRUE; }
+
 // End Stubbing
 // -------------------------------------------------------------------------------------------
 
@@ -105,6 +107,38 @@ namespace tut
 			bool* done;
 	};
 
+	class compress_responder_test : public LLImageDecodeThread::CompressResponder
+	{
+		public:
+			compress_responder_test(bool* res)
+			{ 
+				done = res;
+				*done = false;
+			}
+			virtual void completed(bool success, LLImageDXT* compressed)
+			{
+				*done = true;
+			}
+		private:
+			bool* done;
+	};
+
+	class encode_responder_test : public LLImageEncodeThread::Responder
+	{
+		public:
+			encode_responder_test(bool* res)
+			{ 
+				done = res;
+				*done = false;
+			}
+			virtual void completed(bool success, LLImageFormatted* formatted, LLImageRaw* decoded)
+			{
+				*done = true;
+			}
+		private:
+			bool* done;
+	};
+
 	// Test wrapper declaration : decode thread
 	struct imagedecodethread_test
 	{
@@ -148,11 +182,24 @@ namespace tut
 		}
 	};
 
+	// Test wrapper declaration : encode thread pool
+	struct imageencodethread_test
+	{
+		~imageencodethread_test()
+		{
+			LLImageEncodeThread::cleanupClass();
+		}
+	};
+
 	// Tut templating thingamagic: test group, object and test instance
 	typedef test_group<imagedecodethread_test> imagedecodethread_t;
 	typedef imagedecodethread_t::object imagedecodethread_object_t;
 	tut::imagedecodethread_t tut_imagedecodethread("imagedecodethread");
 
+	typedef test_group<imageencodethread_test> imageencodethread_t;
+	typedef imageencodethread_t::object imageencodethread_object_t;
+	tut::imageencodethread_t tut_imageencodethread("imageencodethread");
+
 	typedef test_group<imagerequest_test> imagerequest_t;
 	typedef imagerequest_t::object imagerequest_object_t;
 	tut::imagerequest_t tut_imagerequest("imagerequest");
@@ -239,6 +286,75 @@ namespace tut
 		ensure("LLImageDecodeThread: threaded work unit not processed", done == true);
 	}
 
+	template<> template<>
+	void imagedecodethread_object_t::test<3>()
+	{
+		// Test compression requests on a *non threaded* instance of the class
+		mThread = new LLImageDecodeThread(false);
+		bool done = false;
+		LLImageDecodeThread::handle_t compressHandle = mThread->compressImage(NULL, NULL, LLQueuedThread::PRIORITY_NORMAL, false, new compress_responder_test(&done));
+		// Verifies we got a valid handle
+		ensure("LLImageDecodeThread: non threaded compressImage(), returned handle is null", compressHandle != 0);
+		// Verifies that the request is waiting for the next update()
+		ensure("LLImageDecodeThread: non threaded compressImage() insertion in threaded list failed", mThread->tut_size() == 1);
+		S32 res = mThread->update(0);
+		ensure("LLImageDecodeThread: non threaded compression update() list handling test failed", res == 0);
+		ensure("LLImageDecodeThread: non threaded compression update() list emptying test failed", mThread->tut_size() == 0);
+		// Nothing to compress: the responder is still called
+		ensure("LLImageDecodeThread: non threaded compression responder not called", done == true);
+	}
+
+	// ---------------------------------------------------------------------------------------
+	// Test the LLImageEncodeThread pool
+	// ---------------------------------------------------------------------------------------
+
+	template<> template<>
+	void imageencodethread_object_t::test<1>()
+	{
+		// Test a *non threaded* pool
+		LLImageEncodeThread::initClass(2, false);
+		ensure_equals("LLImageEncodeThread: non threaded pool size", LLImageEncodeThread::tut_size(), 2);
+		bool done = false;
+		ensure("LLImageEncodeThread: non threaded encodeImage() refused",
+			   LLImageEncodeThread::encodeImage(NULL, NULL, false, new encode_responder_test(&done)));
+		// Responders are only called from updateClass()
+		ensure("LLImageEncodeThread: responder called too early", done == false);
+		LLImageEncodeThread::updateClass(0);
+		// Nothing to encode: the responder is still called
+		ensure("LLImageEncodeThread: non threaded responder not called", done == true);
+		ensure_equals("LLImageEncodeThread: non threaded pool not idle", LLImageEncodeThread::updateClass(0), 0);
+		LLImageEncodeThread::cleanupClass();
+		ensure_equals("LLImageEncodeThread: pool not emptied", LLImageEncodeThread::tut_size(), 0);
+		ensure("LLImageEncodeThread: encodeImage() accepted after cleanupClass()",
+			   !LLImageEncodeThread::encodeImage(NULL, NULL, false, new encode_responder_test(&done)));
+	}
+
+	template<> template<>
+	void imageencodethread_object_t::test<2>()
+	{
+		// Test a *threaded* pool: every request completes, whichever thread ran it
+		LLImageEncodeThread::initClass(2, true);
+		const S32 REQUESTS = 4;
+		bool done[REQUESTS];
+		for (S32 i = 0; i < REQUESTS; i++)
+		{
+			ensure("LLImageEncodeThread: threaded encodeImage() refused",
+				   LLImageEncodeThread::encodeImage(NULL, NULL, false, new encode_responder_test(&done[i])));
+		}
+		const U32 INCREMENT_TIME = 100;				// 100 milliseconds
+		const U32 MAX_TIME = 100 * INCREMENT_TIME;	// wait 10 seconds but no more
+		U32 total_time = 0;
+		S32 completed = 0;
+		while (completed < REQUESTS && total_time < MAX_TIME)
+		{
+			ms_sleep(INCREMENT_TIME);
+			total_time += INCREMENT_TIME;
+			LLImageEncodeThread::updateClass(1);
+			completed = (S32)std::count(done, done + REQUESTS, true);
+		}
+		ensure_equals("LLImageEncodeThread: threaded work units not processed", completed, REQUESTS);
+	}
+
 	// ---------------------------------------------------------------------------------------
 	// Test the LLImageDecodeThread::ImageRequest interface
 	// ---------------------------------------------------------------------------------------
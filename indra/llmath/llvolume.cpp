@@ -2068,7 +2068,7 @@ LLProfile::~LLProfile()
 }
 
 
-S32 LLVolume::sNumMeshPoints = 0;
+LLAtomicS32 LLVolume::sNumMeshPoints;
 
 LLVolume::LLVolume(const LLVolumeParams &params, const F32 detail, const BOOL generate_single_face, const BOOL is_unique)
 	: mParams(params)
@@ -3345,6 +3345,17 @@ void LLVolume::sculpt(U16 sculpt_width, U16 sculpt_height, S8 sculpt_components,
 	createVolumeFaces();
 }
 
+void LLVolume::swapGeometry(LLVolume* volumep)
+{
+	llassert(mParams == volumep->mParams && mDetail == volumep->mDetail);
+	std::swap(mPathp, volumep->mPathp);
+	std::swap(mProfilep, volumep->mProfilep);
+	mMesh.swap(volumep->mMesh);
+	mVolumeFaces.swap(volumep->mVolumeFaces);
+	std::swap(mFaceMask, volumep->mFaceMask);
+	std::swap(mSculptLevel, volumep->mSculptLevel);
+}
+
 
 
 
@@ -61,6 +61,7 @@ class LLVolumeTriangle;
 #include "v4coloru.h"
 #include "llmemory.h"
 #include "llfile.h"
+#include "llapr.h"
 
 //============================================================================
 
@@ -1057,7 +1058,7 @@ public:
 	LLFaceID generateFaceMask();
 
 	BOOL isFaceMaskValid(LLFaceID face_mask);
-	static S32 sNumMeshPoints;
+	static LLAtomicS32 sNumMeshPoints;	// Volumes may be generated on other threads
 
 	friend std::ostream& operator<<(std::ostream &s, const LLVolume &volume);
 	friend std::ostream& operator<<(std::ostream &s, const LLVolume *volumep);		// HACK to bypass Windoze confusion over 
@@ -1068,6 +1069,9 @@ public:
 	LLVector3			mLODScaleBias;		// vector for biasing LOD based on scale
 	
 	void sculpt(U16 sculpt_width, U16 sculpt_height, S8 sculpt_components, const U8* sculpt_data, S32 sculpt_level);
+	// Trades geometry with a volume of the same parameters and detail, one sculpted
+	// on another thread say.
+	void swapGeometry(LLVolume* volumep);
 	void copyVolumeFaces(const LLVolume* volume);
 	void cacheOptimize();
 
@@ -179,6 +179,18 @@ void LLVolumeMgr::unrefVolume(LLVolume *volumep)
 
 }
 
+BOOL LLVolumeMgr::isVolumeBuilt(const LLVolumeParams &volume_params, const S32 detail) const
+{
+	LLVolumeLODGroup* volgroupp = getGroup(volume_params);
+	return volgroupp && volgroupp->isLODBuilt(detail);
+}
+
+BOOL LLVolumeMgr::addBuiltVolume(LLVolume *volumep, const S32 detail)
+{
+	LLVolumeLODGroup* volgroupp = getGroup(volumep->getParams());
+	return volgroupp && volgroupp->setBuiltLOD(detail, volumep);
+}
+
 // protected
 void LLVolumeMgr::insertGroup(LLVolumeLODGroup* volgroup)
 {
@@ -310,6 +322,17 @@ LLVolume* LLVolumeLODGroup::refLOD(const S32 detail)
 	return mVolumeLODs[detail];
 }
 
+BOOL LLVolumeLODGroup::setBuiltLOD(const S32 detail, LLVolume* volumep)
+{
+	llassert(detail >=0 && detail < NUM_LODS);
+	if (mVolumeLODs[detail].notNull())
+	{
+		return FALSE;
+	}
+	mVolumeLODs[detail] = volumep;
+	return TRUE;
+}
+
 BOOL LLVolumeLODGroup::derefLOD(LLVolume *volumep)
 {
 	llassert_always(mRefs > 0);
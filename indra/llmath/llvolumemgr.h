@@ -63,6 +63,10 @@ public:
 
 	LLVolume* refLOD(const S32 detail);
 	BOOL derefLOD(LLVolume *volumep);
+	// Whether refLOD() would hand out an existing volume rather than generate one
+	BOOL isLODBuilt(const S32 detail) const { return mVolumeLODs[detail].notNull(); }
+	// Takes a volume generated elsewhere for that detail, unless one has been meanwhile
+	BOOL setBuiltLOD(const S32 detail, LLVolume* volumep);
 	S32 getNumRefs() const { return mRefs; }
 	
 	const LLVolumeParams* getVolumeParams() const { return &mVolumeParams; };
@@ -96,6 +100,11 @@ public:
 	virtual LLVolume *refVolume(const LLVolumeParams &volume_params, const S32 detail);
 	virtual void unrefVolume(LLVolume *volumep);
 
+	// For generating volumes on other threads: whether a LOD is there already, and
+	// handing one in when done.  Only kept if some object still uses volume_params.
+	BOOL isVolumeBuilt(const LLVolumeParams &volume_params, const S32 detail) const;
+	BOOL addBuiltVolume(LLVolume *volumep, const S32 detail);
+
 	void dump();
 
 	// manually call this for mutex magic
@@ -91,6 +91,8 @@ LLCircuitData::LLCircuitData(const LLHost &host, TPACKETID in_id,
 	mLastPingID(0),
 	mPingDelay(INITIAL_PING_VALUE_MSEC), 
 	mPingDelayAveraged((F32)INITIAL_PING_VALUE_MSEC), 
+	mPotentialLostPackets(LL_MAX_IN_PACKET_WINDOW),
+	mRecentlyReceivedReliablePackets(LL_MAX_IN_PACKET_WINDOW),
 	mUnackedPacketCount(0),
 	mUnackedPacketBytes(0),
 	mLastPacketInTime(0.0),
@@ -138,33 +140,9 @@ LLCircuitData::~LLCircuitData()
 
 	// remove all pending reliable messages on this circuit
 	std::vector<TPACKETID> doomed;
-	reliable_iter iter;
-	reliable_iter end = mUnackedPackets.end();
-	for(iter = mUnackedPackets.begin(); iter != end; ++iter)
-	{
-		packetp = iter->second;
-		gMessageSystem->mFailedResendPackets++;
-		if(gMessageSystem->mVerboseLog)
-		{
-			doomed.push_back(packetp->mPacketID);
-		}
-		if (packetp->mCallback)
-		{
-			packetp->mCallback(packetp->mCallbackData,LL_ERR_CIRCUIT_GONE);
-		}
-
-		// Update stats
-		mUnackedPacketCount--;
-		mUnackedPacketBytes -= packetp->mBufferLength;
-
-		delete packetp;
-	}
-
-	// remove all pending final retry reliable messages on this circuit
-	end = mFinalRetryPackets.end();
-	for(iter = mFinalRetryPackets.begin(); iter != end; ++iter)
+	for(reliable_iter iter = mReliablePackets.begin(); iter != mReliablePackets.end(); ++iter)
 	{
-		packetp = iter->second;
+		packetp = *iter;
 		gMessageSystem->mFailedResendPackets++;
 		if(gMessageSystem->mVerboseLog)
 		{
@@ -179,8 +157,9 @@ LLCircuitData::~LLCircuitData()
 		mUnackedPacketCount--;
 		mUnackedPacketBytes -= packetp->mBufferLength;
 
-		delete packetp;
+		LLReliablePacket::destroy(packetp);
 	}
+	mReliablePackets.clear();
 
 	// log aborted reliable packets for this circuit.
 	if(gMessageSystem->mVerboseLog && !doomed.empty())
@@ -196,80 +175,41 @@ LLCircuitData::~LLCircuitData()
 
 void LLCircuitData::ackReliablePacket(TPACKETID packet_num)
 {
-	reliable_iter iter;
-	LLReliablePacket *packetp;
-
-	iter = mUnackedPackets.find(packet_num);
-	if (iter != mUnackedPackets.end())
+	LLReliablePacket **packetpp = mReliablePackets.find(packet_num);
+	if (!packetpp)
 	{
-		packetp = iter->second;
-
-		if(gMessageSystem->mVerboseLog)
-		{
-			std::ostringstream str;
-			str << "MSG: <- " << packetp->mHost << "\tRELIABLE ACKED:\t"
-				<< packetp->mPacketID;
-			llinfos << str.str() << llendl;
-		}
-		if (packetp->mCallback)
-		{
-			if (packetp->mTimeout < 0.f)   // negative timeout will always return timeout even for successful ack, for debugging
-			{
-				packetp->mCallback(packetp->mCallbackData,LL_ERR_TCP_TIMEOUT);					
-			}
-			else
-			{
-				packetp->mCallback(packetp->mCallbackData,LL_ERR_NOERR);
-			}
-		}
-
-		// Update stats
-		mUnackedPacketCount--;
-		mUnackedPacketBytes -= packetp->mBufferLength;
-
-		// Cleanup
-		delete packetp;
-		mUnackedPackets.erase(iter);
+		// Couldn't find this packet on the unacked list.
+		// maybe it's a duplicate ack?
 		return;
 	}
 
-	iter = mFinalRetryPackets.find(packet_num);
-	if (iter != mFinalRetryPackets.end())
+	LLReliablePacket *packetp = *packetpp;
+	if(gMessageSystem->mVerboseLog)
 	{
-		packetp = iter->second;
-		// llinfos << "Packet " << packet_num << " removed from the pending list" << llendl;
-		if(gMessageSystem->mVerboseLog)
+		std::ostringstream str;
+		str << "MSG: <- " << packetp->mHost << "\tRELIABLE ACKED:\t"
+			<< packetp->mPacketID;
+		llinfos << str.str() << llendl;
+	}
+	if (packetp->mCallback)
+	{
+		if (packetp->mTimeout < 0.f)   // negative timeout will always return timeout even for successful ack, for debugging
 		{
-			std::ostringstream str;
-			str << "MSG: <- " << packetp->mHost << "\tRELIABLE ACKED:\t"
-				<< packetp->mPacketID;
-			llinfos << str.str() << llendl;
+			packetp->mCallback(packetp->mCallbackData,LL_ERR_TCP_TIMEOUT);					
 		}
-		if (packetp->mCallback)
+		else
 		{
-			if (packetp->mTimeout < 0.f)   // negative timeout will always return timeout even for successful ack, for debugging
-			{
-				packetp->mCallback(packetp->mCallbackData,LL_ERR_TCP_TIMEOUT);					
-			}
-			else
-			{
-				packetp->mCallback(packetp->mCallbackData,LL_ERR_NOERR);
-			}
+			packetp->mCallback(packetp->mCallbackData,LL_ERR_NOERR);
 		}
+	}
 
-		// Update stats
-		mUnackedPacketCount--;
-		mUnackedPacketBytes -= packetp->mBufferLength;
+	// Update stats
+	mUnackedPacketCount--;
+	mUnackedPacketBytes -= packetp->mBufferLength;
 
-		// Cleanup
-		delete packetp;
-		mFinalRetryPackets.erase(iter);
-	}
-	else
-	{
-		// Couldn't find this packet on either of the unacked lists.
-		// maybe it's a duplicate ack?
-	}
+	// Cleanup
+	mReliablePackets.erase(packet_num);
+	LLReliablePacket::destroy(packetp);
 }
 
 
@@ -281,17 +221,20 @@ S32 LLCircuitData::resendUnackedPackets(const F64 now)
 
 
 	//
-	// Theoretically we should search through the list for the packet with the oldest
-	// packet ID, as otherwise when we WRAP we will resend reliable packets out of order.
-	// Since resends are ALREADY out of order, and wrapping is highly rare (16+million packets),
-	// I'm not going to worry about this for now - djs
+	// The unacked packets are kept in packet ID order, taking wrapping
+	// into account, so resends go out oldest first.
 	//
 
 	reliable_iter iter;
 	BOOL have_resend_overflow = FALSE;
-	for (iter = mUnackedPackets.begin(); iter != mUnackedPackets.end();)
+	for (iter = mReliablePackets.begin(); iter != mReliablePackets.end(); ++iter)
 	{
-		packetp = iter->second;
+		packetp = *iter;
+		if (!packetp->mRetries)
+		{
+			// Out of retries, only waiting for the final timeout below.
+			continue;
+		}
 
 		// Only check overflow if we haven't had one yet.
 		if (!have_resend_overflow)
@@ -310,14 +253,8 @@ S32 LLCircuitData::resendUnackedPackets(const F64 now)
 				if (now > packetp->mExpirationTime)
 				{
 					// This circuit has overflowed.  Do not retry.  Do not pass go.
+					// This makes it a final retry packet.
 					packetp->mRetries = 0;
-					// Remove it from this list and add it to the final list.
-					mUnackedPackets.erase(iter++);
-					mFinalRetryPackets[packetp->mPacketID] = packetp;
-				}
-				else
-				{
-					++iter;
 				}
 				// Move on to the next unacked packet.
 				continue;
@@ -369,31 +306,17 @@ S32 LLCircuitData::resendUnackedPackets(const F64 now)
 				packetp->mExpirationTime = now + packetp->mTimeout;
 			}
 
-			if (!packetp->mRetries)
-			{
-				// Last resend, remove it from this list and add it to the final list.
-				mUnackedPackets.erase(iter++);
-				mFinalRetryPackets[packetp->mPacketID] = packetp;
-			}
-			else
-			{
-				// Don't remove it yet, it still gets to try to resend at least once.
-				++iter;
-			}
+			// If that was the last resend, mRetries is now zero and the
+			// packet only waits for the final timeout.
 			resent_packets++;
 		}
-		else
-		{
-			// Don't need to do anything with this packet, keep iterating.
-			++iter;
-		}
 	}
 
 
-	for (iter = mFinalRetryPackets.begin(); iter != mFinalRetryPackets.end();)
+	for (iter = mReliablePackets.begin(); iter != mReliablePackets.end();)
 	{
-		packetp = iter->second;
-		if (now > packetp->mExpirationTime)
+		packetp = *iter;
+		if (!packetp->mRetries && (now > packetp->mExpirationTime))
 		{
 			// fail (too many retries)
 			//llinfos << "Packet " << packetp->mPacketID << " removed from the pending list: exceeded retry limit" << llendl;
@@ -420,8 +343,8 @@ S32 LLCircuitData::resendUnackedPackets(const F64 now)
 			mUnackedPacketCount--;
 			mUnackedPacketBytes -= packetp->mBufferLength;
 
-			mFinalRetryPackets.erase(iter++);
-			delete packetp;
+			iter = mReliablePackets.erase(iter);
+			LLReliablePacket::destroy(packetp);
 		}
 		else
 		{
@@ -446,6 +369,9 @@ LLCircuit::~LLCircuit()
 				  llcompose1(
 					  DeletePointerFunctor<LLCircuitData>(),
 					  llselect2nd<circuit_data_map::value_type>()));
+
+	// The circuits handed their reliable packets back to the pool.
+	LLReliablePacket::cleanupClass();
 }
 
 LLCircuitData *LLCircuit::addCircuitData(const LLHost &host, TPACKETID in_id)
@@ -454,6 +380,7 @@ LLCircuitData *LLCircuit::addCircuitData(const LLHost &host, TPACKETID in_id)
 	llinfos << "LLCircuit::addCircuitData for " << host << llendl;
 	LLCircuitData *tempp = new LLCircuitData(host, in_id, mHeartbeatInterval, mHeartbeatTimeout);
 	mCircuitData.insert(circuit_data_map::value_type(host, tempp));
+	mCircuitHash[host] = tempp;
 	mPingSet.insert(tempp);
 
 	mLastCircuit = tempp;
@@ -469,6 +396,7 @@ void LLCircuit::removeCircuitData(const LLHost &host)
 	{
 		LLCircuitData *cdp = it->second;
 		mCircuitData.erase(it);
+		mCircuitHash.erase(host);
 
 		LLCircuit::ping_set_t::iterator psit = mPingSet.find(cdp);
 		if (psit != mPingSet.end())
@@ -482,7 +410,7 @@ void LLCircuit::removeCircuitData(const LLHost &host)
 
 		// Clean up from optimization maps
 		mUnackedCircuitMap.erase(host);
-		mSendAckMap.erase(host);
+		vector_replace_with_last(mSendAckList, cdp);
 		delete cdp;
 	}
 
@@ -572,19 +500,25 @@ void LLCircuitData::addReliablePacket(S32 mSocket, U8 *buf_ptr, S32 buf_len, LLR
 {
 	LLReliablePacket *packet_info;
 
-	packet_info = new LLReliablePacket(mSocket, buf_ptr, buf_len, params);
+	packet_info = LLReliablePacket::create(mSocket, buf_ptr, buf_len, params);
 
-	mUnackedPacketCount++;
-	mUnackedPacketBytes += packet_info->mBufferLength;
-
-	if (params && params->mRetries)
-	{
-		mUnackedPackets[packet_info->mPacketID] = packet_info;
-	}
-	else
+	// Packets without retries are only waiting for their final timeout.
+	if (!mReliablePackets.set(packet_info->mPacketID, packet_info))
 	{
-		mFinalRetryPackets[packet_info->mPacketID] = packet_info;
+		// Only happens if the packet IDs were reset while very old
+		// packets are still unacked.
+		llwarns << mHost << " dropping reliable packet " << packet_info->mPacketID
+				<< ", too far from the oldest unacked packet " << mReliablePackets.getFrontID() << llendl;
+		if (packet_info->mCallback)
+		{
+			packet_info->mCallback(packet_info->mCallbackData,LL_ERR_TCP_TIMEOUT);
+		}
+		LLReliablePacket::destroy(packet_info);
+		return;
 	}
+
+	mUnackedPacketCount++;
+	mUnackedPacketBytes += packet_info->mBufferLength;
 }
 
 
@@ -595,8 +529,8 @@ void LLCircuit::resendUnackedPackets(S32& unacked_list_length, S32& unacked_list
 	unacked_list_size = 0;
 
 	LLCircuitData* circ;
-	circuit_data_map::iterator end = mUnackedCircuitMap.end();
-	for(circuit_data_map::iterator it = mUnackedCircuitMap.begin(); it != end; ++it)
+	circuit_hash_map::iterator end = mUnackedCircuitMap.end();
+	for(circuit_hash_map::iterator it = mUnackedCircuitMap.begin(); it != end; ++it)
 	{
 		circ = (*it).second;
 		unacked_list_length += circ->resendUnackedPackets(now);
@@ -607,7 +541,7 @@ void LLCircuit::resendUnackedPackets(S32& unacked_list_length, S32& unacked_list
 
 BOOL LLCircuitData::isDuplicateResend(TPACKETID packetnum)
 {
-	return (mRecentlyReceivedReliablePackets.find(packetnum) != mRecentlyReceivedReliablePackets.end());
+	return mRecentlyReceivedReliablePackets.contains(packetnum);
 }
 
 
@@ -628,8 +562,8 @@ LLCircuitData* LLCircuit::findCircuit(const LLHost& host) const
 		return mLastCircuit;
 	}
 
-	circuit_data_map::const_iterator it = mCircuitData.find(host);
-	if(it == mCircuitData.end())
+	circuit_hash_map::const_iterator it = mCircuitHash.find(host);
+	if(it == mCircuitHash.end())
 	{
 		return NULL;
 	}
@@ -720,7 +654,7 @@ void LLCircuitData::checkPacketInID(TPACKETID id, BOOL receive_resent)
 		const U8 width = 24;
 		gap = LLModularMath::subtract<width>(mPacketsInID, id);
 
-		if (mPotentialLostPackets.find(id) != mPotentialLostPackets.end())
+		if (mPotentialLostPackets.contains(id))
 		{
 			if(gMessageSystem->mVerboseLog)
 			{
@@ -749,7 +683,7 @@ void LLCircuitData::checkPacketInID(TPACKETID id, BOOL receive_resent)
 					}
 
 //						llinfos << "adding potential lost: " << index << llendl;
-					mPotentialLostPackets[index] = time;
+					mPotentialLostPackets.set(index, time);
 					index++;
 					index = index % LL_MAX_OUT_PACKET_ID;
 					gap_count++;
@@ -870,92 +804,21 @@ BOOL LLCircuitData::updateWatchDogTimers(LLMessageSystem *msgsys)
 	// for the packet that it was out of order with was received BEFORE
 	// the ping was sent.
 
-	// Find the current oldest reliable packetID
-	// This is to handle the case if we actually manage to wrap our
-	// packet IDs - the oldest will actually have a higher packet ID
-	// than the current.
-	BOOL wrapped = FALSE;
-	reliable_iter iter;
-	iter = mUnackedPackets.upper_bound(getPacketOutID());
-	if (iter == mUnackedPackets.end())
-	{
-		// Nothing AFTER this one, so we want the lowest packet ID
-		// then.
-		iter = mUnackedPackets.begin();
-		wrapped = TRUE;
-	}
-
-	TPACKETID packet_id = 0;
-
-	// Check against the "final" packets
-	BOOL wrapped_final = FALSE;
-	reliable_iter iter_final;
-	iter_final = mFinalRetryPackets.upper_bound(getPacketOutID());
-	if (iter_final == mFinalRetryPackets.end())
+	// Find the current oldest reliable packetID.  The unacked packets
+	// are kept in packet ID order, taking wrapping into account, so it
+	// is the front one.
+	TPACKETID packet_id;
+	if (mReliablePackets.empty())
 	{
-		iter_final = mFinalRetryPackets.begin();
-		wrapped_final = TRUE;
-	}
-
-	//llinfos << mHost << " - unacked count " << mUnackedPackets.size() << llendl;
-	//llinfos << mHost << " - final count " << mFinalRetryPackets.size() << llendl;
-	if (wrapped != wrapped_final)
-	{
-		// One of the "unacked" or "final" lists hasn't wrapped.  Whichever one
-		// hasn't has the oldest packet.
-		if (!wrapped)
-		{
-			// Hasn't wrapped, so the one on the
-			// unacked packet list is older
-			packet_id = iter->first;
-			//llinfos << mHost << ": nowrapped unacked" << llendl;
-		}
-		else
-		{
-			packet_id = iter_final->first;
-			//llinfos << mHost << ": nowrapped final" << llendl;
-		}
+		// Wow!  No unacked packets at all!
+		// Send the ID of the last packet we sent out.
+		// This will flush all of the destination's
+		// unacked packets, theoretically.
+		packet_id = getPacketOutID();
 	}
 	else
 	{
-		// They both wrapped, we can just use the minimum of the two.
-		if ((iter == mUnackedPackets.end()) && (iter_final == mFinalRetryPackets.end()))
-		{
-			// Wow!  No unacked packets at all!
-			// Send the ID of the last packet we sent out.
-			// This will flush all of the destination's
-			// unacked packets, theoretically.
-			//llinfos << mHost << ": No unacked!" << llendl;
-			packet_id = getPacketOutID();
-		}
-		else
-		{
-			BOOL had_unacked = FALSE;
-			if (iter != mUnackedPackets.end())
-			{
-				// Unacked list has the lowest so far
-				packet_id = iter->first;
-				had_unacked = TRUE;
-				//llinfos << mHost << ": Unacked" << llendl;
-			}
-
-			if (iter_final != mFinalRetryPackets.end())
-			{
-				// Use the lowest of the unacked list and the final list
-				if (had_unacked)
-				{
-					// Both had a packet, use the lowest.
-					packet_id = llmin(packet_id, iter_final->first);
-					//llinfos << mHost << ": Min of unacked/final" << llendl;
-				}
-				else
-				{
-					// Only the final had a packet, use it.
-					packet_id = iter_final->first;
-					//llinfos << mHost << ": Final!" << llendl;
-				}
-			}
-		}
+		packet_id = mReliablePackets.getFrontID();
 	}
 
 	// Send off the another ping.
@@ -976,7 +839,7 @@ BOOL LLCircuitData::updateWatchDogTimers(LLMessageSystem *msgsys)
 	U64 mt_usec = LLMessageSystem::getMessageTimeUsecs();
 	for (it = mPotentialLostPackets.begin(); it != mPotentialLostPackets.end(); )
 	{
-		U64 delta_t_usec = mt_usec - (*it).second;
+		U64 delta_t_usec = mt_usec - *it;
 		if (delta_t_usec > timeout)
 		{
 			// let's call this one a loss!
@@ -986,10 +849,10 @@ BOOL LLCircuitData::updateWatchDogTimers(LLMessageSystem *msgsys)
 			{
 				std::ostringstream str;
 				str << "MSG: <- " << mHost << "\tLOST PACKET:\t"
-					<< (*it).first;
+					<< it.getID();
 				llinfos << str.str() << llendl;
 			}
-			mPotentialLostPackets.erase(it++);
+			it = mPotentialLostPackets.erase(it);
 		}
 		else
 		{
@@ -1006,45 +869,36 @@ void LLCircuitData::clearDuplicateList(TPACKETID oldest_id)
 	// purge old data from the duplicate suppression queue
 
 	// we want to KEEP all x where oldest_id <= x <= last incoming packet, and delete everything else.
+	// The window is in packet ID order, taking wrapping into account, so that is everything in front
+	// of oldest_id.
 
 	//llinfos << mHost << ": clearing before oldest " << oldest_id << llendl;
 	//llinfos << "Recent list before: " << mRecentlyReceivedReliablePackets.size() << llendl;
-	if (oldest_id < mHighestPacketID)
+	while (!mRecentlyReceivedReliablePackets.empty())
 	{
-		// Clean up everything with a packet ID less than oldest_id.
-		packet_time_map::iterator pit_start;
-		packet_time_map::iterator pit_end;
-		pit_start = mRecentlyReceivedReliablePackets.begin();
-		pit_end = mRecentlyReceivedReliablePackets.lower_bound(oldest_id);
-		mRecentlyReceivedReliablePackets.erase(pit_start, pit_end);
+		TPACKETID front_id = mRecentlyReceivedReliablePackets.getFrontID();
+		U32 behind = (oldest_id - front_id) & LL_PACKET_ID_MASK;
+		if (!behind || behind >= LL_PACKET_ID_HALF_RANGE)
+		{
+			break;
+		}
+		mRecentlyReceivedReliablePackets.popFront();
 	}
 
-	// Do timeout checks on everything with an ID > mHighestPacketID.
-	// This should be empty except for wrapping IDs.  Thus, this should be
-	// highly rare.
+	// Also time out anything that has been around for too long, in case the
+	// other end keeps reporting an old oldest_id.  This should be highly rare.
 	U64 mt_usec = LLMessageSystem::getMessageTimeUsecs();
-
-	packet_time_map::iterator pit;
-	for(pit = mRecentlyReceivedReliablePackets.upper_bound(mHighestPacketID);
-		pit != mRecentlyReceivedReliablePackets.end(); )
+	while (!mRecentlyReceivedReliablePackets.empty())
 	{
-		// Validate that the packet ID seems far enough away
-		if ((pit->first - mHighestPacketID) < 100)
-		{
-			llwarns << "Probably incorrectly timing out non-wrapped packets!" << llendl;
-		}
-		U64 delta_t_usec = mt_usec - (*pit).second;
+		U64 delta_t_usec = mt_usec - *mRecentlyReceivedReliablePackets.begin();
 		F64 delta_t_sec = delta_t_usec * SEC_PER_USEC;
-		if (delta_t_sec > LL_DUPLICATE_SUPPRESSION_TIMEOUT)
-		{
-			// enough time has elapsed we're not likely to get a duplicate on this one
-			llinfos << "Clearing " << pit->first << " from recent list" << llendl;
-			mRecentlyReceivedReliablePackets.erase(pit++);
-		}
-		else
+		if (delta_t_sec <= LL_DUPLICATE_SUPPRESSION_TIMEOUT)
 		{
-			++pit;
+			break;
 		}
+		// enough time has elapsed we're not likely to get a duplicate on this one
+		llinfos << "Clearing " << mRecentlyReceivedReliablePackets.getFrontID() << " from recent list" << llendl;
+		mRecentlyReceivedReliablePackets.popFront();
 	}
 	//llinfos << "Recent list after: " << mRecentlyReceivedReliablePackets.size() << llendl;
 }
@@ -1080,8 +934,13 @@ BOOL LLCircuitData::collectRAck(TPACKETID packet_num)
 {
 	if (mAcks.empty())
 	{
-		// First extra ack, we need to add ourselves to the list of circuits that need to send acks
-		gMessageSystem->mCircuitInfo.mSendAckMap[mHost] = this;
+		// First extra ack, we need to add ourselves to the list of circuits that need to send acks.
+		// We may already be on it if acks went out piggybacked on other messages.
+		std::vector<LLCircuitData*>& send_ack_list = gMessageSystem->mCircuitInfo.mSendAckList;
+		if (std::find(send_ack_list.begin(), send_ack_list.end(), this) == send_ack_list.end())
+		{
+			send_ack_list.push_back(this);
+		}
 	}
 
 	mAcks.push_back(packet_num);
@@ -1093,10 +952,10 @@ BOOL LLCircuitData::collectRAck(TPACKETID packet_num)
 void LLCircuit::sendAcks()
 {
 	LLCircuitData* cd;
-	circuit_data_map::iterator end = mSendAckMap.end();
-	for(circuit_data_map::iterator it = mSendAckMap.begin(); it != end; ++it)
+	std::vector<LLCircuitData*>::iterator end = mSendAckList.end();
+	for(std::vector<LLCircuitData*>::iterator it = mSendAckList.begin(); it != end; ++it)
 	{
-		cd = (*it).second;
+		cd = *it;
 
 		S32 count = (S32)cd->mAcks.size();
 		if(count > 0)
@@ -1137,8 +996,8 @@ void LLCircuit::sendAcks()
 		}
 	}
 
-	// All acks have been sent, clear the map
-	mSendAckMap.clear();
+	// All acks have been sent, clear the list
+	mSendAckList.clear();
 }
 
 
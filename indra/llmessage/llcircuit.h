@@ -36,6 +36,7 @@
 
 #include <map>
 #include <vector>
+#include <boost/unordered_map.hpp>
 
 #include "llerror.h"
 
@@ -44,6 +45,7 @@
 #include "net.h"
 #include "llhost.h"
 #include "llpacketack.h"
+#include "llpacketidwindow.h"
 #include "lluuid.h"
 #include "llthrottle.h"
 #include "llstat.h"
@@ -57,8 +59,6 @@ const F32 LL_AVERAGED_PING_MIN =  100;    // msec  // IW: increased to avoid ret
 
 const U32 INITIAL_PING_VALUE_MSEC = 1000; // initial value for the ping delay, or for ping delay for an unknown circuit
 
-const TPACKETID LL_MAX_OUT_PACKET_ID = 0x01000000;
-
 // 0 - flags
 // [1,4] - packetid
 // 5 - data offset (after message name)
@@ -67,6 +67,10 @@ const U8 LL_PACKET_ID_SIZE = 6;
 const S32 LL_MAX_RESENT_PACKETS_PER_FRAME = 100;
 const S32 LL_MAX_ACKED_PACKETS_PER_FRAME = 200;
 
+// How far back in packet ids we remember incoming packets, for duplicate
+// suppression and packet loss accounting.
+const U32 LL_MAX_IN_PACKET_WINDOW = 0x10000;
+
 //
 // Prototypes and Predefines
 //
@@ -240,17 +244,18 @@ protected:
 	U32		mPingDelay;             // raw ping delay
 	F32		mPingDelayAveraged;     // averaged ping delay (fast attack/slow decay)
 
-	typedef std::map<TPACKETID, U64> packet_time_map;
+	typedef LLPacketIDWindow<U64> packet_time_map;
 
 	packet_time_map							mPotentialLostPackets;
 	packet_time_map							mRecentlyReceivedReliablePackets;
 	std::vector<TPACKETID> mAcks;
 
-	typedef std::map<TPACKETID, LLReliablePacket *> reliable_map;
+	typedef LLPacketIDWindow<LLReliablePacket *> reliable_map;
 	typedef reliable_map::iterator					reliable_iter;
 
-	reliable_map							mUnackedPackets;
-	reliable_map							mFinalRetryPackets;
+	// Reliable packets waiting for an ack.  Packets that are out of
+	// retries (mRetries == 0) are only waiting for their final timeout.
+	reliable_map							mReliablePackets;
 
 	S32										mUnackedPacketCount;
 	S32										mUnackedPacketBytes;
@@ -319,6 +324,7 @@ public:
 	void			dumpResends();
 
 	typedef std::map<LLHost, LLCircuitData*> circuit_data_map;
+	typedef boost::unordered_map<LLHost, LLCircuitData*, LLHostHash> circuit_hash_map;
 
 	/**
 	 * @brief This method gets an iterator range starting after key in
@@ -340,10 +346,11 @@ public:
 
 	// Lists that optimize how many circuits we need to traverse a frame
 	// HACK - this should become protected eventually, but stupid !@$@# message system/circuit classes are jumbling things up.
-	circuit_data_map mUnackedCircuitMap; // Map of circuits with unacked data
-	circuit_data_map mSendAckMap; // Map of circuits which need to send acks
+	circuit_hash_map mUnackedCircuitMap; // Map of circuits with unacked data
+	std::vector<LLCircuitData*> mSendAckList; // Circuits which need to send acks
 protected:
 	circuit_data_map mCircuitData;
+	circuit_hash_map mCircuitHash; // Same as mCircuitData, for lookups by host
 
 	typedef std::set<LLCircuitData *, LLCircuitData::less> ping_set_t; // Circuits sorted by next ping time
 	ping_set_t mPingSet;
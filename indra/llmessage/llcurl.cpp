@@ -43,15 +43,25 @@
 #include "linden_common.h"
 
 #include "llcurl.h"
+#include "llcurlhostgate.h"
 
 #include <algorithm>
+#include <deque>
 #include <iomanip>
 #include <curl/curl.h>
 #if SAFE_SSL
 #include <openssl/crypto.h>
 #endif
+#if LL_LINUX
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+#endif
+#include "apr_atomic.h"
 
 #include "llbufferstream.h"
+#include "llfasttimer.h"
 #include "llstl.h"
 #include "llsdserialize.h"
 #include "llthread.h"
@@ -60,32 +70,34 @@
 
 //////////////////////////////////////////////////////////////////////////////
 /*
-	The trick to getting curl to do keep-alives is to reuse the
-	same easy handle for the requests.  It appears that curl
-	keeps a pool of connections alive for each easy handle, but
-	doesn't share them between easy handles.  Therefore it is
-	important to keep a pool of easy handles and reuse them,
-	rather than create and destroy them with each request.  This
-	code does this.
-
-	Furthermore, it would behoove us to keep track of which
-	hosts an easy handle was used for and pick an easy handle
-	that matches the next request.  This code does not current
-	do this.
+	Every request runs on the one multi handle of the service
+	thread, and a multi handle keeps the connections of the easy
+	handles added to it in a single cache.  So keep-alives work
+	whichever easy handle the next request to a host gets, as long
+	as the connection is still cached when it starts.  That is why
+	requests over the per host limit wait in the service queue
+	rather than open more connections, which would push others out
+	of the cache.
+
+	libcurl 7.20 has no CURLMOPT_MAX_HOST_CONNECTIONS, so the
+	service counts the active requests per host itself.
  */
 
 //////////////////////////////////////////////////////////////////////////////
 
-static const U32 EASY_HANDLE_POOL_SIZE		= 5;
-//static const S32 MULTI_PERFORM_CALL_REPEAT	= 5;
-//possable textuer corruption problem changing to 1 sams voodoo
-static const S32 MULTI_PERFORM_CALL_REPEAT	= 1;
 static const S32 CURL_REQUEST_TIMEOUT = 30; // seconds
-static const S32 MAX_ACTIVE_REQUEST_COUNT = 100;
+static const S32 MAX_ACTIVE_REQUEST_COUNT = 100; // all hosts together
+static const S32 MAX_CACHED_CONNECTIONS = 64;
+static const S32 SERVICE_MAX_WAIT_MS = 1000;
+#if !LL_LINUX
+static const S32 SERVICE_POLL_MS = 10;
+#endif
+
+static LLFastTimer::DeclareTimer FTM_CURL_SOCKET_ACTION("Curl Socket Action");
+static LLFastTimer::DeclareTimer FTM_CURL_PROCESS("Curl Process");
 
 // DEBUG //
 S32 gCurlEasyCount = 0;
-S32 gCurlMultiCount = 0;
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -93,9 +105,7 @@ S32 gCurlMultiCount = 0;
 std::vector<LLMutex*> LLCurl::sSSLMutex;
 std::string LLCurl::sCAPath;
 std::string LLCurl::sCAFile;
-// evil sam set multi-threaded to true
-bool LLCurl::sMultiThreaded = false;
-static U32 sMainThreadID = 0;
+U32 LLCurl::sMaxPerHost[LLCurl::PRIORITY_COUNT];
 
 void check_curl_code(CURLcode code)
 {
@@ -138,7 +148,8 @@ std::string LLCurl::getVersionString()
 //////////////////////////////////////////////////////////////////////////////
 
 LLCurl::Responder::Responder()
-	: mReferenceCount(0)
+	: mReferenceCount(0),
+	  mTransferStartTime(0)
 {
 }
 
@@ -226,7 +237,14 @@ namespace boost
 //////////////////////////////////////////////////////////////////////////////
 
 
-class LLCurl::Easy
+// Link in a Completions queue.
+struct LLCurlQueueNode
+{
+	LLCurlQueueNode() : mNext(NULL) {}
+	LLCurlQueueNode* volatile mNext;
+};
+
+class LLCurl::Easy : public LLCurlQueueNode
 {
 	LOG_CLASS(Easy);
 
@@ -256,6 +274,13 @@ public:
 	void getTransferInfo(LLCurl::TransferInfo* info);
 
 	void prepRequest(const std::string& url, const std::vector<std::string>& headers, ResponderPtr, S32 time_out = 0, bool post = false);
+	void setURL(const std::string& url);
+
+	void setPriority(EPriority priority) { mPriority = priority; }
+	const std::string& getHost() const { return mHost; }
+	void setCompletions(Completions* completions) { mCompletions = completions; }
+	// Only valid once the easy came back through its Completions queue.
+	CURLcode getResult() const { return mResult; }
 	
 	const char* getErrorBuffer();
 
@@ -271,6 +296,15 @@ public:
 
 private:	
 	friend class LLCurl;
+	friend class Service;
+
+	enum EState
+	{
+		STATE_IDLE,
+		STATE_PENDING,	// Waiting for a connection.
+		STATE_ACTIVE,	// On the multi handle.
+		STATE_DONE		// In its Completions queue.
+	};
 
 	CURL*				mCurlEasyHandle;
 	struct curl_slist*	mHeaders;
@@ -287,6 +321,15 @@ private:
 	
 	ResponderPtr		mResponder;
 
+	// Set before the easy is submitted; the rest belongs to the service
+	// thread until the easy is handed back.
+	EPriority			mPriority;
+	Completions*		mCompletions;
+	std::string			mHost;	// Connections are limited per host.
+	U64					mStartTime;	// When it got its connection.
+	CURLcode			mResult;
+	EState				mState;
+
 	static std::set<CURL*> sFreeHandles;
 	static std::set<CURL*> sActiveHandles;
 	static LLMutex* sHandleMutex;
@@ -344,7 +387,12 @@ void LLCurl::Easy::releaseEasyHandle(CURL* handle)
 
 LLCurl::Easy::Easy()
 	: mHeaders(NULL),
-	  mCurlEasyHandle(NULL)
+	  mCurlEasyHandle(NULL),
+	  mPriority(PRIORITY_CAPS),
+	  mCompletions(NULL),
+	  mStartTime(0),
+	  mResult(CURLE_OK),
+	  mState(STATE_IDLE)
 {
 	mErrorBuffer[0] = 0;
 }
@@ -357,7 +405,7 @@ LLCurl::Easy* LLCurl::Easy::getEasy()
 	if (!easy->mCurlEasyHandle)
 	{
 		// this can happen if we have too many open files (fails in c-ares/ares_init.c)
-		llwarns << "allocEasyHandle() returned NULL! Easy handles: " << gCurlEasyCount << " Multi handles: " << gCurlMultiCount << llendl;
+		llwarns << "allocEasyHandle() returned NULL! Easy handles: " << gCurlEasyCount << llendl;
 		delete easy;
 		return NULL;
 	}
@@ -419,6 +467,8 @@ void LLCurl::Easy::resetState()
 	
 	mHeaderOutput.str("");
 	mHeaderOutput.clear();
+
+	mStartTime = 0;
 }
 
 void LLCurl::Easy::setErrorBuffer()
@@ -474,6 +524,7 @@ U32 LLCurl::Easy::report(CURLcode code)
 		
 	if (mResponder)
 	{	
+		mResponder->setTransferStartTime(mStartTime);
 		mResponder->completedRaw(responseCode, responseReason, mChannels, mOutput);
 		mResponder = NULL;
 	}
@@ -606,7 +657,7 @@ void LLCurl::Easy::prepRequest(const std::string& url,
 	setopt(CURLOPT_SSL_VERIFYHOST, 0);
 	setopt(CURLOPT_TIMEOUT, llmax(time_out, CURL_REQUEST_TIMEOUT));
 
-	setoptString(CURLOPT_URL, url);
+	setURL(url);
 
 	mResponder = responder;
 
@@ -623,272 +674,512 @@ void LLCurl::Easy::prepRequest(const std::string& url,
 	}
 }
 
+void LLCurl::Easy::setURL(const std::string& url)
+{
+	setoptString(CURLOPT_URL, url);
+
+	// scheme://[user@]host[:port]/path, the scheme being optional to curl.
+	std::string::size_type start = url.find("://");
+	start = (start == std::string::npos) ? 0 : start + 3;
+	std::string::size_type end = url.find_first_of("/?#", start);
+	mHost = url.substr(start, end == std::string::npos ? std::string::npos : end - start);
+}
+
 ////////////////////////////////////////////////////////////////////////////
 
-class LLCurl::Multi : public LLThread
+// Multiple producer, single consumer queue of finished easies (Vyukov's
+// intrusive queue).  The service thread pushes without taking a lock and
+// the requester pops on its own thread, so a requester polling for results
+// never waits on the service.
+class LLCurl::Completions
 {
-	LOG_CLASS(Multi);
 public:
+	Completions() : mHead(&mStub), mTail(&mStub) {}
 
-	typedef enum
+	// Any thread.
+	void push(Easy* easy)		{ pushNode(easy); }
+	// Requester thread only.  Returns NULL when empty.
+	Easy* pop();
+
+private:
+	void pushNode(LLCurlQueueNode* node);
+	static LLCurlQueueNode* load(LLCurlQueueNode* volatile* nodep)
 	{
-		PERFORM_STATE_READY=0,
-		PERFORM_STATE_PERFORMING=1,
-		PERFORM_STATE_COMPLETED=2
-	} ePerformState;
+		return (LLCurlQueueNode*)apr_atomic_casptr((volatile void**)nodep, NULL, NULL);
+	}
 
-	Multi();
-	~Multi();
+	LLCurlQueueNode mStub;
+	LLCurlQueueNode* volatile mHead;	// Last pushed.
+	LLCurlQueueNode* mTail;				// Next to pop.
+};
 
-	Easy* allocEasy();
-	bool addEasy(Easy* easy);
-	
-	void removeEasy(Easy* easy);
+void LLCurl::Completions::pushNode(LLCurlQueueNode* node)
+{
+	node->mNext = NULL;
+	LLCurlQueueNode* prev = (LLCurlQueueNode*)apr_atomic_xchgptr((volatile void**)&mHead, node);
+	// Until this store, pop() sees the queue end at prev.
+	apr_atomic_xchgptr((volatile void**)&prev->mNext, node);
+}
 
-	S32 process();
-	void perform();
-	void doPerform();
-	
-	virtual void run();
+LLCurl::Easy* LLCurl::Completions::pop()
+{
+	LLCurlQueueNode* tail = mTail;
+	LLCurlQueueNode* next = load(&tail->mNext);
+	if (tail == &mStub)
+	{
+		if (!next)
+		{
+			return NULL;
+		}
+		mTail = next;
+		tail = next;
+		next = load(&next->mNext);
+	}
+	if (next)
+	{
+		mTail = next;
+		return static_cast<Easy*>(tail);
+	}
+	if (tail != load(&mHead))
+	{
+		// A push is half way through, it will be seen next time.
+		return NULL;
+	}
+	pushNode(&mStub);
+	next = load(&tail->mNext);
+	if (next)
+	{
+		mTail = next;
+		return static_cast<Easy*>(tail);
+	}
+	return NULL;
+}
 
-	CURLMsg* info_read(S32* msgs_in_queue);
+////////////////////////////////////////////////////////////////////////////
 
-	S32 mQueued;
-	S32 mErrorCount;
-	
-	S32 mPerformState;
+// One thread running every transfer on one multi handle, woken up by the
+// sockets curl asks it to watch, by curl's timer and by new requests.
+class LLCurl::Service : public LLThread
+{
+	LOG_CLASS(Service);
+public:
+	Service();
+	~Service();
 
-	LLCondition* mSignal;
-	bool mQuitting;
-	bool mThreaded;
+	// Queues easy until its host has a free connection.  Any thread.
+	void submit(Easy* easy);
+	// Takes back an easy that has not finished yet; the service does not
+	// touch it after this returns.  A finished one stays in its queue.
+	void cancel(Easy* easy);
+	void stop();
+
+	virtual void run();
 
 private:
-	void easyFree(Easy*);
-	
+	static int socketCallback(CURL* handle, curl_socket_t sock, int what, void* userp, void* socketp);
+	static int timerCallback(CURLM* multi, long timeout_ms, void* userp);
+
+	void startPending();
+	void startEasy(Easy* easy);
+	void removeEasy(Easy* easy);
+	void socketAction(curl_socket_t sock, int events);
+	void checkDone();
+	S32 getWaitTime();
+	void waitForEvents(S32 wait_ms);
+	void wakeUp();
+
+	LLMutex mMutex;		// Held around everything but the wait for events.
 	CURLM* mCurlMultiHandle;
 
-	typedef std::set<Easy*> easy_active_list_t;
-	easy_active_list_t mEasyActiveList;
-	typedef std::map<CURL*, Easy*> easy_active_map_t;
-	easy_active_map_t mEasyActiveMap;
-	typedef std::set<Easy*> easy_free_list_t;
-	easy_free_list_t mEasyFreeList;
-};
+	typedef std::deque<Easy*> easy_queue_t;
+	easy_queue_t mPending[PRIORITY_COUNT];
+	bool mPendingChanged;
 
-LLCurl::Multi::Multi()
-	: LLThread("Curl Multi"),
-	  mQueued(0),
-	  mErrorCount(0),
-	  mPerformState(PERFORM_STATE_READY)
-{
-	mQuitting = false;
+	LLCurlHostGate mGate;
 
-	mThreaded = LLCurl::sMultiThreaded && LLThread::currentID() == sMainThreadID;
-	if (mThreaded)
+	struct StartEasy
 	{
-		mSignal = new LLCondition;
-	}
-	else
+		StartEasy(Service* service) : mService(service) {}
+		void operator()(Easy* easy) { mService->startEasy(easy); }
+		Service* mService;
+	};
+
+	bool mTimerSet;
+	U64 mTimerDeadline;		// When curl wants CURL_SOCKET_TIMEOUT, in usec.
+
+#if LL_LINUX
+	int mEpoll;
+	int mWakePipe[2];
+	bool mWakeSignalled;
+#else
+	typedef std::map<curl_socket_t, int> socket_map_t;
+	socket_map_t mSockets;	// What curl wants to know about each.
+#endif
+};
+
+static LLCurl::Service* sService = NULL;
+
+LLCurl::Service::Service()
+	: LLThread("Curl Service"),
+	  mPendingChanged(false),
+	  mGate(PRIORITY_COUNT, MAX_ACTIVE_REQUEST_COUNT),
+	  mTimerSet(false),
+	  mTimerDeadline(0)
+{
+	for (S32 priority = 0; priority < PRIORITY_COUNT; ++priority)
 	{
-		mSignal = NULL;
+		mGate.setMaxPerHost(priority, sMaxPerHost[priority]);
 	}
 
 	mCurlMultiHandle = curl_multi_init();
-	if (!mCurlMultiHandle)
-	{
-		llwarns << "curl_multi_init() returned NULL! Easy handles: " << gCurlEasyCount << " Multi handles: " << gCurlMultiCount << llendl;
-		mCurlMultiHandle = curl_multi_init();
-	}
-	
 	llassert_always(mCurlMultiHandle);
-	++gCurlMultiCount;
+	check_curl_multi_code(curl_multi_setopt(mCurlMultiHandle, CURLMOPT_SOCKETFUNCTION, &socketCallback));
+	check_curl_multi_code(curl_multi_setopt(mCurlMultiHandle, CURLMOPT_SOCKETDATA, this));
+	check_curl_multi_code(curl_multi_setopt(mCurlMultiHandle, CURLMOPT_TIMERFUNCTION, &timerCallback));
+	check_curl_multi_code(curl_multi_setopt(mCurlMultiHandle, CURLMOPT_TIMERDATA, this));
+	// Idle connections kept for reuse, shared by all the hosts.
+	check_curl_multi_code(curl_multi_setopt(mCurlMultiHandle, CURLMOPT_MAXCONNECTS, (long)MAX_CACHED_CONNECTIONS));
+
+#if LL_LINUX
+	mWakeSignalled = false;
+	mEpoll = epoll_create(64);
+	if (mEpoll < 0 || pipe(mWakePipe) != 0)
+	{
+		llerrs << "Unable to set up the curl service thread, errno " << errno << llendl;
+	}
+	fcntl(mWakePipe[0], F_SETFL, O_NONBLOCK);
+	fcntl(mWakePipe[1], F_SETFL, O_NONBLOCK);
+	struct epoll_event event;
+	memset(&event, 0, sizeof(event));	/* Flawfinder: ignore */
+	event.events = EPOLLIN;
+	event.data.fd = mWakePipe[0];
+	epoll_ctl(mEpoll, EPOLL_CTL_ADD, mWakePipe[0], &event);
+#endif
 }
 
-LLCurl::Multi::~Multi()
+LLCurl::Service::~Service()
 {
 	llassert(isStopped());
+	// Whatever is still queued or running belongs to requesters that will
+	// not get an answer anymore; curl lets go of the active ones itself.
+	check_curl_multi_code(curl_multi_cleanup(mCurlMultiHandle));
+#if LL_LINUX
+	close(mWakePipe[0]);
+	close(mWakePipe[1]);
+	close(mEpoll);
+#endif
+}
 
-	delete mSignal;
-	mSignal = NULL;
+void LLCurl::Service::submit(Easy* easy)
+{
+	LLMutexLock lock(&mMutex);
+	easy->mState = Easy::STATE_PENDING;
+	mPending[easy->mPriority].push_back(easy);
+	mPendingChanged = true;
+	wakeUp();
+}
 
-	// Clean up active
-	for(easy_active_list_t::iterator iter = mEasyActiveList.begin();
-		iter != mEasyActiveList.end(); ++iter)
+void LLCurl::Service::cancel(Easy* easy)
+{
+	LLMutexLock lock(&mMutex);
+	if (easy->mState == Easy::STATE_PENDING)
 	{
-		Easy* easy = *iter;
-		check_curl_multi_code(curl_multi_remove_handle(mCurlMultiHandle, easy->getCurlHandle()));
-		delete easy;
+		easy_queue_t& pending = mPending[easy->mPriority];
+		pending.erase(std::find(pending.begin(), pending.end(), easy));
+		easy->mState = Easy::STATE_IDLE;
+	}
+	else if (easy->mState == Easy::STATE_ACTIVE)
+	{
+		removeEasy(easy);
+		easy->mState = Easy::STATE_IDLE;
 	}
-	mEasyActiveList.clear();
-	mEasyActiveMap.clear();
-	
-	// Clean up freed
-	for_each(mEasyFreeList.begin(), mEasyFreeList.end(), DeletePointer());	
-	mEasyFreeList.clear();
-
-	check_curl_multi_code(curl_multi_cleanup(mCurlMultiHandle));
-	--gCurlMultiCount;
 }
 
-CURLMsg* LLCurl::Multi::info_read(S32* msgs_in_queue)
+void LLCurl::Service::stop()
 {
-	CURLMsg* curlmsg = curl_multi_info_read(mCurlMultiHandle, msgs_in_queue);
-	return curlmsg;
+	setQuitting();
+	{
+		LLMutexLock lock(&mMutex);
+		wakeUp();
+	}
+	shutdown();
 }
 
-void LLCurl::Multi::perform()
+void LLCurl::Service::run()
 {
-	if (mThreaded)
+	mMutex.lock();
+	while (!isQuitting())
 	{
-		mSignal->lock();
-		if (mPerformState == PERFORM_STATE_READY)
+		startPending();
+		if (mTimerSet && totalTime() >= mTimerDeadline)
 		{
-			mSignal->signal();
+			mTimerSet = false;
+			socketAction(CURL_SOCKET_TIMEOUT, 0);
+			// Finished transfers may have let queued ones through.
+			startPending();
 		}
-		mSignal->unlock();
+		waitForEvents(getWaitTime());
 	}
-	else
+	mMutex.unlock();
+}
+
+S32 LLCurl::Service::getWaitTime()
+{
+	S32 wait_ms = SERVICE_MAX_WAIT_MS;
+	if (mTimerSet)
 	{
-		doPerform();
-	}	
+		U64 now = totalTime();
+		wait_ms = mTimerDeadline <= now ? 0 : (S32)llmin((mTimerDeadline - now + 999) / 1000, (U64)wait_ms);
+	}
+	return wait_ms;
 }
 
-void LLCurl::Multi::run()
+#if LL_LINUX
+void LLCurl::Service::waitForEvents(S32 wait_ms)
 {
-	llassert(mThreaded);
-	
-	mSignal->lock();
-	while (!mQuitting)
+	const S32 MAX_EVENTS = 64;
+	struct epoll_event events[MAX_EVENTS];
+	mMutex.unlock();
+	S32 count = epoll_wait(mEpoll, events, MAX_EVENTS, wait_ms);
+	mMutex.lock();
+	for (S32 i = 0; i < count; ++i)
 	{
-		mSignal->wait();
-		mPerformState = PERFORM_STATE_PERFORMING;
-		if (!mQuitting)
+		if (events[i].data.fd == mWakePipe[0])
+		{
+			char buffer[64];
+			while (read(mWakePipe[0], buffer, sizeof(buffer)) > 0)
+			{
+			}
+			mWakeSignalled = false;
+			continue;
+		}
+		int action = 0;
+		if (events[i].events & EPOLLIN)
+		{
+			action |= CURL_CSELECT_IN;
+		}
+		if (events[i].events & EPOLLOUT)
+		{
+			action |= CURL_CSELECT_OUT;
+		}
+		if (events[i].events & (EPOLLERR | EPOLLHUP))
 		{
-			doPerform();
+			action |= CURL_CSELECT_ERR;
 		}
+		socketAction(events[i].data.fd, action);
 	}
-	mSignal->unlock();
 }
 
-void LLCurl::Multi::doPerform()
+void LLCurl::Service::wakeUp()
 {
-	S32 q = 0;
-	if (mThreaded)
-		mSignal->unlock();
-	for (S32 call_count = 0;
-			call_count < MULTI_PERFORM_CALL_REPEAT;
-			call_count += 1)
+	if (!mWakeSignalled)
 	{
-		CURLMcode code = curl_multi_perform(mCurlMultiHandle, &q);
-		if (CURLM_CALL_MULTI_PERFORM != code || q == 0)
+		mWakeSignalled = true;
+		char byte = 0;
+		if (write(mWakePipe[1], &byte, 1) < 0)
 		{
-			check_curl_multi_code(code);
-			break;
+			// Full, which wakes it up just as well.
 		}
-	
 	}
-	if (mThreaded)
-		mSignal->lock();
-	mQueued = q;
-	mPerformState = PERFORM_STATE_COMPLETED;
 }
+#else
+void LLCurl::Service::waitForEvents(S32 wait_ms)
+{
+	// Without a handle to wake select() up with, new requests wait for
+	// the next poll at most.
+	wait_ms = llmin(wait_ms, SERVICE_POLL_MS);
+
+	fd_set read_fds;
+	fd_set write_fds;
+	fd_set error_fds;
+	FD_ZERO(&read_fds);
+	FD_ZERO(&write_fds);
+	FD_ZERO(&error_fds);
+	std::vector<curl_socket_t> sockets;
+	curl_socket_t max_fd = 0;
+	for (socket_map_t::iterator iter = mSockets.begin(); iter != mSockets.end(); ++iter)
+	{
+		curl_socket_t sock = iter->first;
+		if (iter->second & CURL_POLL_IN)
+		{
+			FD_SET(sock, &read_fds);
+		}
+		if (iter->second & CURL_POLL_OUT)
+		{
+			FD_SET(sock, &write_fds);
+		}
+		FD_SET(sock, &error_fds);
+		max_fd = llmax(max_fd, sock);
+		sockets.push_back(sock);
+	}
 
-S32 LLCurl::Multi::process()
-{
-	perform();
-
-	if (mPerformState != PERFORM_STATE_COMPLETED)
+	mMutex.unlock();
+	S32 count = 0;
+	if (sockets.empty())
 	{
-		return 0;
+		ms_sleep(wait_ms);
 	}
+	else
+	{
+		struct timeval timeout;
+		timeout.tv_sec = wait_ms / 1000;
+		timeout.tv_usec = (wait_ms % 1000) * 1000;
+		count = select((int)max_fd + 1, &read_fds, &write_fds, &error_fds, &timeout);
+	}
+	mMutex.lock();
 
-	CURLMsg* msg;
-	int msgs_in_queue;
-
-	S32 processed = 0;
-	while ((msg = info_read(&msgs_in_queue)))
+	for (S32 i = 0; count > 0 && i < (S32)sockets.size(); ++i)
 	{
-		++processed;
-		if (msg->msg == CURLMSG_DONE)
+		curl_socket_t sock = sockets[i];
+		int action = 0;
+		if (FD_ISSET(sock, &read_fds))
 		{
-			U32 response = 0;
-			easy_active_map_t::iterator iter = mEasyActiveMap.find(msg->easy_handle);
-			if (iter != mEasyActiveMap.end())
-			{
-				Easy* easy = iter->second;
-				response = easy->report(msg->data.result);
-				removeEasy(easy);
-			}
-			else
-			{
-				response = 499;
-				//*TODO: change to llwarns
-				llerrs << "cleaned up curl request completed!" << llendl;
-			}
-			if (response >= 400)
-			{
-				// failure of some sort, inc mErrorCount for debugging and flagging multi for destruction
-				++mErrorCount;
-			}
+			action |= CURL_CSELECT_IN;
+		}
+		if (FD_ISSET(sock, &write_fds))
+		{
+			action |= CURL_CSELECT_OUT;
+		}
+		if (FD_ISSET(sock, &error_fds))
+		{
+			action |= CURL_CSELECT_ERR;
+		}
+		if (action)
+		{
+			socketAction(sock, action);
 		}
 	}
-
-	mPerformState = PERFORM_STATE_READY;
-	return processed;
 }
 
-LLCurl::Easy* LLCurl::Multi::allocEasy()
+void LLCurl::Service::wakeUp()
 {
-	Easy* easy = 0;
+}
+#endif
 
-	if (mEasyFreeList.empty())
+//static
+int LLCurl::Service::socketCallback(CURL* handle, curl_socket_t sock, int what, void* userp, void* socketp)
+{
+	Service* self = (Service*)userp;
+#if LL_LINUX
+	struct epoll_event event;
+	memset(&event, 0, sizeof(event));	/* Flawfinder: ignore */
+	event.data.fd = sock;
+	if (what == CURL_POLL_REMOVE)
 	{
-		easy = Easy::getEasy();
+		epoll_ctl(self->mEpoll, EPOLL_CTL_DEL, sock, &event);
+		return 0;
 	}
-	else
+	if (what & CURL_POLL_IN)
 	{
-		easy = *(mEasyFreeList.begin());
-		mEasyFreeList.erase(easy);
+		event.events |= EPOLLIN;
 	}
-	if (easy)
+	if (what & CURL_POLL_OUT)
 	{
-		mEasyActiveList.insert(easy);
-		mEasyActiveMap[easy->getCurlHandle()] = easy;
+		event.events |= EPOLLOUT;
 	}
-	return easy;
+	// socketp marks the sockets already in the set.
+	int op = socketp ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+	if (epoll_ctl(self->mEpoll, op, sock, &event) != 0)
+	{
+		op = (op == EPOLL_CTL_ADD) ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+		if (epoll_ctl(self->mEpoll, op, sock, &event) != 0)
+		{
+			llwarns << "Unable to watch curl socket " << sock << ", errno " << errno << llendl;
+			return 0;
+		}
+	}
+	if (!socketp)
+	{
+		curl_multi_assign(self->mCurlMultiHandle, sock, self);
+	}
+#else
+	if (what == CURL_POLL_REMOVE)
+	{
+		self->mSockets.erase(sock);
+	}
+	else
+	{
+		self->mSockets[sock] = what;
+	}
+#endif
+	return 0;
 }
 
-bool LLCurl::Multi::addEasy(Easy* easy)
+//static
+int LLCurl::Service::timerCallback(CURLM* multi, long timeout_ms, void* userp)
 {
-	CURLMcode mcode = curl_multi_add_handle(mCurlMultiHandle, easy->getCurlHandle());
-	check_curl_multi_code(mcode);
-	//if (mcode != CURLM_OK)
-	//{
-	//	llwarns << "Curl Error: " << curl_multi_strerror(mcode) << llendl;
-	//	return false;
-	//}
-	return true;
+	Service* self = (Service*)userp;
+	self->mTimerSet = timeout_ms >= 0;
+	self->mTimerDeadline = totalTime() + (U64)llmax(timeout_ms, 0L) * 1000;
+	return 0;
 }
 
-void LLCurl::Multi::easyFree(Easy* easy)
+void LLCurl::Service::startPending()
 {
-	mEasyActiveList.erase(easy);
-	mEasyActiveMap.erase(easy->getCurlHandle());
-	if (mEasyFreeList.size() < EASY_HANDLE_POOL_SIZE)
+	if (!mPendingChanged)
 	{
-		easy->resetState();
-		mEasyFreeList.insert(easy);
+		return;
 	}
-	else
+	mPendingChanged = false;
+
+	StartEasy start(this);
+	if (mGate.startReady(mPending, start))
 	{
-		delete easy;
+		// Gets the new transfers going.
+		socketAction(CURL_SOCKET_TIMEOUT, 0);
 	}
 }
 
-void LLCurl::Multi::removeEasy(Easy* easy)
+void LLCurl::Service::startEasy(Easy* easy)
+{
+	easy->mState = Easy::STATE_ACTIVE;
+	easy->mStartTime = totalTime();
+	easy->setopt(CURLOPT_PRIVATE, (void*)easy);
+	check_curl_multi_code(curl_multi_add_handle(mCurlMultiHandle, easy->getCurlHandle()));
+}
+
+void LLCurl::Service::removeEasy(Easy* easy)
 {
 	check_curl_multi_code(curl_multi_remove_handle(mCurlMultiHandle, easy->getCurlHandle()));
-	easyFree(easy);
+	mGate.finished(easy->mPriority, easy->mHost);
+	mPendingChanged = true;
+}
+
+void LLCurl::Service::socketAction(curl_socket_t sock, int events)
+{
+	LLFastTimer t(FTM_CURL_SOCKET_ACTION);
+	int running = 0;
+	CURLMcode code;
+	do
+	{
+		code = curl_multi_socket_action(mCurlMultiHandle, sock, events, &running);
+	}
+	while (code == CURLM_CALL_MULTI_PERFORM);
+	check_curl_multi_code(code);
+	checkDone();
+}
+
+void LLCurl::Service::checkDone()
+{
+	CURLMsg* msg;
+	int msgs_in_queue;
+	while ((msg = curl_multi_info_read(mCurlMultiHandle, &msgs_in_queue)))
+	{
+		if (msg->msg != CURLMSG_DONE)
+		{
+			continue;
+		}
+		char* privatep = NULL;
+		check_curl_code(curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, &privatep));
+		Easy* easy = (Easy*)privatep;
+		CURLcode result = msg->data.result;
+		removeEasy(easy);
+
+		easy->mResult = result;
+		easy->mState = Easy::STATE_DONE;
+		// The requester may free it as soon as it is pushed.
+		easy->mCompletions->push(easy);
+	}
 }
 
 //static
@@ -899,80 +1190,62 @@ std::string LLCurl::strerror(CURLcode errorcode)
 
 ////////////////////////////////////////////////////////////////////////////
 // For generating a simple request for data
-// using one multi and one easy per request 
+// using one easy per request on the service thread
 
-LLCurlRequest::LLCurlRequest() :
-	mActiveMulti(NULL),
-	mActiveRequestCount(0)
+LLCurlRequest::LLCurlRequest(LLCurl::EPriority priority) :
+	mCompletions(new LLCurl::Completions),
+	mPriority(priority),
+	mProcessing(FALSE)
 {
 	mThreadID = LLThread::currentID();
-	mProcessing = FALSE;
 }
 
 LLCurlRequest::~LLCurlRequest()
 {
 	llassert_always(mThreadID == LLThread::currentID());
 
-	//stop all Multi handle background threads
-	for (curlmulti_set_t::iterator iter = mMultiSet.begin(); iter != mMultiSet.end(); ++iter)
+	// Once the service has let go of them, only the queue still has any.
+	if (sService)
 	{
-		LLCurl::Multi* multi = *iter;
-		if (multi->mThreaded)
-			multi->mSignal->lock();
-		multi->mQuitting = true;
-		if (multi->mThreaded)
+		for (easy_set_t::iterator iter = mEasySet.begin(); iter != mEasySet.end(); ++iter)
 		{
-			while (!multi->isStopped())
-			{
-				multi->mSignal->signal();
-				multi->mSignal->unlock();
-				apr_sleep(1024);// was 1000 checking something sams voodoo
-				multi->mSignal->lock();
-			}
+			sService->cancel(*iter);
 		}
-		if (multi->mThreaded)
-			multi->mSignal->unlock();
 	}
-	for_each(mMultiSet.begin(), mMultiSet.end(), DeletePointer());
-}
-
-void LLCurlRequest::addMulti()
-{
-	llassert_always(mThreadID == LLThread::currentID());
-	LLCurl::Multi* multi = new LLCurl::Multi();
-	if (multi->mThreaded)
+	while (mCompletions->pop())
 	{
-		multi->start();
 	}
-	mMultiSet.insert(multi);
-	mActiveMulti = multi;
-	mActiveRequestCount = 0;
+	for_each(mEasySet.begin(), mEasySet.end(), DeletePointer());
+	mEasySet.clear();
+	delete mCompletions;
 }
 
 LLCurl::Easy* LLCurlRequest::allocEasy()
 {
-	if (!mActiveMulti ||
-		mActiveRequestCount	>= MAX_ACTIVE_REQUEST_COUNT ||
-		mActiveMulti->mErrorCount > 0)
+	llassert_always(mThreadID == LLThread::currentID());
+	LLCurl::Easy* easy = LLCurl::Easy::getEasy();
+	if (easy)
 	{
-		addMulti();
+		easy->setPriority(mPriority);
+		easy->setCompletions(mCompletions);
 	}
-	llassert_always(mActiveMulti);
-	++mActiveRequestCount;
-	LLCurl::Easy* easy = mActiveMulti->allocEasy();
 	return easy;
 }
 
 bool LLCurlRequest::addEasy(LLCurl::Easy* easy)
 {
-	llassert_always(mActiveMulti);
-	
 	if (mProcessing)
 	{
 		llerrs << "Posting to a LLCurlRequest instance from within a responder is not allowed (causes DNS timeouts)." << llendl;
 	}
-	bool res = mActiveMulti->addEasy(easy);
-	return res;
+	if (!sService)
+	{
+		delete easy;
+		return false;
+	}
+	mEasySet.insert(easy);
+	sService->submit(easy);
+	return true;
 }
 
 void LLCurlRequest::get(const std::string& url, LLCurl::ResponderPtr responder)
@@ -1060,37 +1333,16 @@ bool LLCurlRequest::post(const std::string& url,
 S32 LLCurlRequest::process()
 {
 	llassert_always(mThreadID == LLThread::currentID());
+	LLFastTimer t(FTM_CURL_PROCESS);
 	S32 res = 0;
 
 	mProcessing = TRUE;
-	for (curlmulti_set_t::iterator iter = mMultiSet.begin();
-		 iter != mMultiSet.end(); )
-	{
-		curlmulti_set_t::iterator curiter = iter++;
-		LLCurl::Multi* multi = *curiter;
-		S32 tres = multi->process();
-		res += tres;
-		if (multi != mActiveMulti && tres == 0 && multi->mQueued == 0)
-		{
-			mMultiSet.erase(curiter);
-			if (multi->mThreaded)
-				multi->mSignal->lock();
-			multi->mQuitting = true;
-			if (multi->mThreaded)
-			{
-				while (!multi->isStopped())
-				{
-					multi->mSignal->signal();
-					multi->mSignal->unlock();
-					apr_sleep(1000);
-					multi->mSignal->unlock();
-				}
-			}
-			if (multi->mThreaded)
-				multi->mSignal->unlock();
-
-			delete multi;
-		}
+	while (LLCurl::Easy* easy = mCompletions->pop())
+	{
+		mEasySet.erase(easy);
+		easy->report(easy->getResult());
+		delete easy;
+		++res;
 	}
 	mProcessing = FALSE;
 	return res;
@@ -1099,60 +1351,41 @@ S32 LLCurlRequest::process()
 S32 LLCurlRequest::getQueued()
 {
 	llassert_always(mThreadID == LLThread::currentID());
-	S32 queued = 0;
-	for (curlmulti_set_t::iterator iter = mMultiSet.begin();
-		 iter != mMultiSet.end(); )
-	{
-		curlmulti_set_t::iterator curiter = iter++;
-		LLCurl::Multi* multi = *curiter;
-		queued += multi->mQueued;
-		if (multi->mPerformState != LLCurl::Multi::PERFORM_STATE_READY)
-		{
-			++queued;
-		}
-	}
-	return queued;
+	return (S32)mEasySet.size();
 }
 
 ////////////////////////////////////////////////////////////////////////////
 // For generating one easy request
-// associated with a single multi request
+// run by the service thread
 
 LLCurlEasyRequest::LLCurlEasyRequest()
-	: mRequestSent(false),
+	: mCompletions(new LLCurl::Completions),
+	  mRequestSent(false),
 	  mResultReturned(false)
 {
-	mMulti = new LLCurl::Multi();
-	if (mMulti->mThreaded)
-	{
-		mMulti->start();
-	}
-	mEasy = mMulti->allocEasy();
+	mEasy = LLCurl::Easy::getEasy();
 	if (mEasy)
 	{
 		mEasy->setErrorBuffer();
 		mEasy->setCA();
+		mEasy->setCompletions(mCompletions);
 	}
 }
 
 LLCurlEasyRequest::~LLCurlEasyRequest()
 {
-	if (mMulti->mThreaded)
-		mMulti->mSignal->lock();
-	mMulti->mQuitting = true;
-	if (mMulti->mThreaded)
+	if (mEasy)
 	{
-		while (!mMulti->isStopped())
+		if (sService)
+		{
+			sService->cancel(mEasy);
+		}
+		while (mCompletions->pop())
 		{
-			mMulti->mSignal->signal();
-			mMulti->mSignal->unlock();
-			apr_sleep(1000);
-			mMulti->mSignal->lock();
 		}
+		delete mEasy;
 	}
-	if (mMulti->mThreaded)
-		mMulti->mSignal->unlock();
-	delete mMulti;
+	delete mCompletions;
 }
 	
 void LLCurlEasyRequest::setopt(CURLoption option, S32 value)
@@ -1217,6 +1450,14 @@ void LLCurlEasyRequest::setSSLCtxCallback(curl_ssl_ctx_callback callback, void*
 	}
 }
 
+void LLCurlEasyRequest::setPriority(LLCurl::EPriority priority)
+{
+	if (mEasy)
+	{
+		mEasy->setPriority(priority);
+	}
+}
+
 void LLCurlEasyRequest::slist_append(const char* str)
 {
 	if (mEasy)
@@ -1230,11 +1471,19 @@ void LLCurlEasyRequest::sendRequest(const std::string& url)
 	llassert_always(!mRequestSent);
 	mRequestSent = true;
 	lldebugs << url << llendl;
+	if (mEasy && !sService)
+	{
+		// Nothing would ever complete it.  Fail it right away instead, as if
+		// the easy handle couldn't be made.
+		llwarns << "No curl service to send " << url << " on" << llendl;
+		delete mEasy;
+		mEasy = NULL;
+	}
 	if (mEasy)
 	{
 		mEasy->setHeaders();
-		mEasy->setoptString(CURLOPT_URL, url);
-		mMulti->addEasy(mEasy);
+		mEasy->setURL(url);
+		sService->submit(mEasy);
 	}
 }
 
@@ -1242,26 +1491,18 @@ void LLCurlEasyRequest::requestComplete()
 {
 	llassert_always(mRequestSent);
 	mRequestSent = false;
-	if (mEasy)
+	if (mEasy && sService)
 	{
-		mMulti->removeEasy(mEasy);
+		sService->cancel(mEasy);
+		while (mCompletions->pop())
+		{
+		}
 	}
 }
 
-void LLCurlEasyRequest::perform()
-{
-	mMulti->perform();
-}
-
 // Usage: Call getRestult until it returns false (no more messages)
 bool LLCurlEasyRequest::getResult(CURLcode* result, LLCurl::TransferInfo* info)
 {
-	if (mMulti->mPerformState != LLCurl::Multi::PERFORM_STATE_COMPLETED)
-	{ //we're busy, try again later
-		return false;
-	}
-	mMulti->mPerformState = LLCurl::Multi::PERFORM_STATE_READY;
-
 	if (!mEasy)
 	{
 		// Special case - we failed to initialize a curl_easy (can happen if too many open files)
@@ -1277,45 +1518,17 @@ bool LLCurlEasyRequest::getResult(CURLcode* result, LLCurl::TransferInfo* info)
 			return true;
 		}
 	}
-	// In theory, info_read might return a message with a status other than CURLMSG_DONE
-	// In practice for all messages returned, msg == CURLMSG_DONE
-	// Ignore other messages just in case
-	while(1)
+	if (!mCompletions->pop())
 	{
-		S32 q;
-		CURLMsg* curlmsg = info_read(&q, info);
-		if (curlmsg)
-		{
-			if (curlmsg->msg == CURLMSG_DONE)
-			{
-				*result = curlmsg->data.result;			
-				return true;
-			}
-			// else continue
-		}
-		else
-		{
-			return false;
-		}
+		// Still running, try again later
+		return false;
 	}
-}
-
-// private
-CURLMsg* LLCurlEasyRequest::info_read(S32* q, LLCurl::TransferInfo* info)
-{
-	if (mEasy)
+	*result = mEasy->getResult();
+	if (info)
 	{
-		CURLMsg* curlmsg = mMulti->info_read(q);
-		if (curlmsg && curlmsg->msg == CURLMSG_DONE)
-		{
-			if (info)
-			{
-				mEasy->getTransferInfo(info);
-			}
-		}
-		return curlmsg;
+		mEasy->getTransferInfo(info);
 	}
-	return NULL;
+	return true;
 }
 
 std::string LLCurlEasyRequest::getErrorString()
@@ -1346,10 +1559,8 @@ unsigned long LLCurl::ssl_thread_id(void)
 }
 #endif
 
-void LLCurl::initClass(bool multi_threaded)
+void LLCurl::initClass(U32 max_per_host, U32 max_texture_per_host)
 {
-	sMainThreadID = LLThread::currentID();
-	sMultiThreaded = multi_threaded;
 	// Do not change this "unless you are familiar with and mean to control 
 	// internal operations of libcurl"
 	// - http://curl.haxx.se/libcurl/c/curl_global_init.html
@@ -1368,13 +1579,30 @@ void LLCurl::initClass(bool multi_threaded)
 	CRYPTO_set_id_callback(&LLCurl::ssl_thread_id);
 	CRYPTO_set_locking_callback(&LLCurl::ssl_locking_callback);
 #endif
+
+	// Event polls are held open by the server until it has something to
+	// say, so they would only keep other requests waiting: no limit.
+	sMaxPerHost[PRIORITY_EVENT_POLL] = 0;
+	sMaxPerHost[PRIORITY_CAPS] = llmax(max_per_host, (U32)1);
+	sMaxPerHost[PRIORITY_MESH] = llmax(max_per_host, (U32)1);
+	sMaxPerHost[PRIORITY_TEXTURE] = llmax(max_texture_per_host, (U32)1);
+	sService = new Service();
+	sService->start();
 }
 
 void LLCurl::cleanupClass()
 {
+	if (sService)
+	{
+		sService->stop();
+		delete sService;
+		sService = NULL;
+	}
+
 #if SAFE_SSL
 	CRYPTO_set_locking_callback(NULL);
 	for_each(sSSLMutex.begin(), sSSLMutex.end(), DeletePointer());
+	sSSLMutex.clear();
 #endif
 
 	delete Easy::sHandleMutex;
@@ -59,9 +59,20 @@ class LLCurl
 	
 public:
 	class Easy;
-	class Multi;
+	class Service;
+	class Completions;
 
-	static bool sMultiThreaded;
+	// Request classes, each with its own limit of connections per host;
+	// queued requests are served in this order.  Event polls are long
+	// lived and never wait.
+	enum EPriority
+	{
+		PRIORITY_EVENT_POLL,
+		PRIORITY_CAPS,
+		PRIORITY_MESH,
+		PRIORITY_TEXTURE,
+		PRIORITY_COUNT
+	};
 
 	struct TransferInfo
 	{
@@ -125,15 +136,26 @@ public:
 			// Used internally to set the url for debugging later.
 			void setURL(const std::string& url);
 
+			// When the transfer got a connection, in totalTime() microseconds;
+			// set just before completedRaw(), 0 if it never started.
+			void setTransferStartTime(U64 time) { mTransferStartTime = time; }
+			U64 getTransferStartTime() const { return mTransferStartTime; }
+
 			virtual bool followRedir() 
 			{
 				return false;
 			}
+
+			virtual EPriority getPriority()
+			{
+				return PRIORITY_CAPS;
+			}
 	public: /* but not really -- don't touch this */
 		U32 mReferenceCount;
 
 	private:
 		std::string mURL;
+		U64 mTransferStartTime;
 	};
 	typedef boost::intrusive_ptr<Responder>	ResponderPtr;
 
@@ -163,10 +185,22 @@ public:
 	 */
 	static const std::string& getCAPath() { return sCAPath; }
 
+	static const U32 DEFAULT_MAX_PER_HOST = 8;
+	static const U32 DEFAULT_MAX_TEXTURE_PER_HOST = 64;
+
+	/**
+	 * @ brief Initialize LLCurl class and start the service thread
+	 * @param max_per_host connections opened to any one host at a time,
+	 *        for caps and for mesh requests each
+	 * @param max_texture_per_host the same for texture requests
+	 */
+	static void initClass(U32 max_per_host = DEFAULT_MAX_PER_HOST,
+						  U32 max_texture_per_host = DEFAULT_MAX_TEXTURE_PER_HOST);
+
 	/**
-	 * @ brief Initialize LLCurl class
+	 * @ brief Connections one class of requests may have open to a host, 0 for no limit
 	 */
-	static void initClass(bool multi_threaded = false);
+	static U32 getMaxPerHost(EPriority priority) { return sMaxPerHost[priority]; }
 
 	/**
 	 * @ brief Cleanup LLCurl class
@@ -188,6 +222,7 @@ public:
 private:
 	static std::string sCAPath;
 	static std::string sCAFile;
+	static U32 sMaxPerHost[PRIORITY_COUNT];
 	static const unsigned int MAX_REDIRECTS;
 };
 
@@ -198,12 +233,19 @@ namespace boost
 };
 
 
+//
+// All transfers run on one service thread, which drives a single curl
+// multi handle from socket readiness (curl_multi_socket_action), so
+// connections to a host are kept alive and shared by every requester.
+// Finished transfers come back to their requester through a lock free
+// queue; responders are called from process(), on the requester's thread.
+//
 class LLCurlRequest
 {
 public:
 	typedef std::vector<std::string> headers_t;
 	
-	LLCurlRequest();
+	LLCurlRequest(LLCurl::EPriority priority = LLCurl::PRIORITY_CAPS);
 	~LLCurlRequest();
 
 	void get(const std::string& url, LLCurl::ResponderPtr responder);
@@ -211,19 +253,20 @@ public:
 	bool post(const std::string& url, const headers_t& headers, const LLSD& data, LLCurl::ResponderPtr responder, S32 time_out = 0);
 	bool post(const std::string& url, const headers_t& headers, const std::string& data, LLCurl::ResponderPtr responder, S32 time_out = 0);
 	
+	// Calls the responders of finished requests, returns how many there were.
 	S32  process();
+	// Requests sent whose responder has not been called yet.
 	S32  getQueued();
 
 private:
-	void addMulti();
 	LLCurl::Easy* allocEasy();
 	bool addEasy(LLCurl::Easy* easy);
 	
 private:
-	typedef std::set<LLCurl::Multi*> curlmulti_set_t;
-	curlmulti_set_t mMultiSet;
-	LLCurl::Multi* mActiveMulti;
-	S32 mActiveRequestCount;
+	typedef std::set<LLCurl::Easy*> easy_set_t;
+	easy_set_t mEasySet;
+	LLCurl::Completions* mCompletions;
+	LLCurl::EPriority mPriority;
 	BOOL mProcessing;
 	U32 mThreadID; // debug
 };
@@ -240,18 +283,16 @@ public:
 	void setWriteCallback(curl_write_callback callback, void* userdata);
 	void setReadCallback(curl_read_callback callback, void* userdata);
 	void setSSLCtxCallback(curl_ssl_ctx_callback callback, void* userdata);
+	void setPriority(LLCurl::EPriority priority);
 	void slist_append(const char* str);
 	void sendRequest(const std::string& url);
 	void requestComplete();
-	void perform();
+	// Note: the callbacks above are called on the curl service thread.
 	bool getResult(CURLcode* result, LLCurl::TransferInfo* info = NULL);
 	std::string getErrorString();
 
 private:
-	CURLMsg* info_read(S32* queue, LLCurl::TransferInfo* info);
-	
-private:
-	LLCurl::Multi* mMulti;
+	LLCurl::Completions* mCompletions;
 	LLCurl::Easy* mEasy;
 	bool mRequestSent;
 	bool mResultReturned;
@@ -0,0 +1,95 @@
+/** 
+ * @file llcurlhostgate.cpp
+ * @brief Admission of queued curl transfers by request class and host.
+ *
+ * $LicenseInfo:firstyear=2010&license=viewergpl$
+ * 
+ * Copyright (c) 2010, Linden Research, Inc.
+ * 
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ * 
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ * 
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ * 
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "llcurlhostgate.h"
+
+LLCurlHostGate::LLCurlHostGate(S32 class_count, S32 max_active)
+	: mMaxPerHost(class_count, 0),
+	  mHostActive(class_count),
+	  mActiveCount(0),
+	  mMaxActive(max_active)
+{
+}
+
+void LLCurlHostGate::setMaxPerHost(S32 request_class, U32 max_per_host)
+{
+	mMaxPerHost[request_class] = max_per_host;
+}
+
+bool LLCurlHostGate::canStart(S32 request_class, const std::string& host) const
+{
+	U32 max_per_host = mMaxPerHost[request_class];
+	if (!max_per_host)
+	{
+		return true;
+	}
+	if (mActiveCount >= mMaxActive)
+	{
+		return false;
+	}
+	return getActiveCount(request_class, host) < max_per_host;
+}
+
+void LLCurlHostGate::started(S32 request_class, const std::string& host)
+{
+	if (mMaxPerHost[request_class])
+	{
+		++mActiveCount;
+		++mHostActive[request_class][host];
+	}
+}
+
+void LLCurlHostGate::finished(S32 request_class, const std::string& host)
+{
+	if (mMaxPerHost[request_class])
+	{
+		host_count_map_t& host_active = mHostActive[request_class];
+		host_count_map_t::iterator iter = host_active.find(host);
+		if (iter != host_active.end())
+		{
+			--mActiveCount;
+			if (--iter->second == 0)
+			{
+				host_active.erase(iter);
+			}
+		}
+	}
+}
+
+U32 LLCurlHostGate::getActiveCount(S32 request_class, const std::string& host) const
+{
+	const host_count_map_t& host_active = mHostActive[request_class];
+	host_count_map_t::const_iterator iter = host_active.find(host);
+	return iter == host_active.end() ? 0 : iter->second;
+}
@@ -0,0 +1,99 @@
+/** 
+ * @file llcurlhostgate.h
+ * @brief Admission of queued curl transfers by request class and host.
+ *
+ * $LicenseInfo:firstyear=2010&license=viewergpl$
+ * 
+ * Copyright (c) 2010, Linden Research, Inc.
+ * 
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ * 
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ * 
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ * 
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLCURLHOSTGATE_H
+#define LL_LLCURLHOSTGATE_H
+
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+// Decides which queued transfers get a connection.  Each request class
+// has its own limit of connections to any one host; classes are served
+// in order, and requests of one class first come, first served.
+// A class without a limit is neither held back nor counted.
+//
+// Holds no lock: LLCurl::Service calls it under its own mutex.
+class LLCurlHostGate
+{
+public:
+	LLCurlHostGate(S32 class_count, S32 max_active);
+
+	// 0 means no limit.
+	void setMaxPerHost(S32 request_class, U32 max_per_host);
+	U32 getMaxPerHost(S32 request_class) const { return mMaxPerHost[request_class]; }
+
+	bool canStart(S32 request_class, const std::string& host) const;
+	void started(S32 request_class, const std::string& host);
+	void finished(S32 request_class, const std::string& host);
+
+	// Counted transfers, all classes and hosts together.
+	S32 getActiveCount() const { return mActiveCount; }
+	U32 getActiveCount(S32 request_class, const std::string& host) const;
+
+	// Takes out of queues[0 .. class_count) whatever may start now and
+	// hands it to start(request).  T provides getHost().
+	template<class T, class F>
+	bool startReady(std::deque<T*>* queues, F& start)
+	{
+		bool started_any = false;
+		for (S32 request_class = 0; request_class < (S32)mMaxPerHost.size(); ++request_class)
+		{
+			std::deque<T*>& queue = queues[request_class];
+			for (typename std::deque<T*>::iterator iter = queue.begin(); iter != queue.end(); )
+			{
+				T* request = *iter;
+				if (!canStart(request_class, request->getHost()))
+				{
+					++iter;
+					continue;
+				}
+				iter = queue.erase(iter);
+				started(request_class, request->getHost());
+				start(request);
+				started_any = true;
+			}
+		}
+		return started_any;
+	}
+
+private:
+	typedef std::map<std::string, U32> host_count_map_t;
+
+	std::vector<U32> mMaxPerHost;
+	std::vector<host_count_map_t> mHostActive;
+	S32 mActiveCount;
+	S32 mMaxActive;
+};
+
+#endif // LL_LLCURLHOSTGATE_H
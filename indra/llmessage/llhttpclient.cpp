@@ -265,6 +265,7 @@ static void request(
 	if (responder)
 	{
 		responder->setURL(url);
+		req->setPriority(responder->getPriority());
 	}
 
 	req->setCallback(new LLHTTPClientURLAdaptor(responder));
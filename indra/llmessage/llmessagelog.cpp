@@ -1,6 +1,12 @@
 // <edit>
+#include "linden_common.h"
 #include "llmessagelog.h"
 
+LLMessageLogEntry::LLMessageLogEntry()
+:	mType(TEMPLATE),
+	mDataSize(0)
+{
+}
 LLMessageLogEntry::LLMessageLogEntry(EType type, LLHost from_host, LLHost to_host, U8* data, S32 data_size)
 :	mType(type),
 	mFromHost(from_host),
@@ -24,31 +30,141 @@ LLMessageLogEntry::LLMessageLogEntry(EType type, LLHost from_host, LLHost to_hos
 LLMessageLogEntry::~LLMessageLogEntry()
 {
 }
-U32 LLMessageLog::sMaxSize = 4096; // testzone fixme todo boom
-std::deque<LLMessageLogEntry> LLMessageLog::sDeque;
-void (*(LLMessageLog::sCallback))(LLMessageLogEntry);
-void LLMessageLog::setMaxSize(U32 size)
+
+namespace
 {
-	sMaxSize = size;
-	while(sDeque.size() > sMaxSize)
-		sDeque.pop_front();
+	const U32 DEFAULT_LOG_SIZE = 4 * 1024 * 1024;
+	// Set in the length of the filler at the end of the buffer, when the
+	// next entry doesn't fit in before it.
+	const U32 PAD_FLAG = 0x80000000;
+
+	struct RecordHeader
+	{
+		U32 mLength;		// Of the whole record, a multiple of 4.
+		U32 mFromIP;
+		U32 mToIP;
+		U16 mFromPort;
+		U16 mToPort;
+		U32 mDataSize;
+	};
+
+	U32 record_length(S32 data_size)
+	{
+		return (sizeof(RecordHeader) + data_size + 3) & ~3;
+	}
 }
-void LLMessageLog::setCallback(void (*callback)(LLMessageLogEntry))
+
+U8* LLMessageLog::sBuffer = NULL;
+U32 LLMessageLog::sSize = 0;
+volatile apr_uint32_t LLMessageLog::sHead = 0;
+volatile apr_uint32_t LLMessageLog::sTail = 0;
+
+void LLMessageLog::setMaxSize(U32 size)
 {
-	sCallback = callback;
+	U32 pow2 = 4096;
+	while(pow2 < size && pow2 < PAD_FLAG)
+		pow2 <<= 1;
+	// Start past everything a reader may still have a cursor at.
+	U32 head = sBuffer ? getHead() + sSize + pow2 : 0;
+	delete[] sBuffer;
+	sBuffer = new U8[pow2];
+	sSize = pow2;
+	apr_atomic_xchg32(&sTail, head);
+	apr_atomic_xchg32(&sHead, head);
 }
 void LLMessageLog::log(LLHost from_host, LLHost to_host, U8* data, S32 data_size)
 {
-	LLMessageLogEntry entry = LLMessageLogEntry(LLMessageLogEntry::TEMPLATE, from_host, to_host, data, data_size);
-	if(!entry.mDataSize || !entry.mData.size()) return;
-	if(sCallback) sCallback(entry);
-	if(!sMaxSize) return;
-	sDeque.push_back(entry);
-	if(sDeque.size() > sMaxSize)
-		sDeque.pop_front();
+	if(!data || data_size <= 0) return;
+	if(!sBuffer) setMaxSize(DEFAULT_LOG_SIZE);
+	U32 length = record_length(data_size);
+	if(length > sSize / 4) return;
+
+	// Only this thread writes head and tail, no need for barriers to read them.
+	U32 head = sHead;
+	U32 tail = sTail;
+	U32 pos = head & (sSize - 1);
+	U32 pad = (sSize - pos < length) ? sSize - pos : 0;
+
+	// Drop the oldest entries to make room, and say so before overwriting them.
+	U32 end = head + pad + length;
+	if(end - tail > sSize)
+	{
+		do
+		{
+			U32 tail_length;
+			memcpy(&tail_length, sBuffer + (tail & (sSize - 1)), sizeof(U32));	/* Flawfinder: ignore */
+			tail += tail_length & ~PAD_FLAG;
+		}
+		while(end - tail > sSize);
+		apr_atomic_xchg32(&sTail, tail);
+	}
+
+	if(pad)
+	{
+		U32 filler = pad | PAD_FLAG;
+		memcpy(sBuffer + pos, &filler, sizeof(U32));	/* Flawfinder: ignore */
+		pos = 0;
+	}
+	RecordHeader header;
+	header.mLength = length;
+	header.mFromIP = from_host.getAddress();
+	header.mToIP = to_host.getAddress();
+	header.mFromPort = (U16)from_host.getPort();
+	header.mToPort = (U16)to_host.getPort();
+	header.mDataSize = data_size;
+	memcpy(sBuffer + pos, &header, sizeof(RecordHeader));	/* Flawfinder: ignore */
+	memcpy(sBuffer + pos + sizeof(RecordHeader), data, data_size);	/* Flawfinder: ignore */
+	apr_atomic_xchg32(&sHead, end);		// Publishes the entry.
 }
-std::deque<LLMessageLogEntry> LLMessageLog::getDeque()
+LLMessageLog::EReadResult LLMessageLog::read(U32& cursor, LLMessageLogEntry& entry)
 {
-	return sDeque;
+	while(true)
+	{
+		U32 tail = getTail();
+		if((S32)(cursor - tail) < 0)
+		{
+			cursor = tail;
+			return READ_LOST;
+		}
+		if(cursor == getHead())
+			return READ_END;
+
+		// Copy first, then check the writer hasn't been here meanwhile.
+		U32 pos = cursor & (sSize - 1);
+		RecordHeader header;
+		memcpy(&header.mLength, sBuffer + pos, sizeof(U32));	/* Flawfinder: ignore */
+		bool pad = (header.mLength & PAD_FLAG) != 0;
+		U32 length = header.mLength & ~PAD_FLAG;
+		bool valid = length >= sizeof(U32) && length <= sSize - pos;
+		if(valid && !pad)
+		{
+			memcpy(&header, sBuffer + pos, sizeof(RecordHeader));	/* Flawfinder: ignore */
+			valid = header.mLength == length && header.mDataSize && record_length(header.mDataSize) == length;
+			if(valid)
+			{
+				entry.mType = LLMessageLogEntry::TEMPLATE;
+				entry.mFromHost.set(header.mFromIP, header.mFromPort);
+				entry.mToHost.set(header.mToIP, header.mToPort);
+				entry.mDataSize = header.mDataSize;
+				entry.mData.resize(header.mDataSize);
+				memcpy(&(entry.mData[0]), sBuffer + pos + sizeof(RecordHeader), header.mDataSize);	/* Flawfinder: ignore */
+			}
+		}
+		if((S32)(cursor - getTail()) < 0)
+		{
+			// Overwritten while we were reading.
+			cursor = getTail();
+			return READ_LOST;
+		}
+		if(!valid)
+		{
+			llwarns << "Bad message log entry at " << cursor << llendl;
+			cursor = getHead();
+			return READ_LOST;
+		}
+		cursor += length;
+		if(!pad)
+			return READ_OK;
+	}
 }
 // </edit>
@@ -3,8 +3,9 @@
 #define LL_LLMESSAGELOG_H
 #include "stdtypes.h"
 #include "llhost.h"
-#include <queue>
+#include <vector>
 #include <string.h>
+#include "apr_atomic.h"
 
 class LLMessageSystem;
 class LLMessageLogEntry
@@ -16,6 +17,7 @@ public:
 		HTTP_REQUEST,
 		HTTP_RESPONSE
 	};
+	LLMessageLogEntry();
 	LLMessageLogEntry(EType type, LLHost from_host, LLHost to_host, U8* data, S32 data_size);
 	LLMessageLogEntry(EType type, LLHost from_host, LLHost to_host, std::vector<U8> data, S32 data_size);
 	~LLMessageLogEntry();
@@ -25,17 +27,46 @@ public:
 	S32 mDataSize;
 	std::vector<U8> mData;
 };
+
+//
+// Every packet in and out goes into a preallocated byte ring, the oldest
+// being overwritten as it fills up.  Logging copies the packet and moves
+// a counter, it takes no lock and allocates nothing; it must only be done
+// from one thread (the main thread, which runs the message system).
+//
+// Readers, on any thread, keep a cursor: a byte position in the log that
+// only ever grows (modulo 2^32).  An entry that is overwritten while it is
+// being read is reported as lost rather than handed out torn.
+//
 class LLMessageLog
 {
 public:
+	enum EReadResult
+	{
+		READ_OK,
+		READ_END,	// Caught up with the writer.
+		READ_LOST	// The entry was overwritten, the cursor now points to the oldest one.
+	};
+
+	// Bytes of log, rounded up to a power of two.  Forgets everything logged
+	// so far, so only call it when nothing is reading the log.
 	static void setMaxSize(U32 size);
-	static void setCallback(void (*callback)(LLMessageLogEntry));
 	static void log(LLHost from_host, LLHost to_host, U8* data, S32 data_size);
-	static std::deque<LLMessageLogEntry> getDeque();
+
+	// Position of the next entry to be logged.
+	static U32 getHead()		{ return load(&sHead); }
+	// Position of the oldest entry still in the log.
+	static U32 getTail()		{ return load(&sTail); }
+	// Copies the entry at cursor and moves cursor past it.
+	static EReadResult read(U32& cursor, LLMessageLogEntry& entry);
+
 private:
-	static U32 sMaxSize;
-	static void (*sCallback)(LLMessageLogEntry);
-	static std::deque<LLMessageLogEntry> sDeque;
+	static U32 load(volatile apr_uint32_t* value) { return apr_atomic_cas32(value, 0, 0); }
+
+	static U8* sBuffer;
+	static U32 sSize;
+	static volatile apr_uint32_t sHead;
+	static volatile apr_uint32_t sTail;
 };
 #endif
 // </edit>
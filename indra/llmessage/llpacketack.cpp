@@ -43,14 +43,71 @@
 
 #include "message.h"
 
-LLReliablePacket::LLReliablePacket(
+// Enough to cover the unacked packets of a few busy circuits.
+const U32 RELIABLE_PACKET_POOL_SIZE = 512;
+
+LLReliablePacket::packet_list_t LLReliablePacket::sFreeList;
+
+//static
+LLReliablePacket* LLReliablePacket::create(
 	S32 socket,
 	U8* buf_ptr,
 	S32 buf_len,
-	LLReliablePacketParams* params) :
+	LLReliablePacketParams* params)
+{
+	LLReliablePacket* packet;
+	if (sFreeList.empty())
+	{
+		packet = new LLReliablePacket;
+	}
+	else
+	{
+		packet = sFreeList.back();
+		sFreeList.pop_back();
+	}
+	packet->init(socket, buf_ptr, buf_len, params);
+	return packet;
+}
+
+//static
+void LLReliablePacket::destroy(LLReliablePacket* packet)
+{
+	if (sFreeList.size() < RELIABLE_PACKET_POOL_SIZE)
+	{
+		packet->mCallback = NULL;
+		packet->mBufferLength = 0;
+		sFreeList.push_back(packet);
+	}
+	else
+	{
+		delete packet;
+	}
+}
+
+//static
+void LLReliablePacket::cleanupClass()
+{
+	for (packet_list_t::iterator it = sFreeList.begin(); it != sFreeList.end(); ++it)
+	{
+		delete *it;
+	}
+	sFreeList.clear();
+}
+
+LLReliablePacket::LLReliablePacket() :
 	mBuffer(NULL),
-	mBufferLength(0)
+	mBufferLength(0),
+	mBufferSize(0)
+{
+}
+
+void LLReliablePacket::init(
+	S32 socket,
+	U8* buf_ptr,
+	S32 buf_len,
+	LLReliablePacketParams* params)
 {
+	mBufferLength = 0;
 	if (params)
 	{
 		mHost = params->mHost;
@@ -63,6 +120,7 @@ LLReliablePacket::LLReliablePacket(
 	}
 	else
 	{
+		mHost.invalidate();
 		mRetries = 0;
 		mPingBasedRetry = TRUE;
 		mTimeout = 0.f;
@@ -77,12 +135,14 @@ LLReliablePacket::LLReliablePacket(
 	mSocket = socket;
 	if (mRetries)
 	{
-		mBuffer = new U8[buf_len];
-		if (mBuffer != NULL)
+		if (mBufferSize < buf_len)
 		{
-			memcpy(mBuffer,buf_ptr,buf_len);	/*Flawfinder: ignore*/
-			mBufferLength = buf_len;
+			// Keep the old buffer if it is big enough, most packets are about the same size.
+			delete [] mBuffer;
+			mBuffer = new U8[buf_len];
+			mBufferSize = buf_len;
 		}
-			
+		memcpy(mBuffer,buf_ptr,buf_len);	/*Flawfinder: ignore*/
+		mBufferLength = buf_len;
 	}
 }
@@ -33,6 +33,8 @@
 #ifndef LL_LLPACKETACK_H
 #define LL_LLPACKETACK_H
 
+#include <vector>
+
 #include "llhost.h"
 
 class LLReliablePacketParams
@@ -86,11 +88,19 @@ public:
 class LLReliablePacket
 {
 public:
-	LLReliablePacket(
+	// Reliable packets are recycled through a free list, so that a busy
+	// circuit does not allocate a packet and a buffer for every message.
+	static LLReliablePacket* create(
 		S32 socket,
 		U8* buf_ptr,
 		S32 buf_len,
 		LLReliablePacketParams* params);
+	static void destroy(LLReliablePacket* packet);
+	static void cleanupClass();
+
+	friend class LLCircuitData;
+protected:
+	LLReliablePacket();
 	~LLReliablePacket()
 	{ 
 		mCallback = NULL;
@@ -98,8 +108,12 @@ public:
 		mBuffer = NULL;
 	};
 
-	friend class LLCircuitData;
-protected:
+	void init(
+		S32 socket,
+		U8* buf_ptr,
+		S32 buf_len,
+		LLReliablePacketParams* params);
+
 	S32 mSocket;
 	LLHost mHost;
 	S32 mRetries;
@@ -111,10 +125,14 @@ protected:
 
 	U8* mBuffer;
 	S32 mBufferLength;
+	S32 mBufferSize;		// allocated size of mBuffer, may be more than mBufferLength
 
 	TPACKETID mPacketID;
 
 	F64 mExpirationTime;
+
+	typedef std::vector<LLReliablePacket*> packet_list_t;
+	static packet_list_t sFreeList;
 };
 
 #endif
@@ -0,0 +1,310 @@
+/**
+ * @file llpacketcapture.cpp
+ * @brief Recording incoming UDP traffic to a file and replaying it.
+ *
+ * $LicenseInfo:firstyear=2001&license=viewergpl$
+ *
+ * Copyright (c) 2001-2009, Linden Research, Inc.
+ *
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ *
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ *
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ *
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "llpacketcapture.h"
+
+static const char CAPTURE_MAGIC[8] = { 'L', 'L', 'P', 'K', 'T', 'C', 'A', 'P' };
+static const U32 CAPTURE_VERSION = 1;
+static const S32 HEADER_SIZE = 16;
+static const S32 RECORD_HEADER_SIZE = 20;
+static const S32 REGION_DATA_SIZE = 12;
+
+static void put_u16(U8* p, U16 value)
+{
+	p[0] = (U8)value;
+	p[1] = (U8)(value >> 8);
+}
+
+static void put_u32(U8* p, U32 value)
+{
+	put_u16(p, (U16)value);
+	put_u16(p + 2, (U16)(value >> 16));
+}
+
+static void put_u64(U8* p, U64 value)
+{
+	put_u32(p, (U32)value);
+	put_u32(p + 4, (U32)(value >> 32));
+}
+
+static U16 get_u16(const U8* p)
+{
+	return (U16)(p[0] | (p[1] << 8));
+}
+
+static U32 get_u32(const U8* p)
+{
+	return (U32)get_u16(p) | ((U32)get_u16(p + 2) << 16);
+}
+
+static U64 get_u64(const U8* p)
+{
+	return (U64)get_u32(p) | ((U64)get_u32(p + 4) << 32);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// LLPacketCaptureWriter
+
+LLPacketCaptureWriter::LLPacketCaptureWriter()
+	: mFile(NULL), mStartTime(0), mPacketCount(0)
+{
+}
+
+LLPacketCaptureWriter::~LLPacketCaptureWriter()
+{
+	close();
+}
+
+bool LLPacketCaptureWriter::open(const std::string& filename)
+{
+	close();
+	mFile = LLFile::fopen(filename, "wb");	/* Flawfinder: ignore */
+	if (!mFile)
+	{
+		llwarns << "Unable to open packet capture file " << filename << llendl;
+		return false;
+	}
+
+	U8 header[HEADER_SIZE];
+	memcpy(header, CAPTURE_MAGIC, sizeof(CAPTURE_MAGIC));	/* Flawfinder: ignore */
+	put_u32(header + 8, CAPTURE_VERSION);
+	put_u32(header + 12, 0);
+	if (fwrite(header, HEADER_SIZE, 1, mFile) != 1)
+	{
+		llwarns << "Unable to write packet capture file " << filename << llendl;
+		close();
+		return false;
+	}
+
+	mStartTime = totalTime();
+	mPacketCount = 0;
+	llinfos << "Capturing incoming packets to " << filename << llendl;
+	return true;
+}
+
+void LLPacketCaptureWriter::close()
+{
+	if (mFile)
+	{
+		fclose(mFile);
+		mFile = NULL;
+		llinfos << "Packet capture closed after " << mPacketCount << " packets" << llendl;
+	}
+}
+
+void LLPacketCaptureWriter::writePacket(const LLHost& sender, const U8* data, S32 size)
+{
+	writeRecord(LLPacketCaptureReader::RECORD_PACKET, sender, data, size);
+	mPacketCount++;
+}
+
+void LLPacketCaptureWriter::writeRegion(const LLHost& host, U64 handle, U32 width)
+{
+	U8 data[REGION_DATA_SIZE];
+	put_u64(data, handle);
+	put_u32(data + 8, width);
+	writeRecord(LLPacketCaptureReader::RECORD_REGION, host, data, REGION_DATA_SIZE);
+}
+
+void LLPacketCaptureWriter::writeRecord(U8 type, const LLHost& host, const U8* data, S32 size)
+{
+	if (!mFile || size < 0 || size > NET_BUFFER_SIZE)
+	{
+		return;
+	}
+
+	U8 header[RECORD_HEADER_SIZE];
+	put_u64(header, totalTime() - mStartTime);
+	put_u32(header + 8, host.getAddress());
+	put_u16(header + 12, (U16)host.getPort());
+	put_u16(header + 14, (U16)size);
+	header[16] = type;
+	header[17] = header[18] = header[19] = 0;
+
+	if (fwrite(header, RECORD_HEADER_SIZE, 1, mFile) != 1 ||
+		(size && fwrite(data, size, 1, mFile) != 1))
+	{
+		llwarns << "Packet capture write failed, stopping capture" << llendl;
+		close();
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// LLPacketCaptureReader
+
+LLPacketCaptureReader::LLPacketCaptureReader()
+	: mFile(NULL), mType(RECORD_PACKET), mTime(0), mSize(0)
+{
+}
+
+LLPacketCaptureReader::~LLPacketCaptureReader()
+{
+	close();
+}
+
+bool LLPacketCaptureReader::open(const std::string& filename)
+{
+	close();
+	mFile = LLFile::fopen(filename, "rb");	/* Flawfinder: ignore */
+	if (!mFile)
+	{
+		llwarns << "Unable to open packet capture file " << filename << llendl;
+		return false;
+	}
+
+	U8 header[HEADER_SIZE];
+	if (fread(header, HEADER_SIZE, 1, mFile) != 1 ||
+		memcmp(header, CAPTURE_MAGIC, sizeof(CAPTURE_MAGIC)) ||
+		get_u32(header + 8) != CAPTURE_VERSION)
+	{
+		llwarns << filename << " is not a packet capture file this viewer can read" << llendl;
+		close();
+		return false;
+	}
+	return true;
+}
+
+void LLPacketCaptureReader::close()
+{
+	if (mFile)
+	{
+		fclose(mFile);
+		mFile = NULL;
+	}
+}
+
+bool LLPacketCaptureReader::next()
+{
+	if (!mFile)
+	{
+		return false;
+	}
+
+	U8 header[RECORD_HEADER_SIZE];
+	if (fread(header, RECORD_HEADER_SIZE, 1, mFile) != 1)
+	{
+		return false;
+	}
+	mTime = get_u64(header);
+	mHost.set(get_u32(header + 8), get_u16(header + 12));
+	mSize = get_u16(header + 14);
+	mType = header[16];
+	if (mSize > NET_BUFFER_SIZE ||
+		(mSize && fread(mData, mSize, 1, mFile) != 1))
+	{
+		llwarns << "Packet capture ends with a truncated or bad record" << llendl;
+		return false;
+	}
+	return true;
+}
+
+U64 LLPacketCaptureReader::getRegionHandle() const
+{
+	return (mType == RECORD_REGION && mSize >= REGION_DATA_SIZE) ? get_u64(mData) : 0;
+}
+
+U32 LLPacketCaptureReader::getRegionWidth() const
+{
+	return (mType == RECORD_REGION && mSize >= REGION_DATA_SIZE) ? get_u32(mData + 8) : 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// LLPacketReplay
+
+LLPacketReplay::LLPacketReplay(bool realtime)
+	: mRegionCallback(NULL),
+	  mRealtime(realtime),
+	  mStarted(false),
+	  mHavePending(false),
+	  mDone(false),
+	  mStartTime(0),
+	  mPacketCount(0)
+{
+}
+
+bool LLPacketReplay::open(const std::string& filename)
+{
+	mDone = !mReader.open(filename);
+	return !mDone;
+}
+
+S32 LLPacketReplay::receivePacket(char* datap, LLHost& sender)
+{
+	if (!mStarted)
+	{
+		// The clock starts when the message system first asks.
+		mStarted = true;
+		mStartTime = totalTime();
+	}
+
+	while (!mDone)
+	{
+		if (!mHavePending)
+		{
+			if (!mReader.next())
+			{
+				mDone = true;
+				llinfos << "Packet replay done, " << mPacketCount << " packets" << llendl;
+				break;
+			}
+			mHavePending = true;
+		}
+
+		if (mRealtime && mReader.getTime() > totalTime() - mStartTime)
+		{
+			// Not due yet.
+			break;
+		}
+		mHavePending = false;
+
+		if (mReader.getType() == LLPacketCaptureReader::RECORD_REGION)
+		{
+			if (mRegionCallback)
+			{
+				mRegionCallback(mReader.getHost(), mReader.getRegionHandle(), mReader.getRegionWidth());
+			}
+			continue;
+		}
+		if (mReader.getType() != LLPacketCaptureReader::RECORD_PACKET || !mReader.getSize())
+		{
+			continue;
+		}
+
+		memcpy(datap, mReader.getData(), mReader.getSize());	/* Flawfinder: ignore */
+		sender = mReader.getHost();
+		mPacketCount++;
+		return mReader.getSize();
+	}
+	return 0;
+}
@@ -0,0 +1,152 @@
+/**
+ * @file llpacketcapture.h
+ * @brief Recording incoming UDP traffic to a file and replaying it.
+ *
+ * $LicenseInfo:firstyear=2001&license=viewergpl$
+ *
+ * Copyright (c) 2001-2009, Linden Research, Inc.
+ *
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ *
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ *
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ *
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLPACKETCAPTURE_H
+#define LL_LLPACKETCAPTURE_H
+
+#include "llhost.h"
+#include "llfile.h"
+#include "lltimer.h"
+#include "net.h"		// for NET_BUFFER_SIZE
+
+//
+// Capture file format, all numbers little endian:
+//
+//   header:  "LLPKTCAP" U32 version U32 flags
+//   record:  U64 time (usec since the capture started)
+//            U32 ip  U16 port  U16 size  U8 type  U8[3] padding
+//            U8[size] data
+//
+// Packet records hold a datagram exactly as it came off the socket
+// (appended acks, zero coding and all).  Region records tell a replay
+// which simulator is behind a host, so that the world can be set up
+// before its traffic comes in: their data is U64 region handle, U32 width.
+//
+
+class LLPacketCaptureWriter
+{
+public:
+	LLPacketCaptureWriter();
+	~LLPacketCaptureWriter();
+
+	bool open(const std::string& filename);
+	void close();
+	bool isOpen() const						{ return mFile != NULL; }
+
+	void writePacket(const LLHost& sender, const U8* data, S32 size);
+	void writeRegion(const LLHost& host, U64 handle, U32 width);
+
+	U32 getPacketCount() const				{ return mPacketCount; }
+
+private:
+	void writeRecord(U8 type, const LLHost& host, const U8* data, S32 size);
+
+	LLFILE* mFile;
+	U64 mStartTime;
+	U32 mPacketCount;
+};
+
+class LLPacketCaptureReader
+{
+public:
+	enum ERecordType
+	{
+		RECORD_PACKET = 0,
+		RECORD_REGION = 1
+	};
+
+	LLPacketCaptureReader();
+	~LLPacketCaptureReader();
+
+	bool open(const std::string& filename);
+	void close();
+
+	// Reads the next record, returns false at the end of the file (or
+	// when it is cut short, as a capture of a crashed session would be).
+	bool next();
+
+	U8 getType() const						{ return mType; }
+	U64 getTime() const						{ return mTime; }
+	const LLHost& getHost() const			{ return mHost; }
+	const U8* getData() const				{ return mData; }
+	S32 getSize() const						{ return mSize; }
+
+	// For region records.
+	U64 getRegionHandle() const;
+	U32 getRegionWidth() const;
+
+private:
+	LLFILE* mFile;
+	U8 mType;
+	U64 mTime;
+	LLHost mHost;
+	U8 mData[NET_BUFFER_SIZE];
+	S32 mSize;
+};
+
+//
+// Hands out the packets of a capture in place of the socket, either at
+// the pace they were recorded at or as fast as they are asked for.
+//
+class LLPacketReplay
+{
+public:
+	typedef void (*region_callback_t)(const LLHost& host, U64 handle, U32 width);
+
+	LLPacketReplay(bool realtime);
+
+	bool open(const std::string& filename);
+
+	// Called for every region record, as it is reached.
+	void setRegionCallback(region_callback_t callback)	{ mRegionCallback = callback; }
+
+	// Copies the next packet that is due into datap and returns its size,
+	// or returns 0 if none is (yet).
+	S32 receivePacket(char* datap, LLHost& sender);
+
+	bool isDone() const						{ return mDone; }
+	U32 getPacketCount() const				{ return mPacketCount; }
+	// Length of the recorded session so far, in seconds.
+	F64 getCaptureTime() const				{ return (F64)mReader.getTime() * SEC_PER_USEC; }
+
+private:
+	LLPacketCaptureReader mReader;
+	region_callback_t mRegionCallback;
+	bool mRealtime;
+	bool mStarted;
+	bool mHavePending;
+	bool mDone;
+	U64 mStartTime;
+	U32 mPacketCount;
+};
+
+#endif // LL_LLPACKETCAPTURE_H
@@ -0,0 +1,314 @@
+/**
+ * @file llpacketidwindow.h
+ * @brief Sliding window of per packet data indexed by packet id
+ *
+ * $LicenseInfo:firstyear=2001&license=viewergpl$
+ *
+ * Copyright (c) 2001-2009, Linden Research, Inc.
+ *
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ *
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ *
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ *
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLPACKETIDWINDOW_H
+#define LL_LLPACKETIDWINDOW_H
+
+#include <vector>
+
+#include "stdtypes.h"
+
+const TPACKETID LL_MAX_OUT_PACKET_ID = 0x01000000;
+
+// Packet ids are 24 bit sequence numbers that wrap around.
+const TPACKETID LL_PACKET_ID_MASK = LL_MAX_OUT_PACKET_ID - 1;
+const U32 LL_PACKET_ID_HALF_RANGE = LL_MAX_OUT_PACKET_ID / 2;
+
+//
+// Per packet data for the packet ids in a sliding window.
+//
+// A circuit only ever has to remember a run of recent packet ids, so this
+// is a ring buffer indexed by the low bits of the id rather than a map.
+// Lookups, inserts and erases are O(1).  The window is kept ordered by
+// sequence (not numeric) order, so it handles wrapping ids, and iterates
+// from the oldest id to the newest.  The ring only grows when the window
+// is wider than it has ever been, so a circuit in steady state does no
+// allocations.
+//
+// If max_span is non-zero the window forgets ids to stay within it: the
+// oldest ones when a newer id arrives, all of them when an id arrives that
+// is too far back.  Without it the window may cover half the id space and
+// set() refuses ids that do not fit.
+//
+template <class T>
+class LLPacketIDWindow
+{
+	struct Slot
+	{
+		Slot() : mID(0), mUsed(FALSE), mValue() {}
+
+		TPACKETID mID;
+		BOOL mUsed;
+		T mValue;
+	};
+
+public:
+	class iterator
+	{
+	public:
+		iterator() : mWindow(NULL), mID(0) {}
+
+		TPACKETID getID() const { return mID; }
+		T& operator*() const { return *mWindow->find(mID); }
+		iterator& operator++() { mWindow->seek(*this, mID + 1); return *this; }
+
+		bool operator==(const iterator& rhs) const { return (mWindow == rhs.mWindow) && (!mWindow || mID == rhs.mID); }
+		bool operator!=(const iterator& rhs) const { return !(*this == rhs); }
+
+		friend class LLPacketIDWindow<T>;
+	private:
+		LLPacketIDWindow<T>* mWindow;
+		TPACKETID mID;
+	};
+
+	LLPacketIDWindow(U32 max_span = 0)
+	:	mMask(0),
+		mBase(0),
+		mSpan(0),
+		mCount(0),
+		mMaxSpan(max_span ? max_span : LL_PACKET_ID_HALF_RANGE),
+		mForget(max_span != 0)
+	{
+	}
+
+	BOOL empty() const		{ return mCount == 0; }
+	S32 size() const		{ return mCount; }
+
+	// The oldest id in the window.  Only valid if not empty.
+	TPACKETID getFrontID() const { return mBase; }
+
+	iterator begin()
+	{
+		iterator it;
+		if (mCount)
+		{
+			it.mWindow = this;
+			it.mID = mBase;
+		}
+		return it;
+	}
+	iterator end() { return iterator(); }
+
+	T* find(TPACKETID id)
+	{
+		if (!mCount || (offset(id) >= mSpan))
+		{
+			return NULL;
+		}
+		Slot& slot = mSlots[id & mMask];
+		return (slot.mUsed && slot.mID == id) ? &slot.mValue : NULL;
+	}
+
+	BOOL contains(TPACKETID id) { return find(id) != NULL; }
+
+	// Adds id to the window, or replaces its value if it is already there.
+	// Returns FALSE if the id does not fit in the window.
+	BOOL set(TPACKETID id, const T& value)
+	{
+		id &= LL_PACKET_ID_MASK;
+		if (!mCount)
+		{
+			mBase = id;
+			mSpan = 0;
+		}
+		U32 off = offset(id);
+		if (off >= LL_PACKET_ID_HALF_RANGE)
+		{
+			// id is older than anything we have, move the front back
+			U32 grow = LL_MAX_OUT_PACKET_ID - off;
+			if (mSpan + grow <= mMaxSpan)
+			{
+				reserve(mSpan + grow);
+				mBase = id;
+				mSpan += grow;
+			}
+			else if (mForget)
+			{
+				clear();
+				mBase = id;
+				reserve(1);
+				mSpan = 1;
+			}
+			else
+			{
+				return FALSE;
+			}
+		}
+		else if (off >= mSpan)
+		{
+			if (!mForget && (off + 1 > mMaxSpan))
+			{
+				return FALSE;
+			}
+			while (mCount && (off + 1 > mMaxSpan))
+			{
+				popFront();
+				off = offset(id);
+			}
+			if (!mCount)
+			{
+				mBase = id;
+				off = 0;
+			}
+			reserve(off + 1);
+			mSpan = off + 1;
+		}
+
+		Slot& slot = mSlots[id & mMask];
+		if (!slot.mUsed)
+		{
+			slot.mUsed = TRUE;
+			slot.mID = id;
+			mCount++;
+		}
+		slot.mValue = value;
+		return TRUE;
+	}
+
+	BOOL erase(TPACKETID id)
+	{
+		if (!find(id))
+		{
+			return FALSE;
+		}
+		Slot& slot = mSlots[id & mMask];
+		slot.mUsed = FALSE;
+		slot.mValue = T();
+		mCount--;
+		trim();
+		return TRUE;
+	}
+
+	// Erases the value the iterator points at, returns the next one.
+	iterator erase(iterator it)
+	{
+		TPACKETID next = it.mID + 1;
+		erase(it.mID);
+		seek(it, next);
+		return it;
+	}
+
+	void popFront()
+	{
+		if (mCount)
+		{
+			erase(mBase);
+		}
+	}
+
+	void clear()
+	{
+		for (typename slot_list_t::iterator it = mSlots.begin(); it != mSlots.end(); ++it)
+		{
+			*it = Slot();
+		}
+		mCount = 0;
+		mSpan = 0;
+	}
+
+private:
+	typedef std::vector<Slot> slot_list_t;
+
+	// Distance of id after the front of the window, in sequence order.
+	U32 offset(TPACKETID id) const { return (id - mBase) & LL_PACKET_ID_MASK; }
+
+	// Points it at the first id in the window at or after id.
+	void seek(iterator& it, TPACKETID id)
+	{
+		id &= LL_PACKET_ID_MASK;
+		U32 off = offset(id);
+		if (off >= LL_PACKET_ID_HALF_RANGE)
+		{
+			// The front moved past id while iterating.
+			off = 0;
+		}
+		for ( ; off < mSpan; off++)
+		{
+			const Slot& slot = mSlots[(mBase + off) & mMask];
+			if (slot.mUsed)
+			{
+				it.mWindow = this;
+				it.mID = slot.mID;
+				return;
+			}
+		}
+		it = iterator();
+	}
+
+	// Drops the unused ids from the front of the window.
+	void trim()
+	{
+		if (!mCount)
+		{
+			mSpan = 0;
+			return;
+		}
+		while (!mSlots[mBase & mMask].mUsed)
+		{
+			mBase = (mBase + 1) & LL_PACKET_ID_MASK;
+			mSpan--;
+		}
+	}
+
+	void reserve(U32 span)
+	{
+		if (span <= mSlots.size())
+		{
+			return;
+		}
+		U32 size = mSlots.empty() ? 16 : (U32)mSlots.size();
+		while (size < span)
+		{
+			size <<= 1;
+		}
+		slot_list_t slots(size);
+		for (typename slot_list_t::iterator it = mSlots.begin(); it != mSlots.end(); ++it)
+		{
+			if (it->mUsed)
+			{
+				slots[it->mID & (size - 1)] = *it;
+			}
+		}
+		mSlots.swap(slots);
+		mMask = size - 1;
+	}
+
+	slot_list_t mSlots;
+	U32 mMask;
+	TPACKETID mBase;
+	U32 mSpan;
+	S32 mCount;
+	U32 mMaxSpan;
+	BOOL mForget;
+};
+
+#endif
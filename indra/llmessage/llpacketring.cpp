@@ -36,6 +36,7 @@
 
 // linden library includes
 #include "llerror.h"
+#include "llpacketcapture.h"
 #include "lltimer.h"
 #include "timing.h"
 #include "llrand.h"
@@ -68,7 +69,9 @@ LLPacketRing::LLPacketRing () :
 	mInBufferLength(0),
 	mOutBufferLength(0),
 	mDropPercentage(0.0f),
-	mPacketsToDrop(0x0)
+	mPacketsToDrop(0x0),
+	mCapture(NULL),
+	mReplay(NULL)
 {
 }
 
@@ -83,6 +86,9 @@ void LLPacketRing::cleanup ()
 {
 	LLPacketBuffer *packetp;
 
+	stopCapture();
+	stopReplay();
+
 	while (!mReceiveQueue.empty())
 	{
 		packetp = mReceiveQueue.front();
@@ -170,6 +176,14 @@ S32 LLPacketRing::receiveFromRing (S32 socket, char *datap)
 S32 LLPacketRing::receivePacket (S32 socket, char *datap)
 {
 	S32 packet_size = 0;
+	char* bufferp = datap;
+
+	if (mReplay)
+	{
+		packet_size = mReplay->receivePacket(datap, mLastSender);
+		mActualBitsIn += packet_size * 8;
+		return packet_size;
+	}
 
 	// If using the throttle, simulate a limited size input buffer.
 	if (mUseInThrottle)
@@ -273,15 +287,63 @@ S32 LLPacketRing::receivePacket (S32 socket, char *datap)
 		}
 	}
 
+	if (packet_size > 0)
+	{
+		//<edit>
+		LLMessageLog::log(mLastSender, LLHost(16777343, gMessageSystem->getListenPort()), (U8*)bufferp, packet_size);
+		//</edit>
+		if (mCapture)
+		{
+			mCapture->writePacket(mLastSender, (U8*)bufferp, packet_size);
+		}
+	}
+
 	return packet_size;
 }
 
+bool LLPacketRing::startCapture(const std::string& filename)
+{
+	stopCapture();
+	mCapture = new LLPacketCaptureWriter;
+	if (!mCapture->open(filename))
+	{
+		stopCapture();
+		return false;
+	}
+	return true;
+}
+
+void LLPacketRing::stopCapture()
+{
+	delete mCapture;
+	mCapture = NULL;
+}
+
+void LLPacketRing::startReplay(LLPacketReplay* replay)
+{
+	stopReplay();
+	mReplay = replay;
+}
+
+void LLPacketRing::stopReplay()
+{
+	delete mReplay;
+	mReplay = NULL;
+}
+
 BOOL LLPacketRing::sendPacket(int h_socket, char * send_buffer, S32 buf_size, LLHost host)
 {
 	//<edit>
 	LLMessageLog::log(LLHost(16777343, gMessageSystem->getListenPort()), host, (U8*)send_buffer, buf_size);
 	//</edit>
 	BOOL status = TRUE;
+
+	if (mReplay)
+	{
+		// Nobody is listening.
+		mActualBitsOut += buf_size * 8;
+		return TRUE;
+	}
 	
 	if (!mUseOutThrottle)
 	{
@@ -41,6 +41,8 @@
 #include "net.h"
 #include "llthrottle.h"
 
+class LLPacketCaptureWriter;
+class LLPacketReplay;
 
 class LLPacketRing
 {
@@ -61,6 +63,18 @@ public:
 
 	BOOL sendPacket(int h_socket, char * send_buffer, S32 buf_size, LLHost host);
 
+	// Writes every packet received from here on to a capture file.
+	bool startCapture(const std::string& filename);
+	void stopCapture();
+	LLPacketCaptureWriter* getCapture()			{ return mCapture; }
+
+	// Takes incoming packets from a capture file instead of the socket,
+	// and drops everything sent.  Takes ownership of replay.
+	void startReplay(LLPacketReplay* replay);
+	void stopReplay();
+	LLPacketReplay* getReplay()					{ return mReplay; }
+	bool isReplaying() const					{ return mReplay != NULL; }
+
 	inline LLHost getLastSender();
 	inline LLHost getLastReceivingInterface();
 
@@ -91,6 +105,9 @@ protected:
 
 	BOOL doSendPacket(int h_socket, const char * send_buffer, S32 buf_size, LLHost host);
 	U8	 mProxyWrappedSendBuffer[NET_BUFFER_SIZE];
+
+	LLPacketCaptureWriter* mCapture;
+	LLPacketReplay* mReplay;
 };
 
 
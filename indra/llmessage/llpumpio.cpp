@@ -62,6 +62,13 @@
 #include <typeinfo>
 #endif
 
+#if LL_LINUX
+#include <errno.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+#include "apr_portable.h"
+#endif
+
 // constants for poll timeout. if we are threading, we want to have a
 // longer poll timeout.
 #if LL_THREADS_APR
@@ -75,6 +82,11 @@ const F32 DEFAULT_CHAIN_EXPIRY_SECS = 30.0f;
 extern const F32 SHORT_CHAIN_EXPIRY_SECS = 1.0f;
 extern const F32 NEVER_CHAIN_EXPIRY_SECS = 0.0f;
 
+// With epoll, how often chains waiting on a descriptor are checked
+// for expiry, and how many ready descriptors are taken per pump.
+static const F32 EPOLL_EXPIRY_SCAN_SECS = 0.25f;
+static const S32 EPOLL_MAX_EVENTS = 256;
+
 // sorta spammy debug modes.
 //#define LL_DEBUG_SPEW_BUFFER_CHANNEL_IN_ON_ERROR 1
 //#define LL_DEBUG_PROCESS_LINK 1
@@ -171,7 +183,7 @@ struct ll_delete_apr_pollset_fd_client_data
 /**
  * LLPumpIO
  */
-LLPumpIO::LLPumpIO(void) :
+LLPumpIO::LLPumpIO(EPollMode mode) :
 	mState(LLPumpIO::NORMAL),
 	mRebuildPollset(false),
 	mPollset(NULL),
@@ -180,12 +192,24 @@ LLPumpIO::LLPumpIO(void) :
 	mCurrentPoolReallocCount(0),
 	mChainsMutex(NULL),
 	mCallbackMutex(NULL),
-	mCurrentChain(mRunningChains.end())
+	mCurrentChain(mRunningChains.end()),
+	mEpollFD(-1)
 {
 	mCurrentChain = mRunningChains.end();
 
 	LLMemType m1(LLMemType::MTYPE_IO_PUMP);
 	initialize();
+#if LL_LINUX
+	if(POLL_EPOLL == mode)
+	{
+		mEpollFD = epoll_create(EPOLL_MAX_EVENTS);
+		if(mEpollFD < 0)
+		{
+			llwarns << "epoll_create failed, falling back to APR pollset." << llendl;
+		}
+		mExpiryScanTimer.setTimerExpirySec(EPOLL_EXPIRY_SCAN_SECS);
+	}
+#endif
 }
 
 LLPumpIO::~LLPumpIO()
@@ -203,6 +227,13 @@ LLPumpIO::~LLPumpIO()
 		apr_pollset_destroy(mPollset);
 		mPollset = NULL;
 	}
+#if LL_LINUX
+	if(mEpollFD >= 0)
+	{
+		close(mEpollFD);
+		mEpollFD = -1;
+	}
+#endif
 }
 
 bool LLPumpIO::addChain(const chain_t& chain, F32 timeout)
@@ -339,6 +370,10 @@ bool LLPumpIO::setConditional(LLIOPipe* pipe, const apr_pollfd_t* poll)
 		LLChainInfo::pipe_conditional_t& value = (*it);
 		if(pipe_ptr == value.first)
 		{
+			if(mEpollFD >= 0)
+			{
+				removePollDescriptor(value.second);
+			}
 			ll_delete_apr_pollset_fd_client_data()(value);
 			it = (*mCurrentChain).mDescriptors.erase(it);
 			mRebuildPollset = true;
@@ -366,6 +401,10 @@ bool LLPumpIO::setConditional(LLIOPipe* pipe, const apr_pollfd_t* poll)
 	}
 	value.second.client_data = new S32(++mPollsetClientID);
 	(*mCurrentChain).mDescriptors.push_back(value);
+	if(mEpollFD >= 0)
+	{
+		addPollDescriptor(value.second, mCurrentChain);
+	}
 	mRebuildPollset = true;
 	return true;
 }
@@ -504,11 +543,24 @@ void LLPumpIO::pump(const S32& poll_timeout)
 					(*it).mLock = 0;
 				}
 			}
+			for(it = mWaitingChains.begin(); it != mWaitingChains.end(); ++it)
+			{
+				if((*it).mLock && mClearLocks.find((*it).mLock) != not_cleared)
+				{
+					(*it).mLock = 0;
+				}
+			}
 			PUMP_DEBUG;
 			mClearLocks.clear();
 		}
 	}
 
+	if(mEpollFD >= 0)
+	{
+		pumpEpoll(poll_timeout);
+		return;
+	}
+
 	PUMP_DEBUG;
 	// rebuild the pollset if necessary
 	if(mRebuildPollset)
@@ -556,45 +608,10 @@ void LLPumpIO::pump(const S32& poll_timeout)
 	while( run_chain != mRunningChains.end() )
 	{
 		PUMP_DEBUG;
-		if((*run_chain).mInit
-		   && (*run_chain).mTimer.getStarted()
-		   && (*run_chain).mTimer.hasExpired())
+		if(expireChain(*run_chain))
 		{
-			PUMP_DEBUG;
-			if(handleChainError(*run_chain, LLIOPipe::STATUS_EXPIRED))
-			{
-				// the pipe probably handled the error. If the handler
-				// forgot to reset the expiration then we need to do
-				// that here.
-				if((*run_chain).mTimer.getStarted()
-				   && (*run_chain).mTimer.hasExpired())
-				{
-					PUMP_DEBUG;
-					llinfos << "Error handler forgot to reset timeout. "
-							<< "Resetting to " << DEFAULT_CHAIN_EXPIRY_SECS
-							<< " seconds." << llendl;
-					(*run_chain).setTimeoutSeconds(DEFAULT_CHAIN_EXPIRY_SECS);
-				}
-			}
-			else
-			{
-				PUMP_DEBUG;
-				// it timed out and no one handled it, so we need to
-				// retire the chain
-#if LL_DEBUG_PIPE_TYPE_IN_PUMP
-				lldebugs << "Removing chain "
-						<< (*run_chain).mChainLinks[0].mPipe
-						<< " '"
-						<< typeid(*((*run_chain).mChainLinks[0].mPipe)).name()
-						<< "' because it timed out." << llendl;
-#else
-//				lldebugs << "Removing chain "
-//						<< (*run_chain).mChainLinks[0].mPipe
-//						<< " because we reached the end." << llendl;
-#endif
-				run_chain = mRunningChains.erase(run_chain);
-				continue;
-			}
+			run_chain = mRunningChains.erase(run_chain);
+			continue;
 		}
 		PUMP_DEBUG;
 		if((*run_chain).mLock)
@@ -634,37 +651,9 @@ void LLPumpIO::pump(const S32& poll_timeout)
 					client_id = *((S32*)((*it).second.client_data));
 					signal = signalled_client.find(client_id);
 					if (signal == not_signalled) continue;
-					static const apr_int16_t POLL_CHAIN_ERROR =
-						APR_POLLHUP | APR_POLLNVAL | APR_POLLERR;
 					const apr_pollfd_t* poll = &(poll_fd[(*signal).second]);
-					if(poll->rtnevents & POLL_CHAIN_ERROR)
+					if(handlePollError(*run_chain, poll))
 					{
-						// Potential eror condition has been
-						// returned. If HUP was one of them, we pass
-						// that as the error even though there may be
-						// more. If there are in fact more errors,
-						// we'll just wait for that detection until
-						// the next pump() cycle to catch it so that
-						// the logic here gets no more strained than
-						// it already is.
-						LLIOPipe::EStatus error_status;
-						if(poll->rtnevents & APR_POLLHUP)
-							error_status = LLIOPipe::STATUS_LOST_CONNECTION;
-						else
-							error_status = LLIOPipe::STATUS_ERROR;
-						if(handleChainError(*run_chain, error_status)) break;
-						ll_debug_poll_fd("Removing pipe", poll);
-						llwarns << "Removing pipe "
-							<< (*run_chain).mChainLinks[0].mPipe
-							<< " '"
-#if LL_DEBUG_PIPE_TYPE_IN_PUMP
-							<< typeid(
-								*((*run_chain).mChainLinks[0].mPipe)).name()
-#endif
-							<< "' because: "
-							<< events_2_string(poll->rtnevents)
-							<< llendl;
-						(*run_chain).mHead = (*run_chain).mChainLinks.end();
 						break;
 					}
 
@@ -890,6 +879,377 @@ void LLPumpIO::rebuildPollset()
 	}
 }
 
+bool LLPumpIO::expireChain(LLChainInfo& chain)
+{
+	if(!chain.mInit
+	   || !chain.mTimer.getStarted()
+	   || !chain.mTimer.hasExpired())
+	{
+		return false;
+	}
+	PUMP_DEBUG;
+	if(handleChainError(chain, LLIOPipe::STATUS_EXPIRED))
+	{
+		// the pipe probably handled the error. If the handler
+		// forgot to reset the expiration then we need to do
+		// that here.
+		if(chain.mTimer.getStarted() && chain.mTimer.hasExpired())
+		{
+			PUMP_DEBUG;
+			llinfos << "Error handler forgot to reset timeout. "
+					<< "Resetting to " << DEFAULT_CHAIN_EXPIRY_SECS
+					<< " seconds." << llendl;
+			chain.setTimeoutSeconds(DEFAULT_CHAIN_EXPIRY_SECS);
+		}
+		return false;
+	}
+	PUMP_DEBUG;
+	// it timed out and no one handled it, so we need to
+	// retire the chain
+#if LL_DEBUG_PIPE_TYPE_IN_PUMP
+	lldebugs << "Removing chain "
+			<< chain.mChainLinks[0].mPipe
+			<< " '"
+			<< typeid(*(chain.mChainLinks[0].mPipe)).name()
+			<< "' because it timed out." << llendl;
+#else
+//	lldebugs << "Removing chain "
+//			<< chain.mChainLinks[0].mPipe
+//			<< " because we reached the end." << llendl;
+#endif
+	return true;
+}
+
+bool LLPumpIO::handlePollError(LLChainInfo& chain, const apr_pollfd_t* poll)
+{
+	static const apr_int16_t POLL_CHAIN_ERROR =
+		APR_POLLHUP | APR_POLLNVAL | APR_POLLERR;
+	if(!(poll->rtnevents & POLL_CHAIN_ERROR))
+	{
+		return false;
+	}
+
+	// Potential eror condition has been returned. If HUP was one of
+	// them, we pass that as the error even though there may be
+	// more. If there are in fact more errors, we'll just wait for
+	// that detection until the next pump() cycle to catch it so that
+	// the logic here gets no more strained than it already is.
+	LLIOPipe::EStatus error_status;
+	if(poll->rtnevents & APR_POLLHUP)
+		error_status = LLIOPipe::STATUS_LOST_CONNECTION;
+	else
+		error_status = LLIOPipe::STATUS_ERROR;
+	if(handleChainError(chain, error_status)) return true;
+	ll_debug_poll_fd("Removing pipe", poll);
+	llwarns << "Removing pipe "
+		<< chain.mChainLinks[0].mPipe
+		<< " '"
+#if LL_DEBUG_PIPE_TYPE_IN_PUMP
+		<< typeid(*(chain.mChainLinks[0].mPipe)).name()
+#endif
+		<< "' because: "
+		<< events_2_string(poll->rtnevents)
+		<< llendl;
+	chain.mHead = chain.mChainLinks.end();
+	return true;
+}
+
+LLPumpIO::running_chains_t::iterator LLPumpIO::eraseChain(
+	running_chains_t& chains,
+	running_chains_t::iterator chain)
+{
+	LLChainInfo::conditionals_t::iterator it = (*chain).mDescriptors.begin();
+	LLChainInfo::conditionals_t::iterator end = (*chain).mDescriptors.end();
+	for(; it != end; ++it)
+	{
+		if(mEpollFD >= 0)
+		{
+			removePollDescriptor((*it).second);
+		}
+		ll_delete_apr_pollset_fd_client_data()(*it);
+	}
+	return chains.erase(chain);
+}
+
+#if LL_LINUX
+static int get_os_descriptor(const apr_pollfd_t& poll)
+{
+	if(APR_POLL_SOCKET == poll.desc_type)
+	{
+		apr_os_sock_t os_sock;
+		if(APR_SUCCESS == apr_os_sock_get(&os_sock, poll.desc.s))
+		{
+			return os_sock;
+		}
+	}
+	else if(APR_POLL_FILE == poll.desc_type)
+	{
+		apr_os_file_t os_file;
+		if(APR_SUCCESS == apr_os_file_get(&os_file, poll.desc.f))
+		{
+			return os_file;
+		}
+	}
+	return -1;
+}
+
+static U32 apr_to_epoll_events(apr_int16_t events)
+{
+	U32 rv = 0;
+	if(events & APR_POLLIN) rv |= EPOLLIN;
+	if(events & APR_POLLPRI) rv |= EPOLLPRI;
+	if(events & APR_POLLOUT) rv |= EPOLLOUT;
+	return rv;
+}
+
+static apr_int16_t epoll_to_apr_events(U32 events)
+{
+	apr_int16_t rv = 0;
+	if(events & EPOLLIN) rv |= APR_POLLIN;
+	if(events & EPOLLPRI) rv |= APR_POLLPRI;
+	if(events & EPOLLOUT) rv |= APR_POLLOUT;
+	if(events & EPOLLERR) rv |= APR_POLLERR;
+	if(events & EPOLLHUP) rv |= APR_POLLHUP;
+	return rv;
+}
+#endif
+
+void LLPumpIO::addPollDescriptor(const apr_pollfd_t& poll, current_chain_t chain)
+{
+#if LL_LINUX
+	int fd = get_os_descriptor(poll);
+	if(fd < 0)
+	{
+		ll_debug_poll_fd("No descriptor to add", &poll);
+		return;
+	}
+	LLPollRegistration registration;
+	registration.mChain = chain;
+	registration.mPoll = poll;
+	mPollDescriptors[fd].mRegistrations.push_back(registration);
+	updatePollDescriptor(fd);
+#endif
+}
+
+void LLPumpIO::removePollDescriptor(const apr_pollfd_t& poll)
+{
+#if LL_LINUX
+	int fd = get_os_descriptor(poll);
+	poll_descriptors_t::iterator desc = mPollDescriptors.find(fd);
+	if(desc == mPollDescriptors.end())
+	{
+		return;
+	}
+	// client_data is unique to each setConditional() call
+	poll_registrations_t& registrations = (*desc).second.mRegistrations;
+	poll_registrations_t::iterator it = registrations.begin();
+	while(it != registrations.end())
+	{
+		if((*it).mPoll.client_data == poll.client_data)
+		{
+			it = registrations.erase(it);
+		}
+		else
+		{
+			++it;
+		}
+	}
+	updatePollDescriptor(fd);
+#endif
+}
+
+void LLPumpIO::updatePollDescriptor(int fd)
+{
+#if LL_LINUX
+	poll_descriptors_t::iterator desc = mPollDescriptors.find(fd);
+	if(desc == mPollDescriptors.end())
+	{
+		return;
+	}
+	U32 events = 0;
+	poll_registrations_t::iterator it = (*desc).second.mRegistrations.begin();
+	poll_registrations_t::iterator end = (*desc).second.mRegistrations.end();
+	for(; it != end; ++it)
+	{
+		events |= apr_to_epoll_events((*it).mPoll.reqevents);
+	}
+	if(events != (*desc).second.mEvents)
+	{
+		struct epoll_event ev;
+		memset(&ev, 0, sizeof(ev));	/* Flawfinder: ignore */
+		ev.events = events;
+		ev.data.fd = fd;
+		int op = EPOLL_CTL_MOD;
+		if(!(*desc).second.mEvents)
+		{
+			op = EPOLL_CTL_ADD;
+		}
+		else if(!events)
+		{
+			op = EPOLL_CTL_DEL;
+		}
+		// Removing a descriptor which was already closed fails
+		// harmlessly, the kernel dropped it with the last close().
+		if(epoll_ctl(mEpollFD, op, fd, &ev) < 0 && op != EPOLL_CTL_DEL)
+		{
+			llwarns << "epoll_ctl failed on fd " << fd << ": "
+					<< strerror(errno) << llendl;
+		}
+		(*desc).second.mEvents = events;
+	}
+	if((*desc).second.mRegistrations.empty())
+	{
+		mPollDescriptors.erase(desc);
+	}
+#endif
+}
+
+void LLPumpIO::pumpEpoll(S32 poll_timeout)
+{
+#if LL_LINUX
+	PUMP_DEBUG;
+	// Find the chains with a ready descriptor. The set is level
+	// triggered, so a chain which is locked or did not drain its
+	// socket this time is reported again on the next pump.
+	typedef std::map<LLChainInfo*, LLPollRegistration> signalled_chains_t;
+	signalled_chains_t signalled;
+	if(!mPollDescriptors.empty())
+	{
+		struct epoll_event events[EPOLL_MAX_EVENTS];
+		S32 count = 0;
+		{
+			LLPerfBlock polltime("pump_poll");
+			// poll_timeout is in microseconds, like the APR pollset
+			S32 timeout_ms = poll_timeout < 0 ? -1 : (poll_timeout + 999) / 1000;
+			count = epoll_wait(mEpollFD, events, EPOLL_MAX_EVENTS, timeout_ms);
+		}
+		PUMP_DEBUG;
+		for(S32 ii = 0; ii < count; ++ii)
+		{
+			poll_descriptors_t::iterator desc = mPollDescriptors.find(events[ii].data.fd);
+			if(desc == mPollDescriptors.end()) continue;
+			apr_int16_t rtnevents = epoll_to_apr_events(events[ii].events);
+			poll_registrations_t::iterator it = (*desc).second.mRegistrations.begin();
+			poll_registrations_t::iterator end = (*desc).second.mRegistrations.end();
+			for(; it != end; ++it)
+			{
+				// errors go to every pipe on the descriptor, the
+				// rest only to those which asked for them.
+				apr_int16_t mine = rtnevents & ((*it).mPoll.reqevents | APR_POLLERR | APR_POLLHUP);
+				if(!mine) continue;
+				LLPollRegistration& entry = signalled[&(*(*it).mChain)];
+				if(!entry.mPoll.rtnevents || (mine & (APR_POLLERR | APR_POLLHUP)))
+				{
+					entry.mChain = (*it).mChain;
+					entry.mPoll = (*it).mPoll;
+					entry.mPoll.rtnevents = mine;
+				}
+				ll_debug_poll_fd("Signalled pipe", &entry.mPoll);
+			}
+		}
+	}
+
+	// Chains without a conditional run every cycle, as before. Those
+	// which set one during processing move over to the waiting list.
+	PUMP_DEBUG;
+	running_chains_t::iterator run_chain = mRunningChains.begin();
+	while(run_chain != mRunningChains.end())
+	{
+		PUMP_DEBUG;
+		if(expireChain(*run_chain))
+		{
+			run_chain = eraseChain(mRunningChains, run_chain);
+			continue;
+		}
+		if((*run_chain).mLock)
+		{
+			++run_chain;
+			continue;
+		}
+		mCurrentChain = run_chain;
+		if(!((*run_chain).mInit))
+		{
+			(*run_chain).mHead = (*run_chain).mChainLinks.begin();
+			(*run_chain).mInit = true;
+		}
+		processChain(*run_chain);
+
+		if((*run_chain).mHead == (*run_chain).mChainLinks.end())
+		{
+			run_chain = eraseChain(mRunningChains, run_chain);
+		}
+		else if(!(*run_chain).mDescriptors.empty())
+		{
+			// splice() keeps the iterators held by the epoll
+			// registrations valid.
+			running_chains_t::iterator waiting = run_chain++;
+			mWaitingChains.splice(mWaitingChains.end(), mRunningChains, waiting);
+		}
+		else
+		{
+			++run_chain;
+		}
+	}
+
+	// Only the chains epoll reported are visited.
+	PUMP_DEBUG;
+	signalled_chains_t::iterator sig_it = signalled.begin();
+	signalled_chains_t::iterator sig_end = signalled.end();
+	for(; sig_it != sig_end; ++sig_it)
+	{
+		PUMP_DEBUG;
+		current_chain_t chain = (*sig_it).second.mChain;
+		if(expireChain(*chain))
+		{
+			eraseChain(mWaitingChains, chain);
+			continue;
+		}
+		if((*chain).mLock)
+		{
+			continue;
+		}
+		mCurrentChain = chain;
+		if(!handlePollError(*chain, &((*sig_it).second.mPoll)))
+		{
+			processChain(*chain);
+		}
+
+		if((*chain).mHead == (*chain).mChainLinks.end())
+		{
+			eraseChain(mWaitingChains, chain);
+		}
+		else if((*chain).mDescriptors.empty())
+		{
+			mRunningChains.splice(mRunningChains.end(), mWaitingChains, chain);
+		}
+	}
+
+	// The other waiting chains still need to time out.
+	if(mExpiryScanTimer.hasExpired())
+	{
+		PUMP_DEBUG;
+		run_chain = mWaitingChains.begin();
+		while(run_chain != mWaitingChains.end())
+		{
+			if(expireChain(*run_chain))
+			{
+				run_chain = eraseChain(mWaitingChains, run_chain);
+			}
+			else
+			{
+				++run_chain;
+			}
+		}
+		mExpiryScanTimer.setTimerExpirySec(EPOLL_EXPIRY_SCAN_SECS);
+	}
+
+	PUMP_DEBUG;
+	// null out the chain
+	mCurrentChain = mRunningChains.end();
+	END_PUMP_DEBUG;
+#endif
+}
+
 void LLPumpIO::processChain(LLChainInfo& chain)
 {
 	PUMP_DEBUG;
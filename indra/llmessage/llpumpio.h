@@ -35,6 +35,7 @@
 #ifndef LL_LLPUMPIO_H
 #define LL_LLPUMPIO_H
 
+#include <map>
 #include <set>
 #include <boost/shared_ptr.hpp>
 #if LL_LINUX  // needed for PATH_MAX in APR.
@@ -82,10 +83,27 @@ extern const F32 NEVER_CHAIN_EXPIRY_SECS;
 class LLPumpIO
 {
 public:
+	/** 
+	 * @brief How the pump waits on file descriptors.
+	 */
+	enum EPollMode
+	{
+		// Rebuild an APR pollset whenever a chain changes.
+		POLL_APR,
+
+		// On linux, keep one persistent epoll set which is updated as
+		// pipes set and clear conditionals. Chains waiting on a file
+		// descriptor are then only visited when it is ready. Other
+		// platforms fall back to POLL_APR.
+		POLL_EPOLL
+	};
+
 	/**
 	 * @brief Constructor.
+	 *
+	 * @param mode How to wait on file descriptors.
 	 */
-	LLPumpIO(void);
+	explicit LLPumpIO(EPollMode mode = POLL_APR);
 
 	/**
 	 * @brief Destructor.
@@ -382,6 +400,31 @@ protected:
 	callbacks_t mPendingCallbacks;
 	callbacks_t mCallbacks;
 
+	// Persistent epoll set, or -1 when using the APR pollset.
+	int mEpollFD;
+
+	// With epoll, chains move here once they set a conditional and
+	// back to mRunningChains when they clear their last one.
+	running_chains_t mWaitingChains;
+	LLFrameTimer mExpiryScanTimer;
+
+	// Everything registered on one file descriptor. A socket can be
+	// polled by several pipes (eg, reader and writer) at once.
+	struct LLPollRegistration
+	{
+		current_chain_t mChain;
+		apr_pollfd_t mPoll;
+	};
+	typedef std::vector<LLPollRegistration> poll_registrations_t;
+	struct LLPollDescriptor
+	{
+		LLPollDescriptor() : mEvents(0) {}
+		U32 mEvents;
+		poll_registrations_t mRegistrations;
+	};
+	typedef std::map<int, LLPollDescriptor> poll_descriptors_t;
+	poll_descriptors_t mPollDescriptors;
+
 	// Memory pool for pollsets & mutexes.
 	AIAPRPool mPool;
 	AIAPRPool mCurrentPool;
@@ -404,6 +447,43 @@ protected:
 	 */
 	void rebuildPollset();
 
+	/** 
+	 * @brief Incrementally update the epoll set.
+	 * @see setConditional()
+	 */
+	void addPollDescriptor(const apr_pollfd_t& poll, current_chain_t chain);
+	void removePollDescriptor(const apr_pollfd_t& poll);
+	void updatePollDescriptor(int fd);
+
+	/** 
+	 * @brief The part of <code>pump()</code> after pending chains and
+	 * locks have been handled, when using epoll.
+	 */
+	void pumpEpoll(S32 poll_timeout);
+
+	/** 
+	 * @brief Drop a chain's descriptors and erase it from chains.
+	 * @return Returns the iterator following chain.
+	 */
+	running_chains_t::iterator eraseChain(
+		running_chains_t& chains,
+		running_chains_t::iterator chain);
+
+	/** 
+	 * @brief Give the chain a chance to handle its expiration.
+	 *
+	 * @return Returns true if the chain expired and should be removed.
+	 */
+	bool expireChain(LLChainInfo& chain);
+
+	/** 
+	 * @brief Pass poll errors returned on a descriptor to the chain.
+	 *
+	 * @return Returns true if there was an error, in which case the
+	 * chain should not be processed this cycle.
+	 */
+	bool handlePollError(LLChainInfo& chain, const apr_pollfd_t* poll);
+
 	/** 
 	 * @brief Process the chain passed in.
 	 *
@@ -433,7 +513,7 @@ public:
 	 */
 	running_chains_t::size_type runningChains() const
 	{
-		return mRunningChains.size();
+		return mRunningChains.size() + mWaitingChains.size();
 	}
 
 
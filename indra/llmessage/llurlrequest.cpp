@@ -173,6 +173,11 @@ void LLURLRequest::checkRootCertificate(bool check)
 	mDetail->mCurlRequest->setoptString(CURLOPT_ENCODING, "");
 }
 
+void LLURLRequest::setPriority(LLCurl::EPriority priority)
+{
+	mDetail->mCurlRequest->setPriority(priority);
+}
+
 void LLURLRequest::setCallback(LLURLRequestComplete* callback)
 {
 	LLMemType m1(LLMemType::MTYPE_IO_URL_REQUEST);
@@ -319,7 +324,6 @@ LLIOPipe::EStatus LLURLRequest::process_impl(
 	{
 		PUMP_DEBUG;
 		LLIOPipe::EStatus status = STATUS_BREAK;
-		mDetail->mCurlRequest->perform();
 		while(1)
 		{
 			CURLcode result;
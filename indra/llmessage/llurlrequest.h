@@ -44,6 +44,7 @@
 #include "lliopipe.h"
 #include "llchainio.h"
 #include "llerror.h"
+#include "llcurl.h"
 
 extern const std::string CONTEXT_REQUEST;
 extern const std::string CONTEXT_DEST_URI_SD_LABEL;
@@ -168,6 +169,12 @@ public:
 	 * in practice.
 	 */
 	void setCallback(LLURLRequestComplete* callback);
+
+	/**
+	 * @brief Set the order this request gets a connection in when its
+	 * host is busy.
+	 */
+	void setPriority(LLCurl::EPriority priority);
 	//@}
 
 	/* @name LLIOPipe virtual implementations
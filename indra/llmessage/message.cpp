@@ -758,7 +758,7 @@ BOOL LLMessageSystem::checkMessages( S64 frame_count, bool faked_message, U8 fak
 				if (cdp && recv_reliable)
 				{
 					// Add to the recently received list for duplicate suppression
-					cdp->mRecentlyReceivedReliablePackets[mCurrentRecvPacketID] = getMessageTimeUsecs();
+					cdp->mRecentlyReceivedReliablePackets.set(mCurrentRecvPacketID, getMessageTimeUsecs());
 
 					// Put it onto the list of packets to be acked
 					cdp->collectRAck(mCurrentRecvPacketID);
@@ -828,8 +828,12 @@ void LLMessageSystem::processAcks()
 
 	BOOL dump = FALSE;
 	{
-		// Check the status of circuits
-		mCircuitInfo.updateWatchDogTimers(this);
+		// Check the status of circuits, unless they are replayed: nothing
+		// answers our pings then.
+		if (!mPacketRing.isReplaying())
+		{
+			mCircuitInfo.updateWatchDogTimers(this);
+		}
 
 		//resend any necessary packets
 		mCircuitInfo.resendUnackedPackets(mUnackedListDepth, mUnackedListSize);
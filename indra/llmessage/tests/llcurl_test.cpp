@@ -0,0 +1,157 @@
+/**
+ * @file llcurl_test.cpp
+ * @brief Tests running curl requests through the service thread against an LLIOHTTPServer
+ *
+ * $LicenseInfo:firstyear=2010&license=viewergpl$
+ * 
+ * Copyright (c) 2010, Linden Research, Inc.
+ * 
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ * 
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ * 
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ * 
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+#include "../llcurl.h"
+#include "../test/lltut.h"
+
+#include "llhttpnode.h"
+#include "lliohttpserver.h"
+#include "llpumpio.h"
+#include "llsdhttpserver.h"
+#include "lltimer.h"
+
+namespace
+{
+	class StorageNode : public LLHTTPNode
+	{
+	public:
+		LLSD get() const { return LLSD("stored"); }
+	};
+
+	class TimeOutNode : public LLHTTPNode
+	{
+	public:
+		void get(ResponsePtr r, const LLSD& context) const
+		{
+			// never answers, the request is left waiting
+		}
+	};
+
+	LLHTTPRegistration<StorageNode> gStorageNode("/test/storage");
+	LLHTTPRegistration<TimeOutNode> gTimeOutNode("/test/timeout");
+
+	class CountResponder : public LLCurl::Responder
+	{
+	public:
+		CountResponder(S32& good, S32& bad) : mGood(good), mBad(bad) {}
+		virtual void completedRaw(U32 status, const std::string& reason,
+								  const LLChannelDescriptors& channels,
+								  const LLIOPipe::buffer_ptr_t& buffer)
+		{
+			++(isGoodStatus(status) ? mGood : mBad);
+		}
+	private:
+		S32& mGood;
+		S32& mBad;
+	};
+}
+
+namespace tut
+{
+	struct curl_data
+	{
+		curl_data()
+		{
+			mServerPump = new LLPumpIO;
+			LLCurl::initClass();
+
+			LLHTTPNode& root = LLIOHTTPServer::create(*mServerPump, 8888);
+			LLHTTPStandardServices::useServices();
+			LLHTTPRegistrar::buildAllServices(root);
+		}
+
+		~curl_data()
+		{
+			LLCurl::cleanupClass();
+			delete mServerPump;
+		}
+
+		// Answers requests on this thread while the service thread sends them,
+		// until 'request' has nothing queued.
+		void runTheServer(LLCurlRequest& request, F32 timeout = 100.f)
+		{
+			LLTimer timer;
+			timer.setTimerExpirySec(timeout);
+			while (request.getQueued() > 0 && !timer.hasExpired())
+			{
+				mServerPump->pump();
+				mServerPump->callback();
+				request.process();
+			}
+		}
+
+		LLPumpIO* mServerPump;
+	};
+
+	typedef test_group<curl_data> curl_test;
+	typedef curl_test::object curl_object;
+	tut::curl_test tcurl("LLCurl");
+
+	template<> template<>
+	void curl_object::test<1>()
+	{
+		// Requests from several requesters share the service thread, more of
+		// them than a host gets connections.
+		S32 good = 0;
+		S32 bad = 0;
+		LLCurlRequest textures(LLCurl::PRIORITY_TEXTURE);
+		LLCurlRequest caps;
+		LLCurlRequest::headers_t headers;
+		S32 count = 3 * (S32)LLCurl::getMaxPerHost(LLCurl::PRIORITY_CAPS);
+		for (S32 i = 0; i < count; ++i)
+		{
+			textures.getByteRange("http://localhost:8888/test/storage", headers, 0, -1, new CountResponder(good, bad));
+		}
+		caps.get("http://localhost:8888/test/storage", new CountResponder(good, bad));
+
+		runTheServer(caps);
+		runTheServer(textures);
+		ensure_equals("all completed", good, count + 1);
+		ensure_equals("no errors", bad, 0);
+	}
+
+	template<> template<>
+	void curl_object::test<2>()
+	{
+		// A requester going away takes back what it has not been answered.
+		S32 good = 0;
+		S32 bad = 0;
+		{
+			LLCurlRequest request;
+			request.get("http://localhost:8888/test/timeout", new CountResponder(good, bad));
+			runTheServer(request, 0.5f);
+			ensure_equals("still waiting", request.getQueued(), 1);
+		}
+		ensure_equals("responder not called", good + bad, 0);
+	}
+}
@@ -0,0 +1,236 @@
+/**
+ * @file llcurlhostgate_test.cpp
+ * @brief Tests for the per class, per host admission of curl transfers
+ *
+ * $LicenseInfo:firstyear=2010&license=viewergpl$
+ * 
+ * Copyright (c) 2010, Linden Research, Inc.
+ * 
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ * 
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ * 
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ * 
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+#include "../llcurlhostgate.h"
+#include "../test/lltut.h"
+
+#include <algorithm>
+
+namespace
+{
+	enum
+	{
+		CLASS_POLL,
+		CLASS_CAPS,
+		CLASS_TEXTURE,
+		CLASS_COUNT
+	};
+
+	struct Request
+	{
+		Request(S32 id, const std::string& host) : mID(id), mHost(host) {}
+		const std::string& getHost() const { return mHost; }
+		S32 mID;
+		std::string mHost;
+	};
+
+	// Records the order requests were started in.
+	struct Starter
+	{
+		void operator()(Request* request) { mStarted.push_back(request->mID); }
+		std::vector<S32> mStarted;
+	};
+}
+
+namespace tut
+{
+	struct curlhostgate_test
+	{
+		typedef std::deque<Request*> queue_t;
+
+		~curlhostgate_test()
+		{
+			for (S32 i = 0; i < CLASS_COUNT; i++)
+			{
+				for (queue_t::iterator it = mQueues[i].begin(); it != mQueues[i].end(); ++it)
+				{
+					delete *it;
+				}
+			}
+			for (std::vector<Request*>::iterator it = mRunning.begin(); it != mRunning.end(); ++it)
+			{
+				delete *it;
+			}
+		}
+
+		void queue(S32 request_class, S32 id, const std::string& host)
+		{
+			mQueues[request_class].push_back(new Request(id, host));
+		}
+
+		// Starts what the gate lets through and keeps it for finish().
+		std::vector<S32> start(LLCurlHostGate& gate)
+		{
+			std::vector<Request*> before[CLASS_COUNT];
+			for (S32 i = 0; i < CLASS_COUNT; i++)
+			{
+				before[i].assign(mQueues[i].begin(), mQueues[i].end());
+			}
+			Starter starter;
+			gate.startReady(mQueues, starter);
+			for (S32 i = 0; i < CLASS_COUNT; i++)
+			{
+				for (std::vector<Request*>::iterator it = before[i].begin(); it != before[i].end(); ++it)
+				{
+					if (std::find(mQueues[i].begin(), mQueues[i].end(), *it) == mQueues[i].end())
+					{
+						mRunning.push_back(*it);
+						mRunningClass.push_back(i);
+					}
+				}
+			}
+			return starter.mStarted;
+		}
+
+		void finish(LLCurlHostGate& gate, S32 id)
+		{
+			for (U32 i = 0; i < mRunning.size(); i++)
+			{
+				if (mRunning[i]->mID == id)
+				{
+					gate.finished(mRunningClass[i], mRunning[i]->mHost);
+					delete mRunning[i];
+					mRunning.erase(mRunning.begin() + i);
+					mRunningClass.erase(mRunningClass.begin() + i);
+					return;
+				}
+			}
+			fail("finished a request that was not running");
+		}
+
+		queue_t mQueues[CLASS_COUNT];
+		std::vector<Request*> mRunning;
+		std::vector<S32> mRunningClass;
+	};
+
+	typedef test_group<curlhostgate_test> curlhostgate_t;
+	typedef curlhostgate_t::object curlhostgate_object_t;
+	tut::curlhostgate_t tut_curlhostgate("curlhostgate");
+
+	template<> template<>
+	void curlhostgate_object_t::test<1>()
+	{
+		// A host gets no more connections than its limit, other hosts are not held up
+		LLCurlHostGate gate(CLASS_COUNT, 100);
+		gate.setMaxPerHost(CLASS_CAPS, 2);
+		queue(CLASS_CAPS, 1, "a");
+		queue(CLASS_CAPS, 2, "a");
+		queue(CLASS_CAPS, 3, "a");
+		queue(CLASS_CAPS, 4, "b");
+
+		std::vector<S32> started = start(gate);
+		ensure_equals("started", started.size(), 3);
+		ensure_equals("first", started[0], 1);
+		ensure_equals("second", started[1], 2);
+		ensure_equals("other host", started[2], 4);
+		ensure_equals("host a", gate.getActiveCount(CLASS_CAPS, "a"), 2U);
+		ensure_equals("waiting", mQueues[CLASS_CAPS].size(), 1);
+		ensure("nothing more", start(gate).empty());
+
+		finish(gate, 2);
+		started = start(gate);
+		ensure_equals("one more", started.size(), 1);
+		ensure_equals("the waiting one", started[0], 3);
+		ensure_equals("total", gate.getActiveCount(), 3);
+	}
+
+	template<> template<>
+	void curlhostgate_object_t::test<2>()
+	{
+		// Each class has its own limit and its own count for a host
+		LLCurlHostGate gate(CLASS_COUNT, 100);
+		gate.setMaxPerHost(CLASS_CAPS, 1);
+		gate.setMaxPerHost(CLASS_TEXTURE, 3);
+		for (S32 i = 0; i < 4; i++)
+		{
+			queue(CLASS_TEXTURE, 10 + i, "a");
+		}
+		queue(CLASS_CAPS, 1, "a");
+		queue(CLASS_CAPS, 2, "a");
+
+		std::vector<S32> started = start(gate);
+		ensure_equals("started", started.size(), 4);
+		ensure_equals("caps", gate.getActiveCount(CLASS_CAPS, "a"), 1U);
+		ensure_equals("textures", gate.getActiveCount(CLASS_TEXTURE, "a"), 3U);
+		ensure_equals("max per host", gate.getMaxPerHost(CLASS_TEXTURE), 3U);
+	}
+
+	template<> template<>
+	void curlhostgate_object_t::test<3>()
+	{
+		// When connections run short, classes are served in order, each first come first served
+		LLCurlHostGate gate(CLASS_COUNT, 3);
+		gate.setMaxPerHost(CLASS_CAPS, 8);
+		gate.setMaxPerHost(CLASS_TEXTURE, 8);
+		queue(CLASS_TEXTURE, 10, "a");
+		queue(CLASS_TEXTURE, 11, "b");
+		queue(CLASS_CAPS, 1, "a");
+		queue(CLASS_CAPS, 2, "c");
+
+		std::vector<S32> started = start(gate);
+		ensure_equals("started", started.size(), 3);
+		ensure_equals("caps first", started[0], 1);
+		ensure_equals("caps second", started[1], 2);
+		ensure_equals("then the oldest texture", started[2], 10);
+
+		queue(CLASS_CAPS, 3, "b");
+		finish(gate, 1);
+		started = start(gate);
+		ensure_equals("one slot", started.size(), 1);
+		ensure_equals("caps jump the queue", started[0], 3);
+		ensure_equals("texture still waits", mQueues[CLASS_TEXTURE].size(), 1);
+	}
+
+	template<> template<>
+	void curlhostgate_object_t::test<4>()
+	{
+		// A class without a limit never waits and takes no connection from the others
+		LLCurlHostGate gate(CLASS_COUNT, 1);
+		gate.setMaxPerHost(CLASS_CAPS, 1);
+		for (S32 i = 0; i < 5; i++)
+		{
+			queue(CLASS_POLL, i, "a");
+		}
+		queue(CLASS_CAPS, 10, "a");
+
+		std::vector<S32> started = start(gate);
+		ensure_equals("all started", started.size(), 6);
+		ensure_equals("polls not counted", gate.getActiveCount(), 1);
+		ensure_equals("polls per host", gate.getActiveCount(CLASS_POLL, "a"), 0U);
+
+		finish(gate, 0);
+		finish(gate, 10);
+		ensure_equals("all done", gate.getActiveCount(), 0);
+		ensure_equals("host forgotten", gate.getActiveCount(CLASS_CAPS, "a"), 0U);
+	}
+}
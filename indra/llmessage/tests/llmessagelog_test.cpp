@@ -0,0 +1,147 @@
+/**
+ * @file llmessagelog_test.cpp
+ * @brief Tests for the message log ring
+ *
+ * $LicenseInfo:firstyear=2001&license=viewergpl$
+ *
+ * Copyright (c) 2001-2009, Linden Research, Inc.
+ *
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ *
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ *
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ *
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+#include "../llmessagelog.h"
+#include "../test/lltut.h"
+
+namespace tut
+{
+	struct messagelog_test
+	{
+		messagelog_test()
+			: mFrom(0x0100007f, 13000),
+			  mTo(0x0200007f, 13001)
+		{
+		}
+
+		// Entry i is i % 300 + 1 bytes long, every byte holding i & 0xff,
+		// and is sent from port i & 0xffff.
+		void logEntry(U32 i)
+		{
+			U8 data[300];
+			S32 size = i % 300 + 1;
+			memset(data, i & 0xff, size);
+			LLMessageLog::log(LLHost(mFrom.getAddress(), i & 0xffff), mTo, data, size);
+		}
+
+		void ensureEntry(const LLMessageLogEntry& entry, U32 i)
+		{
+			ensure_equals("port", entry.mFromHost.getPort(), i & 0xffff);
+			ensure("to", entry.mToHost == mTo);
+			ensure_equals("size", entry.mDataSize, (S32)(i % 300 + 1));
+			ensure_equals("data size", entry.mData.size(), (size_t)entry.mDataSize);
+			for (S32 j = 0; j < entry.mDataSize; j++)
+			{
+				ensure_equals("data", (U32)entry.mData[j], i & 0xff);
+			}
+		}
+
+		LLHost mFrom;
+		LLHost mTo;
+	};
+
+	typedef test_group<messagelog_test> messagelog_t;
+	typedef messagelog_t::object messagelog_object_t;
+	tut::messagelog_t tut_messagelog("messagelog");
+
+	template<> template<>
+	void messagelog_object_t::test<1>()
+	{
+		// Entries read back in order, a cursor at the head reads nothing
+		LLMessageLog::setMaxSize(1024 * 1024);
+		U32 cursor = LLMessageLog::getHead();
+		LLMessageLogEntry entry;
+		ensure_equals("empty", LLMessageLog::read(cursor, entry), LLMessageLog::READ_END);
+
+		for (U32 i = 0; i < 1000; i++)
+		{
+			logEntry(i);
+		}
+		for (U32 i = 0; i < 1000; i++)
+		{
+			ensure_equals("read", LLMessageLog::read(cursor, entry), LLMessageLog::READ_OK);
+			ensureEntry(entry, i);
+		}
+		ensure_equals("caught up", LLMessageLog::read(cursor, entry), LLMessageLog::READ_END);
+		ensure_equals("cursor at head", cursor, LLMessageLog::getHead());
+	}
+
+	template<> template<>
+	void messagelog_object_t::test<2>()
+	{
+		// A cursor left behind by the writer is told so, and picks up at the
+		// oldest entry, through any number of wraps.
+		LLMessageLog::setMaxSize(4096);
+		U32 cursor = LLMessageLog::getHead();
+		LLMessageLogEntry entry;
+		U32 next = 0;
+		for (S32 round = 0; round < 20; round++)
+		{
+			for (U32 i = 0; i < 100; i++)
+			{
+				logEntry(next++);
+			}
+			ensure_equals("lost", LLMessageLog::read(cursor, entry), LLMessageLog::READ_LOST);
+			ensure_equals("moved to tail", cursor, LLMessageLog::getTail());
+
+			// Whatever is left must be the last entries logged, in order.
+			std::vector<U32> ports;
+			while (LLMessageLog::read(cursor, entry) == LLMessageLog::READ_OK)
+			{
+				ports.push_back(entry.mFromHost.getPort());
+			}
+			ensure("some left", !ports.empty());
+			U32 first = next - ports.size();
+			for (U32 i = 0; i < ports.size(); i++)
+			{
+				ensure_equals("order", ports[i], (first + i) & 0xffff);
+			}
+			ensure("within the log", LLMessageLog::getHead() - LLMessageLog::getTail() <= 4096);
+		}
+	}
+
+	template<> template<>
+	void messagelog_object_t::test<3>()
+	{
+		// Resizing drops old entries, cursors into them are reported lost
+		LLMessageLog::setMaxSize(4096);
+		U32 cursor = LLMessageLog::getHead();
+		logEntry(1);
+		LLMessageLog::setMaxSize(8192);
+		LLMessageLogEntry entry;
+		ensure_equals("lost after resize", LLMessageLog::read(cursor, entry), LLMessageLog::READ_LOST);
+		logEntry(2);
+		ensure_equals("new entry", LLMessageLog::read(cursor, entry), LLMessageLog::READ_OK);
+		ensureEntry(entry, 2);
+	}
+}
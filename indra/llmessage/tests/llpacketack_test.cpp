@@ -0,0 +1,203 @@
+/**
+ * @file llpacketack_test.cpp
+ * @brief Tests for the reliable packet pool and the packet id window
+ *
+ * $LicenseInfo:firstyear=2001&license=viewergpl$
+ *
+ * Copyright (c) 2001-2009, Linden Research, Inc.
+ *
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ *
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ *
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ *
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+#include "../llpacketack.h"
+#include "../llpacketidwindow.h"
+#include "../test/lltut.h"
+#include "../test/lltestrand.h"
+
+#if !LL_WINDOWS
+#include <netinet/in.h>
+#else
+#include "winsock2.h"
+#endif
+
+#include <map>
+
+namespace
+{
+	LLTestRand sRand(4321);
+
+	// Orders packet ids the way the window does, relative to a base id.
+	struct sequence_less
+	{
+		sequence_less(TPACKETID base) : mBase(base) {}
+		bool operator()(TPACKETID a, TPACKETID b) const
+		{
+			return ((a - mBase) & LL_PACKET_ID_MASK) < ((b - mBase) & LL_PACKET_ID_MASK);
+		}
+		TPACKETID mBase;
+	};
+}
+
+namespace tut
+{
+	struct packetack_test
+	{
+		typedef LLPacketIDWindow<U32> window_t;
+
+		std::vector<TPACKETID> ids(window_t& window)
+		{
+			std::vector<TPACKETID> result;
+			for (window_t::iterator it = window.begin(); it != window.end(); ++it)
+			{
+				result.push_back(it.getID());
+			}
+			return result;
+		}
+
+		void makePacket(U8* buffer, TPACKETID id)
+		{
+			buffer[0] = 0;
+			U32 net_id = htonl(id);
+			memcpy(&buffer[PHL_PACKET_ID], &net_id, sizeof(net_id));	/* Flawfinder: ignore */
+		}
+	};
+
+	typedef test_group<packetack_test> packetack_t;
+	typedef packetack_t::object packetack_object_t;
+	tut::packetack_t tut_packetack("packetack");
+
+	template<> template<>
+	void packetack_object_t::test<1>()
+	{
+		// Ids come back in sequence order across the wrap
+		window_t window;
+		window.set(LL_PACKET_ID_MASK - 1, 1);
+		window.set(2, 4);
+		window.set(LL_PACKET_ID_MASK, 2);
+		window.set(0, 3);
+
+		std::vector<TPACKETID> got = ids(window);
+		ensure_equals("window size", window.size(), 4);
+		ensure_equals("front id", window.getFrontID(), LL_PACKET_ID_MASK - 1);
+		ensure_equals("first", got[0], LL_PACKET_ID_MASK - 1);
+		ensure_equals("second", got[1], LL_PACKET_ID_MASK);
+		ensure_equals("third", got[2], (TPACKETID)0);
+		ensure_equals("fourth", got[3], (TPACKETID)2);
+		ensure("missing id", !window.contains(1));
+		ensure_equals("value", *window.find(0), (U32)3);
+
+		window.erase(LL_PACKET_ID_MASK - 1);
+		ensure_equals("front moves on erase", window.getFrontID(), LL_PACKET_ID_MASK);
+	}
+
+	template<> template<>
+	void packetack_object_t::test<2>()
+	{
+		// Random inserts and erases around a moving front match a map in sequence order
+		window_t window;
+		TPACKETID base = LL_MAX_OUT_PACKET_ID - 5000;
+		std::map<TPACKETID, U32, sequence_less> expected((sequence_less(base)));
+		TPACKETID next = base;
+		for (S32 i = 0; i < 20000; i++)
+		{
+			if (expected.empty() || sRand.next(3))
+			{
+				window.set(next, i);
+				expected[next] = i;
+				next = (next + 1) & LL_PACKET_ID_MASK;
+			}
+			else
+			{
+				// Ack an old one, most often near the front
+				std::map<TPACKETID, U32, sequence_less>::iterator it = expected.begin();
+				std::advance(it, sRand.next(llmin((S32)expected.size(), 8)));
+				ensure("erase finds id", window.erase(it->first));
+				expected.erase(it);
+			}
+		}
+
+		// Erase through iterators as the resend loop does
+		window_t::iterator it = window.begin();
+		while (it != window.end())
+		{
+			if (*it % 2)
+			{
+				expected.erase(it.getID());
+				it = window.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+
+		ensure_equals("window size", window.size(), (S32)expected.size());
+		std::vector<TPACKETID> got = ids(window);
+		S32 i = 0;
+		for (std::map<TPACKETID, U32, sequence_less>::iterator eit = expected.begin(); eit != expected.end(); ++eit, ++i)
+		{
+			ensure_equals("id order", got[i], eit->first);
+			ensure_equals("value", *window.find(eit->first), eit->second);
+		}
+	}
+
+	template<> template<>
+	void packetack_object_t::test<3>()
+	{
+		// A window with a maximum span forgets its oldest ids, an unbounded one refuses
+		window_t bounded(16);
+		for (TPACKETID id = 0; id < 20; id++)
+		{
+			bounded.set(id, id);
+		}
+		ensure_equals("bounded size", bounded.size(), 16);
+		ensure_equals("bounded front", bounded.getFrontID(), (TPACKETID)4);
+		ensure("forgets all for a far id", bounded.set(LL_PACKET_ID_HALF_RANGE, 0));
+		ensure_equals("restarted size", bounded.size(), 1);
+
+		window_t unbounded;
+		ensure("first id", unbounded.set(10, 0));
+		ensure("refuses id too far ahead", !unbounded.set(10 + LL_PACKET_ID_HALF_RANGE, 0));
+		ensure_equals("unbounded size", unbounded.size(), 1);
+	}
+
+	template<> template<>
+	void packetack_object_t::test<4>()
+	{
+		// Released packets are handed out again
+		U8 buffer[64];
+		makePacket(buffer, 42);
+		LLReliablePacketParams params;
+		params.mRetries = 3;
+
+		LLReliablePacket* first = LLReliablePacket::create(0, buffer, sizeof(buffer), &params);
+		LLReliablePacket::destroy(first);
+		makePacket(buffer, 43);
+		LLReliablePacket* second = LLReliablePacket::create(0, buffer, sizeof(buffer), &params);
+		ensure("packet reused", first == second);
+		LLReliablePacket::destroy(second);
+		LLReliablePacket::cleanupClass();
+	}
+}
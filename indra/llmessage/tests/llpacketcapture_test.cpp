@@ -0,0 +1,204 @@
+/**
+ * @file llpacketcapture_test.cpp
+ * @brief Tests for the packet capture file and its replay
+ *
+ * $LicenseInfo:firstyear=2001&license=viewergpl$
+ *
+ * Copyright (c) 2001-2009, Linden Research, Inc.
+ *
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ *
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ *
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ *
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+#include "../llpacketcapture.h"
+#include "../test/lltut.h"
+
+#include <vector>
+
+namespace
+{
+	struct RegionRecord
+	{
+		LLHost mHost;
+		U64 mHandle;
+		U32 mWidth;
+	};
+	std::vector<RegionRecord> sRegions;
+
+	void record_region(const LLHost& host, U64 handle, U32 width)
+	{
+		RegionRecord record;
+		record.mHost = host;
+		record.mHandle = handle;
+		record.mWidth = width;
+		sRegions.push_back(record);
+	}
+}
+
+namespace tut
+{
+	struct packetcapture_test
+	{
+		packetcapture_test()
+			: mFilename("llpacketcapture_test.llcap"),
+			  mSim1(0x0100007f, 13000),
+			  mSim2(0x0200007f, 13001)
+		{
+			sRegions.clear();
+		}
+
+		~packetcapture_test()
+		{
+			LLFile::remove(mFilename);
+		}
+
+		// Writes a region record for each sim, then count packets from
+		// them in turn, packet i holding i + 1 bytes of value i.
+		void writeCapture(S32 count)
+		{
+			LLPacketCaptureWriter writer;
+			ensure("open for writing", writer.open(mFilename));
+			writer.writeRegion(mSim1, 0x0003e80000040000ULL, 256);
+			U8 data[NET_BUFFER_SIZE];
+			for (S32 i = 0; i < count; i++)
+			{
+				if (i == count / 2)
+				{
+					writer.writeRegion(mSim2, 0x0003e90000040000ULL, 512);
+				}
+				memset(data, i & 0xff, i + 1);
+				writer.writePacket((i & 1) && i > count / 2 ? mSim2 : mSim1, data, i + 1);
+			}
+			ensure_equals("packets written", writer.getPacketCount(), (U32)count);
+		}
+
+		std::string mFilename;
+		LLHost mSim1;
+		LLHost mSim2;
+	};
+
+	typedef test_group<packetcapture_test> packetcapture_t;
+	typedef packetcapture_t::object packetcapture_object_t;
+	tut::packetcapture_t tut_packetcapture("packetcapture");
+
+	template<> template<>
+	void packetcapture_object_t::test<1>()
+	{
+		// Records read back as they were written
+		writeCapture(100);
+
+		LLPacketCaptureReader reader;
+		ensure("open for reading", reader.open(mFilename));
+		ensure("first record", reader.next());
+		ensure_equals("region type", reader.getType(), (U8)LLPacketCaptureReader::RECORD_REGION);
+		ensure("region host", reader.getHost() == mSim1);
+		ensure_equals("region handle", reader.getRegionHandle(), 0x0003e80000040000ULL);
+		ensure_equals("region width", reader.getRegionWidth(), (U32)256);
+
+		S32 packets = 0;
+		U64 last_time = 0;
+		while (reader.next())
+		{
+			ensure("time goes forward", reader.getTime() >= last_time);
+			last_time = reader.getTime();
+			if (reader.getType() == LLPacketCaptureReader::RECORD_REGION)
+			{
+				ensure("second region host", reader.getHost() == mSim2);
+				ensure_equals("second region width", reader.getRegionWidth(), (U32)512);
+				continue;
+			}
+			ensure_equals("packet size", reader.getSize(), packets + 1);
+			ensure_equals("packet data", (S32)reader.getData()[packets], packets & 0xff);
+			packets++;
+		}
+		ensure_equals("packets read", packets, 100);
+	}
+
+	template<> template<>
+	void packetcapture_object_t::test<2>()
+	{
+		// A fast replay hands out every packet in order, calling back for
+		// each region before any of its traffic.
+		writeCapture(50);
+
+		LLPacketReplay replay(false);
+		replay.setRegionCallback(record_region);
+		ensure("open replay", replay.open(mFilename));
+
+		char buffer[NET_BUFFER_SIZE];
+		LLHost sender;
+		S32 packets = 0;
+		S32 size;
+		while ((size = replay.receivePacket(buffer, sender)) > 0)
+		{
+			ensure_equals("replayed size", size, packets + 1);
+			bool known = false;
+			for (std::vector<RegionRecord>::iterator it = sRegions.begin(); it != sRegions.end(); ++it)
+			{
+				known = known || it->mHost == sender;
+			}
+			ensure("region announced before its packets", known);
+			packets++;
+		}
+		ensure("done", replay.isDone());
+		ensure_equals("replayed packets", packets, 50);
+		ensure_equals("replay count", replay.getPacketCount(), (U32)50);
+		ensure_equals("regions", sRegions.size(), (size_t)2);
+		ensure_equals("region handle", sRegions[1].mHandle, 0x0003e90000040000ULL);
+	}
+
+	template<> template<>
+	void packetcapture_object_t::test<3>()
+	{
+		// Files that are not captures are refused, truncated ones end early
+		LLFILE* fp = LLFile::fopen(mFilename, "wb");	/* Flawfinder: ignore */
+		fputs("not a capture", fp);
+		fclose(fp);
+		LLPacketCaptureReader reader;
+		ensure("bad magic refused", !reader.open(mFilename));
+
+		writeCapture(10);
+		llstat stat_data;
+		LLFile::stat(mFilename, &stat_data);
+		std::vector<char> bytes(stat_data.st_size);
+		fp = LLFile::fopen(mFilename, "rb");	/* Flawfinder: ignore */
+		fread(&bytes[0], bytes.size(), 1, fp);
+		fclose(fp);
+		fp = LLFile::fopen(mFilename, "wb");	/* Flawfinder: ignore */
+		fwrite(&bytes[0], bytes.size() - 3, 1, fp);
+		fclose(fp);
+
+		LLPacketReplay replay(false);
+		ensure("open truncated", replay.open(mFilename));
+		char buffer[NET_BUFFER_SIZE];
+		LLHost sender;
+		S32 packets = 0;
+		while (replay.receivePacket(buffer, sender) > 0)
+		{
+			packets++;
+		}
+		ensure_equals("last packet dropped", packets, 9);
+		ensure("done", replay.isDone());
+	}
+}
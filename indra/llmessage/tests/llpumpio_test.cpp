@@ -0,0 +1,318 @@
+/**
+ * @file llpumpio_test.cpp
+ * @brief Tests for LLPumpIO conditionals, in both poll modes
+ *
+ * $LicenseInfo:firstyear=2010&license=viewergpl$
+ *
+ * Copyright (c) 2010, Linden Research, Inc.
+ *
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ *
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ *
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ *
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+#include "../llpumpio.h"
+#include "../test/lltut.h"
+
+#include "apr_portable.h"
+#include "llframetimer.h"
+#include "lltimer.h"
+
+#if !LL_WINDOWS
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace
+{
+	// A pipe which polls one socket. It sets or clears its conditional
+	// when asked to, drains whatever it reads and remembers the last
+	// error the pump passed it.
+	class PollPipe : public LLIOPipe
+	{
+	public:
+		PollPipe(apr_socket_t* socket, int fd, apr_int16_t events) :
+			mFD(fd),
+			mWatch(true),
+			mWatching(false),
+			mProcessCount(0),
+			mLastError(STATUS_OK)
+		{
+			mPoll.p = NULL;
+			mPoll.desc_type = APR_POLL_SOCKET;
+			mPoll.reqevents = events;
+			mPoll.rtnevents = 0x0;
+			mPoll.desc.s = socket;
+			mPoll.client_data = NULL;
+		}
+
+		/*virtual*/ EStatus handleError(EStatus status, LLPumpIO* pump)
+		{
+			mLastError = status;
+			return status;
+		}
+
+		int mFD;
+		apr_pollfd_t mPoll;
+		bool mWatch;
+		bool mWatching;
+		S32 mProcessCount;
+		EStatus mLastError;
+
+	protected:
+		/*virtual*/ EStatus process_impl(
+			const LLChannelDescriptors& channels,
+			buffer_ptr_t& buffer,
+			bool& eos,
+			LLSD& context,
+			LLPumpIO* pump)
+		{
+			++mProcessCount;
+			if(mPoll.reqevents & APR_POLLIN)
+			{
+				char buf[64];
+				while(recv(mFD, buf, sizeof(buf), MSG_DONTWAIT) > 0)
+				{
+				}
+			}
+			if(mWatch != mWatching)
+			{
+				pump->setConditional(this, mWatch ? &mPoll : NULL);
+				mWatching = mWatch;
+			}
+			return STATUS_BREAK;
+		}
+	};
+
+	const LLPumpIO::EPollMode MODES[] = { LLPumpIO::POLL_APR, LLPumpIO::POLL_EPOLL };
+	const S32 MODE_COUNT = 2;
+
+	std::string mode_name(LLPumpIO::EPollMode mode, const std::string& what)
+	{
+		return (mode == LLPumpIO::POLL_EPOLL ? "epoll: " : "apr: ") + what;
+	}
+}
+
+namespace tut
+{
+	struct pumpio_data
+	{
+		pumpio_data()
+		{
+			mPool.create();
+			mFDs[0] = mFDs[1] = -1;
+			LLFrameTimer::updateFrameTime();
+		}
+
+		~pumpio_data()
+		{
+			closeSockets();
+		}
+
+		// A connected pair of sockets; the pump polls the first one.
+		void openSockets()
+		{
+			closeSockets();
+			ensure("socketpair", 0 == socketpair(AF_UNIX, SOCK_STREAM, 0, mFDs));
+			mSocket = NULL;
+			ensure("apr socket", APR_SUCCESS == apr_os_sock_put(&mSocket, &mFDs[0], mPool()));
+		}
+
+		void closeSockets()
+		{
+			for(S32 i = 0; i < 2; ++i)
+			{
+				if(mFDs[i] >= 0)
+				{
+					close(mFDs[i]);
+					mFDs[i] = -1;
+				}
+			}
+		}
+
+		void poke()
+		{
+			ensure("write", 1 == write(mFDs[1], "x", 1));
+		}
+
+		PollPipe* addPipe(LLPumpIO* pump, apr_int16_t events, F32 timeout = NEVER_CHAIN_EXPIRY_SECS)
+		{
+			PollPipe* pipe = new PollPipe(mSocket, mFDs[0], events);
+			LLPumpIO::chain_t chain;
+			chain.push_back(LLIOPipe::ptr_t(pipe));
+			pump->addChain(chain, timeout);
+			return pipe;
+		}
+
+		void cycle(LLPumpIO* pump, S32 cycles = 1)
+		{
+			for(S32 i = 0; i < cycles; ++i)
+			{
+				LLFrameTimer::updateFrameTime();
+				pump->pump();
+			}
+		}
+
+		AIAPRPool mPool;
+		int mFDs[2];
+		apr_socket_t* mSocket;
+	};
+
+	typedef test_group<pumpio_data> pumpio_test;
+	typedef pumpio_test::object pumpio_object;
+	tut::pumpio_test tpumpio("LLPumpIO");
+
+	template<> template<>
+	void pumpio_object::test<1>()
+	{
+		// A chain waiting on a descriptor only runs once it is ready.
+		for(S32 m = 0; m < MODE_COUNT; ++m)
+		{
+			openSockets();
+			LLPumpIO pump(MODES[m]);
+			LLIOPipe::ptr_t reader(addPipe(&pump, APR_POLLIN));
+			PollPipe* pipe = (PollPipe*)reader.get();
+
+			cycle(&pump);
+			ensure_equals(mode_name(MODES[m], "first run sets the conditional").c_str(), pipe->mProcessCount, 1);
+			cycle(&pump, 3);
+			ensure_equals(mode_name(MODES[m], "idle while nothing to read").c_str(), pipe->mProcessCount, 1);
+
+			poke();
+			cycle(&pump);
+			ensure_equals(mode_name(MODES[m], "runs when readable").c_str(), pipe->mProcessCount, 2);
+			cycle(&pump, 3);
+			ensure_equals(mode_name(MODES[m], "idle again once drained").c_str(), pipe->mProcessCount, 2);
+		}
+	}
+
+	template<> template<>
+	void pumpio_object::test<2>()
+	{
+		// Clearing the conditional puts the chain back to running every cycle.
+		for(S32 m = 0; m < MODE_COUNT; ++m)
+		{
+			openSockets();
+			LLPumpIO pump(MODES[m]);
+			LLIOPipe::ptr_t reader(addPipe(&pump, APR_POLLIN));
+			PollPipe* pipe = (PollPipe*)reader.get();
+
+			cycle(&pump, 3);
+			ensure_equals(mode_name(MODES[m], "waiting").c_str(), pipe->mProcessCount, 1);
+
+			pipe->mWatch = false;
+			poke();
+			cycle(&pump);
+			ensure_equals(mode_name(MODES[m], "woken to clear").c_str(), pipe->mProcessCount, 2);
+			cycle(&pump, 3);
+			ensure_equals(mode_name(MODES[m], "runs every cycle without a conditional").c_str(), pipe->mProcessCount, 5);
+
+			pipe->mWatch = true;
+			cycle(&pump, 3);
+			ensure_equals(mode_name(MODES[m], "waiting on the conditional again").c_str(), pipe->mProcessCount, 6);
+		}
+	}
+
+	template<> template<>
+	void pumpio_object::test<3>()
+	{
+		// A waiting chain still expires even though it is never signalled.
+		for(S32 m = 0; m < MODE_COUNT; ++m)
+		{
+			openSockets();
+			LLPumpIO pump(MODES[m]);
+			LLIOPipe::ptr_t reader(addPipe(&pump, APR_POLLIN, 0.1f));
+			PollPipe* pipe = (PollPipe*)reader.get();
+
+			cycle(&pump);
+			ensure_equals(mode_name(MODES[m], "waiting").c_str(), pipe->mProcessCount, 1);
+			for(S32 i = 0; i < 100 && pipe->mLastError == LLIOPipe::STATUS_OK; ++i)
+			{
+				ms_sleep(10);
+				cycle(&pump);
+			}
+			ensure_equals(mode_name(MODES[m], "expired").c_str(), pipe->mLastError, LLIOPipe::STATUS_EXPIRED);
+
+			// The chain is gone, data no longer reaches it
+			poke();
+			cycle(&pump, 3);
+			ensure_equals(mode_name(MODES[m], "removed").c_str(), pipe->mProcessCount, 1);
+		}
+	}
+
+	template<> template<>
+	void pumpio_object::test<4>()
+	{
+		// A hang up is passed to the chain as an error and drops it.
+		for(S32 m = 0; m < MODE_COUNT; ++m)
+		{
+			openSockets();
+			LLPumpIO pump(MODES[m]);
+			LLIOPipe::ptr_t reader(addPipe(&pump, APR_POLLIN));
+			PollPipe* pipe = (PollPipe*)reader.get();
+
+			cycle(&pump);
+			ensure_equals(mode_name(MODES[m], "waiting").c_str(), pipe->mProcessCount, 1);
+
+			close(mFDs[1]);
+			mFDs[1] = -1;
+			cycle(&pump, 3);
+			ensure_equals(mode_name(MODES[m], "lost connection").c_str(), pipe->mLastError, LLIOPipe::STATUS_LOST_CONNECTION);
+			ensure_equals(mode_name(MODES[m], "not processed after the error").c_str(), pipe->mProcessCount, 1);
+		}
+	}
+
+#if LL_LINUX
+	template<> template<>
+	void pumpio_object::test<5>()
+	{
+		// With epoll a reader and a writer on the same socket each get
+		// their own events. The APR pollset can hold the socket only once.
+		openSockets();
+		LLPumpIO pump(LLPumpIO::POLL_EPOLL);
+		LLIOPipe::ptr_t reader(addPipe(&pump, APR_POLLIN));
+		LLIOPipe::ptr_t writer(addPipe(&pump, APR_POLLOUT));
+		PollPipe* read_pipe = (PollPipe*)reader.get();
+		PollPipe* write_pipe = (PollPipe*)writer.get();
+
+		cycle(&pump);
+		ensure_equals("reader set its conditional", read_pipe->mProcessCount, 1);
+		ensure_equals("writer set its conditional", write_pipe->mProcessCount, 1);
+
+		cycle(&pump, 3);
+		ensure_equals("reader idle", read_pipe->mProcessCount, 1);
+		ensure_equals("writer runs while writable", write_pipe->mProcessCount, 4);
+
+		poke();
+		cycle(&pump);
+		ensure_equals("reader woken", read_pipe->mProcessCount, 2);
+
+		// The writer leaving must not take the reader's registration along
+		write_pipe->mWatch = false;
+		cycle(&pump);
+		poke();
+		cycle(&pump);
+		ensure_equals("reader still registered", read_pipe->mProcessCount, 3);
+	}
+#endif
+}
+#endif // !LL_WINDOWS
@@ -694,6 +694,92 @@ S32 LLFontGL::render(const LLWString &wstr,
 }
 
 
+S32 LLFontGL::renderBatched(const LLWString &wstr, F32 x, F32 y, F32 z,
+							const LLColor4 &color, U8 style) const
+{
+	if (!sDisplayFont || wstr.empty())
+	{
+		return 0;
+	}
+
+	// Strip off any style bits that are already accounted for by the font.
+	style = style & (~getFontDesc().getStyle());
+
+	F32 drop_shadow_strength = 0.f;
+	if (style & (DROP_SHADOW | DROP_SHADOW_SOFT))
+	{
+		F32 luminance;
+		color.calcHSL(NULL, NULL, &luminance);
+		drop_shadow_strength = clamp_rescale(luminance, 0.35f, 0.6f, 0.f, 1.f);
+		if (luminance < 0.35f)
+		{
+			style = style & ~(DROP_SHADOW | DROP_SHADOW_SOFT);
+		}
+	}
+
+	LLFastTimer t(LLFastTimer::FTM_RENDER_FONTS);
+
+	F32 inv_width = 1.f / mFontBitmapCachep->getBitmapWidth();
+	F32 inv_height = 1.f / mFontBitmapCachep->getBitmapHeight();
+
+	// Snap the baseline origin to a whole screen pixel
+	F32 cur_x = (F32)llfloor(x);
+	F32 cur_y = (F32)llfloor(y);
+
+	LLImageGL *last_bound_texture = NULL;
+	S32 chars_drawn = 0;
+	S32 length = (S32)wstr.length();
+	for (S32 i = 0; i < length; i++)
+	{
+		llwchar wch = wstr[i];
+		if (!hasGlyph(wch))
+		{
+			addChar(wch);
+		}
+
+		const LLFontGlyphInfo* fgi = getGlyphInfo(wch);
+		if (!fgi)
+		{
+			llerrs << "Missing Glyph Info" << llendl;
+			break;
+		}
+		// Only a change of bitmap flushes the batch
+		LLImageGL *image_gl = mFontBitmapCachep->getImageGL(fgi->mBitmapNum);
+		if (last_bound_texture != image_gl)
+		{
+			gGL.getTexUnit(0)->bind(image_gl);
+			last_bound_texture = image_gl;
+		}
+
+		LLRectf uv_rect((fgi->mXBitmapOffset) * inv_width,
+				(fgi->mYBitmapOffset + fgi->mHeight + PAD_UVY) * inv_height,
+				(fgi->mXBitmapOffset + fgi->mWidth) * inv_width,
+				(fgi->mYBitmapOffset - PAD_UVY) * inv_height);
+		LLRectf screen_rect(llround(cur_x + (F32)fgi->mXBearing),
+				    llround(cur_y + (F32)fgi->mYBearing),
+				    llround(cur_x + (F32)fgi->mXBearing) + (F32)fgi->mWidth,
+				    llround(cur_y + (F32)fgi->mYBearing) - (F32)fgi->mHeight);
+		drawGlyph(screen_rect, uv_rect, color, style, drop_shadow_strength, z);
+
+		chars_drawn++;
+		cur_x += fgi->mXAdvance;
+		cur_y += fgi->mYAdvance;
+
+		llwchar next_char = wstr[i+1];
+		if (next_char && (next_char < LLFont::LAST_CHAR_FULL))
+		{
+			if (!hasGlyph(next_char))
+			{
+				addChar(next_char);
+			}
+			cur_x += getXKerning(wch, next_char);
+		}
+		cur_x = (F32)llfloor(cur_x + 0.5f);
+	}
+
+	return chars_drawn;
+}
+
 S32 LLFontGL::getWidth(const std::string& utf8text) const
 {
 	LLWString wtext = utf8str_to_wstring(utf8text);
@@ -1103,26 +1189,26 @@ void LLFontGL::removeEmbeddedChar( llwchar wc ) const
 }
 
 
-void LLFontGL::renderQuad(const LLRectf& screen_rect, const LLRectf& uv_rect, F32 slant_amt) const
+void LLFontGL::renderQuad(const LLRectf& screen_rect, const LLRectf& uv_rect, F32 slant_amt, F32 z) const
 {
 	gGL.texCoord2f(uv_rect.mRight, uv_rect.mTop);
-	gGL.vertex2f(llfont_round_x(screen_rect.mRight), 
-				llfont_round_y(screen_rect.mTop));
+	gGL.vertex3f(llfont_round_x(screen_rect.mRight), 
+				llfont_round_y(screen_rect.mTop), z);
 
 	gGL.texCoord2f(uv_rect.mLeft, uv_rect.mTop);
-	gGL.vertex2f(llfont_round_x(screen_rect.mLeft), 
-				llfont_round_y(screen_rect.mTop));
+	gGL.vertex3f(llfont_round_x(screen_rect.mLeft), 
+				llfont_round_y(screen_rect.mTop), z);
 
 	gGL.texCoord2f(uv_rect.mLeft, uv_rect.mBottom);
-	gGL.vertex2f(llfont_round_x(screen_rect.mLeft + slant_amt), 
-				llfont_round_y(screen_rect.mBottom));
+	gGL.vertex3f(llfont_round_x(screen_rect.mLeft + slant_amt), 
+				llfont_round_y(screen_rect.mBottom), z);
 
 	gGL.texCoord2f(uv_rect.mRight, uv_rect.mBottom);
-	gGL.vertex2f(llfont_round_x(screen_rect.mRight + slant_amt), 
-				llfont_round_y(screen_rect.mBottom));
+	gGL.vertex3f(llfont_round_x(screen_rect.mRight + slant_amt), 
+				llfont_round_y(screen_rect.mBottom), z);
 }
 
-void LLFontGL::drawGlyph(const LLRectf& screen_rect, const LLRectf& uv_rect, const LLColor4& color, U8 style, F32 drop_shadow_strength) const
+void LLFontGL::drawGlyph(const LLRectf& screen_rect, const LLRectf& uv_rect, const LLColor4& color, U8 style, F32 drop_shadow_strength, F32 z) const
 {
 	F32 slant_offset;
 	slant_offset = ((style & ITALIC) ? ( -mAscender * 0.2f) : 0.f);
@@ -1139,7 +1225,7 @@ void LLFontGL::drawGlyph(const LLRectf& screen_rect, const LLRectf& uv_rect, con
 				LLRectf screen_rect_offset = screen_rect;
 
 				screen_rect_offset.translate((F32)(pass * BOLD_OFFSET), 0.f);
-				renderQuad(screen_rect_offset, uv_rect, slant_offset);
+				renderQuad(screen_rect_offset, uv_rect, slant_offset, z);
 			}
 		}
 		else if (style & DROP_SHADOW_SOFT)
@@ -1170,10 +1256,10 @@ void LLFontGL::drawGlyph(const LLRectf& screen_rect, const LLRectf& uv_rect, con
 					break;
 				}
 			
-				renderQuad(screen_rect_offset, uv_rect, slant_offset);
+				renderQuad(screen_rect_offset, uv_rect, slant_offset, z);
 			}
 			gGL.color4fv(color.mV);
-			renderQuad(screen_rect, uv_rect, slant_offset);
+			renderQuad(screen_rect, uv_rect, slant_offset, z);
 		}
 		else if (style & DROP_SHADOW)
 		{
@@ -1182,14 +1268,14 @@ void LLFontGL::drawGlyph(const LLRectf& screen_rect, const LLRectf& uv_rect, con
 			gGL.color4fv(shadow_color.mV);
 			LLRectf screen_rect_shadow = screen_rect;
 			screen_rect_shadow.translate(1.f, -1.f);
-			renderQuad(screen_rect_shadow, uv_rect, slant_offset);
+			renderQuad(screen_rect_shadow, uv_rect, slant_offset, z);
 			gGL.color4fv(color.mV);
-			renderQuad(screen_rect, uv_rect, slant_offset);
+			renderQuad(screen_rect, uv_rect, slant_offset, z);
 		}
 		else // normal rendering
 		{
 			gGL.color4fv(color.mV);
-			renderQuad(screen_rect, uv_rect, slant_offset);
+			renderQuad(screen_rect, uv_rect, slant_offset, z);
 		}
 
 	}
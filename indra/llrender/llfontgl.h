@@ -162,6 +162,13 @@ public:
 		BOOL use_embedded = FALSE,
 		BOOL use_ellipses = FALSE) const;
 
+	// Draws text with its baseline at x, y, z in screen pixels, without
+	// touching the matrix stack, so that strings from many callers collect
+	// into one gGL batch. The caller sets up a screen pixel projection and
+	// an identity modelview. Embedded characters and underlines are not drawn.
+	S32 renderBatched(const LLWString &text, F32 x, F32 y, F32 z,
+					  const LLColor4 &color, U8 style = NORMAL) const;
+
 	// font metrics - override for LLFont that returns units of virtual pixels
 	/*virtual*/ F32 getLineHeight() const		{ return (F32)llround(mLineHeight / sScaleY); }
 	/*virtual*/ F32 getAscenderHeight() const	{ return (F32)llround(mAscender / sScaleY); }
@@ -220,8 +227,8 @@ protected:
 	const embedded_data_t* getEmbeddedCharData(const llwchar wch) const;
 	F32 getEmbeddedCharAdvance(const embedded_data_t* ext_data) const;
 	void clearEmbeddedChars();
-	void renderQuad(const LLRectf& screen_rect, const LLRectf& uv_rect, F32 slant_amt) const;
-	void drawGlyph(const LLRectf& screen_rect, const LLRectf& uv_rect, const LLColor4& color, U8 style, F32 drop_shadow_fade) const;
+	void renderQuad(const LLRectf& screen_rect, const LLRectf& uv_rect, F32 slant_amt, F32 z = 0.f) const;
+	void drawGlyph(const LLRectf& screen_rect, const LLRectf& uv_rect, const LLColor4& color, U8 style, F32 drop_shadow_fade, F32 z = 0.f) const;
 
 public:
 	static F32 sVertDPI;
@@ -39,6 +39,7 @@
 
 #include "llerror.h"
 #include "llimage.h"
+#include "llimagedxt.h"
 
 #include "llmath.h"
 #include "llgl.h"
@@ -1141,6 +1142,71 @@ BOOL LLImageGL::createGLTexture(S32 discard_level, const LLImageRaw* imageraw, S
 	return createGLTexture(discard_level, rawdata, FALSE, usename);
 }
 
+BOOL LLImageGL::createCompressedGLTexture(S32 discard_level, const LLImageRaw* imageraw, LLImageDXT* compressed,
+										  S32 usename, BOOL to_create, S32 category)
+{
+	// imageraw may have been scaled down since it was compressed: find the mip that matches it
+	S32 mip = 0;
+	if (compressed)
+	{
+		while ((compressed->getWidth() >> mip) > imageraw->getWidth() && (compressed->getHeight() >> mip) > imageraw->getHeight())
+		{
+			mip++;
+		}
+	}
+	if (!compressed || !compressed->isCompressed() || !to_create ||
+		!gGLManager.mHasCompressedTextures || mHasExplicitFormat || !mUseMipMaps ||
+		(compressed->getWidth() >> mip) != imageraw->getWidth() || (compressed->getHeight() >> mip) != imageraw->getHeight() ||
+		(imageraw->getComponents() != 3 && imageraw->getComponents() != 4))
+	{
+		return createGLTexture(discard_level, imageraw, usename, to_create, category);
+	}
+
+	if (gGLManager.mIsDisabled)
+	{
+		llwarns << "Trying to create a texture while GL is disabled!" << llendl;
+		return FALSE;
+	}
+
+	mGLTextureCreated = false ;
+	llassert(gGLManager.mInited);
+	stop_glerror();
+
+	if (discard_level < 0)
+	{
+		llassert(mCurrentDiscardLevel >= 0);
+		discard_level = mCurrentDiscardLevel;
+	}
+	discard_level = llclamp(discard_level, 0, (S32)mMaxDiscardLevel);
+
+	S32 raw_w = imageraw->getWidth() ;
+	S32 raw_h = imageraw->getHeight() ;
+	setSize(raw_w << discard_level, raw_h << discard_level, imageraw->getComponents());
+
+	// Alpha analysis and the pick mask can't read compressed blocks: run them on the raw image
+	mFormatPrimary = mComponents == 4 ? GL_RGBA : GL_RGB;
+	mFormatInternal = mComponents == 4 ? GL_RGBA8 : GL_RGB8;
+	mFormatType = GL_UNSIGNED_BYTE;
+	calcAlphaChannelOffsetAndStride() ;
+	analyzeAlpha(imageraw->getData(), raw_w, raw_h);
+	updatePickMask(raw_w, raw_h, imageraw->getData());
+
+	// DXR1 never uses the DXT1 punch-through mode, so it can go up as RGBA like DXR5
+	if (compressed->getFileFormat() == LLImageDXT::FORMAT_DXR5)
+	{
+		mFormatPrimary = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+	}
+	else
+	{
+		mFormatPrimary = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+	}
+	mFormatInternal = mFormatPrimary;
+
+	setCategory(category) ;
+	// setImage() walks back from the largest mip to the smaller ones stored before it
+	return createGLTexture(discard_level, compressed->getData() + compressed->getMipOffset(mip), TRUE, usename);
+}
+
 BOOL LLImageGL::createGLTexture(S32 discard_level, const U8* data_in, BOOL data_hasmips, S32 usename)
 {
 	llassert(data_in);
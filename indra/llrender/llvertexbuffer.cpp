@@ -1017,7 +1017,6 @@ void LLVertexBuffer::allocateClientIndexBuffer()
 // Map for data access
 volatile U8* LLVertexBuffer::mapVertexBuffer(S32 type, S32 index)
 {
-	LLMemType mt(LLMemType::MTYPE_VERTEX_DATA);
 	if (mFinal)
 	{
 		llerrs << "LLVertexBuffer::mapVeretxBuffer() called on a finalized buffer." << llendl;
@@ -1029,6 +1028,7 @@ volatile U8* LLVertexBuffer::mapVertexBuffer(S32 type, S32 index)
 		
 	if (!mVertexLocked && useVBOs())
 	{
+		LLMemType mt(LLMemType::MTYPE_VERTEX_DATA);
 		{
 			setBuffer(0, type);
 			mVertexLocked = TRUE;
@@ -1093,7 +1093,6 @@ volatile U8* LLVertexBuffer::mapVertexBuffer(S32 type, S32 index)
 
 volatile U8* LLVertexBuffer::mapIndexBuffer(S32 index)
 {
-	LLMemType mt(LLMemType::MTYPE_VERTEX_DATA);
 	if (mFinal)
 	{
 		llerrs << "LLVertexBuffer::mapIndexBuffer() called on a finalized buffer." << llendl;
@@ -1105,6 +1104,7 @@ volatile U8* LLVertexBuffer::mapIndexBuffer(S32 index)
 
 	if (!mIndexLocked && useVBOs())
 	{
+		LLMemType mt(LLMemType::MTYPE_VERTEX_DATA);
 		{
 
 			setBuffer(0, TYPE_INDEX);
@@ -170,6 +170,9 @@ public:
 	LLVertexBuffer(U32 typemask, S32 usage, bool strided=true);
 	
 	// map for data access
+	// Once the buffer is mapped, mapping it again (as the getXXXStrider()
+	// calls do) is only pointer arithmetic, so other threads may do it to
+	// fill disjoint ranges until the main thread unmaps the buffer.
 	volatile U8*		mapVertexBuffer(S32 type, S32 index);
 	volatile U8*		mapIndexBuffer(S32 index);
 
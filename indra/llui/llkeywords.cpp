@@ -59,7 +59,10 @@ inline BOOL LLKeywordToken::isHead(const llwchar* s) const
 	return res;
 }
 
-LLKeywords::LLKeywords() : mLoaded(FALSE)
+LLKeywords::LLKeywords() :
+	mLoaded(FALSE),
+	mWordTableMask(0),
+	mWordTableDirty(TRUE)
 {
 }
 
@@ -203,6 +206,7 @@ void LLKeywords::addToken(LLKeywordToken::TOKEN_TYPE type,
 	{
 	case LLKeywordToken::WORD:
 		mWordTokenMap[key] = new LLKeywordToken(type, color, key, tool_tip);
+		mWordTableDirty = TRUE;
 		break;
 
 	case LLKeywordToken::LINE:
@@ -231,6 +235,95 @@ LLColor3 LLKeywords::readColor( const std::string& s )
 	return LLColor3( r, g, b );
 }
 
+// FNV-1a, computed over the same characters the tokenizer walks when it looks for the end of a word.
+const U32 WORD_HASH_BASIS = 2166136261U;
+const U32 WORD_HASH_PRIME = 16777619U;
+
+static U32 hash_word(const llwchar* word, S32 len)
+{
+	U32 hash = WORD_HASH_BASIS;
+	for (S32 i = 0; i < len; i++)
+	{
+		hash = (hash ^ (U32)word[i]) * WORD_HASH_PRIME;
+	}
+	return hash;
+}
+
+// Position of the first character of the line containing pos.
+static S32 line_start_of(const LLWString& wtext, S32 pos)
+{
+	while( pos > 0 && wtext[pos - 1] != '\n' )
+	{
+		pos--;
+	}
+	return pos;
+}
+
+// Index of the segment covering pos in a sorted, contiguous segment list.
+static S32 segment_index_at(const std::vector<LLTextSegment*>& seg_list, S32 pos)
+{
+	LLTextSegment key(pos);
+	std::vector<LLTextSegment*>::const_iterator iter = std::upper_bound(seg_list.begin(), seg_list.end(), &key, LLTextSegment::compare());
+	if (iter != seg_list.begin()) --iter;
+	return iter - seg_list.begin();
+}
+
+// A line start is a clean boundary if no token segment runs across it, i.e. the
+// tokenizer was not inside a multi-line delimiter when it got there.
+static bool is_clean_line_start(const std::vector<LLTextSegment*>& seg_list, S32 pos)
+{
+	if( pos <= 0 || seg_list.empty() || pos >= seg_list.back()->getEnd() )
+	{
+		return false;
+	}
+	const LLTextSegment* seg = seg_list[segment_index_at(seg_list, pos)];
+	return seg->getStart() >= pos || !seg->getToken();
+}
+
+void LLKeywords::compileWordTable()
+{
+	// Keep the load factor at or below one half so probe chains stay short
+	U32 size = 16;
+	while (size < mWordTokenMap.size() * 2)
+	{
+		size <<= 1;
+	}
+	mWordTable.assign(size, (LLKeywordToken*)NULL);
+	mWordHashes.assign(size, 0);
+	mWordTableMask = size - 1;
+
+	for (word_token_map_t::iterator iter = mWordTokenMap.begin(); iter != mWordTokenMap.end(); ++iter)
+	{
+		const LLWString& word = iter->first;
+		U32 hash = hash_word(word.data(), word.size());
+		U32 i = hash & mWordTableMask;
+		while (mWordTable[i])
+		{
+			i = (i + 1) & mWordTableMask;
+		}
+		mWordTable[i] = iter->second;
+		mWordHashes[i] = hash;
+	}
+	mWordTableDirty = FALSE;
+}
+
+LLKeywordToken* LLKeywords::findWord(const llwchar* word, S32 len, U32 hash) const
+{
+	if (mWordTable.empty())
+	{
+		return NULL;
+	}
+	for (U32 i = hash & mWordTableMask; mWordTable[i]; i = (i + 1) & mWordTableMask)
+	{
+		LLKeywordToken* token = mWordTable[i];
+		if (mWordHashes[i] == hash && token->getLength() == len && token->isHead(word))
+		{
+			return token;
+		}
+	}
+	return NULL;
+}
+
 // Walk through a string, applying the rules specified by the keyword token list and
 // create a list of color segments.
 void LLKeywords::findSegments(std::vector<LLTextSegment *>* seg_list, const LLWString& wtext, const LLColor4 &defaultColor)
@@ -247,17 +340,130 @@ void LLKeywords::findSegments(std::vector<LLTextSegment *>* seg_list, const LLWS
 
 	seg_list->push_back( new LLTextSegment( LLColor3(defaultColor), 0, text_len ) ); 
 
+	scanSegments( seg_list, wtext, 0, defaultColor, NULL, 0, 0 );
+}
+
+void LLKeywords::updateSegments(std::vector<LLTextSegment *>* seg_list, const LLWString& wtext, const LLColor4 &defaultColor,
+								S32 dirty_start, S32 dirty_end, S32 delta)
+{
+	S32 text_len = wtext.size();
+	S32 old_len = text_len - delta;
+
+	if( seg_list->empty() || wtext.empty()
+		|| seg_list->front()->getIsDefault()
+		|| seg_list->back()->getEnd() != old_len
+		|| dirty_start < 0 || dirty_end < dirty_start || dirty_end > text_len
+		|| dirty_end - delta < dirty_start )
+	{
+		// Nothing we can reuse
+		findSegments( seg_list, wtext, defaultColor );
+		return;
+	}
+
+	std::vector<LLTextSegment*>& old_segs = *seg_list;
+
+	// Back up to the start of the edited line, and further while that line begins inside a
+	// delimited segment (block comment, string) opened on an earlier line.  Text before
+	// dirty_start is unchanged, so the old segments are still valid there.
+	S32 start = line_start_of( wtext, dirty_start );
+	S32 idx = segment_index_at( old_segs, start );
+	while( start > 0 && old_segs[idx]->getToken() && old_segs[idx]->getStart() < start )
+	{
+		start = line_start_of( wtext, old_segs[idx]->getStart() );
+		idx = segment_index_at( old_segs, start );
+	}
+
+	// Keep the segments before the restart point.  The default segment leading up to it is
+	// reopened to run to the end of the text, which is how a full scan would have left it.
+	S32 head_start = start;
+	if( old_segs[idx]->getStart() < start )
+	{
+		head_start = old_segs[idx]->getStart();
+	}
+	else if( idx > 0 && !old_segs[idx - 1]->getToken() )
+	{
+		idx--;
+		head_start = old_segs[idx]->getStart();
+	}
+
+	std::vector<LLTextSegment*> new_segs;
+	new_segs.reserve( old_segs.size() + 16 );
+	new_segs.insert( new_segs.end(), old_segs.begin(), old_segs.begin() + idx );
+	if( head_start == 0 )
+	{
+		new_segs.push_back( new LLTextSegment( LLColor3(defaultColor), 0, text_len ) );
+	}
+	else
+	{
+		new_segs.push_back( new LLTextSegment( defaultColor, head_start, text_len ) );
+	}
+
+	S32 resync = scanSegments( &new_segs, wtext, start, defaultColor, &old_segs, dirty_end, delta );
+
+	// Old segments [idx, reuse) were superseded by the rescan, the rest shift into place.
+	S32 reuse = old_segs.size();
+	if( resync < text_len )
+	{
+		reuse = segment_index_at( old_segs, resync - delta );
+
+		// The scan stopped on a clean line start, so it ends in a default segment
+		LLTextSegment* tail = new_segs.back();
+		llassert( !tail->getToken() );
+		LLTextSegment* seg = old_segs[reuse];
+		if( !seg->getToken() )
+		{
+			// Adjoining default segments merge, as they would in a full scan
+			tail->setEnd( seg->getEnd() + delta );
+			reuse++;
+		}
+		else
+		{
+			tail->setEnd( resync );
+		}
+
+		for( S32 i = reuse; i < (S32)old_segs.size(); i++ )
+		{
+			LLTextSegment* moved = old_segs[i];
+			moved->setStart( moved->getStart() + delta );
+			moved->setEnd( moved->getEnd() + delta );
+			new_segs.push_back( moved );
+		}
+	}
+
+	std::for_each( old_segs.begin() + idx, old_segs.begin() + reuse, DeletePointer() );
+	seg_list->swap( new_segs );
+}
+
+S32 LLKeywords::scanSegments(std::vector<LLTextSegment *>* seg_list, const LLWString& wtext, S32 start, const LLColor4 &defaultColor,
+							 const std::vector<LLTextSegment *>* old_segs, S32 resync_pos, S32 delta)
+{
+	if( mWordTableDirty )
+	{
+		compileWordTable();
+	}
+
+	S32 text_len = wtext.size();
+
 	const llwchar* base = wtext.c_str();
-	const llwchar* cur = base;
+	const llwchar* first = base + start;
+	const llwchar* cur = first;
 	const llwchar* line = NULL;
 
 	while( *cur )
 	{
-		if( *cur == '\n' || cur == base )
+		if( *cur == '\n' || cur == first )
 		{
 			if( *cur == '\n' )
 			{
 				cur++;
+
+				// Tokenizing from a clean line start only depends on the text that follows it, so
+				// once we are past the edit and the old segments agree, the rest of them still hold.
+				if( old_segs && (cur - base) > resync_pos && is_clean_line_start( *old_segs, (cur - base) - delta ) )
+				{
+					return cur - base;
+				}
+
 				if( !*cur || *cur == '\n' )
 				{
 					continue;
@@ -423,18 +629,18 @@ void LLKeywords::findSegments(std::vector<LLTextSegment *>* seg_list, const LLWS
 			if( !isalnum( prev ) && (prev != '_') )
 			{
 				const llwchar* p = cur;
+				U32 hash = WORD_HASH_BASIS;
 				while( isalnum( *p ) || (*p == '_') )
 				{
+					hash = (hash ^ (U32)*p) * WORD_HASH_PRIME;
 					p++;
 				}
 				S32 seg_len = p - cur;
 				if( seg_len > 0 )
 				{
-					LLWString word( cur, 0, seg_len );
-					word_token_map_t::iterator map_iter = mWordTokenMap.find(word);
-					if( map_iter != mWordTokenMap.end() )
+					LLKeywordToken* cur_token = findWord( cur, seg_len, hash );
+					if( cur_token )
 					{
-						LLKeywordToken* cur_token = map_iter->second;
 						S32 seg_start = cur - base;
 						S32 seg_end = seg_start + seg_len;
 
@@ -456,6 +662,8 @@ void LLKeywords::findSegments(std::vector<LLTextSegment *>* seg_list, const LLWS
 			}
 		}
 	}
+
+	return text_len;
 }
 
 void LLKeywords::insertSegment(std::vector<LLTextSegment*>* seg_list, LLTextSegment* new_segment, S32 text_len, const LLColor4 &defaultColor )
@@ -39,6 +39,7 @@
 #include <map>
 #include <list>
 #include <deque>
+#include <vector>
 
 class LLTextSegment;
 
@@ -86,6 +87,13 @@ public:
 
 	void		findSegments(std::vector<LLTextSegment *> *seg_list, const LLWString& text, const LLColor4 &defaultColor );
 
+	// Re-highlights only the lines touched by an edit.  [dirty_start, dirty_end) is the edited
+	// range in the current text and delta the change in text length since seg_list was built.
+	// Scanning resumes at the start of the first dirty line (or of the multi-line delimiter it
+	// sits in) and stops at the first clean line boundary where the old segments agree again.
+	void		updateSegments(std::vector<LLTextSegment *> *seg_list, const LLWString& text, const LLColor4 &defaultColor,
+							   S32 dirty_start, S32 dirty_end, S32 delta);
+
 	// Add the token as described
 	void addToken(LLKeywordToken::TOKEN_TYPE type,
 					const std::string& key,
@@ -105,8 +113,26 @@ private:
 	LLColor3	readColor(const std::string& s);
 	void		insertSegment(std::vector<LLTextSegment *> *seg_list, LLTextSegment* new_segment, S32 text_len, const LLColor4 &defaultColor);
 
+	// Tokenizes text from the line starting at start, appending to seg_list.  When old_segs is
+	// given, returns early at the first line start past resync_pos where old_segs (shifted by
+	// delta) are known to match; otherwise runs to the end and returns the text length.
+	S32			scanSegments(std::vector<LLTextSegment *> *seg_list, const LLWString& text, S32 start, const LLColor4 &defaultColor,
+							 const std::vector<LLTextSegment *>* old_segs, S32 resync_pos, S32 delta);
+
+	// Builds the open-addressed word table from mWordTokenMap.
+	void		compileWordTable();
+	LLKeywordToken*	findWord(const llwchar* word, S32 len, U32 hash) const;
+
 	BOOL		mLoaded;
 	word_token_map_t mWordTokenMap;
+
+	// Compiled view of mWordTokenMap: linear probing on an FNV-1a hash of the word, which the
+	// tokenizer computes while it scans for the end of the word.
+	std::vector<LLKeywordToken*> mWordTable;
+	std::vector<U32> mWordHashes;
+	U32			mWordTableMask;
+	BOOL		mWordTableDirty;
+
 	typedef std::deque<LLKeywordToken*> token_list_t;
 	token_list_t mLineTokenList;
 	token_list_t mDelimiterTokenList;
@@ -37,6 +37,7 @@
 #include "llboost.h"
 
 #include "llscrolllistctrl.h"
+#include "llscrolllistsort.h"
 
 #include "indra_constants.h"
 
@@ -469,6 +470,9 @@ const LLSD LLScrollListDate::getValue() const
 	return mDate;
 }
 
+LL_DEFINE_POOL_ALLOCATOR(LLScrollListCell);
+LL_DEFINE_POOL_ALLOCATOR(LLScrollListItem);
+
 LLScrollListItem::~LLScrollListItem()
 {
 	std::for_each(mColumns.begin(), mColumns.end(), DeletePointer());
@@ -670,6 +674,11 @@ LLScrollListCtrl::LLScrollListCtrl(const std::string& name, const LLRect& rect,
 	mTotalStaticColumnWidth(0),
 	mTotalColumnPadding(0),
 	mSorted(TRUE),
+	mNumSortedItems(0),
+	mFirstColumnSorted(TRUE),
+	mDataSource(NULL),
+	mDataWindowStart(0),
+	mDataWindowDirty(FALSE),
 	mDirty(FALSE),
 	mOriginalSelection(-1),
 	mDrewSelected(FALSE)
@@ -762,12 +771,12 @@ BOOL LLScrollListCtrl::setMaxItemCount(S32 max_count)
 
 S32 LLScrollListCtrl::isEmpty() const
 {
-	return mItemList.empty();
+	return getItemCount() == 0;
 }
 
 S32 LLScrollListCtrl::getItemCount() const
 {
-	return mItemList.size();
+	return mDataSource ? mDataSource->getRowCount() : mItemList.size();
 }
 
 // virtual LLScrolListInterface function (was deleteAllItems)
@@ -776,6 +785,10 @@ void LLScrollListCtrl::clearRows()
 	std::for_each(mItemList.begin(), mItemList.end(), DeletePointer());
 	mItemList.clear();
 	//mItemCount = 0;
+	mNumSortedItems = 0;
+	mFirstColumnSorted = TRUE;
+	mDataSelectedIDs.clear();
+	mDataWindowDirty = TRUE;
 
 	// Scroll the bar back up to the top.
 	mScrollbar->setDocParams(0, 0);
@@ -832,6 +845,15 @@ LLDynamicArray<LLUUID> LLScrollListCtrl::getSelectedIDs()
 {
 	LLUUID selected_id;
 	LLDynamicArray<LLUUID> ids;
+	if (mDataSource)
+	{
+		// includes rows scrolled out of the materialized window
+		for (std::set<LLUUID>::iterator itr = mDataSelectedIDs.begin(); itr != mDataSelectedIDs.end(); ++itr)
+		{
+			ids.push_back(*itr);
+		}
+		return ids;
+	}
 	std::vector<LLScrollListItem*> selected = this->getAllSelected();
 	for(std::vector<LLScrollListItem*>::iterator itr = selected.begin(); itr != selected.end(); ++itr)
 	{
@@ -855,7 +877,7 @@ S32 LLScrollListCtrl::getFirstSelectedIndex() const
 		LLScrollListItem* item  = *iter;
 		if (item->getSelected())
 		{
-			return CurSelectedIndex;
+			return mDataWindowStart + CurSelectedIndex;
 		}
 		CurSelectedIndex++;
 	}
@@ -971,6 +993,12 @@ LLRect LLScrollListCtrl::getRequiredRect()
 
 BOOL LLScrollListCtrl::addItem( LLScrollListItem* item, EAddPosition pos, BOOL requires_column )
 {
+	if (mDataSource)
+	{
+		llwarns << "Can't add items to " << getName() << " while it is using a data source" << llendl;
+		return FALSE;
+	}
+
 	BOOL not_too_big = getItemCount() < mMaxItemCount;
 	if (not_too_big)
 	{
@@ -979,6 +1007,7 @@ BOOL LLScrollListCtrl::addItem( LLScrollListItem* item, EAddPosition pos, BOOL r
 		case ADD_TOP:
 			mItemList.push_front(item);
 			setSorted(FALSE);
+			mFirstColumnSorted = FALSE;
 			break;
 	
 		case ADD_SORTED:
@@ -986,12 +1015,18 @@ BOOL LLScrollListCtrl::addItem( LLScrollListItem* item, EAddPosition pos, BOOL r
 				// sort by column 0, in ascending order
 				std::vector<sort_column_t> single_sort_column;
 				single_sort_column.push_back(std::make_pair(0, TRUE));
+				SortScrollListItem comparator(single_sort_column);
 
-				mItemList.push_back(item);
-				std::stable_sort(
-					mItemList.begin(), 
-					mItemList.end(), 
-					SortScrollListItem(single_sort_column));
+				if (mFirstColumnSorted)
+				{
+					LLScrollListSort::insertItem(mItemList, item, comparator);
+				}
+				else
+				{
+					mItemList.push_back(item);
+					std::stable_sort(mItemList.begin(), mItemList.end(), comparator);
+					mFirstColumnSorted = TRUE;
+				}
 				
 				// ADD_SORTED just sorts by first column...
 				// this might not match user sort criteria, so flag list as being in unsorted state
@@ -999,14 +1034,17 @@ BOOL LLScrollListCtrl::addItem( LLScrollListItem* item, EAddPosition pos, BOOL r
 				break;
 			}	
 		case ADD_BOTTOM:
+			// Leaves the sorted items in front alone, the next sort only has to merge this one in
 			mItemList.push_back(item);
-			setSorted(FALSE);
+			mSorted = FALSE;
+			mFirstColumnSorted = FALSE;
 			break;
 	
 		default:
 			llassert(0);
 			mItemList.push_back(item);
 			setSorted(FALSE);
+			mFirstColumnSorted = FALSE;
 			break;
 		}
 	
@@ -1237,16 +1275,18 @@ BOOL LLScrollListCtrl::selectItemRange( S32 first_index, S32 last_index )
 		return FALSE;
 	}
 
-	S32 listlen = (S32)mItemList.size();
-	first_index = llclamp(first_index, 0, listlen-1);
+	// In data source mode only the rows in the materialized window can be reached
+	S32 list_start = mDataWindowStart;
+	S32 list_end = mDataWindowStart + (S32)mItemList.size();
+	first_index = llclamp(first_index, list_start, list_end-1);
 	
 	if (last_index < 0)
-		last_index = listlen-1;
+		last_index = list_end-1;
 	else
-		last_index = llclamp(last_index, first_index, listlen-1);
+		last_index = llclamp(last_index, first_index, list_end-1);
 
 	BOOL success = FALSE;
-	S32 index = 0;
+	S32 index = list_start;
 	for (item_list::iterator iter = mItemList.begin(); iter != mItemList.end(); )
 	{
 		LLScrollListItem *itemp = *iter;
@@ -1293,6 +1333,8 @@ void LLScrollListCtrl::swapWithNext(S32 index)
 	LLScrollListItem *cur_itemp = mItemList[index];
 	mItemList[index] = mItemList[index + 1];
 	mItemList[index + 1] = cur_itemp;
+	mNumSortedItems = 0;
+	mFirstColumnSorted = FALSE;
 }
 
 
@@ -1307,6 +1349,8 @@ void LLScrollListCtrl::swapWithPrevious(S32 index)
 	LLScrollListItem *cur_itemp = mItemList[index];
 	mItemList[index] = mItemList[index - 1];
 	mItemList[index - 1] = cur_itemp;
+	mNumSortedItems = 0;
+	mFirstColumnSorted = FALSE;
 }
 
 void LLScrollListCtrl::moveToFront(S32 index)
@@ -1320,6 +1364,8 @@ void LLScrollListCtrl::moveToFront(S32 index)
 	std::advance(it,index);
 	mItemList.push_front(*it);
 	mItemList.erase(it);
+	mNumSortedItems = 0;
+	mFirstColumnSorted = FALSE;
 }
 
 void LLScrollListCtrl::deleteSingleItem(S32 target_index)
@@ -1337,12 +1383,17 @@ void LLScrollListCtrl::deleteSingleItem(S32 target_index)
 	}
 	delete itemp;
 	mItemList.erase(mItemList.begin() + target_index);
+	if (target_index < mNumSortedItems)
+	{
+		mNumSortedItems--;
+	}
 	dirtyColumns();
 }
 
 //FIXME: refactor item deletion
 void LLScrollListCtrl::deleteItems(const LLSD& sd)
 {
+	S32 index = 0;
 	item_list::iterator iter;
 	for (iter = mItemList.begin(); iter < mItemList.end(); )
 	{
@@ -1355,10 +1406,15 @@ void LLScrollListCtrl::deleteItems(const LLSD& sd)
 			}
 			delete itemp;
 			iter = mItemList.erase(iter);
+			if (index < mNumSortedItems)
+			{
+				mNumSortedItems--;
+			}
 		}
 		else
 		{
 			iter++;
+			index++;
 		}
 	}
 
@@ -1367,6 +1423,7 @@ void LLScrollListCtrl::deleteItems(const LLSD& sd)
 
 void LLScrollListCtrl::deleteSelectedItems()
 {
+	S32 index = 0;
 	item_list::iterator iter;
 	for (iter = mItemList.begin(); iter < mItemList.end(); )
 	{
@@ -1375,10 +1432,15 @@ void LLScrollListCtrl::deleteSelectedItems()
 		{
 			delete itemp;
 			iter = mItemList.erase(iter);
+			if (index < mNumSortedItems)
+			{
+				mNumSortedItems--;
+			}
 		}
 		else
 		{
 			iter++;
+			index++;
 		}
 	}
 	mLastSelected = NULL;
@@ -1413,6 +1475,16 @@ S32	LLScrollListCtrl::selectMultiple( LLDynamicArray<LLUUID> ids )
 		if(ids.end() != iditr) ids.erase(iditr);
 	}
 
+	if (mDataSource)
+	{
+		// ids left over belong to rows outside the materialized window
+		for (LLDynamicArray<LLUUID>::iterator iditr = ids.begin(); iditr != ids.end(); ++iditr)
+		{
+			mDataSelectedIDs.insert(*iditr);
+			++count;
+		}
+	}
+
 	if (mCommitOnSelectionChange)
 	{
 		commitIfChanged();
@@ -1429,7 +1501,7 @@ S32 LLScrollListCtrl::getItemIndex( LLScrollListItem* target_item ) const
 		LLScrollListItem *itemp = *iter;
 		if (target_item == itemp)
 		{
-			return index;
+			return mDataWindowStart + index;
 		}
 		index++;
 	}
@@ -1445,7 +1517,7 @@ S32 LLScrollListCtrl::getItemIndex( const LLUUID& target_id ) const
 		LLScrollListItem *itemp = *iter;
 		if (target_id == itemp->getUUID())
 		{
-			return index;
+			return mDataWindowStart + index;
 		}
 		index++;
 	}
@@ -1540,6 +1612,12 @@ void LLScrollListCtrl::selectNextItem( BOOL extend_selection)
 
 void LLScrollListCtrl::deselectAllItems(BOOL no_commit_on_change)
 {
+	if (!mDataSelectedIDs.empty())
+	{
+		mDataSelectedIDs.clear();
+		mSelectionChanged = TRUE;
+	}
+
 	item_list::iterator iter;
 	for (iter = mItemList.begin(); iter != mItemList.end(); iter++)
 	{
@@ -1832,17 +1910,19 @@ void LLScrollListCtrl::drawItems()
 		
 		mDrewSelected = FALSE;
 
-		S32 line = 0;
 		S32 max_columns = 0;
 
 		LLColor4 highlight_color = LLColor4::white;
 		F32 type_ahead_timeout = LLUI::sConfigGroup->getF32("TypeAheadTimeout");
 		highlight_color.mV[VALPHA] = clamp_rescale(mSearchTimer.getElapsedTimeF32(), type_ahead_timeout * 0.7f, type_ahead_timeout, 0.4f, 0.f);
 
-		item_list::iterator iter;
-		for (iter = mItemList.begin(); iter != mItemList.end(); iter++)
+		// Only visit the visible rows
+		S32 line = llmax(mScrollLines, mDataWindowStart);
+		S32 end_line = llmin(mScrollLines + num_page_lines, mDataWindowStart + (S32)mItemList.size());
+		cur_y -= (line - mScrollLines) * mLineHeight;
+		for (; line < end_line; line++)
 		{
-			LLScrollListItem* item = *iter;
+			LLScrollListItem* item = mItemList[line - mDataWindowStart];
 			
 			item_rect.setOriginAndSize( 
 				x, 
@@ -1859,39 +1939,34 @@ void LLScrollListCtrl::drawItems()
 
 			max_columns = llmax(max_columns, item->getNumColumns());
 
-			LLColor4 fg_color;
+			LLColor4 fg_color = (item->getEnabled() ? mFgUnselectedColor : mFgDisabledColor);
 			LLColor4 bg_color(LLColor4::transparent);
 
-			if( mScrollLines <= line && line < mScrollLines + num_page_lines )
+			if( item->getSelected() && mCanSelect)
 			{
-				fg_color = (item->getEnabled() ? mFgUnselectedColor : mFgDisabledColor);
-				if( item->getSelected() && mCanSelect)
-				{
-					bg_color = mBgSelectedColor;
-					fg_color = (item->getEnabled() ? mFgSelectedColor : mFgDisabledColor);
-				}
-				else if (mHighlightedItem == line && mCanSelect)
-				{
-					bg_color = mHighlightedColor;
-				}
-				else 
+				bg_color = mBgSelectedColor;
+				fg_color = (item->getEnabled() ? mFgSelectedColor : mFgDisabledColor);
+			}
+			else if (mHighlightedItem == line && mCanSelect)
+			{
+				bg_color = mHighlightedColor;
+			}
+			else 
+			{
+				if (mDrawStripes && (line % 2 == 0) && (max_columns > 1))
 				{
-					if (mDrawStripes && (line % 2 == 0) && (max_columns > 1))
-					{
-						bg_color = mBgStripeColor;
-					}
+					bg_color = mBgStripeColor;
 				}
+			}
 
-				if (!item->getEnabled())
-				{
-					bg_color = mBgReadOnlyColor;
-				}
+			if (!item->getEnabled())
+			{
+				bg_color = mBgReadOnlyColor;
+			}
 
-				item->draw(item_rect, fg_color, bg_color, highlight_color, mColumnPadding);
+			item->draw(item_rect, fg_color, bg_color, highlight_color, mColumnPadding);
 
-				cur_y -= mLineHeight;
-			}
-			line++;
+			cur_y -= mLineHeight;
 		}
 	}
 }
@@ -1904,7 +1979,7 @@ void LLScrollListCtrl::draw()
 	// if user specifies sort, make sure it is maintained
 	if (needsSorting() && !isSorted())
 	{
-		sortItems();
+		updateSort();
 	}
 
 	if (mNeedsScroll)
@@ -1912,6 +1987,11 @@ void LLScrollListCtrl::draw()
 		scrollToShowSelected();
 		mNeedsScroll = FALSE;
 	}
+
+	if (mDataSource)
+	{
+		updateDataWindow();
+	}
 	LLRect background(0, getRect().getHeight(), getRect().getWidth(), 0);
 	// Draw background
 	if (mBackgroundVisible)
@@ -2205,6 +2285,7 @@ BOOL LLScrollListCtrl::handleClick(S32 x, S32 y, MASK mask)
 			// propagate value of this cell to other selected items
 			// and commit the respective widgets
 			LLSD item_value = hit_cell->getValue();
+			std::vector<LLScrollListItem*> edited_items;
 			for (item_list::iterator iter = mItemList.begin(); iter != mItemList.end(); iter++)
 			{
 				LLScrollListItem* item = *iter;
@@ -2213,6 +2294,16 @@ BOOL LLScrollListCtrl::handleClick(S32 x, S32 y, MASK mask)
 					LLScrollListCell* cellp = item->getColumn(column_index);
 					cellp->setValue(item_value);
 					cellp->onCommit();
+					edited_items.push_back(item);
+				}
+			}
+			// move the edited rows back into place if the list is sorted on this column
+			for (std::vector<sort_column_t>::iterator iter = mSortColumns.begin(); iter != mSortColumns.end(); ++iter)
+			{
+				if (iter->first == column_index)
+				{
+					resortItems(edited_items);
+					break;
 				}
 			}
 			//FIXME: find a better way to signal cell changes
@@ -2247,22 +2338,24 @@ LLScrollListItem* LLScrollListCtrl::hitItem( S32 x, S32 y )
 	// allow for partial line at bottom
 	S32 num_page_lines = mPageLines + 1;
 
-	S32 line = 0;
-	item_list::iterator iter;
-	for(iter = mItemList.begin(); iter != mItemList.end(); iter++)
+	if (mDataSource)
 	{
-		LLScrollListItem* item  = *iter;
-		if( mScrollLines <= line && line < mScrollLines + num_page_lines )
-		{
-			if( item->getEnabled() && item_rect.pointInRect( x, y ) )
-			{
-				hit_item = item;
-				break;
-			}
+		updateDataWindow();
+	}
 
-			item_rect.translate(0, -mLineHeight);
+	S32 line = llmax(mScrollLines, mDataWindowStart);
+	S32 end_line = llmin(mScrollLines + num_page_lines, mDataWindowStart + (S32)mItemList.size());
+	item_rect.translate(0, -mLineHeight * (line - mScrollLines));
+	for (; line < end_line; line++)
+	{
+		LLScrollListItem* item = mItemList[line - mDataWindowStart];
+		if( item->getEnabled() && item_rect.pointInRect( x, y ) )
+		{
+			hit_item = item;
+			break;
 		}
-		line++;
+
+		item_rect.translate(0, -mLineHeight);
 	}
 
 	return hit_item;
@@ -2624,6 +2717,10 @@ void LLScrollListCtrl::selectItem(LLScrollListItem* itemp, BOOL select_single_it
 			deselectAllItems(TRUE);
 		}
 		itemp->setSelected(TRUE);
+		if (mDataSource)
+		{
+			mDataSelectedIDs.insert(itemp->getUUID());
+		}
 		mLastSelected = itemp;
 		mSelectionChanged = TRUE;
 	}
@@ -2641,6 +2738,7 @@ void LLScrollListCtrl::deselectItem(LLScrollListItem* itemp)
 		}
 
 		itemp->setSelected(FALSE);
+		mDataSelectedIDs.erase(itemp->getUUID());
 		LLScrollListCell* cellp = itemp->getColumn(getSearchColumn());
 		if (cellp)
 		{
@@ -2680,6 +2778,7 @@ BOOL LLScrollListCtrl::setSort(S32 column_idx, BOOL ascending)
 	if (mSortColumns.empty())
 	{
 		mSortColumns.push_back(new_sort_column);
+		mNumSortedItems = 0;
 		return TRUE;
 	}
 	else
@@ -2693,7 +2792,12 @@ BOOL LLScrollListCtrl::setSort(S32 column_idx, BOOL ascending)
 		mSortColumns.push_back(new_sort_column);
 
 		// did the sort criteria change?
-		return (cur_sort_column != new_sort_column);
+		if (cur_sort_column != new_sort_column)
+		{
+			mNumSortedItems = 0;
+			return TRUE;
+		}
+		return FALSE;
 	}
 }
 
@@ -2726,6 +2830,17 @@ void  LLScrollListCtrl::sortByColumnIndex(U32 column, BOOL ascending)
 
 void LLScrollListCtrl::sortItems()
 {
+	if (mDataSource)
+	{
+		if (!mSortColumns.empty())
+		{
+			mDataSource->sortRows(mSortColumns.back().first, mSortColumns.back().second);
+		}
+		mDataWindowDirty = TRUE;
+		setSorted(TRUE);
+		return;
+	}
+
 	// do stable sort to preserve any previous sorts
 	std::stable_sort(
 		mItemList.begin(), 
@@ -2733,11 +2848,79 @@ void LLScrollListCtrl::sortItems()
 		SortScrollListItem(mSortColumns));
 
 	setSorted(TRUE);
+	mNumSortedItems = mItemList.size();
+	mFirstColumnSorted = FALSE;
+}
+
+// Restores sort order after items were added.  Items appended behind the sorted ones are
+// sorted on their own and merged in, which gives the same order as a full stable sort.
+void LLScrollListCtrl::updateSort()
+{
+	S32 num_items = mItemList.size();
+	if (mDataSource || mNumSortedItems <= 0)
+	{
+		sortItems();
+	}
+	else if (mNumSortedItems < num_items)
+	{
+		SortScrollListItem comparator(mSortColumns);
+		item_list::iterator middle = mItemList.begin() + mNumSortedItems;
+		std::stable_sort(middle, mItemList.end(), comparator);
+		std::inplace_merge(mItemList.begin(), middle, mItemList.end(), comparator);
+
+		setSorted(TRUE);
+		mFirstColumnSorted = FALSE;
+		mNumSortedItems = num_items;
+	}
+	else
+	{
+		setSorted(TRUE);
+	}
+}
+
+void LLScrollListCtrl::resortItem(LLScrollListItem* itemp)
+{
+	resortItems(std::vector<LLScrollListItem*>(1, itemp));
+}
+
+void LLScrollListCtrl::resortItems(const std::vector<LLScrollListItem*>& items)
+{
+	if (!needsSorting() || mDataSource)
+	{
+		return;
+	}
+
+	// take them all out first, so that the rest is in order to merge into
+	std::vector<LLScrollListItem*> edited = LLScrollListSort::removeItems(mItemList, items, mNumSortedItems);
+	if (edited.empty())
+	{
+		return;
+	}
+	mFirstColumnSorted = FALSE;
+
+	if (isSorted())
+	{
+		// sorted among themselves and merged back in with the others
+		LLScrollListSort::mergeItems(mItemList, edited, SortScrollListItem(mSortColumns));
+		mNumSortedItems = mItemList.size();
+	}
+	else
+	{
+		// a sort is pending anyway, merge them in with the other new rows
+		mItemList.insert(mItemList.end(), edited.begin(), edited.end());
+	}
 }
 
 // for one-shot sorts, does not save sort column/order
 void LLScrollListCtrl::sortOnce(S32 column, BOOL ascending)
 {
+	if (mDataSource)
+	{
+		mDataSource->sortRows(column, ascending);
+		mDataWindowDirty = TRUE;
+		return;
+	}
+
 	std::vector<std::pair<S32, BOOL> > sort_column;
 	sort_column.push_back(std::make_pair(column, ascending));
 
@@ -2746,6 +2929,68 @@ void LLScrollListCtrl::sortOnce(S32 column, BOOL ascending)
 		mItemList.begin(), 
 		mItemList.end(), 
 		SortScrollListItem(sort_column));
+	mNumSortedItems = 0;
+	mFirstColumnSorted = FALSE;
+}
+
+void LLScrollListCtrl::setDataSource(LLScrollListDataSource* source)
+{
+	clearRows();
+	mDataSource = source;
+	mDataWindowStart = 0;
+	if (mDataSource && needsSorting())
+	{
+		mDataSource->sortRows(mSortColumns.back().first, mSortColumns.back().second);
+	}
+	setSorted(TRUE);
+	updateLayout();
+}
+
+void LLScrollListCtrl::dataChanged()
+{
+	mDataWindowDirty = TRUE;
+	updateLayout();
+}
+
+// Rebuilds the items for the rows around the visible ones once scrolling has moved past
+// them or the source changed.
+void LLScrollListCtrl::updateDataWindow()
+{
+	S32 row_count = mDataSource->getRowCount();
+	S32 visible_end = llmin(row_count, mScrollLines + mPageLines + 1);
+	if (!mDataWindowDirty
+		&& mScrollLines >= mDataWindowStart
+		&& visible_end <= mDataWindowStart + (S32)mItemList.size())
+	{
+		return;
+	}
+
+	// Keep a page either side of the visible rows so keyboard navigation and
+	// shift-click selection near the edges still find their neighbours.
+	S32 first = llclamp(mScrollLines - mPageLines - 1, 0, row_count);
+	S32 last = llclamp(mScrollLines + 2 * (mPageLines + 1), first, row_count);
+
+	LLUUID last_selected_id = mLastSelected ? mLastSelected->getUUID() : LLUUID::null;
+	mLastSelected = NULL;
+	std::for_each(mItemList.begin(), mItemList.end(), DeletePointer());
+	mItemList.clear();
+
+	for (S32 row = first; row < last; row++)
+	{
+		LLScrollListItem* itemp = buildItem(mDataSource->getRow(row), NULL);
+		if (mDataSelectedIDs.count(itemp->getUUID()))
+		{
+			itemp->setSelected(TRUE);
+			if (itemp->getUUID() == last_selected_id)
+			{
+				mLastSelected = itemp;
+			}
+		}
+		mItemList.push_back(itemp);
+	}
+
+	mDataWindowStart = first;
+	mDataWindowDirty = FALSE;
 }
 
 void LLScrollListCtrl::dirtyColumns() 
@@ -2794,7 +3039,7 @@ void LLScrollListCtrl::scrollToShowSelected()
 		return;
 	}
 
-	LLScrollListItem* item = mItemList[index];
+	LLScrollListItem* item = getFirstSelected();
 	if (!item)
 	{
 		// I don't THINK this should ever happen.
@@ -3370,6 +3615,18 @@ void LLScrollListCtrl::setColumnHeadings(LLSD headings)
 }
 
 LLScrollListItem* LLScrollListCtrl::addElement(const LLSD& value, EAddPosition pos, void* userdata)
+{
+	LLScrollListItem* new_item = buildItem(value, userdata);
+	if (!addItem(new_item, pos))
+	{
+		delete new_item;
+		return NULL;
+	}
+	return new_item;
+}
+
+// Makes an item from an LLSD row description, creating any columns it names that we don't have yet
+LLScrollListItem* LLScrollListCtrl::buildItem(const LLSD& value, void* userdata)
 {
 	// ID
 	LLSD id = value["id"];
@@ -3547,8 +3804,6 @@ LLScrollListItem* LLScrollListCtrl::addElement(const LLSD& value, EAddPosition p
 		}
 	}
 
-	addItem(new_item, pos);
-
 	return new_item;
 }
 
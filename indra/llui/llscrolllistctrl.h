@@ -34,6 +34,7 @@
 
 #include <vector>
 #include <deque>
+#include <set>
 
 #include "lluictrl.h"
 #include "llctrlselectioninterface.h"
@@ -49,6 +50,7 @@
 #include "llscrollbar.h"
 #include "llresizebar.h"
 #include "lldate.h"
+#include "llpoolallocator.h"
 // <edit>
 #include "lllineeditor.h"
 // </edit>
@@ -64,6 +66,8 @@
 class LLScrollListCell
 {
 public:
+	LL_USE_POOL_ALLOCATOR(LLScrollListCell);
+
 	LLScrollListCell(S32 width = 0) : mWidth(width) {};
 	virtual ~LLScrollListCell() {};
 	virtual void			draw(const LLColor4& color, const LLColor4& highlight_color) const = 0;		// truncate to given width, if possible
@@ -304,6 +308,8 @@ private:
 class LLScrollListItem
 {
 public:
+	LL_USE_POOL_ALLOCATOR(LLScrollListItem);
+
 	LLScrollListItem( BOOL enabled = TRUE, void* userdata = NULL, const LLUUID& uuid = LLUUID::null )
 		: mSelected(FALSE), mEnabled( enabled ), mUserdata( userdata ), mItemValue( uuid ), mColumns() {}
 	LLScrollListItem( LLSD item_value, void* userdata = NULL )
@@ -381,6 +387,21 @@ public:
 	/*virtual*/ void draw(const LLRect& rect, const LLColor4& fg_color, const LLColor4& bg_color, const LLColor4& highlight_color, S32 column_padding);
 };
 
+// Supplies rows on demand to an LLScrollListCtrl in data source mode.  The list only asks
+// for the rows around its visible window, so a source can hold any number of rows in its own
+// compact form.  The source also keeps its rows in order when the user sorts by a column.
+class LLScrollListDataSource
+{
+public:
+	virtual ~LLScrollListDataSource() {}
+
+	virtual S32		getRowCount() const = 0;
+	// Row 'index' in the current sort order, in the format taken by LLScrollListCtrl::addElement()
+	virtual LLSD	getRow(S32 index) const = 0;
+	// Called when the user clicks a column header
+	virtual void	sortRows(S32 column, BOOL ascending) { }
+};
+
 class LLScrollListCtrl : public LLUICtrl, public LLEditMenuHandler, 
 	public LLCtrlListInterface, public LLCtrlScrollInterface
 {
@@ -618,7 +639,18 @@ public:
 	void			sortOnce(S32 column, BOOL ascending);
 
 	// manually call this whenever editing list items in place to flag need for resorting
-	void			setSorted(BOOL sorted) { mSorted = sorted; }
+	void			setSorted(BOOL sorted) { mSorted = sorted; if (!sorted) mNumSortedItems = 0; }
+	// or this when only some items were edited, to move just those back into sort order
+	void			resortItem(LLScrollListItem* itemp);
+	void			resortItems(const std::vector<LLScrollListItem*>& items);
+
+	// Data source mode: rows come from 'source' and only those near the visible window exist
+	// as LLScrollListItems.  Items can't be added or deleted directly in this mode; call
+	// dataChanged() after the source's rows change instead.  Selection is kept by row id.
+	// The list does not own the source; pass NULL to return to normal mode.
+	void			setDataSource(LLScrollListDataSource* source);
+	LLScrollListDataSource* getDataSource() const { return mDataSource; }
+	void			dataChanged();
 	void			dirtyColumns(); // some operation has potentially affected column layout or ordering
 
 protected:
@@ -654,6 +686,9 @@ private:
 	void			deselectItem(LLScrollListItem* itemp);
 	void			commitIfChanged();
 	BOOL			setSort(S32 column, BOOL ascending);
+	void			updateSort();
+	LLScrollListItem* buildItem(const LLSD& value, void* userdata);
+	void			updateDataWindow();
 
 
 	S32				mCurIndex;			// For get[First/Next]Data
@@ -714,6 +749,13 @@ private:
 	S32				mTotalColumnPadding;
 
 	BOOL			mSorted;
+	S32				mNumSortedItems;	// leading items known to be in sort order; rows appended after them get merged in
+	BOOL			mFirstColumnSorted;	// items are in column 0 order, as ADD_SORTED leaves them
+
+	LLScrollListDataSource* mDataSource;
+	S32				mDataWindowStart;	// source row held by mItemList[0] in data source mode
+	BOOL			mDataWindowDirty;
+	std::set<LLUUID> mDataSelectedIDs;
 	
 	typedef std::map<std::string, LLScrollListColumn> column_map_t;
 	column_map_t mColumns;
@@ -0,0 +1,91 @@
+/**
+ * @file llscrolllistsort.cpp
+ * @brief Keeps the rows of a sorted scroll list in order without full resorts
+ *
+ * $LicenseInfo:firstyear=2010&license=viewergpl$
+ *
+ * Copyright (c) 2010, Linden Research, Inc.
+ *
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ *
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ *
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ *
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include <algorithm>
+#include <set>
+
+#include "llscrolllistsort.h"
+
+void LLScrollListSort::insertItem(item_list_t& items, LLScrollListItem* item, const less_t& less)
+{
+	items.insert(std::upper_bound(items.begin(), items.end(), item, less), item);
+}
+
+void LLScrollListSort::mergeItems(item_list_t& items, std::vector<LLScrollListItem*> added, const less_t& less)
+{
+	if (added.size() == 1)
+	{
+		insertItem(items, added[0], less);
+		return;
+	}
+	std::stable_sort(added.begin(), added.end(), less);
+	S32 num_items = items.size();
+	items.insert(items.end(), added.begin(), added.end());
+	std::inplace_merge(items.begin(), items.begin() + num_items, items.end(), less);
+}
+
+std::vector<LLScrollListItem*> LLScrollListSort::removeItems(item_list_t& items, const std::vector<LLScrollListItem*>& edited, S32& num_sorted)
+{
+	std::set<LLScrollListItem*> wanted(edited.begin(), edited.end());
+	std::set<LLScrollListItem*> found;
+	S32 num_kept = 0;
+	S32 num_sorted_kept = 0;
+	for (S32 i = 0; i < (S32)items.size(); i++)
+	{
+		LLScrollListItem* item = items[i];
+		if (wanted.count(item))
+		{
+			found.insert(item);
+			continue;
+		}
+		if (i < num_sorted)
+		{
+			num_sorted_kept++;
+		}
+		items[num_kept++] = item;
+	}
+	items.resize(num_kept);
+	num_sorted = num_sorted_kept;
+
+	std::vector<LLScrollListItem*> removed;
+	for (std::vector<LLScrollListItem*>::const_iterator edited_it = edited.begin(); edited_it != edited.end(); ++edited_it)
+	{
+		// each one only once, should it be listed twice
+		if (found.erase(*edited_it))
+		{
+			removed.push_back(*edited_it);
+		}
+	}
+	return removed;
+}
@@ -0,0 +1,63 @@
+/**
+ * @file llscrolllistsort.h
+ * @brief Keeps the rows of a sorted scroll list in order without full resorts
+ *
+ * $LicenseInfo:firstyear=2010&license=viewergpl$
+ *
+ * Copyright (c) 2010, Linden Research, Inc.
+ *
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ *
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ *
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ *
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLSCROLLLISTSORT_H
+#define LL_LLSCROLLLISTSORT_H
+
+#include <deque>
+#include <vector>
+#include <boost/function.hpp>
+
+class LLScrollListItem;
+
+// Moves rows of an LLScrollListCtrl into place with a binary search or a merge, so
+// that adding or editing some rows of a long sorted list doesn't sort all of it again.
+namespace LLScrollListSort
+{
+	typedef std::deque<LLScrollListItem*> item_list_t;
+	typedef boost::function<bool (const LLScrollListItem*, const LLScrollListItem*)> less_t;
+
+	// Inserts 'item' into the sorted 'items' behind any equal ones, where a stable
+	// sort would have put it.
+	void insertItem(item_list_t& items, LLScrollListItem* item, const less_t& less);
+
+	// Merges 'added' into the sorted 'items' in one pass, each behind any equal ones
+	// as insertItem() would put them one after the other.
+	void mergeItems(item_list_t& items, std::vector<LLScrollListItem*> added, const less_t& less);
+
+	// Takes the 'edited' items out of 'items' in one pass and returns the ones that
+	// were in it, in the order given. 'num_sorted' counts the leading items known to
+	// be in order and is kept right.
+	std::vector<LLScrollListItem*> removeItems(item_list_t& items, const std::vector<LLScrollListItem*>& edited, S32& num_sorted);
+}
+
+#endif // LL_LLSCROLLLISTSORT_H
@@ -294,6 +294,10 @@ LLTextEditor::LLTextEditor(
 	mLastContextMenuY(-1),
 	mReflowNeeded(FALSE),
 	mScrollNeeded(FALSE),
+	mHighlightDirtyStart(-1),
+	mHighlightDirtyEnd(0),
+	mHighlightDirtyDelta(0),
+	mHighlightFullRescan(TRUE),
 	mSpellCheckable(FALSE)
 {
 	mSourceID.generate();
@@ -628,6 +632,7 @@ BOOL LLTextEditor::truncate()
 			temp_utf8_text = utf8str_truncate( temp_utf8_text, mMaxTextByteLength );
 			mWText = utf8str_to_wstring( temp_utf8_text );
 			mTextIsUpToDate = FALSE;
+			mHighlightFullRescan = TRUE;
 			did_truncate = TRUE;
 		}
 	}
@@ -642,6 +647,7 @@ void LLTextEditor::setText(const LLStringExplicit &utf8str)
 	// mUTF8Text = utf8str;
 	mWText = utf8str_to_wstring(mUTF8Text);
 	mTextIsUpToDate = TRUE;
+	mHighlightFullRescan = TRUE;
 
 	truncate();
 	blockUndo();
@@ -659,6 +665,7 @@ void LLTextEditor::setWText(const LLWString &wtext)
 	mWText = wtext;
 	mUTF8Text.clear();
 	mTextIsUpToDate = FALSE;
+	mHighlightFullRescan = TRUE;
 
 	truncate();
 	blockUndo();
@@ -4149,6 +4156,7 @@ void LLTextEditor::appendText(const std::string &new_text, bool allow_undo, bool
 		S32 segment_end = getLength();
 		LLTextSegment* segment = new LLTextSegment(stylep, segment_start, segment_end );
 		mSegments.push_back(segment);
+		mHighlightFullRescan = TRUE;
 	}
 	
 	needsReflow();
@@ -4228,14 +4236,20 @@ S32 LLTextEditor::insertStringNoUndo(const S32 pos, const LLWString &wstr)
 		make_ui_sound("UISndBadKeystroke");
 		insert_len = mWText.length() - old_len;
 	}
+	else
+	{
+		markHighlightDirty(pos, 0, insert_len);
+	}
 
 	return insert_len;
 }
 
 S32 LLTextEditor::removeStringNoUndo(S32 pos, S32 length)
 {
+	S32 old_len = mWText.length();
 	mWText.erase(pos, length);
 	mTextIsUpToDate = FALSE;
+	markHighlightDirty(pos, old_len - (S32)mWText.length(), 0);
 	return -length;	// This will be wrong if someone calls removeStringNoUndo with an excessive length
 }
 
@@ -4247,9 +4261,34 @@ S32 LLTextEditor::overwriteCharNoUndo(S32 pos, llwchar wc)
 	}
 	mWText[pos] = wc;
 	mTextIsUpToDate = FALSE;
+	markHighlightDirty(pos, 1, 1);
 	return 1;
 }
 
+// Grows the pending highlight range to cover an edit replacing 'removed' characters at pos
+// with 'inserted' new ones.  Text past the range is unchanged apart from the shift by delta.
+void LLTextEditor::markHighlightDirty(S32 pos, S32 removed, S32 inserted)
+{
+	if (mHighlightDirtyStart < 0)
+	{
+		mHighlightDirtyStart = pos;
+		mHighlightDirtyEnd = pos + inserted;
+		mHighlightDirtyDelta = inserted - removed;
+		return;
+	}
+
+	if (mHighlightDirtyEnd >= pos + removed)
+	{
+		mHighlightDirtyEnd += inserted - removed;
+	}
+	else
+	{
+		mHighlightDirtyEnd = pos + inserted;
+	}
+	mHighlightDirtyStart = llmin(mHighlightDirtyStart, pos);
+	mHighlightDirtyDelta += inserted - removed;
+}
+
 //----------------------------------------------------------------------------
 
 void LLTextEditor::makePristine()
@@ -4337,6 +4376,8 @@ void LLTextEditor::loadKeywords(const std::string& filename,
 		}
 
 		mKeywords.findSegments( &mSegments, mWText, mDefaultColor );
+		mHighlightFullRescan = FALSE;
+		mHighlightDirtyStart = -1;
 
 		llassert( mSegments.front()->getStart() == 0 );
 		llassert( mSegments.back()->getEnd() == getLength() );
@@ -4348,7 +4389,18 @@ void LLTextEditor::updateSegments()
 	if (mKeywords.isLoaded())
 	{
 		// HACK:  No non-ascii keywords for now
-		mKeywords.findSegments(&mSegments, mWText, mDefaultColor);
+		if (mHighlightFullRescan || mSegments.empty() || mSegments.front()->getIsDefault())
+		{
+			mKeywords.findSegments(&mSegments, mWText, mDefaultColor);
+		}
+		else if (mHighlightDirtyStart >= 0)
+		{
+			// Only re-tokenize the lines touched since the last pass
+			mKeywords.updateSegments(&mSegments, mWText, mDefaultColor,
+									 mHighlightDirtyStart, mHighlightDirtyEnd, mHighlightDirtyDelta);
+		}
+		mHighlightFullRescan = FALSE;
+		mHighlightDirtyStart = -1;
 	}
 	else if (mAllowEmbeddedItems)
 	{
@@ -4635,6 +4687,8 @@ BOOL LLTextEditor::exportBuffer(std::string &buffer )
 //////////////////////////////////////////////////////////////////////////
 // LLTextSegment
 
+LL_DEFINE_POOL_ALLOCATOR(LLTextSegment);
+
 LLTextSegment::LLTextSegment(S32 start) :
 	mStart(start),
 	mEnd(0),
@@ -46,6 +46,7 @@
 
 #include "llpreeditor.h"
 #include "llmenugl.h"
+#include "llpoolallocator.h"
 
 class LLFontGL;
 class LLScrollbar;
@@ -215,7 +216,7 @@ public:
 	// Color support
 	void 			setCursorColor(const LLColor4& c)			{ mCursorColor = c; }
 	void 			setFgColor( const LLColor4& c )				{ mFgColor = c; }
-	void			setTextDefaultColor( const LLColor4& c )				{ mDefaultColor = c; }
+	void			setTextDefaultColor( const LLColor4& c )				{ mDefaultColor = c; mHighlightFullRescan = TRUE; }
 	void 			setReadOnlyFgColor( const LLColor4& c )		{ mReadOnlyFgColor = c; }
 	void 			setWriteableBgColor( const LLColor4& c )	{ mWriteableBgColor = c; }
 	void 			setReadOnlyBgColor( const LLColor4& c )		{ mReadOnlyBgColor = c; }
@@ -483,6 +484,7 @@ private:
 
 	void			updateSegments();
 	void			pruneSegments();
+	void			markHighlightDirty(S32 pos, S32 removed, S32 inserted);
 
 	void			drawBackground();
 	void			drawSelectionBackground();
@@ -570,6 +572,13 @@ private:
 	BOOL			mReflowNeeded;
 	BOOL			mScrollNeeded;
 
+	// Text edited since the keyword segments were last built, in current text positions, and
+	// the net change in length.  mHighlightDirtyStart < 0 means the segments are up to date.
+	S32				mHighlightDirtyStart;
+	S32				mHighlightDirtyEnd;
+	S32				mHighlightDirtyDelta;
+	BOOL			mHighlightFullRescan;
+
 	LLFrameTimer	mKeystrokeTimer;
 	LLFrameTimer	mSpellTimer;
 
@@ -610,6 +619,8 @@ private:
 class LLTextSegment
 {
 public:
+	LL_USE_POOL_ALLOCATOR(LLTextSegment);
+
 	// for creating a compare value
 	LLTextSegment(S32 start);
 	LLTextSegment( const LLStyleSP& style, S32 start, S32 end );
@@ -618,6 +629,7 @@ public:
 	LLTextSegment( const LLColor3& color, S32 start, S32 end );
 
 	S32					getStart() const					{ return mStart; }
+	void				setStart( S32 start )				{ mStart = start; }
 	S32					getEnd() const						{ return mEnd; }
 	void				setEnd( S32 end )					{ mEnd = end; }
 	const LLColor4&		getColor() const					{ return mStyle->getColor(); }
@@ -0,0 +1,245 @@
+/**
+ * @file llkeywords_test.cpp
+ * @brief Incremental highlighting tests and typing benchmark for LLKeywords
+ *
+ * $LicenseInfo:firstyear=2006&license=viewergpl$
+ *
+ * Copyright (c) 2006-2009, Linden Research, Inc.
+ *
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ *
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ *
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ *
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+// Class to test
+#include "../llkeywords.h"
+#include "../lltexteditor.h"
+#include "llstl.h"
+#include "lltimer.h"
+// Tut header
+#include "../test/lltut.h"
+#include "../test/lltestrand.h"
+
+// -------------------------------------------------------------------------------------------
+// Stubbing: Declarations required to link and run the class being tested
+// Notes:
+// * Add here stubbed implementation of the few classes and methods used in the class to be tested
+// * Add as little as possible (let the link errors guide you)
+// * Do not make any assumption as to how those classes or methods work (i.e. don't copy/paste code)
+// * A simulator for a class can be implemented here. Please comment and document thoroughly.
+
+LLColor3::LLColor3(const LLColor4& a) { }
+LLColor4::LLColor4(const LLColor3& vec, F32 a) { }
+
+// Segments only carry their range and token here, which is all the tests compare.
+LLTextSegment::LLTextSegment(S32 start) : mStart(start), mEnd(0), mToken(NULL), mIsDefault(FALSE) { }
+LLTextSegment::LLTextSegment(const LLColor4& color, S32 start, S32 end) : mStart(start), mEnd(end), mToken(NULL), mIsDefault(FALSE) { }
+LLTextSegment::LLTextSegment(const LLColor3& color, S32 start, S32 end) : mStart(start), mEnd(end), mToken(NULL), mIsDefault(FALSE) { }
+
+// End Stubbing
+// -------------------------------------------------------------------------------------------
+
+namespace
+{
+	typedef std::vector<LLTextSegment*> segment_list_t;
+
+	LLTestRand sRand(12345);
+
+	const char* SCRIPT_BLOCK =
+		"// Generated test block\n"
+		"integer gCount = 0;\n"
+		"/* block comment\n"
+		"   spanning \"several\" lines\n"
+		"*/\n"
+		"default\n"
+		"{\n"
+		"    state_entry()\n"
+		"    {\n"
+		"        string msg = \"escaped \\\" quote // not a comment\";\n"
+		"        if (gCount > 0) llSay(0, msg); // trailing comment\n"
+		"        return;\n"
+		"    }\n"
+		"}\n";
+
+	void clear_segments(segment_list_t& segs)
+	{
+		std::for_each(segs.begin(), segs.end(), DeletePointer());
+		segs.clear();
+	}
+}
+
+// -------------------------------------------------------------------------------------------
+// TUT
+// -------------------------------------------------------------------------------------------
+
+namespace tut
+{
+	// Test wrapper declarations
+	struct keywords_test
+	{
+		LLKeywords mKeywords;
+		LLColor4 mDefaultColor;
+		segment_list_t mIncremental;
+		segment_list_t mFull;
+
+		keywords_test()
+		{
+			const char* words[] = { "default", "state_entry", "llSay", "integer", "string", "if", "return" };
+			for (U32 i = 0; i < LL_ARRAY_SIZE(words); i++)
+			{
+				mKeywords.addToken(LLKeywordToken::WORD, words[i], LLColor3(1.f, 0.f, 0.f));
+			}
+			mKeywords.addToken(LLKeywordToken::ONE_SIDED_DELIMITER, "//", LLColor3(0.f, 1.f, 0.f));
+			mKeywords.addToken(LLKeywordToken::TWO_SIDED_DELIMITER, "/*", LLColor3(0.f, 1.f, 0.f));
+			mKeywords.addToken(LLKeywordToken::TWO_SIDED_DELIMITER, "\"", LLColor3(0.f, 0.f, 1.f));
+		}
+		~keywords_test()
+		{
+			clear_segments(mIncremental);
+			clear_segments(mFull);
+		}
+
+		LLWString makeScript(S32 min_length)
+		{
+			std::string text;
+			while ((S32)text.size() < min_length)
+			{
+				text += SCRIPT_BLOCK;
+			}
+			return utf8str_to_wstring(text);
+		}
+
+		bool sameSegments(const segment_list_t& a, const segment_list_t& b)
+		{
+			if (a.size() != b.size())
+			{
+				return false;
+			}
+			for (U32 i = 0; i < a.size(); i++)
+			{
+				if (a[i]->getStart() != b[i]->getStart()
+					|| a[i]->getEnd() != b[i]->getEnd()
+					|| a[i]->getToken() != b[i]->getToken())
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+	};
+
+	// Tut templating thingamagic: test group, object and test instance
+	typedef test_group<keywords_test> keywords_t;
+	typedef keywords_t::object keywords_object_t;
+	tut::keywords_t tut_keywords("keywords");
+
+	template<> template<>
+	void keywords_object_t::test<1>()
+	{
+		// Compiled word table finds exactly the registered words
+		LLWString text = utf8str_to_wstring("llSay llSayX integer _integer string");
+		mKeywords.findSegments(&mFull, text, mDefaultColor);
+
+		S32 tokens = 0;
+		for (U32 i = 0; i < mFull.size(); i++)
+		{
+			if (mFull[i]->getToken())
+			{
+				tokens++;
+			}
+		}
+		ensure_equals("LLKeywords: keyword matches", tokens, 3);
+		ensure_equals("LLKeywords: segments cover the text", mFull.back()->getEnd(), (S32)text.size());
+	}
+
+	template<> template<>
+	void keywords_object_t::test<2>()
+	{
+		// Random edits, including delimiter characters that open and close block comments and
+		// strings across lines, must give the same segments as a full rescan.
+		const char EDIT_CHARS[] = "ab_ /*\"\\\n";
+		LLWString text = makeScript(4096);
+		mKeywords.findSegments(&mIncremental, text, mDefaultColor);
+
+		for (S32 i = 0; i < 2000; i++)
+		{
+			S32 pos = sRand.next(text.size() + 1);
+			S32 removed = 0;
+			S32 inserted = 0;
+			if (text.empty() || sRand.next(3))
+			{
+				text.insert(pos, 1, (llwchar)EDIT_CHARS[sRand.next(sizeof(EDIT_CHARS) - 1)]);
+				inserted = 1;
+			}
+			else
+			{
+				pos = llmin(pos, (S32)text.size() - 1);
+				removed = llmin((S32)sRand.next(4) + 1, (S32)text.size() - pos);
+				text.erase(pos, removed);
+			}
+
+			mKeywords.updateSegments(&mIncremental, text, mDefaultColor, pos, pos + inserted, inserted - removed);
+			mKeywords.findSegments(&mFull, text, mDefaultColor);
+			ensure("LLKeywords: incremental segments match full scan", sameSegments(mIncremental, mFull));
+		}
+	}
+
+	template<> template<>
+	void keywords_object_t::test<3>()
+	{
+		// Benchmark: type a line into the middle of a 64KB script, re-highlighting after every
+		// keystroke, both incrementally and with a full rescan.
+		const std::string typed = "        llSay(0, \"typing into a large script\"); // done\n";
+		LLWString text = makeScript(64 * 1024);
+		LLWString full_text = text;
+		S32 pos = text.size() / 2;
+		while (text[pos - 1] != '\n')
+		{
+			pos++;
+		}
+
+		mKeywords.findSegments(&mIncremental, text, mDefaultColor);
+		LLTimer timer;
+		for (U32 i = 0; i < typed.size(); i++)
+		{
+			text.insert(pos + i, 1, (llwchar)typed[i]);
+			mKeywords.updateSegments(&mIncremental, text, mDefaultColor, pos + i, pos + i + 1, 1);
+		}
+		F64 incremental_time = timer.getElapsedTimeF64();
+
+		timer.reset();
+		for (U32 i = 0; i < typed.size(); i++)
+		{
+			full_text.insert(pos + i, 1, (llwchar)typed[i]);
+			mKeywords.findSegments(&mFull, full_text, mDefaultColor);
+		}
+		F64 full_time = timer.getElapsedTimeF64();
+
+		llinfos << "LLKeywords: typed " << typed.size() << " chars into " << text.size()
+				<< " char script: incremental " << incremental_time * 1000.0 << " ms, full rescan "
+				<< full_time * 1000.0 << " ms" << llendl;
+
+		ensure("LLKeywords: benchmark segments match full scan", sameSegments(mIncremental, mFull));
+		ensure("LLKeywords: incremental highlighting slower than full rescan", incremental_time < full_time);
+	}
+}
@@ -0,0 +1,213 @@
+/**
+ * @file llscrolllistsort_test.cpp
+ * @brief Tests for moving scroll list rows into sort order without full resorts
+ *
+ * $LicenseInfo:firstyear=2010&license=viewergpl$
+ *
+ * Copyright (c) 2010, Linden Research, Inc.
+ *
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ *
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ *
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ *
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+// Class to test
+#include "../llscrolllistsort.h"
+// Tut header
+#include "../test/lltut.h"
+
+#include <algorithm>
+
+// -------------------------------------------------------------------------------------------
+// Stubbing: Declarations required to link and run the class being tested
+// Notes:
+// * Add here stubbed implementation of the few classes and methods used in the class to be tested
+// * Add as little as possible (let the link errors guide you)
+// * Do not make any assumption as to how those classes or methods work (i.e. don't copy/paste code)
+// * A simulator for a class can be implemented here. Please comment and document thoroughly.
+
+// The sort helpers only move item pointers around and compare them through the functor
+// they are given. This stand-in row carries a sort key, and its id tells equal rows apart.
+class LLScrollListItem
+{
+public:
+	LLScrollListItem(S32 key, S32 id) : mKey(key), mID(id) { }
+	S32 mKey;
+	S32 mID;
+};
+
+// End Stubbing
+// -------------------------------------------------------------------------------------------
+
+namespace
+{
+	bool less_key(const LLScrollListItem* a, const LLScrollListItem* b)
+	{
+		return a->mKey < b->mKey;
+	}
+}
+
+namespace tut
+{
+	struct scrolllistsort_data
+	{
+		~scrolllistsort_data()
+		{
+			for (U32 i = 0; i < mItems.size(); ++i)
+			{
+				delete mItems[i];
+			}
+		}
+
+		// Rows with keys repeating in a scrambled order, so that there are equal keys
+		void makeItems(S32 count)
+		{
+			for (S32 i = 0; i < count; ++i)
+			{
+				mItems.push_back(new LLScrollListItem((i * 37) % 11, i));
+			}
+		}
+
+		void ensureInOrder(const char* msg, const LLScrollListSort::item_list_t& items)
+		{
+			for (U32 i = 1; i < items.size(); ++i)
+			{
+				ensure(msg, !less_key(items[i], items[i - 1]));
+			}
+		}
+
+		std::vector<LLScrollListItem*> mItems;
+	};
+
+	typedef test_group<scrolllistsort_data> scrolllistsort_test;
+	typedef scrolllistsort_test::object scrolllistsort_object;
+	tut::scrolllistsort_test tscrolllistsort("LLScrollListSort");
+
+	template<> template<>
+	void scrolllistsort_object::test<1>()
+	{
+		// Inserting one row at a time gives the same order as a stable sort of them all,
+		// which is what adding rows with ADD_SORTED used to do.
+		makeItems(200);
+		LLScrollListSort::item_list_t inserted;
+		for (U32 i = 0; i < mItems.size(); ++i)
+		{
+			LLScrollListSort::insertItem(inserted, mItems[i], less_key);
+		}
+
+		std::vector<LLScrollListItem*> sorted(mItems);
+		std::stable_sort(sorted.begin(), sorted.end(), less_key);
+		ensure_equals("all rows inserted", inserted.size(), sorted.size());
+		for (U32 i = 0; i < sorted.size(); ++i)
+		{
+			ensure_equals("same row as the stable sort", inserted[i]->mID, sorted[i]->mID);
+		}
+	}
+
+	template<> template<>
+	void scrolllistsort_object::test<2>()
+	{
+		// Removing rows keeps the count of sorted leading rows right, and rows that
+		// aren't in the list are left out of the result.
+		makeItems(10);
+		LLScrollListSort::item_list_t items(mItems.begin(), mItems.end());
+		LLScrollListItem missing(0, 100);
+
+		std::vector<LLScrollListItem*> edited;
+		edited.push_back(mItems[1]);
+		edited.push_back(&missing);
+		edited.push_back(mItems[8]);
+		edited.push_back(mItems[3]);
+
+		S32 num_sorted = 5;
+		std::vector<LLScrollListItem*> removed = LLScrollListSort::removeItems(items, edited, num_sorted);
+		ensure_equals("found rows returned", removed.size(), (size_t)3);
+		ensure_equals("in the order given", removed[1]->mID, 8);
+		ensure_equals("rows taken out", items.size(), (size_t)7);
+		ensure_equals("only rows from the sorted part count", num_sorted, 3);
+		for (U32 i = 0; i < items.size(); ++i)
+		{
+			ensure("removed row gone", items[i] != mItems[1] && items[i] != mItems[3] && items[i] != mItems[8]);
+		}
+	}
+
+	template<> template<>
+	void scrolllistsort_object::test<3>()
+	{
+		// Rows whose sort key was edited in place go back into order by taking them out
+		// and merging them in again, as LLScrollListCtrl::resortItems() does.
+		makeItems(100);
+		LLScrollListSort::item_list_t items;
+		for (U32 i = 0; i < mItems.size(); ++i)
+		{
+			LLScrollListSort::insertItem(items, mItems[i], less_key);
+		}
+
+		std::vector<LLScrollListItem*> edited;
+		for (U32 i = 0; i < mItems.size(); i += 7)
+		{
+			mItems[i]->mKey = 20 - mItems[i]->mKey;
+			edited.push_back(mItems[i]);
+		}
+		S32 num_sorted = items.size();
+		std::vector<LLScrollListItem*> removed = LLScrollListSort::removeItems(items, edited, num_sorted);
+		ensure_equals("sorted rows left", num_sorted, (S32)items.size());
+		ensureInOrder("rest still in order", items);
+		LLScrollListSort::mergeItems(items, removed, less_key);
+		ensure_equals("no rows lost", items.size(), mItems.size());
+		ensureInOrder("back in order", items);
+	}
+
+	template<> template<>
+	void scrolllistsort_object::test<4>()
+	{
+		// Merging many rows at once puts them where inserting them one after the
+		// other would, equal keys included.
+		makeItems(300);
+		LLScrollListSort::item_list_t merged;
+		LLScrollListSort::item_list_t inserted;
+		std::vector<LLScrollListItem*> added;
+		for (U32 i = 0; i < mItems.size(); ++i)
+		{
+			if (i % 3)
+			{
+				added.push_back(mItems[i]);
+			}
+			else
+			{
+				LLScrollListSort::insertItem(merged, mItems[i], less_key);
+				LLScrollListSort::insertItem(inserted, mItems[i], less_key);
+			}
+		}
+		LLScrollListSort::mergeItems(merged, added, less_key);
+		for (U32 i = 0; i < added.size(); ++i)
+		{
+			LLScrollListSort::insertItem(inserted, added[i], less_key);
+		}
+		ensure_equals("all rows merged", merged.size(), inserted.size());
+		for (U32 i = 0; i < merged.size(); ++i)
+		{
+			ensure_equals("same row as inserting one by one", merged[i]->mID, inserted[i]->mID);
+		}
+	}
+}
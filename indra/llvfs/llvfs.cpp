@@ -104,6 +104,8 @@ bool LLVFSFileSpecifier::operator==(const LLVFSFileSpecifier &rhs) const
     
     
 
+LL_DEFINE_POOL_ALLOCATOR(LLVFSFileBlock);
+
 LLVFSFileBlock::LLVFSFileBlock() : LLVFSBlock(),  LLVFSFileSpecifier()
 {
 	init();
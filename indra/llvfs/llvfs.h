@@ -38,6 +38,7 @@
 #include "linked_lists.h"
 #include "llassettype.h"
 #include "llthread.h"
+#include "llpoolallocator.h"
 
 enum EVFSValid 
 {
@@ -93,6 +94,8 @@ public:
 class LLVFSFileBlock : public LLVFSBlock, public LLVFSFileSpecifier
 {
 public:
+	LL_USE_POOL_ALLOCATOR(LLVFSFileBlock);
+
 	LLVFSFileBlock();
 	LLVFSFileBlock(const LLUUID &file_id, LLAssetType::EType file_type, U32 loc = 0, S32 size = 0);
 	void init();
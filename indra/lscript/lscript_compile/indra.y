@@ -11,13 +11,9 @@
 	#include "linden_common.h"
 	#include "lscript_tree.h"
 
-    #ifdef __cplusplus
-    extern "C" {
-    #endif
-
-	int yylex(void);
-	int yyparse( void );
-	int yyerror(const char *fmt, ...);
+	// Tokens come from the list lscript_compile() scanned beforehand rather than
+	// straight from the flex scanner, see lscript_next_token() in indra.l.
+	#define yylex lscript_next_token
 
     #if LL_LINUX
     // broken yacc codegen...  --ryan.
@@ -28,12 +24,11 @@
 	#pragma warning (disable : 4702) // warning C4702: unreachable code
 	#pragma warning( disable : 4065 )	// warning: switch statement contains 'default' but no 'case' labels
 	#endif
-
-    #ifdef __cplusplus
-    }
-    #endif
 %}
 
+// Keep the parser state on the stack so that several threads can compile at once.
+%define api.pure
+
 %union
 {
 	S32								ival;
@@ -55,6 +50,12 @@
 	class LLScriptScript			*script;
 };
 
+%{
+	int lscript_next_token(YYSTYPE* lvalp);
+	int yyparse(void);
+	int yyerror(const char *fmt, ...);
+%}
+
 %token					INTEGER
 %token					FLOAT_TYPE
 %token					STRING
@@ -114,6 +115,10 @@
 
 %token <sval>			STRING_CONSTANT
 
+// Names and strings the parser throws away on a syntax error; the ones
+// it reduces belong to the tree.
+%destructor { delete [] $$; } <sval>
+
 %token					INC_OP
 %token					DEC_OP
 %token					ADD_ASSIGN
@@ -2587,13 +2587,15 @@ void parse_string();
 
 #define ECHO do { } while (0)
 
-#if defined(__cplusplus)
-extern "C" { int yylex(void ); }
-extern "C" { int yyparse( void ); }
-extern "C" { int yyerror(const char *fmt, ...); }
-#endif
+int yylex(void);
+int yyparse(void);
+int yyerror(const char *fmt, ...);
 
-#line 2597 "indra_generated.l.cpp"
+// Token values from the scanner.  The parser is pure and gets them through
+// lscript_next_token() instead, this is only touched while scanning.
+static YYSTYPE yylval;
+
+#line 2599 "indra_generated.l.cpp"
 
 #define INITIAL 0
 
@@ -2780,9 +2782,9 @@ YY_DECL
 	register char *yy_cp, *yy_bp;
 	register int yy_act;
     
-#line 68 "indra.l"
+#line 70 "indra.l"
 
-#line 2786 "indra_generated.l.cpp"
+#line 2788 "indra_generated.l.cpp"
 
 	if ( !(yy_init) )
 		{
@@ -2867,2687 +2869,2687 @@ do_action:	/* This label is used only to access EOF actions. */
 
 case 1:
 YY_RULE_SETUP
-#line 69 "indra.l"
+#line 71 "indra.l"
 { gInternalLine++; gInternalColumn = 0; line_comment(); }
 	YY_BREAK
 case 2:
 YY_RULE_SETUP
-#line 70 "indra.l"
+#line 72 "indra.l"
 { block_comment(); }
 	YY_BREAK
 case 3:
 YY_RULE_SETUP
-#line 72 "indra.l"
+#line 74 "indra.l"
 { count(); return(INTEGER); }
 	YY_BREAK
 case 4:
 YY_RULE_SETUP
-#line 73 "indra.l"
+#line 75 "indra.l"
 { count(); return(FLOAT_TYPE); }
 	YY_BREAK
 case 5:
 YY_RULE_SETUP
-#line 74 "indra.l"
+#line 76 "indra.l"
 { count(); return(STRING); }
 	YY_BREAK
 case 6:
 YY_RULE_SETUP
-#line 75 "indra.l"
+#line 77 "indra.l"
 { count(); return(LLKEY); }
 	YY_BREAK
 case 7:
 YY_RULE_SETUP
-#line 76 "indra.l"
+#line 78 "indra.l"
 { count(); return(VECTOR); }
 	YY_BREAK
 case 8:
 YY_RULE_SETUP
-#line 77 "indra.l"
+#line 79 "indra.l"
 { count(); return(QUATERNION); }
 	YY_BREAK
 case 9:
 YY_RULE_SETUP
-#line 78 "indra.l"
+#line 80 "indra.l"
 { count(); return(QUATERNION); }
 	YY_BREAK
 case 10:
 YY_RULE_SETUP
-#line 79 "indra.l"
+#line 81 "indra.l"
 { count(); return(LIST); }
 	YY_BREAK
 case 11:
 YY_RULE_SETUP
-#line 81 "indra.l"
+#line 83 "indra.l"
 { count(); yylval.sval = new char[strlen(yytext) + 1]; strcpy(yylval.sval, yytext); return(STATE_DEFAULT); }
 	YY_BREAK
 case 12:
 YY_RULE_SETUP
-#line 82 "indra.l"
+#line 84 "indra.l"
 { count(); return(STATE); }
 	YY_BREAK
 case 13:
 YY_RULE_SETUP
-#line 83 "indra.l"
+#line 85 "indra.l"
 { count(); return(EVENT); }
 	YY_BREAK
 case 14:
 YY_RULE_SETUP
-#line 84 "indra.l"
+#line 86 "indra.l"
 { count(); return(JUMP); }
 	YY_BREAK
 case 15:
 YY_RULE_SETUP
-#line 85 "indra.l"
+#line 87 "indra.l"
 { count(); return(RETURN); }
 	YY_BREAK
 case 16:
 YY_RULE_SETUP
-#line 86 "indra.l"
+#line 88 "indra.l"
 { count(); return(IF); }
 	YY_BREAK
 case 17:
 YY_RULE_SETUP
-#line 87 "indra.l"
+#line 89 "indra.l"
 { count(); return(ELSE); }
 	YY_BREAK
 case 18:
 YY_RULE_SETUP
-#line 88 "indra.l"
+#line 90 "indra.l"
 { count(); return(FOR); }
 	YY_BREAK
 case 19:
 YY_RULE_SETUP
-#line 89 "indra.l"
+#line 91 "indra.l"
 { count(); return(DO); }
 	YY_BREAK
 case 20:
 YY_RULE_SETUP
-#line 90 "indra.l"
+#line 92 "indra.l"
 { count(); return(WHILE); }
 	YY_BREAK
 case 21:
 YY_RULE_SETUP
-#line 92 "indra.l"
+#line 94 "indra.l"
 { count(); return(STATE_ENTRY); }
 	YY_BREAK
 case 22:
 YY_RULE_SETUP
-#line 93 "indra.l"
+#line 95 "indra.l"
 { count(); return(STATE_EXIT); }
 	YY_BREAK
 case 23:
 YY_RULE_SETUP
-#line 94 "indra.l"
+#line 96 "indra.l"
 { count(); return(TOUCH_START); }
 	YY_BREAK
 case 24:
 YY_RULE_SETUP
-#line 95 "indra.l"
+#line 97 "indra.l"
 { count(); return(TOUCH); }
 	YY_BREAK
 case 25:
 YY_RULE_SETUP
-#line 96 "indra.l"
+#line 98 "indra.l"
 { count(); return(TOUCH_END); }
 	YY_BREAK
 case 26:
 YY_RULE_SETUP
-#line 97 "indra.l"
+#line 99 "indra.l"
 { count(); return(COLLISION_START); }
 	YY_BREAK
 case 27:
 YY_RULE_SETUP
-#line 98 "indra.l"
+#line 100 "indra.l"
 { count(); return(COLLISION); }
 	YY_BREAK
 case 28:
 YY_RULE_SETUP
-#line 99 "indra.l"
+#line 101 "indra.l"
 { count(); return(COLLISION_END); }
 	YY_BREAK
 case 29:
 YY_RULE_SETUP
-#line 100 "indra.l"
+#line 102 "indra.l"
 { count(); return(LAND_COLLISION_START); }
 	YY_BREAK
 case 30:
 YY_RULE_SETUP
-#line 101 "indra.l"
+#line 103 "indra.l"
 { count(); return(LAND_COLLISION); }
 	YY_BREAK
 case 31:
 YY_RULE_SETUP
-#line 102 "indra.l"
+#line 104 "indra.l"
 { count(); return(LAND_COLLISION_END); }
 	YY_BREAK
 case 32:
 YY_RULE_SETUP
-#line 103 "indra.l"
+#line 105 "indra.l"
 { count(); return(TIMER); }
 	YY_BREAK
 case 33:
 YY_RULE_SETUP
-#line 104 "indra.l"
+#line 106 "indra.l"
 { count(); return(CHAT); }
 	YY_BREAK
 case 34:
 YY_RULE_SETUP
-#line 105 "indra.l"
+#line 107 "indra.l"
 { count(); return(SENSOR); }
 	YY_BREAK
 case 35:
 YY_RULE_SETUP
-#line 106 "indra.l"
+#line 108 "indra.l"
 { count(); return(NO_SENSOR); }
 	YY_BREAK
 case 36:
 YY_RULE_SETUP
-#line 107 "indra.l"
+#line 109 "indra.l"
 { count(); return(CONTROL); }
 	YY_BREAK
 case 37:
 YY_RULE_SETUP
-#line 108 "indra.l"
+#line 110 "indra.l"
 { count(); return(PRINT); }
 	YY_BREAK
 case 38:
 YY_RULE_SETUP
-#line 109 "indra.l"
+#line 111 "indra.l"
 { count(); return(AT_TARGET); }
 	YY_BREAK
 case 39:
 YY_RULE_SETUP
-#line 110 "indra.l"
+#line 112 "indra.l"
 { count(); return(NOT_AT_TARGET); }
 	YY_BREAK
 case 40:
 YY_RULE_SETUP
-#line 111 "indra.l"
+#line 113 "indra.l"
 { count(); return(AT_ROT_TARGET); }
 	YY_BREAK
 case 41:
 YY_RULE_SETUP
-#line 112 "indra.l"
+#line 114 "indra.l"
 { count(); return(NOT_AT_ROT_TARGET); }
 	YY_BREAK
 case 42:
 YY_RULE_SETUP
-#line 113 "indra.l"
+#line 115 "indra.l"
 { count(); return(MONEY); }
 	YY_BREAK
 case 43:
 YY_RULE_SETUP
-#line 114 "indra.l"
+#line 116 "indra.l"
 { count(); return(EMAIL); }
 	YY_BREAK
 case 44:
 YY_RULE_SETUP
-#line 115 "indra.l"
+#line 117 "indra.l"
 { count(); return(RUN_TIME_PERMISSIONS); }
 	YY_BREAK
 case 45:
 YY_RULE_SETUP
-#line 116 "indra.l"
+#line 118 "indra.l"
 { count(); return(INVENTORY); }
 	YY_BREAK
 case 46:
 YY_RULE_SETUP
-#line 117 "indra.l"
+#line 119 "indra.l"
 { count(); return(ATTACH); }
 	YY_BREAK
 case 47:
 YY_RULE_SETUP
-#line 118 "indra.l"
+#line 120 "indra.l"
 { count(); return(DATASERVER); }
 	YY_BREAK
 case 48:
 YY_RULE_SETUP
-#line 119 "indra.l"
+#line 121 "indra.l"
 { count(); return(MOVING_START); }
 	YY_BREAK
 case 49:
 YY_RULE_SETUP
-#line 120 "indra.l"
+#line 122 "indra.l"
 { count(); return(MOVING_END); }
 	YY_BREAK
 case 50:
 YY_RULE_SETUP
-#line 121 "indra.l"
+#line 123 "indra.l"
 { count(); return(LINK_MESSAGE); }
 	YY_BREAK
 case 51:
 YY_RULE_SETUP
-#line 122 "indra.l"
+#line 124 "indra.l"
 { count(); return(REZ); }
 	YY_BREAK
 case 52:
 YY_RULE_SETUP
-#line 123 "indra.l"
+#line 125 "indra.l"
 { count(); return(OBJECT_REZ); }
 	YY_BREAK
 case 53:
 YY_RULE_SETUP
-#line 124 "indra.l"
+#line 126 "indra.l"
 { count(); return(REMOTE_DATA); }
 	YY_BREAK
 case 54:
 YY_RULE_SETUP
-#line 125 "indra.l"
+#line 127 "indra.l"
 { count(); return(HTTP_RESPONSE); }
 	YY_BREAK
 case 55:
 YY_RULE_SETUP
-#line 126 "indra.l"
+#line 128 "indra.l"
 { count(); return(HTTP_REQUEST); }
 	YY_BREAK
 case 56:
 YY_RULE_SETUP
-#line 127 "indra.l"
+#line 129 "indra.l"
 { count(); return(PERIOD); }
 	YY_BREAK
 case 57:
 YY_RULE_SETUP
-#line 130 "indra.l"
+#line 132 "indra.l"
 { count(); yylval.ival = strtoul(yytext, NULL, 0);  return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 58:
 YY_RULE_SETUP
-#line 131 "indra.l"
+#line 133 "indra.l"
 { count(); yylval.ival = strtoul(yytext, NULL, 10); return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 59:
 YY_RULE_SETUP
-#line 132 "indra.l"
+#line 134 "indra.l"
 { count(); yylval.ival = 1; return(INTEGER_TRUE); }
 	YY_BREAK
 case 60:
 YY_RULE_SETUP
-#line 133 "indra.l"
+#line 135 "indra.l"
 { count(); yylval.ival = 0; return(INTEGER_FALSE); }
 	YY_BREAK
 case 61:
 YY_RULE_SETUP
-#line 134 "indra.l"
+#line 136 "indra.l"
 { count(); yylval.ival = 0x1; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 62:
 YY_RULE_SETUP
-#line 135 "indra.l"
+#line 137 "indra.l"
 { count(); yylval.ival = 0x2; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 63:
 YY_RULE_SETUP
-#line 136 "indra.l"
+#line 138 "indra.l"
 { count(); yylval.ival = 0x4; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 64:
 YY_RULE_SETUP
-#line 137 "indra.l"
+#line 139 "indra.l"
 { count(); yylval.ival = 0x8; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 65:
 YY_RULE_SETUP
-#line 138 "indra.l"
+#line 140 "indra.l"
 { count(); yylval.ival = 0x10; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 66:
 YY_RULE_SETUP
-#line 139 "indra.l"
+#line 141 "indra.l"
 { count(); yylval.ival = 0x20; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 67:
 YY_RULE_SETUP
-#line 140 "indra.l"
+#line 142 "indra.l"
 { count(); yylval.ival = 0x40; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 68:
 YY_RULE_SETUP
-#line 141 "indra.l"
+#line 143 "indra.l"
 { count(); yylval.ival = 0x80; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 69:
 YY_RULE_SETUP
-#line 142 "indra.l"
+#line 144 "indra.l"
 { count(); yylval.ival = 0x100; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 70:
 YY_RULE_SETUP
-#line 143 "indra.l"
+#line 145 "indra.l"
 { count(); yylval.ival = 0x200; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 71:
 YY_RULE_SETUP
-#line 145 "indra.l"
+#line 147 "indra.l"
 { count(); yylval.ival = AGENT_FLYING; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 72:
 YY_RULE_SETUP
-#line 146 "indra.l"
+#line 148 "indra.l"
 { count(); yylval.ival = AGENT_ATTACHMENTS; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 73:
 YY_RULE_SETUP
-#line 147 "indra.l"
+#line 149 "indra.l"
 { count(); yylval.ival = AGENT_SCRIPTED; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 74:
 YY_RULE_SETUP
-#line 148 "indra.l"
+#line 150 "indra.l"
 { count(); yylval.ival = AGENT_MOUSELOOK; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 75:
 YY_RULE_SETUP
-#line 149 "indra.l"
+#line 151 "indra.l"
 { count(); yylval.ival = AGENT_SITTING; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 76:
 YY_RULE_SETUP
-#line 150 "indra.l"
+#line 152 "indra.l"
 { count(); yylval.ival = AGENT_ON_OBJECT; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 77:
 YY_RULE_SETUP
-#line 151 "indra.l"
+#line 153 "indra.l"
 { count(); yylval.ival = AGENT_AWAY; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 78:
 YY_RULE_SETUP
-#line 152 "indra.l"
+#line 154 "indra.l"
 { count(); yylval.ival = AGENT_WALKING; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 79:
 YY_RULE_SETUP
-#line 153 "indra.l"
+#line 155 "indra.l"
 { count(); yylval.ival = AGENT_IN_AIR; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 80:
 YY_RULE_SETUP
-#line 154 "indra.l"
+#line 156 "indra.l"
 { count(); yylval.ival = AGENT_TYPING; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 81:
 YY_RULE_SETUP
-#line 155 "indra.l"
+#line 157 "indra.l"
 { count(); yylval.ival = AGENT_CROUCHING; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 82:
 YY_RULE_SETUP
-#line 156 "indra.l"
+#line 158 "indra.l"
 { count(); yylval.ival = AGENT_BUSY; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 83:
 YY_RULE_SETUP
-#line 157 "indra.l"
+#line 159 "indra.l"
 { count(); yylval.ival = AGENT_ALWAYS_RUN; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 84:
 YY_RULE_SETUP
-#line 159 "indra.l"
+#line 161 "indra.l"
 { count(); yylval.ival = FOLLOWCAM_PITCH; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 85:
 YY_RULE_SETUP
-#line 160 "indra.l"
+#line 162 "indra.l"
 { count(); yylval.ival = FOLLOWCAM_FOCUS_OFFSET; return (INTEGER_CONSTANT); }
 	YY_BREAK
 case 86:
 YY_RULE_SETUP
-#line 161 "indra.l"
+#line 163 "indra.l"
 { count(); yylval.ival = FOLLOWCAM_POSITION_LAG; return (INTEGER_CONSTANT); }
 	YY_BREAK
 case 87:
 YY_RULE_SETUP
-#line 162 "indra.l"
+#line 164 "indra.l"
 { count(); yylval.ival = FOLLOWCAM_FOCUS_LAG; return (INTEGER_CONSTANT); }
 	YY_BREAK
 case 88:
 YY_RULE_SETUP
-#line 163 "indra.l"
+#line 165 "indra.l"
 { count(); yylval.ival = FOLLOWCAM_DISTANCE; return (INTEGER_CONSTANT); }
 	YY_BREAK
 case 89:
 YY_RULE_SETUP
-#line 164 "indra.l"
+#line 166 "indra.l"
 { count(); yylval.ival = FOLLOWCAM_BEHINDNESS_ANGLE; return (INTEGER_CONSTANT); }
 	YY_BREAK
 case 90:
 YY_RULE_SETUP
-#line 165 "indra.l"
+#line 167 "indra.l"
 { count(); yylval.ival = FOLLOWCAM_BEHINDNESS_LAG; return (INTEGER_CONSTANT); }
 	YY_BREAK
 case 91:
 YY_RULE_SETUP
-#line 166 "indra.l"
+#line 168 "indra.l"
 { count(); yylval.ival = FOLLOWCAM_POSITION_THRESHOLD; return (INTEGER_CONSTANT); }
 	YY_BREAK
 case 92:
 YY_RULE_SETUP
-#line 167 "indra.l"
+#line 169 "indra.l"
 { count(); yylval.ival = FOLLOWCAM_FOCUS_THRESHOLD; return (INTEGER_CONSTANT); }
 	YY_BREAK
 case 93:
 YY_RULE_SETUP
-#line 168 "indra.l"
+#line 170 "indra.l"
 { count(); yylval.ival = FOLLOWCAM_ACTIVE; return (INTEGER_CONSTANT); }
 	YY_BREAK
 case 94:
 YY_RULE_SETUP
-#line 169 "indra.l"
+#line 171 "indra.l"
 { count(); yylval.ival = FOLLOWCAM_POSITION; return (INTEGER_CONSTANT); }
 	YY_BREAK
 case 95:
 YY_RULE_SETUP
-#line 170 "indra.l"
+#line 172 "indra.l"
 { count(); yylval.ival = FOLLOWCAM_FOCUS; return (INTEGER_CONSTANT); }
 	YY_BREAK
 case 96:
 YY_RULE_SETUP
-#line 171 "indra.l"
+#line 173 "indra.l"
 { count(); yylval.ival = FOLLOWCAM_POSITION_LOCKED; return (INTEGER_CONSTANT); }
 	YY_BREAK
 case 97:
 YY_RULE_SETUP
-#line 172 "indra.l"
+#line 174 "indra.l"
 { count(); yylval.ival = FOLLOWCAM_FOCUS_LOCKED; return (INTEGER_CONSTANT); }
 	YY_BREAK
 case 98:
 YY_RULE_SETUP
-#line 174 "indra.l"
+#line 176 "indra.l"
 { count(); yylval.ival = 0x1; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 99:
 YY_RULE_SETUP
-#line 175 "indra.l"
+#line 177 "indra.l"
 { count(); yylval.ival = 0x2; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 100:
 YY_RULE_SETUP
-#line 176 "indra.l"
+#line 178 "indra.l"
 { count(); yylval.ival = 0x4; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 101:
 YY_RULE_SETUP
-#line 177 "indra.l"
+#line 179 "indra.l"
 { count(); yylval.ival = 0x8; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 102:
 YY_RULE_SETUP
-#line 178 "indra.l"
+#line 180 "indra.l"
 { count(); yylval.ival = 0x10; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 103:
 YY_RULE_SETUP
-#line 179 "indra.l"
+#line 181 "indra.l"
 { count(); yylval.ival = 0x20; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 104:
 YY_RULE_SETUP
-#line 180 "indra.l"
+#line 182 "indra.l"
 { count(); yylval.ival = 0x40; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 105:
 YY_RULE_SETUP
-#line 182 "indra.l"
+#line 184 "indra.l"
 { count(); yylval.ival = LSL_ALL_SIDES; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 106:
 YY_RULE_SETUP
-#line 183 "indra.l"
+#line 185 "indra.l"
 { count(); yylval.ival = LSL_LINK_ROOT; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 107:
 YY_RULE_SETUP
-#line 184 "indra.l"
+#line 186 "indra.l"
 { count(); yylval.ival = LSL_LINK_SET; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 108:
 YY_RULE_SETUP
-#line 185 "indra.l"
+#line 187 "indra.l"
 { count(); yylval.ival = LSL_LINK_ALL_OTHERS; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 109:
 YY_RULE_SETUP
-#line 186 "indra.l"
+#line 188 "indra.l"
 { count(); yylval.ival = LSL_LINK_ALL_CHILDREN; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 110:
 YY_RULE_SETUP
-#line 187 "indra.l"
+#line 189 "indra.l"
 { count(); yylval.ival = LSL_LINK_THIS; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 111:
 YY_RULE_SETUP
-#line 189 "indra.l"
+#line 191 "indra.l"
 { count(); yylval.ival = 0x1; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 112:
 YY_RULE_SETUP
-#line 190 "indra.l"
+#line 192 "indra.l"
 { count(); yylval.ival = 0x2; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 113:
 YY_RULE_SETUP
-#line 191 "indra.l"
+#line 193 "indra.l"
 { count(); yylval.ival = 0x4; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 114:
 YY_RULE_SETUP
-#line 192 "indra.l"
+#line 194 "indra.l"
 { count(); yylval.ival = 0x8; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 115:
 YY_RULE_SETUP
-#line 194 "indra.l"
+#line 196 "indra.l"
 { count(); yylval.ival = AGENT_CONTROL_AT_POS; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 116:
 YY_RULE_SETUP
-#line 195 "indra.l"
+#line 197 "indra.l"
 { count(); yylval.ival = AGENT_CONTROL_AT_NEG; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 117:
 YY_RULE_SETUP
-#line 196 "indra.l"
+#line 198 "indra.l"
 { count(); yylval.ival = AGENT_CONTROL_LEFT_POS; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 118:
 YY_RULE_SETUP
-#line 197 "indra.l"
+#line 199 "indra.l"
 { count(); yylval.ival = AGENT_CONTROL_LEFT_NEG; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 119:
 YY_RULE_SETUP
-#line 198 "indra.l"
+#line 200 "indra.l"
 { count(); yylval.ival = AGENT_CONTROL_YAW_POS; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 120:
 YY_RULE_SETUP
-#line 199 "indra.l"
+#line 201 "indra.l"
 { count(); yylval.ival = AGENT_CONTROL_YAW_NEG; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 121:
 YY_RULE_SETUP
-#line 200 "indra.l"
+#line 202 "indra.l"
 { count(); yylval.ival = AGENT_CONTROL_UP_POS; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 122:
 YY_RULE_SETUP
-#line 201 "indra.l"
+#line 203 "indra.l"
 { count(); yylval.ival = AGENT_CONTROL_UP_NEG; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 123:
 YY_RULE_SETUP
-#line 202 "indra.l"
+#line 204 "indra.l"
 { count(); yylval.ival = AGENT_CONTROL_LBUTTON_DOWN; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 124:
 YY_RULE_SETUP
-#line 203 "indra.l"
+#line 205 "indra.l"
 { count(); yylval.ival = AGENT_CONTROL_ML_LBUTTON_DOWN; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 125:
 YY_RULE_SETUP
-#line 205 "indra.l"
+#line 207 "indra.l"
 { count(); yylval.ival = LSCRIPTRunTimePermissionBits[SCRIPT_PERMISSION_DEBIT]; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 126:
 YY_RULE_SETUP
-#line 206 "indra.l"
+#line 208 "indra.l"
 { count(); yylval.ival = LSCRIPTRunTimePermissionBits[SCRIPT_PERMISSION_TAKE_CONTROLS]; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 127:
 YY_RULE_SETUP
-#line 207 "indra.l"
+#line 209 "indra.l"
 { count(); yylval.ival = LSCRIPTRunTimePermissionBits[SCRIPT_PERMISSION_REMAP_CONTROLS]; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 128:
 YY_RULE_SETUP
-#line 208 "indra.l"
+#line 210 "indra.l"
 { count(); yylval.ival = LSCRIPTRunTimePermissionBits[SCRIPT_PERMISSION_TRIGGER_ANIMATION]; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 129:
 YY_RULE_SETUP
-#line 209 "indra.l"
+#line 211 "indra.l"
 { count(); yylval.ival = LSCRIPTRunTimePermissionBits[SCRIPT_PERMISSION_ATTACH]; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 130:
 YY_RULE_SETUP
-#line 210 "indra.l"
+#line 212 "indra.l"
 { count(); yylval.ival = LSCRIPTRunTimePermissionBits[SCRIPT_PERMISSION_RELEASE_OWNERSHIP]; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 131:
 YY_RULE_SETUP
-#line 211 "indra.l"
+#line 213 "indra.l"
 { count(); yylval.ival = LSCRIPTRunTimePermissionBits[SCRIPT_PERMISSION_CHANGE_LINKS]; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 132:
 YY_RULE_SETUP
-#line 212 "indra.l"
+#line 214 "indra.l"
 { count(); yylval.ival = LSCRIPTRunTimePermissionBits[SCRIPT_PERMISSION_CHANGE_JOINTS]; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 133:
 YY_RULE_SETUP
-#line 213 "indra.l"
+#line 215 "indra.l"
 { count(); yylval.ival = LSCRIPTRunTimePermissionBits[SCRIPT_PERMISSION_CHANGE_PERMISSIONS]; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 134:
 YY_RULE_SETUP
-#line 214 "indra.l"
+#line 216 "indra.l"
 { count(); yylval.ival = LSCRIPTRunTimePermissionBits[SCRIPT_PERMISSION_TRACK_CAMERA]; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 135:
 YY_RULE_SETUP
-#line 215 "indra.l"
+#line 217 "indra.l"
 { count(); yylval.ival = LSCRIPTRunTimePermissionBits[SCRIPT_PERMISSION_CONTROL_CAMERA]; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 136:
 YY_RULE_SETUP
-#line 217 "indra.l"
+#line 219 "indra.l"
 { count(); yylval.ival = LLAssetType::AT_TEXTURE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 137:
 YY_RULE_SETUP
-#line 218 "indra.l"
+#line 220 "indra.l"
 { count(); yylval.ival = LLAssetType::AT_SOUND; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 138:
 YY_RULE_SETUP
-#line 219 "indra.l"
+#line 221 "indra.l"
 { count(); yylval.ival = LLAssetType::AT_OBJECT; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 139:
 YY_RULE_SETUP
-#line 220 "indra.l"
+#line 222 "indra.l"
 { count(); yylval.ival = LLAssetType::AT_LSL_TEXT; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 140:
 YY_RULE_SETUP
-#line 221 "indra.l"
+#line 223 "indra.l"
 { count(); yylval.ival = LLAssetType::AT_LANDMARK; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 141:
 YY_RULE_SETUP
-#line 222 "indra.l"
+#line 224 "indra.l"
 { count(); yylval.ival = LLAssetType::AT_CLOTHING; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 142:
 YY_RULE_SETUP
-#line 223 "indra.l"
+#line 225 "indra.l"
 { count(); yylval.ival = LLAssetType::AT_NOTECARD; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 143:
 YY_RULE_SETUP
-#line 224 "indra.l"
+#line 226 "indra.l"
 { count(); yylval.ival = LLAssetType::AT_BODYPART; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 144:
 YY_RULE_SETUP
-#line 225 "indra.l"
+#line 227 "indra.l"
 { count(); yylval.ival = LLAssetType::AT_ANIMATION; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 145:
 YY_RULE_SETUP
-#line 226 "indra.l"
+#line 228 "indra.l"
 { count(); yylval.ival = LLAssetType::AT_GESTURE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 146:
 YY_RULE_SETUP
-#line 227 "indra.l"
+#line 229 "indra.l"
 { count(); yylval.ival = LLAssetType::AT_NONE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 147:
 YY_RULE_SETUP
-#line 228 "indra.l"
+#line 230 "indra.l"
 { count(); yylval.ival = LLAssetType::AT_NONE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 148:
 YY_RULE_SETUP
-#line 230 "indra.l"
+#line 232 "indra.l"
 { count(); yylval.ival = CHANGED_INVENTORY; return(INTEGER_CONSTANT); }	
 	YY_BREAK
 case 149:
 YY_RULE_SETUP
-#line 231 "indra.l"
+#line 233 "indra.l"
 { count(); yylval.ival = CHANGED_COLOR; return(INTEGER_CONSTANT); }	
 	YY_BREAK
 case 150:
 YY_RULE_SETUP
-#line 232 "indra.l"
+#line 234 "indra.l"
 { count(); yylval.ival = CHANGED_SHAPE; return(INTEGER_CONSTANT); }	
 	YY_BREAK
 case 151:
 YY_RULE_SETUP
-#line 233 "indra.l"
+#line 235 "indra.l"
 { count(); yylval.ival = CHANGED_SCALE; return(INTEGER_CONSTANT); }	
 	YY_BREAK
 case 152:
 YY_RULE_SETUP
-#line 234 "indra.l"
+#line 236 "indra.l"
 { count(); yylval.ival = CHANGED_TEXTURE; return(INTEGER_CONSTANT); }	
 	YY_BREAK
 case 153:
 YY_RULE_SETUP
-#line 235 "indra.l"
+#line 237 "indra.l"
 { count(); yylval.ival = CHANGED_LINK; return(INTEGER_CONSTANT); }	
 	YY_BREAK
 case 154:
 YY_RULE_SETUP
-#line 236 "indra.l"
+#line 238 "indra.l"
 { count(); yylval.ival = CHANGED_ALLOWED_DROP; return(INTEGER_CONSTANT); }	
 	YY_BREAK
 case 155:
 YY_RULE_SETUP
-#line 237 "indra.l"
+#line 239 "indra.l"
 { count(); yylval.ival = CHANGED_OWNER; return(INTEGER_CONSTANT); }	
 	YY_BREAK
 case 156:
 YY_RULE_SETUP
-#line 238 "indra.l"
+#line 240 "indra.l"
 { count(); yylval.ival = CHANGED_REGION; return(INTEGER_CONSTANT); }	
 	YY_BREAK
 case 157:
 YY_RULE_SETUP
-#line 239 "indra.l"
+#line 241 "indra.l"
 { count(); yylval.ival = CHANGED_TELEPORT; return(INTEGER_CONSTANT); }	
 	YY_BREAK
 case 158:
 YY_RULE_SETUP
-#line 240 "indra.l"
+#line 242 "indra.l"
 { count(); yylval.ival = CHANGED_REGION_START; return(INTEGER_CONSTANT); }	
 	YY_BREAK
 case 159:
 YY_RULE_SETUP
-#line 242 "indra.l"
+#line 244 "indra.l"
 { count(); yylval.ival = OBJECT_UNKNOWN_DETAIL; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 160:
 YY_RULE_SETUP
-#line 243 "indra.l"
+#line 245 "indra.l"
 { count(); yylval.ival = OBJECT_NAME; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 161:
 YY_RULE_SETUP
-#line 244 "indra.l"
+#line 246 "indra.l"
 { count(); yylval.ival = OBJECT_DESC; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 162:
 YY_RULE_SETUP
-#line 245 "indra.l"
+#line 247 "indra.l"
 { count(); yylval.ival = OBJECT_POS; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 163:
 YY_RULE_SETUP
-#line 246 "indra.l"
+#line 248 "indra.l"
 { count(); yylval.ival = OBJECT_ROT; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 164:
 YY_RULE_SETUP
-#line 247 "indra.l"
+#line 249 "indra.l"
 { count(); yylval.ival = OBJECT_VELOCITY; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 165:
 YY_RULE_SETUP
-#line 248 "indra.l"
+#line 250 "indra.l"
 { count(); yylval.ival = OBJECT_OWNER; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 166:
 YY_RULE_SETUP
-#line 249 "indra.l"
+#line 251 "indra.l"
 { count(); yylval.ival = OBJECT_GROUP; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 167:
 YY_RULE_SETUP
-#line 250 "indra.l"
+#line 252 "indra.l"
 { count(); yylval.ival = OBJECT_CREATOR; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 168:
 YY_RULE_SETUP
-#line 252 "indra.l"
+#line 254 "indra.l"
 { count(); yylval.ival = LST_INTEGER; return(INTEGER_CONSTANT); }	
 	YY_BREAK
 case 169:
 YY_RULE_SETUP
-#line 253 "indra.l"
+#line 255 "indra.l"
 { count(); yylval.ival = LST_FLOATINGPOINT; return(INTEGER_CONSTANT); }	
 	YY_BREAK
 case 170:
 YY_RULE_SETUP
-#line 254 "indra.l"
+#line 256 "indra.l"
 { count(); yylval.ival = LST_STRING; return(INTEGER_CONSTANT); }	
 	YY_BREAK
 case 171:
 YY_RULE_SETUP
-#line 255 "indra.l"
+#line 257 "indra.l"
 { count(); yylval.ival = LST_KEY; return(INTEGER_CONSTANT); }	
 	YY_BREAK
 case 172:
 YY_RULE_SETUP
-#line 256 "indra.l"
+#line 258 "indra.l"
 { count(); yylval.ival = LST_VECTOR; return(INTEGER_CONSTANT); }	
 	YY_BREAK
 case 173:
 YY_RULE_SETUP
-#line 257 "indra.l"
+#line 259 "indra.l"
 { count(); yylval.ival = LST_QUATERNION; return(INTEGER_CONSTANT); }	
 	YY_BREAK
 case 174:
 YY_RULE_SETUP
-#line 258 "indra.l"
+#line 260 "indra.l"
 { count(); yylval.ival = LST_NULL; return(INTEGER_CONSTANT); }	
 	YY_BREAK
 case 175:
 YY_RULE_SETUP
-#line 260 "indra.l"
+#line 262 "indra.l"
 { yylval.sval = new char[UUID_STR_LENGTH]; strcpy(yylval.sval, "00000000-0000-0000-0000-000000000000"); return(STRING_CONSTANT); }
 	YY_BREAK
 case 176:
 YY_RULE_SETUP
-#line 261 "indra.l"
+#line 263 "indra.l"
 { yylval.sval = new char[UUID_STR_LENGTH]; strcpy(yylval.sval, "\n\n\n"); return(STRING_CONSTANT); }
 	YY_BREAK
 case 177:
 YY_RULE_SETUP
-#line 262 "indra.l"
+#line 264 "indra.l"
 { yylval.sval = new char[UUID_STR_LENGTH]; strcpy(yylval.sval, URL_REQUEST_GRANTED); return(STRING_CONSTANT); }
 	YY_BREAK
 case 178:
 YY_RULE_SETUP
-#line 263 "indra.l"
+#line 265 "indra.l"
 { yylval.sval = new char[UUID_STR_LENGTH]; strcpy(yylval.sval, URL_REQUEST_DENIED); return(STRING_CONSTANT); }
 	YY_BREAK
 case 179:
 YY_RULE_SETUP
-#line 265 "indra.l"
+#line 267 "indra.l"
 { count(); yylval.fval = F_PI; return(FP_CONSTANT); }
 	YY_BREAK
 case 180:
 YY_RULE_SETUP
-#line 266 "indra.l"
+#line 268 "indra.l"
 { count(); yylval.fval = F_TWO_PI; return(FP_CONSTANT); }
 	YY_BREAK
 case 181:
 YY_RULE_SETUP
-#line 267 "indra.l"
+#line 269 "indra.l"
 { count(); yylval.fval = F_PI_BY_TWO; return(FP_CONSTANT); }
 	YY_BREAK
 case 182:
 YY_RULE_SETUP
-#line 268 "indra.l"
+#line 270 "indra.l"
 { count(); yylval.fval = DEG_TO_RAD; return(FP_CONSTANT); }
 	YY_BREAK
 case 183:
 YY_RULE_SETUP
-#line 269 "indra.l"
+#line 271 "indra.l"
 { count(); yylval.fval = RAD_TO_DEG; return(FP_CONSTANT); }
 	YY_BREAK
 case 184:
 YY_RULE_SETUP
-#line 270 "indra.l"
+#line 272 "indra.l"
 { count(); yylval.fval = F_SQRT2; return(FP_CONSTANT); }
 	YY_BREAK
 case 185:
 YY_RULE_SETUP
-#line 272 "indra.l"
+#line 274 "indra.l"
 { count(); yylval.ival = CHAT_CHANNEL_DEBUG; return(INTEGER_CONSTANT); }	
 	YY_BREAK
 case 186:
 YY_RULE_SETUP
-#line 273 "indra.l"
+#line 275 "indra.l"
 { count(); yylval.ival = 0; return(INTEGER_CONSTANT); }	
 	YY_BREAK
 case 187:
 YY_RULE_SETUP
-#line 275 "indra.l"
+#line 277 "indra.l"
 { count(); return(ZERO_VECTOR); }
 	YY_BREAK
 case 188:
 YY_RULE_SETUP
-#line 276 "indra.l"
+#line 278 "indra.l"
 { count(); return(ZERO_ROTATION); }
 	YY_BREAK
 case 189:
 YY_RULE_SETUP
-#line 278 "indra.l"
+#line 280 "indra.l"
 { count(); yylval.ival = 1; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 190:
 YY_RULE_SETUP
-#line 279 "indra.l"
+#line 281 "indra.l"
 { count(); yylval.ival = 2; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 191:
 YY_RULE_SETUP
-#line 280 "indra.l"
+#line 282 "indra.l"
 { count(); yylval.ival = 3; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 192:
 YY_RULE_SETUP
-#line 281 "indra.l"
+#line 283 "indra.l"
 { count(); yylval.ival = 4; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 193:
 YY_RULE_SETUP
-#line 282 "indra.l"
+#line 284 "indra.l"
 { count(); yylval.ival = 5; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 194:
 YY_RULE_SETUP
-#line 283 "indra.l"
+#line 285 "indra.l"
 { count(); yylval.ival = 6; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 195:
 YY_RULE_SETUP
-#line 284 "indra.l"
+#line 286 "indra.l"
 { count(); yylval.ival = 7; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 196:
 YY_RULE_SETUP
-#line 285 "indra.l"
+#line 287 "indra.l"
 { count(); yylval.ival = 8; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 197:
 YY_RULE_SETUP
-#line 286 "indra.l"
+#line 288 "indra.l"
 { count(); yylval.ival = 9; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 198:
 YY_RULE_SETUP
-#line 287 "indra.l"
+#line 289 "indra.l"
 { count(); yylval.ival = 10; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 199:
 YY_RULE_SETUP
-#line 288 "indra.l"
+#line 290 "indra.l"
 { count(); yylval.ival = 11; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 200:
 YY_RULE_SETUP
-#line 289 "indra.l"
+#line 291 "indra.l"
 { count(); yylval.ival = 12; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 201:
 YY_RULE_SETUP
-#line 290 "indra.l"
+#line 292 "indra.l"
 { count(); yylval.ival = 13; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 202:
 YY_RULE_SETUP
-#line 291 "indra.l"
+#line 293 "indra.l"
 { count(); yylval.ival = 14; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 203:
 YY_RULE_SETUP
-#line 292 "indra.l"
+#line 294 "indra.l"
 { count(); yylval.ival = 15; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 204:
 YY_RULE_SETUP
-#line 293 "indra.l"
+#line 295 "indra.l"
 { count(); yylval.ival = 16; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 205:
 YY_RULE_SETUP
-#line 294 "indra.l"
+#line 296 "indra.l"
 { count(); yylval.ival = 17; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 206:
 YY_RULE_SETUP
-#line 295 "indra.l"
+#line 297 "indra.l"
 { count(); yylval.ival = 18; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 207:
 YY_RULE_SETUP
-#line 296 "indra.l"
+#line 298 "indra.l"
 { count(); yylval.ival = 19; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 208:
 YY_RULE_SETUP
-#line 297 "indra.l"
+#line 299 "indra.l"
 { count(); yylval.ival = 20; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 209:
 YY_RULE_SETUP
-#line 298 "indra.l"
+#line 300 "indra.l"
 { count(); yylval.ival = 21; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 210:
 YY_RULE_SETUP
-#line 299 "indra.l"
+#line 301 "indra.l"
 { count(); yylval.ival = 22; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 211:
 YY_RULE_SETUP
-#line 300 "indra.l"
+#line 302 "indra.l"
 { count(); yylval.ival = 23; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 212:
 YY_RULE_SETUP
-#line 301 "indra.l"
+#line 303 "indra.l"
 { count(); yylval.ival = 24; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 213:
 YY_RULE_SETUP
-#line 302 "indra.l"
+#line 304 "indra.l"
 { count(); yylval.ival = 25; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 214:
 YY_RULE_SETUP
-#line 303 "indra.l"
+#line 305 "indra.l"
 { count(); yylval.ival = 26; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 215:
 YY_RULE_SETUP
-#line 304 "indra.l"
+#line 306 "indra.l"
 { count(); yylval.ival = 27; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 216:
 YY_RULE_SETUP
-#line 305 "indra.l"
+#line 307 "indra.l"
 { count(); yylval.ival = 28; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 217:
 YY_RULE_SETUP
-#line 306 "indra.l"
+#line 308 "indra.l"
 { count(); yylval.ival = 29; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 218:
 YY_RULE_SETUP
-#line 307 "indra.l"
+#line 309 "indra.l"
 { count(); yylval.ival = 30; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 219:
 YY_RULE_SETUP
-#line 308 "indra.l"
+#line 310 "indra.l"
 { count(); yylval.ival = 31; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 220:
 YY_RULE_SETUP
-#line 309 "indra.l"
+#line 311 "indra.l"
 { count(); yylval.ival = 32; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 221:
 YY_RULE_SETUP
-#line 310 "indra.l"
+#line 312 "indra.l"
 { count(); yylval.ival = 33; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 222:
 YY_RULE_SETUP
-#line 311 "indra.l"
+#line 313 "indra.l"
 { count(); yylval.ival = 34; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 223:
 YY_RULE_SETUP
-#line 312 "indra.l"
+#line 314 "indra.l"
 { count(); yylval.ival = 35; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 224:
 YY_RULE_SETUP
-#line 313 "indra.l"
+#line 315 "indra.l"
 { count(); yylval.ival = 36; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 225:
 YY_RULE_SETUP
-#line 314 "indra.l"
+#line 316 "indra.l"
 { count(); yylval.ival = 37; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 226:
 YY_RULE_SETUP
-#line 315 "indra.l"
+#line 317 "indra.l"
 { count(); yylval.ival = 38; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 227:
 YY_RULE_SETUP
-#line 317 "indra.l"
+#line 319 "indra.l"
 { count(); yylval.ival = E_LANDBRUSH_LEVEL; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 228:
 YY_RULE_SETUP
-#line 318 "indra.l"
+#line 320 "indra.l"
 { count(); yylval.ival = E_LANDBRUSH_RAISE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 229:
 YY_RULE_SETUP
-#line 319 "indra.l"
+#line 321 "indra.l"
 { count(); yylval.ival = E_LANDBRUSH_LOWER; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 230:
 YY_RULE_SETUP
-#line 320 "indra.l"
+#line 322 "indra.l"
 { count(); yylval.ival = E_LANDBRUSH_SMOOTH; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 231:
 YY_RULE_SETUP
-#line 321 "indra.l"
+#line 323 "indra.l"
 { count(); yylval.ival = E_LANDBRUSH_NOISE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 232:
 YY_RULE_SETUP
-#line 322 "indra.l"
+#line 324 "indra.l"
 { count(); yylval.ival = E_LANDBRUSH_REVERT; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 233:
 YY_RULE_SETUP
-#line 324 "indra.l"
+#line 326 "indra.l"
 { count(); yylval.ival = 1; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 234:
 YY_RULE_SETUP
-#line 325 "indra.l"
+#line 327 "indra.l"
 { count(); yylval.ival = 2; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 235:
 YY_RULE_SETUP
-#line 326 "indra.l"
+#line 328 "indra.l"
 { count(); yylval.ival = 3; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 236:
 YY_RULE_SETUP
-#line 328 "indra.l"
+#line 330 "indra.l"
 { count(); yylval.ival = 1; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 237:
 YY_RULE_SETUP
-#line 329 "indra.l"
+#line 331 "indra.l"
 { count(); yylval.ival = 2; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 238:
 YY_RULE_SETUP
-#line 330 "indra.l"
+#line 332 "indra.l"
 { count(); yylval.ival = 3; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 239:
 YY_RULE_SETUP
-#line 331 "indra.l"
+#line 333 "indra.l"
 { count(); yylval.ival = 4; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 240:
 YY_RULE_SETUP
-#line 332 "indra.l"
+#line 334 "indra.l"
 { count(); yylval.ival = 5; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 241:
 YY_RULE_SETUP
-#line 333 "indra.l"
+#line 335 "indra.l"
 { count(); yylval.ival = 6; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 242:
 YY_RULE_SETUP
-#line 334 "indra.l"
+#line 336 "indra.l"
 { count(); yylval.ival = 7; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 243:
 YY_RULE_SETUP
-#line 335 "indra.l"
+#line 337 "indra.l"
 { count(); yylval.ival = 8; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 244:
 YY_RULE_SETUP
-#line 337 "indra.l"
+#line 339 "indra.l"
 { count(); yylval.ival = 1; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 245:
 YY_RULE_SETUP
-#line 338 "indra.l"
+#line 340 "indra.l"
 { count(); yylval.ival = 2; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 246:
 YY_RULE_SETUP
-#line 340 "indra.l"
+#line 342 "indra.l"
 { count(); yylval.ival = LSL_REMOTE_DATA_CHANNEL; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 247:
 YY_RULE_SETUP
-#line 341 "indra.l"
+#line 343 "indra.l"
 { count(); yylval.ival = LSL_REMOTE_DATA_REQUEST; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 248:
 YY_RULE_SETUP
-#line 342 "indra.l"
+#line 344 "indra.l"
 { count(); yylval.ival = LSL_REMOTE_DATA_REPLY; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 249:
 YY_RULE_SETUP
-#line 345 "indra.l"
+#line 347 "indra.l"
 { count(); yylval.ival = LLPS_PART_FLAGS; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 250:
 YY_RULE_SETUP
-#line 346 "indra.l"
+#line 348 "indra.l"
 { count(); yylval.ival = LLPS_PART_START_COLOR; return (INTEGER_CONSTANT); }
 	YY_BREAK
 case 251:
 YY_RULE_SETUP
-#line 347 "indra.l"
+#line 349 "indra.l"
 { count(); yylval.ival = LLPS_PART_START_ALPHA; return (INTEGER_CONSTANT); }
 	YY_BREAK
 case 252:
 YY_RULE_SETUP
-#line 348 "indra.l"
+#line 350 "indra.l"
 { count(); yylval.ival = LLPS_PART_START_SCALE; return (INTEGER_CONSTANT); }
 	YY_BREAK
 case 253:
 YY_RULE_SETUP
-#line 349 "indra.l"
+#line 351 "indra.l"
 { count(); yylval.ival = LLPS_PART_END_COLOR; return (INTEGER_CONSTANT); }
 	YY_BREAK
 case 254:
 YY_RULE_SETUP
-#line 350 "indra.l"
+#line 352 "indra.l"
 { count(); yylval.ival = LLPS_PART_END_ALPHA; return (INTEGER_CONSTANT); }
 	YY_BREAK
 case 255:
 YY_RULE_SETUP
-#line 351 "indra.l"
+#line 353 "indra.l"
 { count(); yylval.ival = LLPS_PART_END_SCALE; return (INTEGER_CONSTANT); }
 	YY_BREAK
 case 256:
 YY_RULE_SETUP
-#line 352 "indra.l"
+#line 354 "indra.l"
 { count(); yylval.ival = LLPS_PART_MAX_AGE; return (INTEGER_CONSTANT); }
 	YY_BREAK
 case 257:
 YY_RULE_SETUP
-#line 355 "indra.l"
+#line 357 "indra.l"
 { count(); yylval.ival = LLPartData::LL_PART_WIND_MASK; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 258:
 YY_RULE_SETUP
-#line 356 "indra.l"
+#line 358 "indra.l"
 { count(); yylval.ival = LLPartData::LL_PART_INTERP_COLOR_MASK; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 259:
 YY_RULE_SETUP
-#line 357 "indra.l"
+#line 359 "indra.l"
 { count(); yylval.ival = LLPartData::LL_PART_INTERP_SCALE_MASK; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 260:
 YY_RULE_SETUP
-#line 358 "indra.l"
+#line 360 "indra.l"
 { count(); yylval.ival = LLPartData::LL_PART_BOUNCE_MASK; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 261:
 YY_RULE_SETUP
-#line 359 "indra.l"
+#line 361 "indra.l"
 { count(); yylval.ival = LLPartData::LL_PART_FOLLOW_SRC_MASK; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 262:
 YY_RULE_SETUP
-#line 360 "indra.l"
+#line 362 "indra.l"
 { count(); yylval.ival = LLPartData::LL_PART_FOLLOW_VELOCITY_MASK; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 263:
 YY_RULE_SETUP
-#line 361 "indra.l"
+#line 363 "indra.l"
 { count(); yylval.ival = LLPartData::LL_PART_TARGET_POS_MASK; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 264:
 YY_RULE_SETUP
-#line 362 "indra.l"
+#line 364 "indra.l"
 { count(); yylval.ival = LLPartData::LL_PART_EMISSIVE_MASK; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 265:
 YY_RULE_SETUP
-#line 363 "indra.l"
+#line 365 "indra.l"
 { count(); yylval.ival = LLPartData::LL_PART_TARGET_LINEAR_MASK; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 266:
 YY_RULE_SETUP
-#line 366 "indra.l"
+#line 368 "indra.l"
 { count(); yylval.ival = LLPS_SRC_MAX_AGE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 267:
 YY_RULE_SETUP
-#line 367 "indra.l"
+#line 369 "indra.l"
 { count(); yylval.ival = LLPS_SRC_PATTERN; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 268:
 YY_RULE_SETUP
-#line 368 "indra.l"
+#line 370 "indra.l"
 { count(); yylval.ival = LLPS_SRC_INNERANGLE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 269:
 YY_RULE_SETUP
-#line 369 "indra.l"
+#line 371 "indra.l"
 { count(); yylval.ival = LLPS_SRC_OUTERANGLE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 270:
 YY_RULE_SETUP
-#line 370 "indra.l"
+#line 372 "indra.l"
 { count(); yylval.ival = LLPS_SRC_ANGLE_BEGIN; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 271:
 YY_RULE_SETUP
-#line 371 "indra.l"
+#line 373 "indra.l"
 { count(); yylval.ival = LLPS_SRC_ANGLE_END; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 272:
 YY_RULE_SETUP
-#line 372 "indra.l"
+#line 374 "indra.l"
 { count(); yylval.ival = LLPS_SRC_BURST_RATE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 273:
 YY_RULE_SETUP
-#line 373 "indra.l"
+#line 375 "indra.l"
 { count(); yylval.ival = LLPS_SRC_BURST_PART_COUNT; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 274:
 YY_RULE_SETUP
-#line 374 "indra.l"
+#line 376 "indra.l"
 { count(); yylval.ival = LLPS_SRC_BURST_RADIUS; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 275:
 YY_RULE_SETUP
-#line 375 "indra.l"
+#line 377 "indra.l"
 { count(); yylval.ival = LLPS_SRC_BURST_SPEED_MIN; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 276:
 YY_RULE_SETUP
-#line 376 "indra.l"
+#line 378 "indra.l"
 { count(); yylval.ival = LLPS_SRC_BURST_SPEED_MAX; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 277:
 YY_RULE_SETUP
-#line 377 "indra.l"
+#line 379 "indra.l"
 { count(); yylval.ival = LLPS_SRC_ACCEL; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 278:
 YY_RULE_SETUP
-#line 378 "indra.l"
+#line 380 "indra.l"
 { count(); yylval.ival = LLPS_SRC_TEXTURE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 279:
 YY_RULE_SETUP
-#line 379 "indra.l"
+#line 381 "indra.l"
 { count(); yylval.ival = LLPS_SRC_TARGET_UUID; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 280:
 YY_RULE_SETUP
-#line 380 "indra.l"
+#line 382 "indra.l"
 { count(); yylval.ival = LLPS_SRC_OMEGA; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 281:
 YY_RULE_SETUP
-#line 382 "indra.l"
+#line 384 "indra.l"
 { count(); yylval.ival = LLPartSysData::LL_PART_SRC_OBJ_REL_MASK; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 282:
 YY_RULE_SETUP
-#line 384 "indra.l"
+#line 386 "indra.l"
 { count(); yylval.ival = LLPartSysData::LL_PART_SRC_PATTERN_DROP; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 283:
 YY_RULE_SETUP
-#line 385 "indra.l"
+#line 387 "indra.l"
 { count(); yylval.ival = LLPartSysData::LL_PART_SRC_PATTERN_EXPLODE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 284:
 YY_RULE_SETUP
-#line 386 "indra.l"
+#line 388 "indra.l"
 { count(); yylval.ival = LLPartSysData::LL_PART_SRC_PATTERN_ANGLE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 285:
 YY_RULE_SETUP
-#line 387 "indra.l"
+#line 389 "indra.l"
 { count(); yylval.ival = LLPartSysData::LL_PART_SRC_PATTERN_ANGLE_CONE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 286:
 YY_RULE_SETUP
-#line 388 "indra.l"
+#line 390 "indra.l"
 { count(); yylval.ival = LLPartSysData::LL_PART_SRC_PATTERN_ANGLE_CONE_EMPTY; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 287:
 YY_RULE_SETUP
-#line 391 "indra.l"
+#line 393 "indra.l"
 { count(); yylval.ival = VEHICLE_TYPE_NONE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 288:
 YY_RULE_SETUP
-#line 392 "indra.l"
+#line 394 "indra.l"
 { count(); yylval.ival = VEHICLE_TYPE_SLED; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 289:
 YY_RULE_SETUP
-#line 393 "indra.l"
+#line 395 "indra.l"
 { count(); yylval.ival = VEHICLE_TYPE_CAR; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 290:
 YY_RULE_SETUP
-#line 394 "indra.l"
+#line 396 "indra.l"
 { count(); yylval.ival = VEHICLE_TYPE_BOAT; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 291:
 YY_RULE_SETUP
-#line 395 "indra.l"
+#line 397 "indra.l"
 { count(); yylval.ival = VEHICLE_TYPE_AIRPLANE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 292:
 YY_RULE_SETUP
-#line 396 "indra.l"
+#line 398 "indra.l"
 { count(); yylval.ival = VEHICLE_TYPE_BALLOON; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 293:
 YY_RULE_SETUP
-#line 398 "indra.l"
+#line 400 "indra.l"
 { count(); yylval.ival = VEHICLE_REFERENCE_FRAME; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 294:
 YY_RULE_SETUP
-#line 399 "indra.l"
+#line 401 "indra.l"
 { count(); yylval.ival = VEHICLE_LINEAR_FRICTION_TIMESCALE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 295:
 YY_RULE_SETUP
-#line 400 "indra.l"
+#line 402 "indra.l"
 { count(); yylval.ival = VEHICLE_ANGULAR_FRICTION_TIMESCALE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 296:
 YY_RULE_SETUP
-#line 401 "indra.l"
+#line 403 "indra.l"
 { count(); yylval.ival = VEHICLE_LINEAR_MOTOR_DIRECTION; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 297:
 YY_RULE_SETUP
-#line 402 "indra.l"
+#line 404 "indra.l"
 { count(); yylval.ival = VEHICLE_ANGULAR_MOTOR_DIRECTION; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 298:
 YY_RULE_SETUP
-#line 403 "indra.l"
+#line 405 "indra.l"
 { count(); yylval.ival = VEHICLE_LINEAR_MOTOR_OFFSET; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 299:
 YY_RULE_SETUP
-#line 407 "indra.l"
+#line 409 "indra.l"
 { count(); yylval.ival = VEHICLE_HOVER_HEIGHT; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 300:
 YY_RULE_SETUP
-#line 408 "indra.l"
+#line 410 "indra.l"
 { count(); yylval.ival = VEHICLE_HOVER_EFFICIENCY; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 301:
 YY_RULE_SETUP
-#line 409 "indra.l"
+#line 411 "indra.l"
 { count(); yylval.ival = VEHICLE_HOVER_TIMESCALE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 302:
 YY_RULE_SETUP
-#line 410 "indra.l"
+#line 412 "indra.l"
 { count(); yylval.ival = VEHICLE_BUOYANCY; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 303:
 YY_RULE_SETUP
-#line 412 "indra.l"
+#line 414 "indra.l"
 { count(); yylval.ival = VEHICLE_LINEAR_DEFLECTION_EFFICIENCY; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 304:
 YY_RULE_SETUP
-#line 413 "indra.l"
+#line 415 "indra.l"
 { count(); yylval.ival = VEHICLE_LINEAR_DEFLECTION_TIMESCALE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 305:
 YY_RULE_SETUP
-#line 414 "indra.l"
+#line 416 "indra.l"
 { count(); yylval.ival = VEHICLE_LINEAR_MOTOR_TIMESCALE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 306:
 YY_RULE_SETUP
-#line 415 "indra.l"
+#line 417 "indra.l"
 { count(); yylval.ival = VEHICLE_LINEAR_MOTOR_DECAY_TIMESCALE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 307:
 YY_RULE_SETUP
-#line 417 "indra.l"
+#line 419 "indra.l"
 { count(); yylval.ival = VEHICLE_ANGULAR_DEFLECTION_EFFICIENCY; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 308:
 YY_RULE_SETUP
-#line 418 "indra.l"
+#line 420 "indra.l"
 { count(); yylval.ival = VEHICLE_ANGULAR_DEFLECTION_TIMESCALE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 309:
 YY_RULE_SETUP
-#line 419 "indra.l"
+#line 421 "indra.l"
 { count(); yylval.ival = VEHICLE_ANGULAR_MOTOR_TIMESCALE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 310:
 YY_RULE_SETUP
-#line 420 "indra.l"
+#line 422 "indra.l"
 { count(); yylval.ival = VEHICLE_ANGULAR_MOTOR_DECAY_TIMESCALE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 311:
 YY_RULE_SETUP
-#line 422 "indra.l"
+#line 424 "indra.l"
 { count(); yylval.ival = VEHICLE_VERTICAL_ATTRACTION_EFFICIENCY; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 312:
 YY_RULE_SETUP
-#line 423 "indra.l"
+#line 425 "indra.l"
 { count(); yylval.ival = VEHICLE_VERTICAL_ATTRACTION_TIMESCALE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 313:
 YY_RULE_SETUP
-#line 425 "indra.l"
+#line 427 "indra.l"
 { count(); yylval.ival = VEHICLE_BANKING_EFFICIENCY; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 314:
 YY_RULE_SETUP
-#line 426 "indra.l"
+#line 428 "indra.l"
 { count(); yylval.ival = VEHICLE_BANKING_MIX; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 315:
 YY_RULE_SETUP
-#line 427 "indra.l"
+#line 429 "indra.l"
 { count(); yylval.ival = VEHICLE_BANKING_TIMESCALE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 316:
 YY_RULE_SETUP
-#line 429 "indra.l"
+#line 431 "indra.l"
 { count(); yylval.ival = VEHICLE_FLAG_NO_DEFLECTION_UP; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 317:
 YY_RULE_SETUP
-#line 430 "indra.l"
+#line 432 "indra.l"
 { count(); yylval.ival = VEHICLE_FLAG_NO_DEFLECTION_UP; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 318:
 YY_RULE_SETUP
-#line 431 "indra.l"
+#line 433 "indra.l"
 { count(); yylval.ival = VEHICLE_FLAG_LIMIT_ROLL_ONLY; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 319:
 YY_RULE_SETUP
-#line 432 "indra.l"
+#line 434 "indra.l"
 { count(); yylval.ival = VEHICLE_FLAG_HOVER_WATER_ONLY; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 320:
 YY_RULE_SETUP
-#line 433 "indra.l"
+#line 435 "indra.l"
 { count(); yylval.ival = VEHICLE_FLAG_HOVER_TERRAIN_ONLY; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 321:
 YY_RULE_SETUP
-#line 434 "indra.l"
+#line 436 "indra.l"
 { count(); yylval.ival = VEHICLE_FLAG_HOVER_GLOBAL_HEIGHT; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 322:
 YY_RULE_SETUP
-#line 435 "indra.l"
+#line 437 "indra.l"
 { count(); yylval.ival = VEHICLE_FLAG_HOVER_UP_ONLY; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 323:
 YY_RULE_SETUP
-#line 436 "indra.l"
+#line 438 "indra.l"
 { count(); yylval.ival = VEHICLE_FLAG_LIMIT_MOTOR_UP; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 324:
 YY_RULE_SETUP
-#line 437 "indra.l"
+#line 439 "indra.l"
 { count(); yylval.ival = VEHICLE_FLAG_MOUSELOOK_STEER; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 325:
 YY_RULE_SETUP
-#line 438 "indra.l"
+#line 440 "indra.l"
 { count(); yylval.ival = VEHICLE_FLAG_MOUSELOOK_BANK; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 326:
 YY_RULE_SETUP
-#line 439 "indra.l"
+#line 441 "indra.l"
 { count(); yylval.ival = VEHICLE_FLAG_CAMERA_DECOUPLED; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 327:
 YY_RULE_SETUP
-#line 443 "indra.l"
+#line 445 "indra.l"
 { count(); yylval.ival = LSL_PRIM_TYPE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 328:
 YY_RULE_SETUP
-#line 444 "indra.l"
+#line 446 "indra.l"
 { count(); yylval.ival = LSL_PRIM_MATERIAL; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 329:
 YY_RULE_SETUP
-#line 445 "indra.l"
+#line 447 "indra.l"
 { count(); yylval.ival = LSL_PRIM_PHYSICS; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 330:
 YY_RULE_SETUP
-#line 446 "indra.l"
+#line 448 "indra.l"
 { count(); yylval.ival = LSL_PRIM_FLEXIBLE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 331:
 YY_RULE_SETUP
-#line 447 "indra.l"
+#line 449 "indra.l"
 { count(); yylval.ival = LSL_PRIM_POINT_LIGHT; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 332:
 YY_RULE_SETUP
-#line 448 "indra.l"
+#line 450 "indra.l"
 { count(); yylval.ival = LSL_PRIM_TEMP_ON_REZ; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 333:
 YY_RULE_SETUP
-#line 449 "indra.l"
+#line 451 "indra.l"
 { count(); yylval.ival = LSL_PRIM_PHANTOM; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 334:
 YY_RULE_SETUP
-#line 450 "indra.l"
+#line 452 "indra.l"
 { count(); yylval.ival = LSL_PRIM_CAST_SHADOWS; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 335:
 YY_RULE_SETUP
-#line 451 "indra.l"
+#line 453 "indra.l"
 { count(); yylval.ival = LSL_PRIM_POSITION; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 336:
 YY_RULE_SETUP
-#line 452 "indra.l"
+#line 454 "indra.l"
 { count(); yylval.ival = LSL_PRIM_SIZE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 337:
 YY_RULE_SETUP
-#line 453 "indra.l"
+#line 455 "indra.l"
 { count(); yylval.ival = LSL_PRIM_ROTATION; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 338:
 YY_RULE_SETUP
-#line 454 "indra.l"
+#line 456 "indra.l"
 { count(); yylval.ival = LSL_PRIM_TEXTURE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 339:
 YY_RULE_SETUP
-#line 455 "indra.l"
+#line 457 "indra.l"
 { count(); yylval.ival = LSL_PRIM_COLOR; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 340:
 YY_RULE_SETUP
-#line 456 "indra.l"
+#line 458 "indra.l"
 { count(); yylval.ival = LSL_PRIM_BUMP_SHINY; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 341:
 YY_RULE_SETUP
-#line 457 "indra.l"
+#line 459 "indra.l"
 { count(); yylval.ival = LSL_PRIM_FULLBRIGHT; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 342:
 YY_RULE_SETUP
-#line 458 "indra.l"
+#line 460 "indra.l"
 { count(); yylval.ival = LSL_PRIM_TEXGEN; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 343:
 YY_RULE_SETUP
-#line 459 "indra.l"
+#line 461 "indra.l"
 { count(); yylval.ival = LSL_PRIM_GLOW; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 344:
 YY_RULE_SETUP
-#line 461 "indra.l"
+#line 463 "indra.l"
 { count(); yylval.ival = LSL_PRIM_TYPE_BOX; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 345:
 YY_RULE_SETUP
-#line 462 "indra.l"
+#line 464 "indra.l"
 { count(); yylval.ival = LSL_PRIM_TYPE_CYLINDER; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 346:
 YY_RULE_SETUP
-#line 463 "indra.l"
+#line 465 "indra.l"
 { count(); yylval.ival = LSL_PRIM_TYPE_PRISM; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 347:
 YY_RULE_SETUP
-#line 464 "indra.l"
+#line 466 "indra.l"
 { count(); yylval.ival = LSL_PRIM_TYPE_SPHERE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 348:
 YY_RULE_SETUP
-#line 465 "indra.l"
+#line 467 "indra.l"
 { count(); yylval.ival = LSL_PRIM_TYPE_TORUS; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 349:
 YY_RULE_SETUP
-#line 466 "indra.l"
+#line 468 "indra.l"
 { count(); yylval.ival = LSL_PRIM_TYPE_TUBE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 350:
 YY_RULE_SETUP
-#line 467 "indra.l"
+#line 469 "indra.l"
 { count(); yylval.ival = LSL_PRIM_TYPE_RING; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 351:
 YY_RULE_SETUP
-#line 468 "indra.l"
+#line 470 "indra.l"
 { count(); yylval.ival = LSL_PRIM_TYPE_SCULPT; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 352:
 YY_RULE_SETUP
-#line 470 "indra.l"
+#line 472 "indra.l"
 { count(); yylval.ival = LSL_PRIM_HOLE_DEFAULT; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 353:
 YY_RULE_SETUP
-#line 471 "indra.l"
+#line 473 "indra.l"
 { count(); yylval.ival = LSL_PRIM_HOLE_CIRCLE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 354:
 YY_RULE_SETUP
-#line 472 "indra.l"
+#line 474 "indra.l"
 { count(); yylval.ival = LSL_PRIM_HOLE_SQUARE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 355:
 YY_RULE_SETUP
-#line 473 "indra.l"
+#line 475 "indra.l"
 { count(); yylval.ival = LSL_PRIM_HOLE_TRIANGLE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 356:
 YY_RULE_SETUP
-#line 475 "indra.l"
+#line 477 "indra.l"
 { count(); yylval.ival = LSL_PRIM_MATERIAL_STONE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 357:
 YY_RULE_SETUP
-#line 476 "indra.l"
+#line 478 "indra.l"
 { count(); yylval.ival = LSL_PRIM_MATERIAL_METAL; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 358:
 YY_RULE_SETUP
-#line 477 "indra.l"
+#line 479 "indra.l"
 { count(); yylval.ival = LSL_PRIM_MATERIAL_GLASS; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 359:
 YY_RULE_SETUP
-#line 478 "indra.l"
+#line 480 "indra.l"
 { count(); yylval.ival = LSL_PRIM_MATERIAL_WOOD; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 360:
 YY_RULE_SETUP
-#line 479 "indra.l"
+#line 481 "indra.l"
 { count(); yylval.ival = LSL_PRIM_MATERIAL_FLESH; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 361:
 YY_RULE_SETUP
-#line 480 "indra.l"
+#line 482 "indra.l"
 { count(); yylval.ival = LSL_PRIM_MATERIAL_PLASTIC; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 362:
 YY_RULE_SETUP
-#line 481 "indra.l"
+#line 483 "indra.l"
 { count(); yylval.ival = LSL_PRIM_MATERIAL_RUBBER; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 363:
 YY_RULE_SETUP
-#line 482 "indra.l"
+#line 484 "indra.l"
 { count(); yylval.ival = LSL_PRIM_MATERIAL_LIGHT; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 364:
 YY_RULE_SETUP
-#line 484 "indra.l"
+#line 486 "indra.l"
 { count(); yylval.ival = LSL_PRIM_SHINY_NONE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 365:
 YY_RULE_SETUP
-#line 485 "indra.l"
+#line 487 "indra.l"
 { count(); yylval.ival = LSL_PRIM_SHINY_LOW; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 366:
 YY_RULE_SETUP
-#line 486 "indra.l"
+#line 488 "indra.l"
 { count(); yylval.ival = LSL_PRIM_SHINY_MEDIUM; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 367:
 YY_RULE_SETUP
-#line 487 "indra.l"
+#line 489 "indra.l"
 { count(); yylval.ival = LSL_PRIM_SHINY_HIGH; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 368:
 YY_RULE_SETUP
-#line 489 "indra.l"
+#line 491 "indra.l"
 { count(); yylval.ival = LSL_PRIM_BUMP_NONE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 369:
 YY_RULE_SETUP
-#line 490 "indra.l"
+#line 492 "indra.l"
 { count(); yylval.ival = LSL_PRIM_BUMP_BRIGHT; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 370:
 YY_RULE_SETUP
-#line 491 "indra.l"
+#line 493 "indra.l"
 { count(); yylval.ival = LSL_PRIM_BUMP_DARK; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 371:
 YY_RULE_SETUP
-#line 492 "indra.l"
+#line 494 "indra.l"
 { count(); yylval.ival = LSL_PRIM_BUMP_WOOD; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 372:
 YY_RULE_SETUP
-#line 493 "indra.l"
+#line 495 "indra.l"
 { count(); yylval.ival = LSL_PRIM_BUMP_BARK; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 373:
 YY_RULE_SETUP
-#line 494 "indra.l"
+#line 496 "indra.l"
 { count(); yylval.ival = LSL_PRIM_BUMP_BRICKS; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 374:
 YY_RULE_SETUP
-#line 495 "indra.l"
+#line 497 "indra.l"
 { count(); yylval.ival = LSL_PRIM_BUMP_CHECKER; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 375:
 YY_RULE_SETUP
-#line 496 "indra.l"
+#line 498 "indra.l"
 { count(); yylval.ival = LSL_PRIM_BUMP_CONCRETE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 376:
 YY_RULE_SETUP
-#line 497 "indra.l"
+#line 499 "indra.l"
 { count(); yylval.ival = LSL_PRIM_BUMP_TILE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 377:
 YY_RULE_SETUP
-#line 498 "indra.l"
+#line 500 "indra.l"
 { count(); yylval.ival = LSL_PRIM_BUMP_STONE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 378:
 YY_RULE_SETUP
-#line 499 "indra.l"
+#line 501 "indra.l"
 { count(); yylval.ival = LSL_PRIM_BUMP_DISKS; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 379:
 YY_RULE_SETUP
-#line 500 "indra.l"
+#line 502 "indra.l"
 { count(); yylval.ival = LSL_PRIM_BUMP_GRAVEL; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 380:
 YY_RULE_SETUP
-#line 501 "indra.l"
+#line 503 "indra.l"
 { count(); yylval.ival = LSL_PRIM_BUMP_BLOBS; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 381:
 YY_RULE_SETUP
-#line 502 "indra.l"
+#line 504 "indra.l"
 { count(); yylval.ival = LSL_PRIM_BUMP_SIDING; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 382:
 YY_RULE_SETUP
-#line 503 "indra.l"
+#line 505 "indra.l"
 { count(); yylval.ival = LSL_PRIM_BUMP_LARGETILE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 383:
 YY_RULE_SETUP
-#line 504 "indra.l"
+#line 506 "indra.l"
 { count(); yylval.ival = LSL_PRIM_BUMP_STUCCO; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 384:
 YY_RULE_SETUP
-#line 505 "indra.l"
+#line 507 "indra.l"
 { count(); yylval.ival = LSL_PRIM_BUMP_SUCTION; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 385:
 YY_RULE_SETUP
-#line 506 "indra.l"
+#line 508 "indra.l"
 { count(); yylval.ival = LSL_PRIM_BUMP_WEAVE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 386:
 YY_RULE_SETUP
-#line 508 "indra.l"
+#line 510 "indra.l"
 { count(); yylval.ival = LSL_PRIM_TEXGEN_DEFAULT; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 387:
 YY_RULE_SETUP
-#line 509 "indra.l"
+#line 511 "indra.l"
 { count(); yylval.ival = LSL_PRIM_TEXGEN_PLANAR; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 388:
 YY_RULE_SETUP
-#line 511 "indra.l"
+#line 513 "indra.l"
 { count(); yylval.ival = LSL_PRIM_SCULPT_TYPE_SPHERE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 389:
 YY_RULE_SETUP
-#line 512 "indra.l"
+#line 514 "indra.l"
 { count(); yylval.ival = LSL_PRIM_SCULPT_TYPE_TORUS; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 390:
 YY_RULE_SETUP
-#line 513 "indra.l"
+#line 515 "indra.l"
 { count(); yylval.ival = LSL_PRIM_SCULPT_TYPE_PLANE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 391:
 YY_RULE_SETUP
-#line 514 "indra.l"
+#line 516 "indra.l"
 { count(); yylval.ival = LSL_PRIM_SCULPT_TYPE_CYLINDER; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 392:
 YY_RULE_SETUP
-#line 515 "indra.l"
+#line 517 "indra.l"
 { count(); yylval.ival = LSL_PRIM_SCULPT_TYPE_MASK; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 393:
 YY_RULE_SETUP
-#line 516 "indra.l"
+#line 518 "indra.l"
 { count(); yylval.ival = LSL_PRIM_SCULPT_FLAG_MIRROR; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 394:
 YY_RULE_SETUP
-#line 517 "indra.l"
+#line 519 "indra.l"
 { count(); yylval.ival = LSL_PRIM_SCULPT_FLAG_INVERT; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 395:
 YY_RULE_SETUP
-#line 519 "indra.l"
+#line 521 "indra.l"
 { count(); yylval.ival = 0; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 396:
 YY_RULE_SETUP
-#line 520 "indra.l"
+#line 522 "indra.l"
 { count(); yylval.ival = 1; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 397:
 YY_RULE_SETUP
-#line 521 "indra.l"
+#line 523 "indra.l"
 { count(); yylval.ival = 2; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 398:
 YY_RULE_SETUP
-#line 522 "indra.l"
+#line 524 "indra.l"
 { count(); yylval.ival = 3; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 399:
 YY_RULE_SETUP
-#line 523 "indra.l"
+#line 525 "indra.l"
 { count(); yylval.ival = 4; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 400:
 YY_RULE_SETUP
-#line 525 "indra.l"
+#line 527 "indra.l"
 { count(); yylval.ival = PERM_TRANSFER; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 401:
 YY_RULE_SETUP
-#line 526 "indra.l"
+#line 528 "indra.l"
 { count(); yylval.ival = PERM_MODIFY; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 402:
 YY_RULE_SETUP
-#line 527 "indra.l"
+#line 529 "indra.l"
 { count(); yylval.ival = PERM_COPY; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 403:
 YY_RULE_SETUP
-#line 528 "indra.l"
+#line 530 "indra.l"
 { count(); yylval.ival = PERM_MOVE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 404:
 YY_RULE_SETUP
-#line 529 "indra.l"
+#line 531 "indra.l"
 { count(); yylval.ival = PERM_ALL; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 405:
 YY_RULE_SETUP
-#line 531 "indra.l"
+#line 533 "indra.l"
 { count(); yylval.ival = PARCEL_MEDIA_COMMAND_STOP; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 406:
 YY_RULE_SETUP
-#line 532 "indra.l"
+#line 534 "indra.l"
 { count(); yylval.ival = PARCEL_MEDIA_COMMAND_PAUSE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 407:
 YY_RULE_SETUP
-#line 533 "indra.l"
+#line 535 "indra.l"
 { count(); yylval.ival = PARCEL_MEDIA_COMMAND_PLAY; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 408:
 YY_RULE_SETUP
-#line 534 "indra.l"
+#line 536 "indra.l"
 { count(); yylval.ival = PARCEL_MEDIA_COMMAND_LOOP; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 409:
 YY_RULE_SETUP
-#line 535 "indra.l"
+#line 537 "indra.l"
 { count(); yylval.ival = PARCEL_MEDIA_COMMAND_TEXTURE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 410:
 YY_RULE_SETUP
-#line 536 "indra.l"
+#line 538 "indra.l"
 { count(); yylval.ival = PARCEL_MEDIA_COMMAND_URL; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 411:
 YY_RULE_SETUP
-#line 537 "indra.l"
+#line 539 "indra.l"
 { count(); yylval.ival = PARCEL_MEDIA_COMMAND_TIME; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 412:
 YY_RULE_SETUP
-#line 538 "indra.l"
+#line 540 "indra.l"
 { count(); yylval.ival = PARCEL_MEDIA_COMMAND_AGENT; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 413:
 YY_RULE_SETUP
-#line 539 "indra.l"
+#line 541 "indra.l"
 { count(); yylval.ival = PARCEL_MEDIA_COMMAND_UNLOAD; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 414:
 YY_RULE_SETUP
-#line 540 "indra.l"
+#line 542 "indra.l"
 { count(); yylval.ival = PARCEL_MEDIA_COMMAND_AUTO_ALIGN; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 415:
 YY_RULE_SETUP
-#line 541 "indra.l"
+#line 543 "indra.l"
 { count(); yylval.ival = PARCEL_MEDIA_COMMAND_TYPE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 416:
 YY_RULE_SETUP
-#line 542 "indra.l"
+#line 544 "indra.l"
 { count(); yylval.ival = PARCEL_MEDIA_COMMAND_SIZE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 417:
 YY_RULE_SETUP
-#line 543 "indra.l"
+#line 545 "indra.l"
 { count(); yylval.ival = PARCEL_MEDIA_COMMAND_DESC; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 418:
 YY_RULE_SETUP
-#line 544 "indra.l"
+#line 546 "indra.l"
 { count(); yylval.ival = PARCEL_MEDIA_COMMAND_LOOP_SET; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 419:
 YY_RULE_SETUP
-#line 546 "indra.l"
+#line 548 "indra.l"
 { count(); yylval.ival = LIST_STAT_MAX; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 420:
 YY_RULE_SETUP
-#line 547 "indra.l"
+#line 549 "indra.l"
 { count(); yylval.ival = LIST_STAT_MIN; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 421:
 YY_RULE_SETUP
-#line 548 "indra.l"
+#line 550 "indra.l"
 { count(); yylval.ival = LIST_STAT_MEAN; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 422:
 YY_RULE_SETUP
-#line 549 "indra.l"
+#line 551 "indra.l"
 { count(); yylval.ival = LIST_STAT_MEDIAN; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 423:
 YY_RULE_SETUP
-#line 550 "indra.l"
+#line 552 "indra.l"
 { count(); yylval.ival = LIST_STAT_STD_DEV; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 424:
 YY_RULE_SETUP
-#line 551 "indra.l"
+#line 553 "indra.l"
 { count(); yylval.ival = LIST_STAT_SUM; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 425:
 YY_RULE_SETUP
-#line 552 "indra.l"
+#line 554 "indra.l"
 { count(); yylval.ival = LIST_STAT_SUM_SQUARES; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 426:
 YY_RULE_SETUP
-#line 553 "indra.l"
+#line 555 "indra.l"
 { count(); yylval.ival = LIST_STAT_NUM_COUNT; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 427:
 YY_RULE_SETUP
-#line 554 "indra.l"
+#line 556 "indra.l"
 { count(); yylval.ival = LIST_STAT_GEO_MEAN; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 428:
 YY_RULE_SETUP
-#line 555 "indra.l"
+#line 557 "indra.l"
 { count(); yylval.ival = LIST_STAT_RANGE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 429:
 YY_RULE_SETUP
-#line 557 "indra.l"
+#line 559 "indra.l"
 { count(); yylval.ival = PAY_PRICE_HIDE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 430:
 YY_RULE_SETUP
-#line 558 "indra.l"
+#line 560 "indra.l"
 { count(); yylval.ival = PAY_PRICE_DEFAULT; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 431:
 YY_RULE_SETUP
-#line 560 "indra.l"
+#line 562 "indra.l"
 { count(); yylval.ival = PF_ALLOW_FLY; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 432:
 YY_RULE_SETUP
-#line 561 "indra.l"
+#line 563 "indra.l"
 { count(); yylval.ival = PF_ALLOW_GROUP_SCRIPTS; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 433:
 YY_RULE_SETUP
-#line 562 "indra.l"
+#line 564 "indra.l"
 { count(); yylval.ival = PF_ALLOW_OTHER_SCRIPTS; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 434:
 YY_RULE_SETUP
-#line 563 "indra.l"
+#line 565 "indra.l"
 { count(); yylval.ival = PF_ALLOW_LANDMARK; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 435:
 YY_RULE_SETUP
-#line 564 "indra.l"
+#line 566 "indra.l"
 { count(); yylval.ival = PF_ALLOW_TERRAFORM; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 436:
 YY_RULE_SETUP
-#line 565 "indra.l"
+#line 567 "indra.l"
 { count(); yylval.ival = PF_ALLOW_DAMAGE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 437:
 YY_RULE_SETUP
-#line 566 "indra.l"
+#line 568 "indra.l"
 { count(); yylval.ival = PF_CREATE_OBJECTS; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 438:
 YY_RULE_SETUP
-#line 567 "indra.l"
+#line 569 "indra.l"
 { count(); yylval.ival = PF_CREATE_GROUP_OBJECTS; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 439:
 YY_RULE_SETUP
-#line 568 "indra.l"
+#line 570 "indra.l"
 { count(); yylval.ival = PF_USE_ACCESS_GROUP; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 440:
 YY_RULE_SETUP
-#line 569 "indra.l"
+#line 571 "indra.l"
 { count(); yylval.ival = PF_USE_ACCESS_LIST; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 441:
 YY_RULE_SETUP
-#line 570 "indra.l"
+#line 572 "indra.l"
 { count(); yylval.ival = PF_USE_BAN_LIST; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 442:
 YY_RULE_SETUP
-#line 571 "indra.l"
+#line 573 "indra.l"
 { count(); yylval.ival = PF_USE_PASS_LIST; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 443:
 YY_RULE_SETUP
-#line 572 "indra.l"
+#line 574 "indra.l"
 { count(); yylval.ival = PF_SOUND_LOCAL; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 444:
 YY_RULE_SETUP
-#line 573 "indra.l"
+#line 575 "indra.l"
 { count(); yylval.ival = PF_RESTRICT_PUSHOBJECT; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 445:
 YY_RULE_SETUP
-#line 574 "indra.l"
+#line 576 "indra.l"
 { count(); yylval.ival = PF_ALLOW_GROUP_OBJECT_ENTRY; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 446:
 YY_RULE_SETUP
-#line 575 "indra.l"
+#line 577 "indra.l"
 { count(); yylval.ival = PF_ALLOW_ALL_OBJECT_ENTRY; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 447:
 YY_RULE_SETUP
-#line 577 "indra.l"
+#line 579 "indra.l"
 { count(); yylval.ival = REGION_FLAGS_ALLOW_DAMAGE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 448:
 YY_RULE_SETUP
-#line 578 "indra.l"
+#line 580 "indra.l"
 { count(); yylval.ival = REGION_FLAGS_SUN_FIXED; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 449:
 YY_RULE_SETUP
-#line 579 "indra.l"
+#line 581 "indra.l"
 { count(); yylval.ival = REGION_FLAGS_BLOCK_TERRAFORM; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 450:
 YY_RULE_SETUP
-#line 580 "indra.l"
+#line 582 "indra.l"
 { count(); yylval.ival = REGION_FLAGS_SANDBOX; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 451:
 YY_RULE_SETUP
-#line 581 "indra.l"
+#line 583 "indra.l"
 { count(); yylval.ival = REGION_FLAGS_SKIP_COLLISIONS; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 452:
 YY_RULE_SETUP
-#line 582 "indra.l"
+#line 584 "indra.l"
 { count(); yylval.ival = REGION_FLAGS_SKIP_PHYSICS; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 453:
 YY_RULE_SETUP
-#line 583 "indra.l"
+#line 585 "indra.l"
 { count(); yylval.ival = REGION_FLAGS_BLOCK_FLY; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 454:
 YY_RULE_SETUP
-#line 584 "indra.l"
+#line 586 "indra.l"
 { count(); yylval.ival = REGION_FLAGS_ALLOW_DIRECT_TELEPORT; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 455:
 YY_RULE_SETUP
-#line 585 "indra.l"
+#line 587 "indra.l"
 { count(); yylval.ival = REGION_FLAGS_RESTRICT_PUSHOBJECT; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 456:
 YY_RULE_SETUP
-#line 587 "indra.l"
+#line 589 "indra.l"
 { count(); yylval.ival = HTTP_METHOD; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 457:
 YY_RULE_SETUP
-#line 588 "indra.l"
+#line 590 "indra.l"
 { count(); yylval.ival = HTTP_MIMETYPE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 458:
 YY_RULE_SETUP
-#line 589 "indra.l"
+#line 591 "indra.l"
 { count(); yylval.ival = HTTP_BODY_MAXLENGTH; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 459:
 YY_RULE_SETUP
-#line 590 "indra.l"
+#line 592 "indra.l"
 { count(); yylval.ival = HTTP_BODY_TRUNCATED; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 460:
 YY_RULE_SETUP
-#line 591 "indra.l"
+#line 593 "indra.l"
 { count(); yylval.ival = HTTP_VERIFY_CERT; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 461:
 YY_RULE_SETUP
-#line 593 "indra.l"
+#line 595 "indra.l"
 { count(); yylval.ival = OC_TOTAL; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 462:
 YY_RULE_SETUP
-#line 594 "indra.l"
+#line 596 "indra.l"
 { count(); yylval.ival = OC_OWNER; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 463:
 YY_RULE_SETUP
-#line 595 "indra.l"
+#line 597 "indra.l"
 { count(); yylval.ival = OC_GROUP; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 464:
 YY_RULE_SETUP
-#line 596 "indra.l"
+#line 598 "indra.l"
 { count(); yylval.ival = OC_OTHER; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 465:
 YY_RULE_SETUP
-#line 597 "indra.l"
+#line 599 "indra.l"
 { count(); yylval.ival = OC_SELECTED; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 466:
 YY_RULE_SETUP
-#line 598 "indra.l"
+#line 600 "indra.l"
 { count(); yylval.ival = OC_TEMP; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 467:
 YY_RULE_SETUP
-#line 600 "indra.l"
+#line 602 "indra.l"
 { count(); yylval.ival = PARCEL_DETAILS_NAME; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 468:
 YY_RULE_SETUP
-#line 601 "indra.l"
+#line 603 "indra.l"
 { count(); yylval.ival = PARCEL_DETAILS_DESC; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 469:
 YY_RULE_SETUP
-#line 602 "indra.l"
+#line 604 "indra.l"
 { count(); yylval.ival = PARCEL_DETAILS_OWNER; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 470:
 YY_RULE_SETUP
-#line 603 "indra.l"
+#line 605 "indra.l"
 { count(); yylval.ival = PARCEL_DETAILS_GROUP; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 471:
 YY_RULE_SETUP
-#line 604 "indra.l"
+#line 606 "indra.l"
 { count(); yylval.ival = PARCEL_DETAILS_AREA; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 472:
 YY_RULE_SETUP
-#line 606 "indra.l"
+#line 608 "indra.l"
 { count(); yylval.ival = STRING_TRIM_HEAD; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 473:
 YY_RULE_SETUP
-#line 607 "indra.l"
+#line 609 "indra.l"
 { count(); yylval.ival = STRING_TRIM_TAIL; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 474:
 YY_RULE_SETUP
-#line 608 "indra.l"
+#line 610 "indra.l"
 { count(); yylval.ival = STRING_TRIM; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 475:
 YY_RULE_SETUP
-#line 610 "indra.l"
+#line 612 "indra.l"
 { count(); yylval.ival = CLICK_ACTION_NONE; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 476:
 YY_RULE_SETUP
-#line 611 "indra.l"
+#line 613 "indra.l"
 { count(); yylval.ival = CLICK_ACTION_TOUCH; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 477:
 YY_RULE_SETUP
-#line 612 "indra.l"
+#line 614 "indra.l"
 { count(); yylval.ival = CLICK_ACTION_SIT; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 478:
 YY_RULE_SETUP
-#line 613 "indra.l"
+#line 615 "indra.l"
 { count(); yylval.ival = CLICK_ACTION_BUY; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 479:
 YY_RULE_SETUP
-#line 614 "indra.l"
+#line 616 "indra.l"
 { count(); yylval.ival = CLICK_ACTION_PAY; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 480:
 YY_RULE_SETUP
-#line 615 "indra.l"
+#line 617 "indra.l"
 { count(); yylval.ival = CLICK_ACTION_OPEN; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 481:
 YY_RULE_SETUP
-#line 616 "indra.l"
+#line 618 "indra.l"
 { count(); yylval.ival = CLICK_ACTION_PLAY; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 482:
 YY_RULE_SETUP
-#line 617 "indra.l"
+#line 619 "indra.l"
 { count(); yylval.ival = CLICK_ACTION_OPEN_MEDIA; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 483:
 YY_RULE_SETUP
-#line 619 "indra.l"
+#line 621 "indra.l"
 { yylval.sval = new char[UUID_STR_LENGTH]; strcpy(yylval.sval, "5748decc-f629-461c-9a36-a35a221fe21f"); return(STRING_CONSTANT); }
 	YY_BREAK
 case 484:
 YY_RULE_SETUP
-#line 620 "indra.l"
+#line 622 "indra.l"
 { yylval.sval = new char[UUID_STR_LENGTH]; strcpy(yylval.sval, "89556747-24cb-43ed-920b-47caed15465f"); return(STRING_CONSTANT); }
 	YY_BREAK
 case 485:
 YY_RULE_SETUP
-#line 621 "indra.l"
+#line 623 "indra.l"
 { yylval.sval = new char[UUID_STR_LENGTH]; strcpy(yylval.sval, "8b5fec65-8d8d-9dc5-cda8-8fdf2716e361"); return(STRING_CONSTANT); }
 	YY_BREAK
 case 486:
 YY_RULE_SETUP
-#line 622 "indra.l"
+#line 624 "indra.l"
 { yylval.sval = new char[UUID_STR_LENGTH]; strcpy(yylval.sval, "89556747-24cb-43ed-920b-47caed15465f"); return(STRING_CONSTANT); }
 	YY_BREAK
 case 487:
 YY_RULE_SETUP
-#line 623 "indra.l"
+#line 625 "indra.l"
 { yylval.sval = new char[UUID_STR_LENGTH]; strcpy(yylval.sval, "8dcd4a48-2d37-4909-9f78-f7a9eb4ef903"); return(STRING_CONSTANT); }
 	YY_BREAK
 case 488:
 YY_RULE_SETUP
-#line 625 "indra.l"
+#line 627 "indra.l"
 { count(); yylval.ival = -1; return(INTEGER_CONSTANT); }
 	YY_BREAK
 case 489:
 YY_RULE_SETUP
-#line 626 "indra.l"
+#line 628 "indra.l"
 { count(); return(TOUCH_INVALID_VECTOR); }
 	YY_BREAK
 case 490:
 YY_RULE_SETUP
-#line 627 "indra.l"
+#line 629 "indra.l"
 { count(); return(TOUCH_INVALID_TEXCOORD); }
 	YY_BREAK
 case 491:
 YY_RULE_SETUP
-#line 630 "indra.l"
+#line 632 "indra.l"
 { count(); yylval.sval = new char[strlen(yytext) + 1]; strcpy(yylval.sval, yytext); return(IDENTIFIER); }
 	YY_BREAK
 case 492:
 YY_RULE_SETUP
-#line 632 "indra.l"
+#line 634 "indra.l"
 { count(); yylval.fval = (F32)atof(yytext); return(FP_CONSTANT); }
 	YY_BREAK
 case 493:
 YY_RULE_SETUP
-#line 633 "indra.l"
+#line 635 "indra.l"
 { count(); yylval.fval = (F32)atof(yytext); return(FP_CONSTANT); }
 	YY_BREAK
 case 494:
 YY_RULE_SETUP
-#line 634 "indra.l"
+#line 636 "indra.l"
 { count(); yylval.fval = (F32)atof(yytext); return(FP_CONSTANT); }
 	YY_BREAK
 case 495:
 /* rule 495 can match eol */
 YY_RULE_SETUP
-#line 636 "indra.l"
+#line 638 "indra.l"
 { parse_string(); count(); return(STRING_CONSTANT); }
 	YY_BREAK
 case 496:
 YY_RULE_SETUP
-#line 638 "indra.l"
+#line 640 "indra.l"
 { count(); return(INC_OP); }
 	YY_BREAK
 case 497:
 YY_RULE_SETUP
-#line 639 "indra.l"
+#line 641 "indra.l"
 { count(); return(DEC_OP); }
 	YY_BREAK
 case 498:
 YY_RULE_SETUP
-#line 640 "indra.l"
+#line 642 "indra.l"
 { count(); return(ADD_ASSIGN); }
 	YY_BREAK
 case 499:
 YY_RULE_SETUP
-#line 641 "indra.l"
+#line 643 "indra.l"
 { count(); return(SUB_ASSIGN); }
 	YY_BREAK
 case 500:
 YY_RULE_SETUP
-#line 642 "indra.l"
+#line 644 "indra.l"
 { count(); return(MUL_ASSIGN); }
 	YY_BREAK
 case 501:
 YY_RULE_SETUP
-#line 643 "indra.l"
+#line 645 "indra.l"
 { count(); return(DIV_ASSIGN); }
 	YY_BREAK
 case 502:
 YY_RULE_SETUP
-#line 644 "indra.l"
+#line 646 "indra.l"
 { count(); return(MOD_ASSIGN); }
 	YY_BREAK
 case 503:
 YY_RULE_SETUP
-#line 645 "indra.l"
+#line 647 "indra.l"
 { count(); return(';'); }
 	YY_BREAK
 case 504:
 YY_RULE_SETUP
-#line 646 "indra.l"
+#line 648 "indra.l"
 { count(); return('{'); }
 	YY_BREAK
 case 505:
 YY_RULE_SETUP
-#line 647 "indra.l"
+#line 649 "indra.l"
 { count(); return('}'); }
 	YY_BREAK
 case 506:
 YY_RULE_SETUP
-#line 648 "indra.l"
+#line 650 "indra.l"
 { count(); return(','); }
 	YY_BREAK
 case 507:
 YY_RULE_SETUP
-#line 649 "indra.l"
+#line 651 "indra.l"
 { count(); return('='); }
 	YY_BREAK
 case 508:
 YY_RULE_SETUP
-#line 650 "indra.l"
+#line 652 "indra.l"
 { count(); return('('); }
 	YY_BREAK
 case 509:
 YY_RULE_SETUP
-#line 651 "indra.l"
+#line 653 "indra.l"
 { count(); return(')'); }
 	YY_BREAK
 case 510:
 YY_RULE_SETUP
-#line 652 "indra.l"
+#line 654 "indra.l"
 { count(); return('-'); }
 	YY_BREAK
 case 511:
 YY_RULE_SETUP
-#line 653 "indra.l"
+#line 655 "indra.l"
 { count(); return('+'); }
 	YY_BREAK
 case 512:
 YY_RULE_SETUP
-#line 654 "indra.l"
+#line 656 "indra.l"
 { count(); return('*'); }
 	YY_BREAK
 case 513:
 YY_RULE_SETUP
-#line 655 "indra.l"
+#line 657 "indra.l"
 { count(); return('/'); }
 	YY_BREAK
 case 514:
 YY_RULE_SETUP
-#line 656 "indra.l"
+#line 658 "indra.l"
 { count(); return('%'); }
 	YY_BREAK
 case 515:
 YY_RULE_SETUP
-#line 657 "indra.l"
+#line 659 "indra.l"
 { count(); return('@'); }
 	YY_BREAK
 case 516:
 YY_RULE_SETUP
-#line 658 "indra.l"
+#line 660 "indra.l"
 { count(); return(':'); }
 	YY_BREAK
 case 517:
 YY_RULE_SETUP
-#line 659 "indra.l"
+#line 661 "indra.l"
 { count(); return('>'); }
 	YY_BREAK
 case 518:
 YY_RULE_SETUP
-#line 660 "indra.l"
+#line 662 "indra.l"
 { count(); return('<'); }
 	YY_BREAK
 case 519:
 YY_RULE_SETUP
-#line 661 "indra.l"
+#line 663 "indra.l"
 { count(); return(']'); }
 	YY_BREAK
 case 520:
 YY_RULE_SETUP
-#line 662 "indra.l"
+#line 664 "indra.l"
 { count(); return('['); }
 	YY_BREAK
 case 521:
 YY_RULE_SETUP
-#line 663 "indra.l"
+#line 665 "indra.l"
 { count(); return(EQ);  }
 	YY_BREAK
 case 522:
 YY_RULE_SETUP
-#line 664 "indra.l"
+#line 666 "indra.l"
 { count(); return(NEQ);  }
 	YY_BREAK
 case 523:
 YY_RULE_SETUP
-#line 665 "indra.l"
+#line 667 "indra.l"
 { count(); return(GEQ);  }
 	YY_BREAK
 case 524:
 YY_RULE_SETUP
-#line 666 "indra.l"
+#line 668 "indra.l"
 { count(); return(LEQ);  }
 	YY_BREAK
 case 525:
 YY_RULE_SETUP
-#line 667 "indra.l"
+#line 669 "indra.l"
 { count(); return('&');  }
 	YY_BREAK
 case 526:
 YY_RULE_SETUP
-#line 668 "indra.l"
+#line 670 "indra.l"
 { count(); return('|');  }
 	YY_BREAK
 case 527:
 YY_RULE_SETUP
-#line 669 "indra.l"
+#line 671 "indra.l"
 { count(); return('^');  }
 	YY_BREAK
 case 528:
 YY_RULE_SETUP
-#line 670 "indra.l"
+#line 672 "indra.l"
 { count(); return('~');  }
 	YY_BREAK
 case 529:
 YY_RULE_SETUP
-#line 671 "indra.l"
+#line 673 "indra.l"
 { count(); return('!');  }
 	YY_BREAK
 case 530:
 YY_RULE_SETUP
-#line 672 "indra.l"
+#line 674 "indra.l"
 { count(); return(BOOLEAN_AND);	}
 	YY_BREAK
 case 531:
 YY_RULE_SETUP
-#line 673 "indra.l"
+#line 675 "indra.l"
 { count(); return(BOOLEAN_OR);	}
 	YY_BREAK
 case 532:
 YY_RULE_SETUP
-#line 674 "indra.l"
+#line 676 "indra.l"
 { count(); return(SHIFT_LEFT);  }
 	YY_BREAK
 case 533:
 YY_RULE_SETUP
-#line 675 "indra.l"
+#line 677 "indra.l"
 { count(); return(SHIFT_RIGHT); }
 	YY_BREAK
 case 534:
 /* rule 534 can match eol */
 YY_RULE_SETUP
-#line 677 "indra.l"
+#line 679 "indra.l"
 { count(); }
 	YY_BREAK
 case 535:
 YY_RULE_SETUP
-#line 678 "indra.l"
+#line 680 "indra.l"
 { /* ignore bad characters */ }
 	YY_BREAK
 case 536:
 YY_RULE_SETUP
-#line 680 "indra.l"
+#line 682 "indra.l"
 ECHO;
 	YY_BREAK
-#line 5551 "indra_generated.l.cpp"
+#line 5553 "indra_generated.l.cpp"
 case YY_STATE_EOF(INITIAL):
 	yyterminate();
 
@@ -6545,27 +6547,134 @@ void yyfree (void * ptr )
 
 #define YYTABLES_NAME "yytables"
 
-#line 680 "indra.l"
+#line 682 "indra.l"
 
 
+ll_thread_local LLScriptAllocationManager	*gAllocationManager;
+ll_thread_local LLScriptScript				*gScriptp;
 
-LLScriptAllocationManager	*gAllocationManager;
-LLScriptScript				*gScriptp;
+// A token as the scanner returned it, with the position count() gave it.
+struct LLScriptToken
+{
+	int			mToken;
+	YYSTYPE		mValue;
+	S32			mLine;
+	S32			mColumn;
+};
 
-// Prototype for the yacc parser entry point
-int yyparse(void);
+typedef std::vector<LLScriptToken> token_list_t;
+
+// The flex scanner keeps its state in globals, so scripts are scanned one at a
+// time into a token list and parsed from that on the compiling thread.
+static LLMutex* sScannerMutex = NULL;
+static BOOL sExpressionsInitialized = FALSE;
+
+static ll_thread_local token_list_t* sTokens = NULL;
+static ll_thread_local S32 sNextToken = 0;
+static ll_thread_local LLFILE* sErrorFile = NULL;
+
+void lscript_compile_init()
+{
+	if (!sScannerMutex)
+	{
+		sScannerMutex = new LLMutex;
+	}
+	if (!sExpressionsInitialized)
+	{
+		init_supported_expressions();
+		sExpressionsInitialized = TRUE;
+	}
+}
+
+void lscript_compile_cleanup()
+{
+	delete sScannerMutex;
+	sScannerMutex = NULL;
+}
+
+static void scan_tokens(const char* source, S32 length, token_list_t& tokens)
+{
+	// Without lscript_compile_init() there is only ever one compile running.
+	if (sScannerMutex)
+	{
+		sScannerMutex->lock();
+	}
+
+	if (!sExpressionsInitialized)
+	{
+		init_supported_expressions();
+		sExpressionsInitialized = TRUE;
+	}
+
+	YY_BUFFER_STATE buffer = yy_scan_bytes(source, length);
+	LLScriptToken token;
+	do
+	{
+		token.mToken = yylex();
+		token.mValue = yylval;
+		token.mLine = gLine;
+		token.mColumn = gColumn;
+		tokens.push_back(token);
+	}
+	while (token.mToken);
+	yy_delete_buffer(buffer);
+
+	if (sScannerMutex)
+	{
+		sScannerMutex->unlock();
+	}
+}
+
+// A syntax error stops the parser before it has read every token; the
+// strings of the rest are never handed to it.
+static void free_unparsed_tokens(token_list_t& tokens, S32 first)
+{
+	for (S32 i = first; i < (S32)tokens.size(); i++)
+	{
+		switch (tokens[i].mToken)
+		{
+		case IDENTIFIER:
+		case STATE_DEFAULT:
+		case STRING_CONSTANT:
+			delete [] tokens[i].mValue.sval;
+			tokens[i].mValue.sval = NULL;
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+// Lexer entry point for the parser
+int lscript_next_token(YYSTYPE* lvalp)
+{
+	const LLScriptToken& token = (*sTokens)[sNextToken];
+	if (token.mToken)
+	{
+		// the end of input token is handed out for every call past the end
+		sNextToken++;
+	}
+	*lvalp = token.mValue;
+	gLine = token.mLine;
+	gColumn = token.mColumn;
+	return token.mToken;
+}
 
 int yyerror(const char *fmt, ...)
 {
-	gErrorToText.writeError(yyout, gLine, gColumn, LSERROR_SYNTAX_ERROR);
+	gErrorToText.writeError(sErrorFile, gLine, gColumn, LSERROR_SYNTAX_ERROR);
 	return 0;
 }
 
 //#define EMERGENCY_DEBUG_PRINTOUTS
 //#define EMIT_CIL_ASSEMBLER
 
-BOOL lscript_compile(const char* src_filename, const char* dst_filename,
-					 const char* err_filename, BOOL compile_to_mono, const char* class_name, BOOL is_god_like)
+// Runs the scanner, parser and all compile passes over source.  Errors are written to efp,
+// or appended to errors when that is set.  LSO bytecode is written to dst_filename, or
+// stored in bytecode when that is set.
+static BOOL compile_source(const std::string& source, LLFILE* efp, std::string* errors,
+						   const char* dst_filename, std::vector<U8>* bytecode,
+						   BOOL compile_to_mono, const char* class_name, BOOL is_god_like)
 {
 	BOOL			b_parse_ok = FALSE;
 	BOOL			b_dummy = FALSE;
@@ -6574,79 +6683,116 @@ BOOL lscript_compile(const char* src_filename, const char* dst_filename,
 
 	gInternalColumn = 0;
 	gInternalLine = 0;
+	gColumn = 0;
+	gLine = 0;
 	gScriptp = NULL;
 
-	gErrorToText.init();
-	init_supported_expressions();
+	gErrorToText.init(errors);
 	init_temp_jumps();
 	gAllocationManager = new LLScriptAllocationManager();
+	sErrorFile = efp;
 
-	yyin = LLFile::fopen(std::string(src_filename), "r");
-	if (yyin)
-	{
-		yyout = LLFile::fopen(std::string(err_filename), "w");
-
-		// Reset the lexer's internal buffering.
-
-	    yyrestart(yyin);
+	token_list_t tokens;
+	scan_tokens(source.data(), (S32)source.size(), tokens);
+	sTokens = &tokens;
+	sNextToken = 0;
 
-		b_parse_ok = !yyparse();
+	b_parse_ok = !yyparse();
+	free_unparsed_tokens(tokens, sNextToken);
 
-		if (b_parse_ok)
-		{
+	if (b_parse_ok)
+	{
 #ifdef EMERGENCY_DEBUG_PRINTOUTS
-			char compiled[256];
-			sprintf(compiled, "%s.o", src_filename);
-			LLFILE* compfile;
-			compfile = LLFile::fopen(compiled, "w");
+		char compiled[256];
+		sprintf(compiled, "%s.o", class_name);
+		LLFILE* compfile;
+		compfile = LLFile::fopen(compiled, "w");
 #endif
 
-			if(dst_filename)
-			{
-				gScriptp->setBytecodeDest(dst_filename);
-			}
+		if(dst_filename)
+		{
+			gScriptp->setBytecodeDest(dst_filename);
+		}
+		gScriptp->setBytecodeBuffer(bytecode);
 
-			gScriptp->mGodLike = is_god_like;
-			
-			gScriptp->setClassName(class_name);
+		gScriptp->mGodLike = is_god_like;
+		
+		gScriptp->setClassName(class_name);
 
-			gScopeStringTable = new LLStringTable(16384);
+		gScopeStringTable = new LLStringTable(16384);
 #ifdef EMERGENCY_DEBUG_PRINTOUTS
-			gScriptp->recurse(compfile, 0, 4, LSCP_PRETTY_PRINT, LSPRUNE_INVALID, b_dummy, NULL, type, type, b_dummy_count, NULL, NULL, 0, NULL, 0, NULL);
+		gScriptp->recurse(compfile, 0, 4, LSCP_PRETTY_PRINT, LSPRUNE_INVALID, b_dummy, NULL, type, type, b_dummy_count, NULL, NULL, 0, NULL, 0, NULL);
 #endif
-			gScriptp->recurse(yyout, 0, 0, LSCP_PRUNE,		 LSPRUNE_INVALID, b_dummy, NULL, type, type, b_dummy_count, NULL, NULL, 0, NULL, 0, NULL);
-			gScriptp->recurse(yyout, 0, 0, LSCP_SCOPE_PASS1, LSPRUNE_INVALID, b_dummy, NULL, type, type, b_dummy_count, NULL, NULL, 0, NULL, 0, NULL);
-			gScriptp->recurse(yyout, 0, 0, LSCP_SCOPE_PASS2, LSPRUNE_INVALID, b_dummy, NULL, type, type, b_dummy_count, NULL, NULL, 0, NULL, 0, NULL);
-			gScriptp->recurse(yyout, 0, 0, LSCP_TYPE,		 LSPRUNE_INVALID, b_dummy, NULL, type, type, b_dummy_count, NULL, NULL, 0, NULL, 0, NULL);
-			if (!gErrorToText.getErrors())
-			{
-				gScriptp->recurse(yyout, 0, 0, LSCP_RESOURCE, LSPRUNE_INVALID,		 b_dummy, NULL, type, type, b_dummy_count, NULL, NULL, 0, NULL, 0, NULL);
+		gScriptp->recurse(efp, 0, 0, LSCP_PRUNE,		 LSPRUNE_INVALID, b_dummy, NULL, type, type, b_dummy_count, NULL, NULL, 0, NULL, 0, NULL);
+		gScriptp->recurse(efp, 0, 0, LSCP_SCOPE_PASS1, LSPRUNE_INVALID, b_dummy, NULL, type, type, b_dummy_count, NULL, NULL, 0, NULL, 0, NULL);
+		gScriptp->recurse(efp, 0, 0, LSCP_SCOPE_PASS2, LSPRUNE_INVALID, b_dummy, NULL, type, type, b_dummy_count, NULL, NULL, 0, NULL, 0, NULL);
+		gScriptp->recurse(efp, 0, 0, LSCP_TYPE,		 LSPRUNE_INVALID, b_dummy, NULL, type, type, b_dummy_count, NULL, NULL, 0, NULL, 0, NULL);
+		if (!gErrorToText.getErrors())
+		{
+			gScriptp->recurse(efp, 0, 0, LSCP_RESOURCE, LSPRUNE_INVALID,		 b_dummy, NULL, type, type, b_dummy_count, NULL, NULL, 0, NULL, 0, NULL);
 #ifdef EMERGENCY_DEBUG_PRINTOUTS
-				gScriptp->recurse(yyout, 0, 0, LSCP_EMIT_ASSEMBLY, LSPRUNE_INVALID,  b_dummy, NULL, type, type, b_dummy_count, NULL, NULL, 0, NULL, 0, NULL);
+			gScriptp->recurse(efp, 0, 0, LSCP_EMIT_ASSEMBLY, LSPRUNE_INVALID,  b_dummy, NULL, type, type, b_dummy_count, NULL, NULL, 0, NULL, 0, NULL);
 #endif
-				if(TRUE == compile_to_mono)
-				{
-					gScriptp->recurse(yyout, 0, 0, LSCP_EMIT_CIL_ASSEMBLY, LSPRUNE_INVALID,  b_dummy, NULL, type, type, b_dummy_count, NULL, NULL, 0, NULL, 0, NULL);
-				}
-				else
-				{
-					gScriptp->recurse(yyout, 0, 0, LSCP_EMIT_BYTE_CODE, LSPRUNE_INVALID, b_dummy, NULL, type, type, b_dummy_count, NULL, NULL, 0, NULL, 0, NULL);
-				}
+			if(TRUE == compile_to_mono)
+			{
+				gScriptp->recurse(efp, 0, 0, LSCP_EMIT_CIL_ASSEMBLY, LSPRUNE_INVALID,  b_dummy, NULL, type, type, b_dummy_count, NULL, NULL, 0, NULL, 0, NULL);
 			}
-			delete gScopeStringTable;
-			gScopeStringTable = NULL;
+			else
+			{
+				gScriptp->recurse(efp, 0, 0, LSCP_EMIT_BYTE_CODE, LSPRUNE_INVALID, b_dummy, NULL, type, type, b_dummy_count, NULL, NULL, 0, NULL, 0, NULL);
+			}
+		}
+		delete gScopeStringTable;
+		gScopeStringTable = NULL;
 #ifdef EMERGENCY_DEBUG_PRINTOUTS
-			fclose(compfile);
+		fclose(compfile);
 #endif
-		}
-		fclose(yyout);
-		fclose(yyin);
 	}
 
+	sTokens = NULL;
+	sErrorFile = NULL;
 	delete gAllocationManager;
-	delete gScopeStringTable;
-	
-	return b_parse_ok && !gErrorToText.getErrors();
+	gAllocationManager = NULL;
+	gScriptp = NULL;
+
+	BOOL success = b_parse_ok && !gErrorToText.getErrors();
+	gErrorToText.init();
+	return success;
+}
+
+BOOL lscript_compile(const char* src_filename, const char* dst_filename,
+					 const char* err_filename, BOOL compile_to_mono, const char* class_name, BOOL is_god_like)
+{
+	LLFILE* src_fp = LLFile::fopen(std::string(src_filename), "r");
+	if (!src_fp)
+	{
+		return FALSE;
+	}
+
+	std::string source;
+	char buffer[4096];		/*Flawfinder: ignore*/
+	size_t bytes_read;
+	while ((bytes_read = fread(buffer, 1, sizeof(buffer), src_fp)) > 0)
+	{
+		source.append(buffer, bytes_read);
+	}
+	fclose(src_fp);
+
+	LLFILE* err_fp = LLFile::fopen(std::string(err_filename), "w");
+	BOOL success = compile_source(source, err_fp, NULL, dst_filename, NULL, compile_to_mono, class_name, is_god_like);
+	if (err_fp)
+	{
+		fclose(err_fp);
+	}
+	return success;
+}
+
+BOOL lscript_compile_buffer(const std::string& source, std::vector<U8>& bytecode,
+							std::string& errors, BOOL is_god_like)
+{
+	bytecode.clear();
+	errors.clear();
+	return compile_source(source, NULL, &errors, NULL, &bytecode, FALSE, "", is_god_like);
 }
 
 
@@ -1,23 +1,22 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
-/* A Bison parser, made by GNU Bison 2.4.1.  */
+/* Bison implementation for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
-/* Skeleton implementation for Bison's Yacc-like parsers in C
-   
-      Copyright (C) 1984, 1989, 1990, 2000, 2001, 2002, 2003, 2004, 2005, 2006
-   Free Software Foundation, Inc.
-   
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
    the Free Software Foundation, either version 3 of the License, or
    (at your option) any later version.
-   
+
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
    GNU General Public License for more details.
-   
+
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -28,13 +27,17 @@
    special exception, which will cause the skeleton and the resulting
    Bison output files to be licensed under the GNU General Public
    License without this special exception.
-   
+
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -42,17 +45,17 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "2.4.1"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
 
 /* Pure parsers.  */
-#define YYPURE 0
+#define YYPURE 1
 
 /* Push parsers.  */
 #define YYPUSH 0
@@ -60,14 +63,10 @@
 /* Pull parsers.  */
 #define YYPULL 1
 
-/* Using locations.  */
-#define YYLSP_NEEDED 0
 
 
 
-/* Copy the first part of user declarations.  */
-
-/* Line 189 of yacc.c  */
+/* First part of user prologue.  */
 #line 1 "indra.y"
 
 // We maintain a pre-generated parser source file to simplify user builds.
@@ -82,13 +81,9 @@
 	#include "linden_common.h"
 	#include "lscript_tree.h"
 
-    #ifdef __cplusplus
-    extern "C" {
-    #endif
-
-	int yylex(void);
-	int yyparse( void );
-	int yyerror(const char *fmt, ...);
+	// Tokens come from the list lscript_compile() scanned beforehand rather than
+	// straight from the flex scanner, see lscript_next_token() in indra.l.
+	#define yylex lscript_next_token
 
     #if LL_LINUX
     // broken yacc codegen...  --ryan.
@@ -100,195 +95,317 @@
 	#pragma warning( disable : 4065 )	// warning: switch statement contains 'default' but no 'case' labels
 	#endif
 
-    #ifdef __cplusplus
-    }
-    #endif
-
+#line 99 "indra_generated.y.cpp"
 
-/* Line 189 of yacc.c  */
-#line 110 "indra_generated.y.cpp"
-
-/* Enabling traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
-#endif
-
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 0
-#endif
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
 
-/* Enabling the token table.  */
-#ifndef YYTOKEN_TABLE
-# define YYTOKEN_TABLE 0
-#endif
+#include "indra_generated.y.hpp"
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_INTEGER = 3,                    /* INTEGER  */
+  YYSYMBOL_FLOAT_TYPE = 4,                 /* FLOAT_TYPE  */
+  YYSYMBOL_STRING = 5,                     /* STRING  */
+  YYSYMBOL_LLKEY = 6,                      /* LLKEY  */
+  YYSYMBOL_VECTOR = 7,                     /* VECTOR  */
+  YYSYMBOL_QUATERNION = 8,                 /* QUATERNION  */
+  YYSYMBOL_LIST = 9,                       /* LIST  */
+  YYSYMBOL_STATE = 10,                     /* STATE  */
+  YYSYMBOL_EVENT = 11,                     /* EVENT  */
+  YYSYMBOL_JUMP = 12,                      /* JUMP  */
+  YYSYMBOL_RETURN = 13,                    /* RETURN  */
+  YYSYMBOL_STATE_ENTRY = 14,               /* STATE_ENTRY  */
+  YYSYMBOL_STATE_EXIT = 15,                /* STATE_EXIT  */
+  YYSYMBOL_TOUCH_START = 16,               /* TOUCH_START  */
+  YYSYMBOL_TOUCH = 17,                     /* TOUCH  */
+  YYSYMBOL_TOUCH_END = 18,                 /* TOUCH_END  */
+  YYSYMBOL_COLLISION_START = 19,           /* COLLISION_START  */
+  YYSYMBOL_COLLISION = 20,                 /* COLLISION  */
+  YYSYMBOL_COLLISION_END = 21,             /* COLLISION_END  */
+  YYSYMBOL_LAND_COLLISION_START = 22,      /* LAND_COLLISION_START  */
+  YYSYMBOL_LAND_COLLISION = 23,            /* LAND_COLLISION  */
+  YYSYMBOL_LAND_COLLISION_END = 24,        /* LAND_COLLISION_END  */
+  YYSYMBOL_TIMER = 25,                     /* TIMER  */
+  YYSYMBOL_CHAT = 26,                      /* CHAT  */
+  YYSYMBOL_SENSOR = 27,                    /* SENSOR  */
+  YYSYMBOL_NO_SENSOR = 28,                 /* NO_SENSOR  */
+  YYSYMBOL_CONTROL = 29,                   /* CONTROL  */
+  YYSYMBOL_AT_TARGET = 30,                 /* AT_TARGET  */
+  YYSYMBOL_NOT_AT_TARGET = 31,             /* NOT_AT_TARGET  */
+  YYSYMBOL_AT_ROT_TARGET = 32,             /* AT_ROT_TARGET  */
+  YYSYMBOL_NOT_AT_ROT_TARGET = 33,         /* NOT_AT_ROT_TARGET  */
+  YYSYMBOL_MONEY = 34,                     /* MONEY  */
+  YYSYMBOL_EMAIL = 35,                     /* EMAIL  */
+  YYSYMBOL_RUN_TIME_PERMISSIONS = 36,      /* RUN_TIME_PERMISSIONS  */
+  YYSYMBOL_INVENTORY = 37,                 /* INVENTORY  */
+  YYSYMBOL_ATTACH = 38,                    /* ATTACH  */
+  YYSYMBOL_DATASERVER = 39,                /* DATASERVER  */
+  YYSYMBOL_MOVING_START = 40,              /* MOVING_START  */
+  YYSYMBOL_MOVING_END = 41,                /* MOVING_END  */
+  YYSYMBOL_REZ = 42,                       /* REZ  */
+  YYSYMBOL_OBJECT_REZ = 43,                /* OBJECT_REZ  */
+  YYSYMBOL_LINK_MESSAGE = 44,              /* LINK_MESSAGE  */
+  YYSYMBOL_REMOTE_DATA = 45,               /* REMOTE_DATA  */
+  YYSYMBOL_HTTP_RESPONSE = 46,             /* HTTP_RESPONSE  */
+  YYSYMBOL_HTTP_REQUEST = 47,              /* HTTP_REQUEST  */
+  YYSYMBOL_IDENTIFIER = 48,                /* IDENTIFIER  */
+  YYSYMBOL_STATE_DEFAULT = 49,             /* STATE_DEFAULT  */
+  YYSYMBOL_INTEGER_CONSTANT = 50,          /* INTEGER_CONSTANT  */
+  YYSYMBOL_INTEGER_TRUE = 51,              /* INTEGER_TRUE  */
+  YYSYMBOL_INTEGER_FALSE = 52,             /* INTEGER_FALSE  */
+  YYSYMBOL_FP_CONSTANT = 53,               /* FP_CONSTANT  */
+  YYSYMBOL_STRING_CONSTANT = 54,           /* STRING_CONSTANT  */
+  YYSYMBOL_INC_OP = 55,                    /* INC_OP  */
+  YYSYMBOL_DEC_OP = 56,                    /* DEC_OP  */
+  YYSYMBOL_ADD_ASSIGN = 57,                /* ADD_ASSIGN  */
+  YYSYMBOL_SUB_ASSIGN = 58,                /* SUB_ASSIGN  */
+  YYSYMBOL_MUL_ASSIGN = 59,                /* MUL_ASSIGN  */
+  YYSYMBOL_DIV_ASSIGN = 60,                /* DIV_ASSIGN  */
+  YYSYMBOL_MOD_ASSIGN = 61,                /* MOD_ASSIGN  */
+  YYSYMBOL_EQ = 62,                        /* EQ  */
+  YYSYMBOL_NEQ = 63,                       /* NEQ  */
+  YYSYMBOL_GEQ = 64,                       /* GEQ  */
+  YYSYMBOL_LEQ = 65,                       /* LEQ  */
+  YYSYMBOL_BOOLEAN_AND = 66,               /* BOOLEAN_AND  */
+  YYSYMBOL_BOOLEAN_OR = 67,                /* BOOLEAN_OR  */
+  YYSYMBOL_SHIFT_LEFT = 68,                /* SHIFT_LEFT  */
+  YYSYMBOL_SHIFT_RIGHT = 69,               /* SHIFT_RIGHT  */
+  YYSYMBOL_IF = 70,                        /* IF  */
+  YYSYMBOL_ELSE = 71,                      /* ELSE  */
+  YYSYMBOL_FOR = 72,                       /* FOR  */
+  YYSYMBOL_DO = 73,                        /* DO  */
+  YYSYMBOL_WHILE = 74,                     /* WHILE  */
+  YYSYMBOL_PRINT = 75,                     /* PRINT  */
+  YYSYMBOL_PERIOD = 76,                    /* PERIOD  */
+  YYSYMBOL_ZERO_VECTOR = 77,               /* ZERO_VECTOR  */
+  YYSYMBOL_ZERO_ROTATION = 78,             /* ZERO_ROTATION  */
+  YYSYMBOL_TOUCH_INVALID_VECTOR = 79,      /* TOUCH_INVALID_VECTOR  */
+  YYSYMBOL_TOUCH_INVALID_TEXCOORD = 80,    /* TOUCH_INVALID_TEXCOORD  */
+  YYSYMBOL_LOWER_THAN_ELSE = 81,           /* LOWER_THAN_ELSE  */
+  YYSYMBOL_82_ = 82,                       /* ';'  */
+  YYSYMBOL_83_ = 83,                       /* '@'  */
+  YYSYMBOL_84_ = 84,                       /* '-'  */
+  YYSYMBOL_85_ = 85,                       /* '!'  */
+  YYSYMBOL_86_ = 86,                       /* '~'  */
+  YYSYMBOL_87_ = 87,                       /* '='  */
+  YYSYMBOL_88_ = 88,                       /* '<'  */
+  YYSYMBOL_89_ = 89,                       /* '>'  */
+  YYSYMBOL_90_ = 90,                       /* '+'  */
+  YYSYMBOL_91_ = 91,                       /* '*'  */
+  YYSYMBOL_92_ = 92,                       /* '/'  */
+  YYSYMBOL_93_ = 93,                       /* '%'  */
+  YYSYMBOL_94_ = 94,                       /* '&'  */
+  YYSYMBOL_95_ = 95,                       /* '|'  */
+  YYSYMBOL_96_ = 96,                       /* '^'  */
+  YYSYMBOL_97_ = 97,                       /* '('  */
+  YYSYMBOL_98_ = 98,                       /* ')'  */
+  YYSYMBOL_INITIALIZER = 99,               /* INITIALIZER  */
+  YYSYMBOL_100_ = 100,                     /* ','  */
+  YYSYMBOL_101_ = 101,                     /* '['  */
+  YYSYMBOL_102_ = 102,                     /* ']'  */
+  YYSYMBOL_103_ = 103,                     /* '{'  */
+  YYSYMBOL_104_ = 104,                     /* '}'  */
+  YYSYMBOL_YYACCEPT = 105,                 /* $accept  */
+  YYSYMBOL_lscript_program = 106,          /* lscript_program  */
+  YYSYMBOL_globals = 107,                  /* globals  */
+  YYSYMBOL_global = 108,                   /* global  */
+  YYSYMBOL_name_type = 109,                /* name_type  */
+  YYSYMBOL_global_variable = 110,          /* global_variable  */
+  YYSYMBOL_simple_assignable = 111,        /* simple_assignable  */
+  YYSYMBOL_simple_assignable_no_list = 112, /* simple_assignable_no_list  */
+  YYSYMBOL_constant = 113,                 /* constant  */
+  YYSYMBOL_fp_constant = 114,              /* fp_constant  */
+  YYSYMBOL_integer_constant = 115,         /* integer_constant  */
+  YYSYMBOL_special_constant = 116,         /* special_constant  */
+  YYSYMBOL_vector_constant = 117,          /* vector_constant  */
+  YYSYMBOL_quaternion_constant = 118,      /* quaternion_constant  */
+  YYSYMBOL_list_constant = 119,            /* list_constant  */
+  YYSYMBOL_list_entries = 120,             /* list_entries  */
+  YYSYMBOL_list_entry = 121,               /* list_entry  */
+  YYSYMBOL_typename = 122,                 /* typename  */
+  YYSYMBOL_global_function = 123,          /* global_function  */
+  YYSYMBOL_function_parameters = 124,      /* function_parameters  */
+  YYSYMBOL_function_parameter = 125,       /* function_parameter  */
+  YYSYMBOL_states = 126,                   /* states  */
+  YYSYMBOL_other_states = 127,             /* other_states  */
+  YYSYMBOL_default = 128,                  /* default  */
+  YYSYMBOL_state = 129,                    /* state  */
+  YYSYMBOL_state_body = 130,               /* state_body  */
+  YYSYMBOL_event = 131,                    /* event  */
+  YYSYMBOL_state_entry = 132,              /* state_entry  */
+  YYSYMBOL_state_exit = 133,               /* state_exit  */
+  YYSYMBOL_touch_start = 134,              /* touch_start  */
+  YYSYMBOL_touch = 135,                    /* touch  */
+  YYSYMBOL_touch_end = 136,                /* touch_end  */
+  YYSYMBOL_collision_start = 137,          /* collision_start  */
+  YYSYMBOL_collision = 138,                /* collision  */
+  YYSYMBOL_collision_end = 139,            /* collision_end  */
+  YYSYMBOL_land_collision_start = 140,     /* land_collision_start  */
+  YYSYMBOL_land_collision = 141,           /* land_collision  */
+  YYSYMBOL_land_collision_end = 142,       /* land_collision_end  */
+  YYSYMBOL_at_target = 143,                /* at_target  */
+  YYSYMBOL_not_at_target = 144,            /* not_at_target  */
+  YYSYMBOL_at_rot_target = 145,            /* at_rot_target  */
+  YYSYMBOL_not_at_rot_target = 146,        /* not_at_rot_target  */
+  YYSYMBOL_money = 147,                    /* money  */
+  YYSYMBOL_email = 148,                    /* email  */
+  YYSYMBOL_run_time_permissions = 149,     /* run_time_permissions  */
+  YYSYMBOL_inventory = 150,                /* inventory  */
+  YYSYMBOL_attach = 151,                   /* attach  */
+  YYSYMBOL_dataserver = 152,               /* dataserver  */
+  YYSYMBOL_moving_start = 153,             /* moving_start  */
+  YYSYMBOL_moving_end = 154,               /* moving_end  */
+  YYSYMBOL_timer = 155,                    /* timer  */
+  YYSYMBOL_chat = 156,                     /* chat  */
+  YYSYMBOL_sensor = 157,                   /* sensor  */
+  YYSYMBOL_no_sensor = 158,                /* no_sensor  */
+  YYSYMBOL_control = 159,                  /* control  */
+  YYSYMBOL_rez = 160,                      /* rez  */
+  YYSYMBOL_object_rez = 161,               /* object_rez  */
+  YYSYMBOL_link_message = 162,             /* link_message  */
+  YYSYMBOL_remote_data = 163,              /* remote_data  */
+  YYSYMBOL_http_response = 164,            /* http_response  */
+  YYSYMBOL_http_request = 165,             /* http_request  */
+  YYSYMBOL_compound_statement = 166,       /* compound_statement  */
+  YYSYMBOL_statements = 167,               /* statements  */
+  YYSYMBOL_statement = 168,                /* statement  */
+  YYSYMBOL_declaration = 169,              /* declaration  */
+  YYSYMBOL_forexpressionlist = 170,        /* forexpressionlist  */
+  YYSYMBOL_nextforexpressionlist = 171,    /* nextforexpressionlist  */
+  YYSYMBOL_funcexpressionlist = 172,       /* funcexpressionlist  */
+  YYSYMBOL_nextfuncexpressionlist = 173,   /* nextfuncexpressionlist  */
+  YYSYMBOL_listexpressionlist = 174,       /* listexpressionlist  */
+  YYSYMBOL_nextlistexpressionlist = 175,   /* nextlistexpressionlist  */
+  YYSYMBOL_expression = 176,               /* expression  */
+  YYSYMBOL_unaryexpression = 177,          /* unaryexpression  */
+  YYSYMBOL_typecast = 178,                 /* typecast  */
+  YYSYMBOL_unarypostfixexpression = 179,   /* unarypostfixexpression  */
+  YYSYMBOL_vector_initializer = 180,       /* vector_initializer  */
+  YYSYMBOL_quaternion_initializer = 181,   /* quaternion_initializer  */
+  YYSYMBOL_list_initializer = 182,         /* list_initializer  */
+  YYSYMBOL_lvalue = 183                    /* lvalue  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
 
-/* Tokens.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     INTEGER = 258,
-     FLOAT_TYPE = 259,
-     STRING = 260,
-     LLKEY = 261,
-     VECTOR = 262,
-     QUATERNION = 263,
-     LIST = 264,
-     STATE = 265,
-     EVENT = 266,
-     JUMP = 267,
-     RETURN = 268,
-     STATE_ENTRY = 269,
-     STATE_EXIT = 270,
-     TOUCH_START = 271,
-     TOUCH = 272,
-     TOUCH_END = 273,
-     COLLISION_START = 274,
-     COLLISION = 275,
-     COLLISION_END = 276,
-     LAND_COLLISION_START = 277,
-     LAND_COLLISION = 278,
-     LAND_COLLISION_END = 279,
-     TIMER = 280,
-     CHAT = 281,
-     SENSOR = 282,
-     NO_SENSOR = 283,
-     CONTROL = 284,
-     AT_TARGET = 285,
-     NOT_AT_TARGET = 286,
-     AT_ROT_TARGET = 287,
-     NOT_AT_ROT_TARGET = 288,
-     MONEY = 289,
-     EMAIL = 290,
-     RUN_TIME_PERMISSIONS = 291,
-     INVENTORY = 292,
-     ATTACH = 293,
-     DATASERVER = 294,
-     MOVING_START = 295,
-     MOVING_END = 296,
-     REZ = 297,
-     OBJECT_REZ = 298,
-     LINK_MESSAGE = 299,
-     REMOTE_DATA = 300,
-     HTTP_RESPONSE = 301,
-     HTTP_REQUEST = 302,
-     IDENTIFIER = 303,
-     STATE_DEFAULT = 304,
-     INTEGER_CONSTANT = 305,
-     INTEGER_TRUE = 306,
-     INTEGER_FALSE = 307,
-     FP_CONSTANT = 308,
-     STRING_CONSTANT = 309,
-     INC_OP = 310,
-     DEC_OP = 311,
-     ADD_ASSIGN = 312,
-     SUB_ASSIGN = 313,
-     MUL_ASSIGN = 314,
-     DIV_ASSIGN = 315,
-     MOD_ASSIGN = 316,
-     EQ = 317,
-     NEQ = 318,
-     GEQ = 319,
-     LEQ = 320,
-     BOOLEAN_AND = 321,
-     BOOLEAN_OR = 322,
-     SHIFT_LEFT = 323,
-     SHIFT_RIGHT = 324,
-     IF = 325,
-     ELSE = 326,
-     FOR = 327,
-     DO = 328,
-     WHILE = 329,
-     PRINT = 330,
-     PERIOD = 331,
-     ZERO_VECTOR = 332,
-     ZERO_ROTATION = 333,
-     TOUCH_INVALID_VECTOR = 334,
-     TOUCH_INVALID_TEXCOORD = 335,
-     LOWER_THAN_ELSE = 336,
-     INITIALIZER = 337
-   };
-#endif
+/* Second part of user prologue.  */
+#line 53 "indra.y"
 
+	int lscript_next_token(YYSTYPE* lvalp);
+	int yyparse(void);
+	int yyerror(const char *fmt, ...);
 
+#line 322 "indra_generated.y.cpp"
 
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE
-{
 
-/* Line 214 of yacc.c  */
-#line 38 "indra.y"
-
-	S32								ival;
-	F32								fval;
-	char							*sval;
-	class LLScriptType				*type;
-	class LLScriptConstant			*constant;
-	class LLScriptIdentifier		*identifier;
-	class LLScriptSimpleAssignable	*assignable;
-	class LLScriptGlobalVariable	*global;
-	class LLScriptEvent				*event;
-	class LLScriptEventHandler		*handler;
-	class LLScriptExpression		*expression;
-	class LLScriptStatement			*statement;
-	class LLScriptGlobalFunctions	*global_funcs;
-	class LLScriptFunctionDec		*global_decl;
-	class LLScriptState				*state;
-	class LLScritpGlobalStorage		*global_store;
-	class LLScriptScript			*script;
-
-
-
-/* Line 214 of yacc.c  */
-#line 250 "indra_generated.y.cpp"
-} YYSTYPE;
-# define YYSTYPE_IS_TRIVIAL 1
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
-# define YYSTYPE_IS_DECLARED 1
+#ifdef short
+# undef short
 #endif
 
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
 
-/* Copy the second part of user declarations.  */
-
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
 
-/* Line 264 of yacc.c  */
-#line 262 "indra_generated.y.cpp"
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
 
-#ifdef short
-# undef short
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
 #else
-typedef unsigned char yytype_uint8;
+typedef short yytype_int16;
 #endif
 
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
-#elif (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-typedef signed char yytype_int8;
-#else
-typedef short int yytype_int8;
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
 #else
-typedef unsigned short int yytype_uint16;
+typedef short yytype_uint8;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
 #else
-typedef short int yytype_int16;
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -296,55 +413,106 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int16 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
-# if YYENABLE_NLS
+# if defined YYENABLE_NLS && YYENABLE_NLS
 #  if ENABLE_NLS
 #   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
-#   define YY_(msgid) dgettext ("bison-runtime", msgid)
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
 #  endif
 # endif
 # ifndef YY_
-#  define YY_(msgid) msgid
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
 # endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(e) ((void) (e))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(e) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-/* Identity function, used to suppress warnings about constant conditions.  */
-#ifndef lint
-# define YYID(n) (n)
-#else
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static int
-YYID (int yyi)
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
 #else
-static int
-YYID (yyi)
-    int yyi;
+# define YY_INITIAL_VALUE(Value) Value
 #endif
-{
-  return yyi;
-}
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
 #endif
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if !defined yyoverflow
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -361,11 +529,11 @@ YYID (yyi)
 #    define alloca _alloca
 #   else
 #    define YYSTACK_ALLOC alloca
-#    if ! defined _ALLOCA_H && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
 #     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
-#     ifndef _STDLIB_H
-#      define _STDLIB_H 1
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
+#     ifndef EXIT_SUCCESS
+#      define EXIT_SUCCESS 0
 #     endif
 #    endif
 #   endif
@@ -373,8 +541,8 @@ YYID (yyi)
 # endif
 
 # ifdef YYSTACK_ALLOC
-   /* Pacify GCC's `empty if-body' warning.  */
-#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (YYID (0))
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
 #  ifndef YYSTACK_ALLOC_MAXIMUM
     /* The OS might guarantee only one guard page at the bottom of the stack,
        and a page size can be as small as 4096 bytes.  So we cannot safely
@@ -388,88 +556,89 @@ YYID (yyi)
 #  ifndef YYSTACK_ALLOC_MAXIMUM
 #   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
 #  endif
-#  if (defined __cplusplus && ! defined _STDLIB_H \
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
        && ! ((defined YYMALLOC || defined malloc) \
-	     && (defined YYFREE || defined free)))
+             && (defined YYFREE || defined free)))
 #   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
-#   ifndef _STDLIB_H
-#    define _STDLIB_H 1
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
 #   endif
 #  endif
 #  ifndef YYMALLOC
 #   define YYMALLOC malloc
-#   if ! defined malloc && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined malloc && ! defined EXIT_SUCCESS
 void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 #  ifndef YYFREE
 #   define YYFREE free
-#   if ! defined free && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined free && ! defined EXIT_SUCCESS
 void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* !defined yyoverflow */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
-	 || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+         || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
 
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss_alloc;
+  yy_state_t yyss_alloc;
   YYSTYPE yyvs_alloc;
 };
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
       + YYSTACK_GAP_MAXIMUM)
 
-/* Copy COUNT objects from FROM to TO.  The source and destination do
-   not overlap.  */
-# ifndef YYCOPY
-#  if defined __GNUC__ && 1 < __GNUC__
-#   define YYCOPY(To, From, Count) \
-      __builtin_memcpy (To, From, (Count) * sizeof (*(From)))
-#  else
-#   define YYCOPY(To, From, Count)		\
-      do					\
-	{					\
-	  YYSIZE_T yyi;				\
-	  for (yyi = 0; yyi < (Count); yyi++)	\
-	    (To)[yyi] = (From)[yyi];		\
-	}					\
-      while (YYID (0))
-#  endif
-# endif
+# define YYCOPY_NEEDED 1
 
 /* Relocate STACK from its old location to the new one.  The
    local variables YYSIZE and YYSTACKSIZE give the old and new number of
    elements in the stack, and YYPTR gives the new location of the
    stack.  Advance YYPTR to a properly aligned location for the next
    stack.  */
-# define YYSTACK_RELOCATE(Stack_alloc, Stack)				\
-    do									\
-      {									\
-	YYSIZE_T yynewbytes;						\
-	YYCOPY (&yyptr->Stack_alloc, Stack, yysize);			\
-	Stack = &yyptr->Stack_alloc;					\
-	yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-	yyptr += yynewbytes / sizeof (*yyptr);				\
-      }									\
-    while (YYID (0))
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
 
 #endif
 
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
 /* YYFINAL -- State number of the termination state.  */
 #define YYFINAL  21
 /* YYLAST -- Last index in YYTABLE.  */
@@ -481,18 +650,23 @@ union yyalloc
 #define YYNNTS  79
 /* YYNRULES -- Number of rules.  */
 #define YYNRULES  215
-/* YYNRULES -- Number of states.  */
+/* YYNSTATES -- Number of states.  */
 #define YYNSTATES  582
 
-/* YYTRANSLATE(YYLEX) -- Bison symbol number corresponding to YYLEX.  */
-#define YYUNDEFTOK  2
+/* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   337
 
-#define YYTRANSLATE(YYX)						\
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
 
-/* YYTRANSLATE[YYLEX] -- Bison symbol number corresponding to YYLEX.  */
-static const yytype_uint8 yytranslate[] =
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -531,164 +705,50 @@ static const yytype_uint8 yytranslate[] =
 };
 
 #if YYDEBUG
-/* YYPRHS[YYN] -- Index of the first RHS symbol of rule number YYN in
-   YYRHS.  */
-static const yytype_uint16 yyprhs[] =
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
 {
-       0,     0,     3,     6,     8,    10,    13,    15,    17,    20,
-      23,    28,    30,    32,    34,    36,    38,    40,    42,    44,
-      46,    49,    51,    53,    55,    58,    60,    62,    70,    72,
-      74,    76,    86,    88,    92,    95,    97,   101,   103,   105,
-     107,   109,   111,   113,   115,   117,   122,   127,   133,   139,
-     141,   145,   148,   150,   153,   155,   158,   163,   169,   171,
-     174,   177,   180,   183,   186,   189,   192,   195,   198,   201,
-     204,   207,   210,   213,   216,   219,   222,   225,   228,   231,
-     234,   237,   240,   243,   246,   249,   252,   255,   258,   261,
-     264,   267,   270,   273,   276,   280,   284,   290,   296,   302,
-     308,   314,   320,   326,   332,   338,   350,   354,   366,   370,
-     379,   397,   403,   409,   415,   424,   428,   432,   436,   451,
-     457,   461,   473,   479,   485,   500,   521,   536,   548,   551,
-     555,   557,   560,   562,   566,   570,   574,   578,   582,   585,
-     588,   591,   593,   599,   607,   617,   625,   631,   634,   639,
-     640,   642,   644,   648,   649,   651,   653,   657,   658,   660,
-     662,   666,   668,   672,   676,   680,   684,   688,   692,   696,
-     700,   704,   708,   712,   716,   720,   724,   728,   732,   736,
-     740,   744,   748,   752,   756,   760,   764,   767,   770,   773,
-     776,   779,   781,   783,   787,   792,   797,   802,   809,   811,
-     813,   815,   817,   820,   823,   828,   833,   835,   843,   845,
-     847,   849,   859,   861,   865,   867
+       0,   289,   289,   295,   304,   308,   316,   321,   329,   337,
+     342,   350,   354,   361,   368,   373,   380,   385,   390,   398,
+     402,   409,   413,   417,   421,   428,   432,   439,   444,   461,
+     478,   498,   503,   527,   532,   540,   544,   552,   559,   564,
+     569,   574,   579,   584,   589,   597,   604,   609,   616,   624,
+     628,   636,   646,   650,   658,   662,   670,   680,   690,   694,
+     702,   707,   712,   717,   722,   727,   732,   737,   742,   747,
+     752,   757,   762,   767,   772,   777,   782,   787,   792,   797,
+     802,   807,   812,   817,   822,   827,   832,   837,   842,   847,
+     852,   857,   862,   867,   875,   883,   891,   901,   911,   921,
+     931,   941,   951,   961,   971,   981,   995,  1003,  1017,  1025,
+    1037,  1055,  1065,  1075,  1085,  1097,  1105,  1113,  1121,  1137,
+    1147,  1155,  1169,  1179,  1189,  1205,  1225,  1241,  1255,  1260,
+    1268,  1272,  1280,  1285,  1292,  1299,  1306,  1313,  1318,  1323,
+    1328,  1332,  1336,  1342,  1349,  1355,  1361,  1370,  1377,  1388,
+    1391,  1398,  1403,  1412,  1415,  1422,  1427,  1436,  1439,  1446,
+    1451,  1459,  1463,  1468,  1473,  1478,  1483,  1488,  1493,  1498,
+    1503,  1508,  1513,  1518,  1523,  1528,  1533,  1538,  1543,  1548,
+    1553,  1558,  1563,  1568,  1573,  1578,  1586,  1591,  1596,  1601,
+    1606,  1611,  1615,  1619,  1627,  1632,  1639,  1644,  1652,  1656,
+    1660,  1664,  1668,  1673,  1678,  1685,  1690,  1698,  1703,  1720,
+    1737,  1757,  1762,  1786,  1794,  1801
 };
+#endif
 
-/* YYRHS -- A `-1'-separated list of the rules' RHS.  */
-static const yytype_int16 yyrhs[] =
-{
-     106,     0,    -1,   107,   126,    -1,   126,    -1,   108,    -1,
-     108,   107,    -1,   110,    -1,   123,    -1,   122,    48,    -1,
-     109,    82,    -1,   109,    87,   111,    82,    -1,   112,    -1,
-     119,    -1,    48,    -1,   113,    -1,   116,    -1,   115,    -1,
-     114,    -1,    54,    -1,    53,    -1,    84,    53,    -1,    50,
-      -1,    51,    -1,    52,    -1,    84,    50,    -1,   117,    -1,
-     118,    -1,    88,   111,   100,   111,   100,   111,    89,    -1,
-      77,    -1,    79,    -1,    80,    -1,    88,   111,   100,   111,
-     100,   111,   100,   111,    89,    -1,    78,    -1,   101,   120,
-     102,    -1,   101,   102,    -1,   121,    -1,   121,   100,   120,
-      -1,   112,    -1,     3,    -1,     4,    -1,     5,    -1,     6,
-      -1,     7,    -1,     8,    -1,     9,    -1,    48,    97,    98,
-     166,    -1,   109,    97,    98,   166,    -1,    48,    97,   124,
-      98,   166,    -1,   109,    97,   124,    98,   166,    -1,   125,
-      -1,   125,   100,   124,    -1,   122,    48,    -1,   128,    -1,
-     128,   127,    -1,   129,    -1,   129,   127,    -1,    49,   103,
-     130,   104,    -1,    10,    48,   103,   130,   104,    -1,   131,
-      -1,   131,   130,    -1,   132,   166,    -1,   133,   166,    -1,
-     134,   166,    -1,   135,   166,    -1,   136,   166,    -1,   137,
-     166,    -1,   138,   166,    -1,   139,   166,    -1,   140,   166,
-      -1,   141,   166,    -1,   142,   166,    -1,   155,   166,    -1,
-     156,   166,    -1,   157,   166,    -1,   158,   166,    -1,   143,
-     166,    -1,   144,   166,    -1,   145,   166,    -1,   146,   166,
-      -1,   147,   166,    -1,   148,   166,    -1,   149,   166,    -1,
-     150,   166,    -1,   151,   166,    -1,   152,   166,    -1,   159,
-     166,    -1,   153,   166,    -1,   154,   166,    -1,   160,   166,
-      -1,   161,   166,    -1,   162,   166,    -1,   163,   166,    -1,
-     164,   166,    -1,   165,   166,    -1,    14,    97,    98,    -1,
-      15,    97,    98,    -1,    16,    97,     3,    48,    98,    -1,
-      17,    97,     3,    48,    98,    -1,    18,    97,     3,    48,
-      98,    -1,    19,    97,     3,    48,    98,    -1,    20,    97,
-       3,    48,    98,    -1,    21,    97,     3,    48,    98,    -1,
-      22,    97,     7,    48,    98,    -1,    23,    97,     7,    48,
-      98,    -1,    24,    97,     7,    48,    98,    -1,    30,    97,
-       3,    48,   100,     7,    48,   100,     7,    48,    98,    -1,
-      31,    97,    98,    -1,    32,    97,     3,    48,   100,     8,
-      48,   100,     8,    48,    98,    -1,    33,    97,    98,    -1,
-      34,    97,     6,    48,   100,     3,    48,    98,    -1,    35,
-      97,     5,    48,   100,     5,    48,   100,     5,    48,   100,
-       5,    48,   100,     3,    48,    98,    -1,    36,    97,     3,
-      48,    98,    -1,    37,    97,     3,    48,    98,    -1,    38,
-      97,     6,    48,    98,    -1,    39,    97,     6,    48,   100,
-       5,    48,    98,    -1,    40,    97,    98,    -1,    41,    97,
-      98,    -1,    25,    97,    98,    -1,    26,    97,     3,    48,
-     100,     5,    48,   100,     6,    48,   100,     5,    48,    98,
-      -1,    27,    97,     3,    48,    98,    -1,    28,    97,    98,
-      -1,    29,    97,     6,    48,   100,     3,    48,   100,     3,
-      48,    98,    -1,    42,    97,     3,    48,    98,    -1,    43,
-      97,     6,    48,    98,    -1,    44,    97,     3,    48,   100,
-       3,    48,   100,     5,    48,   100,     6,    48,    98,    -1,
-      45,    97,     3,    48,   100,     6,    48,   100,     6,    48,
-     100,     5,    48,   100,     3,    48,   100,     5,    48,    98,
-      -1,    46,    97,     6,    48,   100,     3,    48,   100,     9,
-      48,   100,     5,    48,    98,    -1,    47,    97,     6,    48,
-     100,     5,    48,   100,     5,    48,    98,    -1,   103,   104,
-      -1,   103,   167,   104,    -1,   168,    -1,   167,   168,    -1,
-      82,    -1,    10,    48,    82,    -1,    10,    49,    82,    -1,
-      12,    48,    82,    -1,    83,    48,    82,    -1,    13,   176,
-      82,    -1,    13,    82,    -1,   176,    82,    -1,   169,    82,
-      -1,   166,    -1,    70,    97,   176,    98,   168,    -1,    70,
-      97,   176,    98,   168,    71,   168,    -1,    72,    97,   170,
-      82,   176,    82,   170,    98,   168,    -1,    73,   168,    74,
-      97,   176,    98,    82,    -1,    74,    97,   176,    98,   168,
-      -1,   122,    48,    -1,   122,    48,    87,   176,    -1,    -1,
-     171,    -1,   176,    -1,   176,   100,   171,    -1,    -1,   173,
-      -1,   176,    -1,   176,   100,   173,    -1,    -1,   175,    -1,
-     176,    -1,   176,   100,   175,    -1,   177,    -1,   183,    87,
-     176,    -1,   183,    57,   176,    -1,   183,    58,   176,    -1,
-     183,    59,   176,    -1,   183,    60,   176,    -1,   183,    61,
-     176,    -1,   176,    62,   176,    -1,   176,    63,   176,    -1,
-     176,    65,   176,    -1,   176,    64,   176,    -1,   176,    88,
-     176,    -1,   176,    89,   176,    -1,   176,    90,   176,    -1,
-     176,    84,   176,    -1,   176,    91,   176,    -1,   176,    92,
-     176,    -1,   176,    93,   176,    -1,   176,    94,   176,    -1,
-     176,    95,   176,    -1,   176,    96,   176,    -1,   176,    66,
-     176,    -1,   176,    67,   176,    -1,   176,    68,   176,    -1,
-     176,    69,   176,    -1,    84,   176,    -1,    85,   176,    -1,
-      86,   176,    -1,    55,   183,    -1,    56,   183,    -1,   178,
-      -1,   179,    -1,    97,   176,    98,    -1,    97,   122,    98,
-     183,    -1,    97,   122,    98,   113,    -1,    97,   122,    98,
-     179,    -1,    97,   122,    98,    97,   176,    98,    -1,   180,
-      -1,   181,    -1,   182,    -1,   183,    -1,   183,    55,    -1,
-     183,    56,    -1,    48,    97,   172,    98,    -1,    75,    97,
-     176,    98,    -1,   113,    -1,    88,   176,   100,   176,   100,
-     176,    89,    -1,    77,    -1,    79,    -1,    80,    -1,    88,
-     176,   100,   176,   100,   176,   100,   176,    89,    -1,    78,
-      -1,   101,   174,   102,    -1,    48,    -1,    48,    76,    48,
-      -1
-};
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
 
-/* YYRLINE[YYN] -- source line where rule number YYN was defined.  */
-static const yytype_uint16 yyrline[] =
-{
-       0,   284,   284,   290,   299,   303,   311,   316,   324,   332,
-     337,   345,   349,   356,   363,   368,   375,   380,   385,   393,
-     397,   404,   408,   412,   416,   423,   427,   434,   439,   456,
-     473,   493,   498,   522,   527,   535,   539,   547,   554,   559,
-     564,   569,   574,   579,   584,   592,   599,   604,   611,   619,
-     623,   631,   641,   645,   653,   657,   665,   675,   685,   689,
-     697,   702,   707,   712,   717,   722,   727,   732,   737,   742,
-     747,   752,   757,   762,   767,   772,   777,   782,   787,   792,
-     797,   802,   807,   812,   817,   822,   827,   832,   837,   842,
-     847,   852,   857,   862,   870,   878,   886,   896,   906,   916,
-     926,   936,   946,   956,   966,   976,   990,   998,  1012,  1020,
-    1032,  1050,  1060,  1070,  1080,  1092,  1100,  1108,  1116,  1132,
-    1142,  1150,  1164,  1174,  1184,  1200,  1220,  1236,  1250,  1255,
-    1263,  1267,  1275,  1280,  1287,  1294,  1301,  1308,  1313,  1318,
-    1323,  1327,  1331,  1337,  1344,  1350,  1356,  1365,  1372,  1383,
-    1386,  1393,  1398,  1407,  1410,  1417,  1422,  1431,  1434,  1441,
-    1446,  1454,  1458,  1463,  1468,  1473,  1478,  1483,  1488,  1493,
-    1498,  1503,  1508,  1513,  1518,  1523,  1528,  1533,  1538,  1543,
-    1548,  1553,  1558,  1563,  1568,  1573,  1581,  1586,  1591,  1596,
-    1601,  1606,  1610,  1614,  1622,  1627,  1634,  1639,  1647,  1651,
-    1655,  1659,  1663,  1668,  1673,  1680,  1685,  1693,  1698,  1715,
-    1732,  1752,  1757,  1781,  1789,  1796
-};
-#endif
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
 
-#if YYDEBUG || YYERROR_VERBOSE || YYTOKEN_TABLE
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "INTEGER", "FLOAT_TYPE", "STRING",
-  "LLKEY", "VECTOR", "QUATERNION", "LIST", "STATE", "EVENT", "JUMP",
-  "RETURN", "STATE_ENTRY", "STATE_EXIT", "TOUCH_START", "TOUCH",
-  "TOUCH_END", "COLLISION_START", "COLLISION", "COLLISION_END",
+  "\"end of file\"", "error", "\"invalid token\"", "INTEGER",
+  "FLOAT_TYPE", "STRING", "LLKEY", "VECTOR", "QUATERNION", "LIST", "STATE",
+  "EVENT", "JUMP", "RETURN", "STATE_ENTRY", "STATE_EXIT", "TOUCH_START",
+  "TOUCH", "TOUCH_END", "COLLISION_START", "COLLISION", "COLLISION_END",
   "LAND_COLLISION_START", "LAND_COLLISION", "LAND_COLLISION_END", "TIMER",
   "CHAT", "SENSOR", "NO_SENSOR", "CONTROL", "AT_TARGET", "NOT_AT_TARGET",
   "AT_ROT_TARGET", "NOT_AT_ROT_TARGET", "MONEY", "EMAIL",
@@ -723,165 +783,28 @@ static const char *const yytname[] =
   "listexpressionlist", "nextlistexpressionlist", "expression",
   "unaryexpression", "typecast", "unarypostfixexpression",
   "vector_initializer", "quaternion_initializer", "list_initializer",
-  "lvalue", 0
+  "lvalue", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[YYLEX-NUM] -- Internal token number corresponding to
-   token YYLEX-NUM.  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
-     285,   286,   287,   288,   289,   290,   291,   292,   293,   294,
-     295,   296,   297,   298,   299,   300,   301,   302,   303,   304,
-     305,   306,   307,   308,   309,   310,   311,   312,   313,   314,
-     315,   316,   317,   318,   319,   320,   321,   322,   323,   324,
-     325,   326,   327,   328,   329,   330,   331,   332,   333,   334,
-     335,   336,    59,    64,    45,    33,   126,    61,    60,    62,
-      43,    42,    47,    37,    38,   124,    94,    40,    41,   337,
-      44,    91,    93,   123,   125
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-/* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
-{
-       0,   105,   106,   106,   107,   107,   108,   108,   109,   110,
-     110,   111,   111,   112,   112,   112,   113,   113,   113,   114,
-     114,   115,   115,   115,   115,   116,   116,   117,   117,   117,
-     117,   118,   118,   119,   119,   120,   120,   121,   122,   122,
-     122,   122,   122,   122,   122,   123,   123,   123,   123,   124,
-     124,   125,   126,   126,   127,   127,   128,   129,   130,   130,
-     131,   131,   131,   131,   131,   131,   131,   131,   131,   131,
-     131,   131,   131,   131,   131,   131,   131,   131,   131,   131,
-     131,   131,   131,   131,   131,   131,   131,   131,   131,   131,
-     131,   131,   131,   131,   132,   133,   134,   135,   136,   137,
-     138,   139,   140,   141,   142,   143,   144,   145,   146,   147,
-     148,   149,   150,   151,   152,   153,   154,   155,   156,   157,
-     158,   159,   160,   161,   162,   163,   164,   165,   166,   166,
-     167,   167,   168,   168,   168,   168,   168,   168,   168,   168,
-     168,   168,   168,   168,   168,   168,   168,   169,   169,   170,
-     170,   171,   171,   172,   172,   173,   173,   174,   174,   175,
-     175,   176,   176,   176,   176,   176,   176,   176,   176,   176,
-     176,   176,   176,   176,   176,   176,   176,   176,   176,   176,
-     176,   176,   176,   176,   176,   176,   177,   177,   177,   177,
-     177,   177,   177,   177,   178,   178,   178,   178,   179,   179,
-     179,   179,   179,   179,   179,   179,   179,   180,   180,   180,
-     180,   181,   181,   182,   183,   183
-};
+#define YYPACT_NINF (-218)
 
-/* YYR2[YYN] -- Number of symbols composing right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
-{
-       0,     2,     2,     1,     1,     2,     1,     1,     2,     2,
-       4,     1,     1,     1,     1,     1,     1,     1,     1,     1,
-       2,     1,     1,     1,     2,     1,     1,     7,     1,     1,
-       1,     9,     1,     3,     2,     1,     3,     1,     1,     1,
-       1,     1,     1,     1,     1,     4,     4,     5,     5,     1,
-       3,     2,     1,     2,     1,     2,     4,     5,     1,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     3,     3,     5,     5,     5,     5,
-       5,     5,     5,     5,     5,    11,     3,    11,     3,     8,
-      17,     5,     5,     5,     8,     3,     3,     3,    14,     5,
-       3,    11,     5,     5,    14,    20,    14,    11,     2,     3,
-       1,     2,     1,     3,     3,     3,     3,     3,     2,     2,
-       2,     1,     5,     7,     9,     7,     5,     2,     4,     0,
-       1,     1,     3,     0,     1,     1,     3,     0,     1,     1,
-       3,     1,     3,     3,     3,     3,     3,     3,     3,     3,
-       3,     3,     3,     3,     3,     3,     3,     3,     3,     3,
-       3,     3,     3,     3,     3,     3,     2,     2,     2,     2,
-       2,     1,     1,     3,     4,     4,     4,     6,     1,     1,
-       1,     1,     2,     2,     4,     4,     1,     7,     1,     1,
-       1,     9,     1,     3,     1,     3
-};
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
 
-/* YYDEFACT[STATE-NAME] -- Default rule to reduce with in state
-   STATE-NUM when YYTABLE doesn't specify something else to do.  Zero
-   means the default is an error.  */
-static const yytype_uint8 yydefact[] =
-{
-       0,    38,    39,    40,    41,    42,    43,    44,     0,     0,
-       0,     0,     4,     0,     6,     0,     7,     3,    52,     0,
-       0,     1,     2,     5,     9,     0,     0,     8,     0,    53,
-      54,     0,     0,     0,    49,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-      58,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,    13,    21,    22,    23,    19,
-      18,    28,    32,    29,    30,     0,     0,     0,     0,    11,
-      14,    17,    16,    15,    25,    26,    12,     0,     0,     0,
-      55,     0,    45,    51,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-      56,    59,    60,    61,    62,    63,    64,    65,    66,    67,
-      68,    69,    70,    75,    76,    77,    78,    79,    80,    81,
-      82,    83,    84,    86,    87,    71,    72,    73,    74,    85,
-      88,    89,    90,    91,    92,    93,    24,    20,     0,    34,
-      37,     0,    35,    10,    46,     0,     0,     0,     0,     0,
-     214,     0,     0,     0,     0,     0,     0,     0,   208,   212,
-     209,   210,   132,     0,     0,     0,     0,     0,     0,   157,
-     128,   206,     0,   141,     0,   130,     0,     0,   161,   191,
-     192,   198,   199,   200,   201,    47,    50,    94,    95,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,   117,     0,
-       0,   120,     0,     0,   106,     0,   108,     0,     0,     0,
-       0,     0,     0,   115,   116,     0,     0,     0,     0,     0,
-       0,     0,    33,     0,    48,     0,     0,     0,     0,   138,
-       0,     0,   153,   214,   189,   190,     0,   149,     0,     0,
-       0,     0,    21,    19,   186,   187,   188,     0,     0,     0,
-       0,   158,   159,   147,   129,   131,   140,     0,     0,     0,
-       0,     0,     0,     0,     0,   139,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,   202,   203,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,    36,    57,   133,   134,   135,   137,   215,     0,   154,
-     155,     0,     0,   150,   151,     0,     0,     0,   136,     0,
-       0,   193,   213,     0,     0,   168,   169,   171,   170,   182,
-     183,   184,   185,   175,   172,   173,   174,   176,   177,   178,
-     179,   180,   181,   163,   164,   165,   166,   167,   162,    96,
-      97,    98,    99,   100,   101,   102,   103,   104,     0,   119,
-       0,     0,     0,     0,     0,   111,   112,   113,     0,   122,
-     123,     0,     0,     0,     0,     0,   204,     0,     0,     0,
-       0,     0,     0,   205,     0,     0,   195,   196,   194,   160,
-     148,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,   156,   142,     0,   152,     0,   146,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,    27,     0,     0,   149,     0,     0,   197,     0,
-       0,     0,     0,   109,     0,   114,     0,     0,     0,     0,
-       0,   143,     0,   145,   207,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,    31,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,   144,   211,     0,
-     121,   105,   107,     0,     0,     0,     0,   127,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,   118,     0,
-     124,     0,   126,     0,     0,     0,     0,   110,     0,     0,
-       0,   125
-};
+#define YYTABLE_NINF (-1)
 
-/* YYDEFGOTO[NTERM-NUM].  */
-static const yytype_int16 yydefgoto[] =
-{
-      -1,    10,    11,    12,    13,    14,   118,   119,   241,   121,
-     122,   123,   124,   125,   126,   211,   212,   242,    16,    33,
-      34,    17,    29,    18,    30,    69,    70,    71,    72,    73,
-      74,    75,    76,    77,    78,    79,    80,    81,    82,    83,
-      84,    85,    86,    87,    88,    89,    90,    91,    92,    93,
-      94,    95,    96,    97,    98,    99,   100,   101,   102,   103,
-     104,   243,   244,   245,   246,   392,   393,   388,   389,   320,
-     321,   247,   248,   249,   250,   251,   252,   253,   254
-};
+#define yytable_value_is_error(Yyn) \
+  0
 
 /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
    STATE-NUM.  */
-#define YYPACT_NINF -218
 static const yytype_int16 yypact[] =
 {
      104,  -218,  -218,  -218,  -218,  -218,  -218,  -218,   -92,   -91,
@@ -945,6 +868,72 @@ static const yytype_int16 yypact[] =
      731,  -218
 };
 
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_uint8 yydefact[] =
+{
+       0,    38,    39,    40,    41,    42,    43,    44,     0,     0,
+       0,     0,     4,     0,     6,     0,     7,     3,    52,     0,
+       0,     1,     2,     5,     9,     0,     0,     8,     0,    53,
+      54,     0,     0,     0,    49,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+      58,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,    13,    21,    22,    23,    19,
+      18,    28,    32,    29,    30,     0,     0,     0,     0,    11,
+      14,    17,    16,    15,    25,    26,    12,     0,     0,     0,
+      55,     0,    45,    51,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+      56,    59,    60,    61,    62,    63,    64,    65,    66,    67,
+      68,    69,    70,    75,    76,    77,    78,    79,    80,    81,
+      82,    83,    84,    86,    87,    71,    72,    73,    74,    85,
+      88,    89,    90,    91,    92,    93,    24,    20,     0,    34,
+      37,     0,    35,    10,    46,     0,     0,     0,     0,     0,
+     214,     0,     0,     0,     0,     0,     0,     0,   208,   212,
+     209,   210,   132,     0,     0,     0,     0,     0,     0,   157,
+     128,   206,     0,   141,     0,   130,     0,     0,   161,   191,
+     192,   198,   199,   200,   201,    47,    50,    94,    95,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,   117,     0,
+       0,   120,     0,     0,   106,     0,   108,     0,     0,     0,
+       0,     0,     0,   115,   116,     0,     0,     0,     0,     0,
+       0,     0,    33,     0,    48,     0,     0,     0,     0,   138,
+       0,     0,   153,   214,   189,   190,     0,   149,     0,     0,
+       0,     0,    21,    19,   186,   187,   188,     0,     0,     0,
+       0,   158,   159,   147,   129,   131,   140,     0,     0,     0,
+       0,     0,     0,     0,     0,   139,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,   202,   203,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,    36,    57,   133,   134,   135,   137,   215,     0,   154,
+     155,     0,     0,   150,   151,     0,     0,     0,   136,     0,
+       0,   193,   213,     0,     0,   168,   169,   171,   170,   182,
+     183,   184,   185,   175,   172,   173,   174,   176,   177,   178,
+     179,   180,   181,   163,   164,   165,   166,   167,   162,    96,
+      97,    98,    99,   100,   101,   102,   103,   104,     0,   119,
+       0,     0,     0,     0,     0,   111,   112,   113,     0,   122,
+     123,     0,     0,     0,     0,     0,   204,     0,     0,     0,
+       0,     0,     0,   205,     0,     0,   195,   196,   194,   160,
+     148,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,   156,   142,     0,   152,     0,   146,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,    27,     0,     0,   149,     0,     0,   197,     0,
+       0,     0,     0,   109,     0,   114,     0,     0,     0,     0,
+       0,   143,     0,   145,   207,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,    31,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,   144,   211,     0,
+     121,   105,   107,     0,     0,     0,     0,   127,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,   118,     0,
+     124,     0,   126,     0,     0,     0,     0,   110,     0,     0,
+       0,   125
+};
+
 /* YYPGOTO[NTERM-NUM].  */
 static const yytype_int16 yypgoto[] =
 {
@@ -958,12 +947,23 @@ static const yytype_int16 yypgoto[] =
      441,  -213,  -218,  -218,   443,  -218,  -218,  -218,  -212
 };
 
-/* YYTABLE[YYPACT[STATE-NUM]].  What to do in state STATE-NUM.  If
-   positive, shift that token.  If negative, reduce the rule which
-   number is the opposite.  If zero, do what YYDEFACT says.
-   If YYTABLE_NINF, syntax error.  */
-#define YYTABLE_NINF -1
-static const yytype_uint16 yytable[] =
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_int16 yydefgoto[] =
+{
+       0,    10,    11,    12,    13,    14,   118,   119,   241,   121,
+     122,   123,   124,   125,   126,   211,   212,   242,    16,    33,
+      34,    17,    29,    18,    30,    69,    70,    71,    72,    73,
+      74,    75,    76,    77,    78,    79,    80,    81,    82,    83,
+      84,    85,    86,    87,    88,    89,    90,    91,    92,    93,
+      94,    95,    96,    97,    98,    99,   100,   101,   102,   103,
+     104,   243,   244,   245,   246,   392,   393,   388,   389,   320,
+     321,   247,   248,   249,   250,   251,   252,   253,   254
+};
+
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int16 yytable[] =
 {
      120,   208,   171,   132,   210,    19,   300,   502,   308,   304,
      305,   301,    20,   128,   333,   334,    15,   206,   503,    21,
@@ -1229,8 +1229,8 @@ static const yytype_int16 yycheck[] =
       89,    90,    91,    92,    93
 };
 
-/* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-   symbol of state STATE-NUM.  */
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
 static const yytype_uint8 yystos[] =
 {
        0,     3,     4,     5,     6,     7,     8,     9,    48,    49,
@@ -1294,95 +1294,95 @@ static const yytype_uint8 yystos[] =
       48,    98
 };
 
-#define yyerrok		(yyerrstatus = 0)
-#define yyclearin	(yychar = YYEMPTY)
-#define YYEMPTY		(-2)
-#define YYEOF		0
-
-#define YYACCEPT	goto yyacceptlab
-#define YYABORT		goto yyabortlab
-#define YYERROR		goto yyerrorlab
-
-
-/* Like YYERROR except do call yyerror.  This remains here temporarily
-   to ease the transition to the new meaning of YYERROR, for GCC.
-   Once GCC version 2 has supplanted version 1, this can go.  */
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_uint8 yyr1[] =
+{
+       0,   105,   106,   106,   107,   107,   108,   108,   109,   110,
+     110,   111,   111,   112,   112,   112,   113,   113,   113,   114,
+     114,   115,   115,   115,   115,   116,   116,   117,   117,   117,
+     117,   118,   118,   119,   119,   120,   120,   121,   122,   122,
+     122,   122,   122,   122,   122,   123,   123,   123,   123,   124,
+     124,   125,   126,   126,   127,   127,   128,   129,   130,   130,
+     131,   131,   131,   131,   131,   131,   131,   131,   131,   131,
+     131,   131,   131,   131,   131,   131,   131,   131,   131,   131,
+     131,   131,   131,   131,   131,   131,   131,   131,   131,   131,
+     131,   131,   131,   131,   132,   133,   134,   135,   136,   137,
+     138,   139,   140,   141,   142,   143,   144,   145,   146,   147,
+     148,   149,   150,   151,   152,   153,   154,   155,   156,   157,
+     158,   159,   160,   161,   162,   163,   164,   165,   166,   166,
+     167,   167,   168,   168,   168,   168,   168,   168,   168,   168,
+     168,   168,   168,   168,   168,   168,   168,   169,   169,   170,
+     170,   171,   171,   172,   172,   173,   173,   174,   174,   175,
+     175,   176,   176,   176,   176,   176,   176,   176,   176,   176,
+     176,   176,   176,   176,   176,   176,   176,   176,   176,   176,
+     176,   176,   176,   176,   176,   176,   177,   177,   177,   177,
+     177,   177,   177,   177,   178,   178,   178,   178,   179,   179,
+     179,   179,   179,   179,   179,   179,   179,   180,   180,   180,
+     180,   181,   181,   182,   183,   183
+};
 
-#define YYFAIL		goto yyerrlab
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     2,     1,     1,     2,     1,     1,     2,     2,
+       4,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       2,     1,     1,     1,     2,     1,     1,     7,     1,     1,
+       1,     9,     1,     3,     2,     1,     3,     1,     1,     1,
+       1,     1,     1,     1,     1,     4,     4,     5,     5,     1,
+       3,     2,     1,     2,     1,     2,     4,     5,     1,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     3,     3,     5,     5,     5,     5,
+       5,     5,     5,     5,     5,    11,     3,    11,     3,     8,
+      17,     5,     5,     5,     8,     3,     3,     3,    14,     5,
+       3,    11,     5,     5,    14,    20,    14,    11,     2,     3,
+       1,     2,     1,     3,     3,     3,     3,     3,     2,     2,
+       2,     1,     5,     7,     9,     7,     5,     2,     4,     0,
+       1,     1,     3,     0,     1,     1,     3,     0,     1,     1,
+       3,     1,     3,     3,     3,     3,     3,     3,     3,     3,
+       3,     3,     3,     3,     3,     3,     3,     3,     3,     3,
+       3,     3,     3,     3,     3,     3,     2,     2,     2,     2,
+       2,     1,     1,     3,     4,     4,     4,     6,     1,     1,
+       1,     1,     2,     2,     4,     4,     1,     7,     1,     1,
+       1,     9,     1,     3,     1,     3
+};
 
-#define YYRECOVERING()  (!!yyerrstatus)
 
-#define YYBACKUP(Token, Value)					\
-do								\
-  if (yychar == YYEMPTY && yylen == 1)				\
-    {								\
-      yychar = (Token);						\
-      yylval = (Value);						\
-      yytoken = YYTRANSLATE (yychar);				\
-      YYPOPSTACK (1);						\
-      goto yybackup;						\
-    }								\
-  else								\
-    {								\
-      yyerror (YY_("syntax error: cannot back up")); \
-      YYERROR;							\
-    }								\
-while (YYID (0))
-
-
-#define YYTERROR	1
-#define YYERRCODE	256
-
-
-/* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
-   If N is 0, then set CURRENT to the empty location which ends
-   the previous symbol: RHS[0] (always defined).  */
-
-#define YYRHSLOC(Rhs, K) ((Rhs)[K])
-#ifndef YYLLOC_DEFAULT
-# define YYLLOC_DEFAULT(Current, Rhs, N)				\
-    do									\
-      if (YYID (N))                                                    \
-	{								\
-	  (Current).first_line   = YYRHSLOC (Rhs, 1).first_line;	\
-	  (Current).first_column = YYRHSLOC (Rhs, 1).first_column;	\
-	  (Current).last_line    = YYRHSLOC (Rhs, N).last_line;		\
-	  (Current).last_column  = YYRHSLOC (Rhs, N).last_column;	\
-	}								\
-      else								\
-	{								\
-	  (Current).first_line   = (Current).last_line   =		\
-	    YYRHSLOC (Rhs, 0).last_line;				\
-	  (Current).first_column = (Current).last_column =		\
-	    YYRHSLOC (Rhs, 0).last_column;				\
-	}								\
-    while (YYID (0))
-#endif
+enum { YYENOMEM = -2 };
 
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
 
-/* YY_LOCATION_PRINT -- Print the location on the stream.
-   This macro was not mandated originally: define only if we know
-   we won't break user code: when these are the locations we know.  */
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
-#ifndef YY_LOCATION_PRINT
-# if YYLTYPE_IS_TRIVIAL
-#  define YY_LOCATION_PRINT(File, Loc)			\
-     fprintf (File, "%d.%d-%d.%d",			\
-	      (Loc).first_line, (Loc).first_column,	\
-	      (Loc).last_line,  (Loc).last_column)
-# else
-#  define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-# endif
-#endif
 
+#define YYRECOVERING()  (!!yyerrstatus)
 
-/* YYLEX -- calling `yylex' with the right arguments.  */
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
-#ifdef YYLEX_PARAM
-# define YYLEX yylex (YYLEX_PARAM)
-#else
-# define YYLEX yylex ()
-#endif
 
 /* Enable debugging if requested.  */
 #if YYDEBUG
@@ -1392,80 +1392,58 @@ while (YYID (0))
 #  define YYFPRINTF fprintf
 # endif
 
-# define YYDPRINTF(Args)			\
-do {						\
-  if (yydebug)					\
-    YYFPRINTF Args;				\
-} while (YYID (0))
-
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)			  \
-do {									  \
-  if (yydebug)								  \
-    {									  \
-      YYFPRINTF (stderr, "%s ", Title);					  \
-      yy_symbol_print (stderr,						  \
-		  Type, Value); \
-      YYFPRINTF (stderr, "\n");						  \
-    }									  \
-} while (YYID (0))
-
-
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
-
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
-#else
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
 static void
-yy_symbol_value_print (yyoutput, yytype, yyvaluep)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-#endif
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
 {
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# else
-  YYUSE (yyoutput);
-# endif
-  switch (yytype)
-    {
-      default:
-	break;
-    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
-#else
-static void
-yy_symbol_print (yyoutput, yytype, yyvaluep)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-#endif
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
 {
-  if (yytype < YYNTOKENS)
-    YYFPRINTF (yyoutput, "token %s (", yytname[yytype]);
-  else
-    YYFPRINTF (yyoutput, "nterm %s (", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep);
-  YYFPRINTF (yyoutput, ")");
+  yy_symbol_value_print (yyo, yykind, yyvaluep);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -1473,16 +1451,8 @@ yy_symbol_print (yyoutput, yytype, yyvaluep)
 | TOP (included).                                                   |
 `------------------------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yy_stack_print (yytype_int16 *yybottom, yytype_int16 *yytop)
-#else
-static void
-yy_stack_print (yybottom, yytop)
-    yytype_int16 *yybottom;
-    yytype_int16 *yytop;
-#endif
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
   for (; yybottom <= yytop; yybottom++)
@@ -1493,63 +1463,56 @@ yy_stack_print (yybottom, yytop)
   YYFPRINTF (stderr, "\n");
 }
 
-# define YY_STACK_PRINT(Bottom, Top)				\
-do {								\
-  if (yydebug)							\
-    yy_stack_print ((Bottom), (Top));				\
-} while (YYID (0))
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
 
 
 /*------------------------------------------------.
 | Report that the YYRULE is going to be reduced.  |
 `------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_reduce_print (YYSTYPE *yyvsp, int yyrule)
-#else
 static void
-yy_reduce_print (yyvsp, yyrule)
-    YYSTYPE *yyvsp;
-    int yyrule;
-#endif
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule)
 {
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  unsigned long int yylno = yyrline[yyrule];
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
-	     yyrule - 1, yylno);
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
-      yy_symbol_print (stderr, yyrhs[yyprhs[yyrule] + yyi],
-		       &(yyvsp[(yyi + 1) - (yynrhs)])
-		       		       );
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)]);
       YYFPRINTF (stderr, "\n");
     }
 }
 
-# define YY_REDUCE_PRINT(Rule)		\
-do {					\
-  if (yydebug)				\
-    yy_reduce_print (yyvsp, Rule); \
-} while (YYID (0))
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, Rule); \
+} while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
 
 
 /* YYINITDEPTH -- initial size of the parser's stacks.  */
-#ifndef	YYINITDEPTH
+#ifndef YYINITDEPTH
 # define YYINITDEPTH 200
 #endif
 
@@ -1564,342 +1527,106 @@ int yydebug;
 # define YYMAXDEPTH 10000
 #endif
 
-
-
-#if YYERROR_VERBOSE
-
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
-/* Return the length of YYSTR.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static YYSIZE_T
-yystrlen (const char *yystr)
-#else
-static YYSIZE_T
-yystrlen (yystr)
-    const char *yystr;
-#endif
-{
-  YYSIZE_T yylen;
-  for (yylen = 0; yystr[yylen]; yylen++)
-    continue;
-  return yylen;
-}
-#  endif
-# endif
-
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
-/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
-   YYDEST.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static char *
-yystpcpy (char *yydest, const char *yysrc)
-#else
-static char *
-yystpcpy (yydest, yysrc)
-    char *yydest;
-    const char *yysrc;
-#endif
-{
-  char *yyd = yydest;
-  const char *yys = yysrc;
-
-  while ((*yyd++ = *yys++) != '\0')
-    continue;
-
-  return yyd - 1;
-}
-#  endif
-# endif
-
-# ifndef yytnamerr
-/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
-   quotes and backslashes, so that it's suitable for yyerror.  The
-   heuristic is that double-quoting is unnecessary unless the string
-   contains an apostrophe, a comma, or backslash (other than
-   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
-   null, do not copy; instead, return the length of what the result
-   would have been.  */
-static YYSIZE_T
-yytnamerr (char *yyres, const char *yystr)
-{
-  if (*yystr == '"')
-    {
-      YYSIZE_T yyn = 0;
-      char const *yyp = yystr;
-
-      for (;;)
-	switch (*++yyp)
-	  {
-	  case '\'':
-	  case ',':
-	    goto do_not_strip_quotes;
-
-	  case '\\':
-	    if (*++yyp != '\\')
-	      goto do_not_strip_quotes;
-	    /* Fall through.  */
-	  default:
-	    if (yyres)
-	      yyres[yyn] = *yyp;
-	    yyn++;
-	    break;
-
-	  case '"':
-	    if (yyres)
-	      yyres[yyn] = '\0';
-	    return yyn;
-	  }
-    do_not_strip_quotes: ;
-    }
 
-  if (! yyres)
-    return yystrlen (yystr);
 
-  return yystpcpy (yyres, yystr) - yyres;
-}
-# endif
 
-/* Copy into YYRESULT an error message about the unexpected token
-   YYCHAR while in state YYSTATE.  Return the number of bytes copied,
-   including the terminating null byte.  If YYRESULT is null, do not
-   copy anything; just return the number of bytes that would be
-   copied.  As a special case, return 0 if an ordinary "syntax error"
-   message will do.  Return YYSIZE_MAXIMUM if overflow occurs during
-   size calculation.  */
-static YYSIZE_T
-yysyntax_error (char *yyresult, int yystate, int yychar)
-{
-  int yyn = yypact[yystate];
 
-  if (! (YYPACT_NINF < yyn && yyn <= YYLAST))
-    return 0;
-  else
-    {
-      int yytype = YYTRANSLATE (yychar);
-      YYSIZE_T yysize0 = yytnamerr (0, yytname[yytype]);
-      YYSIZE_T yysize = yysize0;
-      YYSIZE_T yysize1;
-      int yysize_overflow = 0;
-      enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-      char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-      int yyx;
-
-# if 0
-      /* This is so xgettext sees the translatable formats that are
-	 constructed on the fly.  */
-      YY_("syntax error, unexpected %s");
-      YY_("syntax error, unexpected %s, expecting %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s or %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s");
-# endif
-      char *yyfmt;
-      char const *yyf;
-      static char const yyunexpected[] = "syntax error, unexpected %s";
-      static char const yyexpecting[] = ", expecting %s";
-      static char const yyor[] = " or %s";
-      char yyformat[sizeof yyunexpected
-		    + sizeof yyexpecting - 1
-		    + ((YYERROR_VERBOSE_ARGS_MAXIMUM - 2)
-		       * (sizeof yyor - 1))];
-      char const *yyprefix = yyexpecting;
-
-      /* Start YYX at -YYN if negative to avoid negative indexes in
-	 YYCHECK.  */
-      int yyxbegin = yyn < 0 ? -yyn : 0;
-
-      /* Stay within bounds of both yycheck and yytname.  */
-      int yychecklim = YYLAST - yyn + 1;
-      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-      int yycount = 1;
-
-      yyarg[0] = yytname[yytype];
-      yyfmt = yystpcpy (yyformat, yyunexpected);
-
-      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-	if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR)
-	  {
-	    if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-	      {
-		yycount = 1;
-		yysize = yysize0;
-		yyformat[sizeof yyunexpected - 1] = '\0';
-		break;
-	      }
-	    yyarg[yycount++] = yytname[yyx];
-	    yysize1 = yysize + yytnamerr (0, yytname[yyx]);
-	    yysize_overflow |= (yysize1 < yysize);
-	    yysize = yysize1;
-	    yyfmt = yystpcpy (yyfmt, yyprefix);
-	    yyprefix = yyor;
-	  }
-
-      yyf = YY_(yyformat);
-      yysize1 = yysize + yystrlen (yyf);
-      yysize_overflow |= (yysize1 < yysize);
-      yysize = yysize1;
-
-      if (yysize_overflow)
-	return YYSIZE_MAXIMUM;
-
-      if (yyresult)
-	{
-	  /* Avoid sprintf, as that infringes on the user's name space.
-	     Don't have undefined behavior even if the translation
-	     produced a string with the wrong number of "%s"s.  */
-	  char *yyp = yyresult;
-	  int yyi = 0;
-	  while ((*yyp = *yyf) != '\0')
-	    {
-	      if (*yyp == '%' && yyf[1] == 's' && yyi < yycount)
-		{
-		  yyp += yytnamerr (yyp, yyarg[yyi++]);
-		  yyf += 2;
-		}
-	      else
-		{
-		  yyp++;
-		  yyf++;
-		}
-	    }
-	}
-      return yysize;
-    }
-}
-#endif /* YYERROR_VERBOSE */
-
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep)
-#else
 static void
-yydestruct (yymsg, yytype, yyvaluep)
-    const char *yymsg;
-    int yytype;
-    YYSTYPE *yyvaluep;
-#endif
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep)
 {
-  YYUSE (yyvaluep);
-
+  YY_USE (yyvaluep);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
-  switch (yytype)
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  switch (yykind)
     {
+    case YYSYMBOL_IDENTIFIER: /* IDENTIFIER  */
+#line 120 "indra.y"
+            { delete [] ((*yyvaluep).sval); }
+#line 1555 "indra_generated.y.cpp"
+        break;
+
+    case YYSYMBOL_STATE_DEFAULT: /* STATE_DEFAULT  */
+#line 120 "indra.y"
+            { delete [] ((*yyvaluep).sval); }
+#line 1561 "indra_generated.y.cpp"
+        break;
+
+    case YYSYMBOL_STRING_CONSTANT: /* STRING_CONSTANT  */
+#line 120 "indra.y"
+            { delete [] ((*yyvaluep).sval); }
+#line 1567 "indra_generated.y.cpp"
+        break;
 
       default:
-	break;
+        break;
     }
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
-/* Prevent warnings from -Wmissing-prototypes.  */
-#ifdef YYPARSE_PARAM
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void *YYPARSE_PARAM);
-#else
-int yyparse ();
-#endif
-#else /* ! YYPARSE_PARAM */
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void);
-#else
-int yyparse ();
-#endif
-#endif /* ! YYPARSE_PARAM */
-
-
-/* The lookahead symbol.  */
-int yychar;
 
-/* The semantic value of the lookahead symbol.  */
-YYSTYPE yylval;
 
-/* Number of syntax errors so far.  */
-int yynerrs;
 
 
 
-/*-------------------------.
-| yyparse or yypush_parse.  |
-`-------------------------*/
+/*----------.
+| yyparse.  |
+`----------*/
 
-#ifdef YYPARSE_PARAM
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-int
-yyparse (void *YYPARSE_PARAM)
-#else
-int
-yyparse (YYPARSE_PARAM)
-    void *YYPARSE_PARAM;
-#endif
-#else /* ! YYPARSE_PARAM */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 int
 yyparse (void)
-#else
-int
-yyparse ()
-
-#endif
-#endif
 {
+/* Lookahead token kind.  */
+int yychar;
 
 
-    int yystate;
-    /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
+
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
 
-    /* The stacks and their tools:
-       `yyss': related to states.
-       `yyvs': related to semantic values.
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
 
-       Refer to the stacks thru separate pointers, to allow yyoverflow
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
-    yytype_int16 yyssa[YYINITDEPTH];
-    yytype_int16 *yyss;
-    yytype_int16 *yyssp;
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
 
-    /* The semantic value stack.  */
-    YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-    YYSIZE_T yystacksize;
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
 
-#if YYERROR_VERBOSE
-  /* Buffer for error messages, and its allocated size.  */
-  char yymsgbuf[128];
-  char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
 
@@ -1907,133 +1634,140 @@ yyparse ()
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yytoken = 0;
-  yyss = yyssa;
-  yyvs = yyvsa;
-  yystacksize = YYINITDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
 
-  /* Initialize stack pointers.
-     Waste one element of value and location stack
-     so that they stay on the same level as the state stack.
-     The wasted elements are never initialized.  */
-  yyssp = yyss;
-  yyvsp = yyvs;
-
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
-	/* Give user a chance to reallocate the stack.  Use copies of
-	   these so that the &'s don't force the real ones into
-	   memory.  */
-	YYSTYPE *yyvs1 = yyvs;
-	yytype_int16 *yyss1 = yyss;
-
-	/* Each stack pointer address is followed by the size of the
-	   data in use in that stack, in bytes.  This used to be a
-	   conditional around just the two extra args, but that might
-	   be undefined if yyoverflow is a macro.  */
-	yyoverflow (YY_("memory exhausted"),
-		    &yyss1, yysize * sizeof (*yyssp),
-		    &yyvs1, yysize * sizeof (*yyvsp),
-		    &yystacksize);
-
-	yyss = yyss1;
-	yyvs = yyvs1;
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-	goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
-	yystacksize = YYMAXDEPTH;
+        yystacksize = YYMAXDEPTH;
 
       {
-	yytype_int16 *yyss1 = yyss;
-	union yyalloc *yyptr =
-	  (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
-	if (! yyptr)
-	  goto yyexhaustedlab;
-	YYSTACK_RELOCATE (yyss_alloc, yyss);
-	YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
 #  undef YYSTACK_RELOCATE
-	if (yyss1 != yyssa)
-	  YYSTACK_FREE (yyss1);
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
 
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-		  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
-	YYABORT;
+        YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
 
   if (yystate == YYFINAL)
     YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
      lookahead token if we need one and don't already have one.  */
 
   /* First try to decide what to do without reference to lookahead token.  */
   yyn = yypact[yystate];
-  if (yyn == YYPACT_NINF)
+  if (yypact_value_is_default (yyn))
     goto yydefault;
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
-      yychar = YYLEX;
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval);
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -2048,8 +1782,8 @@ yybackup:
   yyn = yytable[yyn];
   if (yyn <= 0)
     {
-      if (yyn == 0 || yyn == YYTABLE_NINF)
-	goto yyerrlab;
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
       yyn = -yyn;
       goto yyreduce;
     }
@@ -2061,13 +1795,13 @@ yybackup:
 
   /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token.  */
-  yychar = YYEMPTY;
-
   yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -2082,14 +1816,14 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
   yylen = yyr2[yyn];
 
   /* If YYLEN is nonzero, implement the default value of the action:
-     `$$ = $1'.
+     '$$ = $1'.
 
      Otherwise, the following line sets YYVAL to garbage.
      This behavior is undocumented and Bison
@@ -2102,263 +1836,235 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 2:
-
-/* Line 1455 of yacc.c  */
-#line 285 "indra.y"
-    {
-		(yyval.script) = new LLScriptScript((yyvsp[(1) - (2)].global_store), (yyvsp[(2) - (2)].state));
+  case 2: /* lscript_program: globals states  */
+#line 290 "indra.y"
+        {
+		(yyval.script) = new LLScriptScript((yyvsp[-1].global_store), (yyvsp[0].state));
 		gAllocationManager->addAllocation((yyval.script));
 		gScriptp = (yyval.script);
-	;}
+	}
+#line 1847 "indra_generated.y.cpp"
     break;
 
-  case 3:
-
-/* Line 1455 of yacc.c  */
-#line 291 "indra.y"
-    {
-		(yyval.script) = new LLScriptScript(NULL, (yyvsp[(1) - (1)].state));
+  case 3: /* lscript_program: states  */
+#line 296 "indra.y"
+        {
+		(yyval.script) = new LLScriptScript(NULL, (yyvsp[0].state));
 		gAllocationManager->addAllocation((yyval.script));
 		gScriptp = (yyval.script);
-	;}
+	}
+#line 1857 "indra_generated.y.cpp"
     break;
 
-  case 4:
-
-/* Line 1455 of yacc.c  */
-#line 300 "indra.y"
-    {
-		(yyval.global_store) = (yyvsp[(1) - (1)].global_store);
-	;}
+  case 4: /* globals: global  */
+#line 305 "indra.y"
+        {
+		(yyval.global_store) = (yyvsp[0].global_store);
+	}
+#line 1865 "indra_generated.y.cpp"
     break;
 
-  case 5:
-
-/* Line 1455 of yacc.c  */
-#line 304 "indra.y"
-    {
-		(yyval.global_store) = (yyvsp[(1) - (2)].global_store);
-		(yyvsp[(1) - (2)].global_store)->addGlobal((yyvsp[(2) - (2)].global_store));
-	;}
+  case 5: /* globals: global globals  */
+#line 309 "indra.y"
+        {
+		(yyval.global_store) = (yyvsp[-1].global_store);
+		(yyvsp[-1].global_store)->addGlobal((yyvsp[0].global_store));
+	}
+#line 1874 "indra_generated.y.cpp"
     break;
 
-  case 6:
-
-/* Line 1455 of yacc.c  */
-#line 312 "indra.y"
-    {
-		(yyval.global_store) = new LLScritpGlobalStorage((yyvsp[(1) - (1)].global));
+  case 6: /* global: global_variable  */
+#line 317 "indra.y"
+        {
+		(yyval.global_store) = new LLScritpGlobalStorage((yyvsp[0].global));
 		gAllocationManager->addAllocation((yyval.global_store));
-	;}
+	}
+#line 1883 "indra_generated.y.cpp"
     break;
 
-  case 7:
-
-/* Line 1455 of yacc.c  */
-#line 317 "indra.y"
-    {
-		(yyval.global_store) = new LLScritpGlobalStorage((yyvsp[(1) - (1)].global_funcs));
+  case 7: /* global: global_function  */
+#line 322 "indra.y"
+        {
+		(yyval.global_store) = new LLScritpGlobalStorage((yyvsp[0].global_funcs));
 		gAllocationManager->addAllocation((yyval.global_store));
-	;}
+	}
+#line 1892 "indra_generated.y.cpp"
     break;
 
-  case 8:
-
-/* Line 1455 of yacc.c  */
-#line 325 "indra.y"
-    {
-		(yyval.identifier) = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(2) - (2)].sval), (yyvsp[(1) - (2)].type));	
+  case 8: /* name_type: typename IDENTIFIER  */
+#line 330 "indra.y"
+        {
+		(yyval.identifier) = new LLScriptIdentifier(gLine, gColumn, (yyvsp[0].sval), (yyvsp[-1].type));	
 		gAllocationManager->addAllocation((yyval.identifier));
-	;}
+	}
+#line 1901 "indra_generated.y.cpp"
     break;
 
-  case 9:
-
-/* Line 1455 of yacc.c  */
-#line 333 "indra.y"
-    {
-		(yyval.global) = new LLScriptGlobalVariable(gLine, gColumn, (yyvsp[(1) - (2)].identifier)->mType, (yyvsp[(1) - (2)].identifier), NULL);
+  case 9: /* global_variable: name_type ';'  */
+#line 338 "indra.y"
+        {
+		(yyval.global) = new LLScriptGlobalVariable(gLine, gColumn, (yyvsp[-1].identifier)->mType, (yyvsp[-1].identifier), NULL);
 		gAllocationManager->addAllocation((yyval.global));
-	;}
+	}
+#line 1910 "indra_generated.y.cpp"
     break;
 
-  case 10:
-
-/* Line 1455 of yacc.c  */
-#line 338 "indra.y"
-    {
-		(yyval.global) = new LLScriptGlobalVariable(gLine, gColumn, (yyvsp[(1) - (4)].identifier)->mType, (yyvsp[(1) - (4)].identifier), (yyvsp[(3) - (4)].assignable));
+  case 10: /* global_variable: name_type '=' simple_assignable ';'  */
+#line 343 "indra.y"
+        {
+		(yyval.global) = new LLScriptGlobalVariable(gLine, gColumn, (yyvsp[-3].identifier)->mType, (yyvsp[-3].identifier), (yyvsp[-1].assignable));
 		gAllocationManager->addAllocation((yyval.global));
-	;}
+	}
+#line 1919 "indra_generated.y.cpp"
     break;
 
-  case 11:
-
-/* Line 1455 of yacc.c  */
-#line 346 "indra.y"
-    {
-		(yyval.assignable) = (yyvsp[(1) - (1)].assignable);
-	;}
+  case 11: /* simple_assignable: simple_assignable_no_list  */
+#line 351 "indra.y"
+        {
+		(yyval.assignable) = (yyvsp[0].assignable);
+	}
+#line 1927 "indra_generated.y.cpp"
     break;
 
-  case 12:
-
-/* Line 1455 of yacc.c  */
-#line 350 "indra.y"
-    {
-		(yyval.assignable) = (yyvsp[(1) - (1)].assignable);
-	;}
+  case 12: /* simple_assignable: list_constant  */
+#line 355 "indra.y"
+        {
+		(yyval.assignable) = (yyvsp[0].assignable);
+	}
+#line 1935 "indra_generated.y.cpp"
     break;
 
-  case 13:
-
-/* Line 1455 of yacc.c  */
-#line 357 "indra.y"
-    {
-		LLScriptIdentifier	*id = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(1) - (1)].sval));	
+  case 13: /* simple_assignable_no_list: IDENTIFIER  */
+#line 362 "indra.y"
+        {
+		LLScriptIdentifier	*id = new LLScriptIdentifier(gLine, gColumn, (yyvsp[0].sval));	
 		gAllocationManager->addAllocation(id);
 		(yyval.assignable) = new LLScriptSAIdentifier(gLine, gColumn, id);	
 		gAllocationManager->addAllocation((yyval.assignable));
-	;}
-    break;
-
-  case 14:
-
-/* Line 1455 of yacc.c  */
-#line 364 "indra.y"
-    {
-		(yyval.assignable) = new LLScriptSAConstant(gLine, gColumn, (yyvsp[(1) - (1)].constant));
-		gAllocationManager->addAllocation((yyval.assignable));
-	;}
+	}
+#line 1946 "indra_generated.y.cpp"
     break;
 
-  case 15:
-
-/* Line 1455 of yacc.c  */
+  case 14: /* simple_assignable_no_list: constant  */
 #line 369 "indra.y"
-    {
-		(yyval.assignable) = (yyvsp[(1) - (1)].assignable);
-	;}
+        {
+		(yyval.assignable) = new LLScriptSAConstant(gLine, gColumn, (yyvsp[0].constant));
+		gAllocationManager->addAllocation((yyval.assignable));
+	}
+#line 1955 "indra_generated.y.cpp"
     break;
 
-  case 16:
-
-/* Line 1455 of yacc.c  */
-#line 376 "indra.y"
-    {
-		(yyval.constant) = new LLScriptConstantInteger(gLine, gColumn, (yyvsp[(1) - (1)].ival));
-		gAllocationManager->addAllocation((yyval.constant));
-	;}
+  case 15: /* simple_assignable_no_list: special_constant  */
+#line 374 "indra.y"
+        {
+		(yyval.assignable) = (yyvsp[0].assignable);
+	}
+#line 1963 "indra_generated.y.cpp"
     break;
 
-  case 17:
-
-/* Line 1455 of yacc.c  */
+  case 16: /* constant: integer_constant  */
 #line 381 "indra.y"
-    {
-		(yyval.constant) = new LLScriptConstantFloat(gLine, gColumn, (yyvsp[(1) - (1)].fval));
+        {
+		(yyval.constant) = new LLScriptConstantInteger(gLine, gColumn, (yyvsp[0].ival));
 		gAllocationManager->addAllocation((yyval.constant));
-	;}
+	}
+#line 1972 "indra_generated.y.cpp"
     break;
 
-  case 18:
-
-/* Line 1455 of yacc.c  */
+  case 17: /* constant: fp_constant  */
 #line 386 "indra.y"
-    {
-		(yyval.constant) = new LLScriptConstantString(gLine, gColumn, (yyvsp[(1) - (1)].sval));
+        {
+		(yyval.constant) = new LLScriptConstantFloat(gLine, gColumn, (yyvsp[0].fval));
 		gAllocationManager->addAllocation((yyval.constant));
-	;}
-    break;
-
-  case 19:
-
-/* Line 1455 of yacc.c  */
-#line 394 "indra.y"
-    {
-		(yyval.fval) = (yyvsp[(1) - (1)].fval);
-	;}
-    break;
-
-  case 20:
-
-/* Line 1455 of yacc.c  */
-#line 398 "indra.y"
-    {
-		(yyval.fval) = -(yyvsp[(2) - (2)].fval);
-	;}
-    break;
-
-  case 21:
-
-/* Line 1455 of yacc.c  */
-#line 405 "indra.y"
-    {
-		(yyval.ival) = (yyvsp[(1) - (1)].ival);
-	;}
+	}
+#line 1981 "indra_generated.y.cpp"
     break;
 
-  case 22:
-
-/* Line 1455 of yacc.c  */
-#line 409 "indra.y"
-    {
-		(yyval.ival) = (yyvsp[(1) - (1)].ival);
-	;}
+  case 18: /* constant: STRING_CONSTANT  */
+#line 391 "indra.y"
+        {
+		(yyval.constant) = new LLScriptConstantString(gLine, gColumn, (yyvsp[0].sval));
+		gAllocationManager->addAllocation((yyval.constant));
+	}
+#line 1990 "indra_generated.y.cpp"
     break;
 
-  case 23:
-
-/* Line 1455 of yacc.c  */
-#line 413 "indra.y"
-    {
-		(yyval.ival) = (yyvsp[(1) - (1)].ival);
-	;}
+  case 19: /* fp_constant: FP_CONSTANT  */
+#line 399 "indra.y"
+        {
+		(yyval.fval) = (yyvsp[0].fval);
+	}
+#line 1998 "indra_generated.y.cpp"
     break;
 
-  case 24:
+  case 20: /* fp_constant: '-' FP_CONSTANT  */
+#line 403 "indra.y"
+        {
+		(yyval.fval) = -(yyvsp[0].fval);
+	}
+#line 2006 "indra_generated.y.cpp"
+    break;
 
-/* Line 1455 of yacc.c  */
-#line 417 "indra.y"
-    {
-		(yyval.ival) = -(yyvsp[(2) - (2)].ival);
-	;}
+  case 21: /* integer_constant: INTEGER_CONSTANT  */
+#line 410 "indra.y"
+        {
+		(yyval.ival) = (yyvsp[0].ival);
+	}
+#line 2014 "indra_generated.y.cpp"
     break;
 
-  case 25:
+  case 22: /* integer_constant: INTEGER_TRUE  */
+#line 414 "indra.y"
+        {
+		(yyval.ival) = (yyvsp[0].ival);
+	}
+#line 2022 "indra_generated.y.cpp"
+    break;
 
-/* Line 1455 of yacc.c  */
-#line 424 "indra.y"
-    {
-		(yyval.assignable) = (yyvsp[(1) - (1)].assignable);
-	;}
+  case 23: /* integer_constant: INTEGER_FALSE  */
+#line 418 "indra.y"
+        {
+		(yyval.ival) = (yyvsp[0].ival);
+	}
+#line 2030 "indra_generated.y.cpp"
     break;
 
-  case 26:
+  case 24: /* integer_constant: '-' INTEGER_CONSTANT  */
+#line 422 "indra.y"
+        {
+		(yyval.ival) = -(yyvsp[0].ival);
+	}
+#line 2038 "indra_generated.y.cpp"
+    break;
 
-/* Line 1455 of yacc.c  */
-#line 428 "indra.y"
-    {
-		(yyval.assignable) = (yyvsp[(1) - (1)].assignable);
-	;}
+  case 25: /* special_constant: vector_constant  */
+#line 429 "indra.y"
+        {
+		(yyval.assignable) = (yyvsp[0].assignable);
+	}
+#line 2046 "indra_generated.y.cpp"
     break;
 
-  case 27:
+  case 26: /* special_constant: quaternion_constant  */
+#line 433 "indra.y"
+        {
+		(yyval.assignable) = (yyvsp[0].assignable);
+	}
+#line 2054 "indra_generated.y.cpp"
+    break;
 
-/* Line 1455 of yacc.c  */
-#line 435 "indra.y"
-    {
-		(yyval.assignable) = new LLScriptSAVector(gLine, gColumn, (yyvsp[(2) - (7)].assignable), (yyvsp[(4) - (7)].assignable), (yyvsp[(6) - (7)].assignable));
+  case 27: /* vector_constant: '<' simple_assignable ',' simple_assignable ',' simple_assignable '>'  */
+#line 440 "indra.y"
+        {
+		(yyval.assignable) = new LLScriptSAVector(gLine, gColumn, (yyvsp[-5].assignable), (yyvsp[-3].assignable), (yyvsp[-1].assignable));
 		gAllocationManager->addAllocation((yyval.assignable));
-	;}
+	}
+#line 2063 "indra_generated.y.cpp"
     break;
 
-  case 28:
-
-/* Line 1455 of yacc.c  */
-#line 440 "indra.y"
-    {
+  case 28: /* vector_constant: ZERO_VECTOR  */
+#line 445 "indra.y"
+        {
 		LLScriptConstantFloat *cf0 = new LLScriptConstantFloat(gLine, gColumn, 0.f);
 		gAllocationManager->addAllocation(cf0);
 		LLScriptSAConstant *sa0 = new LLScriptSAConstant(gLine, gColumn, cf0);
@@ -2373,14 +2079,13 @@ yyreduce:
 		gAllocationManager->addAllocation(sa2);
 		(yyval.assignable) = new LLScriptSAVector(gLine, gColumn, sa0, sa1, sa2);
 		gAllocationManager->addAllocation((yyval.assignable));
-	;}
+	}
+#line 2084 "indra_generated.y.cpp"
     break;
 
-  case 29:
-
-/* Line 1455 of yacc.c  */
-#line 457 "indra.y"
-    {
+  case 29: /* vector_constant: TOUCH_INVALID_VECTOR  */
+#line 462 "indra.y"
+        {
 		LLScriptConstantFloat *cf0 = new LLScriptConstantFloat(gLine, gColumn, 0.f);
 		gAllocationManager->addAllocation(cf0);
 		LLScriptSAConstant *sa0 = new LLScriptSAConstant(gLine, gColumn, cf0);
@@ -2395,14 +2100,13 @@ yyreduce:
 		gAllocationManager->addAllocation(sa2);
 		(yyval.assignable) = new LLScriptSAVector(gLine, gColumn, sa0, sa1, sa2);
 		gAllocationManager->addAllocation((yyval.assignable));
-	;}
+	}
+#line 2105 "indra_generated.y.cpp"
     break;
 
-  case 30:
-
-/* Line 1455 of yacc.c  */
-#line 474 "indra.y"
-    {
+  case 30: /* vector_constant: TOUCH_INVALID_TEXCOORD  */
+#line 479 "indra.y"
+        {
 		LLScriptConstantFloat *cf0 = new LLScriptConstantFloat(gLine, gColumn, -1.f);
 		gAllocationManager->addAllocation(cf0);
 		LLScriptSAConstant *sa0 = new LLScriptSAConstant(gLine, gColumn, cf0);
@@ -2417,24 +2121,22 @@ yyreduce:
 		gAllocationManager->addAllocation(sa2);
 		(yyval.assignable) = new LLScriptSAVector(gLine, gColumn, sa0, sa1, sa2);
 		gAllocationManager->addAllocation((yyval.assignable));
-	;}
+	}
+#line 2126 "indra_generated.y.cpp"
     break;
 
-  case 31:
-
-/* Line 1455 of yacc.c  */
-#line 494 "indra.y"
-    {
-		(yyval.assignable) = new LLScriptSAQuaternion(gLine, gColumn, (yyvsp[(2) - (9)].assignable), (yyvsp[(4) - (9)].assignable), (yyvsp[(6) - (9)].assignable), (yyvsp[(8) - (9)].assignable));
+  case 31: /* quaternion_constant: '<' simple_assignable ',' simple_assignable ',' simple_assignable ',' simple_assignable '>'  */
+#line 499 "indra.y"
+        {
+		(yyval.assignable) = new LLScriptSAQuaternion(gLine, gColumn, (yyvsp[-7].assignable), (yyvsp[-5].assignable), (yyvsp[-3].assignable), (yyvsp[-1].assignable));
 		gAllocationManager->addAllocation((yyval.assignable));
-	;}
+	}
+#line 2135 "indra_generated.y.cpp"
     break;
 
-  case 32:
-
-/* Line 1455 of yacc.c  */
-#line 499 "indra.y"
-    {
+  case 32: /* quaternion_constant: ZERO_ROTATION  */
+#line 504 "indra.y"
+        {
 		LLScriptConstantFloat *cf0 = new LLScriptConstantFloat(gLine, gColumn, 0.f);
 		gAllocationManager->addAllocation(cf0);
 		LLScriptSAConstant *sa0 = new LLScriptSAConstant(gLine, gColumn, cf0);
@@ -2453,1882 +2155,1706 @@ yyreduce:
 		gAllocationManager->addAllocation(sa3);
 		(yyval.assignable) = new LLScriptSAQuaternion(gLine, gColumn, sa0, sa1, sa2, sa3);
 		gAllocationManager->addAllocation((yyval.assignable));
-	;}
+	}
+#line 2160 "indra_generated.y.cpp"
     break;
 
-  case 33:
-
-/* Line 1455 of yacc.c  */
-#line 523 "indra.y"
-    {
-		(yyval.assignable) = new LLScriptSAList(gLine, gColumn, (yyvsp[(2) - (3)].assignable));
+  case 33: /* list_constant: '[' list_entries ']'  */
+#line 528 "indra.y"
+        {
+		(yyval.assignable) = new LLScriptSAList(gLine, gColumn, (yyvsp[-1].assignable));
 		gAllocationManager->addAllocation((yyval.assignable));
-	;}
+	}
+#line 2169 "indra_generated.y.cpp"
     break;
 
-  case 34:
-
-/* Line 1455 of yacc.c  */
-#line 528 "indra.y"
-    {
+  case 34: /* list_constant: '[' ']'  */
+#line 533 "indra.y"
+        {
 		(yyval.assignable) = new LLScriptSAList(gLine, gColumn, NULL);
 		gAllocationManager->addAllocation((yyval.assignable));
-	;}
+	}
+#line 2178 "indra_generated.y.cpp"
     break;
 
-  case 35:
-
-/* Line 1455 of yacc.c  */
-#line 536 "indra.y"
-    {
-		(yyval.assignable) = (yyvsp[(1) - (1)].assignable);
-	;}
+  case 35: /* list_entries: list_entry  */
+#line 541 "indra.y"
+        {
+		(yyval.assignable) = (yyvsp[0].assignable);
+	}
+#line 2186 "indra_generated.y.cpp"
     break;
 
-  case 36:
-
-/* Line 1455 of yacc.c  */
-#line 540 "indra.y"
-    {
-		(yyval.assignable) = (yyvsp[(1) - (3)].assignable);
-		(yyvsp[(1) - (3)].assignable)->addAssignable((yyvsp[(3) - (3)].assignable));
-	;}
+  case 36: /* list_entries: list_entry ',' list_entries  */
+#line 545 "indra.y"
+        {
+		(yyval.assignable) = (yyvsp[-2].assignable);
+		(yyvsp[-2].assignable)->addAssignable((yyvsp[0].assignable));
+	}
+#line 2195 "indra_generated.y.cpp"
     break;
 
-  case 37:
-
-/* Line 1455 of yacc.c  */
-#line 548 "indra.y"
-    {
-		(yyval.assignable) = (yyvsp[(1) - (1)].assignable);
-	;}
+  case 37: /* list_entry: simple_assignable_no_list  */
+#line 553 "indra.y"
+        {
+		(yyval.assignable) = (yyvsp[0].assignable);
+	}
+#line 2203 "indra_generated.y.cpp"
     break;
 
-  case 38:
-
-/* Line 1455 of yacc.c  */
-#line 555 "indra.y"
-    {  
+  case 38: /* typename: INTEGER  */
+#line 560 "indra.y"
+        {  
 		(yyval.type) = new LLScriptType(gLine, gColumn, LST_INTEGER);
 		gAllocationManager->addAllocation((yyval.type));
-	;}
+	}
+#line 2212 "indra_generated.y.cpp"
     break;
 
-  case 39:
-
-/* Line 1455 of yacc.c  */
-#line 560 "indra.y"
-    {  
+  case 39: /* typename: FLOAT_TYPE  */
+#line 565 "indra.y"
+        {  
 		(yyval.type) = new LLScriptType(gLine, gColumn, LST_FLOATINGPOINT);
 		gAllocationManager->addAllocation((yyval.type));
-	;}
+	}
+#line 2221 "indra_generated.y.cpp"
     break;
 
-  case 40:
-
-/* Line 1455 of yacc.c  */
-#line 565 "indra.y"
-    {  
+  case 40: /* typename: STRING  */
+#line 570 "indra.y"
+        {  
 		(yyval.type) = new LLScriptType(gLine, gColumn, LST_STRING);
 		gAllocationManager->addAllocation((yyval.type));
-	;}
+	}
+#line 2230 "indra_generated.y.cpp"
     break;
 
-  case 41:
-
-/* Line 1455 of yacc.c  */
-#line 570 "indra.y"
-    {  
+  case 41: /* typename: LLKEY  */
+#line 575 "indra.y"
+        {  
 		(yyval.type) = new LLScriptType(gLine, gColumn, LST_KEY);
 		gAllocationManager->addAllocation((yyval.type));
-	;}
+	}
+#line 2239 "indra_generated.y.cpp"
     break;
 
-  case 42:
-
-/* Line 1455 of yacc.c  */
-#line 575 "indra.y"
-    {  
+  case 42: /* typename: VECTOR  */
+#line 580 "indra.y"
+        {  
 		(yyval.type) = new LLScriptType(gLine, gColumn, LST_VECTOR);
 		gAllocationManager->addAllocation((yyval.type));
-	;}
+	}
+#line 2248 "indra_generated.y.cpp"
     break;
 
-  case 43:
-
-/* Line 1455 of yacc.c  */
-#line 580 "indra.y"
-    {  
+  case 43: /* typename: QUATERNION  */
+#line 585 "indra.y"
+        {  
 		(yyval.type) = new LLScriptType(gLine, gColumn, LST_QUATERNION);
 		gAllocationManager->addAllocation((yyval.type));
-	;}
+	}
+#line 2257 "indra_generated.y.cpp"
     break;
 
-  case 44:
-
-/* Line 1455 of yacc.c  */
-#line 585 "indra.y"
-    {
+  case 44: /* typename: LIST  */
+#line 590 "indra.y"
+        {
 		(yyval.type) = new LLScriptType(gLine, gColumn, LST_LIST);
 		gAllocationManager->addAllocation((yyval.type));
-	;}
+	}
+#line 2266 "indra_generated.y.cpp"
     break;
 
-  case 45:
-
-/* Line 1455 of yacc.c  */
-#line 593 "indra.y"
-    {  
-		LLScriptIdentifier	*id = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(1) - (4)].sval));	
+  case 45: /* global_function: IDENTIFIER '(' ')' compound_statement  */
+#line 598 "indra.y"
+        {  
+		LLScriptIdentifier	*id = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-3].sval));	
 		gAllocationManager->addAllocation(id);
-		(yyval.global_funcs) = new LLScriptGlobalFunctions(gLine, gColumn, NULL, id, NULL, (yyvsp[(4) - (4)].statement));
+		(yyval.global_funcs) = new LLScriptGlobalFunctions(gLine, gColumn, NULL, id, NULL, (yyvsp[0].statement));
 		gAllocationManager->addAllocation((yyval.global_funcs));
-	;}
+	}
+#line 2277 "indra_generated.y.cpp"
     break;
 
-  case 46:
-
-/* Line 1455 of yacc.c  */
-#line 600 "indra.y"
-    {
-		(yyval.global_funcs) = new LLScriptGlobalFunctions(gLine, gColumn, (yyvsp[(1) - (4)].identifier)->mType, (yyvsp[(1) - (4)].identifier), NULL, (yyvsp[(4) - (4)].statement));
+  case 46: /* global_function: name_type '(' ')' compound_statement  */
+#line 605 "indra.y"
+        {
+		(yyval.global_funcs) = new LLScriptGlobalFunctions(gLine, gColumn, (yyvsp[-3].identifier)->mType, (yyvsp[-3].identifier), NULL, (yyvsp[0].statement));
 		gAllocationManager->addAllocation((yyval.global_funcs));
-	;}
+	}
+#line 2286 "indra_generated.y.cpp"
     break;
 
-  case 47:
-
-/* Line 1455 of yacc.c  */
-#line 605 "indra.y"
-    {
-		LLScriptIdentifier	*id = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(1) - (5)].sval));	
+  case 47: /* global_function: IDENTIFIER '(' function_parameters ')' compound_statement  */
+#line 610 "indra.y"
+        {
+		LLScriptIdentifier	*id = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-4].sval));	
 		gAllocationManager->addAllocation(id);
-		(yyval.global_funcs) = new LLScriptGlobalFunctions(gLine, gColumn, NULL, id, (yyvsp[(3) - (5)].global_decl), (yyvsp[(5) - (5)].statement));
+		(yyval.global_funcs) = new LLScriptGlobalFunctions(gLine, gColumn, NULL, id, (yyvsp[-2].global_decl), (yyvsp[0].statement));
 		gAllocationManager->addAllocation((yyval.global_funcs));
-	;}
+	}
+#line 2297 "indra_generated.y.cpp"
     break;
 
-  case 48:
-
-/* Line 1455 of yacc.c  */
-#line 612 "indra.y"
-    {  
-		(yyval.global_funcs) = new LLScriptGlobalFunctions(gLine, gColumn, (yyvsp[(1) - (5)].identifier)->mType, (yyvsp[(1) - (5)].identifier), (yyvsp[(3) - (5)].global_decl), (yyvsp[(5) - (5)].statement));
+  case 48: /* global_function: name_type '(' function_parameters ')' compound_statement  */
+#line 617 "indra.y"
+        {  
+		(yyval.global_funcs) = new LLScriptGlobalFunctions(gLine, gColumn, (yyvsp[-4].identifier)->mType, (yyvsp[-4].identifier), (yyvsp[-2].global_decl), (yyvsp[0].statement));
 		gAllocationManager->addAllocation((yyval.global_funcs));
-	;}
+	}
+#line 2306 "indra_generated.y.cpp"
     break;
 
-  case 49:
-
-/* Line 1455 of yacc.c  */
-#line 620 "indra.y"
-    {  
-		(yyval.global_decl) = (yyvsp[(1) - (1)].global_decl);
-	;}
+  case 49: /* function_parameters: function_parameter  */
+#line 625 "indra.y"
+        {  
+		(yyval.global_decl) = (yyvsp[0].global_decl);
+	}
+#line 2314 "indra_generated.y.cpp"
     break;
 
-  case 50:
-
-/* Line 1455 of yacc.c  */
-#line 624 "indra.y"
-    {  
-		(yyval.global_decl) = (yyvsp[(1) - (3)].global_decl);
-		(yyvsp[(1) - (3)].global_decl)->addFunctionParameter((yyvsp[(3) - (3)].global_decl));
-	;}
+  case 50: /* function_parameters: function_parameter ',' function_parameters  */
+#line 629 "indra.y"
+        {  
+		(yyval.global_decl) = (yyvsp[-2].global_decl);
+		(yyvsp[-2].global_decl)->addFunctionParameter((yyvsp[0].global_decl));
+	}
+#line 2323 "indra_generated.y.cpp"
     break;
 
-  case 51:
-
-/* Line 1455 of yacc.c  */
-#line 632 "indra.y"
-    {  
-		LLScriptIdentifier	*id = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(2) - (2)].sval));	
+  case 51: /* function_parameter: typename IDENTIFIER  */
+#line 637 "indra.y"
+        {  
+		LLScriptIdentifier	*id = new LLScriptIdentifier(gLine, gColumn, (yyvsp[0].sval));	
 		gAllocationManager->addAllocation(id);
-		(yyval.global_decl) = new LLScriptFunctionDec(gLine, gColumn, (yyvsp[(1) - (2)].type), id);
+		(yyval.global_decl) = new LLScriptFunctionDec(gLine, gColumn, (yyvsp[-1].type), id);
 		gAllocationManager->addAllocation((yyval.global_decl));
-	;}
+	}
+#line 2334 "indra_generated.y.cpp"
     break;
 
-  case 52:
-
-/* Line 1455 of yacc.c  */
-#line 642 "indra.y"
-    {  
-		(yyval.state) = (yyvsp[(1) - (1)].state);
-	;}
+  case 52: /* states: default  */
+#line 647 "indra.y"
+        {  
+		(yyval.state) = (yyvsp[0].state);
+	}
+#line 2342 "indra_generated.y.cpp"
     break;
 
-  case 53:
-
-/* Line 1455 of yacc.c  */
-#line 646 "indra.y"
-    {  
-		(yyval.state) = (yyvsp[(1) - (2)].state);
-		(yyvsp[(1) - (2)].state)->mNextp = (yyvsp[(2) - (2)].state);
-	;}
+  case 53: /* states: default other_states  */
+#line 651 "indra.y"
+        {  
+		(yyval.state) = (yyvsp[-1].state);
+		(yyvsp[-1].state)->mNextp = (yyvsp[0].state);
+	}
+#line 2351 "indra_generated.y.cpp"
     break;
 
-  case 54:
-
-/* Line 1455 of yacc.c  */
-#line 654 "indra.y"
-    {  
-		(yyval.state) = (yyvsp[(1) - (1)].state);
-	;}
+  case 54: /* other_states: state  */
+#line 659 "indra.y"
+        {  
+		(yyval.state) = (yyvsp[0].state);
+	}
+#line 2359 "indra_generated.y.cpp"
     break;
 
-  case 55:
-
-/* Line 1455 of yacc.c  */
-#line 658 "indra.y"
-    {  
-		(yyval.state) = (yyvsp[(1) - (2)].state);
-		(yyvsp[(1) - (2)].state)->addState((yyvsp[(2) - (2)].state));
-	;}
+  case 55: /* other_states: state other_states  */
+#line 663 "indra.y"
+        {  
+		(yyval.state) = (yyvsp[-1].state);
+		(yyvsp[-1].state)->addState((yyvsp[0].state));
+	}
+#line 2368 "indra_generated.y.cpp"
     break;
 
-  case 56:
-
-/* Line 1455 of yacc.c  */
-#line 666 "indra.y"
-    {  
-		LLScriptIdentifier	*id = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(1) - (4)].sval));	
+  case 56: /* default: STATE_DEFAULT '{' state_body '}'  */
+#line 671 "indra.y"
+        {  
+		LLScriptIdentifier	*id = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-3].sval));	
 		gAllocationManager->addAllocation(id);
-		(yyval.state) = new LLScriptState(gLine, gColumn, LSSTYPE_DEFAULT, id, (yyvsp[(3) - (4)].handler));
+		(yyval.state) = new LLScriptState(gLine, gColumn, LSSTYPE_DEFAULT, id, (yyvsp[-1].handler));
 		gAllocationManager->addAllocation((yyval.state));
-	;}
+	}
+#line 2379 "indra_generated.y.cpp"
     break;
 
-  case 57:
-
-/* Line 1455 of yacc.c  */
-#line 676 "indra.y"
-    {  
-		LLScriptIdentifier	*id = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(2) - (5)].sval));	
+  case 57: /* state: STATE IDENTIFIER '{' state_body '}'  */
+#line 681 "indra.y"
+        {  
+		LLScriptIdentifier	*id = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-3].sval));	
 		gAllocationManager->addAllocation(id);
-		(yyval.state) = new LLScriptState(gLine, gColumn, LSSTYPE_USER, id, (yyvsp[(4) - (5)].handler));
+		(yyval.state) = new LLScriptState(gLine, gColumn, LSSTYPE_USER, id, (yyvsp[-1].handler));
 		gAllocationManager->addAllocation((yyval.state));
-	;}
-    break;
-
-  case 58:
-
-/* Line 1455 of yacc.c  */
-#line 686 "indra.y"
-    {  
-		(yyval.handler) = (yyvsp[(1) - (1)].handler);
-	;}
+	}
+#line 2390 "indra_generated.y.cpp"
     break;
 
-  case 59:
-
-/* Line 1455 of yacc.c  */
-#line 690 "indra.y"
-    {  
-		(yyval.handler) = (yyvsp[(1) - (2)].handler);
-		(yyvsp[(1) - (2)].handler)->addEvent((yyvsp[(2) - (2)].handler));
-	;}
+  case 58: /* state_body: event  */
+#line 691 "indra.y"
+        {  
+		(yyval.handler) = (yyvsp[0].handler);
+	}
+#line 2398 "indra_generated.y.cpp"
     break;
 
-  case 60:
-
-/* Line 1455 of yacc.c  */
-#line 698 "indra.y"
-    {  
-		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[(1) - (2)].event), (yyvsp[(2) - (2)].statement));
-		gAllocationManager->addAllocation((yyval.handler));
-	;}
+  case 59: /* state_body: event state_body  */
+#line 695 "indra.y"
+        {  
+		(yyval.handler) = (yyvsp[-1].handler);
+		(yyvsp[-1].handler)->addEvent((yyvsp[0].handler));
+	}
+#line 2407 "indra_generated.y.cpp"
     break;
 
-  case 61:
-
-/* Line 1455 of yacc.c  */
+  case 60: /* event: state_entry compound_statement  */
 #line 703 "indra.y"
-    {  
-		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[(1) - (2)].event), (yyvsp[(2) - (2)].statement));
+        {  
+		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[-1].event), (yyvsp[0].statement));
 		gAllocationManager->addAllocation((yyval.handler));
-	;}
+	}
+#line 2416 "indra_generated.y.cpp"
     break;
 
-  case 62:
-
-/* Line 1455 of yacc.c  */
+  case 61: /* event: state_exit compound_statement  */
 #line 708 "indra.y"
-    {
-		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[(1) - (2)].event), (yyvsp[(2) - (2)].statement));
+        {  
+		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[-1].event), (yyvsp[0].statement));
 		gAllocationManager->addAllocation((yyval.handler));
-	;}
+	}
+#line 2425 "indra_generated.y.cpp"
     break;
 
-  case 63:
-
-/* Line 1455 of yacc.c  */
+  case 62: /* event: touch_start compound_statement  */
 #line 713 "indra.y"
-    {  
-		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[(1) - (2)].event), (yyvsp[(2) - (2)].statement));
+        {
+		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[-1].event), (yyvsp[0].statement));
 		gAllocationManager->addAllocation((yyval.handler));
-	;}
+	}
+#line 2434 "indra_generated.y.cpp"
     break;
 
-  case 64:
-
-/* Line 1455 of yacc.c  */
+  case 63: /* event: touch compound_statement  */
 #line 718 "indra.y"
-    {  
-		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[(1) - (2)].event), (yyvsp[(2) - (2)].statement));
+        {  
+		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[-1].event), (yyvsp[0].statement));
 		gAllocationManager->addAllocation((yyval.handler));
-	;}
+	}
+#line 2443 "indra_generated.y.cpp"
     break;
 
-  case 65:
-
-/* Line 1455 of yacc.c  */
+  case 64: /* event: touch_end compound_statement  */
 #line 723 "indra.y"
-    {  
-		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[(1) - (2)].event), (yyvsp[(2) - (2)].statement));
+        {  
+		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[-1].event), (yyvsp[0].statement));
 		gAllocationManager->addAllocation((yyval.handler));
-	;}
+	}
+#line 2452 "indra_generated.y.cpp"
     break;
 
-  case 66:
-
-/* Line 1455 of yacc.c  */
+  case 65: /* event: collision_start compound_statement  */
 #line 728 "indra.y"
-    {  
-		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[(1) - (2)].event), (yyvsp[(2) - (2)].statement));
+        {  
+		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[-1].event), (yyvsp[0].statement));
 		gAllocationManager->addAllocation((yyval.handler));
-	;}
+	}
+#line 2461 "indra_generated.y.cpp"
     break;
 
-  case 67:
-
-/* Line 1455 of yacc.c  */
+  case 66: /* event: collision compound_statement  */
 #line 733 "indra.y"
-    {  
-		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[(1) - (2)].event), (yyvsp[(2) - (2)].statement));
+        {  
+		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[-1].event), (yyvsp[0].statement));
 		gAllocationManager->addAllocation((yyval.handler));
-	;}
+	}
+#line 2470 "indra_generated.y.cpp"
     break;
 
-  case 68:
-
-/* Line 1455 of yacc.c  */
+  case 67: /* event: collision_end compound_statement  */
 #line 738 "indra.y"
-    {  
-		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[(1) - (2)].event), (yyvsp[(2) - (2)].statement));
+        {  
+		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[-1].event), (yyvsp[0].statement));
 		gAllocationManager->addAllocation((yyval.handler));
-	;}
+	}
+#line 2479 "indra_generated.y.cpp"
     break;
 
-  case 69:
-
-/* Line 1455 of yacc.c  */
+  case 68: /* event: land_collision_start compound_statement  */
 #line 743 "indra.y"
-    {  
-		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[(1) - (2)].event), (yyvsp[(2) - (2)].statement));
+        {  
+		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[-1].event), (yyvsp[0].statement));
 		gAllocationManager->addAllocation((yyval.handler));
-	;}
+	}
+#line 2488 "indra_generated.y.cpp"
     break;
 
-  case 70:
-
-/* Line 1455 of yacc.c  */
+  case 69: /* event: land_collision compound_statement  */
 #line 748 "indra.y"
-    {  
-		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[(1) - (2)].event), (yyvsp[(2) - (2)].statement));
+        {  
+		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[-1].event), (yyvsp[0].statement));
 		gAllocationManager->addAllocation((yyval.handler));
-	;}
+	}
+#line 2497 "indra_generated.y.cpp"
     break;
 
-  case 71:
-
-/* Line 1455 of yacc.c  */
+  case 70: /* event: land_collision_end compound_statement  */
 #line 753 "indra.y"
-    {  
-		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[(1) - (2)].event), (yyvsp[(2) - (2)].statement));
+        {  
+		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[-1].event), (yyvsp[0].statement));
 		gAllocationManager->addAllocation((yyval.handler));
-	;}
+	}
+#line 2506 "indra_generated.y.cpp"
     break;
 
-  case 72:
-
-/* Line 1455 of yacc.c  */
+  case 71: /* event: timer compound_statement  */
 #line 758 "indra.y"
-    {
-		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[(1) - (2)].event), (yyvsp[(2) - (2)].statement));
+        {  
+		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[-1].event), (yyvsp[0].statement));
 		gAllocationManager->addAllocation((yyval.handler));
-	;}
+	}
+#line 2515 "indra_generated.y.cpp"
     break;
 
-  case 73:
-
-/* Line 1455 of yacc.c  */
+  case 72: /* event: chat compound_statement  */
 #line 763 "indra.y"
-    {  
-		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[(1) - (2)].event), (yyvsp[(2) - (2)].statement));
+        {
+		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[-1].event), (yyvsp[0].statement));
 		gAllocationManager->addAllocation((yyval.handler));
-	;}
+	}
+#line 2524 "indra_generated.y.cpp"
     break;
 
-  case 74:
-
-/* Line 1455 of yacc.c  */
+  case 73: /* event: sensor compound_statement  */
 #line 768 "indra.y"
-    {  
-		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[(1) - (2)].event), (yyvsp[(2) - (2)].statement));
+        {  
+		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[-1].event), (yyvsp[0].statement));
 		gAllocationManager->addAllocation((yyval.handler));
-	;}
+	}
+#line 2533 "indra_generated.y.cpp"
     break;
 
-  case 75:
-
-/* Line 1455 of yacc.c  */
+  case 74: /* event: no_sensor compound_statement  */
 #line 773 "indra.y"
-    {  
-		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[(1) - (2)].event), (yyvsp[(2) - (2)].statement));
+        {  
+		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[-1].event), (yyvsp[0].statement));
 		gAllocationManager->addAllocation((yyval.handler));
-	;}
+	}
+#line 2542 "indra_generated.y.cpp"
     break;
 
-  case 76:
-
-/* Line 1455 of yacc.c  */
+  case 75: /* event: at_target compound_statement  */
 #line 778 "indra.y"
-    {  
-		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[(1) - (2)].event), (yyvsp[(2) - (2)].statement));
+        {  
+		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[-1].event), (yyvsp[0].statement));
 		gAllocationManager->addAllocation((yyval.handler));
-	;}
+	}
+#line 2551 "indra_generated.y.cpp"
     break;
 
-  case 77:
-
-/* Line 1455 of yacc.c  */
+  case 76: /* event: not_at_target compound_statement  */
 #line 783 "indra.y"
-    {  
-		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[(1) - (2)].event), (yyvsp[(2) - (2)].statement));
+        {  
+		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[-1].event), (yyvsp[0].statement));
 		gAllocationManager->addAllocation((yyval.handler));
-	;}
+	}
+#line 2560 "indra_generated.y.cpp"
     break;
 
-  case 78:
-
-/* Line 1455 of yacc.c  */
+  case 77: /* event: at_rot_target compound_statement  */
 #line 788 "indra.y"
-    {  
-		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[(1) - (2)].event), (yyvsp[(2) - (2)].statement));
+        {  
+		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[-1].event), (yyvsp[0].statement));
 		gAllocationManager->addAllocation((yyval.handler));
-	;}
+	}
+#line 2569 "indra_generated.y.cpp"
     break;
 
-  case 79:
-
-/* Line 1455 of yacc.c  */
+  case 78: /* event: not_at_rot_target compound_statement  */
 #line 793 "indra.y"
-    {  
-		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[(1) - (2)].event), (yyvsp[(2) - (2)].statement));
+        {  
+		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[-1].event), (yyvsp[0].statement));
 		gAllocationManager->addAllocation((yyval.handler));
-	;}
+	}
+#line 2578 "indra_generated.y.cpp"
     break;
 
-  case 80:
-
-/* Line 1455 of yacc.c  */
+  case 79: /* event: money compound_statement  */
 #line 798 "indra.y"
-    {  
-		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[(1) - (2)].event), (yyvsp[(2) - (2)].statement));
+        {  
+		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[-1].event), (yyvsp[0].statement));
 		gAllocationManager->addAllocation((yyval.handler));
-	;}
+	}
+#line 2587 "indra_generated.y.cpp"
     break;
 
-  case 81:
-
-/* Line 1455 of yacc.c  */
+  case 80: /* event: email compound_statement  */
 #line 803 "indra.y"
-    {  
-		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[(1) - (2)].event), (yyvsp[(2) - (2)].statement));
+        {  
+		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[-1].event), (yyvsp[0].statement));
 		gAllocationManager->addAllocation((yyval.handler));
-	;}
+	}
+#line 2596 "indra_generated.y.cpp"
     break;
 
-  case 82:
-
-/* Line 1455 of yacc.c  */
+  case 81: /* event: run_time_permissions compound_statement  */
 #line 808 "indra.y"
-    {  
-		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[(1) - (2)].event), (yyvsp[(2) - (2)].statement));
+        {  
+		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[-1].event), (yyvsp[0].statement));
 		gAllocationManager->addAllocation((yyval.handler));
-	;}
+	}
+#line 2605 "indra_generated.y.cpp"
     break;
 
-  case 83:
-
-/* Line 1455 of yacc.c  */
+  case 82: /* event: inventory compound_statement  */
 #line 813 "indra.y"
-    {  
-		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[(1) - (2)].event), (yyvsp[(2) - (2)].statement));
+        {  
+		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[-1].event), (yyvsp[0].statement));
 		gAllocationManager->addAllocation((yyval.handler));
-	;}
+	}
+#line 2614 "indra_generated.y.cpp"
     break;
 
-  case 84:
-
-/* Line 1455 of yacc.c  */
+  case 83: /* event: attach compound_statement  */
 #line 818 "indra.y"
-    {  
-		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[(1) - (2)].event), (yyvsp[(2) - (2)].statement));
+        {  
+		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[-1].event), (yyvsp[0].statement));
 		gAllocationManager->addAllocation((yyval.handler));
-	;}
+	}
+#line 2623 "indra_generated.y.cpp"
     break;
 
-  case 85:
-
-/* Line 1455 of yacc.c  */
+  case 84: /* event: dataserver compound_statement  */
 #line 823 "indra.y"
-    {  
-		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[(1) - (2)].event), (yyvsp[(2) - (2)].statement));
+        {  
+		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[-1].event), (yyvsp[0].statement));
 		gAllocationManager->addAllocation((yyval.handler));
-	;}
+	}
+#line 2632 "indra_generated.y.cpp"
     break;
 
-  case 86:
-
-/* Line 1455 of yacc.c  */
+  case 85: /* event: control compound_statement  */
 #line 828 "indra.y"
-    {  
-		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[(1) - (2)].event), (yyvsp[(2) - (2)].statement));
+        {  
+		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[-1].event), (yyvsp[0].statement));
 		gAllocationManager->addAllocation((yyval.handler));
-	;}
+	}
+#line 2641 "indra_generated.y.cpp"
     break;
 
-  case 87:
-
-/* Line 1455 of yacc.c  */
+  case 86: /* event: moving_start compound_statement  */
 #line 833 "indra.y"
-    {  
-		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[(1) - (2)].event), (yyvsp[(2) - (2)].statement));
+        {  
+		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[-1].event), (yyvsp[0].statement));
 		gAllocationManager->addAllocation((yyval.handler));
-	;}
+	}
+#line 2650 "indra_generated.y.cpp"
     break;
 
-  case 88:
-
-/* Line 1455 of yacc.c  */
+  case 87: /* event: moving_end compound_statement  */
 #line 838 "indra.y"
-    {  
-		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[(1) - (2)].event), (yyvsp[(2) - (2)].statement));
+        {  
+		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[-1].event), (yyvsp[0].statement));
 		gAllocationManager->addAllocation((yyval.handler));
-	;}
+	}
+#line 2659 "indra_generated.y.cpp"
     break;
 
-  case 89:
-
-/* Line 1455 of yacc.c  */
+  case 88: /* event: rez compound_statement  */
 #line 843 "indra.y"
-    {  
-		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[(1) - (2)].event), (yyvsp[(2) - (2)].statement));
+        {  
+		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[-1].event), (yyvsp[0].statement));
 		gAllocationManager->addAllocation((yyval.handler));
-	;}
+	}
+#line 2668 "indra_generated.y.cpp"
     break;
 
-  case 90:
-
-/* Line 1455 of yacc.c  */
+  case 89: /* event: object_rez compound_statement  */
 #line 848 "indra.y"
-    {  
-		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[(1) - (2)].event), (yyvsp[(2) - (2)].statement));
+        {  
+		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[-1].event), (yyvsp[0].statement));
 		gAllocationManager->addAllocation((yyval.handler));
-	;}
+	}
+#line 2677 "indra_generated.y.cpp"
     break;
 
-  case 91:
-
-/* Line 1455 of yacc.c  */
+  case 90: /* event: link_message compound_statement  */
 #line 853 "indra.y"
-    {  
-		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[(1) - (2)].event), (yyvsp[(2) - (2)].statement));
+        {  
+		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[-1].event), (yyvsp[0].statement));
 		gAllocationManager->addAllocation((yyval.handler));
-	;}
+	}
+#line 2686 "indra_generated.y.cpp"
     break;
 
-  case 92:
-
-/* Line 1455 of yacc.c  */
+  case 91: /* event: remote_data compound_statement  */
 #line 858 "indra.y"
-    {  
-		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[(1) - (2)].event), (yyvsp[(2) - (2)].statement));
+        {  
+		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[-1].event), (yyvsp[0].statement));
 		gAllocationManager->addAllocation((yyval.handler));
-	;}
+	}
+#line 2695 "indra_generated.y.cpp"
     break;
 
-  case 93:
-
-/* Line 1455 of yacc.c  */
+  case 92: /* event: http_response compound_statement  */
 #line 863 "indra.y"
-    {  
-		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[(1) - (2)].event), (yyvsp[(2) - (2)].statement));
+        {  
+		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[-1].event), (yyvsp[0].statement));
 		gAllocationManager->addAllocation((yyval.handler));
-	;}
+	}
+#line 2704 "indra_generated.y.cpp"
     break;
 
-  case 94:
+  case 93: /* event: http_request compound_statement  */
+#line 868 "indra.y"
+        {  
+		(yyval.handler) = new LLScriptEventHandler(gLine, gColumn, (yyvsp[-1].event), (yyvsp[0].statement));
+		gAllocationManager->addAllocation((yyval.handler));
+	}
+#line 2713 "indra_generated.y.cpp"
+    break;
 
-/* Line 1455 of yacc.c  */
-#line 871 "indra.y"
-    {  
+  case 94: /* state_entry: STATE_ENTRY '(' ')'  */
+#line 876 "indra.y"
+        {  
 		(yyval.event) = new LLScriptStateEntryEvent(gLine, gColumn);
 		gAllocationManager->addAllocation((yyval.event));
-	;}
+	}
+#line 2722 "indra_generated.y.cpp"
     break;
 
-  case 95:
-
-/* Line 1455 of yacc.c  */
-#line 879 "indra.y"
-    {  
+  case 95: /* state_exit: STATE_EXIT '(' ')'  */
+#line 884 "indra.y"
+        {  
 		(yyval.event) = new LLScriptStateExitEvent(gLine, gColumn);
 		gAllocationManager->addAllocation((yyval.event));
-	;}
+	}
+#line 2731 "indra_generated.y.cpp"
     break;
 
-  case 96:
-
-/* Line 1455 of yacc.c  */
-#line 887 "indra.y"
-    {  
-		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(4) - (5)].sval));	
+  case 96: /* touch_start: TOUCH_START '(' INTEGER IDENTIFIER ')'  */
+#line 892 "indra.y"
+        {  
+		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-1].sval));	
 		gAllocationManager->addAllocation(id1);
 		(yyval.event) = new LLScriptTouchStartEvent(gLine, gColumn, id1);
 		gAllocationManager->addAllocation((yyval.event));
-	;}
+	}
+#line 2742 "indra_generated.y.cpp"
     break;
 
-  case 97:
-
-/* Line 1455 of yacc.c  */
-#line 897 "indra.y"
-    {  
-		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(4) - (5)].sval));	
+  case 97: /* touch: TOUCH '(' INTEGER IDENTIFIER ')'  */
+#line 902 "indra.y"
+        {  
+		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-1].sval));	
 		gAllocationManager->addAllocation(id1);
 		(yyval.event) = new LLScriptTouchEvent(gLine, gColumn, id1);
 		gAllocationManager->addAllocation((yyval.event));
-	;}
+	}
+#line 2753 "indra_generated.y.cpp"
     break;
 
-  case 98:
-
-/* Line 1455 of yacc.c  */
-#line 907 "indra.y"
-    {  
-		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(4) - (5)].sval));	
+  case 98: /* touch_end: TOUCH_END '(' INTEGER IDENTIFIER ')'  */
+#line 912 "indra.y"
+        {  
+		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-1].sval));	
 		gAllocationManager->addAllocation(id1);
 		(yyval.event) = new LLScriptTouchEndEvent(gLine, gColumn, id1);
 		gAllocationManager->addAllocation((yyval.event));
-	;}
+	}
+#line 2764 "indra_generated.y.cpp"
     break;
 
-  case 99:
-
-/* Line 1455 of yacc.c  */
-#line 917 "indra.y"
-    {  
-		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(4) - (5)].sval));	
+  case 99: /* collision_start: COLLISION_START '(' INTEGER IDENTIFIER ')'  */
+#line 922 "indra.y"
+        {  
+		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-1].sval));	
 		gAllocationManager->addAllocation(id1);
 		(yyval.event) = new LLScriptCollisionStartEvent(gLine, gColumn, id1);
 		gAllocationManager->addAllocation((yyval.event));
-	;}
+	}
+#line 2775 "indra_generated.y.cpp"
     break;
 
-  case 100:
-
-/* Line 1455 of yacc.c  */
-#line 927 "indra.y"
-    {  
-		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(4) - (5)].sval));	
+  case 100: /* collision: COLLISION '(' INTEGER IDENTIFIER ')'  */
+#line 932 "indra.y"
+        {  
+		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-1].sval));	
 		gAllocationManager->addAllocation(id1);
 		(yyval.event) = new LLScriptCollisionEvent(gLine, gColumn, id1);
 		gAllocationManager->addAllocation((yyval.event));
-	;}
+	}
+#line 2786 "indra_generated.y.cpp"
     break;
 
-  case 101:
-
-/* Line 1455 of yacc.c  */
-#line 937 "indra.y"
-    {  
-		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(4) - (5)].sval));	
+  case 101: /* collision_end: COLLISION_END '(' INTEGER IDENTIFIER ')'  */
+#line 942 "indra.y"
+        {  
+		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-1].sval));	
 		gAllocationManager->addAllocation(id1);
 		(yyval.event) = new LLScriptCollisionEndEvent(gLine, gColumn, id1);
 		gAllocationManager->addAllocation((yyval.event));
-	;}
+	}
+#line 2797 "indra_generated.y.cpp"
     break;
 
-  case 102:
-
-/* Line 1455 of yacc.c  */
-#line 947 "indra.y"
-    {  
-		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(4) - (5)].sval));	
+  case 102: /* land_collision_start: LAND_COLLISION_START '(' VECTOR IDENTIFIER ')'  */
+#line 952 "indra.y"
+        {  
+		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-1].sval));	
 		gAllocationManager->addAllocation(id1);
 		(yyval.event) = new LLScriptLandCollisionStartEvent(gLine, gColumn, id1);
 		gAllocationManager->addAllocation((yyval.event));
-	;}
+	}
+#line 2808 "indra_generated.y.cpp"
     break;
 
-  case 103:
-
-/* Line 1455 of yacc.c  */
-#line 957 "indra.y"
-    {  
-		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(4) - (5)].sval));	
+  case 103: /* land_collision: LAND_COLLISION '(' VECTOR IDENTIFIER ')'  */
+#line 962 "indra.y"
+        {  
+		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-1].sval));	
 		gAllocationManager->addAllocation(id1);
 		(yyval.event) = new LLScriptLandCollisionEvent(gLine, gColumn, id1);
 		gAllocationManager->addAllocation((yyval.event));
-	;}
+	}
+#line 2819 "indra_generated.y.cpp"
     break;
 
-  case 104:
-
-/* Line 1455 of yacc.c  */
-#line 967 "indra.y"
-    {  
-		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(4) - (5)].sval));	
+  case 104: /* land_collision_end: LAND_COLLISION_END '(' VECTOR IDENTIFIER ')'  */
+#line 972 "indra.y"
+        {  
+		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-1].sval));	
 		gAllocationManager->addAllocation(id1);
 		(yyval.event) = new LLScriptLandCollisionEndEvent(gLine, gColumn, id1);
 		gAllocationManager->addAllocation((yyval.event));
-	;}
+	}
+#line 2830 "indra_generated.y.cpp"
     break;
 
-  case 105:
-
-/* Line 1455 of yacc.c  */
-#line 977 "indra.y"
-    {  
-		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(4) - (11)].sval));	
+  case 105: /* at_target: AT_TARGET '(' INTEGER IDENTIFIER ',' VECTOR IDENTIFIER ',' VECTOR IDENTIFIER ')'  */
+#line 982 "indra.y"
+        {  
+		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-7].sval));	
 		gAllocationManager->addAllocation(id1);
-		LLScriptIdentifier	*id2 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(7) - (11)].sval));	
+		LLScriptIdentifier	*id2 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-4].sval));	
 		gAllocationManager->addAllocation(id2);
-		LLScriptIdentifier	*id3 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(10) - (11)].sval));	
+		LLScriptIdentifier	*id3 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-1].sval));	
 		gAllocationManager->addAllocation(id3);
 		(yyval.event) = new LLScriptAtTarget(gLine, gColumn, id1, id2, id3);
 		gAllocationManager->addAllocation((yyval.event));
-	;}
+	}
+#line 2845 "indra_generated.y.cpp"
     break;
 
-  case 106:
-
-/* Line 1455 of yacc.c  */
-#line 991 "indra.y"
-    {  
+  case 106: /* not_at_target: NOT_AT_TARGET '(' ')'  */
+#line 996 "indra.y"
+        {  
 		(yyval.event) = new LLScriptNotAtTarget(gLine, gColumn);
 		gAllocationManager->addAllocation((yyval.event));
-	;}
+	}
+#line 2854 "indra_generated.y.cpp"
     break;
 
-  case 107:
-
-/* Line 1455 of yacc.c  */
-#line 999 "indra.y"
-    {  
-		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(4) - (11)].sval));	
+  case 107: /* at_rot_target: AT_ROT_TARGET '(' INTEGER IDENTIFIER ',' QUATERNION IDENTIFIER ',' QUATERNION IDENTIFIER ')'  */
+#line 1004 "indra.y"
+        {  
+		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-7].sval));	
 		gAllocationManager->addAllocation(id1);
-		LLScriptIdentifier	*id2 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(7) - (11)].sval));	
+		LLScriptIdentifier	*id2 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-4].sval));	
 		gAllocationManager->addAllocation(id2);
-		LLScriptIdentifier	*id3 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(10) - (11)].sval));	
+		LLScriptIdentifier	*id3 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-1].sval));	
 		gAllocationManager->addAllocation(id3);
 		(yyval.event) = new LLScriptAtRotTarget(gLine, gColumn, id1, id2, id3);
 		gAllocationManager->addAllocation((yyval.event));
-	;}
+	}
+#line 2869 "indra_generated.y.cpp"
     break;
 
-  case 108:
-
-/* Line 1455 of yacc.c  */
-#line 1013 "indra.y"
-    {  
+  case 108: /* not_at_rot_target: NOT_AT_ROT_TARGET '(' ')'  */
+#line 1018 "indra.y"
+        {  
 		(yyval.event) = new LLScriptNotAtRotTarget(gLine, gColumn);
 		gAllocationManager->addAllocation((yyval.event));
-	;}
+	}
+#line 2878 "indra_generated.y.cpp"
     break;
 
-  case 109:
-
-/* Line 1455 of yacc.c  */
-#line 1021 "indra.y"
-    {  
-		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(4) - (8)].sval));	
+  case 109: /* money: MONEY '(' LLKEY IDENTIFIER ',' INTEGER IDENTIFIER ')'  */
+#line 1026 "indra.y"
+        {  
+		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-4].sval));	
 		gAllocationManager->addAllocation(id1);
-		LLScriptIdentifier	*id2 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(7) - (8)].sval));	
+		LLScriptIdentifier	*id2 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-1].sval));	
 		gAllocationManager->addAllocation(id2);
 		(yyval.event) = new LLScriptMoneyEvent(gLine, gColumn, id1, id2);
 		gAllocationManager->addAllocation((yyval.event));
-	;}
+	}
+#line 2891 "indra_generated.y.cpp"
     break;
 
-  case 110:
-
-/* Line 1455 of yacc.c  */
-#line 1033 "indra.y"
-    {  
-		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(4) - (17)].sval));	
+  case 110: /* email: EMAIL '(' STRING IDENTIFIER ',' STRING IDENTIFIER ',' STRING IDENTIFIER ',' STRING IDENTIFIER ',' INTEGER IDENTIFIER ')'  */
+#line 1038 "indra.y"
+        {  
+		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-13].sval));	
 		gAllocationManager->addAllocation(id1);
-		LLScriptIdentifier	*id2 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(7) - (17)].sval));	
+		LLScriptIdentifier	*id2 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-10].sval));	
 		gAllocationManager->addAllocation(id2);
-		LLScriptIdentifier	*id3 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(10) - (17)].sval));	
+		LLScriptIdentifier	*id3 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-7].sval));	
 		gAllocationManager->addAllocation(id3);
-		LLScriptIdentifier	*id4 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(13) - (17)].sval));	
+		LLScriptIdentifier	*id4 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-4].sval));	
 		gAllocationManager->addAllocation(id4);
-		LLScriptIdentifier	*id5 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(16) - (17)].sval));	
+		LLScriptIdentifier	*id5 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-1].sval));	
 		gAllocationManager->addAllocation(id5);
 		(yyval.event) = new LLScriptEmailEvent(gLine, gColumn, id1, id2, id3, id4, id5);
 		gAllocationManager->addAllocation((yyval.event));
-	;}
+	}
+#line 2910 "indra_generated.y.cpp"
     break;
 
-  case 111:
-
-/* Line 1455 of yacc.c  */
-#line 1051 "indra.y"
-    {  
-		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(4) - (5)].sval));	
+  case 111: /* run_time_permissions: RUN_TIME_PERMISSIONS '(' INTEGER IDENTIFIER ')'  */
+#line 1056 "indra.y"
+        {  
+		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-1].sval));	
 		gAllocationManager->addAllocation(id1);
 		(yyval.event) = new LLScriptRTPEvent(gLine, gColumn, id1);
 		gAllocationManager->addAllocation((yyval.event));
-	;}
+	}
+#line 2921 "indra_generated.y.cpp"
     break;
 
-  case 112:
-
-/* Line 1455 of yacc.c  */
-#line 1061 "indra.y"
-    {  
-		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(4) - (5)].sval));	
+  case 112: /* inventory: INVENTORY '(' INTEGER IDENTIFIER ')'  */
+#line 1066 "indra.y"
+        {  
+		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-1].sval));	
 		gAllocationManager->addAllocation(id1);
 		(yyval.event) = new LLScriptInventoryEvent(gLine, gColumn, id1);
 		gAllocationManager->addAllocation((yyval.event));
-	;}
+	}
+#line 2932 "indra_generated.y.cpp"
     break;
 
-  case 113:
-
-/* Line 1455 of yacc.c  */
-#line 1071 "indra.y"
-    {  
-		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(4) - (5)].sval));	
+  case 113: /* attach: ATTACH '(' LLKEY IDENTIFIER ')'  */
+#line 1076 "indra.y"
+        {  
+		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-1].sval));	
 		gAllocationManager->addAllocation(id1);
 		(yyval.event) = new LLScriptAttachEvent(gLine, gColumn, id1);
 		gAllocationManager->addAllocation((yyval.event));
-	;}
+	}
+#line 2943 "indra_generated.y.cpp"
     break;
 
-  case 114:
-
-/* Line 1455 of yacc.c  */
-#line 1081 "indra.y"
-    {  
-		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(4) - (8)].sval));	
+  case 114: /* dataserver: DATASERVER '(' LLKEY IDENTIFIER ',' STRING IDENTIFIER ')'  */
+#line 1086 "indra.y"
+        {  
+		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-4].sval));	
 		gAllocationManager->addAllocation(id1);
-		LLScriptIdentifier	*id2 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(7) - (8)].sval));	
+		LLScriptIdentifier	*id2 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-1].sval));	
 		gAllocationManager->addAllocation(id2);
 		(yyval.event) = new LLScriptDataserverEvent(gLine, gColumn, id1, id2);
 		gAllocationManager->addAllocation((yyval.event));
-	;}
+	}
+#line 2956 "indra_generated.y.cpp"
     break;
 
-  case 115:
-
-/* Line 1455 of yacc.c  */
-#line 1093 "indra.y"
-    {  
+  case 115: /* moving_start: MOVING_START '(' ')'  */
+#line 1098 "indra.y"
+        {  
 		(yyval.event) = new LLScriptMovingStartEvent(gLine, gColumn);
 		gAllocationManager->addAllocation((yyval.event));
-	;}
+	}
+#line 2965 "indra_generated.y.cpp"
     break;
 
-  case 116:
-
-/* Line 1455 of yacc.c  */
-#line 1101 "indra.y"
-    {  
+  case 116: /* moving_end: MOVING_END '(' ')'  */
+#line 1106 "indra.y"
+        {  
 		(yyval.event) = new LLScriptMovingEndEvent(gLine, gColumn);
 		gAllocationManager->addAllocation((yyval.event));
-	;}
+	}
+#line 2974 "indra_generated.y.cpp"
     break;
 
-  case 117:
-
-/* Line 1455 of yacc.c  */
-#line 1109 "indra.y"
-    {  
+  case 117: /* timer: TIMER '(' ')'  */
+#line 1114 "indra.y"
+        {  
 		(yyval.event) = new LLScriptTimerEvent(gLine, gColumn);
 		gAllocationManager->addAllocation((yyval.event));
-	;}
+	}
+#line 2983 "indra_generated.y.cpp"
     break;
 
-  case 118:
-
-/* Line 1455 of yacc.c  */
-#line 1117 "indra.y"
-    {  
-		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(4) - (14)].sval));	
+  case 118: /* chat: CHAT '(' INTEGER IDENTIFIER ',' STRING IDENTIFIER ',' LLKEY IDENTIFIER ',' STRING IDENTIFIER ')'  */
+#line 1122 "indra.y"
+        {  
+		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-10].sval));	
 		gAllocationManager->addAllocation(id1);
-		LLScriptIdentifier	*id2 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(7) - (14)].sval));	
+		LLScriptIdentifier	*id2 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-7].sval));	
 		gAllocationManager->addAllocation(id2);
-		LLScriptIdentifier	*id3 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(10) - (14)].sval));	
+		LLScriptIdentifier	*id3 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-4].sval));	
 		gAllocationManager->addAllocation(id3);
-		LLScriptIdentifier	*id4 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(13) - (14)].sval));	
+		LLScriptIdentifier	*id4 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-1].sval));	
 		gAllocationManager->addAllocation(id4);
 		(yyval.event) = new LLScriptChatEvent(gLine, gColumn, id1, id2, id3, id4);
 		gAllocationManager->addAllocation((yyval.event));
-	;}
+	}
+#line 3000 "indra_generated.y.cpp"
     break;
 
-  case 119:
-
-/* Line 1455 of yacc.c  */
-#line 1133 "indra.y"
-    {  
-		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(4) - (5)].sval));	
+  case 119: /* sensor: SENSOR '(' INTEGER IDENTIFIER ')'  */
+#line 1138 "indra.y"
+        {  
+		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-1].sval));	
 		gAllocationManager->addAllocation(id1);
 		(yyval.event) = new LLScriptSensorEvent(gLine, gColumn, id1);
 		gAllocationManager->addAllocation((yyval.event));
-	;}
+	}
+#line 3011 "indra_generated.y.cpp"
     break;
 
-  case 120:
-
-/* Line 1455 of yacc.c  */
-#line 1143 "indra.y"
-    {  
+  case 120: /* no_sensor: NO_SENSOR '(' ')'  */
+#line 1148 "indra.y"
+        {  
 		(yyval.event) = new LLScriptNoSensorEvent(gLine, gColumn);
 		gAllocationManager->addAllocation((yyval.event));
-	;}
+	}
+#line 3020 "indra_generated.y.cpp"
     break;
 
-  case 121:
-
-/* Line 1455 of yacc.c  */
-#line 1151 "indra.y"
-    {  
-		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(4) - (11)].sval));	
+  case 121: /* control: CONTROL '(' LLKEY IDENTIFIER ',' INTEGER IDENTIFIER ',' INTEGER IDENTIFIER ')'  */
+#line 1156 "indra.y"
+        {  
+		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-7].sval));	
 		gAllocationManager->addAllocation(id1);
-		LLScriptIdentifier	*id2 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(7) - (11)].sval));	
+		LLScriptIdentifier	*id2 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-4].sval));	
 		gAllocationManager->addAllocation(id2);
-		LLScriptIdentifier	*id3 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(10) - (11)].sval));	
+		LLScriptIdentifier	*id3 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-1].sval));	
 		gAllocationManager->addAllocation(id3);
 		(yyval.event) = new LLScriptControlEvent(gLine, gColumn, id1, id2, id3);
 		gAllocationManager->addAllocation((yyval.event));
-	;}
+	}
+#line 3035 "indra_generated.y.cpp"
     break;
 
-  case 122:
-
-/* Line 1455 of yacc.c  */
-#line 1165 "indra.y"
-    {  
-		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(4) - (5)].sval));	
+  case 122: /* rez: REZ '(' INTEGER IDENTIFIER ')'  */
+#line 1170 "indra.y"
+        {  
+		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-1].sval));	
 		gAllocationManager->addAllocation(id1);
 		(yyval.event) = new LLScriptRezEvent(gLine, gColumn, id1);
 		gAllocationManager->addAllocation((yyval.event));
-	;}
+	}
+#line 3046 "indra_generated.y.cpp"
     break;
 
-  case 123:
-
-/* Line 1455 of yacc.c  */
-#line 1175 "indra.y"
-    {  
-		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(4) - (5)].sval));	
+  case 123: /* object_rez: OBJECT_REZ '(' LLKEY IDENTIFIER ')'  */
+#line 1180 "indra.y"
+        {  
+		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-1].sval));	
 		gAllocationManager->addAllocation(id1);
 		(yyval.event) = new LLScriptObjectRezEvent(gLine, gColumn, id1);
 		gAllocationManager->addAllocation((yyval.event));
-	;}
+	}
+#line 3057 "indra_generated.y.cpp"
     break;
 
-  case 124:
-
-/* Line 1455 of yacc.c  */
-#line 1185 "indra.y"
-    {  
-		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(4) - (14)].sval));	
+  case 124: /* link_message: LINK_MESSAGE '(' INTEGER IDENTIFIER ',' INTEGER IDENTIFIER ',' STRING IDENTIFIER ',' LLKEY IDENTIFIER ')'  */
+#line 1190 "indra.y"
+        {  
+		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-10].sval));	
 		gAllocationManager->addAllocation(id1);
-		LLScriptIdentifier	*id2 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(7) - (14)].sval));	
+		LLScriptIdentifier	*id2 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-7].sval));	
 		gAllocationManager->addAllocation(id2);
-		LLScriptIdentifier	*id3 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(10) - (14)].sval));	
+		LLScriptIdentifier	*id3 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-4].sval));	
 		gAllocationManager->addAllocation(id3);
-		LLScriptIdentifier	*id4 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(13) - (14)].sval));	
+		LLScriptIdentifier	*id4 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-1].sval));	
 		gAllocationManager->addAllocation(id4);
 		(yyval.event) = new LLScriptLinkMessageEvent(gLine, gColumn, id1, id2, id3, id4);
 		gAllocationManager->addAllocation((yyval.event));
-	;}
+	}
+#line 3074 "indra_generated.y.cpp"
     break;
 
-  case 125:
-
-/* Line 1455 of yacc.c  */
-#line 1201 "indra.y"
-    {  
-		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(4) - (20)].sval));	
+  case 125: /* remote_data: REMOTE_DATA '(' INTEGER IDENTIFIER ',' LLKEY IDENTIFIER ',' LLKEY IDENTIFIER ',' STRING IDENTIFIER ',' INTEGER IDENTIFIER ',' STRING IDENTIFIER ')'  */
+#line 1206 "indra.y"
+        {  
+		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-16].sval));	
 		gAllocationManager->addAllocation(id1);
-		LLScriptIdentifier	*id2 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(7) - (20)].sval));	
+		LLScriptIdentifier	*id2 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-13].sval));	
 		gAllocationManager->addAllocation(id2);
-		LLScriptIdentifier	*id3 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(10) - (20)].sval));	
+		LLScriptIdentifier	*id3 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-10].sval));	
 		gAllocationManager->addAllocation(id3);
-		LLScriptIdentifier	*id4 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(13) - (20)].sval));	
+		LLScriptIdentifier	*id4 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-7].sval));	
 		gAllocationManager->addAllocation(id4);
-		LLScriptIdentifier	*id5 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(16) - (20)].sval));	
+		LLScriptIdentifier	*id5 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-4].sval));	
 		gAllocationManager->addAllocation(id4);
-		LLScriptIdentifier	*id6 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(19) - (20)].sval));	
+		LLScriptIdentifier	*id6 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-1].sval));	
 		gAllocationManager->addAllocation(id4);
 		(yyval.event) = new LLScriptRemoteEvent(gLine, gColumn, id1, id2, id3, id4, id5, id6);
 		gAllocationManager->addAllocation((yyval.event));
-	;}
+	}
+#line 3095 "indra_generated.y.cpp"
     break;
 
-  case 126:
-
-/* Line 1455 of yacc.c  */
-#line 1221 "indra.y"
-    {  
-		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(4) - (14)].sval));	
+  case 126: /* http_response: HTTP_RESPONSE '(' LLKEY IDENTIFIER ',' INTEGER IDENTIFIER ',' LIST IDENTIFIER ',' STRING IDENTIFIER ')'  */
+#line 1226 "indra.y"
+        {  
+		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-10].sval));	
 		gAllocationManager->addAllocation(id1);
-		LLScriptIdentifier	*id2 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(7) - (14)].sval));	
+		LLScriptIdentifier	*id2 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-7].sval));	
 		gAllocationManager->addAllocation(id2);
-		LLScriptIdentifier	*id3 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(10) - (14)].sval));	
+		LLScriptIdentifier	*id3 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-4].sval));	
 		gAllocationManager->addAllocation(id3);
-		LLScriptIdentifier	*id4 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(13) - (14)].sval));	
+		LLScriptIdentifier	*id4 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-1].sval));	
 		gAllocationManager->addAllocation(id4);
 		(yyval.event) = new LLScriptHTTPResponseEvent(gLine, gColumn, id1, id2, id3, id4);
 		gAllocationManager->addAllocation((yyval.event));
-	;}
+	}
+#line 3112 "indra_generated.y.cpp"
     break;
 
-  case 127:
-
-/* Line 1455 of yacc.c  */
-#line 1237 "indra.y"
-    {  
-		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(4) - (11)].sval));	
+  case 127: /* http_request: HTTP_REQUEST '(' LLKEY IDENTIFIER ',' STRING IDENTIFIER ',' STRING IDENTIFIER ')'  */
+#line 1242 "indra.y"
+        {  
+		LLScriptIdentifier	*id1 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-7].sval));	
 		gAllocationManager->addAllocation(id1);
-		LLScriptIdentifier	*id2 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(7) - (11)].sval));	
+		LLScriptIdentifier	*id2 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-4].sval));	
 		gAllocationManager->addAllocation(id2);
-		LLScriptIdentifier	*id3 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(10) - (11)].sval));	
+		LLScriptIdentifier	*id3 = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-1].sval));	
 		gAllocationManager->addAllocation(id3);
 		(yyval.event) = new LLScriptHTTPRequestEvent(gLine, gColumn, id1, id2, id3);
 		gAllocationManager->addAllocation((yyval.event));
-	;}
+	}
+#line 3127 "indra_generated.y.cpp"
     break;
 
-  case 128:
-
-/* Line 1455 of yacc.c  */
-#line 1251 "indra.y"
-    {  
+  case 128: /* compound_statement: '{' '}'  */
+#line 1256 "indra.y"
+        {  
 		(yyval.statement) = new LLScriptCompoundStatement(gLine, gColumn, NULL);
 		gAllocationManager->addAllocation((yyval.statement));
-	;}
+	}
+#line 3136 "indra_generated.y.cpp"
     break;
 
-  case 129:
-
-/* Line 1455 of yacc.c  */
-#line 1256 "indra.y"
-    {  
-		(yyval.statement) = new LLScriptCompoundStatement(gLine, gColumn, (yyvsp[(2) - (3)].statement));
+  case 129: /* compound_statement: '{' statements '}'  */
+#line 1261 "indra.y"
+        {  
+		(yyval.statement) = new LLScriptCompoundStatement(gLine, gColumn, (yyvsp[-1].statement));
 		gAllocationManager->addAllocation((yyval.statement));
-	;}
+	}
+#line 3145 "indra_generated.y.cpp"
     break;
 
-  case 130:
-
-/* Line 1455 of yacc.c  */
-#line 1264 "indra.y"
-    {  
-		(yyval.statement) = (yyvsp[(1) - (1)].statement);
-	;}
+  case 130: /* statements: statement  */
+#line 1269 "indra.y"
+        {  
+		(yyval.statement) = (yyvsp[0].statement);
+	}
+#line 3153 "indra_generated.y.cpp"
     break;
 
-  case 131:
-
-/* Line 1455 of yacc.c  */
-#line 1268 "indra.y"
-    {  
-		(yyval.statement) = new LLScriptStatementSequence(gLine, gColumn, (yyvsp[(1) - (2)].statement), (yyvsp[(2) - (2)].statement));
+  case 131: /* statements: statements statement  */
+#line 1273 "indra.y"
+        {  
+		(yyval.statement) = new LLScriptStatementSequence(gLine, gColumn, (yyvsp[-1].statement), (yyvsp[0].statement));
 		gAllocationManager->addAllocation((yyval.statement));
-	;}
+	}
+#line 3162 "indra_generated.y.cpp"
     break;
 
-  case 132:
-
-/* Line 1455 of yacc.c  */
-#line 1276 "indra.y"
-    {  
+  case 132: /* statement: ';'  */
+#line 1281 "indra.y"
+        {  
 		(yyval.statement) = new LLScriptNOOP(gLine, gColumn);
 		gAllocationManager->addAllocation((yyval.statement));
-	;}
+	}
+#line 3171 "indra_generated.y.cpp"
     break;
 
-  case 133:
-
-/* Line 1455 of yacc.c  */
-#line 1281 "indra.y"
-    {  
-		LLScriptIdentifier	*id = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(2) - (3)].sval));	
+  case 133: /* statement: STATE IDENTIFIER ';'  */
+#line 1286 "indra.y"
+        {  
+		LLScriptIdentifier	*id = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-1].sval));	
 		gAllocationManager->addAllocation(id);
 		(yyval.statement) = new LLScriptStateChange(gLine, gColumn, id);
 		gAllocationManager->addAllocation((yyval.statement));
-	;}
+	}
+#line 3182 "indra_generated.y.cpp"
     break;
 
-  case 134:
-
-/* Line 1455 of yacc.c  */
-#line 1288 "indra.y"
-    {  
-		LLScriptIdentifier	*id = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(2) - (3)].sval));	
+  case 134: /* statement: STATE STATE_DEFAULT ';'  */
+#line 1293 "indra.y"
+        {  
+		LLScriptIdentifier	*id = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-1].sval));	
 		gAllocationManager->addAllocation(id);
 		(yyval.statement) = new LLScriptStateChange(gLine, gColumn, id);
 		gAllocationManager->addAllocation((yyval.statement));
-	;}
+	}
+#line 3193 "indra_generated.y.cpp"
     break;
 
-  case 135:
-
-/* Line 1455 of yacc.c  */
-#line 1295 "indra.y"
-    {  
-		LLScriptIdentifier	*id = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(2) - (3)].sval));	
+  case 135: /* statement: JUMP IDENTIFIER ';'  */
+#line 1300 "indra.y"
+        {  
+		LLScriptIdentifier	*id = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-1].sval));	
 		gAllocationManager->addAllocation(id);
 		(yyval.statement) = new LLScriptJump(gLine, gColumn, id);
 		gAllocationManager->addAllocation((yyval.statement));
-	;}
+	}
+#line 3204 "indra_generated.y.cpp"
     break;
 
-  case 136:
-
-/* Line 1455 of yacc.c  */
-#line 1302 "indra.y"
-    {  
-		LLScriptIdentifier	*id = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(2) - (3)].sval));	
+  case 136: /* statement: '@' IDENTIFIER ';'  */
+#line 1307 "indra.y"
+        {  
+		LLScriptIdentifier	*id = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-1].sval));	
 		gAllocationManager->addAllocation(id);
 		(yyval.statement) = new LLScriptLabel(gLine, gColumn, id);
 		gAllocationManager->addAllocation((yyval.statement));
-	;}
-    break;
-
-  case 137:
-
-/* Line 1455 of yacc.c  */
-#line 1309 "indra.y"
-    {  
-		(yyval.statement) = new LLScriptReturn(gLine, gColumn, (yyvsp[(2) - (3)].expression));
-		gAllocationManager->addAllocation((yyval.statement));
-	;}
+	}
+#line 3215 "indra_generated.y.cpp"
     break;
 
-  case 138:
-
-/* Line 1455 of yacc.c  */
+  case 137: /* statement: RETURN expression ';'  */
 #line 1314 "indra.y"
-    {  
-		(yyval.statement) = new LLScriptReturn(gLine, gColumn, NULL);
+        {  
+		(yyval.statement) = new LLScriptReturn(gLine, gColumn, (yyvsp[-1].expression));
 		gAllocationManager->addAllocation((yyval.statement));
-	;}
+	}
+#line 3224 "indra_generated.y.cpp"
     break;
 
-  case 139:
-
-/* Line 1455 of yacc.c  */
+  case 138: /* statement: RETURN ';'  */
 #line 1319 "indra.y"
-    {  
-		(yyval.statement) = new LLScriptExpressionStatement(gLine, gColumn, (yyvsp[(1) - (2)].expression));
+        {  
+		(yyval.statement) = new LLScriptReturn(gLine, gColumn, NULL);
 		gAllocationManager->addAllocation((yyval.statement));
-	;}
+	}
+#line 3233 "indra_generated.y.cpp"
     break;
 
-  case 140:
-
-/* Line 1455 of yacc.c  */
+  case 139: /* statement: expression ';'  */
 #line 1324 "indra.y"
-    {  
-		(yyval.statement) = (yyvsp[(1) - (2)].statement);
-	;}
+        {  
+		(yyval.statement) = new LLScriptExpressionStatement(gLine, gColumn, (yyvsp[-1].expression));
+		gAllocationManager->addAllocation((yyval.statement));
+	}
+#line 3242 "indra_generated.y.cpp"
     break;
 
-  case 141:
-
-/* Line 1455 of yacc.c  */
-#line 1328 "indra.y"
-    { 
-		(yyval.statement) = (yyvsp[(1) - (1)].statement);
-	;}
+  case 140: /* statement: declaration ';'  */
+#line 1329 "indra.y"
+        {  
+		(yyval.statement) = (yyvsp[-1].statement);
+	}
+#line 3250 "indra_generated.y.cpp"
     break;
 
-  case 142:
+  case 141: /* statement: compound_statement  */
+#line 1333 "indra.y"
+        { 
+		(yyval.statement) = (yyvsp[0].statement);
+	}
+#line 3258 "indra_generated.y.cpp"
+    break;
 
-/* Line 1455 of yacc.c  */
-#line 1332 "indra.y"
-    {  
-		(yyval.statement) = new LLScriptIf(gLine, gColumn, (yyvsp[(3) - (5)].expression), (yyvsp[(5) - (5)].statement));
-		(yyvsp[(5) - (5)].statement)->mAllowDeclarations = FALSE;
+  case 142: /* statement: IF '(' expression ')' statement  */
+#line 1337 "indra.y"
+        {  
+		(yyval.statement) = new LLScriptIf(gLine, gColumn, (yyvsp[-2].expression), (yyvsp[0].statement));
+		(yyvsp[0].statement)->mAllowDeclarations = FALSE;
 		gAllocationManager->addAllocation((yyval.statement));
-	;}
+	}
+#line 3268 "indra_generated.y.cpp"
     break;
 
-  case 143:
-
-/* Line 1455 of yacc.c  */
-#line 1338 "indra.y"
-    {  
-		(yyval.statement) = new LLScriptIfElse(gLine, gColumn, (yyvsp[(3) - (7)].expression), (yyvsp[(5) - (7)].statement), (yyvsp[(7) - (7)].statement));
-		(yyvsp[(5) - (7)].statement)->mAllowDeclarations = FALSE;
-		(yyvsp[(7) - (7)].statement)->mAllowDeclarations = FALSE;
+  case 143: /* statement: IF '(' expression ')' statement ELSE statement  */
+#line 1343 "indra.y"
+        {  
+		(yyval.statement) = new LLScriptIfElse(gLine, gColumn, (yyvsp[-4].expression), (yyvsp[-2].statement), (yyvsp[0].statement));
+		(yyvsp[-2].statement)->mAllowDeclarations = FALSE;
+		(yyvsp[0].statement)->mAllowDeclarations = FALSE;
 		gAllocationManager->addAllocation((yyval.statement));
-	;}
+	}
+#line 3279 "indra_generated.y.cpp"
     break;
 
-  case 144:
-
-/* Line 1455 of yacc.c  */
-#line 1345 "indra.y"
-    {  
-		(yyval.statement) = new LLScriptFor(gLine, gColumn, (yyvsp[(3) - (9)].expression), (yyvsp[(5) - (9)].expression), (yyvsp[(7) - (9)].expression), (yyvsp[(9) - (9)].statement));
-		(yyvsp[(9) - (9)].statement)->mAllowDeclarations = FALSE;
+  case 144: /* statement: FOR '(' forexpressionlist ';' expression ';' forexpressionlist ')' statement  */
+#line 1350 "indra.y"
+        {  
+		(yyval.statement) = new LLScriptFor(gLine, gColumn, (yyvsp[-6].expression), (yyvsp[-4].expression), (yyvsp[-2].expression), (yyvsp[0].statement));
+		(yyvsp[0].statement)->mAllowDeclarations = FALSE;
 		gAllocationManager->addAllocation((yyval.statement));
-	;}
+	}
+#line 3289 "indra_generated.y.cpp"
     break;
 
-  case 145:
-
-/* Line 1455 of yacc.c  */
-#line 1351 "indra.y"
-    {  
-		(yyval.statement) = new LLScriptDoWhile(gLine, gColumn, (yyvsp[(2) - (7)].statement), (yyvsp[(5) - (7)].expression));
-		(yyvsp[(2) - (7)].statement)->mAllowDeclarations = FALSE;
+  case 145: /* statement: DO statement WHILE '(' expression ')' ';'  */
+#line 1356 "indra.y"
+        {  
+		(yyval.statement) = new LLScriptDoWhile(gLine, gColumn, (yyvsp[-5].statement), (yyvsp[-2].expression));
+		(yyvsp[-5].statement)->mAllowDeclarations = FALSE;
 		gAllocationManager->addAllocation((yyval.statement));
-	;}
+	}
+#line 3299 "indra_generated.y.cpp"
     break;
 
-  case 146:
-
-/* Line 1455 of yacc.c  */
-#line 1357 "indra.y"
-    {  
-		(yyval.statement) = new LLScriptWhile(gLine, gColumn, (yyvsp[(3) - (5)].expression), (yyvsp[(5) - (5)].statement));
-		(yyvsp[(5) - (5)].statement)->mAllowDeclarations = FALSE;
+  case 146: /* statement: WHILE '(' expression ')' statement  */
+#line 1362 "indra.y"
+        {  
+		(yyval.statement) = new LLScriptWhile(gLine, gColumn, (yyvsp[-2].expression), (yyvsp[0].statement));
+		(yyvsp[0].statement)->mAllowDeclarations = FALSE;
 		gAllocationManager->addAllocation((yyval.statement));
-	;}
+	}
+#line 3309 "indra_generated.y.cpp"
     break;
 
-  case 147:
-
-/* Line 1455 of yacc.c  */
-#line 1366 "indra.y"
-    {  
-		LLScriptIdentifier	*id = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(2) - (2)].sval));	
+  case 147: /* declaration: typename IDENTIFIER  */
+#line 1371 "indra.y"
+        {  
+		LLScriptIdentifier	*id = new LLScriptIdentifier(gLine, gColumn, (yyvsp[0].sval));	
 		gAllocationManager->addAllocation(id);
-		(yyval.statement) = new LLScriptDeclaration(gLine, gColumn, (yyvsp[(1) - (2)].type), id, NULL);
+		(yyval.statement) = new LLScriptDeclaration(gLine, gColumn, (yyvsp[-1].type), id, NULL);
 		gAllocationManager->addAllocation((yyval.statement));
-	;}
+	}
+#line 3320 "indra_generated.y.cpp"
     break;
 
-  case 148:
-
-/* Line 1455 of yacc.c  */
-#line 1373 "indra.y"
-    {  
-		LLScriptIdentifier	*id = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(2) - (4)].sval));	
+  case 148: /* declaration: typename IDENTIFIER '=' expression  */
+#line 1378 "indra.y"
+        {  
+		LLScriptIdentifier	*id = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-2].sval));	
 		gAllocationManager->addAllocation(id);
-		(yyval.statement) = new LLScriptDeclaration(gLine, gColumn, (yyvsp[(1) - (4)].type), id, (yyvsp[(4) - (4)].expression));
+		(yyval.statement) = new LLScriptDeclaration(gLine, gColumn, (yyvsp[-3].type), id, (yyvsp[0].expression));
 		gAllocationManager->addAllocation((yyval.statement));
-	;}
+	}
+#line 3331 "indra_generated.y.cpp"
     break;
 
-  case 149:
-
-/* Line 1455 of yacc.c  */
-#line 1383 "indra.y"
-    {  
+  case 149: /* forexpressionlist: %empty  */
+#line 1388 "indra.y"
+        {  
 		(yyval.expression) = NULL;
-	;}
+	}
+#line 3339 "indra_generated.y.cpp"
     break;
 
-  case 150:
-
-/* Line 1455 of yacc.c  */
-#line 1387 "indra.y"
-    {
-		(yyval.expression) = (yyvsp[(1) - (1)].expression);
-	;}
+  case 150: /* forexpressionlist: nextforexpressionlist  */
+#line 1392 "indra.y"
+        {
+		(yyval.expression) = (yyvsp[0].expression);
+	}
+#line 3347 "indra_generated.y.cpp"
     break;
 
-  case 151:
-
-/* Line 1455 of yacc.c  */
-#line 1394 "indra.y"
-    {  
-		(yyval.expression) = new LLScriptForExpressionList(gLine, gColumn, (yyvsp[(1) - (1)].expression), NULL);
+  case 151: /* nextforexpressionlist: expression  */
+#line 1399 "indra.y"
+        {  
+		(yyval.expression) = new LLScriptForExpressionList(gLine, gColumn, (yyvsp[0].expression), NULL);
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3356 "indra_generated.y.cpp"
     break;
 
-  case 152:
-
-/* Line 1455 of yacc.c  */
-#line 1399 "indra.y"
-    {
-		(yyval.expression) = new LLScriptForExpressionList(gLine, gColumn, (yyvsp[(1) - (3)].expression), (yyvsp[(3) - (3)].expression));
+  case 152: /* nextforexpressionlist: expression ',' nextforexpressionlist  */
+#line 1404 "indra.y"
+        {
+		(yyval.expression) = new LLScriptForExpressionList(gLine, gColumn, (yyvsp[-2].expression), (yyvsp[0].expression));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3365 "indra_generated.y.cpp"
     break;
 
-  case 153:
-
-/* Line 1455 of yacc.c  */
-#line 1407 "indra.y"
-    {  
+  case 153: /* funcexpressionlist: %empty  */
+#line 1412 "indra.y"
+        {  
 		(yyval.expression) = NULL;
-	;}
+	}
+#line 3373 "indra_generated.y.cpp"
     break;
 
-  case 154:
-
-/* Line 1455 of yacc.c  */
-#line 1411 "indra.y"
-    {
-		(yyval.expression) = (yyvsp[(1) - (1)].expression);
-	;}
+  case 154: /* funcexpressionlist: nextfuncexpressionlist  */
+#line 1416 "indra.y"
+        {
+		(yyval.expression) = (yyvsp[0].expression);
+	}
+#line 3381 "indra_generated.y.cpp"
     break;
 
-  case 155:
-
-/* Line 1455 of yacc.c  */
-#line 1418 "indra.y"
-    {  
-		(yyval.expression) = new LLScriptFuncExpressionList(gLine, gColumn, (yyvsp[(1) - (1)].expression), NULL);
+  case 155: /* nextfuncexpressionlist: expression  */
+#line 1423 "indra.y"
+        {  
+		(yyval.expression) = new LLScriptFuncExpressionList(gLine, gColumn, (yyvsp[0].expression), NULL);
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3390 "indra_generated.y.cpp"
     break;
 
-  case 156:
-
-/* Line 1455 of yacc.c  */
-#line 1423 "indra.y"
-    {
-		(yyval.expression) = new LLScriptFuncExpressionList(gLine, gColumn, (yyvsp[(1) - (3)].expression), (yyvsp[(3) - (3)].expression));
+  case 156: /* nextfuncexpressionlist: expression ',' nextfuncexpressionlist  */
+#line 1428 "indra.y"
+        {
+		(yyval.expression) = new LLScriptFuncExpressionList(gLine, gColumn, (yyvsp[-2].expression), (yyvsp[0].expression));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3399 "indra_generated.y.cpp"
     break;
 
-  case 157:
-
-/* Line 1455 of yacc.c  */
-#line 1431 "indra.y"
-    {  
+  case 157: /* listexpressionlist: %empty  */
+#line 1436 "indra.y"
+        {  
 		(yyval.expression) = NULL;
-	;}
-    break;
-
-  case 158:
-
-/* Line 1455 of yacc.c  */
-#line 1435 "indra.y"
-    {
-		(yyval.expression) = (yyvsp[(1) - (1)].expression);
-	;}
+	}
+#line 3407 "indra_generated.y.cpp"
     break;
 
-  case 159:
-
-/* Line 1455 of yacc.c  */
-#line 1442 "indra.y"
-    {  
-		(yyval.expression) = new LLScriptListExpressionList(gLine, gColumn, (yyvsp[(1) - (1)].expression), NULL);
-		gAllocationManager->addAllocation((yyval.expression));
-	;}
+  case 158: /* listexpressionlist: nextlistexpressionlist  */
+#line 1440 "indra.y"
+        {
+		(yyval.expression) = (yyvsp[0].expression);
+	}
+#line 3415 "indra_generated.y.cpp"
     break;
 
-  case 160:
-
-/* Line 1455 of yacc.c  */
+  case 159: /* nextlistexpressionlist: expression  */
 #line 1447 "indra.y"
-    {
-		(yyval.expression) = new LLScriptListExpressionList(gLine, gColumn, (yyvsp[(1) - (3)].expression), (yyvsp[(3) - (3)].expression));
+        {  
+		(yyval.expression) = new LLScriptListExpressionList(gLine, gColumn, (yyvsp[0].expression), NULL);
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
-    break;
-
-  case 161:
-
-/* Line 1455 of yacc.c  */
-#line 1455 "indra.y"
-    {  
-		(yyval.expression) = (yyvsp[(1) - (1)].expression);
-	;}
+	}
+#line 3424 "indra_generated.y.cpp"
     break;
 
-  case 162:
-
-/* Line 1455 of yacc.c  */
-#line 1459 "indra.y"
-    {  
-		(yyval.expression) = new LLScriptAssignment(gLine, gColumn, (yyvsp[(1) - (3)].expression), (yyvsp[(3) - (3)].expression));
+  case 160: /* nextlistexpressionlist: expression ',' nextlistexpressionlist  */
+#line 1452 "indra.y"
+        {
+		(yyval.expression) = new LLScriptListExpressionList(gLine, gColumn, (yyvsp[-2].expression), (yyvsp[0].expression));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3433 "indra_generated.y.cpp"
     break;
 
-  case 163:
+  case 161: /* expression: unaryexpression  */
+#line 1460 "indra.y"
+        {  
+		(yyval.expression) = (yyvsp[0].expression);
+	}
+#line 3441 "indra_generated.y.cpp"
+    break;
 
-/* Line 1455 of yacc.c  */
+  case 162: /* expression: lvalue '=' expression  */
 #line 1464 "indra.y"
-    {  
-		(yyval.expression) = new LLScriptAddAssignment(gLine, gColumn, (yyvsp[(1) - (3)].expression), (yyvsp[(3) - (3)].expression));
+        {  
+		(yyval.expression) = new LLScriptAssignment(gLine, gColumn, (yyvsp[-2].expression), (yyvsp[0].expression));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3450 "indra_generated.y.cpp"
     break;
 
-  case 164:
-
-/* Line 1455 of yacc.c  */
+  case 163: /* expression: lvalue ADD_ASSIGN expression  */
 #line 1469 "indra.y"
-    {  
-		(yyval.expression) = new LLScriptSubAssignment(gLine, gColumn, (yyvsp[(1) - (3)].expression), (yyvsp[(3) - (3)].expression));
+        {  
+		(yyval.expression) = new LLScriptAddAssignment(gLine, gColumn, (yyvsp[-2].expression), (yyvsp[0].expression));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3459 "indra_generated.y.cpp"
     break;
 
-  case 165:
-
-/* Line 1455 of yacc.c  */
+  case 164: /* expression: lvalue SUB_ASSIGN expression  */
 #line 1474 "indra.y"
-    {  
-		(yyval.expression) = new LLScriptMulAssignment(gLine, gColumn, (yyvsp[(1) - (3)].expression), (yyvsp[(3) - (3)].expression));
+        {  
+		(yyval.expression) = new LLScriptSubAssignment(gLine, gColumn, (yyvsp[-2].expression), (yyvsp[0].expression));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3468 "indra_generated.y.cpp"
     break;
 
-  case 166:
-
-/* Line 1455 of yacc.c  */
+  case 165: /* expression: lvalue MUL_ASSIGN expression  */
 #line 1479 "indra.y"
-    {  
-		(yyval.expression) = new LLScriptDivAssignment(gLine, gColumn, (yyvsp[(1) - (3)].expression), (yyvsp[(3) - (3)].expression));
+        {  
+		(yyval.expression) = new LLScriptMulAssignment(gLine, gColumn, (yyvsp[-2].expression), (yyvsp[0].expression));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3477 "indra_generated.y.cpp"
     break;
 
-  case 167:
-
-/* Line 1455 of yacc.c  */
+  case 166: /* expression: lvalue DIV_ASSIGN expression  */
 #line 1484 "indra.y"
-    {  
-		(yyval.expression) = new LLScriptModAssignment(gLine, gColumn, (yyvsp[(1) - (3)].expression), (yyvsp[(3) - (3)].expression));
+        {  
+		(yyval.expression) = new LLScriptDivAssignment(gLine, gColumn, (yyvsp[-2].expression), (yyvsp[0].expression));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3486 "indra_generated.y.cpp"
     break;
 
-  case 168:
-
-/* Line 1455 of yacc.c  */
+  case 167: /* expression: lvalue MOD_ASSIGN expression  */
 #line 1489 "indra.y"
-    {  
-		(yyval.expression) = new LLScriptEquality(gLine, gColumn, (yyvsp[(1) - (3)].expression), (yyvsp[(3) - (3)].expression));
+        {  
+		(yyval.expression) = new LLScriptModAssignment(gLine, gColumn, (yyvsp[-2].expression), (yyvsp[0].expression));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3495 "indra_generated.y.cpp"
     break;
 
-  case 169:
-
-/* Line 1455 of yacc.c  */
+  case 168: /* expression: expression EQ expression  */
 #line 1494 "indra.y"
-    {  
-		(yyval.expression) = new LLScriptNotEquals(gLine, gColumn, (yyvsp[(1) - (3)].expression), (yyvsp[(3) - (3)].expression));
+        {  
+		(yyval.expression) = new LLScriptEquality(gLine, gColumn, (yyvsp[-2].expression), (yyvsp[0].expression));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3504 "indra_generated.y.cpp"
     break;
 
-  case 170:
-
-/* Line 1455 of yacc.c  */
+  case 169: /* expression: expression NEQ expression  */
 #line 1499 "indra.y"
-    {  
-		(yyval.expression) = new LLScriptLessEquals(gLine, gColumn, (yyvsp[(1) - (3)].expression), (yyvsp[(3) - (3)].expression));
+        {  
+		(yyval.expression) = new LLScriptNotEquals(gLine, gColumn, (yyvsp[-2].expression), (yyvsp[0].expression));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3513 "indra_generated.y.cpp"
     break;
 
-  case 171:
-
-/* Line 1455 of yacc.c  */
+  case 170: /* expression: expression LEQ expression  */
 #line 1504 "indra.y"
-    {  
-		(yyval.expression) = new LLScriptGreaterEquals(gLine, gColumn, (yyvsp[(1) - (3)].expression), (yyvsp[(3) - (3)].expression));
+        {  
+		(yyval.expression) = new LLScriptLessEquals(gLine, gColumn, (yyvsp[-2].expression), (yyvsp[0].expression));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3522 "indra_generated.y.cpp"
     break;
 
-  case 172:
-
-/* Line 1455 of yacc.c  */
+  case 171: /* expression: expression GEQ expression  */
 #line 1509 "indra.y"
-    {  
-		(yyval.expression) = new LLScriptLessThan(gLine, gColumn, (yyvsp[(1) - (3)].expression), (yyvsp[(3) - (3)].expression));
+        {  
+		(yyval.expression) = new LLScriptGreaterEquals(gLine, gColumn, (yyvsp[-2].expression), (yyvsp[0].expression));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3531 "indra_generated.y.cpp"
     break;
 
-  case 173:
-
-/* Line 1455 of yacc.c  */
+  case 172: /* expression: expression '<' expression  */
 #line 1514 "indra.y"
-    {  
-		(yyval.expression) = new LLScriptGreaterThan(gLine, gColumn, (yyvsp[(1) - (3)].expression), (yyvsp[(3) - (3)].expression));
+        {  
+		(yyval.expression) = new LLScriptLessThan(gLine, gColumn, (yyvsp[-2].expression), (yyvsp[0].expression));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3540 "indra_generated.y.cpp"
     break;
 
-  case 174:
-
-/* Line 1455 of yacc.c  */
+  case 173: /* expression: expression '>' expression  */
 #line 1519 "indra.y"
-    {  
-		(yyval.expression) = new LLScriptPlus(gLine, gColumn, (yyvsp[(1) - (3)].expression), (yyvsp[(3) - (3)].expression));
+        {  
+		(yyval.expression) = new LLScriptGreaterThan(gLine, gColumn, (yyvsp[-2].expression), (yyvsp[0].expression));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3549 "indra_generated.y.cpp"
     break;
 
-  case 175:
-
-/* Line 1455 of yacc.c  */
+  case 174: /* expression: expression '+' expression  */
 #line 1524 "indra.y"
-    {  
-		(yyval.expression) = new LLScriptMinus(gLine, gColumn, (yyvsp[(1) - (3)].expression), (yyvsp[(3) - (3)].expression));
+        {  
+		(yyval.expression) = new LLScriptPlus(gLine, gColumn, (yyvsp[-2].expression), (yyvsp[0].expression));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3558 "indra_generated.y.cpp"
     break;
 
-  case 176:
-
-/* Line 1455 of yacc.c  */
+  case 175: /* expression: expression '-' expression  */
 #line 1529 "indra.y"
-    {  
-		(yyval.expression) = new LLScriptTimes(gLine, gColumn, (yyvsp[(1) - (3)].expression), (yyvsp[(3) - (3)].expression));
+        {  
+		(yyval.expression) = new LLScriptMinus(gLine, gColumn, (yyvsp[-2].expression), (yyvsp[0].expression));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3567 "indra_generated.y.cpp"
     break;
 
-  case 177:
-
-/* Line 1455 of yacc.c  */
+  case 176: /* expression: expression '*' expression  */
 #line 1534 "indra.y"
-    {  
-		(yyval.expression) = new LLScriptDivide(gLine, gColumn, (yyvsp[(1) - (3)].expression), (yyvsp[(3) - (3)].expression));
+        {  
+		(yyval.expression) = new LLScriptTimes(gLine, gColumn, (yyvsp[-2].expression), (yyvsp[0].expression));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3576 "indra_generated.y.cpp"
     break;
 
-  case 178:
-
-/* Line 1455 of yacc.c  */
+  case 177: /* expression: expression '/' expression  */
 #line 1539 "indra.y"
-    {  
-		(yyval.expression) = new LLScriptMod(gLine, gColumn, (yyvsp[(1) - (3)].expression), (yyvsp[(3) - (3)].expression));
+        {  
+		(yyval.expression) = new LLScriptDivide(gLine, gColumn, (yyvsp[-2].expression), (yyvsp[0].expression));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3585 "indra_generated.y.cpp"
     break;
 
-  case 179:
-
-/* Line 1455 of yacc.c  */
+  case 178: /* expression: expression '%' expression  */
 #line 1544 "indra.y"
-    {  
-		(yyval.expression) = new LLScriptBitAnd(gLine, gColumn, (yyvsp[(1) - (3)].expression), (yyvsp[(3) - (3)].expression));
+        {  
+		(yyval.expression) = new LLScriptMod(gLine, gColumn, (yyvsp[-2].expression), (yyvsp[0].expression));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3594 "indra_generated.y.cpp"
     break;
 
-  case 180:
-
-/* Line 1455 of yacc.c  */
+  case 179: /* expression: expression '&' expression  */
 #line 1549 "indra.y"
-    {  
-		(yyval.expression) = new LLScriptBitOr(gLine, gColumn, (yyvsp[(1) - (3)].expression), (yyvsp[(3) - (3)].expression));
+        {  
+		(yyval.expression) = new LLScriptBitAnd(gLine, gColumn, (yyvsp[-2].expression), (yyvsp[0].expression));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3603 "indra_generated.y.cpp"
     break;
 
-  case 181:
-
-/* Line 1455 of yacc.c  */
+  case 180: /* expression: expression '|' expression  */
 #line 1554 "indra.y"
-    {  
-		(yyval.expression) = new LLScriptBitXor(gLine, gColumn, (yyvsp[(1) - (3)].expression), (yyvsp[(3) - (3)].expression));
+        {  
+		(yyval.expression) = new LLScriptBitOr(gLine, gColumn, (yyvsp[-2].expression), (yyvsp[0].expression));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3612 "indra_generated.y.cpp"
     break;
 
-  case 182:
-
-/* Line 1455 of yacc.c  */
+  case 181: /* expression: expression '^' expression  */
 #line 1559 "indra.y"
-    {  
-		(yyval.expression) = new LLScriptBooleanAnd(gLine, gColumn, (yyvsp[(1) - (3)].expression), (yyvsp[(3) - (3)].expression));
+        {  
+		(yyval.expression) = new LLScriptBitXor(gLine, gColumn, (yyvsp[-2].expression), (yyvsp[0].expression));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3621 "indra_generated.y.cpp"
     break;
 
-  case 183:
-
-/* Line 1455 of yacc.c  */
+  case 182: /* expression: expression BOOLEAN_AND expression  */
 #line 1564 "indra.y"
-    {  
-		(yyval.expression) = new LLScriptBooleanOr(gLine, gColumn, (yyvsp[(1) - (3)].expression), (yyvsp[(3) - (3)].expression));
+        {  
+		(yyval.expression) = new LLScriptBooleanAnd(gLine, gColumn, (yyvsp[-2].expression), (yyvsp[0].expression));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3630 "indra_generated.y.cpp"
     break;
 
-  case 184:
-
-/* Line 1455 of yacc.c  */
+  case 183: /* expression: expression BOOLEAN_OR expression  */
 #line 1569 "indra.y"
-    {
-		(yyval.expression) = new LLScriptShiftLeft(gLine, gColumn, (yyvsp[(1) - (3)].expression), (yyvsp[(3) - (3)].expression));
+        {  
+		(yyval.expression) = new LLScriptBooleanOr(gLine, gColumn, (yyvsp[-2].expression), (yyvsp[0].expression));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3639 "indra_generated.y.cpp"
     break;
 
-  case 185:
-
-/* Line 1455 of yacc.c  */
+  case 184: /* expression: expression SHIFT_LEFT expression  */
 #line 1574 "indra.y"
-    {
-		(yyval.expression) = new LLScriptShiftRight(gLine, gColumn, (yyvsp[(1) - (3)].expression), (yyvsp[(3) - (3)].expression));
+        {
+		(yyval.expression) = new LLScriptShiftLeft(gLine, gColumn, (yyvsp[-2].expression), (yyvsp[0].expression));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3648 "indra_generated.y.cpp"
     break;
 
-  case 186:
-
-/* Line 1455 of yacc.c  */
-#line 1582 "indra.y"
-    {  
-		(yyval.expression) = new LLScriptUnaryMinus(gLine, gColumn, (yyvsp[(2) - (2)].expression));
+  case 185: /* expression: expression SHIFT_RIGHT expression  */
+#line 1579 "indra.y"
+        {
+		(yyval.expression) = new LLScriptShiftRight(gLine, gColumn, (yyvsp[-2].expression), (yyvsp[0].expression));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3657 "indra_generated.y.cpp"
     break;
 
-  case 187:
-
-/* Line 1455 of yacc.c  */
+  case 186: /* unaryexpression: '-' expression  */
 #line 1587 "indra.y"
-    {  
-		(yyval.expression) = new LLScriptBooleanNot(gLine, gColumn, (yyvsp[(2) - (2)].expression));
+        {  
+		(yyval.expression) = new LLScriptUnaryMinus(gLine, gColumn, (yyvsp[0].expression));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3666 "indra_generated.y.cpp"
     break;
 
-  case 188:
-
-/* Line 1455 of yacc.c  */
+  case 187: /* unaryexpression: '!' expression  */
 #line 1592 "indra.y"
-    {  
-		(yyval.expression) = new LLScriptBitNot(gLine, gColumn, (yyvsp[(2) - (2)].expression));
+        {  
+		(yyval.expression) = new LLScriptBooleanNot(gLine, gColumn, (yyvsp[0].expression));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3675 "indra_generated.y.cpp"
     break;
 
-  case 189:
-
-/* Line 1455 of yacc.c  */
+  case 188: /* unaryexpression: '~' expression  */
 #line 1597 "indra.y"
-    {  
-		(yyval.expression) = new LLScriptPreIncrement(gLine, gColumn, (yyvsp[(2) - (2)].expression));
+        {  
+		(yyval.expression) = new LLScriptBitNot(gLine, gColumn, (yyvsp[0].expression));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3684 "indra_generated.y.cpp"
     break;
 
-  case 190:
-
-/* Line 1455 of yacc.c  */
+  case 189: /* unaryexpression: INC_OP lvalue  */
 #line 1602 "indra.y"
-    {  
-		(yyval.expression) = new LLScriptPreDecrement(gLine, gColumn, (yyvsp[(2) - (2)].expression));
+        {  
+		(yyval.expression) = new LLScriptPreIncrement(gLine, gColumn, (yyvsp[0].expression));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3693 "indra_generated.y.cpp"
     break;
 
-  case 191:
-
-/* Line 1455 of yacc.c  */
+  case 190: /* unaryexpression: DEC_OP lvalue  */
 #line 1607 "indra.y"
-    {
-		(yyval.expression) = (yyvsp[(1) - (1)].expression);
-	;}
+        {  
+		(yyval.expression) = new LLScriptPreDecrement(gLine, gColumn, (yyvsp[0].expression));
+		gAllocationManager->addAllocation((yyval.expression));
+	}
+#line 3702 "indra_generated.y.cpp"
     break;
 
-  case 192:
-
-/* Line 1455 of yacc.c  */
-#line 1611 "indra.y"
-    {  
-		(yyval.expression) = (yyvsp[(1) - (1)].expression);
-	;}
+  case 191: /* unaryexpression: typecast  */
+#line 1612 "indra.y"
+        {
+		(yyval.expression) = (yyvsp[0].expression);
+	}
+#line 3710 "indra_generated.y.cpp"
     break;
 
-  case 193:
-
-/* Line 1455 of yacc.c  */
-#line 1615 "indra.y"
-    {  
-		(yyval.expression) = new LLScriptParenthesis(gLine, gColumn, (yyvsp[(2) - (3)].expression));
-		gAllocationManager->addAllocation((yyval.expression));
-	;}
+  case 192: /* unaryexpression: unarypostfixexpression  */
+#line 1616 "indra.y"
+        {  
+		(yyval.expression) = (yyvsp[0].expression);
+	}
+#line 3718 "indra_generated.y.cpp"
     break;
 
-  case 194:
-
-/* Line 1455 of yacc.c  */
-#line 1623 "indra.y"
-    {
-		(yyval.expression) = new LLScriptTypeCast(gLine, gColumn, (yyvsp[(2) - (4)].type), (yyvsp[(4) - (4)].expression));
+  case 193: /* unaryexpression: '(' expression ')'  */
+#line 1620 "indra.y"
+        {  
+		(yyval.expression) = new LLScriptParenthesis(gLine, gColumn, (yyvsp[-1].expression));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3727 "indra_generated.y.cpp"
     break;
 
-  case 195:
-
-/* Line 1455 of yacc.c  */
+  case 194: /* typecast: '(' typename ')' lvalue  */
 #line 1628 "indra.y"
-    {
-		LLScriptConstantExpression *temp =  new LLScriptConstantExpression(gLine, gColumn, (yyvsp[(4) - (4)].constant));
-		gAllocationManager->addAllocation(temp);
-		(yyval.expression) = new LLScriptTypeCast(gLine, gColumn, (yyvsp[(2) - (4)].type), temp);
+        {
+		(yyval.expression) = new LLScriptTypeCast(gLine, gColumn, (yyvsp[-2].type), (yyvsp[0].expression));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3736 "indra_generated.y.cpp"
     break;
 
-  case 196:
-
-/* Line 1455 of yacc.c  */
-#line 1635 "indra.y"
-    {
-		(yyval.expression) = new LLScriptTypeCast(gLine, gColumn, (yyvsp[(2) - (4)].type), (yyvsp[(4) - (4)].expression));
+  case 195: /* typecast: '(' typename ')' constant  */
+#line 1633 "indra.y"
+        {
+		LLScriptConstantExpression *temp =  new LLScriptConstantExpression(gLine, gColumn, (yyvsp[0].constant));
+		gAllocationManager->addAllocation(temp);
+		(yyval.expression) = new LLScriptTypeCast(gLine, gColumn, (yyvsp[-2].type), temp);
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3747 "indra_generated.y.cpp"
     break;
 
-  case 197:
-
-/* Line 1455 of yacc.c  */
+  case 196: /* typecast: '(' typename ')' unarypostfixexpression  */
 #line 1640 "indra.y"
-    {
-		(yyval.expression) = new LLScriptTypeCast(gLine, gColumn, (yyvsp[(2) - (6)].type), (yyvsp[(5) - (6)].expression));
+        {
+		(yyval.expression) = new LLScriptTypeCast(gLine, gColumn, (yyvsp[-2].type), (yyvsp[0].expression));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3756 "indra_generated.y.cpp"
     break;
 
-  case 198:
-
-/* Line 1455 of yacc.c  */
-#line 1648 "indra.y"
-    {  
-		(yyval.expression) = (yyvsp[(1) - (1)].expression);
-	;}
+  case 197: /* typecast: '(' typename ')' '(' expression ')'  */
+#line 1645 "indra.y"
+        {
+		(yyval.expression) = new LLScriptTypeCast(gLine, gColumn, (yyvsp[-4].type), (yyvsp[-1].expression));
+		gAllocationManager->addAllocation((yyval.expression));
+	}
+#line 3765 "indra_generated.y.cpp"
     break;
 
-  case 199:
-
-/* Line 1455 of yacc.c  */
-#line 1652 "indra.y"
-    {
-		(yyval.expression) = (yyvsp[(1) - (1)].expression);
-	;}
+  case 198: /* unarypostfixexpression: vector_initializer  */
+#line 1653 "indra.y"
+        {  
+		(yyval.expression) = (yyvsp[0].expression);
+	}
+#line 3773 "indra_generated.y.cpp"
     break;
 
-  case 200:
-
-/* Line 1455 of yacc.c  */
-#line 1656 "indra.y"
-    {  
-		(yyval.expression) = (yyvsp[(1) - (1)].expression);
-	;}
+  case 199: /* unarypostfixexpression: quaternion_initializer  */
+#line 1657 "indra.y"
+        {
+		(yyval.expression) = (yyvsp[0].expression);
+	}
+#line 3781 "indra_generated.y.cpp"
     break;
 
-  case 201:
-
-/* Line 1455 of yacc.c  */
-#line 1660 "indra.y"
-    {  
-		(yyval.expression) = (yyvsp[(1) - (1)].expression);
-	;}
+  case 200: /* unarypostfixexpression: list_initializer  */
+#line 1661 "indra.y"
+        {  
+		(yyval.expression) = (yyvsp[0].expression);
+	}
+#line 3789 "indra_generated.y.cpp"
     break;
 
-  case 202:
-
-/* Line 1455 of yacc.c  */
-#line 1664 "indra.y"
-    {  
-		(yyval.expression) = new LLScriptPostIncrement(gLine, gColumn, (yyvsp[(1) - (2)].expression));
-		gAllocationManager->addAllocation((yyval.expression));
-	;}
+  case 201: /* unarypostfixexpression: lvalue  */
+#line 1665 "indra.y"
+        {  
+		(yyval.expression) = (yyvsp[0].expression);
+	}
+#line 3797 "indra_generated.y.cpp"
     break;
 
-  case 203:
-
-/* Line 1455 of yacc.c  */
+  case 202: /* unarypostfixexpression: lvalue INC_OP  */
 #line 1669 "indra.y"
-    {  
-		(yyval.expression) = new LLScriptPostDecrement(gLine, gColumn, (yyvsp[(1) - (2)].expression));
+        {  
+		(yyval.expression) = new LLScriptPostIncrement(gLine, gColumn, (yyvsp[-1].expression));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3806 "indra_generated.y.cpp"
     break;
 
-  case 204:
-
-/* Line 1455 of yacc.c  */
+  case 203: /* unarypostfixexpression: lvalue DEC_OP  */
 #line 1674 "indra.y"
-    {  
-		LLScriptIdentifier	*id = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(1) - (4)].sval));	
-		gAllocationManager->addAllocation(id);
-		(yyval.expression) = new LLScriptFunctionCall(gLine, gColumn, id, (yyvsp[(3) - (4)].expression));
+        {  
+		(yyval.expression) = new LLScriptPostDecrement(gLine, gColumn, (yyvsp[-1].expression));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3815 "indra_generated.y.cpp"
     break;
 
-  case 205:
-
-/* Line 1455 of yacc.c  */
-#line 1681 "indra.y"
-    {  
-		(yyval.expression) = new LLScriptPrint(gLine, gColumn, (yyvsp[(3) - (4)].expression));
+  case 204: /* unarypostfixexpression: IDENTIFIER '(' funcexpressionlist ')'  */
+#line 1679 "indra.y"
+        {  
+		LLScriptIdentifier	*id = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-3].sval));	
+		gAllocationManager->addAllocation(id);
+		(yyval.expression) = new LLScriptFunctionCall(gLine, gColumn, id, (yyvsp[-1].expression));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3826 "indra_generated.y.cpp"
     break;
 
-  case 206:
-
-/* Line 1455 of yacc.c  */
+  case 205: /* unarypostfixexpression: PRINT '(' expression ')'  */
 #line 1686 "indra.y"
-    {  
-		(yyval.expression) = new LLScriptConstantExpression(gLine, gColumn, (yyvsp[(1) - (1)].constant));
+        {  
+		(yyval.expression) = new LLScriptPrint(gLine, gColumn, (yyvsp[-1].expression));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3835 "indra_generated.y.cpp"
     break;
 
-  case 207:
-
-/* Line 1455 of yacc.c  */
-#line 1694 "indra.y"
-    {
-		(yyval.expression) = new LLScriptVectorInitializer(gLine, gColumn, (yyvsp[(2) - (7)].expression), (yyvsp[(4) - (7)].expression), (yyvsp[(6) - (7)].expression));
+  case 206: /* unarypostfixexpression: constant  */
+#line 1691 "indra.y"
+        {  
+		(yyval.expression) = new LLScriptConstantExpression(gLine, gColumn, (yyvsp[0].constant));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3844 "indra_generated.y.cpp"
     break;
 
-  case 208:
-
-/* Line 1455 of yacc.c  */
+  case 207: /* vector_initializer: '<' expression ',' expression ',' expression '>'  */
 #line 1699 "indra.y"
-    {
+        {
+		(yyval.expression) = new LLScriptVectorInitializer(gLine, gColumn, (yyvsp[-5].expression), (yyvsp[-3].expression), (yyvsp[-1].expression));
+		gAllocationManager->addAllocation((yyval.expression));
+	}
+#line 3853 "indra_generated.y.cpp"
+    break;
+
+  case 208: /* vector_initializer: ZERO_VECTOR  */
+#line 1704 "indra.y"
+        {
 		LLScriptConstantFloat *cf0 = new LLScriptConstantFloat(gLine, gColumn, 0.f);
 		gAllocationManager->addAllocation(cf0);
 		LLScriptConstantExpression *sa0 = new LLScriptConstantExpression(gLine, gColumn, cf0);
@@ -4343,14 +3869,13 @@ yyreduce:
 		gAllocationManager->addAllocation(sa2);
 		(yyval.expression) = new LLScriptVectorInitializer(gLine, gColumn, sa0, sa1, sa2);
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3874 "indra_generated.y.cpp"
     break;
 
-  case 209:
-
-/* Line 1455 of yacc.c  */
-#line 1716 "indra.y"
-    {
+  case 209: /* vector_initializer: TOUCH_INVALID_VECTOR  */
+#line 1721 "indra.y"
+        {
 		LLScriptConstantFloat *cf0 = new LLScriptConstantFloat(gLine, gColumn, 0.f);
 		gAllocationManager->addAllocation(cf0);
 		LLScriptConstantExpression *sa0 = new LLScriptConstantExpression(gLine, gColumn, cf0);
@@ -4365,14 +3890,13 @@ yyreduce:
 		gAllocationManager->addAllocation(sa2);
 		(yyval.expression) = new LLScriptVectorInitializer(gLine, gColumn, sa0, sa1, sa2);
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3895 "indra_generated.y.cpp"
     break;
 
-  case 210:
-
-/* Line 1455 of yacc.c  */
-#line 1733 "indra.y"
-    {
+  case 210: /* vector_initializer: TOUCH_INVALID_TEXCOORD  */
+#line 1738 "indra.y"
+        {
 		LLScriptConstantFloat *cf0 = new LLScriptConstantFloat(gLine, gColumn, -1.f);
 		gAllocationManager->addAllocation(cf0);
 		LLScriptConstantExpression *sa0 = new LLScriptConstantExpression(gLine, gColumn, cf0);
@@ -4387,24 +3911,22 @@ yyreduce:
 		gAllocationManager->addAllocation(sa2);
 		(yyval.expression) = new LLScriptVectorInitializer(gLine, gColumn, sa0, sa1, sa2);
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3916 "indra_generated.y.cpp"
     break;
 
-  case 211:
-
-/* Line 1455 of yacc.c  */
-#line 1753 "indra.y"
-    {
-		(yyval.expression) = new LLScriptQuaternionInitializer(gLine, gColumn, (yyvsp[(2) - (9)].expression), (yyvsp[(4) - (9)].expression), (yyvsp[(6) - (9)].expression), (yyvsp[(8) - (9)].expression));
+  case 211: /* quaternion_initializer: '<' expression ',' expression ',' expression ',' expression '>'  */
+#line 1758 "indra.y"
+        {
+		(yyval.expression) = new LLScriptQuaternionInitializer(gLine, gColumn, (yyvsp[-7].expression), (yyvsp[-5].expression), (yyvsp[-3].expression), (yyvsp[-1].expression));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3925 "indra_generated.y.cpp"
     break;
 
-  case 212:
-
-/* Line 1455 of yacc.c  */
-#line 1758 "indra.y"
-    {
+  case 212: /* quaternion_initializer: ZERO_ROTATION  */
+#line 1763 "indra.y"
+        {
 		LLScriptConstantFloat *cf0 = new LLScriptConstantFloat(gLine, gColumn, 0.f);
 		gAllocationManager->addAllocation(cf0);
 		LLScriptConstantExpression *sa0 = new LLScriptConstantExpression(gLine, gColumn, cf0);
@@ -4423,138 +3945,111 @@ yyreduce:
 		gAllocationManager->addAllocation(sa3);
 		(yyval.expression) = new LLScriptQuaternionInitializer(gLine, gColumn, sa0, sa1, sa2, sa3);
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3950 "indra_generated.y.cpp"
     break;
 
-  case 213:
-
-/* Line 1455 of yacc.c  */
-#line 1782 "indra.y"
-    {  
-		(yyval.expression) = new LLScriptListInitializer(gLine, gColumn, (yyvsp[(2) - (3)].expression));
+  case 213: /* list_initializer: '[' listexpressionlist ']'  */
+#line 1787 "indra.y"
+        {  
+		(yyval.expression) = new LLScriptListInitializer(gLine, gColumn, (yyvsp[-1].expression));
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3959 "indra_generated.y.cpp"
     break;
 
-  case 214:
-
-/* Line 1455 of yacc.c  */
-#line 1790 "indra.y"
-    {  
-		LLScriptIdentifier	*id = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(1) - (1)].sval));	
+  case 214: /* lvalue: IDENTIFIER  */
+#line 1795 "indra.y"
+        {  
+		LLScriptIdentifier	*id = new LLScriptIdentifier(gLine, gColumn, (yyvsp[0].sval));	
 		gAllocationManager->addAllocation(id);
 		(yyval.expression) = new LLScriptLValue(gLine, gColumn, id, NULL);
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3970 "indra_generated.y.cpp"
     break;
 
-  case 215:
-
-/* Line 1455 of yacc.c  */
-#line 1797 "indra.y"
-    {
-		LLScriptIdentifier	*id = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(1) - (3)].sval));	
+  case 215: /* lvalue: IDENTIFIER PERIOD IDENTIFIER  */
+#line 1802 "indra.y"
+        {
+		LLScriptIdentifier	*id = new LLScriptIdentifier(gLine, gColumn, (yyvsp[-2].sval));	
 		gAllocationManager->addAllocation(id);
-		LLScriptIdentifier	*ac = new LLScriptIdentifier(gLine, gColumn, (yyvsp[(3) - (3)].sval));	
+		LLScriptIdentifier	*ac = new LLScriptIdentifier(gLine, gColumn, (yyvsp[0].sval));	
 		gAllocationManager->addAllocation(id);
 		(yyval.expression) = new LLScriptLValue(gLine, gColumn, id, ac);
 		gAllocationManager->addAllocation((yyval.expression));
-	;}
+	}
+#line 3983 "indra_generated.y.cpp"
     break;
 
 
+#line 3987 "indra_generated.y.cpp"
 
-/* Line 1455 of yacc.c  */
-#line 4469 "indra_generated.y.cpp"
       default: break;
     }
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
 
-  /* Now `shift' the result of the reduction.  Determine what state
+  /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
 
-/*------------------------------------.
-| yyerrlab -- here on detecting error |
-`------------------------------------*/
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
 yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
       yyerror (YY_("syntax error"));
-#else
-      {
-	YYSIZE_T yysize = yysyntax_error (0, yystate, yychar);
-	if (yymsg_alloc < yysize && yymsg_alloc < YYSTACK_ALLOC_MAXIMUM)
-	  {
-	    YYSIZE_T yyalloc = 2 * yysize;
-	    if (! (yysize <= yyalloc && yyalloc <= YYSTACK_ALLOC_MAXIMUM))
-	      yyalloc = YYSTACK_ALLOC_MAXIMUM;
-	    if (yymsg != yymsgbuf)
-	      YYSTACK_FREE (yymsg);
-	    yymsg = (char *) YYSTACK_ALLOC (yyalloc);
-	    if (yymsg)
-	      yymsg_alloc = yyalloc;
-	    else
-	      {
-		yymsg = yymsgbuf;
-		yymsg_alloc = sizeof yymsgbuf;
-	      }
-	  }
-
-	if (0 < yysize && yysize <= yymsg_alloc)
-	  {
-	    (void) yysyntax_error (yymsg, yystate, yychar);
-	    yyerror (yymsg);
-	  }
-	else
-	  {
-	    yyerror (YY_("syntax error"));
-	    if (yysize != 0)
-	      goto yyexhaustedlab;
-	  }
-      }
-#endif
     }
 
-
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
-	 error, discard it.  */
+         error, discard it.  */
 
       if (yychar <= YYEOF)
-	{
-	  /* Return failure if at end of input.  */
-	  if (yychar == YYEOF)
-	    YYABORT;
-	}
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
       else
-	{
-	  yydestruct ("Error: discarding",
-		      yytoken, &yylval);
-	  yychar = YYEMPTY;
-	}
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval);
+          yychar = YYEMPTY;
+        }
     }
 
   /* Else will try to reuse lookahead token after shifting the error
@@ -4566,14 +4061,13 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
-
-  /* Do not reclaim the symbols of the rule which action triggered
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
   YYPOPSTACK (yylen);
   yylen = 0;
@@ -4586,39 +4080,42 @@ yyerrorlab:
 | yyerrlab1 -- common code for both syntax error and YYERROR.  |
 `-------------------------------------------------------------*/
 yyerrlab1:
-  yyerrstatus = 3;	/* Each real token shifted decrements this.  */
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
-      if (yyn != YYPACT_NINF)
-	{
-	  yyn += YYTERROR;
-	  if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
-	    {
-	      yyn = yytable[yyn];
-	      if (0 < yyn)
-		break;
-	    }
-	}
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
 
       /* Pop the current state because it cannot handle the error token.  */
       if (yyssp == yyss)
-	YYABORT;
+        YYABORT;
 
 
       yydestruct ("Error: popping",
-		  yystos[yystate], yyvsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
     }
 
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -4629,54 +4126,55 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
-#if !defined(yyoverflow) || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
   yyerror (YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
+
 
-yyreturn:
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
-     yydestruct ("Cleanup: discarding lookahead",
-		 yytoken, &yylval);
-  /* Do not reclaim the symbols of the rule which action triggered
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
   YYPOPSTACK (yylen);
   YY_STACK_PRINT (yyss, yyssp);
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-		  yystos[*yyssp], yyvsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
-  if (yymsg != yymsgbuf)
-    YYSTACK_FREE (yymsg);
-#endif
-  /* Make sure YYID is used.  */
-  return YYID (yyresult);
-}
-
 
+  return yyresult;
+}
 
-/* Line 1675 of yacc.c  */
-#line 1807 "indra.y"
-
+#line 1812 "indra.y"
 
@@ -1,23 +1,22 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
-/* A Bison parser, made by GNU Bison 2.4.1.  */
+/* Bison interface for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
-/* Skeleton interface for Bison's Yacc-like parsers in C
-   
-      Copyright (C) 1984, 1989, 1990, 2000, 2001, 2002, 2003, 2004, 2005, 2006
-   Free Software Foundation, Inc.
-   
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
    the Free Software Foundation, either version 3 of the License, or
    (at your option) any later version.
-   
+
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
    GNU General Public License for more details.
-   
+
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -28,108 +27,122 @@
    special exception, which will cause the skeleton and the resulting
    Bison output files to be licensed under the GNU General Public
    License without this special exception.
-   
+
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+#ifndef YY_YY_INDRA_GENERATED_Y_HPP_INCLUDED
+# define YY_YY_INDRA_GENERATED_Y_HPP_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 0
+#endif
+#if YYDEBUG
+extern int yydebug;
+#endif
 
-/* Tokens.  */
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     INTEGER = 258,
-     FLOAT_TYPE = 259,
-     STRING = 260,
-     LLKEY = 261,
-     VECTOR = 262,
-     QUATERNION = 263,
-     LIST = 264,
-     STATE = 265,
-     EVENT = 266,
-     JUMP = 267,
-     RETURN = 268,
-     STATE_ENTRY = 269,
-     STATE_EXIT = 270,
-     TOUCH_START = 271,
-     TOUCH = 272,
-     TOUCH_END = 273,
-     COLLISION_START = 274,
-     COLLISION = 275,
-     COLLISION_END = 276,
-     LAND_COLLISION_START = 277,
-     LAND_COLLISION = 278,
-     LAND_COLLISION_END = 279,
-     TIMER = 280,
-     CHAT = 281,
-     SENSOR = 282,
-     NO_SENSOR = 283,
-     CONTROL = 284,
-     AT_TARGET = 285,
-     NOT_AT_TARGET = 286,
-     AT_ROT_TARGET = 287,
-     NOT_AT_ROT_TARGET = 288,
-     MONEY = 289,
-     EMAIL = 290,
-     RUN_TIME_PERMISSIONS = 291,
-     INVENTORY = 292,
-     ATTACH = 293,
-     DATASERVER = 294,
-     MOVING_START = 295,
-     MOVING_END = 296,
-     REZ = 297,
-     OBJECT_REZ = 298,
-     LINK_MESSAGE = 299,
-     REMOTE_DATA = 300,
-     HTTP_RESPONSE = 301,
-     HTTP_REQUEST = 302,
-     IDENTIFIER = 303,
-     STATE_DEFAULT = 304,
-     INTEGER_CONSTANT = 305,
-     INTEGER_TRUE = 306,
-     INTEGER_FALSE = 307,
-     FP_CONSTANT = 308,
-     STRING_CONSTANT = 309,
-     INC_OP = 310,
-     DEC_OP = 311,
-     ADD_ASSIGN = 312,
-     SUB_ASSIGN = 313,
-     MUL_ASSIGN = 314,
-     DIV_ASSIGN = 315,
-     MOD_ASSIGN = 316,
-     EQ = 317,
-     NEQ = 318,
-     GEQ = 319,
-     LEQ = 320,
-     BOOLEAN_AND = 321,
-     BOOLEAN_OR = 322,
-     SHIFT_LEFT = 323,
-     SHIFT_RIGHT = 324,
-     IF = 325,
-     ELSE = 326,
-     FOR = 327,
-     DO = 328,
-     WHILE = 329,
-     PRINT = 330,
-     PERIOD = 331,
-     ZERO_VECTOR = 332,
-     ZERO_ROTATION = 333,
-     TOUCH_INVALID_VECTOR = 334,
-     TOUCH_INVALID_TEXCOORD = 335,
-     LOWER_THAN_ELSE = 336,
-     INITIALIZER = 337
-   };
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    INTEGER = 258,                 /* INTEGER  */
+    FLOAT_TYPE = 259,              /* FLOAT_TYPE  */
+    STRING = 260,                  /* STRING  */
+    LLKEY = 261,                   /* LLKEY  */
+    VECTOR = 262,                  /* VECTOR  */
+    QUATERNION = 263,              /* QUATERNION  */
+    LIST = 264,                    /* LIST  */
+    STATE = 265,                   /* STATE  */
+    EVENT = 266,                   /* EVENT  */
+    JUMP = 267,                    /* JUMP  */
+    RETURN = 268,                  /* RETURN  */
+    STATE_ENTRY = 269,             /* STATE_ENTRY  */
+    STATE_EXIT = 270,              /* STATE_EXIT  */
+    TOUCH_START = 271,             /* TOUCH_START  */
+    TOUCH = 272,                   /* TOUCH  */
+    TOUCH_END = 273,               /* TOUCH_END  */
+    COLLISION_START = 274,         /* COLLISION_START  */
+    COLLISION = 275,               /* COLLISION  */
+    COLLISION_END = 276,           /* COLLISION_END  */
+    LAND_COLLISION_START = 277,    /* LAND_COLLISION_START  */
+    LAND_COLLISION = 278,          /* LAND_COLLISION  */
+    LAND_COLLISION_END = 279,      /* LAND_COLLISION_END  */
+    TIMER = 280,                   /* TIMER  */
+    CHAT = 281,                    /* CHAT  */
+    SENSOR = 282,                  /* SENSOR  */
+    NO_SENSOR = 283,               /* NO_SENSOR  */
+    CONTROL = 284,                 /* CONTROL  */
+    AT_TARGET = 285,               /* AT_TARGET  */
+    NOT_AT_TARGET = 286,           /* NOT_AT_TARGET  */
+    AT_ROT_TARGET = 287,           /* AT_ROT_TARGET  */
+    NOT_AT_ROT_TARGET = 288,       /* NOT_AT_ROT_TARGET  */
+    MONEY = 289,                   /* MONEY  */
+    EMAIL = 290,                   /* EMAIL  */
+    RUN_TIME_PERMISSIONS = 291,    /* RUN_TIME_PERMISSIONS  */
+    INVENTORY = 292,               /* INVENTORY  */
+    ATTACH = 293,                  /* ATTACH  */
+    DATASERVER = 294,              /* DATASERVER  */
+    MOVING_START = 295,            /* MOVING_START  */
+    MOVING_END = 296,              /* MOVING_END  */
+    REZ = 297,                     /* REZ  */
+    OBJECT_REZ = 298,              /* OBJECT_REZ  */
+    LINK_MESSAGE = 299,            /* LINK_MESSAGE  */
+    REMOTE_DATA = 300,             /* REMOTE_DATA  */
+    HTTP_RESPONSE = 301,           /* HTTP_RESPONSE  */
+    HTTP_REQUEST = 302,            /* HTTP_REQUEST  */
+    IDENTIFIER = 303,              /* IDENTIFIER  */
+    STATE_DEFAULT = 304,           /* STATE_DEFAULT  */
+    INTEGER_CONSTANT = 305,        /* INTEGER_CONSTANT  */
+    INTEGER_TRUE = 306,            /* INTEGER_TRUE  */
+    INTEGER_FALSE = 307,           /* INTEGER_FALSE  */
+    FP_CONSTANT = 308,             /* FP_CONSTANT  */
+    STRING_CONSTANT = 309,         /* STRING_CONSTANT  */
+    INC_OP = 310,                  /* INC_OP  */
+    DEC_OP = 311,                  /* DEC_OP  */
+    ADD_ASSIGN = 312,              /* ADD_ASSIGN  */
+    SUB_ASSIGN = 313,              /* SUB_ASSIGN  */
+    MUL_ASSIGN = 314,              /* MUL_ASSIGN  */
+    DIV_ASSIGN = 315,              /* DIV_ASSIGN  */
+    MOD_ASSIGN = 316,              /* MOD_ASSIGN  */
+    EQ = 317,                      /* EQ  */
+    NEQ = 318,                     /* NEQ  */
+    GEQ = 319,                     /* GEQ  */
+    LEQ = 320,                     /* LEQ  */
+    BOOLEAN_AND = 321,             /* BOOLEAN_AND  */
+    BOOLEAN_OR = 322,              /* BOOLEAN_OR  */
+    SHIFT_LEFT = 323,              /* SHIFT_LEFT  */
+    SHIFT_RIGHT = 324,             /* SHIFT_RIGHT  */
+    IF = 325,                      /* IF  */
+    ELSE = 326,                    /* ELSE  */
+    FOR = 327,                     /* FOR  */
+    DO = 328,                      /* DO  */
+    WHILE = 329,                   /* WHILE  */
+    PRINT = 330,                   /* PRINT  */
+    PERIOD = 331,                  /* PERIOD  */
+    ZERO_VECTOR = 332,             /* ZERO_VECTOR  */
+    ZERO_ROTATION = 333,           /* ZERO_ROTATION  */
+    TOUCH_INVALID_VECTOR = 334,    /* TOUCH_INVALID_VECTOR  */
+    TOUCH_INVALID_TEXCOORD = 335,  /* TOUCH_INVALID_TEXCOORD  */
+    LOWER_THAN_ELSE = 336,         /* LOWER_THAN_ELSE  */
+    INITIALIZER = 337              /* INITIALIZER  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
 
-
-
+/* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE
+union YYSTYPE
 {
-
-/* Line 1676 of yacc.c  */
-#line 38 "indra.y"
+#line 33 "indra.y"
 
 	S32								ival;
 	F32								fval;
@@ -149,16 +162,18 @@ typedef union YYSTYPE
 	class LLScritpGlobalStorage		*global_store;
 	class LLScriptScript			*script;
 
+#line 166 "indra_generated.y.hpp"
 
-
-/* Line 1676 of yacc.c  */
-#line 156 "indra_generated.y.hpp"
-} YYSTYPE;
+};
+typedef union YYSTYPE YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
 # define YYSTYPE_IS_DECLARED 1
 #endif
 
-extern YYSTYPE yylval;
 
 
+
+int yyparse (void);
+
+
+#endif /* !YY_YY_INDRA_GENERATED_Y_HPP_INCLUDED  */
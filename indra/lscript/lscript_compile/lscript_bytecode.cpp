@@ -312,7 +312,7 @@ void LLScriptScriptCodeChunk::build(LLFILE *efp, LLFILE *bcfp)
 		set_register(mCompleteCode, LREG_TM, mTotalSize);
 
 
-		if (fwrite(mCompleteCode, 1, mTotalSize, bcfp) != (size_t)mTotalSize)
+		if (bcfp && fwrite(mCompleteCode, 1, mTotalSize, bcfp) != (size_t)mTotalSize)
 		{
 			llwarns << "Short write" << llendl;
 		}
@@ -323,4 +323,4 @@ void LLScriptScriptCodeChunk::build(LLFILE *efp, LLFILE *bcfp)
 	}
 }
 
-LLScriptScriptCodeChunk	*gScriptCodeChunk;
+ll_thread_local LLScriptScriptCodeChunk	*gScriptCodeChunk;
@@ -78,6 +78,7 @@ public:
 	LLScriptScriptCodeChunk(S32 total_size);
 	~LLScriptScriptCodeChunk();
 
+	// Assembles mCompleteCode, and writes it to bcfp when that is set.
 	void build(LLFILE *efp, LLFILE *bcfp);
 
 	LLScriptByteCodeChunk				*mRegisters;	
@@ -89,7 +90,7 @@ public:
 	U8									*mCompleteCode;
 };
 
-extern LLScriptScriptCodeChunk	*gScriptCodeChunk;
+extern ll_thread_local LLScriptScriptCodeChunk	*gScriptCodeChunk;
 
 #endif
 
@@ -34,12 +34,12 @@
 
 #include "lscript_error.h"
 
-S32 gColumn = 0;
-S32 gLine = 0;
-S32 gInternalColumn = 0;
-S32 gInternalLine = 0;
+ll_thread_local S32 gColumn = 0;
+ll_thread_local S32 gLine = 0;
+ll_thread_local S32 gInternalColumn = 0;
+ll_thread_local S32 gInternalLine = 0;
 
-LLScriptGenerateErrorText gErrorToText;
+ll_thread_local LLScriptGenerateErrorText gErrorToText;
 
 void LLScriptFilePosition::fdotabs(LLFILE *fp, S32 tabs, S32 tabsize)
 {
@@ -79,27 +79,39 @@ const char* gErrorText[LSERROR_EOF] = 	/*Flawfinder: ignore*/
 	"Bytecode verification failed"
 };
 
+void LLScriptGenerateErrorText::write(LLFILE *fp, const std::string& message)
+{
+	if (mOutput)
+	{
+		mOutput->append(message);
+	}
+	else if (fp)
+	{
+		fputs(message.c_str(), fp);
+	}
+}
+
 void LLScriptGenerateErrorText::writeWarning(LLFILE *fp, LLScriptFilePosition *pos, LSCRIPTWarnings warning)
 {
-	fprintf(fp, "(%d, %d) : WARNING : %s\n", pos->mLineNumber, pos->mColumnNumber, gWarningText[warning]);
+	write(fp, llformat("(%d, %d) : WARNING : %s\n", pos->mLineNumber, pos->mColumnNumber, gWarningText[warning]));
 	mTotalWarnings++;
 }
 
 void LLScriptGenerateErrorText::writeWarning(LLFILE *fp, S32 line, S32 col, LSCRIPTWarnings warning)
 {
-	fprintf(fp, "(%d, %d) : WARNING : %s\n", line, col, gWarningText[warning]);
+	write(fp, llformat("(%d, %d) : WARNING : %s\n", line, col, gWarningText[warning]));
 	mTotalWarnings++;
 }
 
 void LLScriptGenerateErrorText::writeError(LLFILE *fp, LLScriptFilePosition *pos, LSCRIPTErrors error)
 {
-	fprintf(fp, "(%d, %d) : ERROR : %s\n", pos->mLineNumber, pos->mColumnNumber, gErrorText[error]);
+	write(fp, llformat("(%d, %d) : ERROR : %s\n", pos->mLineNumber, pos->mColumnNumber, gErrorText[error]));
 	mTotalErrors++;
 }
 
 void LLScriptGenerateErrorText::writeError(LLFILE *fp, S32 line, S32 col, LSCRIPTErrors error)
 {
-	fprintf(fp, "(%d, %d) : ERROR : %s\n", line, col, gErrorText[error]);
+	write(fp, llformat("(%d, %d) : ERROR : %s\n", line, col, gErrorText[error]));
 	mTotalErrors++;
 }
 
@@ -64,10 +64,11 @@ typedef enum e_lscript_prune_type
 	LSPRUNE_EOF
 } LSCRIPTPruneType;
 
-extern S32 gColumn;
-extern S32 gLine;
-extern S32 gInternalColumn;
-extern S32 gInternalLine;
+// Compiler state is kept per thread so that several scripts can be compiled at once.
+extern ll_thread_local S32 gColumn;
+extern ll_thread_local S32 gLine;
+extern ll_thread_local S32 gInternalColumn;
+extern ll_thread_local S32 gInternalLine;
 
 
 // used to describe where in the file this piece is
@@ -131,13 +132,12 @@ typedef enum e_lscript_errors
 	LSERROR_EOF
 } LSCRIPTErrors;
 
+// No constructor so that it can live in thread local storage, call init() before use.
 class LLScriptGenerateErrorText
 {
 public:
-	LLScriptGenerateErrorText() { init(); }
-	~LLScriptGenerateErrorText() {}
-
-	void init() { mTotalErrors = 0; mTotalWarnings = 0; }
+	// When output is set, messages are appended to it instead of being written to the file.
+	void init(std::string* output = NULL) { mTotalErrors = 0; mTotalWarnings = 0; mOutput = output; }
 
 	void writeWarning(LLFILE *fp, LLScriptFilePosition *pos, LSCRIPTWarnings warning);
 	void writeWarning(LLFILE *fp, S32 line, S32 col, LSCRIPTWarnings warning);
@@ -149,10 +149,15 @@ public:
 
 	S32 mTotalErrors;
 	S32 mTotalWarnings;
+
+private:
+	void write(LLFILE *fp, const std::string& message);
+
+	std::string* mOutput;
 };
 
 std::string getLScriptErrorString(LSCRIPTErrors error);
 
-extern LLScriptGenerateErrorText gErrorToText;
+extern ll_thread_local LLScriptGenerateErrorText gErrorToText;
 
 #endif
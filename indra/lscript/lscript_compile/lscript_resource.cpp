@@ -39,4 +39,4 @@ void init_temp_jumps()
 	gTempJumpCount = 0;
 }
 
-S32 gTempJumpCount = 0;
+ll_thread_local S32 gTempJumpCount = 0;
@@ -37,7 +37,7 @@
 
 void init_temp_jumps();
 
-extern S32 gTempJumpCount;
+extern ll_thread_local S32 gTempJumpCount;
 
 #endif
 
@@ -34,4 +34,4 @@
 
 #include "lscript_tree.h"
 
-LLStringTable *gScopeStringTable;
+ll_thread_local LLStringTable *gScopeStringTable;
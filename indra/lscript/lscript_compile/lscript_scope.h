@@ -34,6 +34,7 @@
 #define LL_LSCRIPT_SCOPE_H
 
 #include "string_table.h"
+#include "llthread.h"
 #include "llmap.h"
 #include "lscript_byteformat.h"
 
@@ -405,7 +406,7 @@ public:
 	S32									mStateCount;
 };
 
-extern LLStringTable *gScopeStringTable;
+extern ll_thread_local LLStringTable *gScopeStringTable;
 
 
 
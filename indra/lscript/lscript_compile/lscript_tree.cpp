@@ -9573,7 +9573,7 @@ S32 LLScriptEventHandler::getSize()
 	return mStackSpace;
 }
 
-U64 gCurrentHandler = 0;
+ll_thread_local U64 gCurrentHandler = 0;
 
 static void print_cil_local_init(LLFILE* fp, LLScriptScopeEntry* scopeEntry)
 {
@@ -9794,11 +9794,14 @@ void LLScriptEventHandler::recurse(LLFILE *fp, S32 tabs, S32 tabsize, LSCRIPTCom
 			entrycount = 0;
 			mStatement->recurse(fp, tabs, tabsize, pass, ptype, prunearg, scope, type, basetype, count, chunk, heap, stacksize, mScopeEntry, entrycount, NULL);
 
-			const char *function_args = mScopeEntry->mFunctionArgs.mString;
-			fprintf(fp, "Function Args: %s\n", function_args?function_args:"");
+			if (fp)
+			{
+				const char *function_args = mScopeEntry->mFunctionArgs.mString;
+				fprintf(fp, "Function Args: %s\n", function_args?function_args:"");
 
-			const char *local_list = mScopeEntry->mLocals.mString;
-			fprintf(fp, "Local List: %s\n", local_list?local_list:"");
+				const char *local_list = mScopeEntry->mLocals.mString;
+				fprintf(fp, "Local List: %s\n", local_list?local_list:"");
+			}
 		}
 		mStackSpace = (S32)count;
 		break;
@@ -10221,8 +10224,11 @@ void LLScriptGlobalFunctions::recurse(LLFILE *fp, S32 tabs, S32 tabsize, LSCRIPT
 		{
 			entrycount = 0;
 			mStatements->recurse(fp, tabs, tabsize, pass, ptype, prunearg, scope, type, basetype, count, chunk, heap, stacksize, mIdentifier->mScopeEntry, entrycount, NULL);
-			fprintf(fp, "Function Args: %s\n", mIdentifier->mScopeEntry->mFunctionArgs.mString);
-			fprintf(fp, "Local List: %s\n", mIdentifier->mScopeEntry->mLocals.mString);
+			if (fp)
+			{
+				fprintf(fp, "Function Args: %s\n", mIdentifier->mScopeEntry->mFunctionArgs.mString);
+				fprintf(fp, "Local List: %s\n", mIdentifier->mScopeEntry->mLocals.mString);
+			}
 			if (mIdentifier->mScopeEntry)
 			{
 				mIdentifier->mScopeEntry->mSize = (S32)count;
@@ -10583,7 +10589,8 @@ S32 LLScriptScript::getSize()
 LLScriptScript::LLScriptScript(LLScritpGlobalStorage *globals, 
 							   LLScriptState *states) :
     LLScriptFilePosition(0, 0),
-	mStates(states), mGlobalScope(NULL), mGlobals(NULL), mGlobalFunctions(NULL), mGodLike(FALSE)
+	mStates(states), mGlobalScope(NULL), mGlobals(NULL), mGlobalFunctions(NULL), mGodLike(FALSE),
+	mBytecodeBuffer(NULL)
 {
 	const char DEFAULT_BYTECODE_FILENAME[] = "lscript.lso";
 
@@ -10697,6 +10704,14 @@ void LLScriptScript::recurse(LLFILE *fp, S32 tabs, S32 tabsize, LSCRIPTCompilePa
 						sentry = mGlobalScope->addEntry(i->mName, LIT_LIBRARY_FUNCTION, char2type(*i->mReturnType));
 					else
 						sentry = mGlobalScope->addEntry(i->mName, LIT_LIBRARY_FUNCTION, LST_NULL);
+				}
+				else
+				{
+					sentry = NULL;
+				}
+				// The library has a few overloaded names, the first definition wins.
+				if (sentry)
+				{
 					sentry->mLibraryNumber = function_index;
 					arg = i->mArgs;
 					if (arg)
@@ -10822,10 +10837,21 @@ void LLScriptScript::recurse(LLFILE *fp, S32 tabs, S32 tabsize, LSCRIPTCompilePa
 
 			// now, put it all together and spit it out
 			// we need 
-			LLFILE* bcfp = LLFile::fopen(mBytecodeDest, "wb");		/*Flawfinder: ignore*/
-			
-			code->build(fp, bcfp);
-			fclose(bcfp);
+			if (mBytecodeBuffer)
+			{
+				code->build(fp, NULL);
+				if (code->mCompleteCode)
+				{
+					mBytecodeBuffer->assign(code->mCompleteCode, code->mCompleteCode + code->mTotalSize);
+				}
+			}
+			else
+			{
+				LLFILE* bcfp = LLFile::fopen(mBytecodeDest, "wb");		/*Flawfinder: ignore*/
+
+				code->build(fp, bcfp);
+				fclose(bcfp);
+			}
 									   
 			delete code;
 		}
@@ -2289,6 +2289,8 @@ public:
 	S32 getSize();
 
 	void setBytecodeDest(const char* dst_filename);
+	// LSO bytecode goes into buffer instead of the destination file.
+	void setBytecodeBuffer(std::vector<U8>* buffer) { mBytecodeBuffer = buffer; }
 
 	void setClassName(const char* class_name);
 	const char* getClassName() {return mClassName;}
@@ -2301,6 +2303,7 @@ public:
 
 private:
 	std::string mBytecodeDest;
+	std::vector<U8>* mBytecodeBuffer;
 	char mClassName[MAX_STRING];
 };
 
@@ -2326,7 +2329,7 @@ public:
 	LLLinkedList<LLScriptFilePosition> mAllocationList;
 };
 
-extern LLScriptAllocationManager *gAllocationManager;
-extern LLScriptScript			 *gScriptp;
+extern ll_thread_local LLScriptAllocationManager *gAllocationManager;
+extern ll_thread_local LLScriptScript			 *gScriptp;
 
 #endif
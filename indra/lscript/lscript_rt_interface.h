@@ -36,6 +36,12 @@
 BOOL lscript_compile(char *filename, BOOL compile_to_mono, BOOL is_god_like = FALSE);
 BOOL lscript_compile(const char* src_filename, const char* dst_filename,
 					 const char* err_filename, BOOL compile_to_mono, const char* class_name, BOOL is_god_like = FALSE);
+// Compiles LSL source held in memory to LSO bytecode without touching the disk.  Several
+// threads may compile at once after lscript_compile_init() was called from the main thread.
+BOOL lscript_compile_buffer(const std::string& source, std::vector<U8>& bytecode,
+							std::string& errors, BOOL is_god_like = FALSE);
+void lscript_compile_init();
+void lscript_compile_cleanup();
 void lscript_run(const std::string& filename, BOOL b_debug);
 
 
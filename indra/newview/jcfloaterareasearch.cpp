@@ -58,7 +58,9 @@ const F32 min_refresh_interval = 0.25f;	// Minimum interval between list refresh
 JCFloaterAreaSearch::JCFloaterAreaSearch() :
 LLFloater(),
 mCounterText(0),
-mResultList(0)
+mResultList(0),
+mSortColumn(LIST_OBJECT_NAME),
+mSortAscending(TRUE)
 {
 	llassert_always(sInstance == NULL);
 	sInstance = this;
@@ -67,6 +69,10 @@ mResultList(0)
 
 JCFloaterAreaSearch::~JCFloaterAreaSearch()
 {
+	if (mResultList)
+	{
+		mResultList->setDataSource(NULL);
+	}
 	sInstance = NULL;
 }
 
@@ -91,6 +97,7 @@ BOOL JCFloaterAreaSearch::postBuild()
 	mResultList->setCallbackUserData(this);
 	mResultList->setDoubleClickCallback(onDoubleClick);
 	mResultList->sortByColumn("Name", TRUE);
+	mResultList->setDataSource(this);
 
 	mCounterText = getChild<LLTextBox>("counter");
 
@@ -117,7 +124,8 @@ void JCFloaterAreaSearch::checkRegion()
 		sObjectDetails.clear();
 		if (sInstance)
 		{
-			sInstance->mResultList->deleteAllItems();
+			sInstance->mResultRows.clear();
+			sInstance->mResultList->dataChanged();
 			sInstance->mCounterText->setText(std::string("Listed/Pending/Total"));
 		}
 	}
@@ -235,9 +243,9 @@ void JCFloaterAreaSearch::results()
 	if (!(sInstance->getVisible())) return;
 	if (sRequested > 0 && sInstance->mLastUpdateTimer.getElapsedTimeF32() < min_refresh_interval) return;
 	//llinfos << "results()" << llendl;
-	LLDynamicArray<LLUUID> selected = sInstance->mResultList->getSelectedIDs();
-	S32 scrollpos = sInstance->mResultList->getScrollPos();
-	sInstance->mResultList->deleteAllItems();
+	// The list keeps the selection and scroll position of a data source across changes
+	std::vector<AResultRow>& rows = sInstance->mResultRows;
+	rows.clear();
 	S32 i;
 	S32 total = gObjectList.getNumObjects();
 
@@ -281,21 +289,13 @@ void JCFloaterAreaSearch::results()
 							(sSearchedGroup == "" || object_group.find(sSearchedGroup) != -1))
 						{
 							//llinfos << "pass" << llendl;
-							LLSD element;
-							element["id"] = object_id;
-							element["columns"][LIST_OBJECT_NAME]["column"] = "Name";
-							element["columns"][LIST_OBJECT_NAME]["type"] = "text";
-							element["columns"][LIST_OBJECT_NAME]["value"] = details->name;	//item->getName();//ai->second//"avatar_icon";
-							element["columns"][LIST_OBJECT_DESC]["column"] = "Description";
-							element["columns"][LIST_OBJECT_DESC]["type"] = "text";
-							element["columns"][LIST_OBJECT_DESC]["value"] = details->desc;	//ai->second;
-							element["columns"][LIST_OBJECT_OWNER]["column"] = "Owner";
-							element["columns"][LIST_OBJECT_OWNER]["type"] = "text";
-							element["columns"][LIST_OBJECT_OWNER]["value"] = onU;			//ai->first;
-							element["columns"][LIST_OBJECT_GROUP]["column"] = "Group";
-							element["columns"][LIST_OBJECT_GROUP]["type"] = "text";
-							element["columns"][LIST_OBJECT_GROUP]["value"] = cnU;			//ai->second;
-							sInstance->mResultList->addElement(element, ADD_BOTTOM);
+							rows.push_back(AResultRow());
+							AResultRow& row = rows.back();
+							row.id = object_id;
+							row.column[LIST_OBJECT_NAME] = details->name;
+							row.column[LIST_OBJECT_DESC] = details->desc;
+							row.column[LIST_OBJECT_OWNER] = onU;
+							row.column[LIST_OBJECT_GROUP] = cnU;
 						}
 					}
 				}
@@ -303,13 +303,51 @@ void JCFloaterAreaSearch::results()
 		}
 	}
 
-	sInstance->mResultList->sortItems();
-	sInstance->mResultList->selectMultiple(selected);
-	sInstance->mResultList->setScrollPos(scrollpos);
+	std::stable_sort(rows.begin(), rows.end(), sort_rows(sInstance->mSortColumn, sInstance->mSortAscending));
+	sInstance->mResultList->dataChanged();
 	sInstance->mCounterText->setText(llformat("%d listed/%d pending/%d total", sInstance->mResultList->getItemCount(), sRequested, sObjectDetails.size()));
 	sInstance->mLastUpdateTimer.reset();
 }
 
+S32 JCFloaterAreaSearch::getRowCount() const
+{
+	return mResultRows.size();
+}
+
+LLSD JCFloaterAreaSearch::getRow(S32 index) const
+{
+	static const char* column_names[LIST_OBJECT_GROUP + 1] = { "Name", "Description", "Owner", "Group" };
+
+	const AResultRow& row = mResultRows[index];
+	LLSD element;
+	element["id"] = row.id;
+	for (S32 i = LIST_OBJECT_NAME; i <= LIST_OBJECT_GROUP; i++)
+	{
+		element["columns"][i]["column"] = column_names[i];
+		element["columns"][i]["type"] = "text";
+		element["columns"][i]["value"] = row.column[i];
+	}
+	return element;
+}
+
+void JCFloaterAreaSearch::sortRows(S32 column, BOOL ascending)
+{
+	if (column < LIST_OBJECT_NAME || column > LIST_OBJECT_GROUP)
+	{
+		return;
+	}
+	mSortColumn = column;
+	mSortAscending = ascending;
+	std::stable_sort(mResultRows.begin(), mResultRows.end(), sort_rows(column, ascending));
+}
+
+// Same order as the list sorts text cells in
+bool JCFloaterAreaSearch::sort_rows::operator()(const AResultRow& lhs, const AResultRow& rhs) const
+{
+	S32 order = LLStringUtil::compareDict(lhs.column[mColumn], rhs.column[mColumn]);
+	return mAscending ? order < 0 : order > 0;
+}
+
 // static
 void JCFloaterAreaSearch::processObjectPropertiesFamily(LLMessageSystem* msg, void** user_data)
 {
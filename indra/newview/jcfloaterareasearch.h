@@ -32,12 +32,12 @@
  */
 
 #include "llfloater.h"
+#include "llscrolllistctrl.h"
 #include "lluuid.h"
 #include "llstring.h"
 #include "llframetimer.h"
 
 class LLTextBox;
-class LLScrollListCtrl;
 class LLViewerRegion;
 
 struct AObjectDetails
@@ -49,7 +49,9 @@ struct AObjectDetails
 	LLUUID group_id;
 };
 
-class JCFloaterAreaSearch : public LLFloater
+// The result list asks for the rows it shows, so a region with tens of
+// thousands of objects only builds list items for the visible page.
+class JCFloaterAreaSearch : public LLFloater, public LLScrollListDataSource
 {
 public:
 	JCFloaterAreaSearch();
@@ -58,6 +60,10 @@ public:
 	/*virtual*/ BOOL postBuild();
 	/*virtual*/ void close(bool app = false);
 
+	/*virtual*/ S32 getRowCount() const;
+	/*virtual*/ LLSD getRow(S32 index) const;
+	/*virtual*/ void sortRows(S32 column, BOOL ascending);
+
 	static void results();
 	static void toggle();
 	static JCFloaterAreaSearch* getInstance() { return sInstance; }
@@ -79,6 +85,20 @@ private:
 		LIST_OBJECT_GROUP
 	};
 
+	// One matching object, with the names as shown
+	struct AResultRow
+	{
+		LLUUID id;
+		std::string column[LIST_OBJECT_GROUP + 1];
+	};
+	struct sort_rows
+	{
+		sort_rows(S32 column, BOOL ascending) : mColumn(column), mAscending(ascending) { }
+		bool operator()(const AResultRow& lhs, const AResultRow& rhs) const;
+		S32 mColumn;
+		BOOL mAscending;
+	};
+
 	static JCFloaterAreaSearch* sInstance;
 
 	static S32 sRequested;
@@ -87,6 +107,10 @@ private:
 	LLScrollListCtrl* mResultList;
 	LLFrameTimer mLastUpdateTimer;
 
+	std::vector<AResultRow> mResultRows;
+	S32 mSortColumn;
+	BOOL mSortAscending;
+
 	static std::map<LLUUID, AObjectDetails> sObjectDetails;
 
 	static std::string sSearchedName;
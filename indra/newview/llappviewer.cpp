@@ -73,6 +73,7 @@
 #include "llviewermediafocus.h"
 #include "llviewermessage.h"
 #include "llviewerobjectlist.h"
+#include "llviewerpacketreplay.h"
 #include "llworldmap.h"
 #include "llmutelist.h"
 #include "llurldispatcher.h"
@@ -109,6 +110,7 @@
 #include "llviewerkeyboard.h"
 #include "lllfsthread.h"
 #include "llworkerthread.h"
+#include "lljobscheduler.h"
 #include "lltexturecache.h"
 #include "lltexturefetch.h"
 #include "llimageworker.h"
@@ -129,6 +131,10 @@
 #include "llstreamingaudio.h"
 #include "llviewermenu.h"
 #include "llselectmgr.h"
+#include "llcullthread.h"
+#include "llnetmaptiles.h"
+#include "llscriptcompilethread.h"
+#include "llvolumebuildthread.h"
 #include "lltrans.h"
 #include "lluitrans.h"
 #include "lltracker.h"
@@ -577,6 +583,9 @@ bool LLAppViewer::init()
 
 	initLogging();
 
+	// From here on messages are written out by a thread of their own.
+	LLError::startAsyncLogging();
+
 	// Logging is initialized. Now it's safe to start the error thread.
 	startErrorThread();
 
@@ -592,7 +601,8 @@ bool LLAppViewer::init()
 
     // *NOTE:Mani - LLCurl::initClass is not thread safe. 
     // Called before threads are created.
-    LLCurl::initClass(gSavedSettings.getBOOL("CurlUseMultipleThreads"));
+    LLCurl::initClass(gSavedSettings.getU32("CurlMaxRequestsPerHost"),
+					  gSavedSettings.getU32("CurlMaxTextureRequestsPerHost"));
 	LL_INFOS("InitInfo") << "LLCurl initialized." << LL_ENDL ;
 
     initThreads();
@@ -906,7 +916,7 @@ bool LLAppViewer::mainLoop()
 	//-------------------------------------------
 
 	// Create IO Pump to use for HTTP Requests.
-	gServicePump = new LLPumpIO;
+	gServicePump = new LLPumpIO(gSavedSettings.getBOOL("PumpIOUseEpoll") ? LLPumpIO::POLL_EPOLL : LLPumpIO::POLL_APR);
 	LLHTTPClient::setPump(*gServicePump);
 	LLCurl::setCAFile(gDirUtilp->getCAFile());
 	
@@ -1106,6 +1116,9 @@ bool LLAppViewer::mainLoop()
  					work_pending += LLAppViewer::getTextureCache()->update(1); // unpauses the texture cache thread
  					work_pending += LLAppViewer::getImageDecodeThread()->update(1); // unpauses the image thread
  					work_pending += LLAppViewer::getTextureFetch()->update(1); // unpauses the texture fetch thread
+					work_pending += LLScriptCompileThread::updateClass(1);
+					work_pending += LLImageEncodeThread::updateClass(1);
+					work_pending += LLVolumeBuildThread::updateClass(1);
 					io_pending += LLVFSThread::updateClass(1);
 					io_pending += LLLFSThread::updateClass(1);
 					if (io_pending > 1000)
@@ -1523,6 +1536,9 @@ bool LLAppViewer::cleanup()
 		pending += LLAppViewer::getTextureCache()->update(1); // unpauses the worker thread
 		pending += LLAppViewer::getImageDecodeThread()->update(1); // unpauses the image thread
 		pending += LLAppViewer::getTextureFetch()->update(1); // unpauses the texture fetch thread
+		pending += LLScriptCompileThread::updateClass(0);
+		pending += LLImageEncodeThread::updateClass(0);
+		pending += LLVolumeBuildThread::updateClass(0);
 		pending += LLVFSThread::updateClass(0);
 		pending += LLLFSThread::updateClass(0);
 		if (pending == 0)
@@ -1549,6 +1565,11 @@ bool LLAppViewer::cleanup()
     sTextureFetch = NULL;
 	delete sImageDecodeThread;
     sImageDecodeThread = NULL;
+	LLScriptCompileThread::cleanupClass();
+	LLImageEncodeThread::cleanupClass();
+	LLVolumeBuildThread::cleanupClass();
+	LLCullThread::cleanupClass();
+	LLNetMapTiles::cleanupClass();
 
 
 	llinfos << "Cleaning up Media and Textures" << llendflush;
@@ -1566,6 +1587,7 @@ bool LLAppViewer::cleanup()
 	LLImage::cleanupClass();
 	LLVFSThread::cleanupClass();
 	LLLFSThread::cleanupClass();
+	LLJobScheduler::cleanupClass();
 
 	llinfos << "VFS Thread finished" << llendflush;
 
@@ -1624,6 +1646,8 @@ bool LLAppViewer::cleanup()
 
     llinfos << "Goodbye!" << llendflush;
 
+	LLError::stopAsyncLogging();
+
 	// return 0;
 	return true;
 }
@@ -1663,15 +1687,36 @@ bool LLAppViewer::initThreads()
 		LLWatchdog::getInstance()->init(watchdog_killer_callback);
 	}
 
+	// Shared worker threads; the threaded queues below run their requests on them
+	if (enable_threads)
+	{
+		LLJobScheduler::initClass(gSavedSettings.getU32("JobSchedulerThreads"));
+	}
+
 	LLVFSThread::initClass(enable_threads && false);
 	LLLFSThread::initClass(enable_threads && false);
 
 	// Image decoding
-	LLAppViewer::sImageDecodeThread = new LLImageDecodeThread(enable_threads && true);
+	LLAppViewer::sImageDecodeThread = new LLImageDecodeThread(enable_threads && true, llmax((S32)gSavedSettings.getU32("ImageDecodeJobs"), 1));
 	LLAppViewer::sTextureCache = new LLTextureCache(enable_threads && true);
 	LLAppViewer::sTextureFetch = new LLTextureFetch(LLAppViewer::getTextureCache(), sImageDecodeThread, enable_threads && true);
 	LLImage::initClass();
 
+	// Image encoding for uploads and snapshots
+	LLImageEncodeThread::initClass(gSavedSettings.getU32("ImageEncodeThreads"), enable_threads && true);
+
+	// Local script compilation for the compile queue
+	LLScriptCompileThread::initClass(gSavedSettings.getU32("ScriptCompileThreads"), enable_threads && true);
+
+	// Prim and sculpt geometry
+	LLVolumeBuildThread::initClass(gSavedSettings.getU32("VolumeBuildThreads"), enable_threads && true);
+
+	// Frustum culling, alongside the main thread
+	LLCullThread::initClass(gSavedSettings.getU32("CullThreads"), enable_threads && true);
+
+	// Minimap object layer
+	LLNetMapTiles::initClass(enable_threads && true);
+
 
 #if MESH_ENABLED
 	// Mesh streaming and caching
@@ -2713,6 +2758,7 @@ void LLAppViewer::handleViewerCrash()
 	// Close the debug file
 	pApp->writeDebugInfo();
 
+	LLError::flushAsyncLog();
 	LLError::logToFile("");
 
 // On Mac, we send the report on the next run, since we need macs crash report
@@ -3595,6 +3641,10 @@ void LLAppViewer::idle()
 		gGLActive = FALSE;
 	}
 
+	if (LLViewerPacketReplay::isReplaying())
+	{
+		LLViewerPacketReplay::idle(dt_raw);
+	}
 	
     F32 yaw = 0.f;				// radians
 
@@ -50,7 +50,6 @@
 #include "llviewerobject.h"
 #include "llviewerobjectlist.h"
 #include "llviewerregion.h"
-#include "lscript_rt_interface.h"
 #include "llviewercontrol.h"
 #include "llviewerobject.h"
 #include "llviewerregion.h"
@@ -62,6 +61,7 @@
 #include "lluictrlfactory.h"
 
 #include "llselectmgr.h"
+#include "llscriptcompilethread.h"
 
 ///----------------------------------------------------------------------------
 /// Local function declarations, constants, enums, and typedefs
@@ -452,37 +452,22 @@ void LLFloaterCompileQueue::scriptArrived(LLVFS *vfs, const LLUUID& asset_id,
 			}
 			else
 			{
-				// It's now in the file, now compile it.
 				buffer = std::string("Downloaded, now compiling: ") + data->mScriptName; // *TODO: Translate
 
-				// Write script to local file for compilation.
-				LLFILE *fp = LLFile::fopen(filename, "wb");	 /*Flawfinder: ignore*/
-				if (fp)
+				// Read the script straight out of the VFS, the compile
+				// threads work on memory buffers.
+				std::string source;
+				source.resize(file.getSize());
+				if (source.empty() || file.read((U8*)&source[0], source.size()))
 				{
-					const S32 buf_size = 65536;
-					U8 copy_buf[buf_size];
-					
-					while (file.read(copy_buf, buf_size)) 	 /*Flawfinder: ignore*/
-					{
-						if (fwrite(copy_buf, file.getLastBytesRead(), 1, fp) < 1)
-						{
-							// return a bad file error if we can't write the whole thing
-							status = LL_ERR_CANNOT_OPEN_FILE;
-						}
-					}
-
-					fclose(fp);
+					// TODO: babbage: No compile if no cap.
+					queue->compile(source, data->mItemId);
 				}
 				else
 				{
-					llerrs << "Unable to find object to compile" << llendl;
+					llwarns << "Unable to read script " << asset_id << " from the VFS" << llendl;
+					queue->removeItemByItemID(data->mItemId);
 				}
-
-				// TODO: babbage: No compile if no cap.
-				queue->compile(filename, data->mItemId);
-					
-				// Delete it after we're done compiling?
-				LLFile::remove(filename);
 			}
 		}
 	}
@@ -554,45 +539,81 @@ void LLFloaterCompileQueue::onSaveBytecodeComplete(const LLUUID& asset_id, void*
 	data = NULL;
 }
 
-// compile the file given and save it out.
-void LLFloaterCompileQueue::compile(const std::string& filename,
+class LLCompileQueueResponder : public LLScriptCompileThread::Responder
+{
+public:
+	LLCompileQueueResponder(const LLUUID& queue_id, const LLUUID& item_id, const std::string& source) :
+		mQueueID(queue_id),
+		mItemID(item_id),
+		mSource(source)
+	{
+	}
+
+	/*virtual*/ void completed(bool success, const std::vector<U8>& bytecode, const std::string& errors)
+	{
+		LLFloaterCompileQueue* queue = static_cast<LLFloaterCompileQueue*>
+					(LLFloaterScriptQueue::findInstance(mQueueID));
+		if (!queue)
+		{
+			// The floater was closed while we were compiling.
+			return;
+		}
+		if (success)
+		{
+			llinfos << "compile successful." << llendl;
+			queue->saveCompiledScript(mItemID, mSource, bytecode);
+		}
+		else
+		{
+			llwarns << "compile failed" << llendl;
+			LLScrollListCtrl* list = queue->getChild<LLScrollListCtrl>("queue output");
+			std::istringstream lines(errors);
+			std::string line;
+			while (std::getline(lines, line))
+			{
+				LLStringUtil::stripNonprintable(line);
+				list->addCommentText(line);
+			}
+			queue->removeItemByItemID(mItemID);
+		}
+	}
+
+private:
+	LLUUID mQueueID;
+	LLUUID mItemID;
+	std::string mSource;
+};
+
+// queue the script source for compilation, it is saved out once the
+// compile thread is done with it.
+void LLFloaterCompileQueue::compile(const std::string& source,
 									const LLUUID& item_id)
 {
-	LLUUID new_asset_id;
+	LLScriptCompileThread::compileScript(source, gAgent.isGodlike(),
+										 new LLCompileQueueResponder(mID, item_id, source));
+}
+
+void LLFloaterCompileQueue::saveCompiledScript(const LLUUID& item_id, const std::string& source,
+											   const std::vector<U8>& bytecode)
+{
 	LLTransactionID tid;
 	tid.generate();
-	new_asset_id = tid.makeAssetID(gAgent.getSecureSessionID());
-	
-	std::string uuid_string;
-	new_asset_id.toString(uuid_string);
-	std::string dst_filename;
-	dst_filename = gDirUtilp->getExpandedFilename(LL_PATH_CACHE,uuid_string) + ".lso";
-	std::string err_filename;
-	err_filename = gDirUtilp->getExpandedFilename(LL_PATH_CACHE,uuid_string) + ".out";
-
-	gAssetStorage->storeAssetData(filename, tid,
-								  LLAssetType::AT_LSL_TEXT,
+	LLAssetID asset_id = tid.makeAssetID(gAgent.getSecureSessionID());
+
+	// Stage both assets in the VFS, the asset storage uploads from there.
+	LLVFile text_file(gVFS, asset_id, LLAssetType::AT_LSL_TEXT, LLVFile::APPEND);
+	text_file.setMaxSize(source.size());
+	text_file.write((const U8*)source.data(), source.size());
+	gAssetStorage->storeAssetData(tid, LLAssetType::AT_LSL_TEXT,
 								  &onSaveTextComplete, NULL, FALSE);
 
-	const BOOL compile_to_mono = FALSE;
-	if(!lscript_compile(filename.c_str(), dst_filename.c_str(),
-						err_filename.c_str(), compile_to_mono,
-						uuid_string.c_str(), gAgent.isGodlike()))
-	{
-		llwarns << "compile failed" << llendl;
-		removeItemByItemID(item_id);
-	}
-	else
-	{
-		llinfos << "compile successful." << llendl;
-		
-		// Save LSL bytecode
-		LLCompileQueueData* data = new LLCompileQueueData(mID, item_id);
-		gAssetStorage->storeAssetData(dst_filename, new_asset_id,
-									LLAssetType::AT_LSL_BYTECODE,
-									&LLFloaterCompileQueue::onSaveBytecodeComplete,
-									(void*)data, FALSE);
-	}
+	LLVFile bytecode_file(gVFS, asset_id, LLAssetType::AT_LSL_BYTECODE, LLVFile::APPEND);
+	bytecode_file.setMaxSize(bytecode.size());
+	bytecode_file.write(&bytecode[0], bytecode.size());
+	LLCompileQueueData* data = new LLCompileQueueData(mID, item_id);
+	gAssetStorage->storeAssetData(tid, LLAssetType::AT_LSL_BYTECODE,
+								  &LLFloaterCompileQueue::onSaveBytecodeComplete,
+								  (void*)data, FALSE);
 }
 
 void LLFloaterCompileQueue::removeItemByItemID(const LLUUID& asset_id)
@@ -143,6 +143,10 @@ public:
 	// remove any object in mScriptScripts with the matching uuid.
 	void removeItemByItemID(const LLUUID& item_id);
 
+	// save the source and bytecode of a successfully compiled script.
+	void saveCompiledScript(const LLUUID& item_id, const std::string& source,
+							const std::vector<U8>& bytecode);
+
 protected:
 	LLFloaterCompileQueue(const std::string& name, const LLRect& rect);
 	virtual ~LLFloaterCompileQueue();
@@ -162,8 +166,9 @@ protected:
 									   void* user_data,
 									   S32 status, LLExtStat ext_status);
 
-	// compile the file given and save it out.
-	void compile(const std::string& filename, const LLUUID& asset_id);
+	// queue the script source for compilation, it is saved out once
+	// the compile thread is done with it.
+	void compile(const std::string& source, const LLUUID& item_id);
 	
 	// remove any object in mScriptScripts with the matching uuid.
 	void removeItemByAssetID(const LLUUID& asset_id);
@@ -0,0 +1,193 @@
+/**
+ * @file llcullthread.cpp
+ * @brief Runs the frustum checks of a cull on several threads at once
+ *
+ * $LicenseInfo:firstyear=2002&license=viewergpl$
+ *
+ * Copyright (c) 2002-2009, Linden Research, Inc.
+ *
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ *
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ *
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ *
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#include "llviewerprecompiledheaders.h"
+
+#include "llcullthread.h"
+
+#include "llstl.h"
+
+//============================================================================
+
+/*static*/ LLCullThread::thread_list_t LLCullThread::sThreads;
+/*static*/ LLCondition* LLCullThread::sBatchCondition = NULL;
+/*static*/ const LLCullThread::job_list_t* LLCullThread::sJobs = NULL;
+/*static*/ S32 LLCullThread::sActiveThreads = 0;
+/*static*/ LLAtomicS32 LLCullThread::sNextJob;
+
+//============================================================================
+// Run on MAIN thread
+//static
+void LLCullThread::initClass(U32 num_threads, bool threaded)
+{
+	llassert(sThreads.empty());
+	if (!threaded)
+	{
+		return;
+	}
+	sBatchCondition = new LLCondition;
+	for (U32 i = 0; i < num_threads; i++)
+	{
+		LLCullThread* threadp = new LLCullThread();
+		threadp->start();
+		sThreads.push_back(threadp);
+	}
+}
+
+//static
+void LLCullThread::cleanupClass()
+{
+	for (thread_list_t::iterator iter = sThreads.begin(); iter != sThreads.end(); ++iter)
+	{
+		(*iter)->setQuitting();
+	}
+	for_each(sThreads.begin(), sThreads.end(), DeletePointer());
+	sThreads.clear();
+	delete sBatchCondition;
+	sBatchCondition = NULL;
+}
+
+//static
+void LLCullThread::runJobs(const job_list_t& jobs)
+{
+	if (sThreads.empty() || jobs.size() < 2)
+	{
+		for (job_list_t::const_iterator iter = jobs.begin(); iter != jobs.end(); ++iter)
+		{
+			(*iter)->run();
+		}
+		return;
+	}
+
+	sNextJob = 0;
+	sBatchCondition->lock();
+	sJobs = &jobs;
+	sBatchCondition->unlock();
+
+	// No point waking up more threads than there are jobs to share.
+	U32 num_threads = llmin((U32)sThreads.size(), (U32)jobs.size() - 1);
+	for (U32 i = 0; i < num_threads; i++)
+	{
+		LLCullThread* threadp = sThreads[i];
+		threadp->lockData();
+		threadp->mBatchPending = true;
+		threadp->wakeLocked();
+		threadp->unlockData();
+	}
+
+	runClaimedJobs(jobs);
+
+	// Every job is claimed by now; wait for those still running elsewhere,
+	// and keep threads that wake up late out of the batch.
+	sBatchCondition->lock();
+	sJobs = NULL;
+	while (sActiveThreads > 0)
+	{
+		sBatchCondition->wait();
+	}
+	sBatchCondition->unlock();
+}
+
+//static
+void LLCullThread::runClaimedJobs(const job_list_t& jobs)
+{
+	S32 num_jobs = (S32)jobs.size();
+	while (true)
+	{
+		S32 index = sNextJob++;
+		if (index >= num_jobs)
+		{
+			break;
+		}
+		jobs[index]->run();
+	}
+}
+
+//----------------------------------------------------------------------------
+
+LLCullThread::LLCullThread() :
+	LLThread("cull"),
+	mBatchPending(false)
+{
+}
+
+LLCullThread::~LLCullThread()
+{
+	shutdown();
+}
+
+//virtual
+bool LLCullThread::runCondition()
+{
+	// mRunCondition must be locked here
+	return mBatchPending;
+}
+
+//virtual
+void LLCullThread::run()
+{
+	while (1)
+	{
+		// Sleeps until runJobs() has a batch for us, or we are asked to quit.
+		checkPause();
+
+		if (isQuitting())
+		{
+			break;
+		}
+
+		lockData();
+		mBatchPending = false;
+		unlockData();
+
+		sBatchCondition->lock();
+		const job_list_t* jobs = sJobs;
+		if (jobs)
+		{
+			sActiveThreads++;
+		}
+		sBatchCondition->unlock();
+
+		if (jobs)
+		{
+			runClaimedJobs(*jobs);
+
+			sBatchCondition->lock();
+			if (--sActiveThreads == 0)
+			{
+				sBatchCondition->signal();
+			}
+			sBatchCondition->unlock();
+		}
+	}
+	llinfos << "LLCullThread " << mName << " EXITING." << llendl;
+}
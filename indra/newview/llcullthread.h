@@ -0,0 +1,144 @@
+/**
+ * @file llcullthread.h
+ * @brief Runs the frustum checks of a cull on several threads at once
+ *
+ * $LicenseInfo:firstyear=2002&license=viewergpl$
+ *
+ * Copyright (c) 2002-2009, Linden Research, Inc.
+ *
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ *
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ *
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ *
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLCULLTHREAD_H
+#define LL_LLCULLTHREAD_H
+
+#include <vector>
+
+#include "llapr.h"
+#include "llthread.h"
+
+//============================================================================
+// Fork/join pool for work that the main thread has to wait on within the
+// frame, like culling.  runJobs() hands a batch of independent jobs to the
+// pool and works through them itself too, returning once they are all done.
+// Jobs must not touch GL or anything else that isn't safe off the main
+// thread; the main thread is blocked in runJobs() while they run.
+//============================================================================
+
+class LLCullThread : public LLThread
+{
+public:
+	class Job
+	{
+	public:
+		virtual ~Job() { }
+		virtual void run() = 0;
+	};
+	typedef std::vector<Job*> job_list_t;
+
+	LLCullThread();
+	virtual ~LLCullThread();
+
+	// Run on MAIN thread
+	static void initClass(U32 num_threads, bool threaded = true);
+	static void cleanupClass();
+
+	// No threads means runJobs() simply runs the jobs in order.
+	static bool isEnabled()						{ return !sThreads.empty(); }
+	static void runJobs(const job_list_t& jobs);
+
+protected:
+	/*virtual*/ void run();
+	/*virtual*/ bool runCondition();
+
+private:
+	// Claims and runs jobs from the current batch until there are none left.
+	static void runClaimedJobs(const job_list_t& jobs);
+
+	bool mBatchPending;
+
+	typedef std::vector<LLCullThread*> thread_list_t;
+	static thread_list_t sThreads;
+
+	// The current batch, and the number of threads working on it.  Guarded
+	// by sBatchCondition, which runJobs() waits on for the count to drop.
+	static LLCondition* sBatchCondition;
+	static const job_list_t* sJobs;
+	static S32 sActiveThreads;
+	static LLAtomicS32 sNextJob;
+};
+
+// What a cull job found, for the main thread to act on once the jobs are
+// done: the groups in the order the job reached them, each with the size
+// of its subtree, so that the subtree of a group the main thread finds
+// occluded is skipped as a serial cull would have.
+template <class GROUP>
+class LLCullTrace
+{
+public:
+	void clear()							{ mEntries.clear(); }
+
+	// Records a group before its subtree, returns what endGroup() takes.
+	U32 beginGroup(GROUP* group)
+	{
+		Entry entry = { group, 0, false };
+		mEntries.push_back(entry);
+		return mEntries.size() - 1;
+	}
+	// Marks the group recorded last as passing its frustum checks.
+	void setProcess(bool process)			{ mEntries.back().mProcess = process; }
+	void endGroup(U32 index)				{ mEntries[index].mSkip = mEntries.size() - index - 1; }
+
+	// Run on MAIN thread, with a culler that has earlyFail() and processGroup().
+	template <class CULLER>
+	void replay(CULLER& culler) const
+	{
+		U32 i = 0;
+		while (i < mEntries.size())
+		{
+			const Entry& entry = mEntries[i];
+			if (culler.earlyFail(entry.mGroup))
+			{
+				i += entry.mSkip + 1;
+				continue;
+			}
+			if (entry.mProcess)
+			{
+				culler.processGroup(entry.mGroup);
+			}
+			i++;
+		}
+	}
+
+private:
+	struct Entry
+	{
+		GROUP* mGroup;
+		U32 mSkip;		// number of entries that follow for the subtree under mGroup
+		bool mProcess;
+	};
+	std::vector<Entry> mEntries;
+};
+
+#endif // LL_LLCULLTHREAD_H
@@ -0,0 +1,547 @@
+/** 
+ * @file lldecodedtexturecache.cpp
+ * @brief Disk cache of decoded texture mip levels.
+ *
+ * $LicenseInfo:firstyear=2000&license=viewergpl$
+ * 
+ * Copyright (c) 2000-2009, Linden Research, Inc.
+ * 
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ * 
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ * 
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ * 
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#include "llviewerprecompiledheaders.h"
+
+#include "lldecodedtexturecache.h"
+
+#include <algorithm>
+
+#include "lldir.h"
+#include "lldiriterator.h"
+#include "llfile.h"
+
+#ifdef LL_STANDALONE
+#include <zlib.h>
+#else
+#include "zlib/zlib.h"
+#endif
+
+// File format, native byte order since the cache never leaves this machine:
+//   header, then the raw image and the aux channel (if any) back to back,
+//   zlib compressed if FLAG_COMPRESSED.  The aux channel is the size of the
+//   raw image.
+namespace
+{
+	const U32 DECODED_CACHE_MAGIC = 0x44435854;	// "TXCD"
+	const U32 DECODED_CACHE_VERSION = 1;
+	const U32 FLAG_COMPRESSED = 0x1;
+
+	struct FileHeader
+	{
+		U32 mMagic;
+		U32 mVersion;
+		U32 mFlags;
+		U16 mWidth;
+		U16 mHeight;
+		U8 mComponents;
+		U8 mAuxComponents;
+		U16 mPad;
+		U32 mDataSize;		// Uncompressed, raw image and aux channel
+		U32 mStoredSize;	// Of what follows the header
+	};
+
+	const char* SUBDIRS = "0123456789abcdef";
+	const std::string FILE_EXTENSION(".raw");
+	const std::string TEMP_EXTENSION(".tmp");
+
+	bool sort_by_time(const std::pair<time_t, std::string>& a, const std::pair<time_t, std::string>& b)
+	{
+		return a.first < b.first;
+	}
+}
+
+//============================================================================
+
+LLDecodedTextureCache::LLDecodedTextureCache(bool threaded) :
+	LLQueuedThread("decodedtexturecache", threaded),
+	mMaxSize(0),
+	mCompress(true),
+	mReadOnly(true),
+	mUsage(0)
+{
+}
+
+LLDecodedTextureCache::~LLDecodedTextureCache()
+{
+	// ~LLQueuedThread() will be called here
+}
+
+//----------------------------------------------------------------------------
+// Run on MAIN thread
+
+void LLDecodedTextureCache::setDirName(const std::string& dirname)
+{
+	mDirName = dirname;
+}
+
+void LLDecodedTextureCache::initCache(S64 max_size, bool compress)
+{
+	llassert_always(getPending() == 0);
+	mMaxSize = max_size;
+	mCompress = compress;
+	if (mDirName.empty())
+	{
+		mMaxSize = 0;
+		return;
+	}
+	if (!isEnabled())
+	{
+		// Turned off, give the disk space back.
+		purgeAll(true);
+		return;
+	}
+
+	std::string delem = gDirUtilp->getDirDelimiter();
+	if (!mReadOnly)
+	{
+		LLFile::mkdir(mDirName);
+	}
+	std::vector<std::pair<time_t, std::string> > files;
+	for (S32 i = 0; i < 16; i++)
+	{
+		std::string dirname = mDirName + delem + SUBDIRS[i];
+		if (!mReadOnly)
+		{
+			LLFile::mkdir(dirname);
+			// Left over by a session that ended while writing.
+			gDirUtilp->deleteFilesInDir(dirname, "*" + TEMP_EXTENSION);
+		}
+		LLDirIterator iter(dirname, "*" + FILE_EXTENSION);
+		std::string filename;
+		while (iter.next(filename))
+		{
+			std::string fullpath = dirname + delem + filename;
+			llstat stat_data;
+			if (LLFile::stat(fullpath, &stat_data) == 0)
+			{
+				files.push_back(std::make_pair(stat_data.st_mtime, fullpath));
+			}
+		}
+	}
+	// Oldest first, so that the most recent end up at the front of the LRU list.
+	std::sort(files.begin(), files.end(), sort_by_time);
+
+	LLMutexLock lock(&mIndexMutex);
+	for (std::vector<std::pair<time_t, std::string> >::iterator iter = files.begin(); iter != files.end(); ++iter)
+	{
+		std::string filename = gDirUtilp->getBaseFileName(iter->second);
+		key_t key;
+		bool has_aux;
+		llstat stat_data;
+		if (!parseFileName(filename, key, has_aux) || LLFile::stat(iter->second, &stat_data) != 0)
+		{
+			if (!mReadOnly)
+			{
+				LLFile::remove(iter->second);
+			}
+			continue;
+		}
+		addEntry(key, (S64)stat_data.st_size, has_aux);
+	}
+	evict();
+	LL_INFOS("TextureCache") << "Decoded textures: " << mEntries.size() << " entries, "
+							 << mUsage / (1024 * 1024) << " of " << mMaxSize / (1024 * 1024) << " MB" << LL_ENDL;
+}
+
+void LLDecodedTextureCache::purgeAll(bool purge_directories)
+{
+	LLMutexLock lock(&mIndexMutex);
+	if (!mReadOnly && !mDirName.empty())
+	{
+		std::string delem = gDirUtilp->getDirDelimiter();
+		for (S32 i = 0; i < 16; i++)
+		{
+			std::string dirname = mDirName + delem + SUBDIRS[i];
+			gDirUtilp->deleteFilesInDir(dirname, "*");
+			if (purge_directories)
+			{
+				LLFile::rmdir(dirname);
+			}
+		}
+		if (purge_directories)
+		{
+			LLFile::rmdir(mDirName);
+		}
+	}
+	mEntries.clear();
+	mLRU.clear();
+	mUsage = 0;
+}
+
+//----------------------------------------------------------------------------
+// Any thread
+
+bool LLDecodedTextureCache::read(const LLUUID& id, S32 max_discard, bool needs_aux, S32& discard,
+								 LLPointer<LLImageRaw>& raw, LLPointer<LLImageRaw>& aux)
+{
+	if (!isEnabled() || max_discard < 0)
+	{
+		return false;
+	}
+
+	key_t key;
+	bool has_aux = false;
+	{
+		LLMutexLock lock(&mIndexMutex);
+		entry_map_t::iterator iter = mEntries.upper_bound(key_t(id, max_discard));
+		bool found = false;
+		while (!found && iter != mEntries.begin())
+		{
+			--iter;
+			if (iter->first.first != id)
+			{
+				break;
+			}
+			found = !needs_aux || iter->second.mHasAux;
+		}
+		if (!found)
+		{
+			return false;
+		}
+		mLRU.splice(mLRU.begin(), mLRU, iter->second.mLRU);
+		key = iter->first;
+		has_aux = iter->second.mHasAux;
+	}
+
+	std::string filename = getFileName(key, has_aux);
+	LLPointer<LLImageRaw> new_raw;
+	LLPointer<LLImageRaw> new_aux;
+	bool success = false;
+	LLFILE* fp = LLFile::fopen(filename, "rb");
+	if (fp)
+	{
+		FileHeader header;
+		if (fread(&header, sizeof(FileHeader), 1, fp) == 1 &&
+			header.mMagic == DECODED_CACHE_MAGIC &&
+			header.mVersion == DECODED_CACHE_VERSION &&
+			header.mWidth && header.mHeight &&
+			header.mComponents >= 1 && header.mComponents <= 4 &&
+			header.mAuxComponents <= 4 &&
+			(header.mAuxComponents != 0) == has_aux)
+		{
+			U32 pixels = (U32)header.mWidth * (U32)header.mHeight;
+			U32 raw_size = pixels * header.mComponents;
+			U32 aux_size = pixels * header.mAuxComponents;
+			if (header.mDataSize == raw_size + aux_size)
+			{
+				new_raw = new LLImageRaw(header.mWidth, header.mHeight, header.mComponents);
+				if (has_aux)
+				{
+					new_aux = new LLImageRaw(header.mWidth, header.mHeight, header.mAuxComponents);
+				}
+				if (!new_raw->getData() || (new_aux.notNull() && !new_aux->getData()))
+				{
+					// Out of memory
+				}
+				else if (header.mFlags & FLAG_COMPRESSED)
+				{
+					std::vector<U8> stored(header.mStoredSize);
+					if (header.mStoredSize && fread(&stored[0], header.mStoredSize, 1, fp) == 1)
+					{
+						uLongf size = raw_size;
+						if (!has_aux)
+						{
+							success = uncompress(new_raw->getData(), &size, &stored[0], header.mStoredSize) == Z_OK &&
+									  size == raw_size;
+						}
+						else
+						{
+							std::vector<U8> data(header.mDataSize);
+							size = header.mDataSize;
+							success = uncompress(&data[0], &size, &stored[0], header.mStoredSize) == Z_OK &&
+									  size == header.mDataSize;
+							if (success)
+							{
+								memcpy(new_raw->getData(), &data[0], raw_size);	/* Flawfinder: ignore */
+								memcpy(new_aux->getData(), &data[raw_size], aux_size);	/* Flawfinder: ignore */
+							}
+						}
+					}
+				}
+				else if (header.mStoredSize == header.mDataSize)
+				{
+					success = fread(new_raw->getData(), raw_size, 1, fp) == 1 &&
+							  (!has_aux || fread(new_aux->getData(), aux_size, 1, fp) == 1);
+				}
+			}
+		}
+		fclose(fp);
+	}
+
+	if (!success)
+	{
+		LL_WARNS("TextureCache") << "Dropping unreadable decoded texture " << filename << LL_ENDL;
+		LLMutexLock lock(&mIndexMutex);
+		entry_map_t::iterator iter = mEntries.find(key);
+		if (iter != mEntries.end())
+		{
+			if (!mReadOnly)
+			{
+				LLFile::remove(filename);
+			}
+			eraseEntry(iter);
+		}
+		return false;
+	}
+
+	discard = key.second;
+	raw = new_raw;
+	aux = new_aux;
+	return true;
+}
+
+void LLDecodedTextureCache::write(const LLUUID& id, S32 discard, LLImageRaw* raw, LLImageRaw* aux)
+{
+	if (!isEnabled() || mReadOnly || discard < 0 || !raw || !raw->getData() ||
+		(aux && (!aux->getData() || aux->getWidth() != raw->getWidth() || aux->getHeight() != raw->getHeight())))
+	{
+		return;
+	}
+	key_t key(id, discard);
+	{
+		LLMutexLock lock(&mIndexMutex);
+		if (mEntries.count(key) || !mPending.insert(key).second)
+		{
+			return;
+		}
+	}
+	addRequest(new WriteRequest(this, generateHandle(), id, discard, raw, aux));
+}
+
+void LLDecodedTextureCache::remove(const LLUUID& id)
+{
+	LLMutexLock lock(&mIndexMutex);
+	entry_map_t::iterator iter = mEntries.lower_bound(key_t(id, 0));
+	while (iter != mEntries.end() && iter->first.first == id)
+	{
+		if (!mReadOnly)
+		{
+			LLFile::remove(getFileName(iter->first, iter->second.mHasAux));
+		}
+		eraseEntry(iter++);
+	}
+}
+
+S64 LLDecodedTextureCache::getUsage()
+{
+	LLMutexLock lock(&mIndexMutex);
+	return mUsage;
+}
+
+S32 LLDecodedTextureCache::getNumEntries()
+{
+	LLMutexLock lock(&mIndexMutex);
+	return (S32)mEntries.size();
+}
+
+//----------------------------------------------------------------------------
+
+// <dir>/<first digit of id>/<id>_<discard>[a].raw, the 'a' marking an aux channel
+std::string LLDecodedTextureCache::getFileName(const key_t& key, bool has_aux) const
+{
+	std::string idstr = key.first.asString();
+	std::string delem = gDirUtilp->getDirDelimiter();
+	return mDirName + delem + idstr[0] + delem + idstr + llformat("_%d", key.second) +
+		   (has_aux ? "a" : "") + FILE_EXTENSION;
+}
+
+bool LLDecodedTextureCache::parseFileName(const std::string& filename, key_t& key, bool& has_aux) const
+{
+	const size_t id_length = UUID_STR_LENGTH - 1;
+	if (filename.length() < id_length + 2 + FILE_EXTENSION.length() ||
+		filename[id_length] != '_' ||
+		filename.compare(filename.length() - FILE_EXTENSION.length(), std::string::npos, FILE_EXTENSION) != 0)
+	{
+		return false;
+	}
+	std::string idstr = filename.substr(0, id_length);
+	if (!LLUUID::validate(idstr))
+	{
+		return false;
+	}
+	std::string level = filename.substr(id_length + 1, filename.length() - FILE_EXTENSION.length() - id_length - 1);
+	has_aux = !level.empty() && level[level.length() - 1] == 'a';
+	if (has_aux)
+	{
+		level.erase(level.length() - 1);
+	}
+	if (level.empty() || level.length() > 2 || level.find_first_not_of("0123456789") != std::string::npos)
+	{
+		return false;
+	}
+	key.first.set(idstr);
+	key.second = atoi(level.c_str());
+	return true;
+}
+
+void LLDecodedTextureCache::addEntry(const key_t& key, S64 size, bool has_aux)
+{
+	entry_map_t::iterator iter = mEntries.find(key);
+	if (iter != mEntries.end())
+	{
+		eraseEntry(iter);
+	}
+	mLRU.push_front(key);
+	Entry& entry = mEntries[key];
+	entry.mSize = size;
+	entry.mHasAux = has_aux;
+	entry.mLRU = mLRU.begin();
+	mUsage += size;
+}
+
+void LLDecodedTextureCache::eraseEntry(entry_map_t::iterator iter)
+{
+	mUsage -= iter->second.mSize;
+	mLRU.erase(iter->second.mLRU);
+	mEntries.erase(iter);
+}
+
+void LLDecodedTextureCache::evict()
+{
+	while (mUsage > mMaxSize && !mLRU.empty())
+	{
+		entry_map_t::iterator iter = mEntries.find(mLRU.back());
+		llassert_always(iter != mEntries.end());
+		if (!mReadOnly)
+		{
+			LLFile::remove(getFileName(iter->first, iter->second.mHasAux));
+		}
+		eraseEntry(iter);
+	}
+}
+
+void LLDecodedTextureCache::entryWritten(const key_t& key, S64 size, bool has_aux)
+{
+	LLMutexLock lock(&mIndexMutex);
+	addEntry(key, size, has_aux);
+	evict();
+}
+
+void LLDecodedTextureCache::writeDone(const key_t& key)
+{
+	LLMutexLock lock(&mIndexMutex);
+	mPending.erase(key);
+}
+
+//----------------------------------------------------------------------------
+
+LLDecodedTextureCache::WriteRequest::WriteRequest(LLDecodedTextureCache* cache, handle_t handle,
+												  const LLUUID& id, S32 discard,
+												  LLImageRaw* raw, LLImageRaw* aux) :
+	LLQueuedThread::QueuedRequest(handle, PRIORITY_LOW, FLAG_AUTO_COMPLETE),
+	mCache(cache),
+	mID(id),
+	mDiscard(discard),
+	mWidth(raw->getWidth()),
+	mHeight(raw->getHeight()),
+	mComponents(raw->getComponents()),
+	mAuxComponents(aux ? aux->getComponents() : 0)
+{
+	const U8* data = raw->getData();
+	mData.reserve(raw->getDataSize() + (aux ? aux->getDataSize() : 0));
+	mData.assign(data, data + raw->getDataSize());
+	if (aux)
+	{
+		const U8* aux_data = aux->getData();
+		mData.insert(mData.end(), aux_data, aux_data + aux->getDataSize());
+	}
+}
+
+LLDecodedTextureCache::WriteRequest::~WriteRequest()
+{
+}
+
+bool LLDecodedTextureCache::WriteRequest::processRequest()
+{
+	FileHeader header;
+	memset(&header, 0, sizeof(FileHeader));	/* Flawfinder: ignore */
+	header.mMagic = DECODED_CACHE_MAGIC;
+	header.mVersion = DECODED_CACHE_VERSION;
+	header.mWidth = mWidth;
+	header.mHeight = mHeight;
+	header.mComponents = (U8)mComponents;
+	header.mAuxComponents = (U8)mAuxComponents;
+	header.mDataSize = (U32)mData.size();
+
+	const U8* body = &mData[0];
+	uLongf body_size = mData.size();
+	std::vector<U8> packed;
+	if (mCache->mCompress)
+	{
+		uLongf packed_size = compressBound(body_size);
+		packed.resize(packed_size);
+		if (compress2(&packed[0], &packed_size, body, body_size, Z_BEST_SPEED) == Z_OK &&
+			packed_size < body_size)
+		{
+			header.mFlags |= FLAG_COMPRESSED;
+			body = &packed[0];
+			body_size = packed_size;
+		}
+	}
+	header.mStoredSize = (U32)body_size;
+
+	// Written under a temporary name first, so that a lookup never sees half a file.
+	key_t key(mID, mDiscard);
+	bool has_aux = mAuxComponents != 0;
+	std::string filename = mCache->getFileName(key, has_aux);
+	std::string temp_filename = filename + TEMP_EXTENSION;
+	LLFILE* fp = LLFile::fopen(temp_filename, "wb");
+	if (!fp)
+	{
+		return true;
+	}
+	bool success = fwrite(&header, sizeof(FileHeader), 1, fp) == 1 &&
+				   fwrite(body, body_size, 1, fp) == 1;
+	success = (fclose(fp) == 0) && success;
+	if (success)
+	{
+		LLFile::remove(filename);
+		success = LLFile::rename(temp_filename, filename) == 0;
+	}
+	if (success)
+	{
+		mCache->entryWritten(key, (S64)(sizeof(FileHeader) + body_size), has_aux);
+	}
+	else
+	{
+		LL_WARNS("TextureCache") << "Failed to write decoded texture " << filename << LL_ENDL;
+		LLFile::remove(temp_filename);
+	}
+	return true;
+}
+
+void LLDecodedTextureCache::WriteRequest::finishRequest(bool completed)
+{
+	mCache->writeDone(key_t(mID, mDiscard));
+	// Will automatically be deleted
+}
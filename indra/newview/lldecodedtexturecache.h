@@ -0,0 +1,151 @@
+/** 
+ * @file lldecodedtexturecache.h
+ * @brief Disk cache of decoded texture mip levels.
+ *
+ * $LicenseInfo:firstyear=2000&license=viewergpl$
+ * 
+ * Copyright (c) 2000-2009, Linden Research, Inc.
+ * 
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ * 
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ * 
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ * 
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLDECODEDTEXTURECACHE_H
+#define LL_LLDECODEDTEXTURECACHE_H
+
+#include <list>
+#include <map>
+#include <set>
+#include <vector>
+
+#include "llimage.h"
+#include "llqueuedthread.h"
+#include "lluuid.h"
+
+//============================================================================
+// Second tier of the texture cache: mip levels as they came out of the
+// decoder, so that a texture seen on an earlier visit can be handed to the
+// viewer without going through the J2C decoder again.
+//
+// Entries are keyed by texture id and discard level, one file each under
+// texturecache/decoded, optionally zlib compressed at its fastest setting.
+// It has its own size budget and evicts least recently used entries first
+// (across sessions, by file modification time).
+//
+// Lookups read the file on the calling thread (the texture fetch thread);
+// stores are queued and written out on this thread.
+//============================================================================
+
+class LLDecodedTextureCache : public LLQueuedThread
+{
+	LOG_CLASS(LLDecodedTextureCache);
+
+public:
+	class WriteRequest : public LLQueuedThread::QueuedRequest
+	{
+	protected:
+		virtual ~WriteRequest(); // use deleteRequest()
+
+	public:
+		WriteRequest(LLDecodedTextureCache* cache, handle_t handle, const LLUUID& id, S32 discard,
+					 LLImageRaw* raw, LLImageRaw* aux);
+
+		/*virtual*/ bool processRequest();
+		/*virtual*/ void finishRequest(bool completed);
+
+	private:
+		LLDecodedTextureCache* mCache;
+		LLUUID mID;
+		S32 mDiscard;
+		U16 mWidth;
+		U16 mHeight;
+		S8 mComponents;
+		S8 mAuxComponents;
+		// The images may be changed once handed over to the viewer, take a copy.
+		std::vector<U8> mData;
+	};
+
+public:
+	LLDecodedTextureCache(bool threaded = true);
+	virtual ~LLDecodedTextureCache();
+
+	// Run on MAIN thread, before any texture is fetched
+	void setDirName(const std::string& dirname);
+	void setReadOnly(bool read_only)					{ mReadOnly = read_only; }
+	void initCache(S64 max_size, bool compress);
+	// Removes every entry, and the directories too if purge_directories.
+	void purgeAll(bool purge_directories);
+
+	bool isEnabled() const								{ return mMaxSize > 0; }
+
+	// Reads back the lowest resolution level stored for id that is at least
+	// as sharp as max_discard, with an aux channel if needs_aux.  Returns
+	// false if there is none, or it could not be read (it is dropped then).
+	bool read(const LLUUID& id, S32 max_discard, bool needs_aux, S32& discard,
+			  LLPointer<LLImageRaw>& raw, LLPointer<LLImageRaw>& aux);
+	// Queues a copy of that level to be stored, unless it already is.
+	void write(const LLUUID& id, S32 discard, LLImageRaw* raw, LLImageRaw* aux);
+	// Forgets every level of id.
+	void remove(const LLUUID& id);
+
+	// debug
+	S64 getUsage();
+	S64 getMaxUsage() const								{ return mMaxSize; }
+	S32 getNumEntries();
+
+private:
+	typedef std::pair<LLUUID, S32> key_t;
+	typedef std::list<key_t> lru_list_t;
+	struct Entry
+	{
+		S64 mSize;
+		bool mHasAux;
+		lru_list_t::iterator mLRU;
+	};
+	typedef std::map<key_t, Entry> entry_map_t;
+
+	std::string getFileName(const key_t& key, bool has_aux) const;
+	bool parseFileName(const std::string& filename, key_t& key, bool& has_aux) const;
+	// Call with mIndexMutex locked
+	void addEntry(const key_t& key, S64 size, bool has_aux);
+	void eraseEntry(entry_map_t::iterator iter);
+	// Drops least recently used entries until the cache fits its budget.
+	void evict();
+
+	// Called from WriteRequest, on this thread.
+	void entryWritten(const key_t& key, S64 size, bool has_aux);
+	void writeDone(const key_t& key);
+
+	std::string mDirName;
+	S64 mMaxSize;
+	bool mCompress;
+	bool mReadOnly;
+
+	LLMutex mIndexMutex;
+	entry_map_t mEntries;
+	lru_list_t mLRU;			// most recently used first
+	std::set<key_t> mPending;	// queued for writing
+	S64 mUsage;
+};
+
+#endif // LL_LLDECODEDTEXTURECACHE_H
@@ -77,6 +77,8 @@ namespace
 									const std::string& reason,
 									const LLChannelDescriptors& channels,
 									const LLIOPipe::buffer_ptr_t& buffer);
+
+		virtual LLCurl::EPriority getPriority()	{ return LLCurl::PRIORITY_EVENT_POLL; }
 	private:
 
 		bool	mDone;
@@ -679,6 +679,45 @@ static void xform(LLVector2 &tex_coord, F32 cosAng, F32 sinAng, F32 offS, F32 of
 	tex_coord.mV[1] = t;
 }
 
+// xform() for a whole array of texture coordinates, two at a time.
+static void xform_array(LLStrider<LLVector2>& dst, const LLVector2* src, S32 count, F32 cosAng, F32 sinAng, F32 offS, F32 offT, F32 magS, F32 magT)
+{
+	LLVector4a half(0.5f);
+	LLVector4a cos_ang(cosAng);
+	LLVector4a sin_ang(sinAng, -sinAng, sinAng, -sinAng);
+	LLVector4a mag(magS, magT, magS, magT);
+	LLVector4a off(offS + 0.5f, offT + 0.5f, offS + 0.5f, offT + 0.5f);
+
+	S32 i = 0;
+	for (; i + 1 < count; i += 2)
+	{
+		// s0 t0 s1 t1
+		LLVector4a tc;
+		tc.loadua(src[i].mV);
+		tc.sub(half);
+
+		// Rotation: s' = s*cos + t*sin, t' = t*cos - s*sin
+		LLVector4a swapped = _mm_shuffle_ps(tc, tc, _MM_SHUFFLE(2, 3, 0, 1));
+		tc.mul(cos_ang);
+		swapped.mul(sin_ang);
+		tc.add(swapped);
+
+		tc.mul(mag);
+		tc.add(off);
+
+		const F32* res = tc.getF32ptr();
+		(*dst++).set(res[0], res[1]);
+		(*dst++).set(res[2], res[3]);
+	}
+
+	if (i < count)
+	{
+		LLVector2 tc(src[i]);
+		xform(tc, cosAng, sinAng, offS, offT, magS, magT);
+		*dst++ = tc;
+	}
+}
+
 
 bool less_than_max_mag(const LLVector4a& vec)
 {
@@ -1030,6 +1069,17 @@ BOOL LLFace::getGeometryVolume(const LLVolume& volume,
 								const LLMatrix4& mat_vert_in, const LLMatrix3& mat_norm_in,
 								const U16 &index_offset,
 								bool force_rebuild)
+{
+	if (!prepareGeometryVolume(volume, f, force_rebuild))
+	{
+		return FALSE;
+	}
+
+	fillGeometryVolume(volume, f, mat_vert_in, mat_norm_in, index_offset, force_rebuild);
+	return TRUE;
+}
+
+BOOL LLFace::prepareGeometryVolume(const LLVolume& volume, const S32 &f, bool force_rebuild)
 {
 	llassert(verify());
 	const LLVolumeFace &vf = volume.getVolumeFace(f);
@@ -1059,6 +1109,67 @@ BOOL LLFace::getGeometryVolume(const LLVolume& volume,
 		}
 	}
 
+	BOOL full_rebuild = force_rebuild || mDrawablep->isState(LLDrawable::REBUILD_VOLUME);
+	bool rebuild_pos = full_rebuild || mDrawablep->isState(LLDrawable::REBUILD_POSITION);
+	bool rebuild_color = full_rebuild || mDrawablep->isState(LLDrawable::REBUILD_COLOR);
+	bool rebuild_tcoord = full_rebuild || mDrawablep->isState(LLDrawable::REBUILD_TCOORD);
+
+	if (mDrawablep->isStatic())
+	{
+		setState(GLOBAL);
+	}
+	else
+	{
+		clearState(GLOBAL);
+	}
+
+	if (rebuild_tcoord)
+	{
+		// The volume may be shared with other objects, generate its
+		// binormals here rather than from the fill.
+		const LLTextureEntry *tep = mVObjp->getTE(f);
+		U8 bump_code = tep ? tep->getBumpmap() : 0;
+		if (bump_code || getTextureEntry()->getTexGen() != LLTextureEntry::TEX_GEN_DEFAULT)
+		{
+			mVObjp->getVolume()->genBinormals(f);
+		}
+
+		if (isState(TEXTURE_ANIM) && !((LLVOVolume*) (LLViewerObject*) mVObjp)->mTexAnimMode)
+		{
+			clearState(TEXTURE_ANIM);
+		}
+	}
+
+	// Map the buffer now, from then on getting a strider into it is only
+	// pointer arithmetic.
+	if (full_rebuild)
+	{
+		mVertexBuffer->mapIndexBuffer(mIndicesIndex);
+	}
+	if (rebuild_pos || rebuild_color || rebuild_tcoord)
+	{
+		mVertexBuffer->mapVertexBuffer(LLVertexBuffer::TYPE_VERTEX, mGeomIndex);
+	}
+
+	mLastVertexBuffer = mVertexBuffer;
+	mLastGeomCount = mGeomCount;
+	mLastGeomIndex = mGeomIndex;
+	mLastIndicesCount = mIndicesCount;
+	mLastIndicesIndex = mIndicesIndex;
+
+	return TRUE;
+}
+
+void LLFace::fillGeometryVolume(const LLVolume& volume,
+								const S32 &f,
+								const LLMatrix4& mat_vert_in, const LLMatrix3& mat_norm_in,
+								const U16 &index_offset,
+								bool force_rebuild)
+{
+	const LLVolumeFace &vf = volume.getVolumeFace(f);
+	S32 num_vertices = (S32)vf.mNumVertices;
+	S32 num_indices = (S32) vf.mNumIndices;
+
 	LLStrider<LLVector3> vertices;
 	LLStrider<LLVector2> tex_coords;
 	LLStrider<LLVector2> tex_coords2;
@@ -1098,20 +1209,6 @@ BOOL LLFace::getGeometryVolume(const LLVolume& volume,
 
 
 	
-	BOOL is_static = mDrawablep->isStatic();
-	BOOL is_global = is_static;
-
-	LLVector3 center_sum(0.f, 0.f, 0.f);
-	
-	if (is_global)
-	{
-		setState(GLOBAL);
-	}
-	else
-	{
-		clearState(GLOBAL);
-	}
-
 	LLColor4U color = (tep ? LLColor4U(tep->getColor()) : LLColor4U::white);
 
 	if (rebuild_color)	// FALSE if tep == NULL
@@ -1200,7 +1297,6 @@ BOOL LLFace::getGeometryVolume(const LLVolume& volume,
 		
 		if (bump_code)
 		{
-			mVObjp->getVolume()->genBinormals(f);
 			F32 offset_multiple; 
 			switch( bump_code )
 			{
@@ -1247,10 +1343,6 @@ BOOL LLFace::getGeometryVolume(const LLVolume& volume,
 		}
 
 		U8 texgen = getTextureEntry()->getTexGen();
-		if (rebuild_tcoord && texgen != LLTextureEntry::TEX_GEN_DEFAULT)
-		{ //planar texgen needs binormals
-			mVObjp->getVolume()->genBinormals(f);
-		}
 
 		U8 tex_mode = 0;
 	
@@ -1259,11 +1351,7 @@ BOOL LLFace::getGeometryVolume(const LLVolume& volume,
 			LLVOVolume* vobj = (LLVOVolume*) (LLViewerObject*) mVObjp;	
 			tex_mode = vobj->mTexAnimMode;
 
-			if (!tex_mode)
-			{
-				clearState(TEXTURE_ANIM);
-			}
-			else
+			if (tex_mode)
 			{
 				os = ot = 0.f;
 				r = 0.f;
@@ -1300,12 +1388,7 @@ BOOL LLFace::getGeometryVolume(const LLVolume& volume,
 					}
 					else
 					{
-						for (S32 i = 0; i < num_vertices; i++)
-						{	
-							LLVector2 tc(vf.mTexCoords[i]);
-							xform(tc, cos_ang, sin_ang, os, ot, ms, mt);
-							*tex_coords++ = tc;	
-						}
+						xform_array(tex_coords, vf.mTexCoords, num_vertices, cos_ang, sin_ang, os, ot, ms, mt);
 					}
 				}
 				else
@@ -1542,14 +1625,6 @@ BOOL LLFace::getGeometryVolume(const LLVolume& volume,
 		mTexExtents[0][1] *= et ;
 		mTexExtents[1][1] *= et ;
 	}
-
-	mLastVertexBuffer = mVertexBuffer;
-	mLastGeomCount = mGeomCount;
-	mLastGeomIndex = mGeomIndex;
-	mLastIndicesCount = mIndicesCount;
-	mLastIndicesIndex = mIndicesIndex;
-
-	return TRUE;
 }
 
 const F32 LEAST_IMPORTANCE = 0.05f ;
@@ -2012,4 +2087,4 @@ void LLFace::setRiggedIndex(U32 type, S32 index)
 }
 
 
-#endif //MESH_ENABLED
\ No newline at end of file
+#endif //MESH_ENABLED
\ No newline at end of file
@@ -165,6 +165,18 @@ public:
 						const U16 &index_offset,
 						bool force_rebuild = false);
 
+	// getGeometryVolume() in two steps, for filling many faces in parallel.
+	// prepareGeometryVolume() checks the face fits its buffer, maps the
+	// buffer and updates shared state, it must be called on the main thread.
+	// fillGeometryVolume() then only writes this face's range of the buffer
+	// and may run on any thread, as long as the buffer stays mapped.
+	BOOL prepareGeometryVolume(const LLVolume& volume, const S32 &f, bool force_rebuild = false);
+	void fillGeometryVolume(const LLVolume& volume,
+						const S32 &f,
+						const LLMatrix4& mat_vert, const LLMatrix3& mat_normal,
+						const U16 &index_offset,
+						bool force_rebuild = false);
+
 	// For avatar
 	U16			 getGeometryAvatar(
 									LLStrider<LLVector3> &vertices,
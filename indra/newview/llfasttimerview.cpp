@@ -49,6 +49,8 @@
 #include "llstat.h"
 
 #include "llfasttimer.h"
+#include "lldir.h"
+#include "llfile.h"
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -281,6 +283,7 @@ LLFastTimerView::LLFastTimerView(const std::string& name, const LLRect& rect)
 			llassert(level < FTV_DISPLAY_NUM);
 			ft_display_table[i].desc = text;
 			ft_display_table[i].level = level;
+			LLFastTimer::setTypeName((LLFastTimer::EFastTimerType)ft_display_table[i].timer, text);
 			if (level > 0)
 			{
 				ft_display_table[i].parent = pidx[level-1];
@@ -361,6 +364,10 @@ BOOL LLFastTimerView::handleMouseDown(S32 x, S32 y, MASK mask)
 			}
 		}
 	}
+	else if ((mask & (MASK_CONTROL | MASK_SHIFT)) == (MASK_CONTROL | MASK_SHIFT))
+	{
+		writeTrace();
+	}
 	else if (mask & MASK_ALT)
 	{
 		if (mask & MASK_SHIFT)
@@ -459,6 +466,27 @@ BOOL LLFastTimerView::handleScrollWheel(S32 x, S32 y, S32 clicks)
 	return TRUE;
 }
 
+// Ctrl-Shift-click: turns tracing on, or if it is on writes out the last
+// FastTimerTraceSeconds of all threads.
+void LLFastTimerView::writeTrace()
+{
+	if (!LLFastTimer::isTracing())
+	{
+		gSavedSettings.setBOOL("FastTimerTrace", TRUE);
+		return;
+	}
+
+	std::string filename = gDirUtilp->getExpandedFilename(LL_PATH_LOGS, "fasttimers.json");
+	llofstream file(filename);
+	if (!file.is_open())
+	{
+		llwarns << "Unable to open " << filename << llendl;
+		return;
+	}
+	LLFastTimer::writeTrace(file, gSavedSettings.getF32("FastTimerTraceSeconds"));
+	llinfos << "Wrote fast timer trace to " << filename << llendl;
+}
+
 void LLFastTimerView::onClose(bool app_quitting)
 {
 	if (app_quitting)
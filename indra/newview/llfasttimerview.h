@@ -54,6 +54,8 @@ public:
 	F64 getTime(LLFastTimer::EFastTimerType tidx);
 	
 private:	
+	void writeTrace();
+
 	S32* mBarStart;
 	S32* mBarEnd;
 	S32 mDisplayMode;
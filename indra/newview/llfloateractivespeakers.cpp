@@ -428,6 +428,18 @@ void LLPanelActiveSpeakers::handleSpeakerSelect()
 	}
 }
 
+// What the list sorts a row by, to tell whether refreshing it moved it.
+static std::string row_sort_text(LLScrollListItem* itemp)
+{
+	std::string text;
+	for (S32 i = 0; i < itemp->getNumColumns(); i++)
+	{
+		text += itemp->getColumn(i)->getValue().asString();
+		text += '\n';
+	}
+	return text;
+}
+
 void LLPanelActiveSpeakers::refreshSpeakers()
 {
 	// store off current selection and scroll state to preserve across list rebuilds
@@ -456,6 +468,8 @@ void LLPanelActiveSpeakers::refreshSpeakers()
 
 	LLSpeakerMgr::speaker_list_t speaker_list;
 	mSpeakerMgr->getSpeakerList(&speaker_list, mShowTextChatters);
+	// rows whose text changed, they may have to move
+	std::vector<LLScrollListItem*> edited_items;
 	for (std::vector<LLScrollListItem*>::iterator item_it = items.begin();
 		item_it != items.end();
 		++item_it)
@@ -469,6 +483,8 @@ void LLPanelActiveSpeakers::refreshSpeakers()
 			continue;
 		}
 
+		std::string old_sort_text = row_sort_text(itemp);
+
 		// since we are forced to sort by text, encode sort order as string
 		std::string speaking_order_sort_string = llformat("%010d", speakerp->mSortIndex);
 
@@ -590,10 +606,15 @@ void LLPanelActiveSpeakers::refreshSpeakers()
 			// print speaking ordinal in a text-sorting friendly manner
 			speaking_status_cell->setValue(speaking_order_sort_string);
 		}
+
+		if (row_sort_text(itemp) != old_sort_text)
+		{
+			edited_items.push_back(itemp);
+		}
 	}
 	
-	// we potentially modified the sort order by touching the list items
-	mSpeakerList->setSorted(FALSE);
+	// move just the rows we changed back into sort order
+	mSpeakerList->resortItems(edited_items);
 
 	LLPointer<LLSpeaker> selected_speakerp = mSpeakerMgr->findSpeaker(selected_id);
 	// update UI for selected participant
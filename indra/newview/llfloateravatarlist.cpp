@@ -49,6 +49,7 @@
 #include <string.h>
 
 #include <map>
+#include <algorithm>
 
 
 #include "llworld.h"
@@ -216,7 +217,10 @@ BOOL LLAvatarListEntry::isDead()
 
 LLFloaterAvatarList* LLFloaterAvatarList::sInstance = NULL;
 
-LLFloaterAvatarList::LLFloaterAvatarList() :  LLFloater(std::string("radar"))
+LLFloaterAvatarList::LLFloaterAvatarList() :  LLFloater(std::string("radar")),
+	mAvatarList(NULL),
+	mSortColumn(LIST_DISTANCE),
+	mSortAscending(TRUE)
 {
 	llassert_always(sInstance == NULL);
 	sInstance = this;
@@ -226,6 +230,10 @@ LLFloaterAvatarList::LLFloaterAvatarList() :  LLFloater(std::string("radar"))
 LLFloaterAvatarList::~LLFloaterAvatarList()
 {
 	gIdleCallbacks.deleteFunction(LLFloaterAvatarList::callbackIdle);
+	if (mAvatarList)
+	{
+		mAvatarList->setDataSource(NULL);
+	}
 	sInstance = NULL;
 }
 //static
@@ -372,6 +380,7 @@ BOOL LLFloaterAvatarList::postBuild()
 	mAvatarList->setCallbackUserData(this);
 	mAvatarList->setCommitCallback(onSelectName);
 	mAvatarList->setDoubleClickCallback(onClickFocus);
+	mAvatarList->setDataSource(this);
 	refreshAvatarList();
 
 	gIdleCallbacks.addFunction(LLFloaterAvatarList::callbackIdle);
@@ -624,13 +633,9 @@ void LLFloaterAvatarList::refreshAvatarList()
 	// Don't update list when interface is hidden
 	if (!sInstance->getVisible()) return;
 
-	// We rebuild the list fully each time it's refreshed
-	// The assumption is that it's faster to refill it and sort than
-	// to rebuild the whole list.
-	LLDynamicArray<LLUUID> selected = mAvatarList->getSelectedIDs();
-	S32 scrollpos = mAvatarList->getScrollPos();
-
-	mAvatarList->deleteAllItems();
+	// We rebuild the rows fully each time it's refreshed. The list only
+	// builds items for the visible ones and keeps the selection by id.
+	mRows.clear();
 
 	LLVector3d mypos = gAgent.getPositionGlobal();
 	LLVector3d posagent;
@@ -872,18 +877,46 @@ void LLFloaterAvatarList::refreshAvatarList()
 		element["columns"][LIST_CLIENT]["color"] = client_color.getValue();
 
 		// Add to list
-		mAvatarList->addElement(element, ADD_BOTTOM);
+		mRows.push_back(element);
 	}
 
 	// finish
-	mAvatarList->sortItems();
-	mAvatarList->selectMultiple(selected);
-	mAvatarList->setScrollPos(scrollpos);
+	std::stable_sort(mRows.begin(), mRows.end(), sort_rows(mSortColumn, mSortAscending));
+	mAvatarList->dataChanged();
 
 //	llinfos << "radar refresh: done" << llendl;
 
 }
 
+S32 LLFloaterAvatarList::getRowCount() const
+{
+	return mRows.size();
+}
+
+LLSD LLFloaterAvatarList::getRow(S32 index) const
+{
+	return mRows[index];
+}
+
+void LLFloaterAvatarList::sortRows(S32 column, BOOL ascending)
+{
+	if (column < LIST_MARK || column > LIST_CLIENT)
+	{
+		return;
+	}
+	mSortColumn = column;
+	mSortAscending = ascending;
+	std::stable_sort(mRows.begin(), mRows.end(), sort_rows(column, ascending));
+}
+
+// Same order as the list sorts text cells in
+bool LLFloaterAvatarList::sort_rows::operator()(const LLSD& lhs, const LLSD& rhs) const
+{
+	S32 order = LLStringUtil::compareDict(lhs["columns"][mColumn]["value"].asString(),
+										  rhs["columns"][mColumn]["value"].asString());
+	return mAscending ? order < 0 : order > 0;
+}
+
 // static
 void LLFloaterAvatarList::onClickIM(void* userdata)
 {
@@ -936,10 +969,8 @@ void LLFloaterAvatarList::onClickTrack(void *userdata)
 {
 	LLFloaterAvatarList *self = (LLFloaterAvatarList*)userdata;
 	
- 	LLScrollListItem *item =   self->mAvatarList->getFirstSelected();
-	if (!item) return;
-
-	LLUUID agent_id = item->getUUID();
+ 	LLUUID agent_id = self->getSelectedID();
+	if (agent_id.isNull()) return;
 
 	if (self->mTracking && self->mTrackedAvatar == agent_id) {
 		LLTracker::stopTracking(NULL);
@@ -1024,10 +1055,10 @@ void LLFloaterAvatarList::onClickFocus(void *userdata)
 {
 	LLFloaterAvatarList *self = (LLFloaterAvatarList*)userdata;
 	
- 	LLScrollListItem *item = self->mAvatarList->getFirstSelected();
-	if (item)
+ 	LLUUID agent_id = self->getSelectedID();
+	if (agent_id.notNull())
 	{
-		self->mFocusedAvatar = item->getUUID();
+		self->mFocusedAvatar = agent_id;
 		self->focusOnCurrent();
 	}
 }
@@ -1201,11 +1232,9 @@ void LLFloaterAvatarList::onClickNextMarked(void *userdata)
 void LLFloaterAvatarList::onClickGetKey(void *userdata)
 {
 	LLFloaterAvatarList *self = (LLFloaterAvatarList*)userdata;
- 	LLScrollListItem *item = self->mAvatarList->getFirstSelected();
+ 	LLUUID agent_id = self->getSelectedID();
 
-	if (NULL == item) return;
-
-	LLUUID agent_id = item->getUUID();
+	if (agent_id.isNull()) return;
 
 	char buffer[UUID_STR_LENGTH];		/*Flawfinder: ignore*/
 	agent_id.toString(buffer);
@@ -1454,8 +1483,9 @@ std::string LLFloaterAvatarList::getSelectedName()
 
 LLUUID LLFloaterAvatarList::getSelectedID()
 {
-	LLScrollListItem *item = mAvatarList->getFirstSelected();
-	if (item) return item->getUUID();
+	// the selected row may be scrolled out of the items the list has built
+	LLDynamicArray<LLUUID> ids = mAvatarList->getSelectedIDs();
+	if (!ids.empty()) return ids.front();
 	return LLUUID::null;
 }
 
@@ -1578,10 +1608,9 @@ void LLFloaterAvatarList::onClickEjectFromEstate(void *userdata)
 void LLFloaterAvatarList::onClickAR(void *userdata)
 {
 	LLFloaterAvatarList *self = (LLFloaterAvatarList*)userdata;
- 	LLScrollListItem *item = self->mAvatarList->getFirstSelected();
-	if (item)
+ 	LLUUID agent_id = self->getSelectedID();
+	if (agent_id.notNull())
 	{
-		LLUUID agent_id = item->getUUID();
 		LLAvatarListEntry *entry = self->getAvatarEntry(agent_id);
 		if (entry)
 		{
@@ -1601,10 +1630,9 @@ void LLFloaterAvatarList::onClickProfile(void* userdata)
 void LLFloaterAvatarList::onClickTeleport(void* userdata)
 {
 	LLFloaterAvatarList *self = (LLFloaterAvatarList*)userdata;
- 	LLScrollListItem *item = self->mAvatarList->getFirstSelected();
-	if (item)
+ 	LLUUID agent_id = self->getSelectedID();
+	if (agent_id.notNull())
 	{
-		LLUUID agent_id = item->getUUID();
 		LLAvatarListEntry *entry = self->getAvatarEntry(agent_id);
 		if (entry)
 		{
@@ -1618,10 +1646,9 @@ void LLFloaterAvatarList::onSelectName(LLUICtrl*, void* userdata)
 {
 	LLFloaterAvatarList* self = (LLFloaterAvatarList*)userdata;
 
- 	LLScrollListItem *item = self->mAvatarList->getFirstSelected();
-	if (item)
+ 	LLUUID agent_id = self->getSelectedID();
+	if (agent_id.notNull())
 	{
-		LLUUID agent_id = item->getUUID();
 		LLAvatarListEntry *entry = self->getAvatarEntry(agent_id);
 		if (entry)
 		{
@@ -135,7 +135,7 @@ private:
  * Since I'm very new to C++ any suggestions on coding, style, etc are very
  * welcome.
  */
-class LLFloaterAvatarList : public LLFloater
+class LLFloaterAvatarList : public LLFloater, public LLScrollListDataSource
 {
 	/**
 	 * @brief Creates and initializes the LLFloaterAvatarList
@@ -150,6 +150,9 @@ public:
 	/*virtual*/ void onOpen();
 	/*virtual*/ BOOL postBuild();
 	/*virtual*/ void draw();
+	/*virtual*/ S32 getRowCount() const;
+	/*virtual*/ LLSD getRow(S32 index) const;
+	/*virtual*/ void sortRows(S32 column, BOOL ascending);
 	static void createInstance(bool visible);
 	/**
 	 * @brief Toggles interface visibility
@@ -289,6 +292,21 @@ private:
 	LLScrollListCtrl*			mAvatarList;
 	std::map<LLUUID, LLAvatarListEntry>	mAvatars;
 
+	/**
+	 * @brief Rows shown in the list, kept in its sort order
+	 */
+	std::vector<LLSD> mRows;
+	S32 mSortColumn;
+	BOOL mSortAscending;
+
+	struct sort_rows
+	{
+		sort_rows(S32 column, BOOL ascending) : mColumn(column), mAscending(ascending) { }
+		bool operator()(const LLSD& lhs, const LLSD& rhs) const;
+		S32 mColumn;
+		BOOL mAscending;
+	};
+
 	/**
 	 * @brief TRUE when Updating
 	 */
@@ -38,6 +38,8 @@
 #include "llbutton.h"
 #include "llspinctrl.h"
 #include "llresmgr.h"
+#include "llscrolllistctrl.h"
+#include "llpoolallocator.h"
 
 #include "llmath.h"
 #include "llviewerwindow.h"
@@ -187,11 +189,45 @@ BOOL LLFloaterMemLeak::postBuild(void)
 	childSetAction("release_btn", onClickRelease, this);
 	childSetAction("close_btn", onClickClose, this);
 
+	updatePoolStats() ;
+
 	return TRUE ;
 }
 
+void LLFloaterMemLeak::updatePoolStats()
+{
+	LLScrollListCtrl* list = getChild<LLScrollListCtrl>("pool_stats");
+	S32 scroll_pos = list->getScrollPos();
+	list->deleteAllItems();
+	for (LLPoolStats* stats = LLPoolStats::getFirst(); stats; stats = stats->getNext())
+	{
+		LLSD element;
+		element["columns"][0]["column"] = "name";
+		element["columns"][0]["value"] = stats->getName();
+		element["columns"][1]["column"] = "live";
+		element["columns"][1]["value"] = (S32)stats->getLive();
+		element["columns"][2]["column"] = "peak";
+		element["columns"][2]["value"] = (S32)stats->getPeak();
+		element["columns"][3]["column"] = "total";
+		element["columns"][3]["value"] = (S32)stats->getTotal();
+		list->addElement(element);
+	}
+	list->setScrollPos(scroll_pos);
+
+	std::string bytes_string;
+	LLResMgr::getInstance()->getIntegerString(bytes_string, LLPoolAllocator::getSlabBytes() >> 10);
+	childSetTextArg("pool_slabs_label", "[SIZE]", bytes_string);
+}
+
 void LLFloaterMemLeak::draw()
 {
+	//show live objects of the pooled classes, once a second is plenty
+	if(mPoolStatsTimer.getElapsedTimeF32() > 1.f)
+	{
+		updatePoolStats() ;
+		mPoolStatsTimer.reset() ;
+	}
+
 	//show total memory leaked
 	if(sTotalLeaked > 0)
 	{
@@ -34,6 +34,7 @@
 #define LL_LLFLOATERMEMLEAK_H
 
 #include "llfloater.h"
+#include "llframetimer.h"
 
 class LLFloaterMemLeak : public LLFloater
 {
@@ -66,6 +67,7 @@ public:
 
 private:
 	void release() ;
+	void updatePoolStats() ;
 
 private:
 	enum 
@@ -85,6 +87,7 @@ private:
 	static BOOL sbAllocationFailed ;
 
 	std::vector<char*> mLeakedMem ;	
+	LLFrameTimer mPoolStatsTimer ;
 };
 
 #endif // LL_LLFLOATERMEMLEAK_H
@@ -32,39 +32,37 @@ LLNetListItem::LLNetListItem(LLUUID id)
 ////////////////////////////////
 #define MAX_PACKET_LEN (0x2000)
 LLTemplateMessageReader* LLFloaterMessageLogItem::sTemplateMessageReader = NULL;
-LLFloaterMessageLogItem::LLFloaterMessageLogItem(LLMessageLogEntry entry)
-:	LLMessageLogEntry(entry.mType, entry.mFromHost, entry.mToHost, entry.mData, entry.mDataSize)
+LLFloaterMessageLogItem::LLFloaterMessageLogItem(const LLMessageLogEntry& entry, U32 log_position, U32 serial, const LLHost& local_host, LLTemplateMessageReader* readerp)
+:	mSerial(serial),
+	mLogPosition(log_position),
+	mType(entry.mType),
+	mFromHost(entry.mFromHost),
+	mToHost(entry.mToHost),
+	mOutgoing(entry.mFromHost == local_host),
+	mSequenceID(0),
+	mFlags(0)
 {
-	if(!sTemplateMessageReader)
-	{
-		sTemplateMessageReader = new LLTemplateMessageReader(gMessageSystem->mMessageNumbers);
-	}
-	mID.generate();
-	mSequenceID = 0;
-	if(mType == TEMPLATE)
+	if(mType == LLMessageLogEntry::TEMPLATE)
 	{
 		BOOL decode_invalid = FALSE;
-		S32 decode_len = mDataSize;
-		std::vector<U8> DecodeBuffer(MAX_PACKET_LEN,0);
-		memcpy(&(DecodeBuffer[0]),&(mData[0]),decode_len);
-		U8* decodep = &(DecodeBuffer[0]);
-		mFlags = DecodeBuffer[0];
-		gMessageSystem->zeroCodeExpand(&decodep, &decode_len);
-		if(decode_len < 7)
+		std::vector<U8> decoded;
+		mFlags = entry.mData[0];
+		if(!zeroCodeExpand(entry.mData, decoded) || decoded.size() < 7)
 			decode_invalid = TRUE;
 		else
 		{
+			U8* decodep = &(decoded[0]);
 			mSequenceID = ntohl(*((U32*)(&decodep[1])));
-			sTemplateMessageReader->clearMessage();
-			if(!sTemplateMessageReader->validateMessage(decodep, decode_len, mFromHost, TRUE))
+			readerp->clearMessage();
+			if(!readerp->validateMessage(decodep, decoded.size(), mFromHost, true, TRUE))
 				decode_invalid = TRUE;
 			else
 			{
-				if(!sTemplateMessageReader->decodeData(decodep, mFromHost, TRUE))
+				if(!readerp->decodeData(decodep, mFromHost, TRUE))
 					decode_invalid = TRUE;
 				else
 				{
-					LLMessageTemplate* temp = sTemplateMessageReader->getTemplate();
+					LLMessageTemplate* temp = readerp->getTemplate();
 					mName = temp->mName;
 					mSummary = "";
 					
@@ -88,7 +86,7 @@ LLFloaterMessageLogItem::LLFloaterMessageLogItem(LLMessageLogEntry entry)
 					{
 						LLMessageBlock* block = (*blocks_iter);
 						const char* block_name = block->mName;
-						S32 num_blocks = sTemplateMessageReader->getNumberOfBlocks(block_name);
+						S32 num_blocks = readerp->getNumberOfBlocks(block_name);
 						if(!num_blocks)
 							mSummary.append(" { } ");
 						else if(num_blocks > 1)
@@ -103,7 +101,7 @@ LLFloaterMessageLogItem::LLFloaterMessageLogItem(LLMessageLogEntry entry)
 								LLMessageVariable* variable = (*var_iter);
 								const char* var_name = variable->getName();
 								BOOL returned_hex;
-								std::string value = getString(sTemplateMessageReader, block_name, i, var_name, variable->getType(), returned_hex, TRUE);
+								std::string value = getString(readerp, block_name, i, var_name, variable->getType(), returned_hex, TRUE);
 								mSummary.append(llformat(" %s=%s ", var_name, value.c_str()));
 							}
 							mSummary.append(" } ");
@@ -122,8 +120,8 @@ LLFloaterMessageLogItem::LLFloaterMessageLogItem(LLMessageLogEntry entry)
 		{
 			mName = "Invalid";
 			mSummary = "";
-			for(S32 i = 0; i < mDataSize; i++)
-				mSummary.append(llformat("%02X ", mData[i]));
+			for(S32 i = 0; i < entry.mDataSize; i++)
+				mSummary.append(llformat("%02X ", entry.mData[i]));
 		}
 	}
 	else // not template
@@ -132,30 +130,44 @@ LLFloaterMessageLogItem::LLFloaterMessageLogItem(LLMessageLogEntry entry)
 		mSummary = "TODO: SOMETHING ELSE";
 	}
 }
-LLFloaterMessageLogItem::~LLFloaterMessageLogItem()
+LLUUID LLFloaterMessageLogItem::getID() const
 {
+	LLUUID id;
+	memcpy(id.mData, &mSerial, sizeof(U32));	/* Flawfinder: ignore */
+	return id;
 }
-BOOL LLFloaterMessageLogItem::isOutgoing()
+// static
+U32 LLFloaterMessageLogItem::getSerial(const LLUUID& id)
 {
-	return mFromHost == LLHost(16777343, gMessageSystem->getListenPort());
+	U32 serial;
+	memcpy(&serial, id.mData, sizeof(U32));	/* Flawfinder: ignore */
+	return serial;
 }
-std::string LLFloaterMessageLogItem::getFull(BOOL show_header)
+std::string LLFloaterMessageLogItem::getFull(BOOL show_header) const
 {
 	std::string full("");
-	if(mType == TEMPLATE)
+	LLMessageLogEntry entry;
+	U32 cursor = mLogPosition;
+	if(LLMessageLog::read(cursor, entry) != LLMessageLog::READ_OK)
 	{
+		// Logged over since it was listed.
+		return "This message is no longer in the log.";
+	}
+	if(mType == LLMessageLogEntry::TEMPLATE)
+	{
+		if(!sTemplateMessageReader)
+		{
+			sTemplateMessageReader = new LLTemplateMessageReader(gMessageSystem->mMessageNumbers);
+		}
 		BOOL decode_invalid = FALSE;
-		S32 decode_len = mDataSize;
-		std::vector<U8> DecodeBuffer(MAX_PACKET_LEN,0);
-		memcpy(&(DecodeBuffer[0]),&(mData[0]),decode_len);
-		U8* decodep = &(DecodeBuffer[0]);
-		gMessageSystem->zeroCodeExpand(&decodep, &decode_len);
-		if(decode_len < 7)
+		std::vector<U8> decoded;
+		if(!zeroCodeExpand(entry.mData, decoded) || decoded.size() < 7)
 			decode_invalid = TRUE;
 		else
 		{
+			U8* decodep = &(decoded[0]);
 			sTemplateMessageReader->clearMessage();
-			if(!sTemplateMessageReader->validateMessage(decodep, decode_len, mFromHost, TRUE))
+			if(!sTemplateMessageReader->validateMessage(decodep, decoded.size(), mFromHost, true, TRUE))
 				decode_invalid = TRUE;
 			else
 			{
@@ -210,8 +222,8 @@ std::string LLFloaterMessageLogItem::getFull(BOOL show_header)
 		{
 			full = isOutgoing() ? "out" : "in";
 			full.append("\n");
-			for(S32 i = 0; i < mDataSize; i++)
-				full.append(llformat("%02X ", mData[i]));
+			for(S32 i = 0; i < entry.mDataSize; i++)
+				full.append(llformat("%02X ", entry.mData[i]));
 		}
 	}
 	else // not template
@@ -221,6 +233,45 @@ std::string LLFloaterMessageLogItem::getFull(BOOL show_header)
 	return full;
 }
 // static
+// Same as LLMessageSystem::zeroCodeExpand(), which can't be used here: it expands into
+// a buffer of the message system's, on the main thread, and counts towards its stats.
+BOOL LLFloaterMessageLogItem::zeroCodeExpand(const std::vector<U8>& data, std::vector<U8>& expanded)
+{
+	S32 size = data.size();
+	if(size < LL_PACKET_ID_SIZE)
+		return FALSE;
+	if(!(data[0] & LL_ZERO_CODE_FLAG))
+	{
+		expanded = data;
+		return TRUE;
+	}
+	expanded.reserve(MAX_PACKET_LEN);
+	expanded.assign(data.begin(), data.begin() + LL_PACKET_ID_SIZE);
+	expanded[0] &= ~LL_ZERO_CODE_FLAG;
+	for(S32 i = LL_PACKET_ID_SIZE; i < size; i++)
+	{
+		if(data[i])
+		{
+			expanded.push_back(data[i]);
+			continue;
+		}
+		// A zero is followed by how many zeros it stands for, each extra zero before
+		// the count adding 256.
+		S32 zeros = 1;
+		while(i + 1 < size && !data[i + 1])
+		{
+			zeros += 256;
+			i++;
+		}
+		if(i + 1 < size)
+			zeros += data[++i] - 1;
+		if(expanded.size() + zeros > MAX_PACKET_LEN)
+			return FALSE;
+		expanded.insert(expanded.end(), zeros, 0);
+	}
+	return TRUE;
+}
+// static
 std::string LLFloaterMessageLogItem::getString(LLTemplateMessageReader* readerp, const char* block_name, S32 block_num, const char* var_name, e_message_variable_type var_type, BOOL &returned_hex, BOOL summary_mode)
 {
 	returned_hex = FALSE;
@@ -411,99 +462,179 @@ BOOL LLMessageLogFilter::set(std::string filter)
 	}
 	return TRUE;
 }
+BOOL LLMessageLogFilter::matches(const std::string& name) const
+{
+	std::string find_name = name;
+	LLStringUtil::toLower(find_name);
+	if(mPositiveNames.size())
+		if(std::find(mPositiveNames.begin(), mPositiveNames.end(), find_name) == mPositiveNames.end())
+			return FALSE;
+	if(std::find(mNegativeNames.begin(), mNegativeNames.end(), find_name) != mNegativeNames.end())
+		return FALSE;
+	return TRUE;
+}
 ////////////////////////////////
-// LLMessageLogFilterApply
+// LLMessageLogDecoder
 ////////////////////////////////
-LLMessageLogFilterApply::LLMessageLogFilterApply()
-:	LLEventTimer(0.1f),
-	mFinished(FALSE),
-	mProgress(0)
+// Packets decoded before handing them over, so a backlog shows up as it goes.
+const S32 DECODE_BATCH_SIZE = 1024;
+const U32 DECODE_IDLE_MS = 20;
+LLMessageLogDecoder::LLMessageLogDecoder(const LLHost& local_host)
+:	LLThread("Message log decoder"),
+	mFilterGeneration(0),
+	mClearRequested(FALSE),
+	mReplaceMatches(FALSE),
+	mDecodedCount(0),
+	mLocalHost(local_host),
+	mCursor(LLMessageLog::getTail()),
+	mNextSerial(1),
+	mAppliedGeneration(0)
+{
+	mReader = new LLTemplateMessageReader(gMessageSystem->mMessageNumbers);
+}
+LLMessageLogDecoder::~LLMessageLogDecoder()
+{
+	delete mReader;
+}
+void LLMessageLogDecoder::setFilter(const LLMessageLogFilter& filter)
+{
+	LLMutexLock lock(&mMutex);
+	mFilter = filter;
+	mFilterGeneration++;
+}
+void LLMessageLogDecoder::clear()
 {
-	mIter = LLFloaterMessageLog::sMessageLogEntries.begin();
+	LLMutexLock lock(&mMutex);
+	mClearRequested = TRUE;
+	mMatches.clear();
+	mReplaceMatches = TRUE;
+	mDecodedCount = 0;
 }
-void LLMessageLogFilterApply::cancel()
+BOOL LLMessageLogDecoder::isFiltering()
 {
-	mFinished = TRUE;
+	LLMutexLock lock(&mMutex);
+	return mAppliedGeneration != mFilterGeneration;
 }
-BOOL LLMessageLogFilterApply::tick()
+BOOL LLMessageLogDecoder::takeMatches(std::vector<LLFloaterMessageLogItemPtr>& matches, S32& decoded)
 {
-	std::deque<LLMessageLogEntry>::iterator end = LLFloaterMessageLog::sMessageLogEntries.end();
-	if(mIter == end || !LLFloaterMessageLog::sInstance)
+	LLMutexLock lock(&mMutex);
+	matches.swap(mMatches);
+	mMatches.clear();
+	decoded = mDecodedCount;
+	BOOL replace = mReplaceMatches;
+	mReplaceMatches = FALSE;
+	return replace;
+}
+void LLMessageLogDecoder::run()
+{
+	LLMessageLogFilter filter;
+	std::vector<LLFloaterMessageLogItemPtr> matches;
+	while(!isQuitting())
 	{
-		mFinished = TRUE;
-		if(LLFloaterMessageLog::sInstance)
+		U32 generation;
+		BOOL clear;
 		{
-			if(LLFloaterMessageLog::sInstance->mMessageLogFilterApply == this)
-			{
-				LLFloaterMessageLog::sInstance->stopApplyingFilter();
-			}
+			LLMutexLock lock(&mMutex);
+			generation = mFilterGeneration;
+			if(generation != mAppliedGeneration)
+				filter = mFilter;
+			clear = mClearRequested;
+			mClearRequested = FALSE;
 		}
-		return TRUE;
-	}
-	for(S32 i = 0; i < 256; i++)
-	{
-		if(mIter == end)
-		{
-			mFinished = TRUE;
-			if(LLFloaterMessageLog::sInstance)
-			{
-				if(LLFloaterMessageLog::sInstance->mMessageLogFilterApply == this)
-				{
-					LLFloaterMessageLog::sInstance->stopApplyingFilter();
 
-					//we're done messing with the deque, push all queued items to the main deque
-					std::deque<LLMessageLogEntry>::iterator queueIter = mQueuedMessages.begin();
-					std::deque<LLMessageLogEntry>::iterator queueEnd = mQueuedMessages.end();
+		matches.clear();
+		BOOL replace = clear || generation != mAppliedGeneration;
+		if(clear)
+		{
+			mItems.clear();
+			mCursor = LLMessageLog::getHead();
+		}
+		else if(replace)
+		{
+			for(std::deque<LLFloaterMessageLogItemPtr>::iterator iter = mItems.begin(); iter != mItems.end(); ++iter)
+				if(filter.matches((*iter)->mName))
+					matches.push_back(*iter);
+		}
 
-					while(queueIter != queueEnd)
-					{
-						LLFloaterMessageLog::sInstance->conditionalLog(LLFloaterMessageLogItem((*queueIter)));
-						++queueIter;
-					}
+		S32 decoded = 0;
+		LLMessageLogEntry entry;
+		while(decoded < DECODE_BATCH_SIZE)
+		{
+			U32 position = mCursor;
+			LLMessageLog::EReadResult result = LLMessageLog::read(mCursor, entry);
+			if(result == LLMessageLog::READ_END)
+				break;
+			if(result == LLMessageLog::READ_LOST)
+				continue;
+			LLFloaterMessageLogItemPtr itemp = new LLFloaterMessageLogItem(entry, position, mNextSerial++, mLocalHost, mReader);
+			mItems.push_back(itemp);
+			if(filter.matches(itemp->mName))
+				matches.push_back(itemp);
+			decoded++;
+		}
+		// Forget what has been logged over since.
+		U32 tail = LLMessageLog::getTail();
+		while(!mItems.empty() && (S32)(mItems.front()->mLogPosition - tail) < 0)
+			mItems.pop_front();
 
-					mQueuedMessages.clear();
+		{
+			LLMutexLock lock(&mMutex);
+			// If the filter changed or the log got cleared meanwhile, whatever was
+			// matched is redone on the next round.
+			if(generation == mFilterGeneration && !mClearRequested)
+			{
+				if(replace)
+				{
+					mMatches.swap(matches);
+					mReplaceMatches = TRUE;
 				}
+				else
+					mMatches.insert(mMatches.end(), matches.begin(), matches.end());
+				mDecodedCount = mItems.size();
+				mAppliedGeneration = generation;
 			}
-
-			return TRUE;
 		}
 
-		LLFloaterMessageLog::sInstance->conditionalLog(LLFloaterMessageLogItem((*mIter)));
-		
-		mIter++;
-		mProgress++;
+		if(!decoded && !replace)
+			ms_sleep(DECODE_IDLE_MS);
 	}
-	LLFloaterMessageLog::sInstance->updateFilterStatus();
-	return FALSE;
 }
 ////////////////////////////////
 // LLFloaterMessageLog
 ////////////////////////////////
+namespace
+{
+	struct SerialLess
+	{
+		bool operator()(const LLFloaterMessageLogItemPtr& itemp, U32 serial) const
+		{
+			return itemp->mSerial < serial;
+		}
+	};
+}
 LLFloaterMessageLog* LLFloaterMessageLog::sInstance;
 std::list<LLNetListItem*> LLFloaterMessageLog::sNetListItems;
-std::deque<LLMessageLogEntry> LLFloaterMessageLog::sMessageLogEntries;
-std::vector<LLFloaterMessageLogItem> LLFloaterMessageLog::sFloaterMessageLogItems;
+std::deque<LLFloaterMessageLogItemPtr> LLFloaterMessageLog::sFloaterMessageLogItems;
 LLMessageLogFilter LLFloaterMessageLog::sMessageLogFilter = LLMessageLogFilter();
 std::string LLFloaterMessageLog::sMessageLogFilterString("!StartPingCheck !CompletePingCheck !PacketAck !SimulatorViewerTimeMessage !SimStats !AgentUpdate !AgentAnimation !AvatarAnimation !ViewerEffect !CoarseLocationUpdate !LayerData !CameraConstraint !ObjectUpdateCached !RequestMultipleObjects !ObjectUpdate !ObjectUpdateCompressed !ImprovedTerseObjectUpdate !KillObject !ImagePacket !SendXferPacket !ConfirmXferPacket !TransferPacket !SoundTrigger !AttachedSound !PreloadSound");
-BOOL LLFloaterMessageLog::sBusyApplyingFilter = FALSE;
 LLFloaterMessageLog::LLFloaterMessageLog()
 :	LLFloater(),
 	LLEventTimer(1.0f),
 	mNetInfoMode(NI_NET),
-	mMessageLogFilterApply(NULL)
+	mDecodedCount(0)
 {
 	sInstance = this;
-	LLMessageLog::setCallback(onLog);
-	sMessageLogEntries = LLMessageLog::getDeque();
+	mDecoder = new LLMessageLogDecoder(LLHost(16777343, gMessageSystem->getListenPort()));
 	LLUICtrlFactory::getInstance()->buildFloater(this, "floater_message_log.xml");
+	mDecoder->start();
 }
 LLFloaterMessageLog::~LLFloaterMessageLog()
 {
-	LLMessageLog::setCallback(NULL);
-	stopApplyingFilter();
+	mDecoder->shutdown();
+	delete mDecoder;
+	getChild<LLScrollListCtrl>("message_log")->setDataSource(NULL);
 	sInstance = NULL;
 	sNetListItems.clear();
-	sMessageLogEntries.clear();
 	sFloaterMessageLogItems.clear();
 }
 // static
@@ -516,6 +647,7 @@ BOOL LLFloaterMessageLog::postBuild()
 {
 	childSetCommitCallback("net_list", onCommitNetList, this);
 	childSetCommitCallback("message_log", onCommitMessageLog, this);
+	getChild<LLScrollListCtrl>("message_log")->setDataSource(this);
 	childSetAction("filter_choice_btn", onClickFilterChoice, this);
 	childSetAction("filter_apply_btn", onClickFilterApply, this);
 	childSetCommitCallback("filter_edit", onCommitFilter, this);
@@ -526,6 +658,11 @@ BOOL LLFloaterMessageLog::postBuild()
 	startApplyingFilter(sMessageLogFilterString, TRUE);
 	return TRUE;
 }
+void LLFloaterMessageLog::draw()
+{
+	updateLog();
+	LLFloater::draw();
+}
 BOOL LLFloaterMessageLog::tick()
 {
 	refreshNetList();
@@ -699,34 +836,59 @@ void LLFloaterMessageLog::setNetInfoMode(ENetInfoMode mode)
 	if(mNetInfoMode == NI_NET)
 		refreshNetInfo(TRUE);
 }
-// static
-void LLFloaterMessageLog::onLog(LLMessageLogEntry entry)
+void LLFloaterMessageLog::updateLog()
 {
-	//don't mess with the queue while a filter's being applied, or face invalid iterators
-	if(!sBusyApplyingFilter)
+	std::vector<LLFloaterMessageLogItemPtr> matches;
+	S32 decoded = 0;
+	BOOL replace = mDecoder->takeMatches(matches, decoded);
+	// Drop what has been logged over since
+	U32 tail = LLMessageLog::getTail();
+	S32 dropped = 0;
+	while(!sFloaterMessageLogItems.empty() && (S32)(sFloaterMessageLogItems.front()->mLogPosition - tail) < 0)
 	{
-		sMessageLogEntries.push_back(entry);
-		conditionalLog(LLFloaterMessageLogItem(entry));
+		sFloaterMessageLogItems.pop_front();
+		dropped++;
 	}
-}
-// static
-void LLFloaterMessageLog::conditionalLog(LLFloaterMessageLogItem item)
-{	
-	if(!sBusyApplyingFilter)
-		sInstance->childSetText("log_status_text", llformat("Showing %d messages from %d", sFloaterMessageLogItems.size(), sMessageLogEntries.size()));
-	std::string find_name = item.mName;
-	LLStringUtil::toLower(find_name);
-	if(sMessageLogFilter.mPositiveNames.size())
-		if(std::find(sMessageLogFilter.mPositiveNames.begin(), sMessageLogFilter.mPositiveNames.end(), find_name) == sMessageLogFilter.mPositiveNames.end())
-			return;
-	if(std::find(sMessageLogFilter.mNegativeNames.begin(), sMessageLogFilter.mNegativeNames.end(), find_name) != sMessageLogFilter.mNegativeNames.end())
+	if(replace)
+	{
+		dropped = 0;
+		sFloaterMessageLogItems.clear();
+	}
+	if(!replace && !dropped && matches.empty())
+	{
+		if(decoded != mDecodedCount)
+		{
+			mDecodedCount = decoded;
+			updateFilterStatus();
+		}
 		return;
-	sFloaterMessageLogItems.push_back(item); // moved from beginning...
-	BOOL outgoing = item.isOutgoing();
+	}
+	mDecodedCount = decoded;
+	LLScrollListCtrl* scrollp = getChild<LLScrollListCtrl>("message_log");
+	S32 scroll_pos = scrollp->getScrollPos();
+	BOOL at_end = scroll_pos > (S32)sFloaterMessageLogItems.size() - scrollp->getPageLines() - 4;
+	sFloaterMessageLogItems.insert(sFloaterMessageLogItems.end(), matches.begin(), matches.end());
+	scrollp->dataChanged();
+	if(replace)
+		childSetVisible("message_log", true);
+	if(at_end)
+		scrollp->setScrollPos(scrollp->getItemCount());
+	else if(dropped)
+		scrollp->setScrollPos(llmax(0, scroll_pos - dropped));
+	updateFilterStatus();
+}
+S32 LLFloaterMessageLog::getRowCount() const
+{
+	return sFloaterMessageLogItems.size();
+}
+LLSD LLFloaterMessageLog::getRow(S32 index) const
+{
+	const LLFloaterMessageLogItem* itemp = sFloaterMessageLogItems[index];
+	BOOL outgoing = itemp->isOutgoing();
 	std::string net_name("\?\?\?");
-	if(item.mType == LLFloaterMessageLogItem::TEMPLATE)
+	if(itemp->mType == LLMessageLogEntry::TEMPLATE)
 	{
-		LLHost find_host = outgoing ? item.mToHost : item.mFromHost;
+		LLHost find_host = outgoing ? itemp->mToHost : itemp->mFromHost;
 		net_name = find_host.getIPandPort();
 		std::list<LLNetListItem*>::iterator end = sNetListItems.end();
 		for(std::list<LLNetListItem*>::iterator iter = sNetListItems.begin(); iter != end; ++iter)
@@ -739,13 +901,13 @@ void LLFloaterMessageLog::conditionalLog(LLFloaterMessageLogItem item)
 		}
 	}
 	LLSD element;
-	element["id"] = item.mID;
+	element["id"] = itemp->getID();
 	LLSD& sequence_column = element["columns"][0];
 	sequence_column["column"] = "sequence";
-	sequence_column["value"] = llformat("%u", item.mSequenceID);
+	sequence_column["value"] = llformat("%u", itemp->mSequenceID);
 	LLSD& type_column = element["columns"][1];
 	type_column["column"] = "type";
-	type_column["value"] = item.mType == LLFloaterMessageLogItem::TEMPLATE ? "UDP" : "\?\?\?";
+	type_column["value"] = itemp->mType == LLMessageLogEntry::TEMPLATE ? "UDP" : "\?\?\?";
 	LLSD& direction_column = element["columns"][2];
 	direction_column["column"] = "direction";
 	direction_column["value"] = outgoing ? "to" : "from";
@@ -754,33 +916,29 @@ void LLFloaterMessageLog::conditionalLog(LLFloaterMessageLogItem item)
 	net_column["value"] = net_name;
 	LLSD& name_column = element["columns"][4];
 	name_column["column"] = "name";
-	name_column["value"] = item.mName;
+	name_column["value"] = itemp->mName;
 	/*
 	LLSD& zer_column = element["columns"][5];
 	zer_column["column"] = "flag_zer";
 	zer_column["type"] = "icon";
-	zer_column["value"] = (item.mFlags & LL_ZERO_CODE_FLAG) ? "flag_zer.tga" : "";
+	zer_column["value"] = (itemp->mFlags & LL_ZERO_CODE_FLAG) ? "flag_zer.tga" : "";
 	LLSD& rel_column = element["columns"][6];
 	rel_column["column"] = "flag_rel";
 	rel_column["type"] = "icon";
-	rel_column["value"] = (item.mFlags & LL_RELIABLE_FLAG) ? "flag_rel.tga" : "";
+	rel_column["value"] = (itemp->mFlags & LL_RELIABLE_FLAG) ? "flag_rel.tga" : "";
 	LLSD& rsd_column = element["columns"][7];
 	rsd_column["column"] = "flag_rsd";
 	rsd_column["type"] = "icon";
-	rsd_column["value"] = (item.mFlags & LL_RESENT_FLAG) ? "flag_rsd.tga" : "";
+	rsd_column["value"] = (itemp->mFlags & LL_RESENT_FLAG) ? "flag_rsd.tga" : "";
 	LLSD& ack_column = element["columns"][8];
 	ack_column["column"] = "flag_ack";
 	ack_column["type"] = "icon";
-	ack_column["value"] = (item.mFlags & LL_ACK_FLAG) ? "flag_ack.tga" : "";
+	ack_column["value"] = (itemp->mFlags & LL_ACK_FLAG) ? "flag_ack.tga" : "";
 	*/
 	LLSD& summary_column = element["columns"][5];
 	summary_column["column"] = "summary";
-	summary_column["value"] = item.mSummary;
-	LLScrollListCtrl* scrollp = sInstance->getChild<LLScrollListCtrl>("message_log");
-	S32 scroll_pos = scrollp->getScrollPos();
-	scrollp->addElement(element);
-	if(scroll_pos > scrollp->getItemCount() - scrollp->getPageLines() - 4)
-		scrollp->setScrollPos(scrollp->getItemCount());
+	summary_column["value"] = itemp->mSummary;
+	return element;
 }
 // static
 void LLFloaterMessageLog::onCommitNetList(LLUICtrl* ctrl, void* user_data)
@@ -796,16 +954,13 @@ void LLFloaterMessageLog::onCommitMessageLog(LLUICtrl* ctrl, void* user_data)
 	LLScrollListCtrl* scrollp = floaterp->getChild<LLScrollListCtrl>("message_log");
 	LLScrollListItem* selected_itemp = scrollp->getFirstSelected();
 	if(!selected_itemp) return;
-	LLUUID id = selected_itemp->getUUID();
-	std::vector<LLFloaterMessageLogItem>::iterator end = sFloaterMessageLogItems.end();
-	for(std::vector<LLFloaterMessageLogItem>::iterator iter = sFloaterMessageLogItems.begin(); iter != end; ++iter)
+	U32 serial = LLFloaterMessageLogItem::getSerial(selected_itemp->getUUID());
+	std::deque<LLFloaterMessageLogItemPtr>::iterator iter =
+		std::lower_bound(sFloaterMessageLogItems.begin(), sFloaterMessageLogItems.end(), serial, SerialLess());
+	if(iter != sFloaterMessageLogItems.end() && (*iter)->mSerial == serial)
 	{
-		if(iter->mID == id)
-		{
-			floaterp->setNetInfoMode(NI_LOG);
-			floaterp->childSetText("net_info", iter->getFull(FALSE));
-			break;
-		}
+		floaterp->setNetInfoMode(NI_LOG);
+		floaterp->childSetText("net_info", (*iter)->getFull(FALSE));
 	}
 }
 // static
@@ -882,37 +1037,19 @@ void LLFloaterMessageLog::startApplyingFilter(std::string filter, BOOL force)
 		|| (new_filter.mNegativeNames != sMessageLogFilter.mNegativeNames)
 		|| (new_filter.mPositiveNames != sMessageLogFilter.mPositiveNames))
 	{
-		stopApplyingFilter();
 		sMessageLogFilter = new_filter;
-		sFloaterMessageLogItems.clear();
-		getChild<LLScrollListCtrl>("message_log")->clearRows();
-		sBusyApplyingFilter = TRUE;
+		mDecoder->setFilter(new_filter);
+		// The matches of the new filter replace the list when they come in.
 		childSetVisible("message_log", false);
-		//childSetVisible("log_status_text", true);
-		mMessageLogFilterApply = new LLMessageLogFilterApply();
-	}
-}
-void LLFloaterMessageLog::stopApplyingFilter()
-{
-	if(mMessageLogFilterApply)
-	{
-		if(!(mMessageLogFilterApply->mFinished))
-			mMessageLogFilterApply->cancel();
-		//delete mMessageLogFilterApply;
-		sBusyApplyingFilter = FALSE;
-		//childSetVisible("log_status_text", false);
-		childSetVisible("message_log", true);
-		childSetText("log_status_text", llformat("Showing %d messages from %d", sFloaterMessageLogItems.size(), sMessageLogEntries.size()));
+		updateFilterStatus();
 	}
 }
 void LLFloaterMessageLog::updateFilterStatus()
 {
-	if(!mMessageLogFilterApply || !sBusyApplyingFilter) return;
-	S32 progress = mMessageLogFilterApply->mProgress;
-	S32 packets = sMessageLogEntries.size();
-	S32 matches = sFloaterMessageLogItems.size();
-	std::string text = llformat("Applying filter ( %d / %d ), %d matches ...", progress, packets, matches);
-	childSetText("log_status_text", text);
+	if(mDecoder->isFiltering())
+		childSetText("log_status_text", std::string("Applying filter ..."));
+	else
+		childSetText("log_status_text", llformat("Showing %d messages from %d", sFloaterMessageLogItems.size(), mDecodedCount));
 }
 // static
 void LLFloaterMessageLog::onCommitFilter(LLUICtrl* ctrl, void* user_data)
@@ -924,11 +1061,12 @@ void LLFloaterMessageLog::onCommitFilter(LLUICtrl* ctrl, void* user_data)
 void LLFloaterMessageLog::onClickClearLog(void* user_data)
 {
 	LLFloaterMessageLog* floaterp = (LLFloaterMessageLog*)user_data;
-	floaterp->stopApplyingFilter();
-	floaterp->getChild<LLScrollListCtrl>("message_log")->clearRows();
-	floaterp->setNetInfoMode(NI_NET);
-	sMessageLogEntries.clear();
+	floaterp->mDecoder->clear();
 	sFloaterMessageLogItems.clear();
+	floaterp->mDecodedCount = 0;
+	floaterp->getChild<LLScrollListCtrl>("message_log")->dataChanged();
+	floaterp->setNetInfoMode(NI_NET);
+	floaterp->updateFilterStatus();
 }
 // static
 void LLFloaterMessageLog::onClickFilterChoice(void* user_data)
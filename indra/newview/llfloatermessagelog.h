@@ -3,6 +3,8 @@
 #include "llmessagelog.h"
 #include "lltemplatemessagereader.h"
 #include "lleventtimer.h"
+#include "llscrolllistctrl.h"
+#include "llthread.h"
 
 class LLNetListItem
 {
@@ -15,61 +17,97 @@ public:
 	LLCircuitData* mCircuitData;
 };
 
-class LLFloaterMessageLogItem : public LLMessageLogEntry
+// A logged packet as the floater lists it.  Only the summary is kept, the full
+// decode is redone from the message log when the packet gets selected.
+class LLFloaterMessageLogItem : public LLThreadSafeRefCount
 {
 public:
-	LLFloaterMessageLogItem(LLMessageLogEntry entry);
-	~LLFloaterMessageLogItem();
-	LLUUID mID;
+	LLFloaterMessageLogItem(const LLMessageLogEntry& entry, U32 log_position, U32 serial, const LLHost& local_host, LLTemplateMessageReader* readerp);
+	U32 mSerial;			// Order the item was decoded in, starting at 1.
+	U32 mLogPosition;		// Cursor in LLMessageLog the packet was read at.
+	LLMessageLogEntry::EType mType;
+	LLHost mFromHost;
+	LLHost mToHost;
+	BOOL mOutgoing;
 	U32 mSequenceID;
 	std::string mName;
 	std::string mSummary;
 	U32 mFlags;
-	std::string getFull(BOOL show_header = TRUE);
-	BOOL isOutgoing();
-	void refreshNetList();
+	LLUUID getID() const;
+	static U32 getSerial(const LLUUID& id);
+	std::string getFull(BOOL show_header = TRUE) const;
+	BOOL isOutgoing() const { return mOutgoing; }
 
 private:
 	static LLTemplateMessageReader* sTemplateMessageReader;
+	static BOOL zeroCodeExpand(const std::vector<U8>& data, std::vector<U8>& expanded);
 	static std::string getString(LLTemplateMessageReader* readerp, const char* block_name, S32 block_num, const char* var_name, e_message_variable_type var_type, BOOL &returned_hex, BOOL summary_mode = FALSE);
 };
+typedef LLPointer<LLFloaterMessageLogItem> LLFloaterMessageLogItemPtr;
 class LLMessageLogFilter
 {
 public:
 	LLMessageLogFilter();
 	~LLMessageLogFilter();
 	BOOL set(std::string filter);
+	BOOL matches(const std::string& name) const;
 	std::list<std::string> mPositiveNames;
 	std::list<std::string> mNegativeNames;
 };
-class LLMessageLogFilterApply : public LLEventTimer
+// Follows the message log on its own thread, decoding each new packet and keeping
+// the ones that pass the filter for the floater to pick up.
+class LLMessageLogDecoder : public LLThread
 {
 public:
-	LLMessageLogFilterApply();
-	void cancel();
-	BOOL tick();
-	S32 mProgress;
-	BOOL mFinished;
+	LLMessageLogDecoder(const LLHost& local_host);
+	~LLMessageLogDecoder();
+	// The rest is for the main thread.
+	void setFilter(const LLMessageLogFilter& filter);
+	void clear();
+	BOOL isFiltering();
+	// Hands over the matches found since the last call, and how many packets have been
+	// decoded.  Returns TRUE if they replace all those handed over before, after the
+	// filter changed or the log was cleared.
+	BOOL takeMatches(std::vector<LLFloaterMessageLogItemPtr>& matches, S32& decoded);
+
+protected:
+	/*virtual*/ void run();
+
 private:
-	std::deque<LLMessageLogEntry> mQueuedMessages;
-	std::deque<LLMessageLogEntry>::iterator mIter;
+	LLMutex mMutex;
+	// Shared, under mMutex
+	LLMessageLogFilter mFilter;
+	U32 mFilterGeneration;
+	BOOL mClearRequested;
+	std::vector<LLFloaterMessageLogItemPtr> mMatches;
+	BOOL mReplaceMatches;
+	S32 mDecodedCount;
+	// Only used by the decoding thread
+	LLTemplateMessageReader* mReader;
+	LLHost mLocalHost;
+	std::deque<LLFloaterMessageLogItemPtr> mItems;
+	U32 mCursor;
+	U32 mNextSerial;
+	U32 mAppliedGeneration;
 };
-class LLFloaterMessageLog : public LLFloater, public LLEventTimer
+class LLFloaterMessageLog : public LLFloater, public LLEventTimer, public LLScrollListDataSource
 {
 public:
 	LLFloaterMessageLog();
 	~LLFloaterMessageLog();
 	static void show();
 	BOOL postBuild();
+	/*virtual*/ void draw();
 	BOOL tick();
+	/*virtual*/ S32 getRowCount() const;
+	/*virtual*/ LLSD getRow(S32 index) const;
 	LLNetListItem* findNetListItem(LLHost host);
 	LLNetListItem* findNetListItem(LLUUID id);
 	void refreshNetList();
 	void refreshNetInfo(BOOL force);
 	enum ENetInfoMode { NI_NET, NI_LOG };
 	void setNetInfoMode(ENetInfoMode mode);
-	static void onLog(LLMessageLogEntry entry);
-	static void conditionalLog(LLFloaterMessageLogItem item);
+	void updateLog();
 	static void onCommitNetList(LLUICtrl* ctrl, void* user_data);
 	static void onCommitMessageLog(LLUICtrl* ctrl, void* user_data);
 	static void onCommitFilter(LLUICtrl* ctrl, void* user_data);
@@ -78,15 +116,13 @@ public:
 	static bool onConfirmRemoveRegion(const LLSD& notification, const LLSD& response );
 	static void onClickFilterApply(void* user_data);
 	void startApplyingFilter(std::string filter, BOOL force);
-	void stopApplyingFilter();
 	void updateFilterStatus();
-	static BOOL sBusyApplyingFilter;
-	LLMessageLogFilterApply* mMessageLogFilterApply;
+	LLMessageLogDecoder* mDecoder;
+	S32 mDecodedCount;
 	static void onClickClearLog(void* user_data);
 	static LLFloaterMessageLog* sInstance;
 	static std::list<LLNetListItem*> sNetListItems;
-	static std::deque<LLMessageLogEntry> sMessageLogEntries;
-	static std::vector<LLFloaterMessageLogItem> sFloaterMessageLogItems;
+	static std::deque<LLFloaterMessageLogItemPtr> sFloaterMessageLogItems;
 	static LLMessageLogFilter sMessageLogFilter;
 	static std::string sMessageLogFilterString;
 	ENetInfoMode mNetInfoMode;
@@ -76,6 +76,7 @@
 #include "llimagepng.h"
 #include "llimagebmp.h"
 #include "llimagej2c.h"
+#include "llimageworker.h"
 #include "llvfile.h"
 #include "llvfs.h"
 
@@ -161,6 +162,9 @@ public:
 	// Returns TRUE when snapshot generated, FALSE otherwise.
 	static BOOL onIdle( void* snapshot_preview );
 
+	// Called on the main thread when the encode of snapshot 'generation' is done.
+	void onPreviewEncoded(U32 generation, bool success, LLImageFormatted* formatted, LLImageRaw* decoded);
+
 private:
 	LLColor4					mColor;
 	LLPointer<LLViewerTexture>	mViewerImage[2]; //used to represent the scene when the frame is frozen.
@@ -193,6 +197,8 @@ private:
 	ESnapshotType				mSnapshotType;
 	LLFloaterSnapshot::ESnapshotFormat	mSnapshotFormat;
 	BOOL						mSnapshotUpToDate;
+	U32							mEncodeGeneration;	// bumped whenever the snapshot is invalidated
+	BOOL						mPreviewEncoded;	// an encode finished since the last onIdle()
 	LLFrameTimer				mFallAnimTimer;
 	LLVector3					mCameraPos;
 	LLQuaternion				mCameraRot;
@@ -223,6 +229,8 @@ LLSnapshotLivePreview::LLSnapshotLivePreview (const LLRect& rect) :
 	mSnapshotType(SNAPSHOT_POSTCARD),
 	mSnapshotFormat(LLFloaterSnapshot::ESnapshotFormat(gSavedSettings.getS32("SnapshotFormat"))),
 	mSnapshotUpToDate(FALSE),
+	mEncodeGeneration(0),
+	mPreviewEncoded(FALSE),
 	mCameraPos(LLViewerCamera::getInstance()->getOrigin()),
 	mCameraRot(LLViewerCamera::getInstance()->getQuaternion()),
 	mSnapshotActive(FALSE),
@@ -321,6 +329,8 @@ void LLSnapshotLivePreview::updateSnapshot(BOOL new_snapshot, BOOL new_thumbnail
 		mFallAnimTimer.start();		
 	}
 	mSnapshotUpToDate = FALSE; 		
+	// drop the result of any encode still in flight
+	mEncodeGeneration++;
 
 	LLRect& rect = mImageRect[mCurImageIndex];
 	rect.set(0, getRect().getHeight(), getRect().getWidth(), 0);
@@ -727,6 +737,29 @@ void LLSnapshotLivePreview::generateThumbnailImage(BOOL force_update)
 }
 
 
+// Hands the encoded snapshot back to its preview, if that is still around.
+class LLSnapshotEncodeResponder : public LLImageEncodeThread::Responder
+{
+public:
+	LLSnapshotEncodeResponder(const LLHandle<LLView>& preview, U32 generation)
+		: mPreview(preview), mGeneration(generation)
+	{
+	}
+
+	/*virtual*/ void completed(bool success, LLImageFormatted* formatted, LLImageRaw* decoded)
+	{
+		LLSnapshotLivePreview* previewp = (LLSnapshotLivePreview*)mPreview.get();
+		if (previewp)
+		{
+			previewp->onPreviewEncoded(mGeneration, success, formatted, decoded);
+		}
+	}
+
+private:
+	LLHandle<LLView> mPreview;
+	U32 mGeneration;
+};
+
 // Called often. Checks whether it's time to grab a new snapshot and if so, does it.
 // Returns TRUE if new snapshot generated, FALSE otherwise.
 //static 
@@ -734,6 +767,13 @@ BOOL LLSnapshotLivePreview::onIdle( void* snapshot_preview )
 {
 	LLSnapshotLivePreview* previewp = (LLSnapshotLivePreview*)snapshot_preview;	
 
+	if (previewp->mPreviewEncoded)
+	{
+		// the controls depend on the encoded image (data size, save buttons).
+		previewp->mPreviewEncoded = FALSE;
+		return TRUE;
+	}
+
 	LLVector3 new_camera_pos = LLViewerCamera::getInstance()->getOrigin();
 	LLQuaternion new_camera_rot = LLViewerCamera::getInstance()->getQuaternion();
 	static const LLCachedControl<bool> freeze_time("FreezeTime",false);
@@ -761,15 +801,8 @@ BOOL LLSnapshotLivePreview::onIdle( void* snapshot_preview )
 
 	// time to produce a snapshot
 
-	if (!previewp->mPreviewImage)
-	{
-		previewp->mPreviewImage = new LLImageRaw;
-	}
-
-	if (!previewp->mPreviewImageEncoded)
-	{
-		previewp->mPreviewImageEncoded = new LLImageRaw;
-	}
+	// always grab into a fresh image, an earlier one may still be read by the encode threads.
+	previewp->mPreviewImage = new LLImageRaw;
 
 	previewp->setVisible(FALSE);
 	previewp->setEnabled(FALSE);
@@ -777,8 +810,8 @@ BOOL LLSnapshotLivePreview::onIdle( void* snapshot_preview )
 	previewp->getWindow()->incBusyCount();
 	previewp->mImageScaled[previewp->mCurImageIndex] = FALSE;
 
-	// grab the raw image and encode it into desired format
-	if(gViewerWindow->rawSnapshot(
+	// grab the raw image
+	BOOL grabbed = gViewerWindow->rawSnapshot(
 							previewp->mPreviewImage,
 							previewp->mWidth[previewp->mCurImageIndex],
 							previewp->mHeight[previewp->mCurImageIndex],
@@ -787,34 +820,35 @@ BOOL LLSnapshotLivePreview::onIdle( void* snapshot_preview )
 							gSavedSettings.getBOOL("RenderUIInSnapshot"),
 							FALSE,
 							previewp->mSnapshotBufferType,
-							previewp->getMaxImageSize()))
+							previewp->getMaxImageSize());
+	previewp->getWindow()->decBusyCount();
+
+	if (grabbed)
 	{
-		previewp->mPreviewImageEncoded->resize(
-			previewp->mPreviewImage->getWidth(), 
-			previewp->mPreviewImage->getHeight(), 
-			previewp->mPreviewImage->getComponents());
+		// and encode it into desired format on the image encode threads,
+		// onPreviewEncoded() takes it from there.
+		LLPointer<LLImageRaw> raw = previewp->mPreviewImage;
+		LLPointer<LLImageFormatted> formatted;
+		bool decode = true;
+
+		// delete any existing image
+		previewp->mFormattedImage = NULL;
+		previewp->mDataSize = 0;
 
 		if(previewp->getSnapshotType() == SNAPSHOT_TEXTURE)
 		{
-			LLPointer<LLImageJ2C> formatted = new LLImageJ2C;
-			LLPointer<LLImageRaw> scaled = new LLImageRaw(
+			raw = new LLImageRaw(
 				previewp->mPreviewImage->getData(),
 				previewp->mPreviewImage->getWidth(),
 				previewp->mPreviewImage->getHeight(),
 				previewp->mPreviewImage->getComponents());
 		
-			scaled->biasedScaleToPowerOfTwo(512);
+			raw->biasedScaleToPowerOfTwo(512);
 			previewp->mImageScaled[previewp->mCurImageIndex] = TRUE;
-			if (formatted->encode(scaled, 0.f))
-			{
-				previewp->mDataSize = formatted->getDataSize();
-				formatted->decode(previewp->mPreviewImageEncoded, 0);
-			}
+			formatted = new LLImageJ2C;
 		}
 		else
 		{
-			// delete any existing image
-			previewp->mFormattedImage = NULL;
 			// now create the new one of the appropriate format.
 			// note: postcards hardcoded to use jpeg always.
 			LLFloaterSnapshot::ESnapshotFormat format = previewp->getSnapshotType() == SNAPSHOT_POSTCARD
@@ -822,82 +856,39 @@ BOOL LLSnapshotLivePreview::onIdle( void* snapshot_preview )
 			switch(format)
 			{
 			case LLFloaterSnapshot::SNAPSHOT_FORMAT_PNG:
-				previewp->mFormattedImage = new LLImagePNG(); 
+				formatted = new LLImagePNG(); 
 				break;
 			case LLFloaterSnapshot::SNAPSHOT_FORMAT_JPEG:
-				previewp->mFormattedImage = new LLImageJPEG(previewp->mSnapshotQuality); 
+				formatted = new LLImageJPEG(previewp->mSnapshotQuality); 
 				break;
 			case LLFloaterSnapshot::SNAPSHOT_FORMAT_BMP:
-				previewp->mFormattedImage = new LLImageBMP(); 
+				formatted = new LLImageBMP(); 
 				break;
 			}
-			if (previewp->mFormattedImage->encode(previewp->mPreviewImage, 0))
-			{
-				previewp->mDataSize = previewp->mFormattedImage->getDataSize();
-				// special case BMP to copy instead of decode otherwise decode will crash.
-				if(format == LLFloaterSnapshot::SNAPSHOT_FORMAT_BMP)
-				{
-					previewp->mPreviewImageEncoded->copy(previewp->mPreviewImage);
-				}
-				else
-				{
-					previewp->mFormattedImage->decode(previewp->mPreviewImageEncoded, 0);
-				}
-			}
+			// special case BMP to copy instead of decode otherwise decode will crash.
+			decode = format != LLFloaterSnapshot::SNAPSHOT_FORMAT_BMP;
 		}
 
-		LLPointer<LLImageRaw> scaled = new LLImageRaw(
-			previewp->mPreviewImageEncoded->getData(),
-			previewp->mPreviewImageEncoded->getWidth(),
-			previewp->mPreviewImageEncoded->getHeight(),
-			previewp->mPreviewImageEncoded->getComponents());
-		
-		if(!scaled->isBufferInvalid())
-		{
-			// leave original image dimensions, just scale up texture buffer
-			if (previewp->mPreviewImageEncoded->getWidth() > 1024 || previewp->mPreviewImageEncoded->getHeight() > 1024)
-			{
-				// go ahead and shrink image to appropriate power of 2 for display
-				scaled->biasedScaleToPowerOfTwo(1024);
-				previewp->mImageScaled[previewp->mCurImageIndex] = TRUE;
-			}
-			else
-			{
-				// expand image but keep original image data intact
-				scaled->expandToPowerOfTwo(1024, FALSE);
-			}
-
-			previewp->mViewerImage[previewp->mCurImageIndex] = LLViewerTextureManager::getLocalTexture(scaled.get(), FALSE);
-			LLPointer<LLViewerTexture> curr_preview_image = previewp->mViewerImage[previewp->mCurImageIndex];
-			gGL.getTexUnit(0)->bind(curr_preview_image);
-			if (previewp->getSnapshotType() != SNAPSHOT_TEXTURE)
-			{
-				curr_preview_image->setFilteringOption(LLTexUnit::TFO_POINT);
-			}
-			else
-			{
-				curr_preview_image->setFilteringOption(LLTexUnit::TFO_ANISOTROPIC);
-			}
-			curr_preview_image->setAddressMode(LLTexUnit::TAM_CLAMP);
+		previewp->mPosTakenGlobal = gAgentCamera.getCameraPositionGlobal();
 
-			previewp->mSnapshotUpToDate = TRUE;
-			//Resize to thumbnail.
+		LLPointer<LLImageEncodeThread::Responder> responder =
+			new LLSnapshotEncodeResponder(previewp->getHandle(), previewp->mEncodeGeneration);
+		if (!LLImageEncodeThread::encodeImage(raw, formatted, decode, responder))
+		{
+			// no encode threads (shutting down), do it here.
+			bool success = formatted->encode(raw, 0);
+			LLPointer<LLImageRaw> decoded;
+			if (success && decode)
 			{
-				previewp->mThumbnailUpToDate = TRUE ;
-				previewp->mThumbnailUpdateLock = TRUE ;
-				S32 w = get_lower_power_two(scaled->getWidth(), 512) * 2 ;
-				S32 h = get_lower_power_two(scaled->getHeight(), 512) * 2 ;
-				scaled->scale(w,h);
-				previewp->mThumbnailImage =  LLViewerTextureManager::getLocalTexture(scaled.get(), FALSE);
-				previewp->mThumbnailUpdateLock = FALSE ;
-				previewp->setThumbnailImageSize();
+				decoded = new LLImageRaw(formatted->getWidth(), formatted->getHeight(), formatted->getComponents());
+				if (!formatted->decode(decoded, 0))
+				{
+					decoded = NULL;
+				}
 			}
-
-			previewp->mPosTakenGlobal = gAgentCamera.getCameraPositionGlobal();
-			previewp->mShineCountdown = 4; // wait a few frames to avoid animation glitch due to readback this frame
+			responder->completed(success, formatted, decoded);
 		}
 	}
-	previewp->getWindow()->decBusyCount();
 	// only show fullscreen preview when in freeze frame mode
 	previewp->setVisible(gSavedSettings.getBOOL("UseFreezeFrame"));
 	previewp->mSnapshotDelayTimer.stop();
@@ -911,6 +902,89 @@ BOOL LLSnapshotLivePreview::onIdle( void* snapshot_preview )
 	return TRUE;
 }
 
+void LLSnapshotLivePreview::onPreviewEncoded(U32 generation, bool success, LLImageFormatted* formatted, LLImageRaw* decoded)
+{
+	if (generation != mEncodeGeneration)
+	{
+		// the snapshot was invalidated or retaken while it was being encoded.
+		return;
+	}
+	mPreviewEncoded = TRUE;
+
+	if (success)
+	{
+		mFormattedImage = formatted;
+		mDataSize = formatted->getDataSize();
+	}
+	else
+	{
+		llwarns << "Error encoding snapshot" << llendl;
+	}
+
+	if (decoded)
+	{
+		mPreviewImageEncoded = decoded;
+	}
+	else
+	{
+		mPreviewImageEncoded = new LLImageRaw(
+			mPreviewImage->getData(),
+			mPreviewImage->getWidth(),
+			mPreviewImage->getHeight(),
+			mPreviewImage->getComponents());
+	}
+
+	LLPointer<LLImageRaw> scaled = new LLImageRaw(
+		mPreviewImageEncoded->getData(),
+		mPreviewImageEncoded->getWidth(),
+		mPreviewImageEncoded->getHeight(),
+		mPreviewImageEncoded->getComponents());
+	
+	if(!scaled->isBufferInvalid())
+	{
+		// leave original image dimensions, just scale up texture buffer
+		if (mPreviewImageEncoded->getWidth() > 1024 || mPreviewImageEncoded->getHeight() > 1024)
+		{
+			// go ahead and shrink image to appropriate power of 2 for display
+			scaled->biasedScaleToPowerOfTwo(1024);
+			mImageScaled[mCurImageIndex] = TRUE;
+		}
+		else
+		{
+			// expand image but keep original image data intact
+			scaled->expandToPowerOfTwo(1024, FALSE);
+		}
+
+		mViewerImage[mCurImageIndex] = LLViewerTextureManager::getLocalTexture(scaled.get(), FALSE);
+		LLPointer<LLViewerTexture> curr_preview_image = mViewerImage[mCurImageIndex];
+		gGL.getTexUnit(0)->bind(curr_preview_image);
+		if (getSnapshotType() != SNAPSHOT_TEXTURE)
+		{
+			curr_preview_image->setFilteringOption(LLTexUnit::TFO_POINT);
+		}
+		else
+		{
+			curr_preview_image->setFilteringOption(LLTexUnit::TFO_ANISOTROPIC);
+		}
+		curr_preview_image->setAddressMode(LLTexUnit::TAM_CLAMP);
+
+		mSnapshotUpToDate = TRUE;
+		//Resize to thumbnail.
+		{
+			mThumbnailUpToDate = TRUE ;
+			mThumbnailUpdateLock = TRUE ;
+			S32 w = get_lower_power_two(scaled->getWidth(), 512) * 2 ;
+			S32 h = get_lower_power_two(scaled->getHeight(), 512) * 2 ;
+			scaled->scale(w,h);
+			mThumbnailImage =  LLViewerTextureManager::getLocalTexture(scaled.get(), FALSE);
+			mThumbnailUpdateLock = FALSE ;
+			setThumbnailImageSize();
+		}
+
+		mShineCountdown = 4; // wait a few frames to avoid animation glitch due to readback this frame
+	}
+}
+
 void LLSnapshotLivePreview::setSize(S32 w, S32 h)
 {
 	mWidth[mCurImageIndex] = w;
@@ -962,15 +1036,9 @@ void LLSnapshotLivePreview::saveTexture()
 	tid.generate();
 	LLAssetID new_asset_id = tid.makeAssetID(gAgent.getSecureSessionID());
 		
-	LLPointer<LLImageJ2C> formatted = new LLImageJ2C;
-	LLPointer<LLImageRaw> scaled = new LLImageRaw(mPreviewImage->getData(),
-												  mPreviewImage->getWidth(),
-												  mPreviewImage->getHeight(),
-												  mPreviewImage->getComponents());
-	
-	scaled->biasedScaleToPowerOfTwo(512);
-			
-	if (formatted->encode(scaled, 0.0f))
+	// the J2C was already made from the scaled down preview by onIdle().
+	LLImageJ2C* formatted = dynamic_cast<LLImageJ2C*>(mFormattedImage.get());
+	if (formatted && formatted->getDataSize() > 0)
 	{
 		LLVFile::writeFile(formatted->getData(), formatted->getDataSize(), gVFS, new_asset_id, LLAssetType::AT_TEXTURE);
 		std::string pos_string;
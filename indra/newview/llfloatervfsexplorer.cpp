@@ -16,12 +16,15 @@ std::map<LLVFSFileSpecifier, LLVFSFileBlock*> LLFloaterVFSExplorer::sVFSFileMap;
 
 LLFloaterVFSExplorer::LLFloaterVFSExplorer()
 :	LLFloater(),
-	mEditID(LLUUID::null)
+	mEditID(LLUUID::null),
+	mSortColumn(-1),
+	mSortAscending(TRUE)
 {
 	LLUICtrlFactory::getInstance()->buildFloater(this, "floater_vfs_explorer.xml");
 }
 LLFloaterVFSExplorer::~LLFloaterVFSExplorer()
 {
+	getChild<LLScrollListCtrl>("file_list")->setDataSource(NULL);
 	sInstance = NULL;
 }
 // static
@@ -43,30 +46,64 @@ BOOL LLFloaterVFSExplorer::postBuild()
 	childSetAction("copy_uuid_btn", onClickCopyUUID, this);
 	childSetAction("edit_data_btn", onClickEditData, this);
 	childSetAction("item_btn", onClickItem, this);
+	getChild<LLScrollListCtrl>("file_list")->setDataSource(this);
 	refresh();
 	return TRUE;
 }
 void LLFloaterVFSExplorer::refresh()
 {
 	LLScrollListCtrl* list = getChild<LLScrollListCtrl>("file_list");
-	list->clearRows();
 	sVFSFileMap = gVFS->getFileList();
+	mRows.clear();
 	std::map<LLVFSFileSpecifier, LLVFSFileBlock*>::iterator end = sVFSFileMap.end();
 	for(std::map<LLVFSFileSpecifier, LLVFSFileBlock*>::iterator iter = sVFSFileMap.begin(); iter != end; ++iter)
 	{
-		LLVFSFileSpecifier file_spec = iter->first;
-		LLSD element;
-		element["id"] = file_spec.mFileID;
-		LLSD& name_column = element["columns"][0];
-		name_column["column"] = "name";
-		name_column["value"] = file_spec.mFileID.asString();
-		LLSD& type_column = element["columns"][1];
-		type_column["column"] = "type";
-		type_column["value"] = std::string(LLAssetType::lookup(file_spec.mFileType));
-		list->addElement(element, ADD_BOTTOM);
+		mRows.push_back(iter->first);
 	}
+	if(mSortColumn >= 0)
+		sortRows(mSortColumn, mSortAscending);
+	list->dataChanged();
 	setEditID(mEditID);
 }
+S32 LLFloaterVFSExplorer::getRowCount() const
+{
+	return mRows.size();
+}
+LLSD LLFloaterVFSExplorer::getRow(S32 index) const
+{
+	const LLVFSFileSpecifier& file_spec = mRows[index];
+	LLSD element;
+	element["id"] = file_spec.mFileID;
+	LLSD& name_column = element["columns"][0];
+	name_column["column"] = "name";
+	name_column["value"] = file_spec.mFileID.asString();
+	LLSD& type_column = element["columns"][1];
+	type_column["column"] = "type";
+	type_column["value"] = std::string(LLAssetType::lookup(file_spec.mFileType));
+	return element;
+}
+// Same order as the list sorts text cells in
+struct vfs_row_less
+{
+	vfs_row_less(S32 column, BOOL ascending) : mColumn(column), mAscending(ascending) { }
+	std::string text(const LLVFSFileSpecifier& file_spec) const
+	{
+		return mColumn == 0 ? file_spec.mFileID.asString() : std::string(LLAssetType::lookup(file_spec.mFileType));
+	}
+	bool operator()(const LLVFSFileSpecifier& lhs, const LLVFSFileSpecifier& rhs) const
+	{
+		S32 order = LLStringUtil::compareDict(text(lhs), text(rhs));
+		return mAscending ? order < 0 : order > 0;
+	}
+	S32 mColumn;
+	BOOL mAscending;
+};
+void LLFloaterVFSExplorer::sortRows(S32 column, BOOL ascending)
+{
+	mSortColumn = column;
+	mSortAscending = ascending;
+	std::stable_sort(mRows.begin(), mRows.end(), vfs_row_less(column, ascending));
+}
 void LLFloaterVFSExplorer::reloadAll()
 {
 	//get our magic from gvfs here
@@ -76,7 +113,15 @@ void LLFloaterVFSExplorer::reloadAll()
 void LLFloaterVFSExplorer::setEditID(LLUUID edit_id)
 {
 	LLScrollListCtrl* list = getChild<LLScrollListCtrl>("file_list");
-	bool found_in_list = (list->getItemIndex(edit_id) != -1);
+	bool found_in_list = false;
+	for(std::vector<LLVFSFileSpecifier>::iterator iter = mRows.begin(); iter != mRows.end(); ++iter)
+	{
+		if(iter->mFileID == edit_id)
+		{
+			found_in_list = true;
+			break;
+		}
+	}
 	bool found_in_files = false;
 	LLVFSFileSpecifier file;
 	std::map<LLVFSFileSpecifier, LLVFSFileBlock*>::iterator end = sVFSFileMap.end();
@@ -92,7 +137,11 @@ void LLFloaterVFSExplorer::setEditID(LLUUID edit_id)
 	if(found_in_files && found_in_list)
 	{
 		mEditID = edit_id;
-		list->selectByID(edit_id);
+		// the row may be outside the page the list has items for
+		LLDynamicArray<LLUUID> ids;
+		ids.push_back(edit_id);
+		list->deselectAllItems(TRUE);
+		list->selectMultiple(ids);
 		setEditEnabled(true);
 		childSetText("name_edit", file.mFileID.asString());
 		childSetText("id_edit", file.mFileID.asString());
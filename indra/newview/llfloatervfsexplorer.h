@@ -4,9 +4,12 @@
 
 #include "llfloater.h"
 #include "llassettype.h"
+#include "llscrolllistctrl.h"
 #include "llvfs.h"
 
-class LLFloaterVFSExplorer : LLFloater
+// The file list asks for the rows it shows, so a cache with many thousands
+// of files only builds list items for the visible page.
+class LLFloaterVFSExplorer : LLFloater, public LLScrollListDataSource
 {
 typedef struct
 {
@@ -25,6 +28,9 @@ public:
 	void removeEntry();
 	void setEditID(LLUUID edit_id);
 	LLVFSFileSpecifier getEditEntry();
+	/*virtual*/ S32 getRowCount() const;
+	/*virtual*/ LLSD getRow(S32 index) const;
+	/*virtual*/ void sortRows(S32 column, BOOL ascending);
 	static void onCommitFileList(LLUICtrl* ctrl, void* user_data);
 	static void onClickCopyUUID(void* user_data);
 	static void onClickRemove(void* user_data);
@@ -35,6 +41,10 @@ private:
 	static LLFloaterVFSExplorer* sInstance;
 	static std::map<LLVFSFileSpecifier, LLVFSFileBlock*> sVFSFileMap;
 	LLUUID mEditID;
+	// The files in sVFSFileMap, in list order
+	std::vector<LLVFSFileSpecifier> mRows;
+	S32 mSortColumn;
+	BOOL mSortAscending;
 	void setEditEnabled(bool enabled);
 };
 #endif
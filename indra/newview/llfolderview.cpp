@@ -83,6 +83,7 @@ const S32 ARROW_SIZE = 12;
 const S32 RENAME_WIDTH_PAD = 4;
 const S32 RENAME_HEIGHT_PAD = 6;
 const S32 AUTO_OPEN_STACK_DEPTH = 16;
+const S32 INDEXED_CHECKS_PER_ITEM = 16;	// filter checks the inventory name index settles per FilterItemsPerFrame item
 const S32 MIN_ITEM_WIDTH_VISIBLE = ICON_WIDTH + ICON_PAD + ARROW_SIZE + TEXT_PAD + /*first few characters*/ 40;
 const S32 MINIMUM_RENAMER_WIDTH = 80;
 const F32 FOLDER_CLOSE_TIME_CONSTANT = 0.02f;
@@ -168,6 +169,7 @@ LLFolderViewItem::LLFolderViewItem( const std::string& name, LLUIImagePtr icon,
 	mIndentation(0),
 	mFiltered(FALSE),
 	mLastFilterGeneration(-1),
+	mLabelIsObjectName(FALSE),
 	mStringMatchOffset(std::string::npos),
 	mControlLabelRotation(0.f),
 	mRoot( root ),
@@ -321,6 +323,10 @@ void LLFolderViewItem::refreshFromListener()
 			}
 		}
 		mSearchableLabelCreator = creator_name;
+
+		// The inventory name index only knows the object's own name
+		LLInventoryObject* obj = item ? item : gInventory.getObject(mListener->getUUID());
+		mLabelIsObjectName = obj && mLabelSuffix.empty() && mLabel == obj->getName();
 	}
 }
 
@@ -4656,6 +4662,13 @@ LLInventoryFilter::LLInventoryFilter(const std::string& name) :
 	mLastLogoff = gSavedPerAccountSettings.getU32("LastLogoff");
 	mFilterBehavior = FILTER_NONE;
 
+	mIndexedSearchType = 0;
+	mIndexVersion = 0;
+	mIndexFrame = 0;
+	mIndexUsable = FALSE;
+	mLastCheckIndexed = FALSE;
+	mIndexedCheckCount = 0;
+
 	// copy mFilterOps into mDefaultFilterOps
 	markDefault();
 }
@@ -4686,9 +4699,49 @@ BOOL LLInventoryFilter::check(LLFolderViewItem* item)
 	{
 		earliest = 0;
 	}
-	mSubStringMatchOffset = mFilterSubString.size() ? item->getSearchableLabel().find(mFilterSubString) : std::string::npos;
+
+	mSubStringMatchOffset = std::string::npos;
+	if (mFilterSubString.size())
+	{
+		U32 search_type = item->getRoot()->getSearchType();
+		if (updateIndexMatches(search_type))
+		{
+			if (std::binary_search(mIndexMatches.begin(), mIndexMatches.end(), item_id))
+			{
+				// The index knows the object, not the label shown for it,
+				// which can differ for a link or an item renamed since
+				mSubStringMatchOffset = item->getSearchableLabel().find(mFilterSubString);
+				if (mSubStringMatchOffset == std::string::npos)
+				{
+					return FALSE;
+				}
+			}
+			else if (!item->getLabelIsObjectName() && (search_type == 0 || (search_type & 1)))
+			{
+				// Only a label suffix the index does not know about can still match
+				mSubStringMatchOffset = item->getSearchableName().find(mFilterSubString);
+				if (mSubStringMatchOffset == std::string::npos)
+				{
+					return FALSE;
+				}
+			}
+			else
+			{
+				mLastCheckIndexed = TRUE;
+				return FALSE;
+			}
+		}
+		else
+		{
+			mSubStringMatchOffset = item->getSearchableLabel().find(mFilterSubString);
+			if (mSubStringMatchOffset == std::string::npos)
+			{
+				return FALSE;
+			}
+		}
+	}
+
 	BOOL passed = (0x1 << listener->getInventoryType() & mFilterOps.mFilterTypes || listener->getInventoryType() == LLInventoryType::IT_NONE)
-					&& (mFilterSubString.size() == 0 || mSubStringMatchOffset != std::string::npos)
 					&& (mFilterWorn == false || gAgentWearables.isWearingItem(item_id) ||
 						(gAgent.getAvatarObject() && gAgent.getAvatarObject()->isWearingAttachment(item_id)))
 					&& ((listener->getPermissionMask() & mFilterOps.mPermissions) == mFilterOps.mPermissions)
@@ -4696,6 +4749,55 @@ BOOL LLInventoryFilter::check(LLFolderViewItem* item)
 	return passed;
 }
 
+// Refreshes the index matches at most once a frame; the inventory does
+// not change while a frame's share of the folder view is filtered.
+BOOL LLInventoryFilter::updateIndexMatches(U32 search_type)
+{
+	// The searchable label joins the searched fields with spaces, so a
+	// string with a space can match across them. The index searches each
+	// field on its own; leave those strings to the label search.
+	if ((search_type & (search_type - 1)) && mFilterSubString.find(' ') != std::string::npos)
+	{
+		return FALSE;
+	}
+
+	U32 frame = LLFrameTimer::getFrameCount();
+	if (frame == mIndexFrame && mIndexedSubString == mFilterSubString && mIndexedSearchType == search_type)
+	{
+		return mIndexUsable;
+	}
+	mIndexFrame = frame;
+
+	U32 version = gInventory.getNameIndexVersion(search_type);
+	if (mIndexedSubString != mFilterSubString || mIndexedSearchType != search_type || mIndexVersion != version)
+	{
+		mIndexedSubString = mFilterSubString;
+		mIndexedSearchType = search_type;
+		mIndexVersion = version;
+		mIndexUsable = gInventory.findObjectsWithSubString(mFilterSubString, search_type, mIndexMatches);
+		if (!mIndexUsable)
+		{
+			mIndexMatches.clear();
+		}
+	}
+	return mIndexUsable;
+}
+
+void LLInventoryFilter::decrementFilterCount()
+{
+	// Items the name index turned away cost a lookup rather than a
+	// string search, so many of them fit in one item's share of the frame.
+	if (mLastCheckIndexed)
+	{
+		mLastCheckIndexed = FALSE;
+		if (++mIndexedCheckCount % INDEXED_CHECKS_PER_ITEM)
+		{
+			return;
+		}
+	}
+	mFilterCount--;
+}
+
 const std::string LLInventoryFilter::getFilterSubString(BOOL trim)
 {
 	return mFilterSubString;
@@ -229,7 +229,7 @@ public:
 
 	void setFilterCount(S32 count) { mFilterCount = count; }
 	S32 getFilterCount() { return mFilterCount; }
-	void decrementFilterCount() { mFilterCount--; }
+	void decrementFilterCount();
 	
 	void markDefault();
 	void resetDefault();
@@ -270,6 +270,17 @@ protected:
 	S32				mNextFilterGeneration;
 	EFilterBehavior mFilterBehavior;
 
+	// Objects the inventory name index found for mIndexedSubString
+	BOOL updateIndexMatches(U32 search_type);
+	uuid_vec_t		mIndexMatches;
+	std::string		mIndexedSubString;
+	U32				mIndexedSearchType;
+	U32				mIndexVersion;
+	U32				mIndexFrame;
+	BOOL			mIndexUsable;
+	BOOL			mLastCheckIndexed;	// last check() was settled by an index lookup
+	S32				mIndexedCheckCount;
+
 private:
 	U32 mLastLogoff;
 	BOOL mModified;
@@ -341,6 +352,7 @@ protected:
 
 	std::string					mLabel;
 	std::string					mSearchableLabel;
+	BOOL						mLabelIsObjectName;
 	std::string					mSearchableLabelDesc;
 	std::string					mSearchableLabelCreator;
 	std::string					mSearchable;
@@ -469,6 +481,11 @@ public:
 
 	std::string& getSearchableLabel( void );
 
+	// The upper cased label and suffix alone, and whether that is just
+	// the inventory object's name, as the inventory name index sees it.
+	const std::string& getSearchableName() const { return mSearchableLabel; }
+	BOOL getLabelIsObjectName() const { return mLabelIsObjectName; }
+
 	// This method returns the label displayed on the view. This
 	// method was primarily added to allow sorting on the folder
 	// contents possible before the entire view has been constructed.
@@ -268,6 +268,9 @@ void LLHUDObject::renderAll()
 {
 	LLHUDObject *hud_objp;
 	
+	// Text without bubbles goes first, in one batch per font
+	LLHUDText::renderAllBatched();
+
 	hud_object_list_t::iterator object_it;
 	for (object_it = sHUDObjects.begin(); object_it != sHUDObjects.end(); )
 	{
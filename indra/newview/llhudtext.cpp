@@ -77,10 +77,27 @@ const F32 MAX_STABLE_CAMERA_VELOCITY = 0.1f;
 const F32 LOD_0_SCREEN_COVERAGE = 0.15f;
 const F32 LOD_1_SCREEN_COVERAGE = 0.30f;
 const F32 LOD_2_SCREEN_COVERAGE = 0.40f;
-
-std::set<LLPointer<LLHUDText> > LLHUDText::sTextObjects;
+// updateVisibility() pushes text this far towards the camera at most
+const F32 MAX_OBJECT_RADIUS = 26.f;
+const F32 GRID_CELL_SIZE = 32.f;
+// Static texts outside the cells near the camera have their positions
+// refreshed round robin, at least this many a frame and all of them
+// every GRID_REFRESH_FRAMES frames, so a moved object is rebinned soon.
+const U32 GRID_MIN_REFRESH = 16;
+const U32 GRID_REFRESH_FRAMES = 16;
+// renderAllBatched() groups lines by font only among texts this close in
+// distance from the camera.
+const F32 BATCH_DEPTH_BUCKET_SIZE = 4.f;
+
+std::vector<LLPointer<LLHUDText> > LLHUDText::sTextObjects;
 std::vector<LLPointer<LLHUDText> > LLHUDText::sVisibleTextObjects;
 std::vector<LLPointer<LLHUDText> > LLHUDText::sVisibleHUDTextObjects;
+LLHUDTextGrid<LLHUDText> LLHUDText::sTextGrid(GRID_CELL_SIZE);
+std::vector<LLHUDText*> LLHUDText::sUnbinnedTexts;
+F32 LLHUDText::sGridReach = 0.f;
+U32 LLHUDText::sRefreshIndex = 0;
+U32 LLHUDText::sVisitFrame = 0;
+std::vector<LLHUDTextBatchLine> LLHUDText::sBatchLines;
 BOOL LLHUDText::sDisplayText = TRUE ;
 
 bool lltextobject_further_away::operator()(const LLPointer<LLHUDText>& lhs, const LLPointer<LLHUDText>& rhs) const
@@ -104,7 +121,10 @@ LLHUDText::LLHUDText(const U8 type) :
 			mTextAlignment(ALIGN_TEXT_CENTER),
 			mVertAlignment(ALIGN_VERT_CENTER),
 			mLOD(0),
-			mHidden(FALSE)
+			mHidden(FALSE),
+			mLayoutDirty(TRUE),
+			mBinned(FALSE),
+			mVisitFrame(0)
 {
 	mColor = LLColor4(1.f, 1.f, 1.f, 1.f);
 	mDoFade = TRUE;
@@ -114,8 +134,9 @@ LLHUDText::LLHUDText(const U8 type) :
 	mDropShadow = TRUE;
 	mOffscreen = FALSE;
 	mRadius = 0.1f;
-	LLPointer<LLHUDText> ptr(this);
-	sTextObjects.insert(ptr);
+	hud_text_list_add(sTextObjects, this, &LLHUDText::mTextIndex);
+	// Visited every frame until updateVisibility() knows where it is
+	sUnbinnedTexts.push_back(this);
 	//LLDebugVarMessageBox::show("max width", &HUD_TEXT_MAX_WIDTH, 500.f, 1.f);
 }
 
@@ -232,7 +253,8 @@ BOOL LLHUDText::lineSegmentIntersect(const LLVector3& start, const LLVector3& en
 
 void LLHUDText::render()
 {
-	if (!mOnHUDAttachment && sDisplayText)
+	// Text without a bubble is drawn by renderAllBatched()
+	if (!mOnHUDAttachment && sDisplayText && mUseBubble)
 	{
 		LLGLDepthTest gls_depth(GL_TRUE, GL_FALSE);
 		renderText(FALSE);
@@ -266,22 +288,18 @@ void LLHUDText::renderText(BOOL for_select)
 	LLGLState gls_alpha(GL_ALPHA_TEST, for_select ? FALSE : TRUE);
 	
 	LLColor4 shadow_color(0.f, 0.f, 0.f, 1.f);
-	F32 alpha_factor = 1.f;
+	F32 alpha_factor = getAlphaFactor();
 	LLColor4 text_color = mColor;
-	if (mDoFade)
-	{
-		if (mLastDistance > mFadeDistance)
-		{
-			alpha_factor = llmax(0.f, 1.f - (mLastDistance - mFadeDistance)/mFadeRange);
-			text_color.mV[3] = text_color.mV[3]*alpha_factor;
-		}
-	}
+	text_color.mV[3] = text_color.mV[3]*alpha_factor;
 	if (text_color.mV[3] < 0.01f)
 	{
 		return;
 	}
 	shadow_color.mV[3] = text_color.mV[3];
 
+	// Content may have changed since updateAll()
+	updateSize();
+
 	mOffsetY = lltrunc(mHeight * ((mVertAlignment == ALIGN_VERT_CENTER) ? 0.5f : 1.f));
 
 	// *TODO: cache this image
@@ -482,76 +500,26 @@ void LLHUDText::renderText(BOOL for_select)
 		LLUI::popMatrix();
 	}
 
-	F32 y_offset = (F32)mOffsetY;
-		
-	// Render label
-	{
-		gGL.getTexUnit(0)->setTextureBlendType(LLTexUnit::TB_MULT);
-
-		for(std::vector<LLHUDTextSegment>::iterator segment_iter = mLabelSegments.begin();
-			segment_iter != mLabelSegments.end(); ++segment_iter )
-		{
-			const LLFontGL* fontp = segment_iter->mFont;
-			y_offset -= fontp->getLineHeight();
-
-			F32 x_offset;
-			if (mTextAlignment == ALIGN_TEXT_CENTER)
-			{
-				x_offset = -0.5f*segment_iter->getWidth(fontp);
-			}
-			else // ALIGN_LEFT
-			{
-				x_offset = -0.5f * mWidth + (HORIZONTAL_PADDING / 2.f);
-			}
-
-			LLColor4 label_color(0.f, 0.f, 0.f, 1.f);
-			label_color.mV[VALPHA] = alpha_factor;
-			hud_render_text(segment_iter->getText(), render_position, *fontp, segment_iter->mStyle, x_offset, y_offset, label_color, mOnHUDAttachment);
-		}
-	}
-
-	// Render text
+	// Render label and text, as laid out by updateLayout()
+	gGL.getTexUnit(0)->setTextureBlendType(LLTexUnit::TB_MULT);
+	for (std::vector<LLHUDTextLine>::iterator line_iter = mLines.begin();
+		 line_iter != mLines.end(); ++line_iter)
 	{
-		// -1 mMaxLines means unlimited lines.
-		S32 start_segment;
-		S32 max_lines = getMaxLines();
-
-		if (max_lines < 0) 
+		LLColor4 line_color;
+		const LLHUDTextSegment* segment;
+		if (line_iter->mIsLabel)
 		{
-			start_segment = 0;
+			segment = &mLabelSegments[line_iter->mSegment];
+			line_color.setVec(0.f, 0.f, 0.f, alpha_factor);
 		}
-		else 
+		else
 		{
-			start_segment = llmax((S32)0, (S32)mTextSegments.size() - max_lines);
-		}
-
-		for (std::vector<LLHUDTextSegment>::iterator segment_iter = mTextSegments.begin() + start_segment;
-			 segment_iter != mTextSegments.end(); ++segment_iter )
-		{
-			const LLFontGL* fontp = (segment_iter->mStyle == LLFontGL::BOLD) ? mBoldFontp : mFontp;
-			y_offset -= fontp->getLineHeight();
-
-			U8 style = segment_iter->mStyle;
-			if (mDropShadow)
-			{
-				style |= LLFontGL::DROP_SHADOW;
-			}
-	
-			F32 x_offset;
-			if (mTextAlignment== ALIGN_TEXT_CENTER)
-			{
-				x_offset = -0.5f*segment_iter->getWidth(fontp);
-			}
-			else // ALIGN_LEFT
-			{
-				x_offset = -0.5f * mWidth + (HORIZONTAL_PADDING / 2.f);
-			}
-
-			text_color = segment_iter->mColor;
-			text_color.mV[VALPHA] *= alpha_factor;
-
-			hud_render_text(segment_iter->getText(), render_position, *fontp, style, x_offset, y_offset, text_color, mOnHUDAttachment);
+			segment = &mTextSegments[line_iter->mSegment];
+			line_color = segment->mColor;
+			line_color.mV[VALPHA] *= alpha_factor;
 		}
+		hud_render_text(segment->getText(), render_position, *line_iter->mFont, line_iter->mStyle,
+						line_iter->mXOffset, (F32)mOffsetY + line_iter->mYOffset, line_color, mOnHUDAttachment);
 	}
 	/// Reset the default color to white.  The renderer expects this to be the default. 
 	glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
@@ -593,12 +561,14 @@ void LLHUDText::setStringUTF8(const std::string &wtext)
 void LLHUDText::setString(const LLWString &wtext)
 {
 	mTextSegments.clear();
+	mLayoutDirty = TRUE;
 	addLine(wtext, mColor);
 }
 
 void LLHUDText::clearString()
 {
 	mTextSegments.clear();
+	mLayoutDirty = TRUE;
 }
 
 
@@ -640,6 +610,7 @@ void LLHUDText::addLine(const LLWString &wstr, const LLColor4& color, const LLFo
 			while (line_length != iter->size());
 			++iter;
 		}
+		mLayoutDirty = TRUE;
 	}
 }
 
@@ -652,6 +623,7 @@ void LLHUDText::setLabel(const std::string &label)
 void LLHUDText::setLabel(const LLWString &wlabel)
 {
 	mLabelSegments.clear();
+	mLayoutDirty = TRUE;
 	addLabel(wlabel);
 }
 
@@ -682,12 +654,17 @@ void LLHUDText::addLabel(const LLWString &wlabel)
 			while (line_length != iter->size());
 			++iter;
 		}
+		mLayoutDirty = TRUE;
 	}
 }
 
 void LLHUDText::setDropShadow(const BOOL do_shadow)
 {
-	mDropShadow = do_shadow;
+	if (mDropShadow != do_shadow)
+	{
+		mDropShadow = do_shadow;
+		mLayoutDirty = TRUE;
+	}
 }
 
 void LLHUDText::setZCompare(const BOOL zcompare)
@@ -697,7 +674,51 @@ void LLHUDText::setZCompare(const BOOL zcompare)
 
 void LLHUDText::setFont(const LLFontGL* font)
 {
-	mFontp = font;
+	if (mFontp != font)
+	{
+		mFontp = font;
+		mLayoutDirty = TRUE;
+	}
+}
+
+void LLHUDText::setMaxLines(S32 max_lines)
+{
+	if (mMaxLines != max_lines)
+	{
+		mMaxLines = max_lines;
+		mLayoutDirty = TRUE;
+	}
+}
+
+void LLHUDText::setTextAlignment(ETextAlignment alignment)
+{
+	if (mTextAlignment != alignment)
+	{
+		mTextAlignment = alignment;
+		mLayoutDirty = TRUE;
+	}
+}
+
+// The next three change whether the text may be culled by the grid, so
+// it is visited every frame until updateVisibility() files it again.
+
+void LLHUDText::setFadeDistance(F32 fade_distance, F32 fade_range)
+{
+	mFadeDistance = fade_distance;
+	mFadeRange = fade_range;
+	unbin();
+}
+
+void LLHUDText::setVisibleOffScreen(BOOL visible)
+{
+	mVisibleOffScreen = visible;
+	unbin();
+}
+
+void LLHUDText::setOnHUDAttachment(BOOL on_hud)
+{
+	mOnHUDAttachment = on_hud;
+	unbin();
 }
 
 
@@ -730,6 +751,7 @@ void LLHUDText::setUsePixelSize(const BOOL use_pixel_size)
 void LLHUDText::setDoFade(const BOOL do_fade)
 {
 	mDoFade = do_fade;
+	unbin();
 }
 
 // <edit>
@@ -757,6 +779,7 @@ void LLHUDText::updateVisibility()
 	}
 	
 	mPositionAgent = gAgent.getPosAgentFromGlobal(mPositionGlobal);
+	updateBinning();
 
 	if (!mSourceObject)
 	{
@@ -910,6 +933,12 @@ LLVector2 LLHUDText::updateScreenPos(LLVector2 &offset)
 
 void LLHUDText::updateSize()
 {
+	if (!mLayoutDirty)
+	{
+		return;
+	}
+	mLayoutDirty = FALSE;
+
 	F32 height = 0.f;
 	F32 width = 0.f;
 
@@ -938,6 +967,7 @@ void LLHUDText::updateSize()
 	
 	if (width == 0.f)
 	{
+		mLines.clear();
 		return;
 	}
 
@@ -958,19 +988,171 @@ void LLHUDText::updateSize()
 
 	mWidth = llmax(width, lerp(mWidth, (F32)width, u));
 	mHeight = llmax(height, lerp(mHeight, (F32)height, u));
+
+	updateLayout();
+}
+
+// Places the label and text lines below the top of the text, so that
+// rendering only has to add the vertical alignment offset.
+void LLHUDText::updateLayout()
+{
+	mLines.clear();
+
+	F32 y_offset = 0.f;
+	for (S32 i = 0; i < (S32)mLabelSegments.size(); i++)
+	{
+		LLHUDTextSegment& segment = mLabelSegments[i];
+		LLHUDTextLine line;
+		line.mSegment = i;
+		line.mIsLabel = TRUE;
+		line.mFont = segment.mFont;
+		line.mStyle = segment.mStyle;
+		y_offset -= line.mFont->getLineHeight();
+		line.mYOffset = y_offset;
+		if (mTextAlignment == ALIGN_TEXT_CENTER)
+		{
+			line.mXOffset = -0.5f * segment.getWidth(line.mFont);
+		}
+		else // ALIGN_LEFT
+		{
+			line.mXOffset = -0.5f * mWidth + (HORIZONTAL_PADDING / 2.f);
+		}
+		mLines.push_back(line);
+	}
+
+	// -1 mMaxLines means unlimited lines.
+	S32 max_lines = getMaxLines();
+	S32 start_segment = max_lines < 0 ? 0 : llmax((S32)0, (S32)mTextSegments.size() - max_lines);
+	for (S32 i = start_segment; i < (S32)mTextSegments.size(); i++)
+	{
+		LLHUDTextSegment& segment = mTextSegments[i];
+		LLHUDTextLine line;
+		line.mSegment = i;
+		line.mIsLabel = FALSE;
+		line.mFont = (segment.mStyle == LLFontGL::BOLD) ? mBoldFontp : mFontp;
+		line.mStyle = segment.mStyle;
+		if (mDropShadow)
+		{
+			line.mStyle |= LLFontGL::DROP_SHADOW;
+		}
+		y_offset -= line.mFont->getLineHeight();
+		line.mYOffset = y_offset;
+		if (mTextAlignment == ALIGN_TEXT_CENTER)
+		{
+			line.mXOffset = -0.5f * segment.getWidth(line.mFont);
+		}
+		else // ALIGN_LEFT
+		{
+			line.mXOffset = -0.5f * mWidth + (HORIZONTAL_PADDING / 2.f);
+		}
+		mLines.push_back(line);
+	}
+}
+
+F32 LLHUDText::getAlphaFactor() const
+{
+	if (mDoFade && mLastDistance > mFadeDistance)
+	{
+		return llmax(0.f, 1.f - (mLastDistance - mFadeDistance)/mFadeRange);
+	}
+	return 1.f;
+}
+
+// Text that fades out with distance and follows an object that is not
+// moving can be culled by position alone, so it goes into the grid.
+void LLHUDText::updateBinning()
+{
+	BOOL binnable = mSourceObject.notNull()
+		&& !mOnHUDAttachment
+		&& mDoFade
+		&& !mVisibleOffScreen
+		&& !mSourceObject->isActive()
+		&& (mSourceObject->mDrawable.isNull() || !mSourceObject->mDrawable->isActive());
+	if (!binnable)
+	{
+		unbin();
+		return;
+	}
+
+	if (!mBinned)
+	{
+		std::vector<LLHUDText*>::iterator iter = std::find(sUnbinnedTexts.begin(), sUnbinnedTexts.end(), this);
+		if (iter != sUnbinnedTexts.end())
+		{
+			*iter = sUnbinnedTexts.back();
+			sUnbinnedTexts.pop_back();
+		}
+		mBinned = TRUE;
+	}
+	sTextGrid.update(this, mPositionAgent);
+	sGridReach = llmax(sGridReach, mFadeDistance + mFadeRange);
+}
+
+void LLHUDText::unbin()
+{
+	if (mBinned)
+	{
+		sTextGrid.remove(this);
+		mBinned = FALSE;
+		sUnbinnedTexts.push_back(this);
+	}
 }
 
 void LLHUDText::updateAll()
 {
-	// iterate over all text objects, calculate their restoration forces,
-	// and add them to the visible set if they are on screen and close enough
+	sVisitFrame++;
+
+	// Texts that are not visited this frame must not keep last frame's
+	// visibility, or picking and rendering would still see them.
+	VisibleTextObjectIterator vis_it;
+	for (vis_it = sVisibleTextObjects.begin(); vis_it != sVisibleTextObjects.end(); ++vis_it)
+	{
+		(*vis_it)->mVisible = FALSE;
+	}
+	for (vis_it = sVisibleHUDTextObjects.begin(); vis_it != sVisibleHUDTextObjects.end(); ++vis_it)
+	{
+		(*vis_it)->mVisible = FALSE;
+	}
 	sVisibleTextObjects.clear();
 	sVisibleHUDTextObjects.clear();
-	
-	TextObjectIterator text_it;
-	for (text_it = sTextObjects.begin(); text_it != sTextObjects.end(); ++text_it)
+
+	// Binned texts only follow their object when they are visited, so a
+	// few of them are refreshed every frame to catch objects that were
+	// edited or moved without becoming active.
+	U32 num_texts = sTextObjects.size();
+	if (num_texts)
+	{
+		U32 refresh_count = llmin(num_texts, llmax(GRID_MIN_REFRESH, num_texts / GRID_REFRESH_FRAMES));
+		for (U32 i = 0; i < refresh_count; i++)
+		{
+			sRefreshIndex = (sRefreshIndex + 1) % num_texts;
+			LLHUDText* textp = sTextObjects[sRefreshIndex];
+			if (textp->mBinned && textp->mSourceObject.notNull() && !textp->mSourceObject->isDead())
+			{
+				textp->mSourceObject->updateText();
+				textp->mPositionAgent = gAgent.getPosAgentFromGlobal(textp->mPositionGlobal);
+				textp->updateBinning();
+			}
+		}
+	}
+
+	// Only texts near enough to the camera to be faded in can be visible
+	std::vector<LLHUDText*> candidates;
+	F32 reach = sGridReach + MAX_OBJECT_RADIUS;
+	sTextGrid.query(LLViewerCamera::getInstance()->getOrigin(), reach, candidates);
+	// updateVisibility() can move texts out of sUnbinnedTexts, so visit a copy
+	candidates.insert(candidates.end(), sUnbinnedTexts.begin(), sUnbinnedTexts.end());
+
+	// iterate over the candidates, calculate their restoration forces,
+	// and add them to the visible set if they are on screen and close enough
+	for (std::vector<LLHUDText*>::iterator text_it = candidates.begin(); text_it != candidates.end(); ++text_it)
 	{
 		LLHUDText* textp = (*text_it);
+		if (textp->mVisitFrame == sVisitFrame)
+		{
+			continue;
+		}
+		textp->mVisitFrame = sVisitFrame;
 		textp->mTargetPositionOffset.clearVec();
 		textp->updateSize();
 		textp->updateVisibility();
@@ -1099,7 +1281,11 @@ void LLHUDText::updateAll()
 
 void LLHUDText::setLOD(S32 lod)
 {
-	mLOD = lod;
+	if (mLOD != lod)
+	{
+		mLOD = lod;
+		mLayoutDirty = TRUE;
+	}
 	//RN: uncomment this to visualize LOD levels
 	//std::string label = llformat("%d", lod);
 	//setLabel(label);
@@ -1123,7 +1309,23 @@ S32 LLHUDText::getMaxLines()
 
 void LLHUDText::markDead()
 {
-	sTextObjects.erase(LLPointer<LLHUDText>(this));
+	// Keep this alive until LLHUDObject::markDead() is done with it
+	LLPointer<LLHUDText> self = this;
+	hud_text_list_remove(sTextObjects, this, &LLHUDText::mTextIndex);
+	if (mBinned)
+	{
+		sTextGrid.remove(this);
+		mBinned = FALSE;
+	}
+	else
+	{
+		std::vector<LLHUDText*>::iterator iter = std::find(sUnbinnedTexts.begin(), sUnbinnedTexts.end(), this);
+		if (iter != sUnbinnedTexts.end())
+		{
+			*iter = sUnbinnedTexts.back();
+			sUnbinnedTexts.pop_back();
+		}
+	}
 	LLHUDObject::markDead();
 }
 
@@ -1152,6 +1354,133 @@ void LLHUDText::renderAllHUD()
 	LLGLState::checkClientArrays();
 }
 
+//static
+void LLHUDText::renderAllBatched()
+{
+	if (!sDisplayText)
+	{
+		return;
+	}
+
+	// Project every line to the screen first, back to front as sorted by
+	// updateAll(), so that each font is bound and drawn once per depth bucket.
+	sBatchLines.clear();
+	LLViewerCamera* camera = LLViewerCamera::getInstance();
+	for (VisibleTextObjectIterator text_it = sVisibleTextObjects.begin(); text_it != sVisibleTextObjects.end(); ++text_it)
+	{
+		LLHUDText* textp = (*text_it);
+		if (textp->mUseBubble || !textp->mVisible || textp->mHidden || textp->mDead)
+		{
+			continue;
+		}
+
+		F32 alpha_factor = textp->getAlphaFactor();
+		if (textp->mColor.mV[VALPHA] * alpha_factor < 0.01f)
+		{
+			continue;
+		}
+
+		// Content may have changed since updateAll()
+		textp->updateSize();
+		textp->mOffsetY = lltrunc(textp->mHeight * ((textp->mVertAlignment == ALIGN_VERT_CENTER) ? 0.5f : 1.f));
+
+		LLVector3 x_pixel_vec;
+		LLVector3 y_pixel_vec;
+		camera->getPixelVectors(textp->mPositionAgent, y_pixel_vec, x_pixel_vec);
+		textp->mRadius = (textp->mWidth * x_pixel_vec + textp->mHeight * y_pixel_vec).magVec() * 0.5f;
+
+		LLVector3 render_position = textp->mPositionAgent
+				+ (x_pixel_vec * textp->mPositionOffset.mV[VX])
+				+ (y_pixel_vec * textp->mPositionOffset.mV[VY]);
+
+		F64 win_x, win_y, win_z;
+		gluProject(render_position.mV[VX], render_position.mV[VY], render_position.mV[VZ],
+					gGLModelView, gGLProjection, (GLint*) gGLViewport,
+					&win_x, &win_y, &win_z);
+		S32 depth_bucket = llfloor(textp->mLastDistance / BATCH_DEPTH_BUCKET_SIZE);
+
+		for (std::vector<LLHUDTextLine>::iterator line_iter = textp->mLines.begin();
+			 line_iter != textp->mLines.end(); ++line_iter)
+		{
+			LLHUDTextBatchLine line;
+			const LLHUDTextSegment* segment;
+			if (line_iter->mIsLabel)
+			{
+				segment = &textp->mLabelSegments[line_iter->mSegment];
+				line.mColor.setVec(0.f, 0.f, 0.f, alpha_factor);
+			}
+			else
+			{
+				segment = &textp->mTextSegments[line_iter->mSegment];
+				line.mColor = segment->mColor;
+				line.mColor.mV[VALPHA] *= alpha_factor;
+			}
+			if (segment->getText().empty())
+			{
+				continue;
+			}
+			line.mDepthBucket = depth_bucket;
+			line.mFont = line_iter->mFont;
+			line.mText = &segment->getText();
+			line.mX = (F32)win_x + floorf(line_iter->mXOffset);
+			line.mY = (F32)win_y + floorf((F32)textp->mOffsetY + line_iter->mYOffset);
+			line.mZ = -(((F32)win_z * 2.f) - 1.f);
+			line.mStyle = line_iter->mStyle;
+			sBatchLines.push_back(line);
+		}
+	}
+
+	if (sBatchLines.empty())
+	{
+		return;
+	}
+
+	// Overlapping text is blended without depth writes, so it has to be drawn
+	// back to front. Lines are only grouped by font within a depth bucket;
+	// there a farther line in one font can still be drawn over a nearer line
+	// in another. That is accepted for texts less than BATCH_DEPTH_BUCKET_SIZE
+	// apart.
+	sort_hud_text_batch(sBatchLines);
+
+	//fonts all render orthographically, set up projection
+	glMatrixMode(GL_PROJECTION);
+	glPushMatrix();
+	glMatrixMode(GL_MODELVIEW);
+	gGL.pushMatrix();
+	LLUI::pushMatrix();
+
+	gViewerWindow->setup2DRender();
+	LLUI::loadIdentity();
+
+	{
+		LLGLDepthTest gls_depth(GL_TRUE, GL_FALSE);
+		LLGLState gls_blend(GL_BLEND, TRUE);
+		LLGLState gls_alpha(GL_ALPHA_TEST, TRUE);
+		gGL.getTexUnit(0)->enable(LLTexUnit::TT_TEXTURE);
+		gGL.getTexUnit(0)->setTextureBlendType(LLTexUnit::TB_MULT);
+		gGL.setSceneBlendType(LLRender::BT_ALPHA);
+
+		for (std::vector<LLHUDTextBatchLine>::iterator line_iter = sBatchLines.begin();
+			 line_iter != sBatchLines.end(); ++line_iter)
+		{
+			line_iter->mFont->renderBatched(*line_iter->mText, line_iter->mX, line_iter->mY, line_iter->mZ,
+											line_iter->mColor, line_iter->mStyle);
+		}
+		gGL.flush();
+	}
+
+	LLUI::popMatrix();
+	gGL.popMatrix();
+
+	glMatrixMode(GL_PROJECTION);
+	glPopMatrix();
+	glMatrixMode(GL_MODELVIEW);
+
+	/// Reset the default color to white.  The renderer expects this to be the default. 
+	glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+	sBatchLines.clear();
+}
+
 void LLHUDText::shiftAll(const LLVector3& offset)
 {
 	TextObjectIterator text_it;
@@ -1160,6 +1489,17 @@ void LLHUDText::shiftAll(const LLVector3& offset)
 		LLHUDText *textp = text_it->get();
 		textp->shift(offset);
 	}
+
+	// Agent positions all moved; texts are filed again as they are visited
+	sTextGrid.clear();
+	sUnbinnedTexts.clear();
+	for (text_it = sTextObjects.begin(); text_it != sTextObjects.end(); ++text_it)
+	{
+		LLHUDText *textp = text_it->get();
+		textp->mBinned = FALSE;
+		sUnbinnedTexts.push_back(textp);
+	}
+	sGridReach = 0.f;
 }
 
 void LLHUDText::shift(const LLVector3& offset)
@@ -1202,6 +1542,7 @@ void LLHUDText::reshape()
 		{
 			segment_iter->clearFontWidthMap();
 		}		
+		textp->mLayoutDirty = TRUE;
 	}
 }
 
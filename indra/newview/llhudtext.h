@@ -43,6 +43,7 @@
 #include "llrect.h"
 #include "llframetimer.h"
 #include "llfontgl.h"
+#include "llhudtextgrid.h"
 #include <set>
 #include <vector>
 #include "lldarray.h"
@@ -105,19 +106,19 @@ public:
 	void setUsePixelSize(const BOOL use_pixel_size);
 	void setZCompare(const BOOL zcompare);
 	void setDoFade(const BOOL do_fade);
-	void setVisibleOffScreen(BOOL visible) { mVisibleOffScreen = visible; }
+	void setVisibleOffScreen(BOOL visible);
 	// <edit>
 	std::string getStringUTF8();
 	// </edit>
 	
 	// mMaxLines of -1 means unlimited lines.
-	void setMaxLines(S32 max_lines) { mMaxLines = max_lines; }
-	void setFadeDistance(F32 fade_distance, F32 fade_range) { mFadeDistance = fade_distance; mFadeRange = fade_range; }
+	void setMaxLines(S32 max_lines);
+	void setFadeDistance(F32 fade_distance, F32 fade_range);
 	void updateVisibility();
 	LLVector2 updateScreenPos(LLVector2 &offset_target);
 	void updateSize();
 	void setMass(F32 mass) { mMass = llmax(0.1f, mass); }
-	void setTextAlignment(ETextAlignment alignment) { mTextAlignment = alignment; }
+	void setTextAlignment(ETextAlignment alignment);
 	void setVertAlignment(EVertAlignment alignment) { mVertAlignment = alignment; }
 	/*virtual*/ void markDead();
 	friend class LLHUDObject;
@@ -127,13 +128,15 @@ public:
 	BOOL getVisible() { return mVisible; }
 	BOOL getHidden() const { return mHidden; }
 	void setHidden( BOOL hide ) { mHidden = hide; }
-	void setOnHUDAttachment(BOOL on_hud) { mOnHUDAttachment = on_hud; }
+	void setOnHUDAttachment(BOOL on_hud);
 	void shift(const LLVector3& offset);
 
 	BOOL lineSegmentIntersect(const LLVector3& start, const LLVector3& end, LLVector3& intersection, BOOL debug_render = FALSE);
 
 	static void shiftAll(const LLVector3& offset);
 	static void renderAllHUD();
+	// Draws the visible in-world texts without bubbles, one batch per font.
+	static void renderAllBatched();
 	static void addPickable(std::set<LLViewerObject*> &pick_list);
 	static void reshape();
 	static void setDisplayText(BOOL flag) { sDisplayText = flag ; }
@@ -150,8 +153,23 @@ protected:
 	static void updateAll();
 	void setLOD(S32 lod);
 	S32 getMaxLines();
+	void updateLayout();
+	void updateBinning();
+	void unbin();
+	F32 getAlphaFactor() const;
 
 private:
+	// One laid out line of text, offsets in pixels from the render position
+	struct LLHUDTextLine
+	{
+		S32				mSegment;
+		BOOL			mIsLabel;
+		const LLFontGL*	mFont;
+		U8				mStyle;
+		F32				mXOffset;
+		F32				mYOffset;
+	};
+
 	~LLHUDText();
 	BOOL			mOnHUD;
 	BOOL			mUseBubble;
@@ -186,15 +204,29 @@ private:
 	EVertAlignment	mVertAlignment;
 	S32				mLOD;
 	BOOL			mHidden;
+	BOOL			mLayoutDirty;		// segments, fonts, alignment or LOD changed since updateLayout()
+	std::vector<LLHUDTextLine> mLines;
+	S32				mTextIndex;			// position in sTextObjects
+	BOOL			mBinned;			// in sTextGrid rather than sUnbinnedTexts
+	U32				mVisitFrame;
 // [RLVa:KB] - Checked: 2009-07-09 (RLVa-1.0.0f) | Added: RLVa-1.0.0f
 	std::string     mObjText;
 // [/RLVa:KB]
 
 	static BOOL    sDisplayText ;
-	static std::set<LLPointer<LLHUDText> > sTextObjects;
+	// All texts, contiguous; markDead() swaps the last one into the hole.
+	static std::vector<LLPointer<LLHUDText> > sTextObjects;
+	// Texts that fade with distance from a static object are found
+	// through the grid; all others are visited every frame.
+	static LLHUDTextGrid<LLHUDText> sTextGrid;
+	static std::vector<LLHUDText*> sUnbinnedTexts;
+	static F32 sGridReach;
+	static U32 sRefreshIndex;
+	static U32 sVisitFrame;
+	static std::vector<LLHUDTextBatchLine> sBatchLines;
 	static std::vector<LLPointer<LLHUDText> > sVisibleTextObjects;
 	static std::vector<LLPointer<LLHUDText> > sVisibleHUDTextObjects;
-	typedef std::set<LLPointer<LLHUDText> >::iterator TextObjectIterator;
+	typedef std::vector<LLPointer<LLHUDText> >::iterator TextObjectIterator;
 	typedef std::vector<LLPointer<LLHUDText> >::iterator VisibleTextObjectIterator;
 };
 
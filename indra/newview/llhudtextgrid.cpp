@@ -0,0 +1,57 @@
+/** 
+ * @file llhudtextgrid.cpp
+ * @brief Bookkeeping for LLHUDText that does not need a renderer: the
+ * uniform grid used for distance culling, the contiguous text list and
+ * the order batched lines are drawn in.
+ *
+ * $LicenseInfo:firstyear=2010&license=viewergpl$
+ * 
+ * Copyright (c) 2010, Linden Research, Inc.
+ * 
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ * 
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ * 
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ * 
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#include "llviewerprecompiledheaders.h"
+
+#include "llhudtextgrid.h"
+
+namespace
+{
+	struct sort_batch_by_depth_and_font
+	{
+		bool operator()(const LLHUDTextBatchLine& lhs, const LLHUDTextBatchLine& rhs) const
+		{
+			if (lhs.mDepthBucket != rhs.mDepthBucket)
+			{
+				return lhs.mDepthBucket > rhs.mDepthBucket;
+			}
+			return lhs.mFont < rhs.mFont;
+		}
+	};
+}
+
+void sort_hud_text_batch(std::vector<LLHUDTextBatchLine>& lines)
+{
+	std::stable_sort(lines.begin(), lines.end(), sort_batch_by_depth_and_font());
+}
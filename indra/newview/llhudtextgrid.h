@@ -0,0 +1,207 @@
+/** 
+ * @file llhudtextgrid.h
+ * @brief Bookkeeping for LLHUDText that does not need a renderer: the
+ * uniform grid used for distance culling, the contiguous text list and
+ * the order batched lines are drawn in.
+ *
+ * $LicenseInfo:firstyear=2010&license=viewergpl$
+ * 
+ * Copyright (c) 2010, Linden Research, Inc.
+ * 
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ * 
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ * 
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ * 
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+
+#ifndef LL_LLHUDTEXTGRID_H
+#define LL_LLHUDTEXTGRID_H
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include "llstring.h"
+#include "v3math.h"
+#include "v4color.h"
+
+class LLFontGL;
+
+// Bins items by agent position into square columns of cell_size metres,
+// so that the ones near the camera can be found without visiting the
+// rest. Items are moved between cells as they are updated; an item whose
+// position is not refreshed stays in its old cell.
+template <class T>
+class LLHUDTextGrid
+{
+public:
+	typedef std::vector<T*> item_list_t;
+
+	LLHUDTextGrid(F32 cell_size)
+		: mCellSize(cell_size)
+	{
+	}
+
+	// Files item under pos, moving it if it was in another cell.
+	void update(T* item, const LLVector3& pos)
+	{
+		cell_t cell = cellFor(pos);
+		typename item_cell_map_t::iterator iter = mItemCells.find(item);
+		if (iter != mItemCells.end())
+		{
+			if (iter->second == cell)
+			{
+				return;
+			}
+			eraseFromCell(item, iter->second);
+			iter->second = cell;
+		}
+		else
+		{
+			mItemCells[item] = cell;
+		}
+		mCells[cell].push_back(item);
+	}
+
+	void remove(T* item)
+	{
+		typename item_cell_map_t::iterator iter = mItemCells.find(item);
+		if (iter != mItemCells.end())
+		{
+			eraseFromCell(item, iter->second);
+			mItemCells.erase(iter);
+		}
+	}
+
+	bool has(T* item) const
+	{
+		return mItemCells.find(item) != mItemCells.end();
+	}
+
+	void clear()
+	{
+		mCells.clear();
+		mItemCells.clear();
+	}
+
+	S32 size() const
+	{
+		return (S32)mItemCells.size();
+	}
+
+	// Appends the items in every cell within radius of center, in x and y.
+	// This can include items a little further away than radius.
+	void query(const LLVector3& center, F32 radius, item_list_t& items) const
+	{
+		cell_t low = cellFor(center - LLVector3(radius, radius, 0.f));
+		cell_t high = cellFor(center + LLVector3(radius, radius, 0.f));
+		for (S32 x = low.first; x <= high.first; x++)
+		{
+			for (S32 y = low.second; y <= high.second; y++)
+			{
+				typename cell_map_t::const_iterator iter = mCells.find(cell_t(x, y));
+				if (iter != mCells.end())
+				{
+					items.insert(items.end(), iter->second.begin(), iter->second.end());
+				}
+			}
+		}
+	}
+
+private:
+	typedef std::pair<S32, S32> cell_t;
+	typedef std::map<cell_t, item_list_t> cell_map_t;
+	typedef std::map<T*, cell_t> item_cell_map_t;
+
+	cell_t cellFor(const LLVector3& pos) const
+	{
+		return cell_t(llfloor(pos.mV[VX] / mCellSize), llfloor(pos.mV[VY] / mCellSize));
+	}
+
+	void eraseFromCell(T* item, const cell_t& cell)
+	{
+		typename cell_map_t::iterator iter = mCells.find(cell);
+		if (iter == mCells.end())
+		{
+			return;
+		}
+		item_list_t& items = iter->second;
+		typename item_list_t::iterator found = std::find(items.begin(), items.end(), item);
+		if (found != items.end())
+		{
+			*found = items.back();
+			items.pop_back();
+		}
+		if (items.empty())
+		{
+			mCells.erase(iter);
+		}
+	}
+
+	F32 mCellSize;
+	cell_map_t mCells;
+	item_cell_map_t mItemCells;
+};
+
+// Keeps items in a contiguous list where each knows its own position,
+// through the index member, so that one can be removed by moving the last
+// item into its slot rather than by searching. The order is not kept.
+template <class T, class P>
+void hud_text_list_add(std::vector<P>& list, T* item, S32 T::*index)
+{
+	item->*index = (S32)list.size();
+	list.push_back(P(item));
+}
+
+template <class T, class P>
+void hud_text_list_remove(std::vector<P>& list, T* item, S32 T::*index)
+{
+	S32 pos = item->*index;
+	if (pos < 0)
+	{
+		return;
+	}
+	list[pos] = list.back();
+	T* moved = list[pos];
+	moved->*index = pos;
+	list.pop_back();
+	item->*index = -1;
+}
+
+// One line of the batch LLHUDText::renderAllBatched() draws
+struct LLHUDTextBatchLine
+{
+	S32				mDepthBucket;
+	const LLFontGL*	mFont;
+	const LLWString* mText;
+	F32				mX;
+	F32				mY;
+	F32				mZ;
+	LLColor4		mColor;
+	U8				mStyle;
+};
+
+// Puts farther depth buckets first and groups lines by font within a
+// bucket, keeping their order within a font.
+void sort_hud_text_batch(std::vector<LLHUDTextBatchLine>& lines);
+
+#endif // LL_LLHUDTEXTGRID_H
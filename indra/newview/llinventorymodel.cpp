@@ -35,6 +35,7 @@
 #include "llinventorymodel.h"
 
 #include "llassetstorage.h"
+#include "llcachename.h"
 #include "llcrc.h"
 #include "lldir.h"
 #include "llsys.h"
@@ -363,6 +364,55 @@ S32 LLInventoryModel::getCategoryCount() const
 	return mCategoryMap.size();
 }
 
+BOOL LLInventoryModel::findObjectsWithSubString(const std::string& sub_string, U32 search_type, uuid_vec_t& matches)
+{
+	updateNameIndex(search_type);
+	return mNameIndex.find(sub_string, search_type, matches);
+}
+
+U32 LLInventoryModel::getNameIndexVersion(U32 search_type)
+{
+	updateNameIndex(search_type);
+	return mNameIndex.getVersion();
+}
+
+void LLInventoryModel::updateNameIndex(U32 search_type)
+{
+	for (std::set<LLUUID>::iterator iter = mNameIndexPending.begin(); iter != mNameIndexPending.end(); ++iter)
+	{
+		LLViewerInventoryItem* item = getItem(*iter);
+		if (item)
+		{
+			mNameIndex.update(*iter, item->getName(), item->getDescription(), item->getCreatorUUID());
+			continue;
+		}
+		LLViewerInventoryCategory* cat = getCategory(*iter);
+		if (cat)
+		{
+			mNameIndex.update(*iter, cat->getName(), LLStringUtil::null, LLUUID::null);
+		}
+		else
+		{
+			mNameIndex.remove(*iter);
+		}
+	}
+	mNameIndexPending.clear();
+
+	if (search_type & LLInventoryNameIndex::SEARCH_CREATOR)
+	{
+		uuid_vec_t creators;
+		mNameIndex.getUnnamedCreators(creators);
+		std::string creator_name;
+		for (uuid_vec_t::iterator iter = creators.begin(); iter != creators.end(); ++iter)
+		{
+			if (gCacheName->getFullName(*iter, creator_name))
+			{
+				mNameIndex.setCreatorName(*iter, creator_name);
+			}
+		}
+	}
+}
+
 // Return the direct descendents of the id provided. The array
 // provided points straight into the guts of this object, and
 // should only be used for read operations, since modifications
@@ -1256,6 +1306,7 @@ void LLInventoryModel::addChangedMask(U32 mask, const LLUUID& referent)
 	if (referent.notNull())
 	{
 		mChangedItemIDs.insert(referent);
+		mNameIndexPending.insert(referent);
 	}
 	
 	// Update all linked items.  Starting with just LABEL because I'm
@@ -1950,6 +2001,7 @@ void LLInventoryModel::addCategory(LLViewerInventoryCategory* category)
 	{
 		// Insert category uniquely into the map
 		mCategoryMap[category->getUUID()] = category; // LLPointer will deref and delete the old one
+		mNameIndexPending.insert(category->getUUID());
 		//mInventory[category->getUUID()] = category;
 	}
 }
@@ -1977,6 +2029,7 @@ void LLInventoryModel::addItem(LLViewerInventoryItem* item)
 		}
 
 		mItemMap[item->getUUID()] = item;
+		mNameIndexPending.insert(item->getUUID());
 	}
 }
 
@@ -1997,6 +2050,8 @@ void LLInventoryModel::empty()
 	mCategoryMap.clear(); // remove all references (should delete entries)
 	mItemMap.clear(); // remove all references (should delete entries)
 	mLastItem = NULL;
+	mNameIndex.clear();
+	mNameIndexPending.clear();
 	//mInventory.clear();
 }
 
@@ -40,6 +40,7 @@
 #include "llpermissionsflags.h"
 #include "llstring.h"
 #include "llhttpclient.h"
+#include "llinventorynameindex.h"
 
 #include <map>
 #include <set>
@@ -282,6 +283,26 @@ public:
 	S32 getItemCount() const;
 	S32 getCategoryCount() const;
 
+	//--------------------------------------------------------------------
+	// Search
+	//--------------------------------------------------------------------
+public:
+	// Puts the ids of the objects whose name, description or creator
+	// name, as picked by the LLInventoryNameIndex search type bits,
+	// contain sub_string (upper case) into matches, sorted. Returns
+	// FALSE when sub_string is too short to look up.
+	BOOL findObjectsWithSubString(const std::string& sub_string, U32 search_type, uuid_vec_t& matches);
+	// Changes whenever findObjectsWithSubString() could find something
+	// else; brings the index up to date first.
+	U32 getNameIndexVersion(U32 search_type);
+private:
+	void updateNameIndex(U32 search_type);
+
+	// Kept up to date lazily from the objects addChangedMask() was
+	// called for, so that nothing is paid until someone searches.
+	LLInventoryNameIndex mNameIndex;
+	std::set<LLUUID> mNameIndexPending;
+
 /**                    Accessors
  **                                                                            **
  *******************************************************************************/
@@ -0,0 +1,288 @@
+/**
+ * @file llinventorynameindex.cpp
+ * @brief Substring index over inventory names, descriptions and creators
+ *
+ * $LicenseInfo:firstyear=2001&license=viewergpl$
+ *
+ * Copyright (c) 2001-2009, Linden Research, Inc.
+ *
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ *
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ *
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ *
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#include "llviewerprecompiledheaders.h"
+
+#include "llinventorynameindex.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "llstring.h"
+
+// Retired entries are only compacted away past this many
+const S32 MIN_RETIRED_TO_COMPACT = 1024;
+
+LLInventoryNameIndex::LLInventoryNameIndex()
+:	mRetiredCount(0),
+	mVersion(0)
+{
+}
+
+//static
+U32 LLInventoryNameIndex::trigram(const std::string& text, U32 offset)
+{
+	return ((U32)(U8)text[offset] << 16) | ((U32)(U8)text[offset + 1] << 8) | (U32)(U8)text[offset + 2];
+}
+
+void LLInventoryNameIndex::update(const LLUUID& id, const std::string& name, const std::string& desc, const LLUUID& creator_id)
+{
+	std::string upper_name(name);
+	LLStringUtil::toUpper(upper_name);
+	std::string upper_desc(desc);
+	LLStringUtil::toUpper(upper_desc);
+
+	S32* indexp = mEntryIDs.find(id);
+	if (indexp)
+	{
+		Entry& old_entry = mEntries[*indexp];
+		if (old_entry.mName == upper_name && old_entry.mDesc == upper_desc && old_entry.mCreatorID == creator_id)
+		{
+			// Most change notifications are for moves and flags
+			return;
+		}
+		old_entry.mLive = FALSE;
+		mRetiredCount++;
+	}
+
+	Entry entry;
+	entry.mID = id;
+	entry.mName = upper_name;
+	entry.mDesc = upper_desc;
+	entry.mCreatorID = creator_id;
+	entry.mLive = TRUE;
+	mEntries.push_back(entry);
+	S32 index = (S32)mEntries.size() - 1;
+	mEntryIDs.set(id, index);
+	addPostings(index);
+
+	if (creator_id.notNull() && mCreatorNames.find(creator_id) == mCreatorNames.end())
+	{
+		mCreatorNames[creator_id] = std::string();
+	}
+	mVersion++;
+
+	if (mRetiredCount > MIN_RETIRED_TO_COMPACT && mRetiredCount > mEntryIDs.size())
+	{
+		compact();
+	}
+}
+
+void LLInventoryNameIndex::remove(const LLUUID& id)
+{
+	S32* indexp = mEntryIDs.find(id);
+	if (!indexp)
+	{
+		return;
+	}
+	mEntries[*indexp].mLive = FALSE;
+	mEntryIDs.erase(id);
+	mRetiredCount++;
+	mVersion++;
+
+	if (mRetiredCount > MIN_RETIRED_TO_COMPACT && mRetiredCount > mEntryIDs.size())
+	{
+		compact();
+	}
+}
+
+void LLInventoryNameIndex::clear()
+{
+	mEntries.clear();
+	mEntryIDs.clear();
+	mPostings.clear();
+	mCreatorNames.clear();
+	mRetiredCount = 0;
+	mVersion++;
+}
+
+void LLInventoryNameIndex::getUnnamedCreators(uuid_vec_t& creators) const
+{
+	for (std::map<LLUUID, std::string>::const_iterator iter = mCreatorNames.begin(); iter != mCreatorNames.end(); ++iter)
+	{
+		if (iter->second.empty())
+		{
+			creators.push_back(iter->first);
+		}
+	}
+}
+
+void LLInventoryNameIndex::setCreatorName(const LLUUID& creator_id, const std::string& name)
+{
+	std::string upper_name(name);
+	LLStringUtil::toUpper(upper_name);
+	std::string& creator_name = mCreatorNames[creator_id];
+	if (creator_name != upper_name)
+	{
+		creator_name = upper_name;
+		mVersion++;
+	}
+}
+
+BOOL LLInventoryNameIndex::find(const std::string& sub_string, U32 search_type, uuid_vec_t& matches) const
+{
+	if (sub_string.size() < MIN_SUBSTRING_LENGTH)
+	{
+		return FALSE;
+	}
+	if (!search_type)
+	{
+		search_type = SEARCH_NAME;
+	}
+
+	uuid_vec_t found;
+	if (search_type & (SEARCH_NAME | SEARCH_DESC))
+	{
+		// Look up every distinct run of the string, shortest list first
+		std::vector<const posting_list_t*> lists;
+		for (U32 i = 0; i + 2 < sub_string.size(); i++)
+		{
+			posting_map_t::const_iterator iter = mPostings.find(trigram(sub_string, i));
+			if (iter == mPostings.end())
+			{
+				lists.clear();
+				break;
+			}
+			if (std::find(lists.begin(), lists.end(), &iter->second) == lists.end())
+			{
+				lists.push_back(&iter->second);
+			}
+		}
+
+		if (!lists.empty())
+		{
+			std::vector<std::pair<size_t, const posting_list_t*> > by_size;
+			for (std::vector<const posting_list_t*>::iterator iter = lists.begin(); iter != lists.end(); ++iter)
+			{
+				by_size.push_back(std::make_pair((*iter)->size(), *iter));
+			}
+			std::sort(by_size.begin(), by_size.end());
+
+			posting_list_t candidates(*by_size[0].second);
+			posting_list_t narrowed;
+			for (U32 i = 1; i < by_size.size() && !candidates.empty(); i++)
+			{
+				narrowed.clear();
+				std::set_intersection(candidates.begin(), candidates.end(),
+									  by_size[i].second->begin(), by_size[i].second->end(),
+									  std::back_inserter(narrowed));
+				candidates.swap(narrowed);
+			}
+
+			for (posting_list_t::iterator iter = candidates.begin(); iter != candidates.end(); ++iter)
+			{
+				const Entry& entry = mEntries[*iter];
+				if (!entry.mLive)
+				{
+					continue;
+				}
+				if (((search_type & SEARCH_NAME) && entry.mName.find(sub_string) != std::string::npos)
+					|| ((search_type & SEARCH_DESC) && entry.mDesc.find(sub_string) != std::string::npos))
+				{
+					found.push_back(entry.mID);
+				}
+			}
+		}
+	}
+
+	if (search_type & SEARCH_CREATOR)
+	{
+		std::vector<LLUUID> creators;
+		for (std::map<LLUUID, std::string>::const_iterator iter = mCreatorNames.begin(); iter != mCreatorNames.end(); ++iter)
+		{
+			if (iter->second.find(sub_string) != std::string::npos)
+			{
+				creators.push_back(iter->first);
+			}
+		}
+		if (!creators.empty())
+		{
+			// Already sorted, as mCreatorNames is
+			for (std::vector<Entry>::const_iterator iter = mEntries.begin(); iter != mEntries.end(); ++iter)
+			{
+				if (iter->mLive && std::binary_search(creators.begin(), creators.end(), iter->mCreatorID))
+				{
+					found.push_back(iter->mID);
+				}
+			}
+		}
+	}
+
+	std::sort(found.begin(), found.end());
+	found.erase(std::unique(found.begin(), found.end()), found.end());
+	matches.swap(found);
+	return TRUE;
+}
+
+void LLInventoryNameIndex::addPostings(S32 index)
+{
+	const Entry& entry = mEntries[index];
+	std::vector<U32> trigrams;
+	for (U32 i = 0; i + 2 < entry.mName.size(); i++)
+	{
+		trigrams.push_back(trigram(entry.mName, i));
+	}
+	for (U32 i = 0; i + 2 < entry.mDesc.size(); i++)
+	{
+		trigrams.push_back(trigram(entry.mDesc, i));
+	}
+	std::sort(trigrams.begin(), trigrams.end());
+	trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+
+	// Entries are only ever appended, so the lists stay sorted
+	for (std::vector<U32>::iterator iter = trigrams.begin(); iter != trigrams.end(); ++iter)
+	{
+		mPostings[*iter].push_back(index);
+	}
+}
+
+void LLInventoryNameIndex::compact()
+{
+	std::vector<Entry> entries;
+	entries.reserve(mEntryIDs.size());
+	for (std::vector<Entry>::iterator iter = mEntries.begin(); iter != mEntries.end(); ++iter)
+	{
+		if (iter->mLive)
+		{
+			entries.push_back(*iter);
+		}
+	}
+	mEntries.swap(entries);
+	mPostings.clear();
+	mEntryIDs.clear();
+	for (S32 i = 0; i < (S32)mEntries.size(); i++)
+	{
+		mEntryIDs.set(mEntries[i].mID, i);
+		addPostings(i);
+	}
+	mRetiredCount = 0;
+}
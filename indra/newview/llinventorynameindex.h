@@ -0,0 +1,119 @@
+/**
+ * @file llinventorynameindex.h
+ * @brief Substring index over inventory names, descriptions and creators
+ *
+ * $LicenseInfo:firstyear=2001&license=viewergpl$
+ *
+ * Copyright (c) 2001-2009, Linden Research, Inc.
+ *
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ *
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ *
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ *
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLINVENTORYNAMEINDEX_H
+#define LL_LLINVENTORYNAMEINDEX_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include <boost/unordered_map.hpp>
+
+#include "lluuid.h"
+#include "llviewerobjectindex.h"
+
+//
+// Trigram index over the searchable text of inventory objects.
+//
+// Every three byte run of an object's upper cased name and description
+// maps to the sorted list of entries containing it, so the objects that
+// can contain a search string are the intersection of the lists for its
+// own runs; those few are then checked with a plain find().  Creator
+// names arrive from the name cache after the objects do, so they are
+// kept per creator and matched when searching.
+//
+// An update appends a fresh entry and retires the old one instead of
+// editing the lists in place, which keeps them sorted; retired entries
+// are dropped by compacting once they outnumber the live ones.
+//
+class LLInventoryNameIndex
+{
+public:
+	// Same bits as LLFolderView::getSearchType(), 0 searching names
+	enum
+	{
+		SEARCH_NAME = 1,
+		SEARCH_DESC = 2,
+		SEARCH_CREATOR = 4
+	};
+
+	// Shorter strings match most of the inventory and are not indexed
+	static const U32 MIN_SUBSTRING_LENGTH = 3;
+
+	LLInventoryNameIndex();
+
+	// Adds the object, or re-indexes it if its text changed.
+	void update(const LLUUID& id, const std::string& name, const std::string& desc, const LLUUID& creator_id);
+	void remove(const LLUUID& id);
+	void clear();
+
+	S32 size() const			{ return mEntryIDs.size(); }
+
+	// Bumped whenever a find() could return something different.
+	U32 getVersion() const		{ return mVersion; }
+
+	// Creators of indexed objects whose names are not known yet.
+	void getUnnamedCreators(uuid_vec_t& creators) const;
+	void setCreatorName(const LLUUID& creator_id, const std::string& name);
+
+	// Puts the ids of the objects whose fields picked by search_type
+	// contain sub_string (already upper case) into matches, sorted.
+	// Returns FALSE, leaving matches alone, when sub_string is too short
+	// to look up and every object has to be checked instead.
+	BOOL find(const std::string& sub_string, U32 search_type, uuid_vec_t& matches) const;
+
+private:
+	struct Entry
+	{
+		LLUUID mID;
+		std::string mName;
+		std::string mDesc;
+		LLUUID mCreatorID;
+		BOOL mLive;
+	};
+
+	typedef std::vector<S32> posting_list_t;
+	typedef boost::unordered_map<U32, posting_list_t> posting_map_t;
+
+	static U32 trigram(const std::string& text, U32 offset);
+	void addPostings(S32 index);
+	void compact();
+
+	std::vector<Entry> mEntries;
+	LLUUIDIndex<S32> mEntryIDs;		// id to its live entry
+	posting_map_t mPostings;
+	std::map<LLUUID, std::string> mCreatorNames;
+	S32 mRetiredCount;
+	U32 mVersion;
+};
+
+#endif // LL_LLINVENTORYNAMEINDEX_H
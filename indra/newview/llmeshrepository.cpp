@@ -471,7 +471,7 @@ LLMeshRepoThread::~LLMeshRepoThread()
 
 void LLMeshRepoThread::run()
 {
-	mCurlRequest = new LLCurlRequest();
+	mCurlRequest = new LLCurlRequest(LLCurl::PRIORITY_MESH);
 #if MESH_IMPORT
 	LLCDResult res = LLConvexDecomposition::initThread();
 	if (res != LLCD_OK)
@@ -1538,7 +1538,7 @@ void LLMeshUploadThread::generateHulls()
 
 void LLMeshUploadThread::doWholeModelUpload()
 {
-	mCurlRequest = new LLCurlRequest();
+	mCurlRequest = new LLCurlRequest(LLCurl::PRIORITY_MESH);
 
 	if (mWholeModelUploadURL.empty())
 	{
@@ -1574,7 +1574,7 @@ void LLMeshUploadThread::requestWholeModelFee()
 {
 	dump_num++;
 
-	mCurlRequest = new LLCurlRequest();
+	mCurlRequest = new LLCurlRequest(LLCurl::PRIORITY_MESH);
 
 	generateHulls();
 
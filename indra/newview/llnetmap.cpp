@@ -54,6 +54,7 @@
 #include "llframetimer.h"
 #include "lltracker.h"
 #include "llmenugl.h"
+#include "llnetmaptiles.h"
 #include "llsurface.h"
 #include "lltextbox.h"
 #include "lluictrlfactory.h"
@@ -95,8 +96,6 @@ const S32 MOUSE_DRAG_SLOP = 2;				// How far the mouse needs to move before we t
 LLNetMap::LLNetMap(const std::string& name) :
 	LLPanel(name),
 	mScale(128.f),
-	mObjectMapTPM(1.f),
-	mObjectMapPixels(255.f),
 	mTargetPanX( 0.f ),
 	mTargetPanY( 0.f ),
 	mCurPanX( 0.f ),
@@ -107,8 +106,6 @@ LLNetMap::LLNetMap(const std::string& name) :
 	mPixelsPerMeter = mScale / LLWorld::getInstance()->getRegionWidthInMeters();
 	mDotRadius = llmax(DOT_SCALE * mPixelsPerMeter, MIN_DOT_RADIUS);
 
-	mObjectImageCenterGlobal = gAgentCamera.getCameraPositionGlobal();
-	
 	// Register event listeners for popup menu
 	(new LLScaleMap())->registerListener(this, "MiniMap.ZoomLevel");
 	(new LLCenterMap())->registerListener(this, "MiniMap.Center");
@@ -154,18 +151,6 @@ void LLNetMap::setScale( F32 scale )
 	}
 	gSavedSettings.setF32("MiniMapScale", mScale);
 
-	if (mObjectImagep.notNull())
-	{
-		F32 width = (F32)(getRect().getWidth());
-		F32 height = (F32)(getRect().getHeight());
-		F32 diameter = sqrt(width * width + height * height);
-		F32 region_widths = diameter / mScale;
-		F32 meters = region_widths * LLWorld::getInstance()->getRegionWidthInMeters();
-		F32 num_pixels = (F32)mObjectImagep->getWidth();
-		mObjectMapTPM = num_pixels / meters;
-		mObjectMapPixels = diameter;
-	}
-
 	mPixelsPerMeter = mScale / LLWorld::getInstance()->getRegionWidthInMeters();
 	mDotRadius = llmax(DOT_SCALE * mPixelsPerMeter, MIN_DOT_RADIUS);
 
@@ -194,11 +179,6 @@ void LLNetMap::draw()
 {
  	static LLFrameTimer map_timer;
 
-	if (mObjectImagep.isNull())
-	{
-		createObjectImage();
-	}
-
 	if (gSavedSettings.getS32( "MiniMapCenter") != MAP_CENTER_NONE)
 	{
 		mCurPanX = lerp(mCurPanX, mTargetPanX, LLCriticalDamp::getInterpolant(0.1f));
@@ -241,6 +221,24 @@ void LLNetMap::draw()
 			glRotatef( rotation * RAD_TO_DEG, 0.f, 0.f, 1.f);
 		}
 
+		// Only the tiles of regions whose objects changed are redrawn, on
+		// LLNetMapTiles' thread; pick up finished ones every frame.
+		bool rasterize = mUpdateNow || (map_timer.getElapsedTimeF32() > 0.5f);
+		if (rasterize)
+		{
+			mUpdateNow = FALSE;
+			map_timer.reset();
+		}
+		// About as many texels as a region has pixels on screen
+		const S32 MIN_TILE_SIZE = 64;
+		const S32 MAX_TILE_SIZE = 256;
+		S32 tile_size = MIN_TILE_SIZE;
+		while ((tile_size < mScale) && (tile_size < MAX_TILE_SIZE))
+		{
+			tile_size <<= 1;
+		}
+		LLNetMapTiles::updateClass(tile_size, rasterize);
+
 		// figure out where agent is
 		LLColor4 this_region_color = gColors.getColor( "NetMapThisRegion" );
 		LLColor4 live_region_color = gColors.getColor( "NetMapLiveRegion" );
@@ -302,50 +300,25 @@ void LLNetMap::draw()
 				}
 			}
 			gGL.setAlphaRejectSettings(LLRender::CF_DEFAULT);
-		}
 
-		// Redraw object layer periodically
-		if (mUpdateNow || (map_timer.getElapsedTimeF32() > 0.5f))
-		{
-			mUpdateNow = FALSE;
-
-			// Locate the centre of the object layer, accounting for panning
-			LLVector3 new_center = globalPosToView(gAgentCamera.getCameraPositionGlobal(), rotate_map);	
-			new_center.mV[0] -= mCurPanX;
-			new_center.mV[1] -= mCurPanY;
-			new_center.mV[2] = 0.f;
-			mObjectImageCenterGlobal = viewPosToGlobal(llround(new_center.mV[0]), llround(new_center.mV[1]), rotate_map);
-
-			// Create the base texture.
-			U8 *default_texture = mObjectRawImagep->getData();
-			memset( default_texture, 0, mObjectImagep->getWidth() * mObjectImagep->getHeight() * mObjectImagep->getComponents() );
-
-			// Draw buildings
-			gObjectList.renderObjectsForMap(*this);
-
-			mObjectImagep->setSubImage(mObjectRawImagep, 0, 0, mObjectImagep->getWidth(), mObjectImagep->getHeight());
-			
-			map_timer.reset();
+			// Draw objects
+			LLViewerTexture* object_tile = LLNetMapTiles::getTile(regionp);
+			if (object_tile)
+			{
+				gGL.getTexUnit(0)->bind(object_tile);
+				gGL.begin(LLRender::QUADS);
+					gGL.texCoord2f(0.f, 1.f);
+					gGL.vertex2f(left, top);
+					gGL.texCoord2f(0.f, 0.f);
+					gGL.vertex2f(left, bottom);
+					gGL.texCoord2f(1.f, 0.f);
+					gGL.vertex2f(right, bottom);
+					gGL.texCoord2f(1.f, 1.f);
+					gGL.vertex2f(right, top);
+				gGL.end();
+			}
 		}
 
-		LLVector3 map_center_agent = gAgent.getPosAgentFromGlobal(mObjectImageCenterGlobal);
-		map_center_agent -= gAgentCamera.getCameraPositionAgent();
-
-		gGL.getTexUnit(0)->bind(mObjectImagep);
-		F32 image_half_width = 0.5f*mObjectMapPixels;
-		F32 image_half_height = 0.5f*mObjectMapPixels;
-
-		gGL.begin(LLRender::QUADS);
-			gGL.texCoord2f(0.f, 1.f);
-			gGL.vertex2f(map_center_agent.mV[VX] - image_half_width, image_half_height + map_center_agent.mV[VY]);
-			gGL.texCoord2f(0.f, 0.f);
-			gGL.vertex2f(map_center_agent.mV[VX] - image_half_width, map_center_agent.mV[VY] - image_half_height);
-			gGL.texCoord2f(1.f, 0.f);
-			gGL.vertex2f(image_half_width + map_center_agent.mV[VX], map_center_agent.mV[VY] - image_half_height);
-			gGL.texCoord2f(1.f, 1.f);
-			gGL.vertex2f(image_half_width + map_center_agent.mV[VX], image_half_height + map_center_agent.mV[VY]);
-		gGL.end();
-
 		gGL.popMatrix();
 
 		LLVector3d pos_global;
@@ -532,7 +505,7 @@ void LLNetMap::draw()
 void LLNetMap::reshape(S32 width, S32 height, BOOL called_from_parent)
 {
 	LLPanel::reshape(width, height, called_from_parent);
-	createObjectImage();
+	mUpdateNow = TRUE;
 	updateMinorDirections();
 }
 
@@ -752,135 +725,6 @@ void LLNetMap::updateMinorDirections()
 	getChild<LLTextBox>("se_label")->setVisible(show_minors);
 }
 
-void LLNetMap::renderScaledPointGlobal( const LLVector3d& pos, const LLColor4U &color, F32 radius_meters )
-{
-	LLVector3 local_pos;
-	local_pos.setVec( pos - mObjectImageCenterGlobal );
-
-	// DEV-17370 - megaprims of size > 4096 cause lag.  (go figger.)
-	const F32 MAX_RADIUS = 256.0f;
-	F32 radius_clamped = llmin(radius_meters, MAX_RADIUS);
-	
-	S32 diameter_pixels = llround(2 * radius_clamped * mObjectMapTPM);
-	renderPoint( local_pos, color, diameter_pixels );
-}
-
-
-void LLNetMap::renderPoint(const LLVector3 &pos_local, const LLColor4U &color, 
-						   S32 diameter, S32 relative_height)
-{
-	if (diameter <= 0)
-	{
-		return;
-	}
-
-	const S32 image_width = (S32)mObjectImagep->getWidth();
-	const S32 image_height = (S32)mObjectImagep->getHeight();
-
-	S32 x_offset = llround(pos_local.mV[VX] * mObjectMapTPM + image_width / 2);
-	S32 y_offset = llround(pos_local.mV[VY] * mObjectMapTPM + image_height / 2);
-
-	if ((x_offset < 0) || (x_offset >= image_width))
-	{
-		return;
-	}
-	if ((y_offset < 0) || (y_offset >= image_height))
-	{
-		return;
-	}
-
-	U8 *datap = mObjectRawImagep->getData();
-
-	S32 neg_radius = diameter / 2;
-	S32 pos_radius = diameter - neg_radius;
-	S32 x, y;
-
-	if (relative_height > 0)
-	{
-		// ...point above agent
-		S32 px, py;
-
-		// vertical line
-		px = x_offset;
-		for (y = -neg_radius; y < pos_radius; y++)
-		{
-			py = y_offset + y;
-			if ((py < 0) || (py >= image_height))
-			{
-				continue;
-			}
-			S32 offset = px + py * image_width;
-			((U32*)datap)[offset] = color.mAll;
-		}
-
-		// top line
-		py = y_offset + pos_radius - 1;
-		for (x = -neg_radius; x < pos_radius; x++)
-		{
-			px = x_offset + x;
-			if ((px < 0) || (px >= image_width))
-			{
-				continue;
-			}
-			S32 offset = px + py * image_width;
-			((U32*)datap)[offset] = color.mAll;
-		}
-	}
-	else
-	{
-		// ...point level with agent
-		for (x = -neg_radius; x < pos_radius; x++)
-		{
-			S32 p_x = x_offset + x;
-			if ((p_x < 0) || (p_x >= image_width))
-			{
-				continue;
-			}
-
-			for (y = -neg_radius; y < pos_radius; y++)
-			{
-				S32 p_y = y_offset + y;
-				if ((p_y < 0) || (p_y >= image_height))
-				{
-					continue;
-				}
-				S32 offset = p_x + p_y * image_width;
-				((U32*)datap)[offset] = color.mAll;
-			}
-		}
-	}
-}
-
-void LLNetMap::createObjectImage()
-{
-	// Find the size of the side of a square that surrounds the circle that surrounds getRect().
-	// ... which is, the diagonal of the rect.
-	F32 width = getRect().getWidth();
-	F32 height = getRect().getHeight();
-	S32 square_size = llround( sqrt(width*width + height*height) );
-
-	// Find the least power of two >= the minimum size.
-	const S32 MIN_SIZE = 64;
-	const S32 MAX_SIZE = 256;
-	S32 img_size = MIN_SIZE;
-	while( (img_size*2 < square_size ) && (img_size < MAX_SIZE) )
-	{
-		img_size <<= 1;
-	}
-
-	if( mObjectImagep.isNull() ||
-		(mObjectImagep->getWidth() != img_size) ||
-		(mObjectImagep->getHeight() != img_size) )
-	{
-		mObjectRawImagep = new LLImageRaw(img_size, img_size, 4);
-		U8* data = mObjectRawImagep->getData();
-		memset( data, 0, img_size * img_size * 4 );
-		mObjectImagep = LLViewerTextureManager::getLocalTexture( mObjectRawImagep.get(), FALSE);
-	}
-	setScale(mScale);
-	mUpdateNow = TRUE;
-}
-
 BOOL LLNetMap::handleMouseDown( S32 x, S32 y, MASK mask )
 {
 	if (!(mask & MASK_SHIFT)) return FALSE;
@@ -65,8 +65,6 @@ public:
 	virtual BOOL	handleScrollWheel(S32 x, S32 y, S32 clicks);
 	virtual BOOL	handleToolTip( S32 x, S32 y, std::string& msg, LLRect* sticky_rect_screen );
 
-	void			renderScaledPointGlobal( const LLVector3d& pos, const LLColor4U &color, F32 radius );
-
 	static void mm_setcolor(LLUUID key,LLColor4 col); //moymod
 
 private:
@@ -77,8 +75,6 @@ private:
 	void			translatePan( F32 delta_x, F32 delta_y );
 	void			setPan( F32 x, F32 y )			{ mTargetPanX = x; mTargetPanY = y; }
 
-	void renderPoint(const LLVector3 &pos, const LLColor4U &color, 
-					 S32 diameter, S32 relative_height = 0);
 	LLVector3		globalPosToView(const LLVector3d& global_pos, BOOL rotated);
 	LLVector3d		viewPosToGlobal(S32 x,S32 y, BOOL rotated);
 
@@ -89,14 +85,11 @@ private:
 
 	void			setDirectionPos( LLTextBox* text_box, F32 rotation );
 	void			updateMinorDirections();
-	void			createObjectImage();
 
 	LLHandle<LLView>	mPopupMenuHandle;
 
 	F32				mScale;					// Size of a region in pixels
 	F32				mPixelsPerMeter;		// world meters to map pixels
-	F32				mObjectMapTPM;			// texels per meter on map
-	F32				mObjectMapPixels;		// Width of object map in pixels
 	F32				mDotRadius;				// Size of avatar markers
 	F32				mTargetPanX;
 	F32				mTargetPanY;
@@ -109,10 +102,7 @@ private:
 	S32				mMouseDownX;
 	S32				mMouseDownY;
 
-	BOOL			mUpdateNow;
-	LLVector3d		mObjectImageCenterGlobal;
-	LLPointer<LLImageRaw> mObjectRawImagep;
-	LLPointer<LLViewerTexture>	mObjectImagep;
+	BOOL			mUpdateNow;			// rasterize the object tiles this frame
 
 private:
 	LLUUID			mClosestAgentToCursor;
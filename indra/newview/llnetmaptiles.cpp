@@ -0,0 +1,516 @@
+/**
+ * @file llnetmaptiles.cpp
+ * @brief The minimap object layer, rasterized per region in the background
+ *
+ * $LicenseInfo:firstyear=2002&license=viewergpl$
+ *
+ * Copyright (c) 2002-2009, Linden Research, Inc.
+ *
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ *
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ *
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ *
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#include "llviewerprecompiledheaders.h"
+
+#include "llnetmaptiles.h"
+
+#include "llagent.h"
+#include "llcolorscheme.h"
+#include "llimage.h"
+#include "llviewercontrol.h"
+#include "llviewerobject.h"
+#include "llviewerregion.h"
+#include "llviewertexture.h"
+#include "llworld.h"
+
+// Every object is looked at again this often, for what moving doesn't
+// cover: ownership, water level, crossing into another region.
+const F32 RESYNC_INTERVAL = 10.f;
+// Objects high above the agent are left off the map; the cut-off moves in
+// steps of this many meters, as every tile has to be redone when it does.
+const F32 ALTITUDE_STEP = 16.f;
+const F32 MAX_ALTITUDE_ABOVE_SELF = 256.f;
+// DEV-17370 - megaprims of size > 4096 cause lag.  (go figger.)
+const F32 MAX_RADIUS = 256.f;
+
+//============================================================================
+
+/*static*/ LLNetMapTiles* LLNetMapTiles::sInstance = NULL;
+/*static*/ LLNetMapTiles::tile_map_t LLNetMapTiles::sTiles;
+/*static*/ LLNetMapTiles::object_region_map_t LLNetMapTiles::sObjectRegions;
+/*static*/ LLNetMapTiles::object_set_t LLNetMapTiles::sMapObjects;
+/*static*/ LLNetMapTiles::object_set_t LLNetMapTiles::sChangedObjects;
+/*static*/ LLFrameTimer LLNetMapTiles::sResyncTimer;
+/*static*/ S32 LLNetMapTiles::sTileSize = 0;
+/*static*/ F32 LLNetMapTiles::sMaxAltitude = 0.f;
+
+// Map colors, read once per update
+static LLColor4U sAboveWaterColor;
+static LLColor4U sBelowWaterColor;
+static LLColor4U sYouOwnAboveWaterColor;
+static LLColor4U sYouOwnBelowWaterColor;
+static LLColor4U sGroupOwnAboveWaterColor;
+static LLColor4U sGroupOwnBelowWaterColor;
+static F32 sMaxPrimRadius = MAX_RADIUS;
+
+//============================================================================
+// Run on MAIN thread
+//static
+void LLNetMapTiles::initClass(bool threaded)
+{
+	llassert(!sInstance);
+	if (threaded)
+	{
+		// Without a thread, tiles are rasterized in updateClass() instead.
+		sInstance = new LLNetMapTiles(threaded);
+	}
+}
+
+//static
+void LLNetMapTiles::cleanupClass()
+{
+	if (sInstance)
+	{
+		sInstance->setQuitting();
+		while (sInstance->update(0))
+		{
+		}
+		delete sInstance;
+		sInstance = NULL;
+	}
+	// Before the texture list goes away.  The objects are still being
+	// kept track of, as long as they are on the map.
+	for (tile_map_t::iterator iter = sTiles.begin(); iter != sTiles.end(); ++iter)
+	{
+		iter->second.mTexture = NULL;
+		iter->second.mPending = false;
+	}
+}
+
+//static
+void LLNetMapTiles::updateClass(S32 tile_size, bool redraw)
+{
+	if (sInstance)
+	{
+		sInstance->update(1);
+
+		completed_list_t completed;
+		{
+			LLMutexLock lock(&sInstance->mCompletedMutex);
+			completed.swap(sInstance->mCompletedList);
+		}
+		for (completed_list_t::iterator iter = completed.begin(); iter != completed.end(); ++iter)
+		{
+			tileDone(iter->region_handle, iter->image);
+		}
+	}
+
+	if (!redraw)
+	{
+		return;
+	}
+
+	if (tile_size != sTileSize)
+	{
+		sTileSize = tile_size;
+		dirtyAll();
+	}
+
+	F32 max_altitude = ALTITUDE_STEP * llfloor((F32)gAgent.getPositionGlobal().mdV[VZ] / ALTITUDE_STEP) +
+					   MAX_ALTITUDE_ABOVE_SELF;
+	if (max_altitude != sMaxAltitude)
+	{
+		sMaxAltitude = max_altitude;
+		dirtyAll();
+	}
+
+	if (sResyncTimer.getElapsedTimeF32() > RESYNC_INTERVAL)
+	{
+		sResyncTimer.reset();
+		sChangedObjects = sMapObjects;
+	}
+
+	if (!sChangedObjects.empty())
+	{
+		sAboveWaterColor = gColors.getColor("NetMapOtherOwnAboveWater");
+		sBelowWaterColor = gColors.getColor("NetMapOtherOwnBelowWater");
+		sYouOwnAboveWaterColor = gColors.getColor("NetMapYouOwnAboveWater");
+		sYouOwnBelowWaterColor = gColors.getColor("NetMapYouOwnBelowWater");
+		sGroupOwnAboveWaterColor = gColors.getColor("NetMapGroupOwnAboveWater");
+		sGroupOwnBelowWaterColor = gColors.getColor("NetMapGroupOwnBelowWater");
+		sMaxPrimRadius = llmin(gSavedSettings.getF32("MiniMapPrimMaxRadius"), MAX_RADIUS);
+
+		for (object_set_t::iterator iter = sChangedObjects.begin(); iter != sChangedObjects.end(); ++iter)
+		{
+			LLViewerObject* objectp = *iter;
+			updatePoint(objectp);
+			// Children don't hear about their root moving.
+			LLViewerObject::const_child_list_t& children = objectp->getChildren();
+			for (LLViewerObject::child_list_t::const_iterator child_iter = children.begin();
+				 child_iter != children.end(); ++child_iter)
+			{
+				LLViewerObject* childp = *child_iter;
+				if (sMapObjects.count(childp))
+				{
+					updatePoint(childp);
+				}
+			}
+		}
+		sChangedObjects.clear();
+	}
+
+	// Drop the tiles of regions we're no longer connected to.
+	std::set<U64> region_handles;
+	for (LLWorld::region_list_t::const_iterator iter = LLWorld::getInstance()->getRegionList().begin();
+		 iter != LLWorld::getInstance()->getRegionList().end(); ++iter)
+	{
+		region_handles.insert((*iter)->getHandle());
+	}
+	for (tile_map_t::iterator iter = sTiles.begin(); iter != sTiles.end(); )
+	{
+		if (region_handles.count(iter->first))
+		{
+			++iter;
+			continue;
+		}
+		for (Tile::point_map_t::iterator point_iter = iter->second.mPoints.begin();
+			 point_iter != iter->second.mPoints.end(); ++point_iter)
+		{
+			sObjectRegions.erase(point_iter->first);
+		}
+		sTiles.erase(iter++);
+	}
+
+	for (tile_map_t::iterator iter = sTiles.begin(); iter != sTiles.end(); ++iter)
+	{
+		Tile& tile = iter->second;
+		if (!tile.mDirty || tile.mPending)
+		{
+			continue;
+		}
+		tile.mDirty = false;
+
+		point_list_t points;
+		points.reserve(tile.mPoints.size());
+		for (Tile::point_map_t::iterator point_iter = tile.mPoints.begin();
+			 point_iter != tile.mPoints.end(); ++point_iter)
+		{
+			const Point& point = point_iter->second;
+			if (point.mOwned || point.mZ <= sMaxAltitude)
+			{
+				points.push_back(point);
+			}
+		}
+
+		if (sInstance)
+		{
+			tile.mPending = true;
+			sInstance->addRequest(new RasterRequest(sInstance, sInstance->generateHandle(), iter->first,
+													points, sTileSize, tile.mRegionWidth));
+		}
+		else
+		{
+			LLPointer<LLImageRaw> image = new LLImageRaw(sTileSize, sTileSize, 4);
+			rasterize(points, image, tile.mRegionWidth);
+			tileDone(iter->first, image);
+		}
+	}
+}
+
+//static
+LLViewerTexture* LLNetMapTiles::getTile(LLViewerRegion* regionp)
+{
+	tile_map_t::iterator iter = sTiles.find(regionp->getHandle());
+	return iter != sTiles.end() ? iter->second.mTexture.get() : NULL;
+}
+
+//static
+void LLNetMapTiles::objectAdded(LLViewerObject* objectp)
+{
+	sMapObjects.insert(objectp);
+	sChangedObjects.insert(objectp);
+}
+
+//static
+void LLNetMapTiles::objectChanged(LLViewerObject* objectp)
+{
+	sChangedObjects.insert(objectp);
+}
+
+//static
+void LLNetMapTiles::objectRemoved(LLViewerObject* objectp)
+{
+	sMapObjects.erase(objectp);
+	sChangedObjects.erase(objectp);
+	removePoint(objectp);
+}
+
+//static
+bool LLNetMapTiles::makePoint(LLViewerObject* objectp, U64& region_handle, F32& region_width, Point& point)
+{
+	LLViewerRegion* regionp = objectp->getRegion();
+	if (objectp->isDead() || !regionp || objectp->isOrphaned() || objectp->isAttachment())
+	{
+		return false;
+	}
+
+	const LLVector3& scale = objectp->getScale();
+	const LLVector3 pos = objectp->getPositionRegion();
+	const F32 water_height = regionp->getWaterHeight();
+
+	F32 approx_radius = (scale.mV[VX] + scale.mV[VY]) * 0.5f * 0.5f * 1.3f;  // 1.3 is a fudge
+
+	// Limit the size of megaprims so they don't blot out everything on the minimap.
+	// Attempting to draw very large megaprims also causes client lag.
+	// See DEV-17370 and SNOW-79 for details.
+	approx_radius = llmin(approx_radius, sMaxPrimRadius);
+
+	point.mOwned = objectp->permYouOwner();
+	point.mColor = sAboveWaterColor;
+	if (point.mOwned)
+	{
+		const F32 MIN_RADIUS_FOR_OWNED_OBJECTS = 2.f;
+		if (approx_radius < MIN_RADIUS_FOR_OWNED_OBJECTS)
+		{
+			approx_radius = MIN_RADIUS_FOR_OWNED_OBJECTS;
+		}
+
+		if (pos.mV[VZ] >= water_height)
+		{
+			point.mColor = objectp->permGroupOwner() ? sGroupOwnAboveWaterColor : sYouOwnAboveWaterColor;
+		}
+		else
+		{
+			point.mColor = objectp->permGroupOwner() ? sGroupOwnBelowWaterColor : sYouOwnBelowWaterColor;
+		}
+	}
+	else if (pos.mV[VZ] < water_height)
+	{
+		point.mColor = sBelowWaterColor;
+	}
+
+	point.mX = pos.mV[VX];
+	point.mY = pos.mV[VY];
+	point.mZ = pos.mV[VZ];
+	point.mRadius = approx_radius;
+	region_handle = regionp->getHandle();
+	region_width = regionp->getWidth();
+	return true;
+}
+
+//static
+void LLNetMapTiles::updatePoint(LLViewerObject* objectp)
+{
+	U64 region_handle = 0;
+	F32 region_width = 0.f;
+	Point point;
+	if (!makePoint(objectp, region_handle, region_width, point))
+	{
+		removePoint(objectp);
+		return;
+	}
+
+	object_region_map_t::iterator region_iter = sObjectRegions.find(objectp);
+	if (region_iter != sObjectRegions.end() && region_iter->second == region_handle)
+	{
+		Tile& tile = sTiles[region_handle];
+		Point& old_point = tile.mPoints[objectp];
+		// Drifting by less than half a texel doesn't show.
+		F32 tolerance = sTileSize > 0 ? 0.5f * tile.mRegionWidth / (F32)sTileSize : 0.f;
+		if (llabs(point.mX - old_point.mX) > tolerance ||
+			llabs(point.mY - old_point.mY) > tolerance ||
+			llabs(point.mRadius - old_point.mRadius) > tolerance ||
+			point.mColor != old_point.mColor ||
+			point.mOwned != old_point.mOwned ||
+			(point.mZ <= sMaxAltitude) != (old_point.mZ <= sMaxAltitude))
+		{
+			old_point = point;
+			tile.mDirty = true;
+		}
+		else
+		{
+			// Keep the altitude current for when the cut-off moves.
+			old_point.mZ = point.mZ;
+		}
+		return;
+	}
+
+	removePoint(objectp);
+	Tile& tile = sTiles[region_handle];
+	tile.mPoints[objectp] = point;
+	tile.mRegionWidth = region_width;
+	tile.mDirty = true;
+	sObjectRegions[objectp] = region_handle;
+}
+
+//static
+void LLNetMapTiles::removePoint(LLViewerObject* objectp)
+{
+	object_region_map_t::iterator region_iter = sObjectRegions.find(objectp);
+	if (region_iter == sObjectRegions.end())
+	{
+		return;
+	}
+	tile_map_t::iterator tile_iter = sTiles.find(region_iter->second);
+	if (tile_iter != sTiles.end())
+	{
+		tile_iter->second.mPoints.erase(objectp);
+		tile_iter->second.mDirty = true;
+	}
+	sObjectRegions.erase(region_iter);
+}
+
+//static
+void LLNetMapTiles::dirtyAll()
+{
+	for (tile_map_t::iterator iter = sTiles.begin(); iter != sTiles.end(); ++iter)
+	{
+		iter->second.mDirty = true;
+	}
+}
+
+//static
+void LLNetMapTiles::tileDone(U64 region_handle, LLImageRaw* image)
+{
+	tile_map_t::iterator iter = sTiles.find(region_handle);
+	if (iter == sTiles.end())
+	{
+		// Region went away meanwhile
+		return;
+	}
+	Tile& tile = iter->second;
+	tile.mPending = false;
+	if (!image || image->isBufferInvalid())
+	{
+		tile.mDirty = true;
+		return;
+	}
+
+	// Only this tile goes to GL.  One of another size is still better than
+	// nothing until its replacement is done.
+	if (tile.mTexture.isNull() ||
+		tile.mTexture->getWidth() != image->getWidth() ||
+		tile.mTexture->getHeight() != image->getHeight())
+	{
+		tile.mTexture = LLViewerTextureManager::getLocalTexture(image, FALSE);
+	}
+	else
+	{
+		tile.mTexture->setSubImage(image, 0, 0, image->getWidth(), image->getHeight());
+	}
+}
+
+//static
+void LLNetMapTiles::rasterize(const point_list_t& points, LLImageRaw* image, F32 region_width)
+{
+	const S32 image_width = image->getWidth();
+	const S32 image_height = image->getHeight();
+	const F32 texels_per_meter = (F32)image_width / region_width;
+
+	U32* datap = (U32*)image->getData();
+	memset(datap, 0, image_width * image_height * 4);	/* Flawfinder: ignore */
+
+	for (point_list_t::const_iterator iter = points.begin(); iter != points.end(); ++iter)
+	{
+		const Point& point = *iter;
+		S32 diameter = llround(2 * point.mRadius * texels_per_meter);
+		if (diameter <= 0)
+		{
+			continue;
+		}
+
+		S32 x_offset = llround(point.mX * texels_per_meter);
+		S32 y_offset = llround(point.mY * texels_per_meter);
+		if ((x_offset < 0) || (x_offset >= image_width) ||
+			(y_offset < 0) || (y_offset >= image_height))
+		{
+			continue;
+		}
+
+		S32 neg_radius = diameter / 2;
+		S32 pos_radius = diameter - neg_radius;
+		S32 x_begin = llmax(x_offset - neg_radius, 0);
+		S32 x_end = llmin(x_offset + pos_radius, image_width);
+		S32 y_begin = llmax(y_offset - neg_radius, 0);
+		S32 y_end = llmin(y_offset + pos_radius, image_height);
+		for (S32 y = y_begin; y < y_end; y++)
+		{
+			U32* rowp = datap + y * image_width;
+			for (S32 x = x_begin; x < x_end; x++)
+			{
+				rowp[x] = point.mColor.mAll;
+			}
+		}
+	}
+}
+
+//============================================================================
+
+LLNetMapTiles::LLNetMapTiles(bool threaded)
+	: LLQueuedThread("netmaptiles", threaded)
+{
+}
+
+LLNetMapTiles::~LLNetMapTiles()
+{
+	// ~LLQueuedThread() will be called here
+}
+
+//============================================================================
+
+LLNetMapTiles::RasterRequest::RasterRequest(LLNetMapTiles* thread, handle_t handle, U64 region_handle,
+											point_list_t& points, S32 tile_size, F32 region_width)
+	: LLQueuedThread::QueuedRequest(handle, LLQueuedThread::PRIORITY_NORMAL, FLAG_AUTO_COMPLETE),
+	  mThread(thread),
+	  mRegionHandle(region_handle),
+	  mTileSize(tile_size),
+	  mRegionWidth(region_width)
+{
+	mPoints.swap(points);
+}
+
+LLNetMapTiles::RasterRequest::~RasterRequest()
+{
+}
+
+bool LLNetMapTiles::RasterRequest::processRequest()
+{
+	mImage = new LLImageRaw(mTileSize, mTileSize, 4);
+	if (!mImage->isBufferInvalid())
+	{
+		rasterize(mPoints, mImage, mRegionWidth);
+	}
+	return true;
+}
+
+void LLNetMapTiles::RasterRequest::finishRequest(bool completed)
+{
+	LLMutexLock lock(&mThread->mCompletedMutex);
+	mThread->mCompletedList.push_back(completed_info());
+	completed_info& info = mThread->mCompletedList.back();
+	info.region_handle = mRegionHandle;
+	if (completed)
+	{
+		info.image = mImage;
+	}
+}
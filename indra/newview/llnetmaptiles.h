@@ -0,0 +1,163 @@
+/**
+ * @file llnetmaptiles.h
+ * @brief The minimap object layer, rasterized per region in the background
+ *
+ * $LicenseInfo:firstyear=2002&license=viewergpl$
+ *
+ * Copyright (c) 2002-2009, Linden Research, Inc.
+ *
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ *
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ *
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ *
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+
+#ifndef LL_LLNETMAPTILES_H
+#define LL_LLNETMAPTILES_H
+
+#include <map>
+#include <set>
+#include <vector>
+
+#include "llframetimer.h"
+#include "llqueuedthread.h"
+#include "v4coloru.h"
+
+class LLImageRaw;
+class LLViewerObject;
+class LLViewerRegion;
+class LLViewerTexture;
+
+//============================================================================
+// The minimap's object layer, kept as one tile per region.  Map objects
+// report being added, changed and removed; updateClass() turns that into
+// dirty tiles, which are rasterized on this thread and uploaded again once
+// they come back.  Tiles nothing happened to are left alone.  LLNetMap draws
+// them on top of the land, one region at a time.
+//============================================================================
+
+class LLNetMapTiles : public LLQueuedThread
+{
+public:
+	// A map object as it shows on the map, in region meters
+	struct Point
+	{
+		F32 mX;
+		F32 mY;
+		F32 mZ;			// global
+		F32 mRadius;
+		LLColor4U mColor;
+		bool mOwned;	// shown at any altitude
+	};
+	typedef std::vector<Point> point_list_t;
+
+	class RasterRequest : public LLQueuedThread::QueuedRequest
+	{
+	protected:
+		virtual ~RasterRequest(); // use deleteRequest()
+
+	public:
+		RasterRequest(LLNetMapTiles* thread, handle_t handle, U64 region_handle,
+					  point_list_t& points, S32 tile_size, F32 region_width);
+
+		/*virtual*/ bool processRequest();
+		/*virtual*/ void finishRequest(bool completed);
+
+	private:
+		LLNetMapTiles* mThread;
+		U64 mRegionHandle;
+		// input
+		point_list_t mPoints;
+		S32 mTileSize;
+		F32 mRegionWidth;
+		// output
+		LLPointer<LLImageRaw> mImage;
+	};
+
+public:
+	LLNetMapTiles(bool threaded = true);
+	virtual ~LLNetMapTiles();
+
+	// Run on MAIN thread
+	static void initClass(bool threaded = true);
+	static void cleanupClass();
+
+	// Picks up finished tiles, and when 'redraw' is set also queues the
+	// dirty ones, tile_size texels a side.  Called by LLNetMap::draw().
+	static void updateClass(S32 tile_size, bool redraw);
+
+	// NULL until the region's first tile is done
+	static LLViewerTexture* getTile(LLViewerRegion* regionp);
+
+	// Objects joining and leaving LLViewerObjectList's map list, and ones on
+	// it that moved or were resized.
+	static void objectAdded(LLViewerObject* objectp);
+	static void objectChanged(LLViewerObject* objectp);
+	static void objectRemoved(LLViewerObject* objectp);
+
+	// Draws points into image, which covers a region region_width meters wide.
+	// Any thread.
+	static void rasterize(const point_list_t& points, LLImageRaw* image, F32 region_width);
+
+private:
+	struct Tile
+	{
+		Tile() : mRegionWidth(256.f), mDirty(false), mPending(false) { }
+
+		typedef std::map<LLViewerObject*, Point> point_map_t;
+		point_map_t mPoints;
+		F32 mRegionWidth;
+		bool mDirty;
+		bool mPending;		// on its way back from the thread
+		LLPointer<LLViewerTexture> mTexture;
+	};
+	typedef std::map<U64, Tile> tile_map_t;
+
+	static bool makePoint(LLViewerObject* objectp, U64& region_handle, F32& region_width, Point& point);
+	static void updatePoint(LLViewerObject* objectp);
+	static void removePoint(LLViewerObject* objectp);
+	static void dirtyAll();
+	static void tileDone(U64 region_handle, LLImageRaw* image);
+
+	struct completed_info
+	{
+		U64 region_handle;
+		LLPointer<LLImageRaw> image;
+	};
+	typedef std::vector<completed_info> completed_list_t;
+	completed_list_t mCompletedList;
+	LLMutex mCompletedMutex;
+
+	static LLNetMapTiles* sInstance;
+
+	static tile_map_t sTiles;
+	typedef std::map<LLViewerObject*, U64> object_region_map_t;
+	static object_region_map_t sObjectRegions;	// where each shown object's point is
+	typedef std::set<LLViewerObject*> object_set_t;
+	static object_set_t sMapObjects;
+	static object_set_t sChangedObjects;
+	static LLFrameTimer sResyncTimer;
+	static S32 sTileSize;
+	static F32 sMaxAltitude;
+};
+
+#endif // LL_LLNETMAPTILES_H
@@ -48,8 +48,8 @@
 #include "llscrollbar.h"
 #include "llscrollcontainer.h"
 #include "llscrolllistctrl.h"
+#include "llscriptcompilethread.h"
 #include "llslider.h"
-#include "lscript_rt_interface.h"
 #include "lscript_export.h"
 #include "lltextbox.h"
 #include "lltooldraganddrop.h"
@@ -1179,6 +1179,22 @@ void LLScriptEdCore::selectFirstError()
 	onErrorList(mErrorList, this);
 }
 
+void LLScriptEdCore::addCompileErrors(const std::string& errors)
+{
+	std::istringstream lines(errors);
+	std::string line;
+	while (std::getline(lines, line))
+	{
+		LLStringUtil::stripNonprintable(line);
+
+		LLSD row;
+		row["columns"][0]["value"] = line;
+		row["columns"][0]["font"] = "OCRA";
+		mErrorList->addElement(row);
+	}
+	selectFirstError();
+}
+
 
 struct LLEntryAndEdCore
 {
@@ -1489,7 +1505,7 @@ void LLPreviewLSL::saveIfNeeded()
 		}
 		else if (gAssetStorage)
 		{
-			uploadAssetLegacy(filename, mItemUUID, tid);
+			uploadAssetLegacy(filename, utf8text, mItemUUID, tid);
 		}
 	}
 }
@@ -1512,7 +1528,27 @@ void LLPreviewLSL::uploadAssetViaCaps(const std::string& url,
 	LLHTTPClient::post(url, body, new LLUpdateAgentInventoryResponder(body, filename, LLAssetType::AT_LSL_TEXT));
 }
 
+class LLPreviewLSLCompileResponder : public LLScriptCompileThread::Responder
+{
+public:
+	LLPreviewLSLCompileResponder(const LLUUID& item_uuid, const LLTransactionID& tid) :
+		mItemUUID(item_uuid),
+		mTransactionID(tid)
+	{
+	}
+
+	/*virtual*/ void completed(bool success, const std::vector<U8>& bytecode, const std::string& errors)
+	{
+		LLPreviewLSL::onCompileComplete(mItemUUID, mTransactionID, success, bytecode, errors);
+	}
+
+private:
+	LLUUID mItemUUID;
+	LLTransactionID mTransactionID;
+};
+
 void LLPreviewLSL::uploadAssetLegacy(const std::string& filename,
+									  const std::string& source,
 									  const LLUUID& item_id,
 									  const LLTransactionID& tid)
 {
@@ -1525,75 +1561,65 @@ void LLPreviewLSL::uploadAssetLegacy(const std::string& filename,
 								  &LLPreviewLSL::onSaveComplete,
 								  info);
 
-	LLAssetID asset_id = tid.makeAssetID(gAgent.getSecureSessionID());
-	std::string filepath = gDirUtilp->getExpandedFilename(LL_PATH_CACHE,asset_id.asString());
-	std::string dst_filename = llformat("%s.lso", filepath.c_str());
-	std::string err_filename = llformat("%s.out", filepath.c_str());
-
-	const BOOL compile_to_mono = FALSE;
-	if(!lscript_compile(filename.c_str(),
-						dst_filename.c_str(),
-						err_filename.c_str(),
-						compile_to_mono,
-						asset_id.asString().c_str(),
-						gAgent.isGodlike()))
-	{
-		llinfos << "Compile failed!" << llendl;
-		//char command[256];
-		//sprintf(command, "type %s\n", err_filename.c_str());
-		//system(command);
+	// The bytecode upload is pending from now on, so that closing after
+	// the save waits for the compile thread too.
+	getWindow()->incBusyCount();
+	mPendingUploads++;
+	LLScriptCompileThread::compileScript(source, gAgent.isGodlike(),
+										 new LLPreviewLSLCompileResponder(mItemUUID, tid));
 
-		// load the error file into the error scrolllist
-		LLFILE* fp = LLFile::fopen(err_filename, "r");
-		if(fp)
-		{
-			char buffer[MAX_STRING];		/*Flawfinder: ignore*/
-			std::string line;
-			while(!feof(fp)) 
-			{
-				if (fgets(buffer, MAX_STRING, fp) == NULL)
-				{
-					buffer[0] = '\0';
-				}
-				if(feof(fp))
-				{
-					break;
-				}
-				else
-				{
-					line.assign(buffer);
-					LLStringUtil::stripNonprintable(line);
+	// get rid of any temp files left lying around
+	LLFile::remove(filename);
+}
 
-					LLSD row;
-					row["columns"][0]["value"] = line;
-					row["columns"][0]["font"] = "OCRA";
-					mScriptEd->mErrorList->addElement(row);
-				}
-			}
-			fclose(fp);
-			mScriptEd->selectFirstError();
-		}
+// static
+void LLPreviewLSL::onCompileComplete(const LLUUID& item_uuid, const LLTransactionID& tid,
+									 bool success, const std::vector<U8>& bytecode, const std::string& errors)
+{
+	LLPreviewLSL* self = LLPreviewLSL::getInstance(item_uuid);
+	if (success && bytecode.empty())
+	{
+		llwarns << "Compile reported success but gave no bytecode" << llendl;
+		success = false;
 	}
-	else
+	if (success)
 	{
 		llinfos << "Compile worked!" << llendl;
-		if(gAssetStorage)
+		if (gAssetStorage)
 		{
-			getWindow()->incBusyCount();
-			mPendingUploads++;
-			LLUUID* this_uuid = new LLUUID(mItemUUID);
-			gAssetStorage->storeAssetData(dst_filename,
-										  tid,
+			LLAssetID asset_id = tid.makeAssetID(gAgent.getSecureSessionID());
+			LLVFile file(gVFS, asset_id, LLAssetType::AT_LSL_BYTECODE, LLVFile::APPEND);
+			file.setMaxSize(bytecode.size());
+			file.write(&bytecode[0], bytecode.size());
+			LLUUID* this_uuid = new LLUUID(item_uuid);
+			gAssetStorage->storeAssetData(tid,
 										  LLAssetType::AT_LSL_BYTECODE,
 										  &LLPreviewLSL::onSaveBytecodeComplete,
 										  (void**)this_uuid);
+			// onSaveBytecodeComplete() takes over the pending upload.
+			return;
+		}
+	}
+	else
+	{
+		llinfos << "Compile failed!" << llendl;
+		if (self)
+		{
+			self->mScriptEd->addCompileErrors(errors);
 		}
 	}
 
-	// get rid of any temp files left lying around
-	LLFile::remove(filename);
-	LLFile::remove(err_filename);
-	LLFile::remove(dst_filename);
+	// The compile was counted busy even if the editor has closed since
+	getWindow()->decBusyCount();
+	if (self)
+	{
+		self->mPendingUploads--;
+		if (self->mPendingUploads <= 0
+			&& self->mCloseAfterSave)
+		{
+			self->close();
+		}
+	}
 }
 
 
@@ -1655,6 +1681,8 @@ void LLPreviewLSL::onSaveBytecodeComplete(const LLUUID& asset_uuid, void* user_d
 	{
 		self = LLPreviewLSL::getInstance(*instance_uuid);
 	}
+	// This upload took over the busy count of the compile
+	getWindow()->decBusyCount();
 	if (0 == status)
 	{
 		if (self)
@@ -1665,7 +1693,6 @@ void LLPreviewLSL::onSaveBytecodeComplete(const LLUUID& asset_uuid, void* user_d
 			self->mScriptEd->mErrorList->addElement(row);
 
 			// Find our window and close it if requested.
-			self->getWindow()->decBusyCount();
 			self->mPendingUploads--;
 			if (self->mPendingUploads <= 0
 				&& self->mCloseAfterSave)
@@ -2382,7 +2409,7 @@ void LLLiveLSLEditor::saveIfNeeded()
 	}
 	else if (gAssetStorage)
 	{
-		uploadAssetLegacy(filename, object, tid, is_running);
+		uploadAssetLegacy(filename, utf8text, object, tid, is_running);
 	}
 }
 
@@ -2402,7 +2429,33 @@ void LLLiveLSLEditor::uploadAssetViaCaps(const std::string& url,
 		new LLUpdateTaskInventoryResponder(body, filename, LLAssetType::AT_LSL_TEXT));
 }
 
+class LLLiveLSLCompileResponder : public LLScriptCompileThread::Responder
+{
+public:
+	LLLiveLSLCompileResponder(const LLUUID& object_id, LLViewerInventoryItem* item,
+							  BOOL is_running, const LLTransactionID& tid) :
+		mObjectID(object_id),
+		mItem(new LLViewerInventoryItem(item)),
+		mIsRunning(is_running),
+		mTransactionID(tid)
+	{
+	}
+
+	/*virtual*/ void completed(bool success, const std::vector<U8>& bytecode, const std::string& errors)
+	{
+		LLLiveLSLEditor::onCompileComplete(mObjectID, mItem, mIsRunning, mTransactionID,
+										   success, bytecode, errors);
+	}
+
+private:
+	LLUUID mObjectID;
+	LLPointer<LLViewerInventoryItem> mItem;
+	BOOL mIsRunning;
+	LLTransactionID mTransactionID;
+};
+
 void LLLiveLSLEditor::uploadAssetLegacy(const std::string& filename,
+										const std::string& source,
 										LLViewerObject* object,
 										const LLTransactionID& tid,
 										BOOL is_running)
@@ -2416,90 +2469,89 @@ void LLLiveLSLEditor::uploadAssetLegacy(const std::string& filename,
 								  (void*)data,
 								  FALSE);
 
-	LLAssetID asset_id = tid.makeAssetID(gAgent.getSecureSessionID());
-	std::string filepath = gDirUtilp->getExpandedFilename(LL_PATH_CACHE,asset_id.asString());
-	std::string dst_filename = llformat("%s.lso", filepath.c_str());
-	std::string err_filename = llformat("%s.out", filepath.c_str());
-
-	LLFILE *fp;
-	const BOOL compile_to_mono = FALSE;
-	if(!lscript_compile(filename.c_str(),
-						dst_filename.c_str(),
-						err_filename.c_str(),
-						compile_to_mono,
-						asset_id.asString().c_str(),
-						gAgent.isGodlike()))
-	{
-		// load the error file into the error scrolllist
-		llinfos << "Compile failed!" << llendl;
-		if(NULL != (fp = LLFile::fopen(err_filename, "r")))
-		{
-			char buffer[MAX_STRING];		/*Flawfinder: ignore*/
-			std::string line;
-			while(!feof(fp)) 
-			{
-				
-				if (fgets(buffer, MAX_STRING, fp) == NULL)
-				{
-					buffer[0] = '\0';
-				}
-				if(feof(fp))
-				{
-					break;
-				}
-				else
-				{
-					line.assign(buffer);
-					LLStringUtil::stripNonprintable(line);
-				
-					LLSD row;
-					row["columns"][0]["value"] = line;
-					row["columns"][0]["font"] = "OCRA";
-					mScriptEd->mErrorList->addElement(row);
-				}
-			}
-			fclose(fp);
-			mScriptEd->selectFirstError();
-			// don't set the asset id, because we want to save the
-			// script, even though the compile failed.
-			//mItem->setAssetUUID(LLUUID::null);
-			object->saveScript(mItem, FALSE, false);
-			dialog_refresh_all();
-		}
+	// The bytecode upload is pending from now on, so that closing after
+	// the save waits for the compile thread too.
+	getWindow()->incBusyCount();
+	mPendingUploads++;
+	LLScriptCompileThread::compileScript(source, gAgent.isGodlike(),
+										 new LLLiveLSLCompileResponder(mObjectID, mItem, is_running, tid));
+
+	// get rid of any temp files left lying around
+	LLFile::remove(filename);
+
+	// If we successfully saved it, then we should be able to check/uncheck the running box!
+	LLCheckBoxCtrl* runningCheckbox = getChild<LLCheckBoxCtrl>( "running");
+	runningCheckbox->setLabel(getString("script_running"));
+	runningCheckbox->setEnabled(TRUE);
+}
+
+// static
+void LLLiveLSLEditor::onCompileComplete(const LLUUID& object_id, LLViewerInventoryItem* item, BOOL is_running,
+										const LLTransactionID& tid, bool success,
+										const std::vector<U8>& bytecode, const std::string& errors)
+{
+	LLLiveLSLEditor* self = sInstances.getIfThere(item->getUUID() ^ object_id);
+	if (success && bytecode.empty())
+	{
+		llwarns << "Compile reported success but gave no bytecode" << llendl;
+		success = false;
 	}
-	else
+	if (success)
 	{
 		llinfos << "Compile worked!" << llendl;
-		// *TODO: Translate
-		mScriptEd->mErrorList->addCommentText(std::string("Compile successful, saving..."));
-		if(gAssetStorage)
+		if (self)
+		{
+			// *TODO: Translate
+			self->mScriptEd->mErrorList->addCommentText(std::string("Compile successful, saving..."));
+		}
+		if (gAssetStorage)
 		{
 			llinfos << "LLLiveLSLEditor::saveAsset "
-					<< mItem->getAssetUUID() << llendl;
-			getWindow()->incBusyCount();
-			mPendingUploads++;
-			LLLiveLSLSaveData* data = NULL;
-			data = new LLLiveLSLSaveData(mObjectID,
-										 mItem,
-										 is_running);
-			gAssetStorage->storeAssetData(dst_filename,
-										  tid,
+					<< item->getAssetUUID() << llendl;
+			LLAssetID asset_id = tid.makeAssetID(gAgent.getSecureSessionID());
+			LLVFile file(gVFS, asset_id, LLAssetType::AT_LSL_BYTECODE, LLVFile::APPEND);
+			file.setMaxSize(bytecode.size());
+			file.write(&bytecode[0], bytecode.size());
+			LLLiveLSLSaveData* data = new LLLiveLSLSaveData(object_id,
+															item,
+															is_running);
+			gAssetStorage->storeAssetData(tid,
 										  LLAssetType::AT_LSL_BYTECODE,
 										  &LLLiveLSLEditor::onSaveBytecodeComplete,
 										  (void*)data);
 			dialog_refresh_all();
+			// onSaveBytecodeComplete() takes over the pending upload.
+			return;
+		}
+	}
+	else
+	{
+		llinfos << "Compile failed!" << llendl;
+		if (self)
+		{
+			self->mScriptEd->addCompileErrors(errors);
+		}
+		// don't set the asset id, because we want to save the
+		// script, even though the compile failed.
+		LLViewerObject* object = gObjectList.findObject(object_id);
+		if (object)
+		{
+			object->saveScript(item, FALSE, false);
+			dialog_refresh_all();
 		}
 	}
 
-	// get rid of any temp files left lying around
-	LLFile::remove(filename);
-	LLFile::remove(err_filename);
-	LLFile::remove(dst_filename);
-
-	// If we successfully saved it, then we should be able to check/uncheck the running box!
-	LLCheckBoxCtrl* runningCheckbox = getChild<LLCheckBoxCtrl>( "running");
-	runningCheckbox->setLabel(getString("script_running"));
-	runningCheckbox->setEnabled(TRUE);
+	// The compile was counted busy even if the editor has closed since
+	getWindow()->decBusyCount();
+	if (self)
+	{
+		self->mPendingUploads--;
+		if (self->mPendingUploads <= 0
+			&& self->mCloseAfterSave)
+		{
+			self->close();
+		}
+	}
 }
 
 void LLLiveLSLEditor::onSaveTextComplete(const LLUUID& asset_uuid, void* user_data, S32 status, LLExtStat ext_status) // StoreAssetData callback (fixed)
@@ -2535,6 +2587,8 @@ void LLLiveLSLEditor::onSaveTextComplete(const LLUUID& asset_uuid, void* user_da
 void LLLiveLSLEditor::onSaveBytecodeComplete(const LLUUID& asset_uuid, void* user_data, S32 status, LLExtStat ext_status) // StoreAssetData callback (fixed)
 {
 	LLLiveLSLSaveData* data = (LLLiveLSLSaveData*)user_data;
+	// This upload took over the busy count of the compile
+	getWindow()->decBusyCount();
 	if(!data)
 		return;
 	if(0 ==status)
@@ -2548,7 +2602,6 @@ void LLLiveLSLEditor::onSaveBytecodeComplete(const LLUUID& asset_uuid, void* use
 			// *TODO: Translate
 			self->mScriptEd->mErrorList->addCommentText(std::string("Save complete."));
 			// close the window if this completes both uploads
-			self->getWindow()->decBusyCount();
 			self->mPendingUploads--;
 			if (self->mPendingUploads <= 0
 				&& self->mCloseAfterSave)
@@ -2575,9 +2628,6 @@ void LLLiveLSLEditor::onSaveBytecodeComplete(const LLUUID& asset_uuid, void* use
 		LLNotifications::instance().add("CompileQueueSaveBytecode", args);
 	}
 
-	std::string filepath = gDirUtilp->getExpandedFilename(LL_PATH_CACHE,asset_uuid.asString());
-	std::string dst_filename = llformat("%s.lso", filepath.c_str());
-	LLFile::remove(dst_filename);
 	delete data;
 }
 
@@ -126,6 +126,8 @@ public:
 	static BOOL		hasChanged(void* userdata);
 
 	void selectFirstError();
+	// One error list row per line of compiler output.
+	void addCompileErrors(const std::string& errors);
 	
 	void autoSave();
 
@@ -190,6 +192,7 @@ protected:
 							const std::string& filename, 
 							const LLUUID& item_id);
 	void uploadAssetLegacy(const std::string& filename,
+							const std::string& source,
 							const LLUUID& item_id,
 							const LLTransactionID& tid);
 	// <edit>
@@ -208,6 +211,10 @@ protected:
 	static void onSaveComplete(const LLUUID& uuid, void* user_data, S32 status, LLExtStat ext_status);
 	static void onSaveBytecodeComplete(const LLUUID& asset_uuid, void* user_data, S32 status, LLExtStat ext_status);
 public:
+	// Called on the main thread when the compile thread is done with a
+	// script saved through uploadAssetLegacy().
+	static void onCompileComplete(const LLUUID& item_uuid, const LLTransactionID& tid,
+								  bool success, const std::vector<U8>& bytecode, const std::string& errors);
 	static LLPreviewLSL* getInstance(const LLUUID& uuid);
 protected:
 	static void* createScriptEdPanel(void* userdata);
@@ -262,6 +269,7 @@ protected:
 							const LLUUID& item_id,
 							BOOL is_running);
 	void uploadAssetLegacy(const std::string& filename,
+						   const std::string& source,
 						   LLViewerObject* object,
 						   const LLTransactionID& tid,
 						   BOOL is_running);
@@ -280,6 +288,13 @@ protected:
 							   void* user_data, S32 status, LLExtStat ext_status);
 	static void onSaveTextComplete(const LLUUID& asset_uuid, void* user_data, S32 status, LLExtStat ext_status);
 	static void onSaveBytecodeComplete(const LLUUID& asset_uuid, void* user_data, S32 status, LLExtStat ext_status);
+public:
+	// Called on the main thread when the compile thread is done with a
+	// script saved through uploadAssetLegacy().
+	static void onCompileComplete(const LLUUID& object_id, LLViewerInventoryItem* item, BOOL is_running,
+								  const LLTransactionID& tid, bool success,
+								  const std::vector<U8>& bytecode, const std::string& errors);
+protected:
 	static void onRunningCheckboxClicked(LLUICtrl*, void* userdata);
 	static void onReset(void* userdata);
 
@@ -0,0 +1,194 @@
+/**
+ * @file llscriptcompilethread.cpp
+ * @brief Worker threads compiling LSL scripts in the background
+ *
+ * $LicenseInfo:firstyear=2002&license=viewergpl$
+ *
+ * Copyright (c) 2002-2009, Linden Research, Inc.
+ *
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ *
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ *
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ *
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#include "llviewerprecompiledheaders.h"
+
+#include "llscriptcompilethread.h"
+
+#include "llstl.h"
+#include "lscript_rt_interface.h"
+
+//============================================================================
+
+/*static*/ LLScriptCompileThread::thread_list_t LLScriptCompileThread::sThreads;
+
+//============================================================================
+// Run on MAIN thread
+//static
+void LLScriptCompileThread::initClass(U32 num_threads, bool threaded)
+{
+	llassert(sThreads.empty());
+	lscript_compile_init();
+	num_threads = llmax(num_threads, (U32)1);
+	for (U32 i = 0; i < num_threads; i++)
+	{
+		sThreads.push_back(new LLScriptCompileThread(threaded));
+	}
+}
+
+//static
+S32 LLScriptCompileThread::updateClass(U32 max_time_ms)
+{
+	S32 pending = 0;
+	for (thread_list_t::iterator iter = sThreads.begin(); iter != sThreads.end(); ++iter)
+	{
+		pending += (*iter)->update(max_time_ms);
+	}
+	return pending;
+}
+
+//static
+void LLScriptCompileThread::cleanupClass()
+{
+	for (thread_list_t::iterator iter = sThreads.begin(); iter != sThreads.end(); ++iter)
+	{
+		(*iter)->setQuitting();
+	}
+	while (updateClass(0))
+	{
+	}
+	for_each(sThreads.begin(), sThreads.end(), DeletePointer());
+	sThreads.clear();
+	lscript_compile_cleanup();
+}
+
+//static
+void LLScriptCompileThread::compileScript(const std::string& source, BOOL is_god_like, Responder* responder)
+{
+	if (sThreads.empty())
+	{
+		llwarns << "LLScriptCompileThread::compileScript called after cleanupClass()" << llendl;
+		return;
+	}
+	LLScriptCompileThread* least_busy = sThreads.front();
+	S32 least_pending = least_busy->getPending();
+	for (thread_list_t::iterator iter = sThreads.begin() + 1; iter != sThreads.end(); ++iter)
+	{
+		S32 pending = (*iter)->getPending();
+		if (pending < least_pending)
+		{
+			least_busy = *iter;
+			least_pending = pending;
+		}
+	}
+	least_busy->compile(source, is_god_like, responder);
+}
+
+//----------------------------------------------------------------------------
+
+LLScriptCompileThread::LLScriptCompileThread(bool threaded) :
+	LLQueuedThread("scriptcompile", threaded)
+{
+}
+
+LLScriptCompileThread::~LLScriptCompileThread()
+{
+	// ~LLQueuedThread() will be called here
+}
+
+LLScriptCompileThread::handle_t LLScriptCompileThread::compile(const std::string& source, BOOL is_god_like,
+															   Responder* responder)
+{
+	handle_t handle = generateHandle();
+	CompileRequest* req = new CompileRequest(this, handle, source, is_god_like, responder);
+	bool res = addRequest(req);
+	if (!res)
+	{
+		llerrs << "LLScriptCompileThread::compile called after LLScriptCompileThread::cleanupClass()" << llendl;
+	}
+	return handle;
+}
+
+// MAIN THREAD
+S32 LLScriptCompileThread::update(U32 max_time_ms)
+{
+	S32 res = LLQueuedThread::update(max_time_ms);
+
+	// Hand finished compiles back to their responders outside of the lock,
+	// they are free to queue more work.
+	completed_list_t completed;
+	{
+		LLMutexLock lock(&mCompletedMutex);
+		completed.swap(mCompletedList);
+	}
+	for (completed_list_t::iterator iter = completed.begin(); iter != completed.end(); ++iter)
+	{
+		iter->responder->completed(iter->success, iter->bytecode, iter->errors);
+	}
+	return res + (S32)completed.size();
+}
+
+//----------------------------------------------------------------------------
+
+LLScriptCompileThread::Responder::~Responder()
+{
+}
+
+//----------------------------------------------------------------------------
+
+LLScriptCompileThread::CompileRequest::CompileRequest(LLScriptCompileThread* thread, handle_t handle,
+													  const std::string& source, BOOL is_god_like,
+													  Responder* responder) :
+	LLQueuedThread::QueuedRequest(handle, PRIORITY_NORMAL, FLAG_AUTO_COMPLETE),
+	mThread(thread),
+	mSource(source),
+	mGodLike(is_god_like),
+	mSuccess(false),
+	mResponder(responder)
+{
+}
+
+LLScriptCompileThread::CompileRequest::~CompileRequest()
+{
+}
+
+// Returns true when done, whether or not the compile was successful.
+bool LLScriptCompileThread::CompileRequest::processRequest()
+{
+	mSuccess = lscript_compile_buffer(mSource, mBytecode, mErrors, mGodLike);
+	return true;
+}
+
+void LLScriptCompileThread::CompileRequest::finishRequest(bool completed)
+{
+	if (mResponder.notNull())
+	{
+		LLMutexLock lock(&mThread->mCompletedMutex);
+		mThread->mCompletedList.push_back(completed_info());
+		completed_info& info = mThread->mCompletedList.back();
+		info.success = completed && mSuccess;
+		info.bytecode.swap(mBytecode);
+		info.errors.swap(mErrors);
+		info.responder = mResponder;
+	}
+	// Will automatically be deleted
+}
@@ -0,0 +1,115 @@
+/**
+ * @file llscriptcompilethread.h
+ * @brief Worker threads compiling LSL scripts in the background
+ *
+ * $LicenseInfo:firstyear=2002&license=viewergpl$
+ *
+ * Copyright (c) 2002-2009, Linden Research, Inc.
+ *
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ *
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ *
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ *
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLSCRIPTCOMPILETHREAD_H
+#define LL_LLSCRIPTCOMPILETHREAD_H
+
+#include <list>
+#include <string>
+#include <vector>
+
+#include "llqueuedthread.h"
+
+//============================================================================
+// Compiles LSL source to LSO bytecode off the main thread.  The compiler
+// keeps its state per thread, so several of these run side by side as a
+// pool; compileScript() hands each request to the least loaded one.
+// Responders are always called on the main thread, from updateClass().
+//============================================================================
+
+class LLScriptCompileThread : public LLQueuedThread
+{
+public:
+	class Responder : public LLThreadSafeRefCount
+	{
+	protected:
+		virtual ~Responder();
+	public:
+		virtual void completed(bool success, const std::vector<U8>& bytecode, const std::string& errors) = 0;
+	};
+
+	class CompileRequest : public LLQueuedThread::QueuedRequest
+	{
+	protected:
+		virtual ~CompileRequest(); // use deleteRequest()
+
+	public:
+		CompileRequest(LLScriptCompileThread* thread, handle_t handle,
+					   const std::string& source, BOOL is_god_like,
+					   Responder* responder);
+
+		/*virtual*/ bool processRequest();
+		/*virtual*/ void finishRequest(bool completed);
+
+	private:
+		LLScriptCompileThread* mThread;
+		// input
+		std::string mSource;
+		BOOL mGodLike;
+		// output
+		bool mSuccess;
+		std::vector<U8> mBytecode;
+		std::string mErrors;
+		LLPointer<Responder> mResponder;
+	};
+
+public:
+	LLScriptCompileThread(bool threaded = true);
+	virtual ~LLScriptCompileThread();
+
+	handle_t compile(const std::string& source, BOOL is_god_like, Responder* responder);
+	S32 update(U32 max_time_ms);
+
+	// Run on MAIN thread
+	static void initClass(U32 num_threads, bool threaded = true);
+	static S32 updateClass(U32 max_time_ms);
+	static void cleanupClass();
+
+	static void compileScript(const std::string& source, BOOL is_god_like, Responder* responder);
+
+private:
+	struct completed_info
+	{
+		bool success;
+		std::vector<U8> bytecode;
+		std::string errors;
+		LLPointer<Responder> responder;
+	};
+	typedef std::list<completed_info> completed_list_t;
+	completed_list_t mCompletedList;
+	LLMutex mCompletedMutex;
+
+	typedef std::vector<LLScriptCompileThread*> thread_list_t;
+	static thread_list_t sThreads;
+};
+
+#endif // LL_LLSCRIPTCOMPILETHREAD_H
@@ -1620,6 +1620,9 @@ LLSpatialPartition::~LLSpatialPartition()
 	
 	delete mOctree;
 	mOctree = NULL;
+
+	for_each(mCullJobs.begin(), mCullJobs.end(), DeletePointer());
+	mCullJobs.clear();
 }
 
 
@@ -2223,6 +2226,180 @@ S32 LLSpatialPartition::cull(LLCamera &camera, std::vector<LLDrawable *>* result
 	return 0;
 }
 
+//============================================================================
+// Parallel culling.  The frustum checks are most of the work of a cull and
+// read nothing but the octree and the camera, so they can run on LLCullThreads:
+// each job runs one of the cullers above over a subtree, recording the groups
+// it reaches in the order it reaches them.  Occlusion readback and marking
+// groups visible touch GL and the pipeline, finishCull() does those on the
+// main thread by walking the recordings.
+
+typedef LLCullTrace<LLSpatialGroup> cull_trace_t;
+
+template <class T>
+class LLOctreeCullRecorder : public T
+{
+public:
+	LLOctreeCullRecorder(LLCamera* camera, S32 res, cull_trace_t& trace)
+		: T(camera), mTrace(trace)
+	{
+		this->mRes = res;
+	}
+
+	// Left to the main thread, which skips the recorded subtree of an occluded group.
+	virtual bool earlyFail(LLSpatialGroup* group)
+	{
+		return false;
+	}
+
+	virtual void traverse(const LLSpatialGroup::OctreeNode* n)
+	{
+		U32 index = mTrace.beginGroup((LLSpatialGroup*) n->getListener(0));
+		T::traverse(n);
+		mTrace.endGroup(index);
+	}
+
+	virtual void visit(const LLSpatialGroup::OctreeNode* branch)
+	{
+		// Visited before its children are traversed, so still the last entry
+		mTrace.setProcess(this->checkObjects(branch, (LLSpatialGroup*) branch->getListener(0)));
+	}
+
+	// Only the root itself, whose result the jobs for its children start from.
+	void traverseRoot(const LLSpatialGroup::OctreeNode* n)
+	{
+		LLSpatialGroup* group = (LLSpatialGroup*) n->getListener(0);
+		mTrace.beginGroup(group);
+		this->mRes = this->frustumCheck(group);
+		if (this->mRes)
+		{
+			visit(n);
+		}
+	}
+
+	cull_trace_t& mTrace;
+};
+
+class LLOctreeCullJob : public LLCullThread::Job
+{
+public:
+	typedef enum
+	{
+		CULL_NORMAL,
+		CULL_NO_FAR_CLIP,
+		CULL_SHADOW
+	} ECuller;
+
+	LLOctreeCullJob()
+		: mNode(NULL), mCamera(NULL), mRes(0), mCuller(CULL_NORMAL), mRoot(false) { }
+
+	void setup(const LLSpatialGroup::OctreeNode* node, LLCamera* camera, S32 res, ECuller culler, bool root)
+	{
+		mNode = node;
+		mCamera = camera;
+		mRes = res;
+		mCuller = culler;
+		mRoot = root;
+		mTrace.clear();
+	}
+
+	/*virtual*/ void run()
+	{
+		switch (mCuller)
+		{
+		case CULL_SHADOW:
+			record<LLOctreeCullShadow>();
+			break;
+		case CULL_NO_FAR_CLIP:
+			record<LLOctreeCullNoFarClip>();
+			break;
+		default:
+			record<LLOctreeCull>();
+			break;
+		}
+	}
+
+	template <class T>
+	void record()
+	{
+		LLOctreeCullRecorder<T> culler(mCamera, mRes, mTrace);
+		if (mRoot)
+		{
+			culler.traverseRoot(mNode);
+			mRes = culler.mRes;
+		}
+		else
+		{
+			culler.traverse(mNode);
+		}
+	}
+
+	const LLSpatialGroup::OctreeNode* mNode;
+	LLCamera* mCamera;
+	S32 mRes;
+	ECuller mCuller;
+	bool mRoot;
+	cull_trace_t mTrace;
+};
+
+void LLSpatialPartition::queueCull(LLCamera& camera, LLCullThread::job_list_t& jobs)
+{
+	LLMemType mt(LLMemType::MTYPE_SPACE_PARTITION);
+	{
+		LLFastTimer ftm(LLFastTimer::FTM_CULL_REBOUND);		
+		LLSpatialGroup* group = (LLSpatialGroup*) mOctree->getListener(0);
+		group->rebound();
+	}
+
+	LLOctreeCullJob::ECuller culler = LLOctreeCullJob::CULL_NORMAL;
+	if (LLPipeline::sShadowRender)
+	{
+		culler = LLOctreeCullJob::CULL_SHADOW;
+	}
+	else if (mInfiniteFarClip || !LLPipeline::sUseFarClip)
+	{
+		culler = LLOctreeCullJob::CULL_NO_FAR_CLIP;
+	}
+
+	if (mCullJobs.empty())
+	{
+		mCullJobs.push_back(new LLOctreeCullJob);
+	}
+	LLOctreeCullJob* root_job = mCullJobs[0];
+	root_job->setup(mOctree, &camera, 0, culler, true);
+	root_job->run();
+
+	U32 num_jobs = root_job->mRes ? mOctree->getChildCount() + 1 : 1;
+	while (mCullJobs.size() > num_jobs)
+	{
+		delete mCullJobs.back();
+		mCullJobs.pop_back();
+	}
+	while (mCullJobs.size() < num_jobs)
+	{
+		mCullJobs.push_back(new LLOctreeCullJob);
+	}
+	for (U32 i = 1; i < num_jobs; i++)
+	{
+		// Each child gets its own frustum check, as a serial cull does after
+		// the first child of a partly visible root.  The child of a fully
+		// visible root checks fully visible anyway, its bounds are inside.
+		mCullJobs[i]->setup(mOctree->getChild(i - 1), &camera, 0, culler, false);
+		jobs.push_back(mCullJobs[i]);
+	}
+}
+
+void LLSpatialPartition::finishCull(LLCamera& camera)
+{
+	LLMemType mt(LLMemType::MTYPE_SPACE_PARTITION);
+	// All the cullers occlude and process groups the same way
+	LLOctreeCull culler(&camera);
+	for (std::vector<LLOctreeCullJob*>::iterator iter = mCullJobs.begin(); iter != mCullJobs.end(); ++iter)
+	{
+		(*iter)->mTrace.replay(culler);
+	}
+}
+
 BOOL earlyFail(LLCamera* camera, LLSpatialGroup* group)
 {
 	if (camera->getOrigin().isExactlyZero())
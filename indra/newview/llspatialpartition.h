@@ -44,6 +44,7 @@
 #include "lldrawpool.h"
 #include "llface.h"
 #include "llviewercamera.h"
+#include "llcullthread.h"
 
 #include <queue>
 
@@ -53,6 +54,7 @@
 class LLSpatialPartition;
 class LLSpatialBridge;
 class LLSpatialGroup;
+class LLOctreeCullJob;
 
 S32 AABBSphereIntersect(const LLVector4a& min, const LLVector4a& max, const LLVector3 &origin, const F32 &rad);
 S32 AABBSphereIntersectR2(const LLVector4a& min, const LLVector4a& max, const LLVector3 &origin, const F32 &radius_squared);
@@ -434,6 +436,10 @@ public:
 
 	BOOL visibleObjectsInFrustum(LLCamera& camera);
 	S32 cull(LLCamera &camera, std::vector<LLDrawable *>* results = NULL, BOOL for_select = FALSE); // Cull on arbitrary frustum
+	// Same as cull(camera), in two halves: the frustum checks go to jobs for LLCullThread::runJobs(),
+	// finishCull() then does the occlusion and marks what's visible, in the order cull() would have.
+	void queueCull(LLCamera& camera, LLCullThread::job_list_t& jobs);
+	void finishCull(LLCamera& camera);
 	
 	BOOL isVisible(const LLVector3& v);
 	
@@ -460,6 +466,10 @@ public:
 	BOOL mDepthMask; //if TRUE, objects in this partition will be written to depth during alpha rendering
 	U32 mDrawableType;
 	U32 mPartitionType;
+
+private:
+	// The root first, then one per child of the root
+	std::vector<LLOctreeCullJob*> mCullJobs;
 };
 
 // class for creating bridges between spatial partitions
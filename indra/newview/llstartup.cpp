@@ -194,6 +194,7 @@
 #include "llviewermessage.h"
 #include "llviewernetwork.h"
 #include "llviewerobjectlist.h"
+#include "llviewerpacketreplay.h"
 #include "llviewerparcelmedia.h"
 #include "llviewerparcelmgr.h"
 #include "llviewerregion.h"
@@ -688,6 +689,11 @@ bool idle_startup()
 				msg->startLogging();
 			}
 
+			if (gSavedSettings.getBOOL("PacketCapture"))
+			{
+				LLViewerPacketReplay::startCapture();
+			}
+
 			// start the xfer system. by default, choke the downloads
 			// a lot...
 			const S32 VIEWER_MAX_XFER = 3;
@@ -948,6 +954,24 @@ bool idle_startup()
 			gViewerWindow->initWorldUI();
 		}
 
+		// A packet replay needs no login: make up an agent and go straight
+		// to building the world around the capture's first region.
+		if (!gSavedSettings.getString("ReplayPacketFile").empty())
+		{
+			if (!LLViewerPacketReplay::startReplay(first_sim, first_sim_handle, first_sim_size_x))
+			{
+				LL_WARNS("AppInit") << "Unable to replay packet capture, quitting" << LL_ENDL;
+				LLAppViewer::instance()->forceQuit();
+				return FALSE;
+			}
+			first_sim_size_y = first_sim_size_x;
+			gAgentID.generate();
+			gAgentSessionID.generate();
+			agent_start_position_region.setVec(128.f, 128.f, 30.f);
+			LLStartUp::setStartupState( STATE_WORLD_INIT );
+			return FALSE;
+		}
+
 		if (show_connect_box)
 		{
 			// Load all the name information out of the login view
@@ -2264,6 +2288,11 @@ bool idle_startup()
 	//---------------------------------------------------------------------
 	if(STATE_SEED_GRANTED_WAIT == LLStartUp::getStartupState())
 	{
+		if (LLViewerPacketReplay::isReplaying())
+		{
+			// No seed capability in a capture.
+			LLStartUp::setStartupState( STATE_SEED_CAP_GRANTED );
+		}
 		return FALSE;
 	}
 
@@ -2517,7 +2546,7 @@ bool idle_startup()
 	{
 		LL_DEBUGS("AppInit") << "Waiting for simulator ack...." << LL_ENDL;
 		set_startup_status(0.59f, LLTrans::getString("LoginWaitingForRegionHandshake"), gAgent.mMOTD);
-		if(gGotUseCircuitCodeAck)
+		if(gGotUseCircuitCodeAck || LLViewerPacketReplay::isReplaying())
 		{
 			LLStartUp::setStartupState( STATE_AGENT_SEND );
 		}
@@ -2573,6 +2602,15 @@ bool idle_startup()
 	//---------------------------------------------------------------------
 	if (STATE_AGENT_WAIT == LLStartUp::getStartupState())
 	{
+		if (LLViewerPacketReplay::isReplaying())
+		{
+			// Leave the captured packets to the main loop, which takes them
+			// a frame's worth at a time.  Inventory and wearables come from
+			// the login, so skip on to the end.
+			LLStartUp::setStartupState( STATE_CLEANUP );
+			return FALSE;
+		}
+
 		LLMessageSystem* msg = gMessageSystem;
 		while (msg->checkAllMessages(gFrameCount, gServicePump))
 		{
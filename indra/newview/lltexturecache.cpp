@@ -35,6 +35,7 @@
 #include "lltexturecache.h"
 
 #include "llapr.h"
+#include "lldecodedtexturecache.h"
 #include "lldir.h"
 #include "llimage.h"
 #include "lllfsthread.h"
@@ -50,6 +51,8 @@
 //  First TEXTURE_CACHE_ENTRY_SIZE bytes of each texture in texture.entries in same order
 // cache/textures/[0-F]/UUID.texture
 //  Actual texture body files
+// cache/textures/decoded/[0-F]/UUID_discard.raw
+//  Decoded mip levels, see LLDecodedTextureCache
 
 //note: there is no good to define 1024 for TEXTURE_CACHE_ENTRY_SIZE while FIRST_PACKET_SIZE is 600 on sim side.
 const S32 TEXTURE_CACHE_ENTRY_SIZE = FIRST_PACKET_SIZE;//1024;
@@ -769,7 +772,8 @@ LLTextureCache::LLTextureCache(bool threaded)
 	  mHeaderAPRFile(NULL),
 	  mReadOnly(TRUE), //do not allow to change the texture cache until setReadOnly() is called.
 	  mTexturesSizeTotal(0),
-	  mDoPurge(FALSE)
+	  mDoPurge(FALSE),
+	  mDecodedCache(new LLDecodedTextureCache(threaded))
 {
     // commented out 3 lines nothing goes here right now sams voodoo
 	purgeTextureFilesTimeSliced(true);
@@ -782,6 +786,8 @@ LLTextureCache::~LLTextureCache()
  	purgeTextureFilesTimeSliced(true); // VWR-3878 - NB - force-flush all pending file deletes
 	clearDeleteList() ;
 	writeUpdatedEntries() ;
+	mDecodedCache->shutdown();
+	delete mDecodedCache;
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -794,6 +800,7 @@ S32 LLTextureCache::update(U32 max_time_ms)
 
 	S32 res;
 	res = LLWorkerThread::update(max_time_ms);
+	res += mDecodedCache->update(max_time_ms);
 
 	mListMutex.lock();
 	handle_list_t priorty_list = mPrioritizeWriteList; // copy list
@@ -928,6 +935,7 @@ const char* cache_filename = "texture.cache";
 const char* old_textures_dirname = "textures";
 //change the location of the texture cache to prevent from being deleted by old version viewers.
 const char* textures_dirname = "texturecache";
+const char* decoded_dirname = "decoded";
 
 void LLTextureCache::setDirNames(ELLPath location)
 {
@@ -935,6 +943,7 @@ void LLTextureCache::setDirNames(ELLPath location)
 	mHeaderEntriesFileName = gDirUtilp->getExpandedFilename(location, textures_dirname, entries_filename);
 	mHeaderDataFileName = gDirUtilp->getExpandedFilename(location, textures_dirname, cache_filename);
 	mTexturesDirName = gDirUtilp->getExpandedFilename(location, textures_dirname);
+	mDecodedCache->setDirName(gDirUtilp->getExpandedFilename(location, textures_dirname, decoded_dirname));
 }
 
 void LLTextureCache::purgeCache(ELLPath location)
@@ -972,6 +981,7 @@ void LLTextureCache::purgeCache(ELLPath location)
 void LLTextureCache::setReadOnly(BOOL read_only)
 {
 	mReadOnly = read_only;
+	mDecodedCache->setReadOnly(read_only);
 }
 
 //called in the main thread.
@@ -1024,6 +1034,8 @@ S64 LLTextureCache::initCache(ELLPath location, S64 max_size, BOOL texture_cache
 	}
 	readHeaderCache();
 	purgeTextures(true); // calc mTexturesSize and make some room in the texture cache if we need it
+	mDecodedCache->initCache((S64)gSavedSettings.getU32("DecodedTextureCacheSize") * 1024 * 1024,
+							 gSavedSettings.getBOOL("DecodedTextureCacheCompress"));
 	llassert_always(getPending() == 0); //should not start accessing the texture cache before initialized.
 	return max_size; // unused cache space
 }
@@ -1547,6 +1559,8 @@ void LLTextureCache::clearCorruptedCache()
 
 void LLTextureCache::purgeAllTextures(bool purge_directories)
 {
+	// Lives inside the textures directory, go first
+	mDecodedCache->purgeAll(purge_directories);
 	if (!mReadOnly)
 	{
 		const char* subdirs = "0123456789abcdef";
@@ -2028,6 +2042,7 @@ bool LLTextureCache::removeFromCache(const LLUUID& id)
 
 		unlockHeaders();
 	}
+	mDecodedCache->remove(id);
 	return ret;
 }
 
@@ -40,6 +40,7 @@
 
 #include "llworkerthread.h"
 
+class LLDecodedTextureCache;
 class LLImageFormatted;
 class LLTextureCacheWorker;
 
@@ -130,6 +131,9 @@ public:
 
 	bool removeFromCache(const LLUUID& id);
 
+	// Decoded mip levels, see lldecodedtexturecache.h
+	LLDecodedTextureCache* getDecodedCache() { return mDecodedCache; }
+
 	// For LLTextureCacheWorker::Responder
 	LLTextureCacheWorker* getReader(handle_t handle);
 	LLTextureCacheWorker* getWriter(handle_t handle);
@@ -218,6 +222,8 @@ private:
 	S64 mTexturesSizeTotal;
 	LLAtomic32<BOOL> mDoPurge;
 
+	LLDecodedTextureCache* mDecodedCache;
+
 	typedef std::map<S32, Entry> idx_entry_map_t;
 	idx_entry_map_t mUpdatedEntryMap;
 
@@ -42,10 +42,12 @@
 #include "llhttpclient.h"
 #include "llhttpstatuscodes.h"
 #include "llimage.h"
+#include "llimagedxt.h"
 #include "llimagej2c.h"
 #include "llimageworker.h"
 #include "llworkerthread.h"
 #include "llagent.h"
+#include "lldecodedtexturecache.h"
 #include "lltexturecache.h"
 #include "llviewercontrol.h"
 #include "llviewertexturelist.h"
@@ -104,8 +106,8 @@ private:
 	class DecodeResponder : public LLImageDecodeThread::Responder
 	{
 	public:
-		DecodeResponder(LLTextureFetch* fetcher, const LLUUID& id, LLTextureFetchWorker* worker)
-			: mFetcher(fetcher), mID(id), mWorker(worker)
+		DecodeResponder(LLTextureFetch* fetcher, const LLUUID& id, U32 request_id, LLTextureFetchWorker* worker)
+			: mFetcher(fetcher), mID(id), mRequestID(request_id), mWorker(worker)
 		{
 		}
 		virtual void completed(bool success, LLImageRaw* raw, LLImageRaw* aux)
@@ -113,15 +115,37 @@ private:
 			LLTextureFetchWorker* worker = mFetcher->getWorker(mID);
 			if (worker)
 			{
- 				worker->callbackDecoded(success, raw, aux);
+ 				worker->callbackDecoded(mRequestID, success, raw, aux);
 			}
 		}
 	private:
 		LLTextureFetch* mFetcher;
 		LLUUID mID;
+		U32 mRequestID;
 		LLTextureFetchWorker* mWorker; // debug only (may get deleted from under us, use mFetcher/mID)
 	};
 
+	class CompressResponder : public LLImageDecodeThread::CompressResponder
+	{
+	public:
+		CompressResponder(LLTextureFetch* fetcher, const LLUUID& id, U32 request_id)
+			: mFetcher(fetcher), mID(id), mRequestID(request_id)
+		{
+		}
+		virtual void completed(bool success, LLImageDXT* compressed)
+		{
+			LLTextureFetchWorker* worker = mFetcher->getWorker(mID);
+			if (worker)
+			{
+				worker->callbackCompressed(mRequestID, success, compressed);
+			}
+		}
+	private:
+		LLTextureFetch* mFetcher;
+		LLUUID mID;
+		U32 mRequestID;
+	};
+
 	struct Compare
 	{
 		// lhs < rhs
@@ -153,7 +177,8 @@ public:
 	void callbackCacheRead(bool success, LLImageFormatted* image,
 						   S32 imagesize, BOOL islocal);
 	void callbackCacheWrite(bool success);
-	void callbackDecoded(bool success, LLImageRaw* raw, LLImageRaw* aux);
+	void callbackDecoded(U32 request_id, bool success, LLImageRaw* raw, LLImageRaw* aux);
+	void callbackCompressed(U32 request_id, bool success, LLImageDXT* compressed);
 	
 	void setGetStatus(U32 status, const std::string& reason)
 	{
@@ -205,6 +230,8 @@ private:
 		WAIT_HTTP_REQ,
 		DECODE_IMAGE,
 		DECODE_IMAGE_UPDATE,
+		COMPRESS_IMAGE,
+		COMPRESS_IMAGE_UPDATE,
 		WRITE_TO_CACHE,
 		WAIT_ON_WRITE,
 		DONE
@@ -215,6 +242,11 @@ private:
 		QUEUED = 1,
 		SENT_SIM = 2
 	};
+	enum e_decode_request // mDecodeRequest
+	{
+		DECODE_REQUEST = 0,
+		COMPRESS_REQUEST = 1
+	};
 	enum e_write_to_cache_state //mWriteToCacheState
 	{
 		NOT_WRITE = 0,
@@ -228,6 +260,7 @@ private:
 	LLPointer<LLImageFormatted> mFormattedImage;
 	LLPointer<LLImageRaw> mRawImage;
 	LLPointer<LLImageRaw> mAuxImage;
+	LLPointer<LLImageDXT> mCompressedImage;
 	LLUUID mID;
 	LLHost mHost;
 	std::string mUrl;
@@ -251,11 +284,15 @@ private:
 	S32 mFileSize;
 	S32 mCachedSize;	
 	e_request_state mSentRequest;
-	handle_t mDecodeHandle;
+	handle_t mDecodeHandle; // also the handle of the DXT compression request
+	e_decode_request mDecodeRequest; // which of the two mDecodeHandle is
+	U32 mDecodeRequestID; // numbers them, a callback only counts if it carries the current one
 	BOOL mLoaded;
 	BOOL mDecoded;
+	BOOL mCompressed;
 	BOOL mWritten;
 	BOOL mNeedsAux;
+	BOOL mCompress;
 	BOOL mHaveAllData;
 	BOOL mInLocalCache;
 	bool mCanUseHTTP ;
@@ -346,6 +383,9 @@ public:
 				}
 			}
 
+			// Time spent queued in the curl service is not round trip.
+			U64 transfer_start = getTransferStartTime();
+			mFetcher->recordHTTPResult(transfer_start ? transfer_start : mStartTime, data_size, status);
 			mFetcher->removeFromHTTPQueue(mID, data_size);
 
 		}
@@ -453,6 +493,14 @@ public:
 LLMutex* SGHostBlackList::sMutex = 0;
 SGHostBlackList::blacklist_t SGHostBlackList::blacklist;
 
+// Requests past what the curl service lets textures have open to one host
+// would only wait in its queue, so the window never asks for more.
+static U32 clamp_http_window(U32 requests)
+{
+	U32 max_per_host = LLCurl::getMaxPerHost(LLCurl::PRIORITY_TEXTURE);
+	return max_per_host ? llmin(requests, max_per_host) : requests;
+}
+
 //call every time a connection is opened
 //return true if connecting allowed
 static bool sgConnectionThrottle() {
@@ -492,6 +540,8 @@ const char* LLTextureFetchWorker::sStateDescs[] = {
 	"WAIT_HTTP_REQ",
 	"DECODE_IMAGE",
 	"DECODE_IMAGE_UPDATE",
+	"COMPRESS_IMAGE",
+	"COMPRESS_IMAGE_UPDATE",
 	"WRITE_TO_CACHE",
 	"WAIT_ON_WRITE",
 	"DONE",
@@ -533,9 +583,13 @@ LLTextureFetchWorker::LLTextureFetchWorker(LLTextureFetch* fetcher,
 	  mLoaded(FALSE),
 	  mSentRequest(UNSENT),
 	  mDecodeHandle(0),
+	  mDecodeRequest(DECODE_REQUEST),
+	  mDecodeRequestID(0),
 	  mDecoded(FALSE),
+	  mCompressed(FALSE),
 	  mWritten(FALSE),
 	  mNeedsAux(FALSE),
+	  mCompress(FALSE),
 	  mHaveAllData(FALSE),
 	  mInLocalCache(FALSE),
 	  mCanUseHTTP(true),
@@ -752,6 +806,7 @@ bool LLTextureFetchWorker::doWork(S32 param)
 		}
 
 		mRawImage = NULL ;
+		mCompressedImage = NULL;
 		mRequestedDiscard = -1;
 		mLoadedDiscard = -1;
 		mDecodedDiscard = -1;
@@ -776,6 +831,26 @@ bool LLTextureFetchWorker::doWork(S32 param)
 		// fall through
 	}
 
+	if (mState == LOAD_FROM_TEXTURE_CACHE && mCacheReadHandle == LLTextureCache::nullHandle() &&
+		mUrl.compare(0, 7, "file://") != 0)
+	{
+		// Decoded on an earlier visit?  Then there is nothing to fetch or decode.
+		S32 discard = -1;
+		if (mFetcher->mTextureCache->getDecodedCache()->read(mID, mDesiredDiscard, mNeedsAux, discard,
+															 mRawImage, mAuxImage))
+		{
+			mLoadedDiscard = discard;
+			mDecodedDiscard = discard;
+			mDecoded = TRUE;
+			mWriteToCacheState = NOT_WRITE;
+			LL_DEBUGS("Texture") << mID << ": Decoded cache hit. Discard: " << mDecodedDiscard
+								 << " Raw Image: " << llformat("%dx%d",mRawImage->getWidth(),mRawImage->getHeight()) << LL_ENDL;
+			setPriority(LLWorkerThread::PRIORITY_HIGH | mWorkPriority);
+			mState = COMPRESS_IMAGE;
+			// fall through
+		}
+	}
+
 	if (mState == LOAD_FROM_TEXTURE_CACHE)
 	{
 		if (mCacheReadHandle == LLTextureCache::nullHandle())
@@ -997,9 +1072,10 @@ bool LLTextureFetchWorker::doWork(S32 param)
 			//1, not openning too many file descriptors at the same time;
 			//2, control the traffic of http so udp gets bandwidth.
 			//
-			static const LLCachedControl<U32> max_http_requests("HTTPMaxRequests", 32);
+			//the cap itself is adjusted by mFetcher->mHTTPThrottle.
+			//
 			static const LLCachedControl<U32> min_http_requests("HTTPMinRequests", 2);
-			if(((U32)mFetcher->getNumHTTPRequests() > max_http_requests) ||
+			if(((U32)mFetcher->getNumHTTPRequests() > mFetcher->getHTTPWindow()) ||
 			   ((mFetcher->getTextureBandwidth() > mFetcher->mMaxBandwidth) &&
 				((U32)mFetcher->getNumHTTPRequests() > min_http_requests)) ||
 			    !sgConnectionThrottle())
@@ -1031,6 +1107,12 @@ bool LLTextureFetchWorker::doWork(S32 param)
 			mRequestedSize = mDesiredSize;
 			mRequestedDiscard = mDesiredDiscard;
 			mRequestedSize -= cur_size;
+			if (mRequestedDiscard > 0)
+			{
+				// Don't waste a round trip on a sliver: data past the desired
+				// discard is cached and serves the next, sharper request.
+				mRequestedSize = llmax(mRequestedSize, mFetcher->getHTTPRangeSize());
+			}
 			S32 offset = cur_size;
 			mBufferSize = cur_size; // This will get modified by callbackHttpGet()
 			
@@ -1262,8 +1344,9 @@ bool LLTextureFetchWorker::doWork(S32 param)
 		mState = DECODE_IMAGE_UPDATE;
 		LL_DEBUGS("Texture") << mID << ": Decoding. Bytes: " << mFormattedImage->getDataSize() << " Discard: " << discard
 				<< " All Data: " << mHaveAllData << LL_ENDL;
+		mDecodeRequest = DECODE_REQUEST;
 		mDecodeHandle = mFetcher->mImageDecodeThread->decodeImage(mFormattedImage, image_priority, discard, mNeedsAux,
-																  new DecodeResponder(mFetcher, mID, this));
+																  new DecodeResponder(mFetcher, mID, ++mDecodeRequestID, this));
 		// fall though
 	}
 	
@@ -1296,8 +1379,13 @@ bool LLTextureFetchWorker::doWork(S32 param)
 				llassert_always(mRawImage.notNull());
 				LL_DEBUGS("Texture") << mID << ": Decoded. Discard: " << mDecodedDiscard
 						<< " Raw Image: " << llformat("%dx%d",mRawImage->getWidth(),mRawImage->getHeight()) << LL_ENDL;
+				if (!mInLocalCache && mUrl.compare(0, 7, "file://") != 0)
+				{
+					// Spare the decoder next time
+					mFetcher->mTextureCache->getDecodedCache()->write(mID, mDecodedDiscard, mRawImage, mAuxImage);
+				}
 				setPriority(LLWorkerThread::PRIORITY_HIGH | mWorkPriority);
-				mState = WRITE_TO_CACHE;
+				mState = COMPRESS_IMAGE;
 			}
 			// fall through
 		}
@@ -1307,6 +1395,43 @@ bool LLTextureFetchWorker::doWork(S32 param)
 		}
 	}
 
+	if (mState == COMPRESS_IMAGE)
+	{
+		mCompressedImage = NULL;
+		S32 components = mRawImage.notNull() ? mRawImage->getComponents() : 0;
+		if (!mCompress || mNeedsAux || (components != 3 && components != 4))
+		{
+			// Nothing to compress, or the aux channel has to stay with the raw image
+			mState = WRITE_TO_CACHE;
+		}
+		else
+		{
+			static const LLCachedControl<bool> high_quality("TextureCompressDXTHighQuality", false);
+			setPriority(LLWorkerThread::PRIORITY_LOW | mWorkPriority); // Set priority first since Responder may change it
+			U32 image_priority = LLWorkerThread::PRIORITY_LOW | mWorkPriority;
+			mCompressed = FALSE;
+			mState = COMPRESS_IMAGE_UPDATE;
+			mDecodeRequest = COMPRESS_REQUEST;
+			mDecodeHandle = mFetcher->mImageDecodeThread->compressImage(mRawImage, new LLImageDXT(), image_priority,
+																		high_quality, new CompressResponder(mFetcher, mID, ++mDecodeRequestID));
+		}
+		// fall through
+	}
+
+	if (mState == COMPRESS_IMAGE_UPDATE)
+	{
+		if (mCompressed)
+		{
+			setPriority(LLWorkerThread::PRIORITY_HIGH | mWorkPriority);
+			mState = WRITE_TO_CACHE;
+			// fall through
+		}
+		else
+		{
+			return false;
+		}
+	}
+
 	if (mState == WRITE_TO_CACHE)
 	{
 		if (mWriteToCacheState != SHOULD_WRITE || mFormattedImage.isNull())
@@ -1625,13 +1750,17 @@ void LLTextureFetchWorker::callbackCacheWrite(bool success)
 
 //////////////////////////////////////////////////////////////////////////////
 
-void LLTextureFetchWorker::callbackDecoded(bool success, LLImageRaw* raw, LLImageRaw* aux)
+void LLTextureFetchWorker::callbackDecoded(U32 request_id, bool success, LLImageRaw* raw, LLImageRaw* aux)
 {
 	LLMutexLock lock(&mWorkMutex);
 	if (mDecodeHandle == 0)
 	{
 		return; // aborted, ignore
 	}
+	if (mDecodeRequest != DECODE_REQUEST || request_id != mDecodeRequestID)
+	{
+		return; // a late one from an earlier request, mDecodeHandle isn't ours
+	}
 	if (mState != DECODE_IMAGE_UPDATE)
 	{
 // 		llwarns << "Decode callback for " << mID << " with state = " << mState << llendl;
@@ -1668,6 +1797,34 @@ void LLTextureFetchWorker::callbackDecoded(bool success, LLImageRaw* raw, LLImag
 	setPriority(LLWorkerThread::PRIORITY_HIGH | mWorkPriority);
 }
 
+void LLTextureFetchWorker::callbackCompressed(U32 request_id, bool success, LLImageDXT* compressed)
+{
+	LLMutexLock lock(&mWorkMutex);
+	if (mDecodeHandle == 0)
+	{
+		return; // aborted, ignore
+	}
+	if (mDecodeRequest != COMPRESS_REQUEST || request_id != mDecodeRequestID)
+	{
+		return; // a late one from an earlier request, mDecodeHandle isn't ours
+	}
+	if (mState != COMPRESS_IMAGE_UPDATE)
+	{
+		mDecodeHandle = 0;
+		return;
+	}
+
+	mDecodeHandle = 0;
+	if (success)
+	{
+		mCompressedImage = compressed;
+		LL_DEBUGS("Texture") << mID << ": Compressed. Bytes: " << compressed->getDataSize() << LL_ENDL;
+	}
+	// On failure the raw image is still good: it just goes up uncompressed
+	mCompressed = TRUE;
+	setPriority(LLWorkerThread::PRIORITY_HIGH | mWorkPriority);
+}
+
 //////////////////////////////////////////////////////////////////////////////
 
 bool LLTextureFetchWorker::writeToCacheComplete()
@@ -1697,7 +1854,7 @@ bool LLTextureFetchWorker::writeToCacheComplete()
 // public
 
 LLTextureFetch::LLTextureFetch(LLTextureCache* cache, LLImageDecodeThread* imagedecodethread, bool threaded, bool qa_mode)
-	: LLWorkerThread("TextureFetch", threaded),
+	: LLWorkerThread("TextureFetch", threaded, 0), // own thread: mCurlGetRequest is bound to the thread that creates it
 	  mDebugCount(0),
 	  mDebugPause(FALSE),
 	  mPacketCount(0),
@@ -1710,6 +1867,10 @@ LLTextureFetch::LLTextureFetch(LLTextureCache* cache, LLImageDecodeThread* image
 	  mCurlGetRequest(NULL)
 {
 	mMaxBandwidth = gSavedSettings.getF32("ThrottleBandwidthKBPS");
+	mHTTPThrottle.setLimits(clamp_http_window(gSavedSettings.getU32("HTTPMinRequests")),
+							clamp_http_window(llmax(gSavedSettings.getU32("HTTPAdaptiveMaxRequests"), gSavedSettings.getU32("HTTPMaxRequests"))),
+							clamp_http_window(gSavedSettings.getU32("HTTPMaxRequests")));
+	mHTTPThrottle.setAdaptive(gSavedSettings.getBOOL("HTTPAdaptiveRequests"));
 	mTextureInfo.setUpLogging(gSavedSettings.getBOOL("LogTextureDownloadsToViewerLog"), gSavedSettings.getBOOL("LogTextureDownloadsToSimulator"), gSavedSettings.getU32("TextureLoggingThreshold"));
 }
 
@@ -1721,7 +1882,8 @@ LLTextureFetch::~LLTextureFetch()
 }
 
 bool LLTextureFetch::createRequest(const std::string& url, const LLUUID& id, const LLHost& host, F32 priority,
-								   S32 w, S32 h, S32 c, S32 desired_discard, bool needs_aux, bool can_use_http)
+								   S32 w, S32 h, S32 c, S32 desired_discard, bool needs_aux, bool can_use_http,
+								   bool compress)
 {
 	if (mDebugPause)
 	{
@@ -1781,6 +1943,7 @@ bool LLTextureFetch::createRequest(const std::string& url, const LLUUID& id, con
 		worker->lockWorkMutex();
 		worker->mActiveCount++;
 		worker->mNeedsAux = needs_aux;
+		worker->mCompress = compress;
 		worker->setImagePriority(priority);
 		worker->setDesiredDiscard(desired_discard, desired_size);
 		worker->setCanUseHTTP(can_use_http) ;
@@ -1805,6 +1968,7 @@ bool LLTextureFetch::createRequest(const std::string& url, const LLUUID& id, con
 		worker->lockWorkMutex();
 		worker->mActiveCount++;
 		worker->mNeedsAux = needs_aux;
+		worker->mCompress = compress;
 		worker->setCanUseHTTP(can_use_http) ;
 		worker->unlockWorkMutex();
 	}
@@ -1849,6 +2013,7 @@ void LLTextureFetch::addToHTTPQueue(const LLUUID& id)
 	LLMutexLock lock(&mNetworkQueueMutex);
 	mHTTPTextureQueue.insert(id);
 	mTotalHTTPRequests++;
+	mHTTPThrottle.noteInFlight(mHTTPTextureQueue.size());
 }
 
 void LLTextureFetch::removeFromHTTPQueue(const LLUUID& id, S32 received_size)
@@ -1858,6 +2023,16 @@ void LLTextureFetch::removeFromHTTPQueue(const LLUUID& id, S32 received_size)
 	mHTTPTextureBits += received_size * 8; // Approximate - does not include header bits	
 }
 
+void LLTextureFetch::recordHTTPResult(U64 start_time, S32 received_size, U32 status)
+{
+	// Only failures that mean the path or server is overloaded count
+	// against the window; a missing texture is not congestion.
+	bool congested = (status == HTTP_INTERNAL_ERROR || status >= HTTP_INTERNAL_SERVER_ERROR);
+	F64 rtt = (F64)(LLTimer::getTotalTime() - start_time) / 1000000.0;
+	LLMutexLock lock(&mNetworkQueueMutex);
+	mHTTPThrottle.recordResult(rtt, received_size, congested);
+}
+
 void LLTextureFetch::deleteRequest(const LLUUID& id, bool cancel)
 {
 	lockQueue() ;
@@ -1920,6 +2095,24 @@ U32 LLTextureFetch::getTotalNumHTTPRequests()
 	return size ;
 }
 
+U32 LLTextureFetch::getHTTPWindow()
+{
+	LLMutexLock lock(&mNetworkQueueMutex);
+	return mHTTPThrottle.getWindow();
+}
+
+S32 LLTextureFetch::getHTTPRangeSize()
+{
+	LLMutexLock lock(&mNetworkQueueMutex);
+	return mHTTPThrottle.getRangeSize();
+}
+
+LLTextureFetchThrottle LLTextureFetch::getHTTPThrottle()
+{
+	LLMutexLock lock(&mNetworkQueueMutex);
+	return mHTTPThrottle;
+}
+
 // call lockQueue() first!
 LLTextureFetchWorker* LLTextureFetch::getWorkerAfterLock(const LLUUID& id)
 {
@@ -1941,7 +2134,8 @@ LLTextureFetchWorker* LLTextureFetch::getWorker(const LLUUID& id)
 
 
 bool LLTextureFetch::getRequestFinished(const LLUUID& id, S32& discard_level,
-										LLPointer<LLImageRaw>& raw, LLPointer<LLImageRaw>& aux)
+										LLPointer<LLImageRaw>& raw, LLPointer<LLImageRaw>& aux,
+										LLPointer<LLImageDXT>& compressed)
 {
 	bool res = false;
 	LLTextureFetchWorker* worker = getWorker(id);
@@ -1966,6 +2160,7 @@ bool LLTextureFetch::getRequestFinished(const LLUUID& id, S32& discard_level,
 			discard_level = worker->mDecodedDiscard;
 			raw = worker->mRawImage;
 			aux = worker->mAuxImage;
+			compressed = worker->mCompressedImage;
 			res = true;
 			LL_DEBUGS("Texture") << id << ": Request Finished. State: " << worker->mState << " Discard: " << discard_level << LL_ENDL;
 			worker->unlockWorkMutex();
@@ -1981,6 +2176,7 @@ bool LLTextureFetch::getRequestFinished(const LLUUID& id, S32& discard_level,
 				discard_level = worker->mDecodedDiscard;
 				raw = worker->mRawImage;
 				aux = worker->mAuxImage;
+				compressed = worker->mCompressedImage;
 			}
 			worker->unlockWorkMutex();
 		}
@@ -2066,6 +2262,23 @@ S32 LLTextureFetch::update(U32 max_time_ms)
 		gTextureList.sTextureBits += mHTTPTextureBits;
 		mHTTPTextureBits = 0 ;
 
+		static const LLCachedControl<bool> adaptive_http_requests("HTTPAdaptiveRequests", true);
+		static const LLCachedControl<U32> max_http_requests("HTTPMaxRequests", 32);
+		static const LLCachedControl<U32> min_http_requests("HTTPMinRequests", 2);
+		static const LLCachedControl<U32> adaptive_max_http_requests("HTTPAdaptiveMaxRequests", 64);
+		U32 fixed_window = clamp_http_window(max_http_requests);
+		U32 min_window = llmax(clamp_http_window(min_http_requests), (U32)1);
+		U32 max_window = clamp_http_window(llmax((U32)adaptive_max_http_requests, (U32)max_http_requests, min_window));
+		if (mHTTPThrottle.getFixedWindow() != fixed_window ||
+			mHTTPThrottle.getMinWindow() != min_window ||
+			mHTTPThrottle.getMaxWindow() != max_window)
+		{
+			mHTTPThrottle.setLimits(min_window, max_window, fixed_window);
+		}
+		mHTTPThrottle.setAdaptive(adaptive_http_requests);
+		mHTTPThrottle.noteInFlight(mHTTPTextureQueue.size());
+		mHTTPThrottle.update(LLTimer::getTotalSeconds());
+
 		mNetworkQueueMutex.unlock() ;
 	}
 	
@@ -2108,7 +2321,7 @@ void LLTextureFetch::shutDownImageDecodeThread()
 void LLTextureFetch::startThread()
 {
 	// Construct mCurlGetRequest from Worker Thread
-	mCurlGetRequest = new LLCurlRequest();
+	mCurlGetRequest = new LLCurlRequest(LLCurl::PRIORITY_TEXTURE);
 }
 
 // WORKER THREAD
@@ -39,8 +39,10 @@
 #include "llworkerthread.h"
 #include "llcurl.h"
 #include "lltextureinfo.h"
+#include "lltexturefetchthrottle.h"
 #include "llapr.h"
 
+class LLImageDXT;
 class LLViewerTexture;
 class LLTextureFetchWorker;
 class HTTPGetResponder;
@@ -66,10 +68,13 @@ public:
 	void shutDownImageDecodeThread() ;  //called in the main thread after the ImageDecodeThread shuts down.
 
 	bool createRequest(const std::string& url, const LLUUID& id, const LLHost& host, F32 priority,
-					   S32 w, S32 h, S32 c, S32 discard, bool needs_aux, bool can_use_http);
+					   S32 w, S32 h, S32 c, S32 discard, bool needs_aux, bool can_use_http,
+					   bool compress = false);
 	void deleteRequest(const LLUUID& id, bool cancel);
+	// compressed is the DXT copy of raw when the request asked for compression and it succeeded
 	bool getRequestFinished(const LLUUID& id, S32& discard_level,
-							LLPointer<LLImageRaw>& raw, LLPointer<LLImageRaw>& aux);
+							LLPointer<LLImageRaw>& raw, LLPointer<LLImageRaw>& aux,
+							LLPointer<LLImageDXT>& compressed);
 	bool updateRequestPriority(const LLUUID& id, F32 priority);
 
 	bool receiveImageHeader(const LLHost& host, const LLUUID& id, U8 codec, U16 packets, U32 totalbytes, U16 data_size, U8* data);
@@ -86,6 +91,10 @@ public:
 	S32 getNumRequests();
 	S32 getNumHTTPRequests();
 	U32 getTotalNumHTTPRequests();	
+	// Congestion window and range floor for HTTP requests, see LLTextureFetchThrottle
+	U32 getHTTPWindow();
+	S32 getHTTPRangeSize();
+	LLTextureFetchThrottle getHTTPThrottle();
 	// Public for access by callbacks
     S32 getPending();
 	void lockQueue() { mQueueMutex.lock();
@@ -102,6 +111,7 @@ protected:
 	void removeFromNetworkQueue(LLTextureFetchWorker* worker, bool cancel);
 	void addToHTTPQueue(const LLUUID& id);
 	void removeFromHTTPQueue(const LLUUID& id, S32 received_size = 0);
+	void recordHTTPResult(U64 start_time, S32 received_size, U32 status);
 	void removeRequest(LLTextureFetchWorker* worker, bool cancel);
 
 	// Overrides from the LLThread tree
@@ -124,7 +134,7 @@ public:
 	
 private:
 	LLMutex mQueueMutex;        //to protect mRequestMap only
-	LLMutex mNetworkQueueMutex; //to protect mNetworkQueue, mHTTPTextureQueue and mCancelQueue.
+	LLMutex mNetworkQueueMutex; //to protect mNetworkQueue, mHTTPTextureQueue, mCancelQueue and mHTTPThrottle.
 
 	LLTextureCache* mTextureCache;
 	LLImageDecodeThread* mImageDecodeThread;
@@ -145,6 +155,7 @@ private:
 	LLTextureInfo mTextureInfo;
 
 	U32 mHTTPTextureBits;
+	LLTextureFetchThrottle mHTTPThrottle;
 
 	//debug use
 	U32 mTotalHTTPRequests ;
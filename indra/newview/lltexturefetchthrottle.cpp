@@ -0,0 +1,253 @@
+/** 
+ * @file lltexturefetchthrottle.cpp
+ * @brief Congestion controller for HTTP texture fetches.
+ *
+ * $LicenseInfo:firstyear=2010&license=viewergpl$
+ * 
+ * Copyright (c) 2010, Linden Research, Inc.
+ * 
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ * 
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ * 
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ * 
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+
+#include "llviewerprecompiledheaders.h"
+
+#include "lltexturefetchthrottle.h"
+
+const F64 LLTextureFetchThrottle::INTERVAL_SECS = 1.0;
+const U32 LLTextureFetchThrottle::HISTORY_SIZE = 120;
+const S32 LLTextureFetchThrottle::MAX_RANGE_SIZE = 256 * 1024;
+
+// Fewer completions than this in an interval say nothing about errors.
+static const U32 MIN_ERROR_SAMPLES = 4;
+static const F32 MAX_ERROR_RATE = 0.1f;
+// A round trip this many times the base one means requests are queueing.
+static const F32 QUEUEING_RTT_FACTOR = 2.f;
+static const F32 QUEUEING_DECREASE = 0.9f;
+static const F32 ERROR_DECREASE = 0.5f;
+static const F32 ADDITIVE_INCREASE = 2.f;
+// Slow start keeps doubling only while each doubling buys this much more.
+static const F32 SLOW_START_GAIN = 1.1f;
+// Congestion avoidance grows unless throughput fell below this fraction.
+static const F32 THROUGHPUT_DROP = 0.75f;
+static const F32 RTT_SMOOTHING = 0.125f;
+static const F32 BASE_RTT_DRIFT = 0.005f;
+// Smallest step of range growth once the window is at its ceiling.
+static const S32 MIN_EXTRA_RANGE = 16 * 1024;
+
+LLTextureFetchThrottle::LLTextureFetchThrottle()
+	: mAdaptive(true),
+	  mSlowStart(true),
+	  mMinWindow(1),
+	  mMaxWindow(1),
+	  mFixedWindow(1),
+	  mWindow(1),
+	  mWindowF(1.f),
+	  mIntervalStart(-1.0),
+	  mIntervalCompleted(0),
+	  mIntervalErrors(0),
+	  mIntervalBytes(0),
+	  mIntervalPeakInFlight(0),
+	  mKBPS(0.f),
+	  mBestKBPS(0.f),
+	  mSmoothedRTT(0.f),
+	  mBaseRTT(0.f),
+	  mErrorRate(0.f),
+	  mExtraRange(0)
+{
+}
+
+void LLTextureFetchThrottle::setLimits(U32 min_requests, U32 max_requests, U32 fixed_requests)
+{
+	mMinWindow = llmax(min_requests, (U32)1);
+	mMaxWindow = llmax(max_requests, mMinWindow);
+	mFixedWindow = fixed_requests;
+	restart();
+}
+
+void LLTextureFetchThrottle::setAdaptive(bool adaptive)
+{
+	if (adaptive != mAdaptive)
+	{
+		mAdaptive = adaptive;
+		restart();
+	}
+}
+
+void LLTextureFetchThrottle::restart()
+{
+	mWindowF = mAdaptive ? (F32)mMinWindow : (F32)llclamp(mFixedWindow, mMinWindow, mMaxWindow);
+	mWindow = (U32)mWindowF;
+	mSlowStart = true;
+	mBestKBPS = 0.f;
+	mExtraRange = 0;
+}
+
+void LLTextureFetchThrottle::recordResult(F64 rtt, S32 bytes, bool error)
+{
+	mIntervalCompleted++;
+	if (error)
+	{
+		// Timeouts and refusals say nothing useful about the path delay
+		mIntervalErrors++;
+		return;
+	}
+	mIntervalBytes += llmax(bytes, 0);
+	F32 sample = (F32)llmax(rtt, 0.0);
+	if (mSmoothedRTT <= 0.f)
+	{
+		mSmoothedRTT = sample;
+	}
+	else
+	{
+		mSmoothedRTT += (sample - mSmoothedRTT) * RTT_SMOOTHING;
+	}
+	if (mBaseRTT <= 0.f || sample < mBaseRTT)
+	{
+		mBaseRTT = sample;
+	}
+}
+
+void LLTextureFetchThrottle::noteInFlight(U32 in_flight)
+{
+	mIntervalPeakInFlight = llmax(mIntervalPeakInFlight, in_flight);
+}
+
+void LLTextureFetchThrottle::update(F64 now)
+{
+	if (mIntervalStart < 0.0)
+	{
+		mIntervalStart = now;
+		return;
+	}
+	F64 elapsed = now - mIntervalStart;
+	if (elapsed < INTERVAL_SECS)
+	{
+		return;
+	}
+
+	F32 kbps = (F32)(mIntervalBytes / 1024.0 / elapsed);
+	mErrorRate = mIntervalCompleted ? (F32)mIntervalErrors / (F32)mIntervalCompleted : 0.f;
+	bool window_limited = mIntervalPeakInFlight >= mWindow;
+
+	if (mAdaptive)
+	{
+		adjustWindow(mIntervalCompleted, window_limited, kbps);
+	}
+	mKBPS = kbps;
+
+	if (mIntervalCompleted > mIntervalErrors && mSmoothedRTT > mBaseRTT)
+	{
+		// Let the base follow a path that really got slower
+		mBaseRTT += (mSmoothedRTT - mBaseRTT) * BASE_RTT_DRIFT;
+	}
+
+	Sample sample;
+	sample.mTime = now;
+	sample.mWindow = mWindow;
+	sample.mKBPS = mKBPS;
+	sample.mRTT = mSmoothedRTT;
+	sample.mErrorRate = mErrorRate;
+	mHistory.push_back(sample);
+	while (mHistory.size() > HISTORY_SIZE)
+	{
+		mHistory.pop_front();
+	}
+
+	mIntervalStart = now;
+	mIntervalCompleted = 0;
+	mIntervalErrors = 0;
+	mIntervalBytes = 0;
+	// Requests still in flight carry over into the next interval
+	mIntervalPeakInFlight = 0;
+}
+
+void LLTextureFetchThrottle::adjustWindow(U32 completed, bool window_limited, F32 kbps)
+{
+	if (completed >= MIN_ERROR_SAMPLES && mErrorRate > MAX_ERROR_RATE)
+	{
+		mWindowF *= ERROR_DECREASE;
+		mExtraRange /= 2;
+		mSlowStart = false;
+	}
+	else if (completed > 0 && mBaseRTT > 0.f && mSmoothedRTT > mBaseRTT * QUEUEING_RTT_FACTOR)
+	{
+		mWindowF *= QUEUEING_DECREASE;
+		mExtraRange /= 2;
+		mSlowStart = false;
+	}
+	else if (window_limited && mWindow >= mMaxWindow)
+	{
+		// Out of requests but not of link: make each one carry more
+		mSlowStart = false;
+		mExtraRange = llclamp(mExtraRange * 2, MIN_EXTRA_RANGE, MAX_RANGE_SIZE);
+	}
+	else if (window_limited)
+	{
+		if (mSlowStart)
+		{
+			if (mBestKBPS <= 0.f || kbps > mBestKBPS * SLOW_START_GAIN)
+			{
+				mBestKBPS = kbps;
+				mWindowF *= 2.f;
+			}
+			else
+			{
+				mSlowStart = false;
+				mWindowF += ADDITIVE_INCREASE;
+			}
+		}
+		else if (kbps >= mKBPS * THROUGHPUT_DROP)
+		{
+			mWindowF += ADDITIVE_INCREASE;
+		}
+	}
+	mWindowF = llclamp(mWindowF, (F32)mMinWindow, (F32)mMaxWindow);
+	mWindow = (U32)mWindowF;
+	if (mExtraRange < MIN_EXTRA_RANGE)
+	{
+		mExtraRange = 0;
+	}
+}
+
+S32 LLTextureFetchThrottle::getRangeSize() const
+{
+	if (!mAdaptive || mBaseRTT <= 0.f || mWindow == 0)
+	{
+		return 0;
+	}
+	F32 bytes = mKBPS * 1024.f * mBaseRTT / (F32)mWindow;
+	return llclamp(llmax((S32)bytes, mExtraRange), 0, MAX_RANGE_SIZE);
+}
+
+std::string LLTextureFetchThrottle::getStateString() const
+{
+	return llformat("Win:%d%s %.0fKB/s RTT:%.0f/%.0fms Err:%.0f%% Rng:%dK",
+					mWindow,
+					!mAdaptive ? "(fixed)" : mSlowStart ? "(ss)" : "",
+					mKBPS,
+					mSmoothedRTT * 1000.f, mBaseRTT * 1000.f,
+					mErrorRate * 100.f,
+					getRangeSize() / 1024);
+}
@@ -0,0 +1,134 @@
+/** 
+ * @file lltexturefetchthrottle.h
+ * @brief Congestion controller for HTTP texture fetches.
+ *
+ * $LicenseInfo:firstyear=2010&license=viewergpl$
+ * 
+ * Copyright (c) 2010, Linden Research, Inc.
+ * 
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ * 
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ * 
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ * 
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+
+#ifndef LL_LLTEXTUREFETCHTHROTTLE_H
+#define LL_LLTEXTUREFETCHTHROTTLE_H
+
+#include <deque>
+#include <string>
+
+// Decides how many HTTP texture requests may be in flight at once, and
+// how large a partial range request should be, from the throughput,
+// round trip time and error rate of the requests that completed.
+//
+// The window opens exponentially (slow start) until throughput stops
+// improving, then grows additively while the fetcher keeps it full;
+// at its ceiling the range size grows instead.
+// An interval with too many errors halves it; a queue building up on
+// the path (round trip time well above the best seen) shrinks it gently.
+//
+// The class holds no locks and reads no clock: the owner serializes the
+// calls and passes the time in, so it can be driven by a simulation.
+class LLTextureFetchThrottle
+{
+public:
+	// One measurement interval, kept for the texture console graph.
+	struct Sample
+	{
+		F64 mTime;
+		U32 mWindow;
+		F32 mKBPS;
+		F32 mRTT;			// seconds, smoothed
+		F32 mErrorRate;		// 0..1
+	};
+	typedef std::deque<Sample> history_t;
+
+	LLTextureFetchThrottle();
+
+	// min/max bound the window; slow start begins at the minimum, so the
+	// base round trip is measured before the path is loaded.
+	void setLimits(U32 min_requests, U32 max_requests, U32 fixed_requests);
+	// When not adaptive the window stays at fixed_requests and no
+	// range floor is applied, but statistics are still collected.
+	// Either call restarts the window.
+	void setAdaptive(bool adaptive);
+	bool getAdaptive() const { return mAdaptive; }
+
+	// A request finished after rtt seconds with bytes of payload.
+	void recordResult(F64 rtt, S32 bytes, bool error);
+	// Number of requests currently in flight.
+	void noteInFlight(U32 in_flight);
+	// Closes the current interval once it is old enough. Call often.
+	void update(F64 now);
+
+	U32 getWindow() const { return mWindow; }
+	U32 getMinWindow() const { return mMinWindow; }
+	U32 getMaxWindow() const { return mMaxWindow; }
+	U32 getFixedWindow() const { return mFixedWindow; }
+	// Smallest byte range worth asking for when a partial fetch is made:
+	// this request's share of what the link delivers in one round trip,
+	// or more once the window has hit its ceiling with room to spare.
+	S32 getRangeSize() const;
+
+	F32 getKBPS() const { return mKBPS; }
+	F32 getSmoothedRTT() const { return mSmoothedRTT; }
+	F32 getBaseRTT() const { return mBaseRTT; }
+	F32 getErrorRate() const { return mErrorRate; }
+	bool inSlowStart() const { return mSlowStart; }
+	const history_t& getHistory() const { return mHistory; }
+	std::string getStateString() const;
+
+	static const F64 INTERVAL_SECS;
+	static const U32 HISTORY_SIZE;
+	static const S32 MAX_RANGE_SIZE;
+
+private:
+	void restart();
+	void adjustWindow(U32 completed, bool window_limited, F32 kbps);
+
+private:
+	bool mAdaptive;
+	bool mSlowStart;
+	U32 mMinWindow;
+	U32 mMaxWindow;
+	U32 mFixedWindow;
+	U32 mWindow;
+	F32 mWindowF;			// fractional window, for additive growth and gentle decrease
+
+	F64 mIntervalStart;
+	U32 mIntervalCompleted;
+	U32 mIntervalErrors;
+	S32 mIntervalBytes;
+	U32 mIntervalPeakInFlight;
+
+	F32 mKBPS;				// throughput of the last interval
+	F32 mBestKBPS;			// throughput when slow start last doubled
+	F32 mSmoothedRTT;
+	F32 mBaseRTT;			// lowest round trip seen, drifts up slowly
+	F32 mErrorRate;
+	S32 mExtraRange;		// grown while the window is pinned at mMaxWindow
+
+	history_t mHistory;
+};
+
+#endif // LL_LLTEXTUREFETCHTHROTTLE_H
@@ -230,10 +230,12 @@ void LLTextureBar::draw()
 		{ "HTP", LLColor4::green },	// WAIT_HTTP_REQ
 		{ "DEC", LLColor4::yellow },// DECODE_IMAGE
 		{ "DEC", LLColor4::green }, // DECODE_IMAGE_UPDATE
+		{ "DXT", LLColor4::yellow },// COMPRESS_IMAGE
+		{ "DXT", LLColor4::green }, // COMPRESS_IMAGE_UPDATE
 		{ "WRT", LLColor4::purple },// WRITE_TO_CACHE
 		{ "WRT", LLColor4::orange },// WAIT_ON_WRITE
 		{ "END", LLColor4::red },   // DONE
-#define LAST_STATE 12
+#define LAST_STATE 14
 		{ "CRE", LLColor4::magenta }, // LAST_STATE+1
 		{ "FUL", LLColor4::green }, // LAST_STATE+2
 		{ "BAD", LLColor4::red }, // LAST_STATE+3
@@ -389,7 +391,7 @@ public:
 		  mTextureView(texview)
 	{
 		S32 line_height = (S32)(LLFontGL::getFontMonospace()->getLineHeight() + .5f);
-		setRect(LLRect(0,0,100,line_height * 4));
+		setRect(LLRect(0,0,100,line_height * 5));
 	}
 
 	virtual void draw();	
@@ -434,7 +436,7 @@ void LLGLTexMemBar::draw()
 					cache_usage, cache_max_usage, total_texture_downloaded, total_object_downloaded);
 	//, cache_entries, cache_max_entries
 
-	LLFontGL::getFontMonospace()->renderUTF8(text, 0, 0, line_height*3,
+	LLFontGL::getFontMonospace()->renderUTF8(text, 0, 0, line_height*4,
 											 text_color, LLFontGL::LEFT, LLFontGL::TOP);
 
 	//----------------------------------------------------------------------------
@@ -512,7 +514,7 @@ void LLGLTexMemBar::draw()
 					LLAppViewer::getImageDecodeThread()->getPending(), 
 					gTextureList.mCreateTextureList.size());
 
-	LLFontGL::getFontMonospace()->renderUTF8(text, 0, 0, line_height*2,
+	LLFontGL::getFontMonospace()->renderUTF8(text, 0, 0, line_height*3,
 									 text_color, LLFontGL::LEFT, LLFontGL::TOP);
 
 	left += LLFontGL::getFontMonospace()->getWidth(text);
@@ -521,8 +523,41 @@ void LLGLTexMemBar::draw()
 	color = bandwidth > max_bandwidth ? LLColor4::red : bandwidth > max_bandwidth*.75f ? LLColor4::yellow : text_color;
 	color[VALPHA] = text_color[VALPHA];
 	text = llformat("BW:%.0f/%.0f",bandwidth, max_bandwidth);
-	LLFontGL::getFontMonospace()->renderUTF8(text, 0, left, line_height*2,
+	LLFontGL::getFontMonospace()->renderUTF8(text, 0, left, line_height*3,
 											 color, LLFontGL::LEFT, LLFontGL::TOP);
+
+	//----------------------------------------------------------------------------
+	// HTTP congestion window, with its recent history as a bar graph:
+	// bar height is the window, colour goes from green to red with errors.
+
+	LLTextureFetchThrottle throttle = LLAppViewer::getTextureFetch()->getHTTPThrottle();
+	text = "HTTP " + throttle.getStateString();
+	LLFontGL::getFontMonospace()->renderUTF8(text, 0, 0, line_height*2,
+											 text_color, LLFontGL::LEFT, LLFontGL::TOP);
+
+	const LLTextureFetchThrottle::history_t& history = throttle.getHistory();
+	if (!history.empty())
+	{
+		S32 graph_left = LLFontGL::getFontMonospace()->getWidth(text) + 8;
+		S32 graph_bottom = line_height + 2;
+		S32 graph_height = line_height - 2;
+		S32 graph_width = (S32)LLTextureFetchThrottle::HISTORY_SIZE * 2;
+		F32 scale = (F32)graph_height / (F32)llmax(throttle.getMaxWindow(), (U32)1);
+
+		gGL.getTexUnit(0)->unbind(LLTexUnit::TT_TEXTURE);
+		gGL.color4f(0.5f, 0.5f, 0.5f, 0.25f);
+		gl_rect_2d(graph_left, graph_bottom + graph_height, graph_left + graph_width, graph_bottom);
+
+		S32 x = graph_left + graph_width - (S32)history.size() * 2;
+		for (LLTextureFetchThrottle::history_t::const_iterator iter = history.begin();
+			 iter != history.end(); ++iter, x += 2)
+		{
+			F32 err = llclamp(iter->mErrorRate * 5.f, 0.f, 1.f);
+			gGL.color4f(err, 1.f - err, 0.f, 0.75f);
+			S32 top = graph_bottom + llmax(llround(iter->mWindow * scale), 1);
+			gl_rect_2d(x, top, x + 2, graph_bottom);
+		}
+	}
 	
 	S32 dx1 = 0;
 	if (LLAppViewer::getTextureFetch()->mDebugPause)
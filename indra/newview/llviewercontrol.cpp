@@ -64,6 +64,7 @@
 #include "llviewerjoystick.h"
 #include "llviewerparcelmedia.h"
 #include "llviewerobjectlist.h"
+#include "llviewerpacketreplay.h"
 #include "llviewerparcelmgr.h"
 #include "llparcel.h"
 #include "llnotify.h"
@@ -127,6 +128,32 @@ bool handleStateMachineMaxTimeChanged(const LLSD& newvalue)
 	return true;
 }
 
+static bool handleFastTimerTraceChanged(const LLSD& newvalue)
+{
+	if (newvalue.asBoolean())
+	{
+		LLFastTimer::startTracing();
+	}
+	else
+	{
+		LLFastTimer::stopTracing();
+	}
+	return true;
+}
+
+static bool handlePacketCaptureChanged(const LLSD& newvalue)
+{
+	if (newvalue.asBoolean())
+	{
+		LLViewerPacketReplay::startCapture();
+	}
+	else
+	{
+		LLViewerPacketReplay::stopCapture();
+	}
+	return true;
+}
+
 static bool handleSetShaderChanged(const LLSD& newvalue)
 {
 	// changing shader level may invalidate existing cached bump maps, as the shader type determines the format of the bump map it expects - clear and repopulate the bump cache
@@ -757,6 +784,9 @@ void settings_setup_listeners()
 	gSavedSettings.getControl("LipSyncEnabled")->getSignal()->connect(boost::bind(&handleVoiceClientPrefsChanged, _2));	
 	gSavedSettings.getControl("TranslateChat")->getSignal()->connect(boost::bind(&handleTranslateChatPrefsChanged, _2));
 	gSavedSettings.getControl("StateMachineMaxTime")->getSignal()->connect(boost::bind(&handleStateMachineMaxTimeChanged, _2));
+	gSavedSettings.getControl("FastTimerTrace")->getSignal()->connect(boost::bind(&handleFastTimerTraceChanged, _2));
+	handleFastTimerTraceChanged(gSavedSettings.getBOOL("FastTimerTrace"));
+	gSavedSettings.getControl("PacketCapture")->getSignal()->connect(boost::bind(&handlePacketCaptureChanged, _2));
 
 	gSavedSettings.getControl("CloudsEnabled")->getSignal()->connect(boost::bind(&handleCloudSettingsChanged, _2));
 	gSavedSettings.getControl("SkyUseClassicClouds")->getSignal()->connect(boost::bind(&handleCloudSettingsChanged, _2));
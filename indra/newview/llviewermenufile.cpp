@@ -41,6 +41,8 @@
 #include "llimagejpeg.h"
 #include "llimagepng.h"
 #include "llimagebmp.h"
+#include "llimagej2c.h"
+#include "llimageworker.h"
 
 #include "statemachine/aifilepicker.h"
 #include "llfloateranimpreview.h"
@@ -617,6 +619,76 @@ static void handle_compress_image_continued(AIFilePicker* filepicker)
 	}
 }
 
+// Finishes an image upload once its JPEG2000 encode is done: saves the
+// codestream next to the temp file and uploads it from there.
+class LLUploadEncodeResponder : public LLImageEncodeThread::Responder
+{
+public:
+	LLUploadEncodeResponder(const std::string& src_filename, const std::string& j2c_filename,
+							const std::string& name, const std::string& desc, S32 compression_info,
+							LLFolderType::EType destination_folder_type,
+							LLInventoryType::EType inv_type,
+							U32 next_owner_perms, U32 group_perms, U32 everyone_perms,
+							const std::string& display_name,
+							LLAssetStorage::LLStoreAssetCallback callback,
+							S32 expected_upload_cost, void* userdata)
+		: mSrcFilename(src_filename), mJ2CFilename(j2c_filename),
+		  mName(name), mDesc(desc), mCompressionInfo(compression_info),
+		  mDestinationFolderType(destination_folder_type), mInvType(inv_type),
+		  mNextOwnerPerms(next_owner_perms), mGroupPerms(group_perms), mEveryonePerms(everyone_perms),
+		  mDisplayName(display_name), mCallback(callback),
+		  mExpectedUploadCost(expected_upload_cost), mUserData(userdata)
+	{
+	}
+
+	/*virtual*/ void completed(bool success, LLImageFormatted* formatted, LLImageRaw* decoded)
+	{
+		LLSD args;
+		args["FILE"] = mSrcFilename;
+		if (!success || !formatted || !formatted->save(mJ2CFilename))
+		{
+			args["ERROR"] = "Couldn't create output file " + mJ2CFilename;
+			upload_error(llformat("Problem with file %s", mSrcFilename.c_str()), "ProblemWithFile", mJ2CFilename, args);
+			return;
+		}
+
+		// test to see if the encode and save worked.
+		LLPointer<LLImageJ2C> integrity_test = new LLImageJ2C;
+		if (!integrity_test->loadAndValidate(mJ2CFilename))
+		{
+			args["ERROR"] = LLImage::getLastError();
+			upload_error(llformat("Image %s is corrupt", mJ2CFilename.c_str()), "ProblemWithFile", mJ2CFilename, args);
+			return;
+		}
+
+		upload_new_resource(mJ2CFilename, mName, mDesc, mCompressionInfo, mDestinationFolderType, mInvType,
+							mNextOwnerPerms, mGroupPerms, mEveryonePerms, mDisplayName,
+							mCallback, mExpectedUploadCost, mUserData);
+
+		// The data is in the VFS now.
+		if (LLFile::remove(mJ2CFilename) == -1)
+		{
+			lldebugs << "unable to remove temp file" << llendl;
+		}
+	}
+
+private:
+	std::string mSrcFilename;
+	std::string mJ2CFilename;
+	std::string mName;
+	std::string mDesc;
+	S32 mCompressionInfo;
+	LLFolderType::EType mDestinationFolderType;
+	LLInventoryType::EType mInvType;
+	U32 mNextOwnerPerms;
+	U32 mGroupPerms;
+	U32 mEveryonePerms;
+	std::string mDisplayName;
+	LLAssetStorage::LLStoreAssetCallback mCallback;
+	S32 mExpectedUploadCost;
+	void* mUserData;
+};
+
 void upload_new_resource(const std::string& src_filename, std::string name,
 			 std::string desc, S32 compression_info,
 			 LLFolderType::EType destination_folder_type,
@@ -654,27 +726,14 @@ void upload_new_resource(const std::string& src_filename, std::string name,
  		upload_error(error_message, "NofileExtension", filename, args);
 		return;
 	}
-	else if( exten == "bmp")
+	else if (exten == "bmp" || exten == "tga" || exten == "jpg" || exten == "jpeg" || exten == "png")
 	{
-		asset_type = LLAssetType::AT_TEXTURE;
-		if (!LLViewerTextureList::createUploadFile(src_filename,
-												 filename,
-												 IMG_CODEC_BMP ))
-		{
-			error_message = llformat( "Problem with file %s:\n\n%s\n",
-					src_filename.c_str(), LLImage::getLastError().c_str());
-			args["FILE"] = src_filename;
-			args["ERROR"] = LLImage::getLastError();
-			upload_error(error_message, "ProblemWithFile", filename, args);
-			return;
-		}
-	}
-	else if( exten == "tga")
-	{
-		asset_type = LLAssetType::AT_TEXTURE;
-		if (!LLViewerTextureList::createUploadFile(src_filename,
-												 filename,
-												 IMG_CODEC_TGA ))
+		// Decode here, so that errors in the file are reported right away, but
+		// leave the JPEG2000 encode to the image encode threads. The upload is
+		// resumed from the saved .j2c file by LLUploadEncodeResponder.
+		LLPointer<LLImageRaw> raw_image =
+			LLViewerTextureList::loadUploadImage(src_filename, LLImageBase::getCodecFromExtension(exten));
+		if (raw_image.isNull())
 		{
 			error_message = llformat("Problem with file %s:\n\n%s\n",
 					src_filename.c_str(), LLImage::getLastError().c_str());
@@ -683,37 +742,18 @@ void upload_new_resource(const std::string& src_filename, std::string name,
 			upload_error(error_message, "ProblemWithFile", filename, args);
 			return;
 		}
-	}
-	else if( exten == "jpg" || exten == "jpeg")
-	{
-		asset_type = LLAssetType::AT_TEXTURE;
-		if (!LLViewerTextureList::createUploadFile(src_filename,
-												 filename,
-												 IMG_CODEC_JPEG ))
+
+		LLPointer<LLUploadEncodeResponder> responder = new LLUploadEncodeResponder(src_filename, filename + ".j2c",
+			name, desc, compression_info, destination_folder_type, inv_type,
+			next_owner_perms, group_perms, everyone_perms, display_name,
+			callback, expected_upload_cost, userdata);
+		if (!LLViewerTextureList::convertToUploadFileAsync(raw_image, responder))
 		{
-			error_message = llformat("Problem with file %s:\n\n%s\n",
-					src_filename.c_str(), LLImage::getLastError().c_str());
-			args["FILE"] = src_filename;
-			args["ERROR"] = LLImage::getLastError();
-			upload_error(error_message, "ProblemWithFile", filename, args);
-			return;
+			// No encode threads; encode right here.
+			responder->completed(true, LLViewerTextureList::convertToUploadFile(raw_image), NULL);
 		}
+		return;
 	}
- 	else if( exten == "png")
- 	{
- 		asset_type = LLAssetType::AT_TEXTURE;
- 		if (!LLViewerTextureList::createUploadFile(src_filename,
- 												 filename,
- 												 IMG_CODEC_PNG ))
- 		{
- 			error_message = llformat("Problem with file %s:\n\n%s\n",
- 					src_filename.c_str(), LLImage::getLastError().c_str());
- 			args["FILE"] = src_filename;
- 			args["ERROR"] = LLImage::getLastError();
- 			upload_error(error_message, "ProblemWithFile", filename, args);
- 			return;
- 		}
- 	}
 	else if(exten == "wav")
 	{
 		asset_type = LLAssetType::AT_SOUND;  // tag it as audio
@@ -68,6 +68,7 @@
 #include "llfloaterproperties.h"
 #include "llfloatertools.h"
 #include "llfollowcam.h"
+#include "llnetmaptiles.h"
 #include "llselectmgr.h"
 #include "llrendersphere.h"
 #include "lltooldraganddrop.h"
@@ -208,7 +209,7 @@ LLViewerObject::LLViewerObject(const LLUUID &id, const LLPCode pcode, LLViewerRe
 	mDead(FALSE),
 	mOrphaned(FALSE),
 	mUserSelected(FALSE),
-	mOnActiveList(FALSE),
+	mActiveListIndex(-1),
 	mOnMap(FALSE),
 	mStatic(FALSE),
 	mNumFaces(0),
@@ -2933,6 +2934,10 @@ void LLViewerObject::setScale(const LLVector3 &scale, BOOL damped)
 				gObjectList.addToMap(this);
 				mOnMap = TRUE;
 			}
+			else
+			{
+				LLNetMapTiles::objectChanged(this);
+			}
 		}
 		else
 		{
@@ -3512,6 +3517,10 @@ void LLViewerObject::setPosition(const LLVector3 &pos, BOOL damped)
 	if (getPosition() != pos)
 	{
 		setChanged(TRANSLATED | SILHOUETTE);
+		if (mOnMap)
+		{
+			LLNetMapTiles::objectChanged(this);
+		}
 	}
 		
 	LLXform::setPosition(pos);
@@ -0,0 +1,158 @@
+/**
+ * @file llviewerobjectindex.cpp
+ * @brief Lookup tables used by the viewer object list
+ *
+ * $LicenseInfo:firstyear=2001&license=viewergpl$
+ *
+ * Copyright (c) 2001-2009, Linden Research, Inc.
+ *
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ *
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ *
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ *
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#include "llviewerprecompiledheaders.h"
+
+#include "llviewerobjectindex.h"
+
+#include "llstl.h"
+
+LLLocalIDTable::LLLocalIDTable()
+{
+}
+
+LLLocalIDTable::~LLLocalIDTable()
+{
+	clear();
+}
+
+const LLUUID& LLLocalIDTable::find(U32 region_index, U32 local_id) const
+{
+	if (region_index >= mRegions.size() || !mRegions[region_index])
+	{
+		return LLUUID::null;
+	}
+	const Region* regionp = mRegions[region_index];
+	U32 page = local_id >> PAGE_BITS;
+	if (page < MAX_PAGES)
+	{
+		if (page >= regionp->mPages.size() || !regionp->mPages[page])
+		{
+			return LLUUID::null;
+		}
+		return regionp->mPages[page]->mIDs[local_id & (PAGE_SIZE - 1)];
+	}
+	std::map<U32, LLUUID>::const_iterator iter = regionp->mOverflow.find(local_id);
+	return (iter != regionp->mOverflow.end()) ? iter->second : LLUUID::null;
+}
+
+void LLLocalIDTable::set(U32 region_index, U32 local_id, const LLUUID& id)
+{
+	if (id.isNull())
+	{
+		llwarns << "LLLocalIDTable::set called with a null id for local id " << local_id << llendl;
+		return;
+	}
+	if (region_index >= mRegions.size())
+	{
+		mRegions.resize(region_index + 1, NULL);
+	}
+	Region*& regionp = mRegions[region_index];
+	if (!regionp)
+	{
+		regionp = new Region;
+	}
+
+	U32 page = local_id >> PAGE_BITS;
+	if (page >= MAX_PAGES)
+	{
+		regionp->mOverflow[local_id] = id;
+		return;
+	}
+	if (page >= regionp->mPages.size())
+	{
+		regionp->mPages.resize(page + 1, NULL);
+	}
+	Page*& pagep = regionp->mPages[page];
+	if (!pagep)
+	{
+		pagep = new Page;
+	}
+	LLUUID& entry = pagep->mIDs[local_id & (PAGE_SIZE - 1)];
+	if (entry.isNull())
+	{
+		pagep->mCount++;
+	}
+	entry = id;
+}
+
+BOOL LLLocalIDTable::erase(U32 region_index, U32 local_id, const LLUUID& id)
+{
+	if (region_index >= mRegions.size() || !mRegions[region_index])
+	{
+		return FALSE;
+	}
+	Region* regionp = mRegions[region_index];
+	U32 page = local_id >> PAGE_BITS;
+	if (page >= MAX_PAGES)
+	{
+		std::map<U32, LLUUID>::iterator iter = regionp->mOverflow.find(local_id);
+		if (iter == regionp->mOverflow.end() || iter->second != id)
+		{
+			return FALSE;
+		}
+		regionp->mOverflow.erase(iter);
+		return TRUE;
+	}
+	if (page >= regionp->mPages.size() || !regionp->mPages[page])
+	{
+		return FALSE;
+	}
+	Page* pagep = regionp->mPages[page];
+	LLUUID& entry = pagep->mIDs[local_id & (PAGE_SIZE - 1)];
+	if (entry.isNull() || entry != id)
+	{
+		// Either there is no entry, or erasing it would zap a valid entry
+		return FALSE;
+	}
+	entry.setNull();
+	if (--pagep->mCount == 0)
+	{
+		delete pagep;
+		regionp->mPages[page] = NULL;
+	}
+	return TRUE;
+}
+
+void LLLocalIDTable::clear()
+{
+	for (region_list_t::iterator iter = mRegions.begin(); iter != mRegions.end(); ++iter)
+	{
+		Region* regionp = *iter;
+		if (regionp)
+		{
+			for_each(regionp->mPages.begin(), regionp->mPages.end(), DeletePointer());
+			delete regionp;
+		}
+	}
+	mRegions.clear();
+}
@@ -0,0 +1,244 @@
+/**
+ * @file llviewerobjectindex.h
+ * @brief Lookup tables used by the viewer object list
+ *
+ * $LicenseInfo:firstyear=2001&license=viewergpl$
+ *
+ * Copyright (c) 2001-2009, Linden Research, Inc.
+ *
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ *
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ *
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ *
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLVIEWEROBJECTINDEX_H
+#define LL_LLVIEWEROBJECTINDEX_H
+
+#include <map>
+#include <vector>
+
+#include "lluuid.h"
+
+//
+// Open addressed hash table from LLUUID to T.
+//
+// Object ids are random, so a cheap hash spreads them well and linear
+// probing keeps a lookup to one or two adjacent cache lines.  Erasing
+// shifts the following entries back instead of leaving tombstones, so
+// heavy churn (objects streaming in and out of view) does not slow
+// lookups down over time.
+//
+template <class T>
+class LLUUIDIndex
+{
+	struct Entry
+	{
+		Entry() : mUsed(FALSE), mValue() {}
+
+		LLUUID mID;
+		BOOL mUsed;
+		T mValue;
+	};
+
+public:
+	LLUUIDIndex() : mMask(0), mShift(32), mCount(0) {}
+
+	BOOL empty() const	{ return mCount == 0; }
+	S32 size() const	{ return mCount; }
+
+	T* find(const LLUUID& id)
+	{
+		S32 i = findSlot(id);
+		return (i < 0) ? NULL : &mEntries[i].mValue;
+	}
+
+	const T* find(const LLUUID& id) const
+	{
+		return const_cast<LLUUIDIndex<T>*>(this)->find(id);
+	}
+
+	BOOL contains(const LLUUID& id) const { return find(id) != NULL; }
+
+	// Adds id, or replaces its value if it is already there.
+	void set(const LLUUID& id, const T& value)
+	{
+		// Keep the table at most half full
+		if ((U32)(mCount + 1) * 2 > mEntries.size())
+		{
+			rehash(mEntries.empty() ? 64 : (U32)mEntries.size() * 2);
+		}
+		U32 i = slot(id);
+		while (mEntries[i].mUsed && mEntries[i].mID != id)
+		{
+			i = (i + 1) & mMask;
+		}
+		Entry& entry = mEntries[i];
+		if (!entry.mUsed)
+		{
+			entry.mUsed = TRUE;
+			entry.mID = id;
+			mCount++;
+		}
+		entry.mValue = value;
+	}
+
+	BOOL erase(const LLUUID& id)
+	{
+		S32 found = findSlot(id);
+		if (found < 0)
+		{
+			return FALSE;
+		}
+		// Move back the entries that probed past the hole
+		U32 hole = (U32)found;
+		for (U32 i = (hole + 1) & mMask; mEntries[i].mUsed; i = (i + 1) & mMask)
+		{
+			U32 home = slot(mEntries[i].mID);
+			if (((i - home) & mMask) >= ((i - hole) & mMask))
+			{
+				mEntries[hole] = mEntries[i];
+				hole = i;
+			}
+		}
+		mEntries[hole] = Entry();
+		mCount--;
+		return TRUE;
+	}
+
+	// Keeps the table's storage, it is usually refilled to the same size.
+	void clear()
+	{
+		if (mCount)
+		{
+			for (typename entry_list_t::iterator it = mEntries.begin(); it != mEntries.end(); ++it)
+			{
+				*it = Entry();
+			}
+			mCount = 0;
+		}
+	}
+
+private:
+	typedef std::vector<Entry> entry_list_t;
+
+	S32 findSlot(const LLUUID& id) const
+	{
+		if (!mCount)
+		{
+			return -1;
+		}
+		for (U32 i = slot(id); ; i = (i + 1) & mMask)
+		{
+			const Entry& entry = mEntries[i];
+			if (!entry.mUsed)
+			{
+				return -1;
+			}
+			if (entry.mID == id)
+			{
+				return (S32)i;
+			}
+		}
+	}
+
+	// Fibonacci hashing of the sum of the id's words, keeping the top bits.
+	U32 slot(const LLUUID& id) const
+	{
+		return mShift >= 32 ? 0 : (id.getCRC32() * 2654435761U) >> mShift;
+	}
+
+	void rehash(U32 size)
+	{
+		entry_list_t entries(size);
+		entries.swap(mEntries);
+		mMask = size - 1;
+		mShift = 32;
+		while (size > 1)
+		{
+			size >>= 1;
+			mShift--;
+		}
+		mCount = 0;
+		for (typename entry_list_t::iterator it = entries.begin(); it != entries.end(); ++it)
+		{
+			if (it->mUsed)
+			{
+				set(it->mID, it->mValue);
+			}
+		}
+	}
+
+	entry_list_t mEntries;
+	U32 mMask;
+	U32 mShift;
+	S32 mCount;
+};
+
+//
+// Maps (simulator index, local id) pairs to object ids.
+//
+// Simulators hand out local ids from a counter, so the ids seen from one
+// region are dense.  Each region gets a directory of fixed size pages
+// indexed directly by the local id; pages are allocated as ids show up
+// and freed when they empty.  The rare id beyond the directory's range
+// goes to an overflow map.
+//
+class LLLocalIDTable
+{
+public:
+	LLLocalIDTable();
+	~LLLocalIDTable();
+
+	// Returns LLUUID::null if there is no entry.
+	const LLUUID& find(U32 region_index, U32 local_id) const;
+	void set(U32 region_index, U32 local_id, const LLUUID& id);
+	// Only removes the entry if it still maps to id.
+	BOOL erase(U32 region_index, U32 local_id, const LLUUID& id);
+	void clear();
+
+private:
+	enum
+	{
+		PAGE_BITS = 10,
+		PAGE_SIZE = 1 << PAGE_BITS,
+		MAX_PAGES = 1 << (24 - PAGE_BITS)	// Directory covers local ids below 2^24
+	};
+
+	struct Page
+	{
+		Page() : mCount(0) {}
+
+		LLUUID mIDs[PAGE_SIZE];
+		S32 mCount;
+	};
+
+	struct Region
+	{
+		std::vector<Page*> mPages;
+		std::map<U32, LLUUID> mOverflow;
+	};
+
+	typedef std::vector<Region*> region_list_t;
+	region_list_t mRegions;
+};
+
+#endif // LL_LLVIEWEROBJECTINDEX_H
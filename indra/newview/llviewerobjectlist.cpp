@@ -44,7 +44,7 @@
 #include "llvoavatar.h"
 #include "llviewerobject.h"
 #include "llviewerwindow.h"
-#include "llnetmap.h"
+#include "llnetmaptiles.h"
 #include "llagent.h"
 #include "llagentcamera.h"
 #include "pipeline.h"
@@ -95,7 +95,9 @@ extern LLPipeline	gPipeline;
 // Statics for object lookup tables.
 U32						LLViewerObjectList::sSimulatorMachineIndex = 1; // Not zero deliberately, to speed up index check.
 std::map<U64, U32>			LLViewerObjectList::sIPAndPortToIndex;
-std::map<U64, LLUUID>	LLViewerObjectList::sIndexAndLocalIDToUUID;
+U64						LLViewerObjectList::sLastIPAndPort = 0;
+U32						LLViewerObjectList::sLastIndex = 0;
+LLLocalIDTable			LLViewerObjectList::sLocalIDTable;
 
 LLViewerObjectList::LLViewerObjectList()
 {
@@ -123,41 +125,63 @@ void LLViewerObjectList::destroy()
 	killAllObjects();
 
 	resetObjectBeacons();
+	for (vobj_list_t::iterator iter = mActiveObjects.begin(); iter != mActiveObjects.end(); ++iter)
+	{
+		(*iter)->setActiveListIndex(-1);
+	}
 	mActiveObjects.clear();
 	mDeadObjects.clear();
+	for (vobj_list_t::iterator iter = mMapObjects.begin(); iter != mMapObjects.end(); ++iter)
+	{
+		LLNetMapTiles::objectRemoved(*iter);
+	}
 	mMapObjects.clear();
 	mUUIDObjectMap.clear();
 	mUUIDAvatarMap.clear();
 }
 
-
-void LLViewerObjectList::getUUIDFromLocal(LLUUID &id,
-										  const U32 local_id,
-										  const U32 ip,
-										  const U32 port)
+//static
+U32 LLViewerObjectList::getSimulatorIndex(const U32 ip, const U32 port, BOOL create)
 {
 	U64 ipport = (((U64)ip) << 32) | (U64)port;
 
-	U32 index = sIPAndPortToIndex[ipport];
+	// Updates come in bursts from the same simulator.
+	if (sLastIndex && ipport == sLastIPAndPort)
+	{
+		return sLastIndex;
+	}
 
+	U32 index = get_if_there(sIPAndPortToIndex, ipport, (U32)0);
 	if (!index)
 	{
+		if (!create)
+		{
+			return 0;
+		}
 		index = sSimulatorMachineIndex++;
 		sIPAndPortToIndex[ipport] = index;
 	}
 
-	U64	indexid = (((U64)index) << 32) | (U64)local_id;
+	sLastIPAndPort = ipport;
+	sLastIndex = index;
+	return index;
+}
 
-	id = get_if_there(sIndexAndLocalIDToUUID, indexid, LLUUID::null);
+void LLViewerObjectList::getUUIDFromLocal(LLUUID &id,
+										  const U32 local_id,
+										  const U32 ip,
+										  const U32 port)
+{
+	U32 index = getSimulatorIndex(ip, port, TRUE);
+
+	id = sLocalIDTable.find(index, local_id);
 }
 
 U64 LLViewerObjectList::getIndex(const U32 local_id,
 								 const U32 ip,
 								 const U32 port)
 {
-	U64 ipport = (((U64)ip) << 32) | (U64)port;
-
-	U32 index = sIPAndPortToIndex[ipport];
+	U32 index = getSimulatorIndex(ip, port, FALSE);
 
 	if (!index)
 	{
@@ -174,28 +198,13 @@ BOOL LLViewerObjectList::removeFromLocalIDTable(const LLViewerObject* objectp)
 		U32 local_id = objectp->mLocalID;		
 		U32 ip = objectp->getRegion()->getHost().getAddress();
 		U32 port = objectp->getRegion()->getHost().getPort();
-		U64 ipport = (((U64)ip) << 32) | (U64)port;
-		U32 index = sIPAndPortToIndex[ipport];
+		U32 index = getSimulatorIndex(ip, port, FALSE);
 		
 		// llinfos << "Removing object from table, local ID " << local_id << ", ip " << ip << ":" << port << llendl;
 		
-		U64	indexid = (((U64)index) << 32) | (U64)local_id;
-		
-		std::map<U64, LLUUID>::iterator iter = sIndexAndLocalIDToUUID.find(indexid);
-		if (iter == sIndexAndLocalIDToUUID.end())
-		{
-			return FALSE;
-		}
-		
-		// Found existing entry
-		if (iter->second == objectp->getID())
-		{   // Full UUIDs match, so remove the entry
-			sIndexAndLocalIDToUUID.erase(iter);
-			return TRUE;
-		}
-		// UUIDs did not match - this would zap a valid entry, so don't erase it
-		//llinfos << "Tried to erase entry where id in table (" 
-		//		<< iter->second	<< ") did not match object " << object.getID() << llendl;
+		// Only erases the entry if the full UUIDs match, otherwise this
+		// would zap a valid entry.
+		return sLocalIDTable.erase(index, local_id, objectp->getID());
 	}
 	
 	return FALSE ;
@@ -206,19 +215,9 @@ void LLViewerObjectList::setUUIDAndLocal(const LLUUID &id,
 										  const U32 ip,
 										  const U32 port)
 {
-	U64 ipport = (((U64)ip) << 32) | (U64)port;
-
-	U32 index = sIPAndPortToIndex[ipport];
+	U32 index = getSimulatorIndex(ip, port, TRUE);
 
-	if (!index)
-	{
-		index = sSimulatorMachineIndex++;
-		sIPAndPortToIndex[ipport] = index;
-	}
-
-	U64	indexid = (((U64)index) << 32) | (U64)local_id;
-
-	sIndexAndLocalIDToUUID[indexid] = id;
+	sLocalIDTable.set(index, local_id, id);
 	
 	//llinfos << "Adding object to table, full ID " << id
 	//	<< ", local ID " << local_id << ", ip " << ip << ":" << port << llendl;
@@ -514,7 +513,7 @@ void LLViewerObjectList::processObjectUpdate(LLMessageSystem *mesgsys,
 				mesgsys->getU8Fast(_PREHASH_ObjectData, _PREHASH_PCode, pcode, i);
 			}
 #ifdef IGNORE_DEAD
-			if (mDeadObjects.find(fullid) != mDeadObjects.end())
+			if (mDeadObjects.contains(fullid))
 			{
 				mNumDeadObjectUpdates++;
 				// llinfos << "update for a dead object:" << fullid << llendl;
@@ -896,7 +895,7 @@ void LLViewerObjectList::update(LLAgent &agent, LLWorld &world)
 	std::vector<LLViewerObject*> idle_list;
 	idle_list.reserve( mActiveObjects.size() );
 
- 	for (std::set<LLPointer<LLViewerObject> >::iterator active_iter = mActiveObjects.begin();
+ 	for (vobj_list_t::iterator active_iter = mActiveObjects.begin();
 		active_iter != mActiveObjects.end(); active_iter++)
 	{
 		objectp = *active_iter;
@@ -968,7 +967,7 @@ void LLViewerObjectList::update(LLAgent &agent, LLWorld &world)
 	LLUUID id;
 	for (i = 0; i < mOrphanParents.count(); i++)
 	{
-		id = sIndexAndLocalIDToUUID[mOrphanParents[i]];
+		id = sLocalIDTable.find((U32)(mOrphanParents[i] >> 32), (U32)mOrphanParents[i]);
 		LLViewerObject *objectp = findObject(id);
 		if (objectp)
 		{
@@ -1002,7 +1001,7 @@ void LLViewerObjectList::update(LLAgent &agent, LLWorld &world)
 				tmpstr = std::string("ChNoP:    ") + id_str;
 				text_color = LLColor4(1.f, 0.f, 0.f, 1.f);
 			}
-			id = sIndexAndLocalIDToUUID[oi.mParentInfo];
+			id = sLocalIDTable.find((U32)(oi.mParentInfo >> 32), (U32)oi.mParentInfo);
 			addDebugBeacon(objectp->getPositionAgent() + LLVector3(0.f, 0.f, -0.25f),
 							tmpstr,
 							LLColor4(0.25f,0.25f,0.25f,1.f),
@@ -1153,13 +1152,13 @@ void LLViewerObjectList::clearDebugText()
 void LLViewerObjectList::cleanupReferences(LLViewerObject *objectp)
 {
 	LLMemType mt(LLMemType::MTYPE_OBJECT);
-	if (mDeadObjects.find(objectp->mID) != mDeadObjects.end())
+	if (mDeadObjects.contains(objectp->mID))
 	{
 		llinfos << "Object " << objectp->mID << " already on dead list!" << llendl;	
 	}
 	else
 	{
-		mDeadObjects.insert(objectp->mID);
+		mDeadObjects.set(objectp->mID, TRUE);
 	}
 
 	// Cleanup any references we have to this object
@@ -1180,8 +1179,7 @@ void LLViewerObjectList::cleanupReferences(LLViewerObject *objectp)
 	if (objectp->onActiveList())
 	{
 		//llinfos << "Removing " << objectp->mID << " " << objectp->getPCodeString() << " from active list in cleanupReferences." << llendl;
-		objectp->setOnActiveList(FALSE);
-		mActiveObjects.erase(objectp);
+		removeFromActiveList(objectp);
 	}
 
 	if (objectp->isOnMap())
@@ -1293,12 +1291,20 @@ void LLViewerObjectList::killAllObjects()
 	if (!mActiveObjects.empty())
 	{
 		llwarns << "Some objects still on active object list!" << llendl;
+		for (vobj_list_t::iterator iter = mActiveObjects.begin(); iter != mActiveObjects.end(); ++iter)
+		{
+			(*iter)->setActiveListIndex(-1);
+		}
 		mActiveObjects.clear();
 	}
 
 	if (!mMapObjects.empty())
 	{
 		llwarns << "Some objects still on map object list!" << llendl;
+		for (vobj_list_t::iterator iter = mMapObjects.begin(); iter != mMapObjects.end(); ++iter)
+		{
+			LLNetMapTiles::objectRemoved(*iter);
+		}
 		mMapObjects.clear();
 	}
 }
@@ -1380,18 +1386,31 @@ void LLViewerObjectList::updateActive(LLViewerObject *objectp)
 		if (active)
 		{
 			//llinfos << "Adding " << objectp->mID << " " << objectp->getPCodeString() << " to active list." << llendl;
-			mActiveObjects.insert(objectp);
-			objectp->setOnActiveList(TRUE);
+			objectp->setActiveListIndex((S32)mActiveObjects.size());
+			mActiveObjects.push_back(objectp);
 		}
 		else
 		{
 			//llinfos << "Removing " << objectp->mID << " " << objectp->getPCodeString() << " from active list." << llendl;
-			mActiveObjects.erase(objectp);
-			objectp->setOnActiveList(FALSE);
+			removeFromActiveList(objectp);
 		}
 	}
 }
 
+void LLViewerObjectList::removeFromActiveList(LLViewerObject *objectp)
+{
+	// Swap the last object into the hole, order does not matter.
+	S32 index = objectp->getActiveListIndex();
+	llassert(index >= 0 && index < (S32)mActiveObjects.size() && mActiveObjects[index] == objectp);
+	objectp->setActiveListIndex(-1);
+	if (index != (S32)mActiveObjects.size() - 1)
+	{
+		mActiveObjects[index] = mActiveObjects.back();
+		mActiveObjects[index]->setActiveListIndex(index);
+	}
+	mActiveObjects.pop_back();
+}
+
 #if MESH_ENABLED
 void LLViewerObjectList::updateObjectCost(LLViewerObject* object)
 {
@@ -1566,94 +1585,20 @@ void LLViewerObjectList::clearAllMapObjectsInRegion(LLViewerRegion* regionp)
 		}
 	}
 }
-void LLViewerObjectList::renderObjectsForMap(LLNetMap &netmap)
+void LLViewerObjectList::addToMap(LLViewerObject *objectp)
 {
-	LLColor4 above_water_color = gColors.getColor( "NetMapOtherOwnAboveWater" );
-	LLColor4 below_water_color = gColors.getColor( "NetMapOtherOwnBelowWater" );
-	LLColor4 you_own_above_water_color = 
-						gColors.getColor( "NetMapYouOwnAboveWater" );
-	LLColor4 you_own_below_water_color = 
-						gColors.getColor( "NetMapYouOwnBelowWater" );
-	LLColor4 group_own_above_water_color = 
-						gColors.getColor( "NetMapGroupOwnAboveWater" );
-	LLColor4 group_own_below_water_color = 
-						gColors.getColor( "NetMapGroupOwnBelowWater" );
-
-	F32 max_radius = gSavedSettings.getF32("MiniMapPrimMaxRadius");
-	
-	static const F32 MAX_ALTITUDE_ABOVE_SELF = 256.f;
-	F32 max_altitude = gAgent.getPositionGlobal()[VZ] + MAX_ALTITUDE_ABOVE_SELF;
+	mMapObjects.push_back(objectp);
+	LLNetMapTiles::objectAdded(objectp);
+}
 
-	for (vobj_list_t::iterator iter = mMapObjects.begin(); iter != mMapObjects.end(); ++iter)
+void LLViewerObjectList::removeFromMap(LLViewerObject *objectp)
+{
+	std::vector<LLPointer<LLViewerObject> >::iterator iter = std::find(mMapObjects.begin(), mMapObjects.end(), objectp);
+	if (iter != mMapObjects.end())
 	{
-		LLViewerObject* objectp = *iter;
-
-		llassert_always(objectp);
-		llassert(!objectp->isDead());
-		
-		if (objectp->isDead() || !objectp->getRegion() || objectp->isOrphaned() || objectp->isAttachment())
-		{
-			continue;
-		}
-		
-		const LLVector3& scale = objectp->getScale();
-		const LLVector3d pos = objectp->getPositionGlobal();
-		const F64 water_height = F64( objectp->getRegion()->getWaterHeight() );
-		// LLWorld::getInstance()->getWaterHeight();
-		
-		F32 approx_radius = (scale.mV[VX] + scale.mV[VY]) * 0.5f * 0.5f * 1.3f;  // 1.3 is a fudge
-
-		// Limit the size of megaprims so they don't blot out everything on the minimap.
-		// Attempting to draw very large megaprims also causes client lag.
-		// See DEV-17370 and SNOW-79 for details.
-		approx_radius = llmin(approx_radius, max_radius);
-
-		LLColor4U color = above_water_color;
-		if( objectp->permYouOwner() )
-		{
-			const F32 MIN_RADIUS_FOR_OWNED_OBJECTS = 2.f;
-			if( approx_radius < MIN_RADIUS_FOR_OWNED_OBJECTS )
-			{
-				approx_radius = MIN_RADIUS_FOR_OWNED_OBJECTS;
-			}
-			
-			if( pos.mdV[VZ] >= water_height )
-			{
-				if ( objectp->permGroupOwner() )
-				{
-					color = group_own_above_water_color;
-				}
-				else
-				{
-					color = you_own_above_water_color;
-				}
-			}
-			else
-			{
-				if ( objectp->permGroupOwner() )
-				{
-					color = group_own_below_water_color;
-				}
-				else
-				{
-					color = you_own_below_water_color;
-				}
-			}
-		}
-		else if ( pos[VZ] > max_altitude )
-		{
-			continue;
-		}
-		else if ( pos.mdV[VZ] < water_height )
-		{
-			color = below_water_color;
-		}
-
-		netmap.renderScaledPointGlobal( 
-			pos, 
-			color,
-			approx_radius );
+		mMapObjects.erase(iter);
 	}
+	LLNetMapTiles::objectRemoved(objectp);
 }
 
 void LLViewerObjectList::renderObjectBounds(const LLVector3 &center)
@@ -1830,12 +1775,12 @@ LLViewerObject *LLViewerObjectList::createObjectViewer(const LLPCode pcode, LLVi
 		return NULL;
 	}
 
-	mUUIDObjectMap[fullid] = objectp;
+	mUUIDObjectMap.set(fullid, objectp);
 	if(objectp->isAvatar())
 	{
 		LLVOAvatar *pAvatar = dynamic_cast<LLVOAvatar*>(objectp);
 		if(pAvatar)
-			mUUIDAvatarMap[fullid] = pAvatar;
+			mUUIDAvatarMap.set(fullid, pAvatar);
 	}
 
 	mObjects.push_back(objectp);
@@ -1870,12 +1815,12 @@ LLViewerObject *LLViewerObjectList::createObject(const LLPCode pcode, LLViewerRe
 		return NULL;
 	}
 
-	mUUIDObjectMap[fullid] = objectp;
+	mUUIDObjectMap.set(fullid, objectp);
 	if(objectp->isAvatar())
 	{
 		LLVOAvatar *pAvatar = dynamic_cast<LLVOAvatar*>(objectp);
 		if(pAvatar)
-			mUUIDAvatarMap[fullid] = pAvatar;
+			mUUIDAvatarMap.set(fullid, pAvatar);
 	}
 	setUUIDAndLocal(fullid,
 					local_id,
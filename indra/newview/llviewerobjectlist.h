@@ -42,10 +42,10 @@
 
 // project includes
 #include "llviewerobject.h"
+#include "llviewerobjectindex.h"
 #include "llvoavatar.h"
 
 class LLCamera;
-class LLNetMap;
 class LLDebugBeacon;
 
 const U32 CLOSE_BIN_SIZE = 10;
@@ -119,7 +119,6 @@ public:
 
 	bool hasMapObjectInRegion(LLViewerRegion* regionp) ;
 	void clearAllMapObjectsInRegion(LLViewerRegion* regionp) ;
-	void renderObjectsForMap(LLNetMap &netmap);
 	void renderObjectBounds(const LLVector3 &center);
 
 	void addDebugBeacon(const LLVector3 &pos_agent, const std::string &string,
@@ -213,6 +212,8 @@ public:
 	S32 mNumDeadObjects;
 	S32 mMinNumDeadObjects;
 protected:
+	void removeFromActiveList(LLViewerObject *objectp);
+
 	std::vector<U64>	mOrphanParents;	// LocalID/ip,port of orphaned objects
 	std::vector<OrphanInfo> mOrphanChildren;	// UUID's of orphaned objects
 	S32 mNumOrphans;
@@ -220,14 +221,14 @@ protected:
 	typedef std::vector<LLPointer<LLViewerObject> > vobj_list_t;
 
 	vobj_list_t mObjects;
-	std::set<LLPointer<LLViewerObject> > mActiveObjects;
+	vobj_list_t mActiveObjects;	// Unordered, objects know their own index (see LLViewerObject::getActiveListIndex())
 
 	vobj_list_t mMapObjects;
 
-	std::set<LLUUID> mDeadObjects;	
+	LLUUIDIndex<BOOL> mDeadObjects;
 
-	std::map<LLUUID, LLPointer<LLViewerObject> > mUUIDObjectMap;
-	std::map<LLUUID, LLPointer<LLVOAvatar> > mUUIDAvatarMap;
+	LLUUIDIndex<LLPointer<LLViewerObject> > mUUIDObjectMap;
+	LLUUIDIndex<LLPointer<LLVOAvatar> > mUUIDAvatarMap;
 
 #if MESH_ENABLED
 	//set of objects that need to update their cost
@@ -243,10 +244,14 @@ protected:
 
 	S32 mCurLazyUpdateIndex;
 
+	static U32 getSimulatorIndex(const U32 ip, const U32 port, BOOL create);
+
 	static U32 sSimulatorMachineIndex;
 	static std::map<U64, U32> sIPAndPortToIndex;
+	static U64 sLastIPAndPort;
+	static U32 sLastIndex;
 
-	static std::map<U64, LLUUID> sIndexAndLocalIDToUUID;
+	static LLLocalIDTable sLocalIDTable;
 
 	std::set<LLViewerObject *> mSelectPickList;
 
@@ -281,21 +286,14 @@ extern LLViewerObjectList gObjectList;
 // Inlines
 inline LLViewerObject *LLViewerObjectList::findObject(const LLUUID &id) const
 {
-	std::map<LLUUID, LLPointer<LLViewerObject> >::const_iterator iter = mUUIDObjectMap.find(id);
-	if(iter != mUUIDObjectMap.end())
-	{
-		return iter->second;
-	}
-	else
-	{
-		return NULL;
-	}
+	const LLPointer<LLViewerObject>* objectpp = mUUIDObjectMap.find(id);
+	return objectpp ? objectpp->get() : NULL;
 }
 
 inline LLVOAvatar *LLViewerObjectList::findAvatar(const LLUUID &id) const
 {
-	std::map<LLUUID, LLPointer<LLVOAvatar> >::const_iterator iter = mUUIDAvatarMap.find(id);
-	return (iter != mUUIDAvatarMap.end()) ? iter->second.get() : NULL;
+	const LLPointer<LLVOAvatar>* avatarpp = mUUIDAvatarMap.find(id);
+	return avatarpp ? avatarpp->get() : NULL;
 }
 
 inline LLViewerObject *LLViewerObjectList::getObject(const S32 index)
@@ -310,19 +308,5 @@ inline LLViewerObject *LLViewerObjectList::getObject(const S32 index)
 	return objectp;
 }
 
-inline void LLViewerObjectList::addToMap(LLViewerObject *objectp)
-{
-	mMapObjects.push_back(objectp);
-}
-
-inline void LLViewerObjectList::removeFromMap(LLViewerObject *objectp)
-{
-	std::vector<LLPointer<LLViewerObject> >::iterator iter = std::find(mMapObjects.begin(), mMapObjects.end(), objectp);
-	if (iter != mMapObjects.end())
-	{
-		mMapObjects.erase(iter);
-	}
-}
-
 
 #endif // LL_VIEWER_OBJECT_LIST_H
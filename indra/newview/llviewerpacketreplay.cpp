@@ -0,0 +1,239 @@
+/** 
+ * @file llviewerpacketreplay.cpp
+ * @brief Capturing simulator traffic and replaying it as a benchmark
+ *
+ * $LicenseInfo:firstyear=2002&license=viewergpl$
+ * 
+ * Copyright (c) 2002-2009, Linden Research, Inc.
+ * 
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ * 
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ * 
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ * 
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#include "llviewerprecompiledheaders.h"
+
+#include "llviewerpacketreplay.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+#include "lldir.h"
+#include "llfasttimer.h"
+#include "llpacketcapture.h"
+#include "message.h"
+
+#include "llagent.h"
+#include "llagentdata.h"
+#include "llappviewer.h"
+#include "llviewercontrol.h"
+#include "llviewerregion.h"
+#include "llworld.h"
+
+static std::vector<F32> sFrameTimes;
+static LLTimer sReplayTimer;
+static bool sReplayReported = false;
+
+//////////////////////////////////////////////////////////////////////////////
+// Capture
+
+// static
+void LLViewerPacketReplay::startCapture()
+{
+	if (!gMessageSystem)
+	{
+		// Picked up when the message system starts.
+		return;
+	}
+	std::string filename = gDirUtilp->getExpandedFilename(LL_PATH_LOGS, "packets.llcap");
+	if (!gMessageSystem->mPacketRing.startCapture(filename))
+	{
+		return;
+	}
+
+	// Regions we are already connected to, the agent's first: that is where
+	// a replay puts the agent.
+	LLViewerRegion* agent_regionp = gAgent.getRegion();
+	if (agent_regionp)
+	{
+		onRegionAdded(agent_regionp->getHost(), agent_regionp->getHandle(), (U32)agent_regionp->getWidth());
+	}
+	const LLWorld::region_list_t& regions = LLWorld::getInstance()->getRegionList();
+	for (LLWorld::region_list_t::const_iterator iter = regions.begin(); iter != regions.end(); ++iter)
+	{
+		LLViewerRegion* regionp = *iter;
+		if (regionp != agent_regionp)
+		{
+			onRegionAdded(regionp->getHost(), regionp->getHandle(), (U32)regionp->getWidth());
+		}
+	}
+}
+
+// static
+void LLViewerPacketReplay::stopCapture()
+{
+	if (gMessageSystem)
+	{
+		gMessageSystem->mPacketRing.stopCapture();
+	}
+}
+
+// static
+void LLViewerPacketReplay::onRegionAdded(const LLHost& host, U64 handle, U32 width)
+{
+	LLPacketCaptureWriter* capture = gMessageSystem ? gMessageSystem->mPacketRing.getCapture() : NULL;
+	if (capture)
+	{
+		capture->writeRegion(host, handle, width);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// Replay
+
+// static
+bool LLViewerPacketReplay::startReplay(LLHost& first_sim, U64& first_sim_handle, U32& first_sim_width)
+{
+	std::string filename = gSavedSettings.getString("ReplayPacketFile");
+
+	// The agent goes to the first region in the capture.
+	LLPacketCaptureReader reader;
+	if (!reader.open(filename))
+	{
+		return false;
+	}
+	while (reader.next() && reader.getType() != LLPacketCaptureReader::RECORD_REGION)
+	{
+	}
+	if (reader.getType() != LLPacketCaptureReader::RECORD_REGION)
+	{
+		llwarns << "Packet capture " << filename << " has no region to replay" << llendl;
+		return false;
+	}
+	first_sim = reader.getHost();
+	first_sim_handle = reader.getRegionHandle();
+	first_sim_width = reader.getRegionWidth();
+	reader.close();
+
+	LLPacketReplay* replay = new LLPacketReplay(!gSavedSettings.getBOOL("ReplayPacketsFast"));
+	if (!replay->open(filename))
+	{
+		delete replay;
+		return false;
+	}
+	replay->setRegionCallback(onReplayRegion);
+	gMessageSystem->mPacketRing.startReplay(replay);
+	llinfos << "Replaying packet capture " << filename << llendl;
+	return true;
+}
+
+// static
+bool LLViewerPacketReplay::isReplaying()
+{
+	return gMessageSystem && gMessageSystem->mPacketRing.isReplaying();
+}
+
+// static
+void LLViewerPacketReplay::onReplayRegion(const LLHost& host, U64 handle, U32 width)
+{
+	gMessageSystem->enableCircuit(host, TRUE);
+	LLWorld::getInstance()->addRegion(handle, host, width, width);
+}
+
+// static
+void LLViewerPacketReplay::idle(F32 frame_time)
+{
+	LLPacketReplay* replay = gMessageSystem->mPacketRing.getReplay();
+	if (!replay || sReplayReported)
+	{
+		return;
+	}
+
+	if (sFrameTimes.empty())
+	{
+		// Only count the frames of the replay itself in the timer averages.
+		LLFastTimer::sResetHistory = 1;
+		sReplayTimer.reset();
+	}
+	sFrameTimes.push_back(frame_time);
+
+	if (replay->isDone())
+	{
+		sReplayReported = true;
+		report();
+		LLAppViewer::instance()->forceQuit();
+	}
+}
+
+// static
+void LLViewerPacketReplay::report()
+{
+	static const struct
+	{
+		LLFastTimer::EFastTimerType mType;
+		const char* mName;
+	} timers[] =
+	{
+		{ LLFastTimer::FTM_FRAME,				"Frame" },
+		{ LLFastTimer::FTM_IDLE,				"Idle" },
+		{ LLFastTimer::FTM_IDLE_NETWORK,		"Network" },
+		{ LLFastTimer::FTM_PROCESS_MESSAGES,	"Process messages" },
+		{ LLFastTimer::FTM_PROCESS_OBJECTS,		"Process objects" },
+		{ LLFastTimer::FTM_CREATE_OBJECT,		"Create objects" },
+		{ LLFastTimer::FTM_OBJECTLIST_UPDATE,	"Update objects" },
+		{ LLFastTimer::FTM_REGION_UPDATE,		"Update regions" },
+		{ LLFastTimer::FTM_IMAGE_UPDATE,		"Update images" },
+		{ LLFastTimer::FTM_UPDATE_AVATAR,		"Update avatars" },
+		{ LLFastTimer::FTM_RENDER,				"Render" },
+		{ LLFastTimer::FTM_SLEEP,				"Sleep" }
+	};
+
+	LLPacketReplay* replay = gMessageSystem->mPacketRing.getReplay();
+	S32 frames = (S32)sFrameTimes.size();
+	std::sort(sFrameTimes.begin(), sFrameTimes.end());
+	F64 total = 0.0;
+	for (S32 i = 0; i < frames; i++)
+	{
+		total += sFrameTimes[i];
+	}
+
+	std::ostringstream out;
+	out << std::fixed << std::setprecision(2);
+	out << "Packet replay done: " << replay->getPacketCount() << " packets, "
+		<< replay->getCaptureTime() << " s captured, replayed in "
+		<< sReplayTimer.getElapsedTimeF64() << " s, " << frames << " frames\n";
+	out << "Frame time (ms): mean " << total * 1000.0 / llmax(frames, 1)
+		<< "  median " << sFrameTimes[frames / 2] * 1000.f
+		<< "  95% " << sFrameTimes[frames * 95 / 100] * 1000.f
+		<< "  99% " << sFrameTimes[frames * 99 / 100] * 1000.f
+		<< "  max " << sFrameTimes[frames - 1] * 1000.f << "\n";
+	out << "Per frame (ms, calls):\n";
+	F64 ms_per_count = 1000.0 / (F64)LLFastTimer::countsPerSecond();
+	for (U32 i = 0; i < sizeof(timers) / sizeof(timers[0]); i++)
+	{
+		out << "  " << std::setw(18) << std::left << timers[i].mName << std::right
+			<< std::setw(10) << LLFastTimer::sCountAverage[timers[i].mType] * ms_per_count
+			<< std::setw(10) << LLFastTimer::sCallAverage[timers[i].mType] << "\n";
+	}
+	llinfos << out.str() << llendl;
+}
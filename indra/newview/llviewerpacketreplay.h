@@ -0,0 +1,70 @@
+/** 
+ * @file llviewerpacketreplay.h
+ * @brief Capturing simulator traffic and replaying it as a benchmark
+ *
+ * $LicenseInfo:firstyear=2002&license=viewergpl$
+ * 
+ * Copyright (c) 2002-2009, Linden Research, Inc.
+ * 
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ * 
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ * 
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ * 
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLVIEWERPACKETREPLAY_H
+#define LL_LLVIEWERPACKETREPLAY_H
+
+#include "llhost.h"
+
+//
+// Capture writes every packet the viewer receives to logs/packets.llcap,
+// along with the regions they came from (PacketCapture setting).
+//
+// Replay (ReplayPacketFile setting) skips the login: the world is set up
+// from the capture's region records and the packet ring hands out the
+// captured packets instead of reading the socket, while everything sent
+// goes nowhere.  When the capture runs out the viewer logs frame times
+// and where they went, and quits.  Nothing but UDP is in a capture, so
+// there are no capabilities, inventory or HTTP textures during a replay.
+//
+class LLViewerPacketReplay
+{
+public:
+	static void startCapture();
+	static void stopCapture();
+	// Called by LLWorld for each region it adds.
+	static void onRegionAdded(const LLHost& host, U64 handle, U32 width);
+
+	// Opens the capture named by ReplayPacketFile and takes over the
+	// packet ring.  Returns the region the agent starts in.
+	static bool startReplay(LLHost& first_sim, U64& first_sim_handle, U32& first_sim_width);
+	static bool isReplaying();
+
+	// Once per frame, when logged in.
+	static void idle(F32 frame_time);
+
+private:
+	static void onReplayRegion(const LLHost& host, U64 handle, U32 width);
+	static void report();
+};
+
+#endif // LL_LLVIEWERPACKETREPLAY_H
@@ -70,6 +70,7 @@ const F32 LLViewerPartSim::PART_ADAPT_RATE_MULT_RECIP = 1.0f/PART_ADAPT_RATE_MUL
 
 
 U32 LLViewerPart::sNextPartID = 1;
+LL_DEFINE_POOL_ALLOCATOR(LLViewerPart);
 
 F32 calc_desired_size(LLViewerCamera* camera, LLVector3 pos, LLVector2 scale)
 {
@@ -36,6 +36,7 @@
 #include "lldarrayptr.h"
 #include "llframetimer.h"
 #include "llmemory.h"
+#include "llpoolallocator.h"
 #include "llpartdata.h"
 #include "llviewerpartsource.h"
 
@@ -56,6 +57,8 @@ typedef void (*LLVPCallback)(LLViewerPart &part, const F32 dt);
 class LLViewerPart : public LLPartData
 {
 public:
+	LL_USE_POOL_ALLOCATOR(LLViewerPart);
+
 	~LLViewerPart();
 public:
 	LLViewerPart();
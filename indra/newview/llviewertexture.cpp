@@ -44,6 +44,7 @@
 #include "llhost.h"
 #include "llimage.h"
 #include "llimagebmp.h"
+#include "llimagedxt.h"
 #include "llimagej2c.h"
 #include "llimagetga.h"
 #include "llmemtype.h"
@@ -1270,6 +1271,30 @@ BOOL LLViewerFetchedTexture::isForSculptOnly() const
 	return mForSculpt && !mNeedsGLTexture ;
 }
 
+bool LLViewerFetchedTexture::canCompressDXT() const
+{
+	static const LLCachedControl<bool> compress_dxt("TextureCompressDXT", false);
+	if (!compress_dxt || !gGLManager.mHasCompressedTextures || mNeedsAux || mForSculpt ||
+		mUrl.compare(0, 7, "file://") == 0)
+	{
+		return false;
+	}
+	switch (mBoostLevel)
+	{
+	  // Bump maps and sculpts are read back from the raw image, UI and HUD
+	  // art shows compression artifacts, and our own bakes feed the baking.
+	  case BOOST_NONE:
+	  case BOOST_AVATAR_BAKED:
+	  case BOOST_AVATAR:
+	  case BOOST_CLOUDS:
+	  case BOOST_TERRAIN:
+	  case BOOST_SELECTED:
+		return true;
+	  default:
+		return false;
+	}
+}
+
 BOOL LLViewerFetchedTexture::isDeleted()  
 { 
 	return mTextureState == DELETED ; 
@@ -1507,7 +1532,14 @@ BOOL LLViewerFetchedTexture::createTexture(S32 usename/*= 0*/)
 		
 		//if(!(res = insertToAtlas()))
 		//{
-			res = mGLTexturep->createGLTexture(mRawDiscardLevel, mRawImage, usename, TRUE, mBoostLevel);
+			if (mCompressedImage.notNull())
+			{
+				res = mGLTexturep->createCompressedGLTexture(mRawDiscardLevel, mRawImage, mCompressedImage, usename, TRUE, mBoostLevel);
+			}
+			else
+			{
+				res = mGLTexturep->createGLTexture(mRawDiscardLevel, mRawImage, usename, TRUE, mBoostLevel);
+			}
 			//resetFaceAtlas() ;
 		//}
 		setActive() ;
@@ -1885,7 +1917,8 @@ bool LLViewerFetchedTexture::updateFetch()
 		
 		if (mRawImage.notNull()) sRawCount--;
 		if (mAuxRawImage.notNull()) sAuxCount--;
-		bool finished = LLAppViewer::getTextureFetch()->getRequestFinished(getID(), fetch_discard, mRawImage, mAuxRawImage);
+		bool finished = LLAppViewer::getTextureFetch()->getRequestFinished(getID(), fetch_discard, mRawImage, mAuxRawImage,
+																		   mCompressedImage);
 		if (mRawImage.notNull()) sRawCount++;
 		if (mAuxRawImage.notNull()) sAuxCount++;
 		if (finished)
@@ -2052,7 +2085,8 @@ bool LLViewerFetchedTexture::updateFetch()
 		// bypass texturefetch directly by pulling from LLTextureCache
 		bool fetch_request_created = false;
 		fetch_request_created = LLAppViewer::getTextureFetch()->createRequest(mUrl, getID(),getTargetHost(), decode_priority,
-																			  w, h, c, desired_discard, needsAux(), mCanUseHTTP);
+																			  w, h, c, desired_discard, needsAux(), mCanUseHTTP,
+																			  canCompressDXT());
 		
 		if (fetch_request_created)
 		{
@@ -2616,6 +2650,7 @@ void LLViewerFetchedTexture::destroyRawImage()
 
 	mRawImage = NULL;
 	mAuxRawImage = NULL;
+	mCompressedImage = NULL;
 	mIsRawImageValid = FALSE;
 	mRawDiscardLevel = INVALID_DISCARD_LEVEL;
 }
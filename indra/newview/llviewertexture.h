@@ -51,6 +51,7 @@
 #define MAX_VIDEO_RAM_IN_MEGA_BYTES    512 // 512MB max for performance reasons.
 
 class LLFace;
+class LLImageDXT;
 class LLImageGL ;
 class LLImageRaw;
 class LLViewerObject;
@@ -409,6 +410,8 @@ public:
 	F32  calcDecodePriority() ;
 
 	BOOL needsAux() const { return mNeedsAux; }
+	// Whether the fetcher should hand back a DXT compressed copy of the decoded image
+	bool canCompressDXT() const;
 
 	// Host we think might have this image, used for baked av textures.
 	void setTargetHost(LLHost host)			{ mTargetHost = host; }
@@ -554,6 +557,9 @@ protected:
 	// doing if you use it for anything else! - djs
 	LLPointer<LLImageRaw> mAuxRawImage;
 
+	// DXT copy of mRawImage made by the fetcher, uploaded in its place when set
+	LLPointer<LLImageDXT> mCompressedImage;
+
 	//keep a copy of mRawImage for some special purposes
 	//when mForceToSaveRawImage is set.
 	BOOL mForceToSaveRawImage ;
@@ -981,6 +981,34 @@ BOOL LLViewerTextureList::createUploadFile(const std::string& filename,
 										 const U8 codec)
 {
 	// First, load the image.
+	LLPointer<LLImageRaw> raw_image = loadUploadImage(filename, codec);
+	if (raw_image.isNull())
+	{
+		return FALSE;
+	}
+	
+	LLPointer<LLImageJ2C> compressedImage = convertToUploadFile(raw_image);
+	
+	if( !compressedImage->save(out_filename) )
+	{
+		llinfos << "Couldn't create output file " << out_filename << llendl;
+		return FALSE;
+	}
+	
+	// test to see if the encode and save worked.
+	LLPointer<LLImageJ2C> integrity_test = new LLImageJ2C;
+	if( !integrity_test->loadAndValidate( out_filename ) )
+	{
+		llinfos << "Image: " << out_filename << " is corrupt." << llendl;
+		return FALSE;
+	}
+	
+	return TRUE;
+}
+
+//static
+LLPointer<LLImageRaw> LLViewerTextureList::loadUploadImage(const std::string& filename, const U8 codec)
+{
 	LLPointer<LLImageRaw> raw_image = new LLImageRaw;
 	
 	switch (codec)
@@ -991,12 +1019,12 @@ BOOL LLViewerTextureList::createUploadFile(const std::string& filename,
 			
 			if (!bmp_image->load(filename))
 			{
-				return FALSE;
+				return NULL;
 			}
 			
 			if (!bmp_image->decode(raw_image, 0.0f))
 			{
-				return FALSE;
+				return NULL;
 			}
 		}
 			break;
@@ -1006,19 +1034,19 @@ BOOL LLViewerTextureList::createUploadFile(const std::string& filename,
 			
 			if (!tga_image->load(filename))
 			{
-				return FALSE;
+				return NULL;
 			}
 			
 			if (!tga_image->decode(raw_image))
 			{
-				return FALSE;
+				return NULL;
 			}
 			
 			if(	(tga_image->getComponents() != 3) &&
 			   (tga_image->getComponents() != 4) )
 			{
 				tga_image->setLastError( "Image files with less than 3 or more than 4 components are not supported." );
-				return FALSE;
+				return NULL;
 			}
 		}
 			break;
@@ -1028,12 +1056,12 @@ BOOL LLViewerTextureList::createUploadFile(const std::string& filename,
 			
 			if (!jpeg_image->load(filename))
 			{
-				return FALSE;
+				return NULL;
 			}
 			
 			if (!jpeg_image->decode(raw_image, 0.0f))
 			{
-				return FALSE;
+				return NULL;
 			}
 		}
 			break;
@@ -1043,40 +1071,25 @@ BOOL LLViewerTextureList::createUploadFile(const std::string& filename,
 			
 			if (!png_image->load(filename))
 			{
-				return FALSE;
+				return NULL;
 			}
 			
 			if (!png_image->decode(raw_image, 0.0f))
 			{
-				return FALSE;
+				return NULL;
 			}
 		}
 			break;
 		default:
-			return FALSE;
-	}
-	
-	LLPointer<LLImageJ2C> compressedImage = convertToUploadFile(raw_image);
-	
-	if( !compressedImage->save(out_filename) )
-	{
-		llinfos << "Couldn't create output file " << out_filename << llendl;
-		return FALSE;
-	}
-	
-	// test to see if the encode and save worked.
-	LLPointer<LLImageJ2C> integrity_test = new LLImageJ2C;
-	if( !integrity_test->loadAndValidate( out_filename ) )
-	{
-		llinfos << "Image: " << out_filename << " is corrupt." << llendl;
-		return FALSE;
+			return NULL;
 	}
 	
-	return TRUE;
+	return raw_image;
 }
 
+// Sets up the LLImageJ2C an upload is encoded into.
 // note: modifies the argument raw_image!!!!
-LLPointer<LLImageJ2C> LLViewerTextureList::convertToUploadFile(LLPointer<LLImageRaw> raw_image)
+static LLPointer<LLImageJ2C> prepare_upload_file(LLPointer<LLImageRaw> raw_image)
 {
 	raw_image->biasedScaleToPowerOfTwo(LLViewerFetchedTexture::MAX_IMAGE_SIZE_DEFAULT);
 	LLPointer<LLImageJ2C> compressedImage = new LLImageJ2C();
@@ -1086,11 +1099,26 @@ LLPointer<LLImageJ2C> LLViewerTextureList::convertToUploadFile(LLPointer<LLImage
 		(raw_image->getWidth() * raw_image->getHeight() <= LL_IMAGE_REZ_LOSSLESS_CUTOFF * LL_IMAGE_REZ_LOSSLESS_CUTOFF))
 		compressedImage->setReversible(TRUE);
 	
+	return compressedImage;
+}
+
+// note: modifies the argument raw_image!!!!
+LLPointer<LLImageJ2C> LLViewerTextureList::convertToUploadFile(LLPointer<LLImageRaw> raw_image)
+{
+	LLPointer<LLImageJ2C> compressedImage = prepare_upload_file(raw_image);
 	compressedImage->encode(raw_image, 0.0f);
 	
 	return compressedImage;
 }
 
+// note: modifies the argument raw_image!!!!
+//static
+bool LLViewerTextureList::convertToUploadFileAsync(LLPointer<LLImageRaw> raw_image, LLImageEncodeThread::Responder* responder)
+{
+	LLPointer<LLImageJ2C> compressedImage = prepare_upload_file(raw_image);
+	return LLImageEncodeThread::encodeImage(raw_image, compressedImage, false, responder);
+}
+
 // Returns min setting for TextureMemory (in MB)
 S32 LLViewerTextureList::getMinVideoRamSetting()
 {
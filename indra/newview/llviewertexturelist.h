@@ -37,6 +37,7 @@
 #include "lluuid.h"
 //#include "message.h"
 #include "llgl.h"
+#include "llimageworker.h"
 #include "llstat.h"
 #include "llviewertexture.h"
 #include "llui.h"
@@ -76,6 +77,11 @@ class LLViewerTextureList
 public:
 	static BOOL createUploadFile(const std::string& filename, const std::string& out_filename, const U8 codec);
 	static LLPointer<LLImageJ2C> convertToUploadFile(LLPointer<LLImageRaw> raw_image);
+	// Loads and decodes an image file to upload, NULL on failure (see LLImage::getLastError())
+	static LLPointer<LLImageRaw> loadUploadImage(const std::string& filename, const U8 codec);
+	// Same as convertToUploadFile(), but encodes on the image encode threads. The
+	// responder gets the LLImageJ2C on the main thread.
+	static bool convertToUploadFileAsync(LLPointer<LLImageRaw> raw_image, LLImageEncodeThread::Responder* responder);
 	static void processImageNotInDatabase( LLMessageSystem *msg, void **user_data );
 	static S32 calcMaxTextureRAM();
 	static void receiveImageHeader(LLMessageSystem *msg, void **user_data);
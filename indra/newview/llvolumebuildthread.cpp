@@ -0,0 +1,341 @@
+/**
+ * @file llvolumebuildthread.cpp
+ * @brief Generating prim and sculpt volumes on worker threads
+ *
+ * $LicenseInfo:firstyear=2002&license=viewergpl$
+ *
+ * Copyright (c) 2002-2009, Linden Research, Inc.
+ *
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ *
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ *
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ *
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#include "llviewerprecompiledheaders.h"
+
+#include "llvolumebuildthread.h"
+
+#include "llimage.h"
+#include "llprimitive.h"
+#include "llstl.h"
+#include "llviewerobjectlist.h"
+#include "llvolumemgr.h"
+#include "llvovolume.h"
+
+//============================================================================
+
+/*static*/ LLVolumeBuildThread::thread_list_t LLVolumeBuildThread::sThreads;
+/*static*/ U32 LLVolumeBuildThread::sNextBuildID = 1;
+/*static*/ LLVolumeBuildThread::pending_volume_index_t LLVolumeBuildThread::sPendingVolumeIndex;
+/*static*/ LLVolumeBuildThread::pending_volume_map_t LLVolumeBuildThread::sPendingVolumes;
+/*static*/ LLVolumeBuildThread::pending_sculpt_index_t LLVolumeBuildThread::sPendingSculptIndex;
+/*static*/ LLVolumeBuildThread::pending_sculpt_map_t LLVolumeBuildThread::sPendingSculpts;
+
+//============================================================================
+// Run on MAIN thread
+//static
+void LLVolumeBuildThread::initClass(U32 num_threads, bool threaded)
+{
+	llassert(sThreads.empty());
+	if (!threaded)
+	{
+		// Queueing them up only to build them on this thread anyway would just
+		// have objects draw at the wrong LOD for a frame.
+		return;
+	}
+	for (U32 i = 0; i < num_threads; i++)
+	{
+		sThreads.push_back(new LLVolumeBuildThread(threaded));
+	}
+}
+
+//static
+S32 LLVolumeBuildThread::updateClass(U32 max_time_ms)
+{
+	S32 pending = 0;
+	for (thread_list_t::iterator iter = sThreads.begin(); iter != sThreads.end(); ++iter)
+	{
+		pending += (*iter)->update(max_time_ms);
+	}
+	return pending;
+}
+
+//static
+void LLVolumeBuildThread::cleanupClass()
+{
+	for (thread_list_t::iterator iter = sThreads.begin(); iter != sThreads.end(); ++iter)
+	{
+		(*iter)->setQuitting();
+	}
+	while (updateClass(0))
+	{
+	}
+	for_each(sThreads.begin(), sThreads.end(), DeletePointer());
+	sThreads.clear();
+	sPendingVolumeIndex.clear();
+	sPendingVolumes.clear();
+	sPendingSculptIndex.clear();
+	sPendingSculpts.clear();
+}
+
+//static
+LLVolumeBuildThread* LLVolumeBuildThread::getLeastBusy()
+{
+	LLVolumeBuildThread* least_busy = sThreads.front();
+	S32 least_pending = least_busy->getPending();
+	for (thread_list_t::iterator iter = sThreads.begin() + 1; iter != sThreads.end(); ++iter)
+	{
+		S32 pending = (*iter)->getPending();
+		if (pending < least_pending)
+		{
+			least_busy = *iter;
+			least_pending = pending;
+		}
+	}
+	return least_busy;
+}
+
+//static
+void LLVolumeBuildThread::buildVolume(const LLVolumeParams& volume_params, S32 detail, const LLUUID& object_id)
+{
+	if (sThreads.empty())
+	{
+		llwarns << "LLVolumeBuildThread::buildVolume called without build threads" << llendl;
+		return;
+	}
+
+	std::pair<LLVolumeParams, S32> key(volume_params, detail);
+	pending_volume_index_t::iterator index_iter = sPendingVolumeIndex.find(key);
+	if (index_iter != sPendingVolumeIndex.end())
+	{
+		std::vector<LLUUID>& object_ids = sPendingVolumes[index_iter->second].object_ids;
+		if (std::find(object_ids.begin(), object_ids.end(), object_id) == object_ids.end())
+		{
+			object_ids.push_back(object_id);
+		}
+		return;
+	}
+
+	U32 build_id = sNextBuildID++;
+	sPendingVolumeIndex[key] = build_id;
+	pending_volume& pending = sPendingVolumes[build_id];
+	pending.params = volume_params;
+	pending.detail = detail;
+	pending.object_ids.push_back(object_id);
+
+	LLVolumeBuildThread* threadp = getLeastBusy();
+	threadp->addRequest(new BuildRequest(threadp, threadp->generateHandle(), build_id, volume_params, detail));
+}
+
+//static
+void LLVolumeBuildThread::sculptVolume(LLVolume* volumep, S32 sculpt_level, LLImageRaw* raw_image, const LLUUID& object_id)
+{
+	if (sThreads.empty())
+	{
+		llwarns << "LLVolumeBuildThread::sculptVolume called without build threads" << llendl;
+		return;
+	}
+
+	pending_sculpt_index_t::iterator index_iter = sPendingSculptIndex.find(volumep);
+	if (index_iter != sPendingSculptIndex.end() && sPendingSculpts[index_iter->second].sculpt_level == sculpt_level)
+	{
+		return;
+	}
+
+	// A newer sculpt supersedes whatever is still on its way for this volume,
+	// which is then dropped when it comes back.
+	U32 build_id = sNextBuildID++;
+	sPendingSculptIndex[volumep] = build_id;
+	pending_sculpt& pending = sPendingSculpts[build_id];
+	pending.volume = volumep;
+	pending.sculpt_level = sculpt_level;
+	pending.object_id = object_id;
+
+	LLVolumeBuildThread* threadp = getLeastBusy();
+	threadp->addRequest(new BuildRequest(threadp, threadp->generateHandle(), build_id, volumep->getParams(),
+										 volumep->getDetail(), sculpt_level, raw_image));
+}
+
+//static
+void LLVolumeBuildThread::volumeBuilt(U32 build_id, LLVolume* volumep)
+{
+	pending_volume_map_t::iterator volume_iter = sPendingVolumes.find(build_id);
+	if (volume_iter != sPendingVolumes.end())
+	{
+		pending_volume& pending = volume_iter->second;
+		LLVolumeMgr* volume_mgr = LLPrimitive::getVolumeManager();
+		if (volumep && volume_mgr)
+		{
+			// Does nothing if it got built on this thread meanwhile, or nothing
+			// uses these params anymore.
+			volume_mgr->addBuiltVolume(volumep, pending.detail);
+			for (std::vector<LLUUID>::iterator iter = pending.object_ids.begin();
+				 iter != pending.object_ids.end(); ++iter)
+			{
+				LLViewerObject* objectp = gObjectList.findObject(*iter);
+				if (objectp && !objectp->isDead() && objectp->getPCode() == LL_PCODE_VOLUME)
+				{
+					((LLVOVolume*)objectp)->notifyVolumeBuilt();
+				}
+			}
+		}
+		sPendingVolumeIndex.erase(std::make_pair(pending.params, pending.detail));
+		sPendingVolumes.erase(volume_iter);
+		return;
+	}
+
+	pending_sculpt_map_t::iterator sculpt_iter = sPendingSculpts.find(build_id);
+	if (sculpt_iter != sPendingSculpts.end())
+	{
+		pending_sculpt& pending = sculpt_iter->second;
+		pending_sculpt_index_t::iterator index_iter = sPendingSculptIndex.find(pending.volume);
+		if (index_iter != sPendingSculptIndex.end() && index_iter->second == build_id)
+		{
+			sPendingSculptIndex.erase(index_iter);
+			// Not worth it if nothing but us and its LOD group holds it anymore.
+			if (volumep && pending.volume->getNumRefs() > getOwnRefs(pending.volume))
+			{
+				pending.volume->swapGeometry(volumep);
+				LLViewerObject* objectp = gObjectList.findObject(pending.object_id);
+				if (objectp && !objectp->isDead() && objectp->getPCode() == LL_PCODE_VOLUME)
+				{
+					((LLVOVolume*)objectp)->notifySculptBuilt();
+				}
+			}
+		}
+		sPendingSculpts.erase(sculpt_iter);
+	}
+}
+
+//static
+S32 LLVolumeBuildThread::getOwnRefs(LLVolume* volumep)
+{
+	// One in sPendingSculpts, and one in the LOD group while it still has that LOD
+	S32 refs = 1;
+	LLVolumeMgr* volume_mgr = LLPrimitive::getVolumeManager();
+	LLVolumeLODGroup* groupp = volume_mgr ? volume_mgr->getGroup(volumep->getParams()) : NULL;
+	if (groupp && groupp->isLODBuilt(LLVolumeLODGroup::getVolumeDetailFromScale(volumep->getDetail())))
+	{
+		refs++;
+	}
+	return refs;
+}
+
+//----------------------------------------------------------------------------
+
+LLVolumeBuildThread::LLVolumeBuildThread(bool threaded) :
+	LLQueuedThread("volumebuild", threaded)
+{
+}
+
+LLVolumeBuildThread::~LLVolumeBuildThread()
+{
+	// ~LLQueuedThread() will be called here
+}
+
+// MAIN THREAD
+S32 LLVolumeBuildThread::update(U32 max_time_ms)
+{
+	S32 res = LLQueuedThread::update(max_time_ms);
+
+	completed_list_t completed;
+	{
+		LLMutexLock lock(&mCompletedMutex);
+		completed.swap(mCompletedList);
+	}
+	for (completed_list_t::iterator iter = completed.begin(); iter != completed.end(); ++iter)
+	{
+		volumeBuilt(iter->build_id, iter->volume);
+	}
+	return res + (S32)completed.size();
+}
+
+//----------------------------------------------------------------------------
+
+LLVolumeBuildThread::BuildRequest::BuildRequest(LLVolumeBuildThread* thread, handle_t handle, U32 build_id,
+												const LLVolumeParams& volume_params, S32 detail) :
+	LLQueuedThread::QueuedRequest(handle, PRIORITY_NORMAL | detail, FLAG_AUTO_COMPLETE),
+	mThread(thread),
+	mBuildID(build_id),
+	mParams(volume_params),
+	mDetail(detail),
+	mVolumeDetail(LLVolumeLODGroup::getVolumeScaleFromDetail(detail)),
+	mSculptLevel(0),
+	mSculptWidth(0),
+	mSculptHeight(0),
+	mSculptComponents(0)
+{
+}
+
+LLVolumeBuildThread::BuildRequest::BuildRequest(LLVolumeBuildThread* thread, handle_t handle, U32 build_id,
+												const LLVolumeParams& volume_params, F32 volume_detail,
+												S32 sculpt_level, LLImageRaw* raw_image) :
+	LLQueuedThread::QueuedRequest(handle, PRIORITY_NORMAL, FLAG_AUTO_COMPLETE),
+	mThread(thread),
+	mBuildID(build_id),
+	mParams(volume_params),
+	mDetail(0),
+	mVolumeDetail(volume_detail),
+	mSculptLevel(sculpt_level),
+	mSculptWidth(raw_image->getWidth()),
+	mSculptHeight(raw_image->getHeight()),
+	mSculptComponents(raw_image->getComponents())
+{
+	// The texture may be rediscarded before we get to it, take a copy.
+	const U8* data = raw_image->getData();
+	if (data)
+	{
+		mSculptData.assign(data, data + raw_image->getDataSize());
+	}
+}
+
+LLVolumeBuildThread::BuildRequest::~BuildRequest()
+{
+}
+
+bool LLVolumeBuildThread::BuildRequest::processRequest()
+{
+	mVolume = new LLVolume(mParams, mVolumeDetail);
+	if (mParams.isSculpt())
+	{
+		mVolume->sculpt(mSculptWidth, mSculptHeight, mSculptComponents,
+						mSculptData.empty() ? NULL : &mSculptData[0], mSculptLevel);
+	}
+	return true;
+}
+
+void LLVolumeBuildThread::BuildRequest::finishRequest(bool completed)
+{
+	// LLVolume's reference count isn't atomic, and once the lock is released the
+	// main thread owns the completed list.  Hand the volume over without touching
+	// its count, and drop it here only while the lock is held.
+	LLMutexLock lock(&mThread->mCompletedMutex);
+	mThread->mCompletedList.push_back(completed_info());
+	completed_info& info = mThread->mCompletedList.back();
+	info.build_id = mBuildID;
+	if (completed)
+	{
+		LLPointer<LLVolume>::swap(info.volume, mVolume);
+	}
+	mVolume = NULL;
+	// Will automatically be deleted
+}
@@ -0,0 +1,158 @@
+/**
+ * @file llvolumebuildthread.h
+ * @brief Worker threads generating volume geometry in the background
+ *
+ * $LicenseInfo:firstyear=2002&license=viewergpl$
+ *
+ * Copyright (c) 2002-2009, Linden Research, Inc.
+ *
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ *
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ *
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ *
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLVOLUMEBUILDTHREAD_H
+#define LL_LLVOLUMEBUILDTHREAD_H
+
+#include <map>
+#include <vector>
+
+#include "llqueuedthread.h"
+#include "llvolume.h"
+
+class LLImageRaw;
+
+//============================================================================
+// Generates volumes off the main thread, on a pool of these.  Prim LODs that
+// aren't in their LLVolumeLODGroup yet are built as standalone LLVolumes and
+// handed to the group once done; sculpties are sculpted on a copy of their
+// volume, whose geometry is then swapped in.  Either way that happens on the
+// main thread, in updateClass(), which also has the objects waiting on it
+// rebuild.  Meanwhile they keep drawing whatever volume they have.
+//============================================================================
+
+class LLVolumeBuildThread : public LLQueuedThread
+{
+public:
+	class BuildRequest : public LLQueuedThread::QueuedRequest
+	{
+	protected:
+		virtual ~BuildRequest(); // use deleteRequest()
+
+	public:
+		// A prim LOD
+		BuildRequest(LLVolumeBuildThread* thread, handle_t handle, U32 build_id,
+					 const LLVolumeParams& volume_params, S32 detail);
+		// A sculpty, from its map at sculpt_level
+		BuildRequest(LLVolumeBuildThread* thread, handle_t handle, U32 build_id,
+					 const LLVolumeParams& volume_params, F32 volume_detail,
+					 S32 sculpt_level, LLImageRaw* raw_image);
+
+		/*virtual*/ bool processRequest();
+		/*virtual*/ void finishRequest(bool completed);
+
+	private:
+		LLVolumeBuildThread* mThread;
+		U32 mBuildID;
+		// input
+		LLVolumeParams mParams;
+		S32 mDetail;
+		F32 mVolumeDetail;
+		S32 mSculptLevel;
+		U16 mSculptWidth;
+		U16 mSculptHeight;
+		S8 mSculptComponents;
+		std::vector<U8> mSculptData;
+		// output, only ever touched by one thread at a time
+		LLPointer<LLVolume> mVolume;
+	};
+
+public:
+	LLVolumeBuildThread(bool threaded = true);
+	virtual ~LLVolumeBuildThread();
+
+	S32 update(U32 max_time_ms);
+
+	// Run on MAIN thread
+	static void initClass(U32 num_threads, bool threaded = true);
+	static S32 updateClass(U32 max_time_ms);
+	static void cleanupClass();
+
+	// No threads means volumes are generated on the main thread as they always were.
+	static bool isEnabled()								{ return !sThreads.empty(); }
+
+	// Builds that LOD of volume_params, unless it's on its way already.  The object is
+	// told with LLVOVolume::notifyVolumeBuilt() once it's in the LOD group.
+	static void buildVolume(const LLVolumeParams& volume_params, S32 detail, const LLUUID& object_id);
+	// Sculpts volumep from raw_image, unless that level is on its way already.  The
+	// object is told with LLVOVolume::notifySculptBuilt() once volumep has it.
+	static void sculptVolume(LLVolume* volumep, S32 sculpt_level, LLImageRaw* raw_image, const LLUUID& object_id);
+	static bool isSculptPending(LLVolume* volumep)		{ return sPendingSculptIndex.count(volumep) > 0; }
+	static bool isVolumePending(const LLVolumeParams& volume_params, S32 detail)
+	{
+		return sPendingVolumeIndex.count(std::make_pair(volume_params, detail)) > 0;
+	}
+
+private:
+	static LLVolumeBuildThread* getLeastBusy();
+	// References to a volume waiting for a sculpt that we hold ourselves
+	static S32 getOwnRefs(LLVolume* volumep);
+
+	struct completed_info
+	{
+		U32 build_id;
+		LLPointer<LLVolume> volume;
+	};
+	typedef std::vector<completed_info> completed_list_t;
+	completed_list_t mCompletedList;
+	LLMutex mCompletedMutex;
+
+	typedef std::vector<LLVolumeBuildThread*> thread_list_t;
+	static thread_list_t sThreads;
+
+	// What the main thread is waiting for, by build id
+	static U32 sNextBuildID;
+	struct pending_volume
+	{
+		LLVolumeParams params;
+		S32 detail;
+		std::vector<LLUUID> object_ids;
+	};
+	struct pending_sculpt
+	{
+		LLPointer<LLVolume> volume;
+		S32 sculpt_level;
+		LLUUID object_id;
+	};
+	typedef std::map<std::pair<LLVolumeParams, S32>, U32> pending_volume_index_t;
+	typedef std::map<U32, pending_volume> pending_volume_map_t;
+	typedef std::map<LLVolume*, U32> pending_sculpt_index_t;
+	typedef std::map<U32, pending_sculpt> pending_sculpt_map_t;
+	static pending_volume_index_t sPendingVolumeIndex;
+	static pending_volume_map_t sPendingVolumes;
+	static pending_sculpt_index_t sPendingSculptIndex;
+	static pending_sculpt_map_t sPendingSculpts;
+
+	static void volumeBuilt(U32 build_id, LLVolume* volumep);
+};
+
+#endif // LL_LLVOLUMEBUILDTHREAD_H
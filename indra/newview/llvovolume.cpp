@@ -77,6 +77,8 @@
 #include "llfloatertools.h"
 #endif //MESH_ENABLED
 #include "llvocache.h"
+#include "llvolumebuildthread.h"
+#include "llcullthread.h"
 
 // [RLVa:KB] - Checked: 2010-04-04 (RLVa-1.2.0d)
 #include "rlvhandler.h"
@@ -623,7 +625,8 @@ void LLVOVolume::updateTextureVirtualSize()
 
 			if (texture_discard >= 0 && //texture has some data available
 				(texture_discard < current_discard || //texture has more data than last rebuild
-				current_discard < 0)) //no previous rebuild
+				current_discard < 0) && //no previous rebuild
+				!LLVolumeBuildThread::isSculptPending(getVolume())) //not already on its way
 			{
 				gPipeline.markRebuild(mDrawable, LLDrawable::REBUILD_VOLUME, FALSE);
 				mSculptChanged = TRUE;
@@ -811,7 +814,12 @@ BOOL LLVOVolume::setVolume(const LLVolumeParams &params_in, const S32 detail, bo
 		volume_params.setSculptID(LLUUID::null, LL_SCULPT_TYPE_NONE);
 	}
 #endif //MESH_ENABLED
-	if ((LLPrimitive::setVolume(volume_params, lod, (mVolumeImpl && mVolumeImpl->isVolumeUnique()))) || mSculptChanged)
+	bool unique = mVolumeImpl && mVolumeImpl->isVolumeUnique();
+	if (!unique)
+	{
+		lod = getReadyLOD(volume_params, lod);
+	}
+	if ((LLPrimitive::setVolume(volume_params, lod, unique)) || mSculptChanged)
 	{
 		mFaceMappingChanged = TRUE;
 		
@@ -848,7 +856,8 @@ BOOL LLVOVolume::setVolume(const LLVolumeParams &params_in, const S32 detail, bo
 			{
 				if (mSculptTexture.notNull())
 				{
-					sculpt();
+					// A volume fresh out of its LOD group has nothing to draw until it's sculpted
+					sculpt(getVolume()->getNumVolumeFaces() > 0);
 				}
 			}
 		}
@@ -858,6 +867,69 @@ BOOL LLVOVolume::setVolume(const LLVolumeParams &params_in, const S32 detail, bo
 	return FALSE;
 }
 
+S32 LLVOVolume::getReadyLOD(const LLVolumeParams& volume_params, S32 lod)
+{
+	// Objects being edited change shape every frame, have them keep up.
+	if (!LLVolumeBuildThread::isEnabled() || lod == 0 ||
+		volume_params.isSculpt() || volume_params.getSculptType() != LL_SCULPT_TYPE_NONE ||
+		isSelected())
+	{
+		return lod;
+	}
+
+	LLVolumeMgr* volume_mgr = getVolumeManager();
+	if (volume_mgr->isVolumeBuilt(volume_params, lod))
+	{
+		return lod;
+	}
+
+	LLVolumeBuildThread::buildVolume(volume_params, lod, getID());
+
+	// Draw the closest LOD we have meanwhile, coarser first.
+	for (S32 i = lod - 1; i >= 0; --i)
+	{
+		if (volume_mgr->isVolumeBuilt(volume_params, i))
+		{
+			return i;
+		}
+	}
+	for (S32 i = lod + 1; i < LLVolumeLODGroup::NUM_LODS; ++i)
+	{
+		if (volume_mgr->isVolumeBuilt(volume_params, i))
+		{
+			return i;
+		}
+	}
+	// Nothing yet, the lowest LOD is quick to build here.
+	return 0;
+}
+
+void LLVOVolume::notifyVolumeBuilt()
+{
+	if (mDrawable.notNull())
+	{
+		mLODChanged = TRUE;
+		gPipeline.markRebuild(mDrawable, LLDrawable::REBUILD_VOLUME, FALSE);
+	}
+}
+
+void LLVOVolume::notifySculptBuilt()
+{
+	if (mSculptTexture.isNull())
+	{
+		return;
+	}
+	for (S32 i = 0; i < mSculptTexture->getNumVolumes(); ++i)
+	{
+		LLVOVolume* volume = (*(mSculptTexture->getVolumeList()))[i];
+		if (volume->getVolume() == getVolume() && volume->mDrawable.notNull())
+		{
+			volume->mSculptChanged = TRUE;
+			gPipeline.markRebuild(volume->mDrawable, LLDrawable::REBUILD_VOLUME, FALSE);
+		}
+	}
+}
+
 void LLVOVolume::updateSculptTexture()
 {
 	LLPointer<LLViewerFetchedTexture> old_sculpt = mSculptTexture;
@@ -903,7 +975,7 @@ void LLVOVolume::notifyMeshLoaded()
 #endif //MESH_ENABLED
 
 // sculpt replaces generate() for sculpted surfaces
-void LLVOVolume::sculpt()
+void LLVOVolume::sculpt(BOOL allow_background)
 {	
 	if (mSculptTexture.notNull())
 	{				
@@ -939,6 +1011,13 @@ void LLVOVolume::sculpt()
 
 		if (current_discard == discard_level)  // no work to do here
 			return;
+
+		if (allow_background && raw_image && LLVolumeBuildThread::isEnabled())
+		{
+			// Keep drawing what we have, notifySculptBuilt() will follow.
+			LLVolumeBuildThread::sculptVolume(getVolume(), discard_level, raw_image, getID());
+			return;
+		}
 		
 		if(!raw_image)
 		{
@@ -3018,6 +3097,97 @@ static LLDrawPoolAvatar* get_avatar_drawpool(LLViewerObject* vobj)
 }
 
 #endif //MESH_ENABLED
+// One face whose buffer range has been laid out and mapped, waiting for
+// its geometry.
+struct LLVolumeFill
+{
+	LLFace* mFace;
+	const LLVolume* mVolume;
+	S32 mTE;
+	const LLVOVolume* mObject;
+	U16 mIndexOffset;
+};
+
+class LLVolumeFillJob : public LLCullThread::Job
+{
+public:
+	LLVolumeFillJob(const LLVolumeFill* begin, const LLVolumeFill* end)
+	:	mBegin(begin), mEnd(end)
+	{
+	}
+
+	/*virtual*/ void run()
+	{
+		for (const LLVolumeFill* fill = mBegin; fill != mEnd; ++fill)
+		{
+			fill->mFace->fillGeometryVolume(*fill->mVolume, fill->mTE,
+				fill->mObject->getRelativeXform(), fill->mObject->getRelativeXformInvTrans(), fill->mIndexOffset);
+		}
+	}
+
+private:
+	const LLVolumeFill* mBegin;
+	const LLVolumeFill* mEnd;
+};
+
+// Collects the faces of a rebuild so that their vertex and index data can
+// be written by the cull threads, all faces at once.  Buffers are laid out
+// and mapped on the main thread as faces are added, each face then only
+// writes its own range; the buffers must stay mapped until run() returns.
+class LLVolumeFillBatch
+{
+public:
+	static bool isEnabled()
+	{
+		static const LLCachedControl<bool> parallel_fill("RenderParallelVertexFill", false);
+		return parallel_fill && LLCullThread::isEnabled();
+	}
+
+	void add(LLFace* facep, const LLVolume& volume, S32 te, const LLVOVolume* vobj, U16 index_offset)
+	{
+		if (facep->prepareGeometryVolume(volume, te))
+		{
+			LLVolumeFill fill = { facep, &volume, te, vobj, index_offset };
+			mFills.push_back(fill);
+		}
+	}
+
+	void run()
+	{
+		// Split the faces into runs of roughly even vertex counts.
+		const S32 VERTICES_PER_JOB = 4096;
+		mJobs.clear();
+		S32 begin = 0;
+		S32 vertex_count = 0;
+		for (S32 i = 0; i < (S32)mFills.size(); ++i)
+		{
+			vertex_count += mFills[i].mVolume->getVolumeFace(mFills[i].mTE).mNumVertices;
+			if (vertex_count >= VERTICES_PER_JOB || i == (S32)mFills.size() - 1)
+			{
+				mJobs.push_back(LLVolumeFillJob(&mFills[begin], &mFills[0] + i + 1));
+				begin = i + 1;
+				vertex_count = 0;
+			}
+		}
+
+		mJobList.clear();
+		for (std::vector<LLVolumeFillJob>::iterator iter = mJobs.begin(); iter != mJobs.end(); ++iter)
+		{
+			mJobList.push_back(&*iter);
+		}
+		LLCullThread::runJobs(mJobList);
+
+		mFills.clear();
+	}
+
+private:
+	std::vector<LLVolumeFill> mFills;
+	std::vector<LLVolumeFillJob> mJobs;
+	LLCullThread::job_list_t mJobList;
+};
+
+static LLVolumeFillBatch sFillBatch;
+
 void LLVolumeGeometryManager::rebuildGeom(LLSpatialGroup* group)
 {
 	if (LLPipeline::sSkipUpdate)
@@ -3449,6 +3619,7 @@ void LLVolumeGeometryManager::rebuildMesh(LLSpatialGroup* group)
 	if (group && group->isState(LLSpatialGroup::MESH_DIRTY) && !group->isState(LLSpatialGroup::GEOM_DIRTY))
 	{
 		S32 num_mapped_vertex_buffer = LLVertexBuffer::sMappedCount ;
+		bool fill_parallel = LLVolumeFillBatch::isEnabled();
 
 		group->mBuilt = 1.f;
 		
@@ -3472,12 +3643,37 @@ void LLVolumeGeometryManager::rebuildMesh(LLSpatialGroup* group)
 					LLFace* face = drawablep->getFace(i);
 					if (face && face->getVertexBuffer())
 					{
-						face->getGeometryVolume(*volume, face->getTEOffset(), 
-							vobj->getRelativeXform(), vobj->getRelativeXformInvTrans(), face->getGeomIndex());
+						if (fill_parallel)
+						{
+							sFillBatch.add(face, *volume, face->getTEOffset(), vobj, face->getGeomIndex());
+						}
+						else
+						{
+							face->getGeometryVolume(*volume, face->getTEOffset(), 
+								vobj->getRelativeXform(), vobj->getRelativeXformInvTrans(), face->getGeomIndex());
+						}
 					}
 				}
 
-				drawablep->clearState(LLDrawable::REBUILD_ALL);
+				if (!fill_parallel)
+				{
+					drawablep->clearState(LLDrawable::REBUILD_ALL);
+				}
+			}
+		}
+
+		if (fill_parallel)
+		{
+			sFillBatch.run();
+
+			//the fills read the rebuild flags, clear them once they are done
+			for (LLSpatialGroup::element_iter drawable_iter = group->getData().begin(); drawable_iter != group->getData().end(); ++drawable_iter)
+			{
+				LLDrawable* drawablep = *drawable_iter;
+				if (!drawablep->isState(LLDrawable::FORCE_INVISIBLE) && !drawablep->isDead())
+				{
+					drawablep->clearState(LLDrawable::REBUILD_ALL);
+				}
 			}
 		}
 		
@@ -3587,6 +3783,10 @@ void LLVolumeGeometryManager::genDrawInfo(LLSpatialGroup* group, U32 mask, std::
 	LLViewerTexture* last_tex = NULL;
 	S32 buffer_index = 0;
 
+	//with a parallel fill, buffers stay mapped until all faces are filled
+	bool fill_parallel = !LLPipeline::sDelayVBUpdate && LLVolumeFillBatch::isEnabled();
+	std::vector<LLVertexBuffer*> mapped_buffers;
+
 	if (distance_sort)
 	{
 		buffer_index = -1;
@@ -3692,8 +3892,15 @@ void LLVolumeGeometryManager::genDrawInfo(LLSpatialGroup* group, U32 mask, std::
 
 					U32 te_idx = facep->getTEOffset();
 
-					facep->getGeometryVolume(*volume, te_idx, 
-						vobj->getRelativeXform(), vobj->getRelativeXformInvTrans(), index_offset);
+					if (fill_parallel)
+					{
+						sFillBatch.add(facep, *volume, te_idx, vobj, index_offset);
+					}
+					else
+					{
+						facep->getGeometryVolume(*volume, te_idx, 
+							vobj->getRelativeXform(), vobj->getRelativeXformInvTrans(), index_offset);
+					}
 				}
 			}
 
@@ -3848,7 +4055,23 @@ void LLVolumeGeometryManager::genDrawInfo(LLSpatialGroup* group, U32 mask, std::
 			++face_iter;
 		}
 
-		buffer->setBuffer(0);
+		if (fill_parallel)
+		{
+			mapped_buffers.push_back(buffer);
+		}
+		else
+		{
+			buffer->setBuffer(0);
+		}
+	}
+
+	if (fill_parallel)
+	{
+		sFillBatch.run();
+		for (std::vector<LLVertexBuffer*>::iterator iter = mapped_buffers.begin(); iter != mapped_buffers.end(); ++iter)
+		{
+			(*iter)->setBuffer(0);
+		}
 	}
 
 	group->mBufferMap[mask].clear();
@@ -197,7 +197,11 @@ public:
 	/*virtual*/ BOOL	setVolume(const LLVolumeParams &volume_params, const S32 detail, bool unique_volume = false);
 				void	updateSculptTexture();
 				void    setIndexInTex(S32 index) { mIndexInTex = index ;}
-				void	sculpt();
+				void	sculpt(BOOL allow_background = FALSE);
+				// Closest LOD of volume_params that's ready, queueing up a build of lod if it isn't
+				S32		getReadyLOD(const LLVolumeParams& volume_params, S32 lod);
+				void	notifyVolumeBuilt();
+				void	notifySculptBuilt();
 #if MESH_ENABLED
 	 static     void    rebuildMeshAssetCallback(LLVFS *vfs,
 														  const LLUUID& asset_uuid,
@@ -49,6 +49,7 @@
 #include "llviewertexturelist.h"
 #include "llviewernetwork.h"
 #include "llviewerobjectlist.h"
+#include "llviewerpacketreplay.h"
 #include "llviewerparceloverlay.h"
 #include "llviewerregion.h"
 #include "llviewerstats.h"
@@ -203,6 +204,7 @@ LLViewerRegion* LLWorld::addRegion(const U64 &region_handle, const LLHost &host,
 
 	mCulledRegionList.push_back(regionp);
 
+	LLViewerPacketReplay::onRegionAdded(host, region_handle, region_size_x);
 
 	// Find all the adjacent regions, and attach them.
 	// Generate handles for all of the adjacent regions, and attach them in the correct way.
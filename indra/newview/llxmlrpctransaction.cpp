@@ -319,19 +319,6 @@ bool LLXMLRPCTransaction::Impl::process()
 		}
 	}
 	
-	//const F32 MAX_PROCESSING_TIME = 0.05f;
-	//LLTimer timer;
-
-	mCurlRequest->perform();
-
-	/*while (mCurlRequest->perform() > 0)
-	{
-		if (timer.getElapsedTimeF32() >= MAX_PROCESSING_TIME)
-		{
-			return false;
-		}
-	}*/
-
 	while(1)
 	{
 		CURLcode result;
@@ -1931,14 +1931,43 @@ void LLPipeline::updateCull(LLCamera& camera, LLCullResult& result, S32 water_cl
 			camera.disableUserClipPlane();
 		}
 
-		for (U32 i = 0; i < LLViewerRegion::NUM_PARTITIONS; i++)
+		if (LLCullThread::isEnabled())
 		{
-			LLSpatialPartition* part = region->getSpatialPartition(i);
-			if (part)
+			// The region's partitions are frustum checked all at once, occlusion
+			// and the rest of marking them visible then happens here in order.
+			std::vector<LLSpatialPartition*> parts;
+			LLCullThread::job_list_t jobs;
+			for (U32 i = 0; i < LLViewerRegion::NUM_PARTITIONS; i++)
 			{
-				if (hasRenderType(part->mDrawableType))
+				LLSpatialPartition* part = region->getSpatialPartition(i);
+				if (part && hasRenderType(part->mDrawableType))
 				{
-					part->cull(camera);
+					part->queueCull(camera, jobs);
+					parts.push_back(part);
+				}
+			}
+
+			{
+				LLFastTimer ftm(LLFastTimer::FTM_FRUSTUM_CULL);
+				LLCullThread::runJobs(jobs);
+			}
+
+			for (std::vector<LLSpatialPartition*>::iterator part_iter = parts.begin(); part_iter != parts.end(); ++part_iter)
+			{
+				(*part_iter)->finishCull(camera);
+			}
+		}
+		else
+		{
+			for (U32 i = 0; i < LLViewerRegion::NUM_PARTITIONS; i++)
+			{
+				LLSpatialPartition* part = region->getSpatialPartition(i);
+				if (part)
+				{
+					if (hasRenderType(part->mDrawableType))
+					{
+						part->cull(camera);
+					}
 				}
 			}
 		}
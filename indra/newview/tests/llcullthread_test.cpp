@@ -0,0 +1,606 @@
+/**
+ * @file llcullthread_test.cpp
+ * @brief Tests and cull scaling benchmark for the cull thread pool
+ *
+ * $LicenseInfo:firstyear=2001&license=viewergpl$
+ *
+ * Copyright (c) 2001-2009, Linden Research, Inc.
+ *
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ *
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ *
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ *
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header: almost always required for newview cpp files
+#include "../llviewerprecompiledheaders.h"
+// Class to test
+#include "../llcullthread.h"
+// Dependencies
+#include "lltimer.h"
+
+// Tut header
+#include "../test/lltut.h"
+#include "../test/lltestrand.h"
+
+namespace tut
+{
+	// A scene shaped like a dense region's partitions: octrees of boxes,
+	// with the objects in their leaves.
+	struct CullNode
+	{
+		F32 mCenter[3];
+		F32 mSize[3];
+		F32 mObjectCenter[3];	// bounds of mObjects alone, set by rebound()
+		F32 mObjectSize[3];
+		bool mOccluded;
+		std::vector<CullNode*> mChildren;
+		std::vector<S32> mObjects;
+
+		~CullNode()
+		{
+			for_each(mChildren.begin(), mChildren.end(), DeletePointer());
+		}
+	};
+
+	struct CullObject
+	{
+		F32 mCenter[3];
+		F32 mSize[3];
+	};
+
+	// Camera at the origin looking down +x, 90 degrees wide, no far clip.
+	struct CullFrustum
+	{
+		F32 mPlanes[4][4];
+
+		CullFrustum()
+		{
+			const F32 s = 0.70710678f;
+			F32 planes[4][4] = {
+				{ -s,  s,  0, 0 },
+				{ -s, -s,  0, 0 },
+				{ -s,  0,  s, 0 },
+				{ -s,  0, -s, 0 } };
+			memcpy(mPlanes, planes, sizeof(mPlanes));	/* Flawfinder: ignore */
+		}
+
+		// 0 outside, 1 partly in, 2 all in.  Planes face out.
+		S32 boxInFrustum(const F32* center, const F32* size) const
+		{
+			S32 res = 2;
+			for (S32 i = 0; i < 4; i++)
+			{
+				const F32* p = mPlanes[i];
+				F32 d = p[0] * center[0] + p[1] * center[1] + p[2] * center[2] + p[3];
+				F32 r = fabsf(p[0]) * size[0] + fabsf(p[1]) * size[1] + fabsf(p[2]) * size[2];
+				if (d - r > 0.f)
+				{
+					return 0;
+				}
+				if (d + r > 0.f)
+				{
+					res = 1;
+				}
+			}
+			return res;
+		}
+	};
+
+	// Culls one subtree into its own list, as the spatial partition jobs do.
+	class CullJob : public LLCullThread::Job
+	{
+	public:
+		CullJob(const CullNode* node, const std::vector<CullObject>& objects, const CullFrustum& frustum)
+			: mNode(node), mObjects(objects), mFrustum(frustum) { }
+
+		/*virtual*/ void run()
+		{
+			mVisible.clear();
+			cull(mNode, 1);
+		}
+
+		void cull(const CullNode* node, S32 res)
+		{
+			if (res != 2)
+			{
+				res = mFrustum.boxInFrustum(node->mCenter, node->mSize);
+				if (!res)
+				{
+					return;
+				}
+			}
+			for (std::vector<S32>::const_iterator iter = node->mObjects.begin(); iter != node->mObjects.end(); ++iter)
+			{
+				const CullObject& object = mObjects[*iter];
+				if (res == 2 || mFrustum.boxInFrustum(object.mCenter, object.mSize))
+				{
+					mVisible.push_back(*iter);
+				}
+			}
+			for (std::vector<CullNode*>::const_iterator iter = node->mChildren.begin(); iter != node->mChildren.end(); ++iter)
+			{
+				cull(*iter, res);
+			}
+		}
+
+		const CullNode* mNode;
+		const std::vector<CullObject>& mObjects;
+		const CullFrustum& mFrustum;
+		std::vector<S32> mVisible;
+	};
+
+	// Culls the way LLOctreeCull does: a group that fails early is skipped
+	// with its subtree, the result of a partly visible group is dropped
+	// after its subtree, and groups with visible objects are processed.
+	class OctreeCull
+	{
+	public:
+		OctreeCull(const std::vector<CullObject>& objects, const CullFrustum& frustum)
+			: mObjects(objects), mFrustum(frustum), mRes(0) { }
+		virtual ~OctreeCull() { }
+
+		virtual bool earlyFail(const CullNode* node)
+		{
+			return node->mOccluded;
+		}
+
+		virtual void traverse(const CullNode* node)
+		{
+			if (earlyFail(node))
+			{
+				return;
+			}
+			if (mRes == 2)
+			{
+				traverseChildren(node);
+			}
+			else
+			{
+				mRes = mFrustum.boxInFrustum(node->mCenter, node->mSize);
+				if (mRes)
+				{
+					traverseChildren(node);
+				}
+				mRes = 0;
+			}
+		}
+
+		void traverseChildren(const CullNode* node)
+		{
+			visit(node);
+			for (std::vector<CullNode*>::const_iterator iter = node->mChildren.begin(); iter != node->mChildren.end(); ++iter)
+			{
+				traverse(*iter);
+			}
+		}
+
+		virtual void visit(const CullNode* node)
+		{
+			if (checkObjects(node))
+			{
+				processGroup(node);
+			}
+		}
+
+		bool checkObjects(const CullNode* node)
+		{
+			if (node->mObjects.empty())
+			{
+				return false;
+			}
+			if (node->mChildren.empty())
+			{
+				return true;
+			}
+			return mRes != 1 || mFrustum.boxInFrustum(node->mObjectCenter, node->mObjectSize);
+		}
+
+		void processGroup(const CullNode* node)
+		{
+			mProcessed.push_back(node);
+		}
+
+		const std::vector<CullObject>& mObjects;
+		const CullFrustum& mFrustum;
+		S32 mRes;
+		std::vector<const CullNode*> mProcessed;
+	};
+
+	// Records a subtree for OctreeCull to replay, like LLOctreeCullRecorder.
+	class OctreeCullRecorder : public OctreeCull
+	{
+	public:
+		OctreeCullRecorder(const std::vector<CullObject>& objects, const CullFrustum& frustum, S32 res,
+						   LLCullTrace<const CullNode>& trace)
+			: OctreeCull(objects, frustum), mTrace(trace)
+		{
+			mRes = res;
+		}
+
+		/*virtual*/ bool earlyFail(const CullNode* node)
+		{
+			return false;
+		}
+
+		/*virtual*/ void traverse(const CullNode* node)
+		{
+			U32 index = mTrace.beginGroup(node);
+			OctreeCull::traverse(node);
+			mTrace.endGroup(index);
+		}
+
+		/*virtual*/ void visit(const CullNode* node)
+		{
+			mTrace.setProcess(checkObjects(node));
+		}
+
+		void traverseRoot(const CullNode* node)
+		{
+			mTrace.beginGroup(node);
+			mRes = mFrustum.boxInFrustum(node->mCenter, node->mSize);
+			if (mRes)
+			{
+				visit(node);
+			}
+		}
+
+		LLCullTrace<const CullNode>& mTrace;
+	};
+
+	class OctreeCullJob : public LLCullThread::Job
+	{
+	public:
+		OctreeCullJob(const CullNode* node, const std::vector<CullObject>& objects, const CullFrustum& frustum,
+					  S32 res, bool root)
+			: mNode(node), mObjects(objects), mFrustum(frustum), mRes(res), mRoot(root) { }
+
+		/*virtual*/ void run()
+		{
+			mTrace.clear();
+			OctreeCullRecorder culler(mObjects, mFrustum, mRes, mTrace);
+			if (mRoot)
+			{
+				culler.traverseRoot(mNode);
+				mRes = culler.mRes;
+			}
+			else
+			{
+				culler.traverse(mNode);
+			}
+		}
+
+		const CullNode* mNode;
+		const std::vector<CullObject>& mObjects;
+		const CullFrustum& mFrustum;
+		S32 mRes;
+		bool mRoot;
+		LLCullTrace<const CullNode> mTrace;
+	};
+
+	// Test wrapper declarations
+	struct cullthread_test
+	{
+		cullthread_test() : mRand(1234)
+		{
+		}
+
+		~cullthread_test()
+		{
+			LLCullThread::cleanupClass();
+			for_each(mJobs.begin(), mJobs.end(), DeletePointer());
+			for_each(mPartitions.begin(), mPartitions.end(), DeletePointer());
+		}
+
+		CullNode* buildNode(const F32* center, const F32* size, std::vector<S32>& objects, S32 depth)
+		{
+			CullNode* node = new CullNode;
+			node->mOccluded = false;
+			memcpy(node->mCenter, center, sizeof(node->mCenter));	/* Flawfinder: ignore */
+			memcpy(node->mSize, size, sizeof(node->mSize));	/* Flawfinder: ignore */
+			if (depth == 0 || objects.size() < 16)
+			{
+				node->mObjects.swap(objects);
+				return node;
+			}
+			std::vector<S32> octants[8];
+			for (std::vector<S32>::iterator iter = objects.begin(); iter != objects.end(); ++iter)
+			{
+				const F32* pos = mObjects[*iter].mCenter;
+				S32 octant = (pos[0] > center[0] ? 1 : 0) | (pos[1] > center[1] ? 2 : 0) | (pos[2] > center[2] ? 4 : 0);
+				octants[octant].push_back(*iter);
+			}
+			for (S32 i = 0; i < 8; i++)
+			{
+				if (octants[i].empty())
+				{
+					continue;
+				}
+				F32 child_size[3] = { size[0] * 0.5f, size[1] * 0.5f, size[2] * 0.5f };
+				F32 child_center[3] = {
+					center[0] + ((i & 1) ? child_size[0] : -child_size[0]),
+					center[1] + ((i & 2) ? child_size[1] : -child_size[1]),
+					center[2] + ((i & 4) ? child_size[2] : -child_size[2]) };
+				// Loose bounds, objects stick out of their octant
+				F32 loose_size[3] = { child_size[0] + 4.f, child_size[1] + 4.f, child_size[2] + 4.f };
+				node->mChildren.push_back(buildNode(child_center, loose_size, octants[i], depth - 1));
+			}
+			return node;
+		}
+
+		// Regions of 256m around the camera, each with a handful of partitions.
+		void buildScene(S32 num_objects, S32 num_partitions)
+		{
+			std::vector<S32> partition_objects[64];
+			for (S32 i = 0; i < num_objects; i++)
+			{
+				CullObject object;
+				object.mCenter[0] = mRand.nextFloat(512.f) - 256.f;
+				object.mCenter[1] = mRand.nextFloat(512.f) - 256.f;
+				object.mCenter[2] = mRand.nextFloat(128.f) - 64.f;
+				object.mSize[0] = 0.1f + mRand.nextFloat(2.f);
+				object.mSize[1] = 0.1f + mRand.nextFloat(2.f);
+				object.mSize[2] = 0.1f + mRand.nextFloat(2.f);
+				mObjects.push_back(object);
+				partition_objects[i % num_partitions].push_back(i);
+			}
+			F32 center[3] = { 0.f, 0.f, 0.f };
+			F32 size[3] = { 260.f, 260.f, 68.f };
+			for (S32 i = 0; i < num_partitions; i++)
+			{
+				mPartitions.push_back(buildNode(center, size, partition_objects[i], 6));
+			}
+		}
+
+		// Tight bounds around the objects below each node, as a rebound
+		// of the spatial groups leaves them.
+		void rebound(CullNode* node)
+		{
+			F32 min[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+			F32 max[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+			for (std::vector<S32>::iterator iter = node->mObjects.begin(); iter != node->mObjects.end(); ++iter)
+			{
+				const CullObject& object = mObjects[*iter];
+				addBox(object.mCenter, object.mSize, min, max);
+			}
+			toBox(min, max, node->mObjectCenter, node->mObjectSize);
+			for (std::vector<CullNode*>::iterator iter = node->mChildren.begin(); iter != node->mChildren.end(); ++iter)
+			{
+				rebound(*iter);
+				addBox((*iter)->mCenter, (*iter)->mSize, min, max);
+			}
+			toBox(min, max, node->mCenter, node->mSize);
+		}
+
+		static void addBox(const F32* center, const F32* size, F32* min, F32* max)
+		{
+			for (S32 i = 0; i < 3; i++)
+			{
+				min[i] = llmin(min[i], center[i] - size[i]);
+				max[i] = llmax(max[i], center[i] + size[i]);
+			}
+		}
+
+		static void toBox(const F32* min, const F32* max, F32* center, F32* size)
+		{
+			for (S32 i = 0; i < 3; i++)
+			{
+				center[i] = (min[i] + max[i]) * 0.5f;
+				size[i] = llmax((max[i] - min[i]) * 0.5f, 0.f);
+			}
+		}
+
+		// Occludes about one in eight groups below the roots.
+		void occlude(CullNode* node, bool root)
+		{
+			node->mOccluded = !root && mRand.nextFloat(8.f) < 1.f;
+			for (std::vector<CullNode*>::iterator iter = node->mChildren.begin(); iter != node->mChildren.end(); ++iter)
+			{
+				occlude(*iter, false);
+			}
+		}
+
+		// Forks and merges a partition the way LLSpatialPartition's
+		// queueCull() and finishCull() do, returns the groups processed.
+		std::vector<const CullNode*> forkCull(const CullNode* root)
+		{
+			std::vector<OctreeCullJob*> jobs;
+			jobs.push_back(new OctreeCullJob(root, mObjects, mFrustum, 0, true));
+			jobs[0]->run();
+			LLCullThread::job_list_t job_list;
+			if (jobs[0]->mRes)
+			{
+				for (std::vector<CullNode*>::const_iterator iter = root->mChildren.begin(); iter != root->mChildren.end(); ++iter)
+				{
+					jobs.push_back(new OctreeCullJob(*iter, mObjects, mFrustum, 0, false));
+					job_list.push_back(jobs.back());
+				}
+			}
+			LLCullThread::runJobs(job_list);
+
+			OctreeCull culler(mObjects, mFrustum);
+			for (std::vector<OctreeCullJob*>::iterator iter = jobs.begin(); iter != jobs.end(); ++iter)
+			{
+				(*iter)->mTrace.replay(culler);
+			}
+			for_each(jobs.begin(), jobs.end(), DeletePointer());
+			return culler.mProcessed;
+		}
+
+		std::vector<const CullNode*> serialCull(const CullNode* root)
+		{
+			OctreeCull culler(mObjects, mFrustum);
+			culler.traverse(root);
+			return culler.mProcessed;
+		}
+
+		// One job per child of each partition root.
+		void buildJobs()
+		{
+			for (std::vector<CullNode*>::iterator iter = mPartitions.begin(); iter != mPartitions.end(); ++iter)
+			{
+				for (std::vector<CullNode*>::iterator child = (*iter)->mChildren.begin(); child != (*iter)->mChildren.end(); ++child)
+				{
+					CullJob* job = new CullJob(*child, mObjects, mFrustum);
+					mJobs.push_back(job);
+					mJobList.push_back(job);
+				}
+			}
+		}
+
+		// Merges the jobs' results in job order.
+		void cull(std::vector<S32>& visible)
+		{
+			LLCullThread::runJobs(mJobList);
+			visible.clear();
+			for (std::vector<CullJob*>::iterator iter = mJobs.begin(); iter != mJobs.end(); ++iter)
+			{
+				visible.insert(visible.end(), (*iter)->mVisible.begin(), (*iter)->mVisible.end());
+			}
+		}
+
+		LLTestRand mRand;
+		std::vector<CullObject> mObjects;
+		std::vector<CullNode*> mPartitions;
+		std::vector<CullJob*> mJobs;
+		LLCullThread::job_list_t mJobList;
+		CullFrustum mFrustum;
+	};
+
+	// Tut templating thingamagic: test group, object and test instance
+	typedef test_group<cullthread_test> cullthread_t;
+	typedef cullthread_t::object cullthread_object_t;
+	tut::cullthread_t tut_cullthread("cullthread");
+
+	template<> template<>
+	void cullthread_object_t::test<1>()
+	{
+		// Threaded culls merge to exactly what a serial cull finds, batch after batch
+		buildScene(20000, 8);
+		buildJobs();
+
+		std::vector<S32> expected;
+		cull(expected);
+		ensure("something visible", !expected.empty());
+		ensure("something culled", expected.size() < mObjects.size());
+
+		LLCullThread::initClass(3);
+		ensure("enabled", LLCullThread::isEnabled());
+		std::vector<S32> visible;
+		for (S32 i = 0; i < 200; i++)
+		{
+			cull(visible);
+			ensure("same result", visible == expected);
+		}
+
+		// Nothing to share
+		LLCullThread::job_list_t empty;
+		LLCullThread::runJobs(empty);
+		std::vector<S32> first = mJobs[0]->mVisible;
+		mJobs[0]->mVisible.clear();
+		LLCullThread::job_list_t single(1, mJobList[0]);
+		LLCullThread::runJobs(single);
+		ensure("single job ran", mJobs[0]->mVisible == first);
+
+		LLCullThread::cleanupClass();
+		ensure("disabled", !LLCullThread::isEnabled());
+	}
+
+	template<> template<>
+	void cullthread_object_t::test<2>()
+	{
+		// Benchmark: cull a 60k object scene on 0 to 7 extra threads
+		buildScene(60000, 16);
+		buildJobs();
+
+		const S32 FRAMES = 50;
+		std::vector<S32> expected;
+		cull(expected);
+
+		F64 serial_time = 0.0;
+		for (U32 threads = 0; threads < 8; threads = threads ? threads * 2 + 1 : 1)
+		{
+			LLCullThread::initClass(threads);
+			std::vector<S32> visible;
+			LLTimer timer;
+			for (S32 i = 0; i < FRAMES; i++)
+			{
+				cull(visible);
+			}
+			F64 time = timer.getElapsedTimeF64() / FRAMES;
+			LLCullThread::cleanupClass();
+			if (!threads)
+			{
+				serial_time = time;
+			}
+
+			llinfos << "LLCullThread: " << mObjects.size() << " objects, " << mJobList.size() << " jobs, "
+					<< threads << " extra threads: " << time * 1000.0 << " ms per cull ("
+					<< serial_time / time << "x)" << llendl;
+			ensure("same result", visible == expected);
+		}
+	}
+
+	template<> template<>
+	void cullthread_object_t::test<3>()
+	{
+		// Culls recorded by jobs and replayed on the main thread process the
+		// same groups in the same order as a serial cull, occlusion included.
+		buildScene(20000, 4);
+		// All in front of the camera, so that the root is fully visible
+		for (S32 i = 0; i < 2000; i++)
+		{
+			CullObject object;
+			object.mCenter[0] = 100.f + mRand.nextFloat(50.f);
+			object.mCenter[1] = mRand.nextFloat(40.f) - 20.f;
+			object.mCenter[2] = mRand.nextFloat(40.f) - 20.f;
+			object.mSize[0] = object.mSize[1] = object.mSize[2] = 0.5f;
+			mObjects.push_back(object);
+		}
+		std::vector<S32> front;
+		for (S32 i = 20000; i < 22000; i++)
+		{
+			front.push_back(i);
+		}
+		F32 center[3] = { 125.f, 0.f, 0.f };
+		F32 size[3] = { 30.f, 30.f, 30.f };
+		mPartitions.push_back(buildNode(center, size, front, 6));
+
+		LLCullThread::initClass(3);
+		S32 fully_visible = 0;
+		for (std::vector<CullNode*>::iterator iter = mPartitions.begin(); iter != mPartitions.end(); ++iter)
+		{
+			rebound(*iter);
+			if (mFrustum.boxInFrustum((*iter)->mCenter, (*iter)->mSize) == 2)
+			{
+				fully_visible++;
+			}
+			for (S32 pass = 0; pass < 2; pass++)
+			{
+				occlude(*iter, true);
+				std::vector<const CullNode*> expected = serialCull(*iter);
+				ensure("something processed", !expected.empty());
+				ensure("same groups", forkCull(*iter) == expected);
+			}
+		}
+		ensure_equals("one fully visible root", fully_visible, 1);
+	}
+}
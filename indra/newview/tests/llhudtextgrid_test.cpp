@@ -0,0 +1,317 @@
+/**
+ * @file llhudtextgrid_test.cpp
+ * @brief Tests for the floating text grid, text list and batch order,
+ * and a culling benchmark
+ *
+ * $LicenseInfo:firstyear=2001&license=viewergpl$
+ *
+ * Copyright (c) 2001-2009, Linden Research, Inc.
+ *
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ *
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ *
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ *
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+
+// Precompiled header: almost always required for newview cpp files
+#include "../llviewerprecompiledheaders.h"
+// Class to test
+#include "../llhudtextgrid.h"
+// Dependencies
+#include "lltimer.h"
+#include <set>
+
+// Tut header
+#include "../test/lltut.h"
+#include "../test/lltestrand.h"
+
+namespace tut
+{
+	// Stands in for an LLHUDText: where it is and how far away it can be seen
+	struct GridLabel
+	{
+		LLVector3 mPos;
+		F32 mReach;
+	};
+
+	// Stands in for an LLHUDText in sTextObjects
+	struct ListedLabel
+	{
+		S32 mIndex;
+	};
+
+	// Test wrapper declarations
+	struct hudtextgrid_test
+	{
+		hudtextgrid_test() : mRand(1234)
+		{
+		}
+
+		// Labels scattered over a region, like hover text on a busy sim
+		void makeLabels(std::vector<GridLabel>& labels, S32 count, F32 region_size)
+		{
+			labels.resize(count);
+			for (S32 i = 0; i < count; i++)
+			{
+				labels[i].mPos.setVec(mRand.nextFloat(region_size), mRand.nextFloat(region_size), 20.f + mRand.nextFloat(40.f));
+				// LLHUDText's default fade distance and range
+				labels[i].mReach = 8.f + 4.f;
+			}
+		}
+
+		LLTestRand mRand;
+	};
+
+	// Tut templating thingamagic: test group, object and test instance
+	typedef test_group<hudtextgrid_test> hudtextgrid_t;
+	typedef hudtextgrid_t::object hudtextgrid_object_t;
+	tut::hudtextgrid_t tut_hudtextgrid("hudtextgrid");
+
+	template<> template<>
+	void hudtextgrid_object_t::test<1>()
+	{
+		// Items are filed, moved, removed and found by position
+		LLHUDTextGrid<GridLabel> grid(32.f);
+		GridLabel a, b, c;
+		grid.update(&a, LLVector3(10.f, 10.f, 0.f));
+		grid.update(&b, LLVector3(100.f, 10.f, 0.f));
+		grid.update(&c, LLVector3(-5.f, -5.f, 0.f));
+		ensure_equals("size", grid.size(), 3);
+		ensure("has", grid.has(&a) && grid.has(&b) && grid.has(&c));
+
+		LLHUDTextGrid<GridLabel>::item_list_t found;
+		grid.query(LLVector3(0.f, 0.f, 0.f), 16.f, found);
+		ensure_equals("near origin", found.size(), (size_t)2);
+		ensure("a near origin", std::find(found.begin(), found.end(), &a) != found.end());
+		ensure("c near origin", std::find(found.begin(), found.end(), &c) != found.end());
+
+		// Moving within a cell and across cells
+		grid.update(&a, LLVector3(12.f, 12.f, 50.f));
+		grid.update(&b, LLVector3(5.f, 5.f, 0.f));
+		ensure_equals("size after moves", grid.size(), 3);
+		found.clear();
+		grid.query(LLVector3(0.f, 0.f, 0.f), 16.f, found);
+		ensure_equals("b moved in", found.size(), (size_t)3);
+		found.clear();
+		grid.query(LLVector3(100.f, 10.f, 0.f), 16.f, found);
+		ensure("b moved out", found.empty());
+
+		grid.remove(&a);
+		grid.remove(&a);
+		ensure("removed", !grid.has(&a));
+		ensure_equals("size after remove", grid.size(), 2);
+		found.clear();
+		grid.query(LLVector3(0.f, 0.f, 0.f), 16.f, found);
+		ensure_equals("a gone", found.size(), (size_t)2);
+
+		grid.clear();
+		ensure_equals("empty after clear", grid.size(), 0);
+		found.clear();
+		grid.query(LLVector3(0.f, 0.f, 0.f), 1000.f, found);
+		ensure("nothing found after clear", found.empty());
+	}
+
+	template<> template<>
+	void hudtextgrid_object_t::test<2>()
+	{
+		// Benchmark: walk a camera across 1000 labels and find the ones close
+		// enough to fade in, through the grid as LLHUDText::updateAll() does
+		// and by visiting every label as it used to.
+		const S32 NUM_LABELS = 1000;
+		const S32 NUM_FRAMES = 2000;
+		const F32 REGION_SIZE = 256.f;
+		const F32 CELL_SIZE = 32.f;
+		const F32 MAX_OBJECT_RADIUS = 26.f;
+
+		std::vector<GridLabel> labels;
+		makeLabels(labels, NUM_LABELS, REGION_SIZE);
+
+		LLHUDTextGrid<GridLabel> grid(CELL_SIZE);
+		F32 reach = 0.f;
+		for (std::vector<GridLabel>::iterator iter = labels.begin(); iter != labels.end(); ++iter)
+		{
+			grid.update(&(*iter), iter->mPos);
+			reach = llmax(reach, iter->mReach);
+		}
+
+		std::vector<LLVector3> path;
+		for (S32 frame = 0; frame < NUM_FRAMES; frame++)
+		{
+			F32 t = (F32)frame / (F32)NUM_FRAMES;
+			path.push_back(LLVector3(REGION_SIZE * t, REGION_SIZE * 0.5f + 60.f * sinf(t * 12.f), 30.f));
+		}
+
+		LLTimer timer;
+		LLHUDTextGrid<GridLabel>::item_list_t candidates;
+		S32 grid_visits = 0;
+		S32 grid_in_reach = 0;
+		for (std::vector<LLVector3>::iterator cam = path.begin(); cam != path.end(); ++cam)
+		{
+			candidates.clear();
+			grid.query(*cam, reach + MAX_OBJECT_RADIUS, candidates);
+			grid_visits += candidates.size();
+			for (LLHUDTextGrid<GridLabel>::item_list_t::iterator iter = candidates.begin(); iter != candidates.end(); ++iter)
+			{
+				if (dist_vec((*iter)->mPos, *cam) <= (*iter)->mReach + MAX_OBJECT_RADIUS)
+				{
+					grid_in_reach++;
+				}
+			}
+		}
+		F64 grid_time = timer.getElapsedTimeF64();
+
+		timer.reset();
+		S32 scan_visits = 0;
+		S32 scan_in_reach = 0;
+		for (std::vector<LLVector3>::iterator cam = path.begin(); cam != path.end(); ++cam)
+		{
+			for (std::vector<GridLabel>::iterator iter = labels.begin(); iter != labels.end(); ++iter)
+			{
+				scan_visits++;
+				if (dist_vec(iter->mPos, *cam) <= iter->mReach + MAX_OBJECT_RADIUS)
+				{
+					scan_in_reach++;
+				}
+			}
+		}
+		F64 scan_time = timer.getElapsedTimeF64();
+
+		llinfos << "LLHUDText culling: " << NUM_LABELS << " labels over " << NUM_FRAMES << " frames: grid visited "
+				<< grid_visits / NUM_FRAMES << " per frame in " << grid_time * 1000.0 << " ms, full scan visited "
+				<< scan_visits / NUM_FRAMES << " per frame in " << scan_time * 1000.0 << " ms" << llendl;
+
+		ensure_equals("grid finds every label in reach", grid_in_reach, scan_in_reach);
+		ensure("grid visits far fewer labels", grid_visits * 4 < scan_visits);
+	}
+
+	template<> template<>
+	void hudtextgrid_object_t::test<3>()
+	{
+		// Batched lines come out farthest bucket first, grouped by font
+		// within a bucket and in their original order within a font
+		const S32 NUM_LINES = 500;
+		const S32 NUM_BUCKETS = 6;
+		const S32 NUM_FONTS = 3;
+		// Only the addresses of the fonts are compared
+		char fonts[NUM_FONTS];
+
+		std::vector<LLHUDTextBatchLine> lines(NUM_LINES);
+		for (S32 i = 0; i < NUM_LINES; i++)
+		{
+			lines[i].mDepthBucket = mRand.next(NUM_BUCKETS);
+			lines[i].mFont = reinterpret_cast<const LLFontGL*>(&fonts[mRand.next(NUM_FONTS)]);
+			lines[i].mText = NULL;
+			// Stands for the order the lines were gathered in
+			lines[i].mX = (F32)i;
+		}
+		std::vector<LLHUDTextBatchLine> sorted = lines;
+		sort_hud_text_batch(sorted);
+
+		ensure_equals("no lines lost", sorted.size(), lines.size());
+		for (S32 i = 1; i < NUM_LINES; i++)
+		{
+			const LLHUDTextBatchLine& prev = sorted[i - 1];
+			const LLHUDTextBatchLine& line = sorted[i];
+			ensure("back to front", prev.mDepthBucket >= line.mDepthBucket);
+			if (prev.mDepthBucket == line.mDepthBucket)
+			{
+				ensure("grouped by font", prev.mFont <= line.mFont);
+				if (prev.mFont == line.mFont)
+				{
+					ensure("stable within a font", prev.mX < line.mX);
+				}
+			}
+		}
+
+		// Each bucket's lines in one font are all together
+		std::set<std::pair<S32, const LLFontGL*> > seen;
+		for (S32 i = 0; i < NUM_LINES; i++)
+		{
+			std::pair<S32, const LLFontGL*> group(sorted[i].mDepthBucket, sorted[i].mFont);
+			if (i == 0 || group != std::make_pair(sorted[i - 1].mDepthBucket, sorted[i - 1].mFont))
+			{
+				ensure("one run per bucket and font", seen.insert(group).second);
+			}
+		}
+	}
+
+	template<> template<>
+	void hudtextgrid_object_t::test<4>()
+	{
+		// Adding and removing in any order leaves every listed item
+		// knowing its position, and removed items knowing they are gone
+		const S32 NUM_LABELS = 200;
+		std::vector<ListedLabel> labels(NUM_LABELS);
+		std::vector<ListedLabel*> list;
+		for (S32 i = 0; i < NUM_LABELS; i++)
+		{
+			hud_text_list_add(list, &labels[i], &ListedLabel::mIndex);
+			ensure_equals("added at end", labels[i].mIndex, i);
+		}
+
+		std::vector<bool> listed(NUM_LABELS, true);
+		for (S32 round = 0; round < NUM_LABELS * 3; round++)
+		{
+			S32 i = mRand.next(NUM_LABELS);
+			if (listed[i])
+			{
+				hud_text_list_remove(list, &labels[i], &ListedLabel::mIndex);
+				ensure_equals("removed", labels[i].mIndex, -1);
+			}
+			else
+			{
+				hud_text_list_add(list, &labels[i], &ListedLabel::mIndex);
+			}
+			listed[i] = !listed[i];
+
+			// A second remove of an unlisted item is harmless
+			if (!listed[i])
+			{
+				hud_text_list_remove(list, &labels[i], &ListedLabel::mIndex);
+			}
+
+			S32 count = 0;
+			for (S32 j = 0; j < NUM_LABELS; j++)
+			{
+				if (listed[j])
+				{
+					count++;
+					ensure("index in range", labels[j].mIndex >= 0 && labels[j].mIndex < (S32)list.size());
+					ensure("index points at item", list[labels[j].mIndex] == &labels[j]);
+				}
+				else
+				{
+					ensure_equals("unlisted", labels[j].mIndex, -1);
+				}
+			}
+			ensure_equals("list size", (S32)list.size(), count);
+		}
+
+		// Removing the last item leaves nothing behind
+		while (!list.empty())
+		{
+			ListedLabel* last = list.back();
+			hud_text_list_remove(list, last, &ListedLabel::mIndex);
+			ensure_equals("last removed", last->mIndex, -1);
+		}
+	}
+}
@@ -0,0 +1,268 @@
+/**
+ * @file llinventorynameindex_test.cpp
+ * @brief Tests and search benchmark for the inventory name index
+ *
+ * $LicenseInfo:firstyear=2001&license=viewergpl$
+ *
+ * Copyright (c) 2001-2009, Linden Research, Inc.
+ *
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ *
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ *
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ *
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+
+// Precompiled header: almost always required for newview cpp files
+#include "../llviewerprecompiledheaders.h"
+// Class to test
+#include "../llinventorynameindex.h"
+// Dependencies
+#include "lltimer.h"
+
+// Tut header
+#include "../test/lltut.h"
+#include "../test/lltestrand.h"
+
+namespace tut
+{
+	// Test wrapper declarations
+	struct inventorynameindex_test
+	{
+		// What the folder view searches, upper cased as it does
+		struct Object
+		{
+			LLUUID mID;
+			std::string mName;
+			std::string mDesc;
+			LLUUID mCreatorID;
+		};
+
+		inventorynameindex_test() : mRand(1234)
+		{
+			static const char* words[] = { "Oak", "Wood", "Hair", "Shoes", "Red", "Dress", "Boots", "Script",
+										   "Texture", "Blue", "Prim", "Sculpt", "Copy", "Tree", "Bench", "Lamp" };
+			mWords.assign(words, words + sizeof(words) / sizeof(words[0]));
+			for (S32 i = 0; i < 50; i++)
+			{
+				mCreators.push_back(makeID());
+			}
+		}
+
+		LLUUID makeID()
+		{
+			LLUUID id;
+			for (S32 i = 0; i < UUID_BYTES; i++)
+			{
+				id.mData[i] = (U8)mRand.next(256);
+			}
+			return id;
+		}
+
+		// Names like "Red Oak Bench 42", mostly with empty descriptions
+		std::string makeName()
+		{
+			std::string name;
+			S32 words = 1 + mRand.next(3);
+			for (S32 i = 0; i < words; i++)
+			{
+				name += mWords[mRand.next(mWords.size())];
+				name += " ";
+			}
+			name += llformat("%d", mRand.next(1000));
+			return name;
+		}
+
+		void makeObject(Object& object)
+		{
+			object.mID = makeID();
+			object.mName = makeName();
+			object.mDesc = mRand.next(4) ? std::string() : makeName();
+			object.mCreatorID = mCreators[mRand.next(mCreators.size())];
+		}
+
+		// What LLInventoryFilter::check() did before: a find() on each label
+		void scan(const std::vector<Object>& objects, const std::string& sub_string, U32 search_type, uuid_vec_t& matches)
+		{
+			matches.clear();
+			for (std::vector<Object>::const_iterator iter = objects.begin(); iter != objects.end(); ++iter)
+			{
+				std::string name(iter->mName);
+				LLStringUtil::toUpper(name);
+				std::string desc(iter->mDesc);
+				LLStringUtil::toUpper(desc);
+				if (((search_type & LLInventoryNameIndex::SEARCH_NAME) && name.find(sub_string) != std::string::npos)
+					|| ((search_type & LLInventoryNameIndex::SEARCH_DESC) && desc.find(sub_string) != std::string::npos))
+				{
+					matches.push_back(iter->mID);
+				}
+			}
+			std::sort(matches.begin(), matches.end());
+		}
+
+		LLTestRand mRand;
+		std::vector<std::string> mWords;
+		uuid_vec_t mCreators;
+	};
+
+	// Tut templating thingamagic: test group, object and test instance
+	typedef test_group<inventorynameindex_test> inventorynameindex_t;
+	typedef inventorynameindex_t::object inventorynameindex_object_t;
+	tut::inventorynameindex_t tut_inventorynameindex("inventorynameindex");
+
+	template<> template<>
+	void inventorynameindex_object_t::test<1>()
+	{
+		// The index finds what a scan finds through renames, removals and compaction
+		LLInventoryNameIndex index;
+		std::vector<Object> objects(3000);
+		for (std::vector<Object>::iterator iter = objects.begin(); iter != objects.end(); ++iter)
+		{
+			makeObject(*iter);
+			index.update(iter->mID, iter->mName, iter->mDesc, iter->mCreatorID);
+		}
+		for (S32 i = 0; i < 5000; i++)
+		{
+			U32 which = mRand.next(objects.size());
+			if (mRand.next(4))
+			{
+				objects[which].mName = makeName();
+				index.update(objects[which].mID, objects[which].mName, objects[which].mDesc, objects[which].mCreatorID);
+			}
+			else
+			{
+				index.remove(objects[which].mID);
+				objects[which] = objects.back();
+				objects.pop_back();
+			}
+		}
+		ensure_equals("size", index.size(), (S32)objects.size());
+
+		const char* queries[] = { "OAK", "WOOD", "D O", "RED OAK", " 42", "SCRIPT 1", "ZZZ", "OOD BE" };
+		uuid_vec_t found;
+		uuid_vec_t expected;
+		for (U32 type = 1; type <= 3; type++)
+		{
+			for (U32 i = 0; i < sizeof(queries) / sizeof(queries[0]); i++)
+			{
+				ensure(queries[i], index.find(queries[i], type, found));
+				scan(objects, queries[i], type, expected);
+				ensure(std::string("same matches for ") + queries[i], found == expected);
+			}
+		}
+
+		ensure("short strings are not indexed", !index.find("OA", 1, found));
+
+		index.clear();
+		ensure_equals("empty after clear", index.size(), 0);
+		ensure("nothing found after clear", index.find("OAK", 1, found) && found.empty());
+	}
+
+	template<> template<>
+	void inventorynameindex_object_t::test<2>()
+	{
+		// Creator names are matched once the name cache supplies them
+		LLInventoryNameIndex index;
+		LLUUID item = makeID();
+		LLUUID other = makeID();
+		LLUUID creator = makeID();
+		index.update(item, "Chair", "", creator);
+		index.update(other, "Table", "Made by Jane", LLUUID::null);
+
+		uuid_vec_t unnamed;
+		index.getUnnamedCreators(unnamed);
+		ensure_equals("one unnamed creator", unnamed.size(), (size_t)1);
+		ensure_equals("the creator", unnamed[0], creator);
+
+		uuid_vec_t found;
+		ensure("creator search", index.find("JANE", LLInventoryNameIndex::SEARCH_CREATOR, found));
+		ensure("no names yet", found.empty());
+
+		U32 version = index.getVersion();
+		index.setCreatorName(creator, "Jane Resident");
+		ensure("name changes version", index.getVersion() != version);
+		unnamed.clear();
+		index.getUnnamedCreators(unnamed);
+		ensure("named now", unnamed.empty());
+
+		index.find("JANE", LLInventoryNameIndex::SEARCH_CREATOR, found);
+		ensure("found by creator", found.size() == 1 && found[0] == item);
+		index.find("JANE", LLInventoryNameIndex::SEARCH_CREATOR | LLInventoryNameIndex::SEARCH_DESC, found);
+		ensure_equals("found by creator and description", found.size(), (size_t)2);
+		index.find("JANE", 0, found);
+		ensure("no search type searches names", found.empty());
+
+		version = index.getVersion();
+		index.update(item, "Chair", "", creator);
+		ensure_equals("unchanged update keeps version", index.getVersion(), version);
+	}
+
+	template<> template<>
+	void inventorynameindex_object_t::test<3>()
+	{
+		// Benchmark: search a 150k object inventory through the index and
+		// with a find() on every label, as the filter used to.
+		const S32 NUM_OBJECTS = 150000;
+		std::vector<Object> objects(NUM_OBJECTS);
+		for (std::vector<Object>::iterator iter = objects.begin(); iter != objects.end(); ++iter)
+		{
+			makeObject(*iter);
+		}
+
+		LLTimer timer;
+		LLInventoryNameIndex index;
+		for (std::vector<Object>::iterator iter = objects.begin(); iter != objects.end(); ++iter)
+		{
+			index.update(iter->mID, iter->mName, iter->mDesc, iter->mCreatorID);
+		}
+		F64 build_time = timer.getElapsedTimeF64();
+
+		const char* queries[] = { "BENCH", "OAK TREE", "SCULPT 99", "ES", "BOO" };
+		const U32 num_queries = sizeof(queries) / sizeof(queries[0]);
+		std::vector<uuid_vec_t> found(num_queries);
+		timer.reset();
+		for (U32 i = 0; i < num_queries; i++)
+		{
+			index.find(queries[i], LLInventoryNameIndex::SEARCH_NAME | LLInventoryNameIndex::SEARCH_DESC, found[i]);
+		}
+		F64 index_time = timer.getElapsedTimeF64();
+
+		std::vector<uuid_vec_t> expected(num_queries);
+		timer.reset();
+		for (U32 i = 0; i < num_queries; i++)
+		{
+			scan(objects, queries[i], LLInventoryNameIndex::SEARCH_NAME | LLInventoryNameIndex::SEARCH_DESC, expected[i]);
+		}
+		F64 scan_time = timer.getElapsedTimeF64();
+
+		llinfos << "LLInventoryNameIndex: " << NUM_OBJECTS << " objects indexed in " << build_time * 1000.0 << " ms; "
+				<< num_queries << " searches: index " << index_time * 1000.0 << " ms, label scan " << scan_time * 1000.0 << " ms" << llendl;
+
+		for (U32 i = 0; i < num_queries; i++)
+		{
+			// "ES" is too short to look up, so the filter scans for it as before
+			if (strlen(queries[i]) >= LLInventoryNameIndex::MIN_SUBSTRING_LENGTH)
+			{
+				ensure(std::string("same matches for ") + queries[i], found[i] == expected[i]);
+			}
+		}
+	}
+}
@@ -0,0 +1,323 @@
+/** 
+ * @file lltexturefetchthrottle_test.cpp
+ * @brief Simulated links driving LLTextureFetchThrottle.
+ *
+ * $LicenseInfo:firstyear=2010&license=viewergpl$
+ * 
+ * Copyright (c) 2010, Linden Research, Inc.
+ * 
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ * 
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ * 
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ * 
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header: almost always required for newview cpp files
+#include "../llviewerprecompiledheaders.h"
+// Class to test
+#include "../lltexturefetchthrottle.h"
+
+// Tut header
+#include "../test/lltut.h"
+
+namespace tut
+{
+	// A texture server behind a link, stepped in fixed time slices.
+	// Each request waits one latency before data flows, then the link
+	// bandwidth is shared evenly between the requests receiving data,
+	// so round trips grow with the number in flight just as they do
+	// when requests queue on a real path. A server with a limit refuses
+	// requests beyond it with a 503 after one latency. Requests are
+	// stretched to the throttle's range floor like partial fetches are.
+	// Like the curl service, the link can grant a host only so many
+	// connections; requests past them wait in its queue, in order.
+	struct SimLink
+	{
+		struct Request
+		{
+			F64 mIssued;
+			F64 mStart;			// when it got a connection
+			F64 mReady;
+			S32 mSize;
+			F32 mRemaining;
+			bool mStarted;
+			bool mRefused;
+		};
+
+		F32 mKBPS;
+		F64 mLatency;
+		U32 mServerLimit;		// 0 is unlimited
+		U32 mDemand;			// most requests the fetcher has to issue, 0 is unlimited
+		U32 mConnections;		// 0 is unlimited
+		bool mTimeFromIssue;	// round trips include the wait for a connection
+		S32 mRequestSize;
+		std::list<Request> mRequests;
+
+		// Averages over the measured part of the run
+		F32 mMeanWindow;
+		F32 mMeanKBPS;
+		F32 mMeanRTT;
+		F32 mErrorRate;
+
+		SimLink(F32 kbps, F64 latency, U32 server_limit = 0, U32 demand = 0)
+			: mKBPS(kbps), mLatency(latency), mServerLimit(server_limit), mDemand(demand),
+			  mConnections(0), mTimeFromIssue(false),
+			  mRequestSize(32 * 1024),
+			  mMeanWindow(0.f), mMeanKBPS(0.f), mMeanRTT(0.f), mErrorRate(0.f)
+		{
+		}
+
+		// Runs for secs and averages the last measure_secs of it.
+		void run(LLTextureFetchThrottle& throttle, F64 secs, F64 measure_secs)
+		{
+			const F64 dt = 0.01;
+			F64 window_sum = 0.0, rtt_sum = 0.0, bytes = 0.0;
+			U32 steps = 0, completed = 0, errors = 0;
+			for (F64 now = dt; now <= secs; now += dt)
+			{
+				bool measure = now > secs - measure_secs;
+				U32 limit = throttle.getWindow();
+				if (mDemand)
+				{
+					limit = llmin(limit, mDemand);
+				}
+				while (mRequests.size() < limit)
+				{
+					Request request;
+					request.mIssued = now;
+					request.mSize = llmax(mRequestSize, throttle.getRangeSize());
+					request.mRemaining = (F32)request.mSize;
+					request.mStarted = false;
+					mRequests.push_back(request);
+				}
+
+				U32 active = 0;
+				U32 receiving = 0;
+				for (std::list<Request>::iterator iter = mRequests.begin(); iter != mRequests.end(); ++iter)
+				{
+					if (!iter->mStarted)
+					{
+						if (mConnections && active >= mConnections)
+						{
+							continue;
+						}
+						iter->mStarted = true;
+						iter->mStart = now;
+						iter->mReady = now + mLatency;
+						iter->mRefused = mServerLimit && active >= mServerLimit;
+					}
+					active++;
+					if (!iter->mRefused && iter->mReady <= now)
+					{
+						receiving++;
+					}
+				}
+				F32 share = receiving ? mKBPS * 1024.f * (F32)dt / (F32)receiving : 0.f;
+
+				for (std::list<Request>::iterator iter = mRequests.begin(); iter != mRequests.end(); )
+				{
+					std::list<Request>::iterator cur = iter++;
+					if (!cur->mStarted || cur->mReady > now)
+					{
+						continue;
+					}
+					F64 rtt = now - (mTimeFromIssue ? cur->mIssued : cur->mStart);
+					if (cur->mRefused)
+					{
+						throttle.recordResult(rtt, 0, true);
+						errors += measure;
+						completed += measure;
+						mRequests.erase(cur);
+						continue;
+					}
+					cur->mRemaining -= share;
+					if (cur->mRemaining <= 0.f)
+					{
+						throttle.recordResult(rtt, cur->mSize, false);
+						if (measure)
+						{
+							completed++;
+							rtt_sum += rtt;
+							bytes += cur->mSize;
+						}
+						mRequests.erase(cur);
+					}
+				}
+
+				throttle.noteInFlight(mRequests.size());
+				throttle.update(now);
+				if (measure)
+				{
+					window_sum += throttle.getWindow();
+					steps++;
+				}
+			}
+			mMeanWindow = steps ? (F32)(window_sum / steps) : 0.f;
+			mMeanKBPS = (F32)(bytes / 1024.0 / measure_secs);
+			mMeanRTT = completed > errors ? (F32)(rtt_sum / (completed - errors)) : 0.f;
+			mErrorRate = completed ? (F32)errors / (F32)completed : 0.f;
+		}
+	};
+
+	struct texturefetchthrottle_test
+	{
+		LLTextureFetchThrottle mThrottle;
+
+		texturefetchthrottle_test()
+		{
+			mThrottle.setLimits(2, 128, 32);
+		}
+	};
+
+	typedef test_group<texturefetchthrottle_test> texturefetchthrottle_t;
+	typedef texturefetchthrottle_t::object texturefetchthrottle_object_t;
+	tut::texturefetchthrottle_t tut_texturefetchthrottle("texturefetchthrottle");
+
+	// Slow start begins at the minimum window, fixed mode at the fixed one
+	template<> template<>
+	void texturefetchthrottle_object_t::test<1>()
+	{
+		ensure_equals("adaptive start", mThrottle.getWindow(), 2U);
+		ensure("slow start", mThrottle.inSlowStart());
+		mThrottle.setAdaptive(false);
+		ensure_equals("fixed start", mThrottle.getWindow(), 32U);
+		mThrottle.setAdaptive(true);
+		ensure_equals("adaptive restart", mThrottle.getWindow(), 2U);
+	}
+
+	// A fast, long link opens the window well past the old fixed 32
+	// and gets far more through it than the fixed limit did.
+	template<> template<>
+	void texturefetchthrottle_object_t::test<2>()
+	{
+		LLTextureFetchThrottle fixed;
+		fixed.setLimits(2, 128, 32);
+		fixed.setAdaptive(false);
+		SimLink fixed_link(20000.f, 0.15);
+		fixed_link.run(fixed, 60.0, 30.0);
+
+		SimLink link(20000.f, 0.15);
+		link.run(mThrottle, 60.0, 30.0);
+		ensure("window opened", link.mMeanWindow > 64.f);
+		ensure("throughput", link.mMeanKBPS > 0.6f * link.mKBPS);
+		ensure("better than fixed", link.mMeanKBPS > 2.f * fixed_link.mMeanKBPS);
+		ensure("range floor", mThrottle.getRangeSize() > 0);
+		ensure("range ceiling", mThrottle.getRangeSize() <= LLTextureFetchThrottle::MAX_RANGE_SIZE);
+	}
+
+	// A slow link closes the window until requests stop queueing,
+	// without giving up throughput.
+	template<> template<>
+	void texturefetchthrottle_object_t::test<3>()
+	{
+		SimLink link(256.f, 0.2);
+		link.run(mThrottle, 120.0, 60.0);
+		ensure("window closed", link.mMeanWindow < 12.f);
+		ensure("throughput", link.mMeanKBPS > 0.8f * link.mKBPS);
+		ensure("no queueing", link.mMeanRTT < 3.f * mThrottle.getBaseRTT());
+	}
+
+	// An overloaded server answering 503 past 24 requests pushes the
+	// window back under its limit.
+	template<> template<>
+	void texturefetchthrottle_object_t::test<4>()
+	{
+		SimLink link(20000.f, 0.15, 24);
+		link.run(mThrottle, 120.0, 60.0);
+		ensure("window under limit", link.mMeanWindow < 26.f);
+		ensure("few errors", link.mErrorRate < 0.1f);
+		ensure("throughput", link.mMeanKBPS > 0.5f * 24 * 32 / 0.15f);
+	}
+
+	// A fetcher with little to fetch does not inflate the window
+	template<> template<>
+	void texturefetchthrottle_object_t::test<5>()
+	{
+		SimLink link(20000.f, 0.15, 0, 4);
+		link.run(mThrottle, 30.0, 10.0);
+		ensure("window follows demand", mThrottle.getWindow() <= 8);
+	}
+
+	// Fixed mode keeps the window and asks for no range floor
+	template<> template<>
+	void texturefetchthrottle_object_t::test<6>()
+	{
+		mThrottle.setAdaptive(false);
+		SimLink link(256.f, 0.2);
+		link.run(mThrottle, 30.0, 10.0);
+		ensure_equals("fixed window", mThrottle.getWindow(), 32U);
+		ensure_equals("no range floor", mThrottle.getRangeSize(), 0);
+		ensure("statistics kept", mThrottle.getSmoothedRTT() > 0.f && !mThrottle.getHistory().empty());
+	}
+
+	// History is bounded
+	template<> template<>
+	void texturefetchthrottle_object_t::test<7>()
+	{
+		SimLink link(1000.f, 0.1);
+		link.run(mThrottle, 2.0 * LLTextureFetchThrottle::HISTORY_SIZE, 1.0);
+		ensure_equals("history size", (U32)mThrottle.getHistory().size(), LLTextureFetchThrottle::HISTORY_SIZE);
+	}
+
+	// Behind a host that gets 16 connections, a window held to the
+	// connection limit keeps every one of them busy and, pinned at its
+	// ceiling, grows the range instead. Left open it runs on into the
+	// connection queue and never gets there.
+	template<> template<>
+	void texturefetchthrottle_object_t::test<8>()
+	{
+		mThrottle.setLimits(2, 16, 16);
+		SimLink link(20000.f, 0.15);
+		link.mConnections = 16;
+		link.run(mThrottle, 60.0, 30.0);
+		ensure("window at the connection limit", link.mMeanWindow > 14.f);
+		ensure("throughput", link.mMeanKBPS > 0.6f * link.mKBPS);
+		ensure("no queueing", link.mMeanRTT < 2.f * mThrottle.getBaseRTT());
+
+		LLTextureFetchThrottle unbounded;
+		unbounded.setLimits(2, 128, 32);
+		SimLink unbounded_link(20000.f, 0.15);
+		unbounded_link.mConnections = 16;
+		unbounded_link.run(unbounded, 60.0, 30.0);
+		ensure("ran past the connections", unbounded_link.mMeanWindow > 32.f);
+		ensure("held window does better", link.mMeanKBPS > 2.f * unbounded_link.mMeanKBPS);
+	}
+
+	// Time spent waiting for a connection is not round trip: timed from
+	// when requests were issued, the throttle reads the queue as a
+	// congested path.
+	template<> template<>
+	void texturefetchthrottle_object_t::test<9>()
+	{
+		SimLink link(20000.f, 0.15);
+		link.mConnections = 16;
+		link.run(mThrottle, 60.0, 30.0);
+
+		LLTextureFetchThrottle from_issue;
+		from_issue.setLimits(2, 128, 32);
+		SimLink issue_link(20000.f, 0.15);
+		issue_link.mConnections = 16;
+		issue_link.mTimeFromIssue = true;
+		issue_link.run(from_issue, 60.0, 30.0);
+		ensure("queue inflates it", from_issue.getSmoothedRTT() > 1.2f * mThrottle.getSmoothedRTT());
+		ensure("window shrinks", issue_link.mMeanWindow < link.mMeanWindow);
+	}
+}
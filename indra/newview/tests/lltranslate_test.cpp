@@ -46,8 +46,8 @@ namespace tut
 		TranslateTestData()
 		{
 			apr_pool_create(&mPool, NULL);
-			mServerPump = new LLPumpIO(mPool);
-			mClientPump = new LLPumpIO(mPool);
+			mServerPump = new LLPumpIO;
+			mClientPump = new LLPumpIO;
 
 			LLHTTPClient::setPump(*mClientPump);
 		}
@@ -0,0 +1,265 @@
+/**
+ * @file llviewerobjectindex_test.cpp
+ * @brief Tests and update burst benchmark for the object list lookup tables
+ *
+ * $LicenseInfo:firstyear=2001&license=viewergpl$
+ *
+ * Copyright (c) 2001-2009, Linden Research, Inc.
+ *
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ *
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ *
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ *
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header: almost always required for newview cpp files
+#include "../llviewerprecompiledheaders.h"
+// Class to test
+#include "../llviewerobjectindex.h"
+// Dependencies
+#include "lltimer.h"
+
+// Tut header
+#include "../test/lltut.h"
+#include "../test/lltestrand.h"
+
+namespace tut
+{
+	// Test wrapper declarations
+	struct viewerobjectindex_test
+	{
+		viewerobjectindex_test() : mRand(1234)
+		{
+		}
+
+		LLUUID makeID()
+		{
+			LLUUID id;
+			for (S32 i = 0; i < UUID_BYTES; i++)
+			{
+				id.mData[i] = (U8)mRand.next(256);
+			}
+			return id;
+		}
+
+		// One message block of a captured update burst.
+		struct Update
+		{
+			U32 mRegion;
+			U32 mLocalID;
+			LLUUID mFullID;	// Null for terse updates, which only carry the local id.
+			BOOL mKill;
+		};
+
+		// Builds a burst like the one seen on arriving in a busy region:
+		// full updates streaming in, terse updates for what has been seen,
+		// and the occasional kill.
+		void makeBurst(std::vector<Update>& burst, S32 num_objects, S32 num_updates)
+		{
+			std::vector<Update> known;
+			U32 next_local_id[4] = { 1000, 5000, 90000, 200000 };
+			for (S32 i = 0; i < num_updates; i++)
+			{
+				Update update;
+				U32 pick = mRand.next(10);
+				if (known.empty() || ((S32)known.size() < num_objects && pick < 3))
+				{
+					update.mRegion = 1 + mRand.next(4);
+					update.mLocalID = next_local_id[update.mRegion - 1]++;
+					update.mFullID = makeID();
+					update.mKill = FALSE;
+					known.push_back(update);
+				}
+				else if (pick == 9)
+				{
+					U32 which = mRand.next(known.size());
+					update = known[which];
+					update.mKill = TRUE;
+					known[which] = known.back();
+					known.pop_back();
+				}
+				else
+				{
+					update = known[mRand.next(known.size())];
+					update.mFullID.setNull();
+				}
+				burst.push_back(update);
+			}
+		}
+
+		LLTestRand mRand;
+	};
+
+	// Tut templating thingamagic: test group, object and test instance
+	typedef test_group<viewerobjectindex_test> viewerobjectindex_t;
+	typedef viewerobjectindex_t::object viewerobjectindex_object_t;
+	tut::viewerobjectindex_t tut_viewerobjectindex("viewerobjectindex");
+
+	template<> template<>
+	void viewerobjectindex_object_t::test<1>()
+	{
+		// LLUUIDIndex matches a std::map through random inserts and erases
+		LLUUIDIndex<S32> index;
+		std::map<LLUUID, S32> expected;
+		std::vector<LLUUID> ids;
+		for (S32 i = 0; i < 5000; i++)
+		{
+			ids.push_back(makeID());
+		}
+		for (S32 i = 0; i < 50000; i++)
+		{
+			const LLUUID& id = ids[mRand.next(ids.size())];
+			if (mRand.next(3))
+			{
+				index.set(id, i);
+				expected[id] = i;
+			}
+			else
+			{
+				ensure_equals("erase result", (bool)index.erase(id), expected.erase(id) == 1);
+			}
+		}
+
+		ensure_equals("size", index.size(), (S32)expected.size());
+		for (std::vector<LLUUID>::iterator iter = ids.begin(); iter != ids.end(); ++iter)
+		{
+			std::map<LLUUID, S32>::iterator found = expected.find(*iter);
+			S32* valuep = index.find(*iter);
+			ensure_equals("present", valuep != NULL, found != expected.end());
+			if (valuep)
+			{
+				ensure_equals("value", *valuep, found->second);
+			}
+		}
+		ensure("null id", !index.contains(LLUUID::null));
+
+		index.clear();
+		ensure("empty after clear", index.empty());
+		ensure("nothing found after clear", !index.contains(ids[0]));
+	}
+
+	template<> template<>
+	void viewerobjectindex_object_t::test<2>()
+	{
+		// LLLocalIDTable keeps regions apart, handles far ids and guards erases
+		LLLocalIDTable table;
+		LLUUID a = makeID();
+		LLUUID b = makeID();
+		LLUUID c = makeID();
+
+		table.set(1, 42, a);
+		table.set(2, 42, b);
+		table.set(1, 0xF0000000, c);
+
+		ensure_equals("region 1", table.find(1, 42), a);
+		ensure_equals("region 2", table.find(2, 42), b);
+		ensure_equals("far id", table.find(1, 0xF0000000), c);
+		ensure("unknown region", table.find(7, 42).isNull());
+		ensure("unknown local id", table.find(1, 43).isNull());
+
+		ensure("erase with stale id", !table.erase(1, 42, b));
+		ensure_equals("stale erase kept entry", table.find(1, 42), a);
+		ensure("erase", table.erase(1, 42, a));
+		ensure("erased", table.find(1, 42).isNull());
+		ensure("erase far id", table.erase(1, 0xF0000000, c));
+		ensure("erased far id", table.find(1, 0xF0000000).isNull());
+		ensure_equals("other region untouched", table.find(2, 42), b);
+
+		// Reusing a local id after its page was released
+		table.set(1, 42, c);
+		ensure_equals("reused", table.find(1, 42), c);
+	}
+
+	template<> template<>
+	void viewerobjectindex_object_t::test<3>()
+	{
+		// Benchmark: replay a burst of object updates through the lookups
+		// processObjectUpdate() and cleanupReferences() make, with the new
+		// tables and with the std::map tables they replace.
+		std::vector<Update> burst;
+		makeBurst(burst, 20000, 200000);
+
+		LLTimer timer;
+		LLLocalIDTable local_table;
+		LLUUIDIndex<S32> objects;
+		S32 found = 0;
+		for (std::vector<Update>::iterator iter = burst.begin(); iter != burst.end(); ++iter)
+		{
+			LLUUID fullid = iter->mFullID;
+			if (fullid.isNull())
+			{
+				fullid = local_table.find(iter->mRegion, iter->mLocalID);
+			}
+			S32* objectp = objects.find(fullid);
+			if (iter->mKill)
+			{
+				objects.erase(fullid);
+				local_table.erase(iter->mRegion, iter->mLocalID, fullid);
+			}
+			else if (!objectp)
+			{
+				objects.set(fullid, 1);
+				local_table.set(iter->mRegion, iter->mLocalID, fullid);
+			}
+			else
+			{
+				found += *objectp;
+			}
+		}
+		F64 index_time = timer.getElapsedTimeF64();
+
+		timer.reset();
+		std::map<U64, LLUUID> local_map;
+		std::map<LLUUID, S32> object_map;
+		S32 map_found = 0;
+		for (std::vector<Update>::iterator iter = burst.begin(); iter != burst.end(); ++iter)
+		{
+			U64 indexid = (((U64)iter->mRegion) << 32) | (U64)iter->mLocalID;
+			LLUUID fullid = iter->mFullID;
+			if (fullid.isNull())
+			{
+				fullid = get_if_there(local_map, indexid, LLUUID::null);
+			}
+			std::map<LLUUID, S32>::iterator objectp = object_map.find(fullid);
+			if (iter->mKill)
+			{
+				object_map.erase(fullid);
+				local_map.erase(indexid);
+			}
+			else if (objectp == object_map.end())
+			{
+				object_map[fullid] = 1;
+				local_map[indexid] = fullid;
+			}
+			else
+			{
+				map_found += objectp->second;
+			}
+		}
+		F64 map_time = timer.getElapsedTimeF64();
+
+		llinfos << "LLViewerObjectList tables: replayed " << burst.size() << " updates: hashed "
+				<< index_time * 1000.0 << " ms, std::map " << map_time * 1000.0 << " ms" << llendl;
+
+		ensure_equals("same updates resolved", found, map_found);
+		ensure_equals("same objects left", objects.size(), (S32)object_map.size());
+	}
+}
@@ -0,0 +1,187 @@
+/**
+ * @file llvolumebuildthread_test.cpp
+ * @brief Tests for generating volume LODs on the build threads
+ *
+ * $LicenseInfo:firstyear=2001&license=viewergpl$
+ *
+ * Copyright (c) 2001-2009, Linden Research, Inc.
+ *
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ *
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ *
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ *
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header: almost always required for newview cpp files
+#include "../llviewerprecompiledheaders.h"
+// Class to test
+#include "../llvolumebuildthread.h"
+// Dependencies
+#include "lljobscheduler.h"
+#include "lltimer.h"
+#include "llvolumemgr.h"
+#include "../llviewerobjectlist.h"
+#include "../llvovolume.h"
+
+// Tut header
+#include "../test/lltut.h"
+
+// -------------------------------------------------------------------------------------------
+// Stubbing: Declarations required to link and run the class being tested
+// Notes:
+// * Add here stubbed implementation of the few classes and methods used in the class to be tested
+// * Add as little as possible (let the link errors guide you)
+// * Do not make any assumption as to how those classes or methods work (i.e. don't copy/paste code)
+// * A simulator for a class can be implemented here. Please comment and document thoroughly.
+
+// The builds are handed to a real LLVolumeMgr.  No objects wait on them here,
+// the tests pass null ids, so the object list is never searched.
+LLVolumeMgr* LLPrimitive::sVolumeManager = NULL;
+void LLPrimitive::setVolumeManager(LLVolumeMgr* volume_manager) { sVolumeManager = volume_manager; }
+LLViewerObjectList::LLViewerObjectList() { }
+LLViewerObjectList::~LLViewerObjectList() { }
+LLViewerObjectList gObjectList;
+void LLVOVolume::notifyVolumeBuilt() { }
+void LLVOVolume::notifySculptBuilt() { }
+U8* LLImageBase::getData() { return NULL; }
+
+// End Stubbing
+// -------------------------------------------------------------------------------------------
+
+namespace tut
+{
+	struct volumebuildthread_data
+	{
+		volumebuildthread_data()
+		{
+			LLJobScheduler::initClass(2);
+			LLVolumeBuildThread::initClass(2);
+			mVolumeMgr = new LLVolumeMgr;
+			LLPrimitive::setVolumeManager(mVolumeMgr);
+		}
+		~volumebuildthread_data()
+		{
+			LLVolumeBuildThread::cleanupClass();
+			LLPrimitive::setVolumeManager(NULL);
+			delete mVolumeMgr;
+			LLJobScheduler::cleanupClass();
+		}
+
+		// A cylinder, with 'ratio' telling them apart
+		LLVolumeParams makeParams(F32 ratio)
+		{
+			LLVolumeParams volume_params;
+			volume_params.setType(LL_PCODE_PROFILE_CIRCLE, LL_PCODE_PATH_LINE);
+			volume_params.setBeginAndEndS(0.f, 1.f);
+			volume_params.setBeginAndEndT(0.f, 1.f);
+			volume_params.setRatio(ratio, ratio);
+			volume_params.setShear(0.f, 0.f);
+			return volume_params;
+		}
+
+		// Collects finished builds on this thread, as the main loop does, until
+		// that one is no longer pending.
+		bool waitForBuild(const LLVolumeParams& volume_params, S32 detail)
+		{
+			for (S32 i = 0; i < 5000 && LLVolumeBuildThread::isVolumePending(volume_params, detail); ++i)
+			{
+				ms_sleep(1);
+				LLVolumeBuildThread::updateClass(0);
+			}
+			return !LLVolumeBuildThread::isVolumePending(volume_params, detail);
+		}
+
+		LLVolumeMgr* mVolumeMgr;
+	};
+
+	typedef test_group<volumebuildthread_data> volumebuildthread_test;
+	typedef volumebuildthread_test::object volumebuildthread_object;
+	tut::volumebuildthread_test tvbt("LLVolumeBuildThread");
+
+	template<> template<>
+	void volumebuildthread_object::test<1>()
+	{
+		// A LOD built on the threads ends up in its LOD group once collected, and
+		// the request hasn't kept a reference to it.
+		LLVolumeParams volume_params = makeParams(0.5f);
+		LLVolume* lowp = mVolumeMgr->refVolume(volume_params, 0);
+		ensure("not there yet", !mVolumeMgr->isVolumeBuilt(volume_params, 2));
+
+		LLVolumeBuildThread::buildVolume(volume_params, 2, LLUUID::null);
+		ensure("pending", LLVolumeBuildThread::isVolumePending(volume_params, 2));
+		ensure("collected", waitForBuild(volume_params, 2));
+		ensure("in the LOD group", mVolumeMgr->isVolumeBuilt(volume_params, 2));
+
+		LLVolume* volumep = mVolumeMgr->refVolume(volume_params, 2);
+		ensure("a different volume from the low LOD", volumep != lowp);
+		ensure_equals("built at that detail", volumep->getDetail(), LLVolumeLODGroup::getVolumeScaleFromDetail(2));
+		ensure_equals("only the LOD group holds it", volumep->getNumRefs(), 1);
+		ensure("has geometry", volumep->getNumVolumeFaces() > 0);
+		mVolumeMgr->unrefVolume(volumep);
+		mVolumeMgr->unrefVolume(lowp);
+	}
+
+	template<> template<>
+	void volumebuildthread_object::test<2>()
+	{
+		// Asking again while a LOD is on its way doesn't queue a second build.
+		// Many builds spread over both threads all make it back.
+		const S32 NUM_PARAMS = 20;
+		std::vector<LLVolumeParams> params;
+		std::vector<LLVolume*> lows;
+		for (S32 i = 0; i < NUM_PARAMS; ++i)
+		{
+			params.push_back(makeParams(0.1f + 0.04f * i));
+			lows.push_back(mVolumeMgr->refVolume(params[i], 0));
+		}
+		for (S32 i = 0; i < NUM_PARAMS; ++i)
+		{
+			for (S32 detail = 1; detail < LLVolumeLODGroup::NUM_LODS; ++detail)
+			{
+				LLVolumeBuildThread::buildVolume(params[i], detail, LLUUID::null);
+				LLVolumeBuildThread::buildVolume(params[i], detail, LLUUID::null);
+			}
+		}
+		for (S32 i = 0; i < NUM_PARAMS; ++i)
+		{
+			for (S32 detail = 1; detail < LLVolumeLODGroup::NUM_LODS; ++detail)
+			{
+				ensure("collected", waitForBuild(params[i], detail));
+				ensure("in the LOD group", mVolumeMgr->isVolumeBuilt(params[i], detail));
+				LLVolume* volumep = mVolumeMgr->refVolume(params[i], detail);
+				ensure_equals("only the LOD group holds it", volumep->getNumRefs(), 1);
+				mVolumeMgr->unrefVolume(volumep);
+			}
+			mVolumeMgr->unrefVolume(lows[i]);
+		}
+	}
+
+	template<> template<>
+	void volumebuildthread_object::test<3>()
+	{
+		// A build for params no object uses anymore is dropped when it comes back.
+		LLVolumeParams volume_params = makeParams(0.75f);
+		LLVolumeBuildThread::buildVolume(volume_params, 1, LLUUID::null);
+		ensure("collected", waitForBuild(volume_params, 1));
+		ensure("not kept", !mVolumeMgr->isVolumeBuilt(volume_params, 1));
+		ensure("no group made for it", mVolumeMgr->getGroup(volume_params) == NULL);
+	}
+}
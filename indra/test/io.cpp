@@ -837,7 +837,7 @@ namespace tut
 		PumpAndChainTestData()
 		{
 			apr_pool_create(&mPool, NULL);
-			mPump = new LLPumpIO(mPool);
+			mPump = new LLPumpIO;
 		}
 		
 		~PumpAndChainTestData()
@@ -917,7 +917,7 @@ namespace tut
 		{
 			LLFrameTimer::updateFrameTime();			
 			apr_pool_create(&mPool, NULL);
-			mPump = new LLPumpIO(mPool);
+			mPump = new LLPumpIO;
 			mSocket = LLSocket::create(
 				mPool,
 				LLSocket::STREAM_TCP,
@@ -1267,7 +1267,7 @@ namespace tut
 			mClient(NULL)
 		{
 			apr_pool_create(&mPool, NULL);
-			mPump = new LLPumpIO(mPool);
+			mPump = new LLPumpIO;
 			mClient = new LLSimpleRPCClient(&mResponse);
 			mChain.push_back(LLIOPipe::ptr_t(mClient));
 			mChain.push_back(LLIOPipe::ptr_t(new LLFilterSD2XMLRPCRequest));
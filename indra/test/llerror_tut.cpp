@@ -95,7 +95,7 @@ namespace tut
 	struct ErrorTestData
 	{
 		TestRecorder mRecorder;
-		LLError::Settings* mPriorErrorSettings;
+		LLError::ThreadSafeSettings* mPriorErrorSettings;
 		
 		ErrorTestData()
 		{
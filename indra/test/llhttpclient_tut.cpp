@@ -43,6 +43,7 @@
 #if !LL_WINDOWS
 
 #include "lltut.h"
+#include "llcurl.h"
 #include "llhttpclient.h"
 #include "llformat.h"
 #include "llpipeutil.h"
@@ -91,16 +92,18 @@ namespace tut
 		HTTPClientTestData()
 		{
 			apr_pool_create(&mPool, NULL);
-			mServerPump = new LLPumpIO(mPool);
-			mClientPump = new LLPumpIO(mPool);
+			mServerPump = new LLPumpIO;
+			mClientPump = new LLPumpIO;
 			
 			LLHTTPClient::setPump(*mClientPump);
+			LLCurl::initClass();
 		}
 		
 		~HTTPClientTestData()
 		{
 			delete mServerPump;
 			delete mClientPump;
+			LLCurl::cleanupClass();
 			apr_pool_destroy(mPool);
 		}
 
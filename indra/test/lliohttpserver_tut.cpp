@@ -114,7 +114,7 @@ namespace tut
 			apr_pool_create(&pool, NULL);
 
 			LLPumpIO* pump;
-			pump = new LLPumpIO(pool);
+			pump = new LLPumpIO;
 
 			LLPumpIO::chain_t chain;
 			LLSD context;
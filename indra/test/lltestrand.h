@@ -0,0 +1,67 @@
+/**
+ * @file lltestrand.h
+ * @brief Fixed-seed random numbers for unit tests
+ *
+ * $LicenseInfo:firstyear=2010&license=viewergpl$
+ *
+ * Copyright (c) 2010, Linden Research, Inc.
+ *
+ * Second Life Viewer Source Code
+ * The source code in this file ("Source Code") is provided by Linden Lab
+ * to you under the terms of the GNU General Public License, version 2.0
+ * ("GPL"), unless you have obtained a separate licensing agreement
+ * ("Other License"), formally executed by you and Linden Lab.  Terms of
+ * the GPL can be found in doc/GPL-license.txt in this distribution, or
+ * online at http://secondlifegrid.net/programs/open_source/licensing/gplv2
+ *
+ * There are special exceptions to the terms and conditions of the GPL as
+ * it is applied to this Source Code. View the full text of the exception
+ * in the file doc/FLOSS-exception.txt in this software distribution, or
+ * online at
+ * http://secondlifegrid.net/programs/open_source/licensing/flossexception
+ *
+ * By copying, modifying or distributing this software, you acknowledge
+ * that you have read and understood your obligations described above,
+ * and agree to abide by those obligations.
+ *
+ * ALL LINDEN LAB SOURCE CODE IS PROVIDED "AS IS." LINDEN LAB MAKES NO
+ * WARRANTIES, EXPRESS, IMPLIED OR OTHERWISE, REGARDING ITS ACCURACY,
+ * COMPLETENESS OR PERFORMANCE.
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLTESTRAND_H
+#define LL_LLTESTRAND_H
+
+// Small linear congruential generator for test data. Unlike ll_rand() it
+// starts from a fixed seed and is not shared, so a failing test sees the
+// same numbers every run and on every thread that owns one.
+class LLTestRand
+{
+public:
+	LLTestRand(U32 seed) : mSeed(seed) { }
+
+	// Returns a number in [0, range)
+	U32 next(U32 range)
+	{
+		return step() % range;
+	}
+
+	// Returns a number in [0, range)
+	F32 nextFloat(F32 range)
+	{
+		return range * (F32)(step() & 0x7fff) / 32768.f;
+	}
+
+private:
+	// The low bits of the state repeat quickly, use the upper half
+	U32 step()
+	{
+		mSeed = mSeed * 1103515245 + 12345;
+		return mSeed >> 16;
+	}
+
+	U32 mSeed;
+};
+
+#endif // LL_LLTESTRAND_H
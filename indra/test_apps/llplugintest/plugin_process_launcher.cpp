@@ -106,7 +106,7 @@ int main(int argc, char **argv)
 
 	PluginProcessLauncherMessageReceiver receiver;
 	
-	gServicePump = new LLPumpIO(gAPRPoolp);
+	gServicePump = new LLPumpIO;
 	gServicePump->prime(gAPRPoolp);
 
 	gPlugin = new LLPluginProcessParent(gServicePump, &receiver);